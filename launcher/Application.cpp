@@ -1,3 +1,19 @@
+    if (!m_mainWindow) {
+        // normal main window
+        showMainWindow(false);
+        qDebug() << "<> Main window shown.";
+        m_startupProfiler.mark("Main window");
+    }
+
+    // the rest waits until the window has been painted, so it doesn't hold that up
+    if (m_firstPaintSeen || !m_mainWindow->isVisible()) {
+        QTimer::singleShot(0, this, &Application::startDeferredSubsystems);
+    } else {
+        m_mainWindow->installEventFilter(this);
+        // in case the window never gets to paint itself, e.g. when its children cover all of it
+        QTimer::singleShot(1000, this, &Application::startDeferredSubsystems);
+    }
+
 // SPDX-FileCopyrightText: 2022 Sefa Eyeoglu <contact@scrumplex.net>
 //
 // SPDX-License-Identifier: GPL-3.0-only AND Apache-2.0
@@ -44,6 +60,8 @@
 #include "BuildConfig.h"
 
 #include "DataMigrationTask.h"
+#include "SamplingProfiler.h"
+#include "Tracing.h"
 #include "net/PasteUpload.h"
 #include "pathmatcher/MultiMatcher.h"
 #include "pathmatcher/SimplePrefixMatcher.h"
@@ -59,6 +77,7 @@
 #include "ui/pages/global/APIPage.h"
 #include "ui/pages/global/AccountListPage.h"
 #include "ui/pages/global/CustomCommandsPage.h"
+#include "ui/pages/global/DiagnosticsPage.h"
 #include "ui/pages/global/EnvironmentVariablesPage.h"
 #include "ui/pages/global/ExternalToolsPage.h"
 #include "ui/pages/global/JavaPage.h"
@@ -96,16 +115,25 @@
 #include <QNetworkAccessManager>
 #include <QStringList>
 #include <QStyleFactory>
+#include <QTimer>
 #include <QTranslator>
+#include <QUrl>
 #include <QWindow>
+#include <QtConcurrentRun>
 
 #include "InstanceList.h"
-#include "MTPixmapCache.h"
 
+#include <minecraft/LaunchPreparer.h>
+#include <minecraft/ServerAddressCache.h>
 #include <minecraft/auth/AccountList.h>
 #include "icons/IconList.h"
+#include "modplatform/helpers/HashCache.h"
+#include "net/ContentStore.h"
+#include "net/ConnectionPrewarmer.h"
+#include "net/PeerCache.h"
 #include "net/HttpMetaCache.h"
 
+#include "java/JavaCheckCache.h"
 #include "java/JavaUtils.h"
 
 #include "updater/ExternalUpdater.h"
@@ -124,6 +152,7 @@
 #include <FileSystem.h>
 #include <LocalPeer.h>
 
+#include <cpufeatures.h>
 #include <stdlib.h>
 #include <sys.h>
 
@@ -159,8 +188,6 @@
 
 static const QLatin1String liveCheckFile("live.check");
 
-PixmapCache* PixmapCache::s_instance = nullptr;
-
 namespace {
 
 /** This is used so that we can output to the log file in addition to the CLI. */
@@ -223,6 +250,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
     setApplicationVersion(BuildConfig.printableVersionString() + "\n" + BuildConfig.GIT_COMMIT);
     setDesktopFileName(BuildConfig.LAUNCHER_DESKTOPFILENAME);
     startTime = QDateTime::currentDateTime();
+    m_startupProfiler.start();
 
     // Don't quit on hiding the last window
     this->setQuitOnLastWindowClosed(false);
@@ -239,7 +267,19 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
           { { "a", "profile" }, "Use the account specified by its profile name (only valid in combination with --launch)", "profile" },
           { "alive", "Write a small '" + liveCheckFile + "' file after the launcher starts" },
           { { "I", "import" }, "Import instance or resource from specified local path or URL", "url" },
-          { "show", "Opens the window for the specified instance (by instance ID)", "show" } });
+          { "show", "Opens the window for the specified instance (by instance ID)", "show" },
+          { "profile-startup", "Print how long each part of the launcher's startup took, once its window is shown" },
+          { "trace", "Record what the launcher's tasks and network requests do, and write it as a Chrome trace (trace-event JSON) on exit",
+            "file" },
+          { "sample-profile",
+            "Sample what keeps the launcher's window and tasks busy, and write it as collapsed stacks for a flame graph on exit. Slow "
+            "event handlers are logged as they happen",
+            "file" },
+          { "headless", "Do what --import, --update, --check-mod-updates and --export ask for without opening any window, print their "
+                        "progress as JSON lines and exit" },
+          { "update", "Update the specified instance (by instance ID), in headless mode", "instance" },
+          { "check-mod-updates", "List the mod updates of the specified instance (by instance ID), in headless mode", "instance" },
+          { "export", "Export an instance to a file, in headless mode. Files ending in .mrpack become Modrinth packs", "instance=file" } });
     // Has to be positional for some OS to handle that properly
     parser.addPositionalArgument("URL", "Import the resource(s) at the given URL(s) (same as -I / --import)", "[URL...]");
 
@@ -252,6 +292,15 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
     m_serverToJoin = parser.value("server");
     m_profileToUse = parser.value("profile");
     m_liveCheck = parser.isSet("alive");
+    m_profileStartup = parser.isSet("profile-startup");
+
+    if (parser.isSet("trace")) {
+        // relative to where we were started, before the working directory changes to the data path
+        Tracing::start(QFileInfo(parser.value("trace")).absoluteFilePath());
+    }
+    if (parser.isSet("sample-profile")) {
+        SamplingProfiler::start(QFileInfo(parser.value("sample-profile")).absoluteFilePath());
+    }
 
     m_instanceIdToShowWindowOf = parser.value("show");
 
@@ -271,6 +320,35 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         return;
     }
 
+    m_headless = parser.isSet("headless");
+    m_headlessActions.update = parser.values("update");
+    m_headlessActions.import = m_urlsToImport;
+    m_headlessActions.checkModUpdates = parser.values("check-mod-updates");
+    for (auto value : parser.values("export")) {
+        auto separator = value.indexOf('=');
+        if (separator <= 0 || separator == value.size() - 1) {
+            std::cerr << "--export takes an instance ID and a file, as <instance>=<file>!" << std::endl;
+            m_status = Application::Failed;
+            return;
+        }
+        // relative to where we were started, like --trace
+        m_headlessActions.exports.append({ value.left(separator), QFileInfo(value.mid(separator + 1)).absoluteFilePath() });
+    }
+
+    if (!m_headless && (!m_headlessActions.update.isEmpty() || !m_headlessActions.checkModUpdates.isEmpty() ||
+                        !m_headlessActions.exports.isEmpty())) {
+        std::cerr << "--update, --check-mod-updates and --export can only be used in combination with --headless!" << std::endl;
+        m_status = Application::Failed;
+        return;
+    }
+    if (m_headless && (m_headlessActions.isEmpty() || !m_instanceIdToLaunch.isEmpty() || !m_instanceIdToShowWindowOf.isEmpty())) {
+        std::cerr << "--headless needs something to do with --import, --update, --check-mod-updates or --export, and no window to "
+                     "show!"
+                  << std::endl;
+        m_status = Application::Failed;
+        return;
+    }
+
     QString origcwdPath = QDir::currentPath();
     QString binPath = applicationDirPath();
 
@@ -358,6 +436,12 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_peerInstance = new LocalPeer(this, appID);
         connect(m_peerInstance, &LocalPeer::messageReceived, this, &Application::messageReceived);
         if (m_peerInstance->isClient()) {
+            if (m_headless) {
+                // what we'd do would end up in its windows instead, and the two of us would step on each other's toes
+                std::cerr << "The launcher is already running with this data folder, close it first!" << std::endl;
+                m_status = Application::Failed;
+                return;
+            }
             int timeout = 2000;
 
             if (m_instanceIdToLaunch.isEmpty()) {
@@ -484,6 +568,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         }
 
         qDebug() << "<> Log initialized.";
+        m_startupProfiler.mark("Log");
     }
 
     {
@@ -507,6 +592,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         qDebug() << "Git refspec                : " << BuildConfig.GIT_REFSPEC;
         qDebug() << "Compiled for               : " << BuildConfig.systemID();
         qDebug() << "Compiled by                : " << BuildConfig.compilerID();
+        qDebug() << "CPU features               : " << Sys::getCpuFeatures().names().join(' ');
         qDebug() << "Build Artifact             : " << BuildConfig.BUILD_ARTIFACT;
         qDebug() << "Updates Enabled           : " << (updaterEnabled() ? "Yes" : "No");
         if (adjustedBy.size()) {
@@ -525,6 +611,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
             qDebug() << "Address of server to join  :" << m_serverToJoin;
         }
         qDebug() << "<> Paths set.";
+        m_startupProfiler.mark("Paths");
     }
 
     if (m_liveCheck) {
@@ -545,7 +632,9 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
     // Initialize application settings
     {
         // Provide a fallback for migration from PolyMC
-        m_settings.reset(new INISettingsObject({ BuildConfig.LAUNCHER_CONFIGFILE, "polymc.cfg", "multimc.cfg" }, this));
+        auto settings = new INISettingsObject({ BuildConfig.LAUNCHER_CONFIGFILE, "polymc.cfg", "multimc.cfg" }, this);
+        settings->setWriteBehind(true);
+        m_settings.reset(settings);
 
         // Theming
         m_settings->registerSetting("IconTheme", QString());
@@ -559,6 +648,12 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
         m_settings->registerSetting("NumberOfConcurrentTasks", 10);
         m_settings->registerSetting("NumberOfConcurrentDownloads", 6);
+        m_settings->registerSetting("UseHttp2", false);
+        // Rate limits for downloads nobody is waiting on, in KiB/s, 0 for none
+        m_settings->registerSetting("BulkDownloadLimit", 0);
+        m_settings->registerSetting("BulkDownloadLimitWhileGaming", 0);
+        // Lines of a repository URL followed by its mirrors, which slow library downloads are raced against
+        m_settings->registerSetting("LibraryMirrors", "");
 
         QString defaultMonospace;
         int defaultSize = 11;
@@ -623,6 +718,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_settings->registerSetting({ "MinMemAlloc", "MinMemoryAlloc" }, 512);
         m_settings->registerSetting({ "MaxMemAlloc", "MaxMemoryAlloc" }, suitableMaxMem());
         m_settings->registerSetting("PermGen", 128);
+        m_settings->registerSetting("AutoTuneJvm", false);
 
         // Java Settings
         m_settings->registerSetting("JavaPath", "");
@@ -661,6 +757,14 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_settings->registerSetting("ModMetadataDisabled", false);
         m_settings->registerSetting("ModDependenciesDisabled", false);
 
+        // Downloads kept in the cache before the least recently used go, in MiB
+        m_settings->registerSetting("CacheSizeLimit", 4096);
+        // Share downloads with other launchers on the local network
+        m_settings->registerSetting("PeerCacheEnabled", false);
+        // The API hosts recent sessions used, with how much, connected to ahead of time. Every launcher loads its
+        // metadata and the Minecraft versions.
+        m_settings->registerSetting("PrewarmHosts", QUrl(BuildConfig.META_URL).host() + " 1\npiston-meta.mojang.com 1");
+
         // Minecraft offline player name
         m_settings->registerSetting("LastOfflinePlayerName", "");
 
@@ -738,6 +842,10 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
         m_settings->registerSetting("CloseAfterLaunch", false);
         m_settings->registerSetting("QuitAfterGameStop", false);
+        m_settings->registerSetting("PrespawnJava", false);
+        m_settings->registerSetting("PrepareLaunchInBackground", true);
+        m_settings->registerSetting("UseClassDataSharing", false);
+        m_settings->registerSetting("UseGameLogChannel", false);
 
         m_settings->registerSetting("Env", QVariant(QMap<QString, QVariant>()));
 
@@ -774,11 +882,11 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
             m_globalSettingsProvider->addPage<ExternalToolsPage>();
             m_globalSettingsProvider->addPage<AccountListPage>();
             m_globalSettingsProvider->addPage<APIPage>();
+            m_globalSettingsProvider->addPage<DiagnosticsPage>();
         }
 
-        PixmapCache::setInstance(new PixmapCache(this));
-
         qDebug() << "<> Settings loaded.";
+        m_startupProfiler.mark("Settings");
     }
 
 #ifndef QT_NO_ACCESSIBILITY
@@ -794,16 +902,49 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         QString user = settings()->get("ProxyUser").toString();
         QString pass = settings()->get("ProxyPass").toString();
         updateProxySettings(proxyTypeStr, addr, port, user, pass);
+        m_connectionPrewarmer = std::make_shared<Net::ConnectionPrewarmer>(m_settings);
+        ServerAddressCache::setPersistPath(QDir("cache").absoluteFilePath("server_addresses.json"));
         qDebug() << "<> Network done.";
+        m_startupProfiler.mark("Network");
     }
 
-    // load translations
+    QFuture<void> metacacheLoad;
+    // init the http meta cache
     {
+        m_metacache.reset(new HttpMetaCache("metacache"));
+        m_metacache->addBase("asset_indexes", QDir("assets/indexes").absolutePath());
+        m_metacache->addBase("asset_objects", QDir("assets/objects").absolutePath());
+        m_metacache->addBase("versions", QDir("versions").absolutePath());
+        m_metacache->addBase("libraries", QDir("libraries").absolutePath());
+        m_metacache->addBase("minecraftforge", QDir("mods/minecraftforge").absolutePath());
+        m_metacache->addBase("fmllibs", QDir("mods/minecraftforge/libs").absolutePath());
+        m_metacache->addBase("liteloader", QDir("mods/liteloader").absolutePath());
+        m_metacache->addBase("general", QDir("cache").absolutePath());
+        m_metacache->addBase("ATLauncherPacks", QDir("cache/ATLauncherPacks").absolutePath());
+        m_metacache->addBase("FTBPacks", QDir("cache/FTBPacks").absolutePath());
+        m_metacache->addBase("ModpacksCHPacks", QDir("cache/ModpacksCHPacks").absolutePath());
+        m_metacache->addBase("TechnicPacks", QDir("cache/TechnicPacks").absolutePath());
+        m_metacache->addBase("FlamePacks", QDir("cache/FlamePacks").absolutePath());
+        m_metacache->addBase("FlameMods", QDir("cache/FlameMods").absolutePath());
+        m_metacache->addBase("ModrinthPacks", QDir("cache/ModrinthPacks").absolutePath());
+        m_metacache->addBase("ModrinthModpacks", QDir("cache/ModrinthModpacks").absolutePath());
+        m_metacache->addBase("root", QDir::currentPath());
+        m_metacache->addBase("translations", QDir("translations").absolutePath());
+        m_metacache->addBase("icons", QDir("cache/icons").absolutePath());
+        m_metacache->addBase("skins", QDir("cache/skins").absolutePath());
+        m_metacache->addBase("meta", QDir("meta").absolutePath());
+        // nothing needs the index until further down, so read it while the rest gets set up
+        metacacheLoad = QtConcurrent::run([cache = m_metacache] { cache->Load(); });
+    }
+
+    // load translations, nothing shown in headless mode needs them
+    if (!m_headless) {
         m_translations.reset(new TranslationsModel("translations"));
         auto bcp47Name = m_settings->get("Language").toString();
         m_translations->selectLanguage(bcp47Name);
         qDebug() << "Your language is" << bcp47Name;
         qDebug() << "<> Translations loaded.";
+        m_startupProfiler.mark("Translations");
     }
 
     // Instance icons
@@ -815,10 +956,14 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         connect(setting.get(), &Setting::SettingChanged,
                 [&](const Setting&, QVariant value) { m_icons->directoryChanged(value.toString()); });
         qDebug() << "<> Instance icons intialized.";
+        m_startupProfiler.mark("Instance icons");
     }
 
     // Themes
-    m_themeManager = std::make_unique<ThemeManager>();
+    if (!m_headless) {
+        m_themeManager = std::make_unique<ThemeManager>();
+        m_startupProfiler.mark("Themes");
+    }
 
     // initialize and load all instances
     {
@@ -835,6 +980,7 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         qDebug() << "Loading Instances...";
         m_instances->loadList();
         qDebug() << "<> Instances loaded.";
+        m_startupProfiler.mark("Instances");
     }
 
     // and accounts
@@ -845,38 +991,24 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_accounts->loadList();
         m_accounts->fillQueue();
         qDebug() << "<> Accounts loaded.";
+        m_startupProfiler.mark("Accounts");
     }
 
-    // init the http meta cache
+    // wait for the cache index, it was being read while everything else was set up
     {
-        m_metacache.reset(new HttpMetaCache("metacache"));
-        m_metacache->addBase("asset_indexes", QDir("assets/indexes").absolutePath());
-        m_metacache->addBase("asset_objects", QDir("assets/objects").absolutePath());
-        m_metacache->addBase("versions", QDir("versions").absolutePath());
-        m_metacache->addBase("libraries", QDir("libraries").absolutePath());
-        m_metacache->addBase("minecraftforge", QDir("mods/minecraftforge").absolutePath());
-        m_metacache->addBase("fmllibs", QDir("mods/minecraftforge/libs").absolutePath());
-        m_metacache->addBase("liteloader", QDir("mods/liteloader").absolutePath());
-        m_metacache->addBase("general", QDir("cache").absolutePath());
-        m_metacache->addBase("ATLauncherPacks", QDir("cache/ATLauncherPacks").absolutePath());
-        m_metacache->addBase("FTBPacks", QDir("cache/FTBPacks").absolutePath());
-        m_metacache->addBase("ModpacksCHPacks", QDir("cache/ModpacksCHPacks").absolutePath());
-        m_metacache->addBase("TechnicPacks", QDir("cache/TechnicPacks").absolutePath());
-        m_metacache->addBase("FlamePacks", QDir("cache/FlamePacks").absolutePath());
-        m_metacache->addBase("FlameMods", QDir("cache/FlameMods").absolutePath());
-        m_metacache->addBase("ModrinthPacks", QDir("cache/ModrinthPacks").absolutePath());
-        m_metacache->addBase("ModrinthModpacks", QDir("cache/ModrinthModpacks").absolutePath());
-        m_metacache->addBase("root", QDir::currentPath());
-        m_metacache->addBase("translations", QDir("translations").absolutePath());
-        m_metacache->addBase("icons", QDir("cache/icons").absolutePath());
-        m_metacache->addBase("meta", QDir("meta").absolutePath());
-        m_metacache->Load();
+        metacacheLoad.waitForFinished();
+        m_contentStore = std::make_shared<Net::ContentStore>(QDir("cache/blobs").absolutePath());
+        m_hashCache = std::make_shared<Hashing::HashCache>(QDir("cache").absoluteFilePath("filehashes.dat"));
+        m_javaCheckCache = std::make_shared<JavaCheckCache>(QDir("cache").absoluteFilePath("javachecks.dat"));
+        if (m_settings->get("PeerCacheEnabled").toBool()) {
+            m_peerCache.reset(new Net::PeerCache());
+            if (!m_peerCache->start())
+                m_peerCache.reset();
+        }
         qDebug() << "<> Cache initialized.";
+        m_startupProfiler.mark("Caches");
     }
 
-    // now we have network, download translation updates
-    m_translations->downloadIndex();
-
     // FIXME: what to do with these?
     m_profilers.insert("jprofiler", std::shared_ptr<BaseProfilerFactory>(new JProfilerFactory()));
     m_profilers.insert("jvisualvm", std::shared_ptr<BaseProfilerFactory>(new JVisualVMFactory()));
@@ -899,6 +1031,12 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
             // save any remaining instance state
             m_instances->saveNow();
         }
+        if (m_accounts) {
+            m_accounts->saveNow();
+        }
+        if (m_connectionPrewarmer) {
+            m_connectionPrewarmer->save();
+        }
         if (logFile) {
             logFile->flush();
             logFile->close();
@@ -909,6 +1047,12 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     detectLibraries();
 
+    if (m_headless) {
+        // the update locks and the setup wizard all need someone to click through them
+        startHeadless();
+        return;
+    }
+
     // check update locks
     {
         auto update_log_path = FS::PathCombine(m_dataPath, "logs", "prism_launcher_update.log");
@@ -1042,6 +1186,9 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
     }
 
     if (createSetupWizard()) {
+        // the language page wants to offer all the translations there are
+        m_translations->downloadIndex();
+        m_translationsIndexRequested = true;
         return;
     }
 
@@ -1049,6 +1196,15 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
     performMainStartupAction();
 }
 
+void Application::startHeadless()
+{
+    auto runner = new HeadlessRunner(m_headlessActions, this);
+    connect(runner, &HeadlessRunner::finished, this, [this](bool success) { exit(success ? 0 : 1); });
+    // only once the event loop is there to quit
+    QMetaObject::invokeMethod(runner, &HeadlessRunner::start, Qt::QueuedConnection);
+    m_status = Application::Initialized;
+}
+
 bool Application::createSetupWizard()
 {
     bool javaRequired = [&]() {
@@ -1181,6 +1337,7 @@ void Application::performMainStartupAction()
             }
 
             launch(inst, true, false, serverToJoin, accountToUse);
+            QTimer::singleShot(0, this, &Application::startDeferredSubsystems);
             return;
         }
     }
@@ -1189,6 +1346,7 @@ void Application::performMainStartupAction()
         if (inst) {
             qDebug() << "<> Showing window of instance " << m_instanceIdToShowWindowOf;
             showInstanceWindow(inst);
+            QTimer::singleShot(0, this, &Application::startDeferredSubsystems);
             return;
         }
     }
@@ -1217,6 +1375,69 @@ void Application::performMainStartupAction()
     }
 }
 
+bool Application::notify(QObject* receiver, QEvent* event)
+{
+    if (!SamplingProfiler::isEnabled()) {
+        return QApplication::notify(receiver, event);
+    }
+    SamplingProfiler::HandlerScope scope(receiver, event);
+    return QApplication::notify(receiver, event);
+}
+
+bool Application::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == m_mainWindow && event->type() == QEvent::Paint && !m_firstPaintSeen) {
+        m_firstPaintSeen = true;
+        m_mainWindow->removeEventFilter(this);
+        m_startupProfiler.mark("First paint");
+        QTimer::singleShot(0, this, &Application::startDeferredSubsystems);
+    }
+    return QApplication::eventFilter(watched, event);
+}
+
+void Application::startDeferredSubsystems()
+{
+    if (m_deferredStarted)
+        return;
+    m_deferredStarted = true;
+    if (m_mainWindow)
+        m_mainWindow->removeEventFilter(this);
+
+    // now we have a window, download translation updates
+    if (!m_translationsIndexRequested) {
+        m_translations->downloadIndex();
+        m_translationsIndexRequested = true;
+    }
+
+    // the first page opened or instance launched shouldn't wait for DNS and TLS
+    m_connectionPrewarmer->prewarm(m_network.get());
+
+    // initialize the updater
+    if (m_mainWindow && updaterEnabled()) {
+        qDebug() << "Initializing updater";
+#ifdef Q_OS_MAC
+#if defined(SPARKLE_ENABLED)
+        m_updater.reset(new MacSparkleUpdater());
+#endif
+#else
+        m_updater.reset(new PrismExternalUpdater(m_mainWindow, m_rootPath, m_dataPath));
+#endif
+        qDebug() << "<> Updater started.";
+    }
+
+    // instances are kept ready to launch while the launcher is open
+    m_launchPreparer.reset(new LaunchPreparer(this));
+
+    m_startupProfiler.mark("Deferred startup");
+
+    if (m_profileStartup) {
+        qInfo() << "Startup profile:";
+        for (auto& line : m_startupProfiler.report()) {
+            qInfo().noquote() << "    " << line;
+        }
+    }
+}
+
 void Application::showFatalErrorMessage(const QString& title, const QString& content)
 {
     m_status = Application::Failed;
@@ -1226,6 +1447,9 @@ void Application::showFatalErrorMessage(const QString& title, const QString& con
 
 Application::~Application()
 {
+    Tracing::stop();
+    SamplingProfiler::stop();
+
     // Shut down logger by setting the logger function to nothing
     qInstallMessageHandler(nullptr);
 
@@ -1246,6 +1470,10 @@ void Application::messageReceived(const QByteArray& message)
         qDebug() << "Received message" << message << "while still initializing. It will be ignored.";
         return;
     }
+    if (m_headless) {
+        qDebug() << "Received message" << message << "while running headless. It will be ignored.";
+        return;
+    }
 
     ApplicationMessage received;
     received.parse(message);
@@ -1787,8 +2015,30 @@ bool Application::handleDataMigration(const QString& currentData,
         }
     }
 
-    QMessageBox::StandardButton askMoveDialogue =
-        QMessageBox::question(nullptr, BuildConfig.LAUNCHER_DISPLAYNAME, message, QMessageBox::Yes | QMessageBox::No, QMessageBox::Yes);
+    auto method = DataMigrationTask::Method::Copy;
+    QMessageBox::StandardButton askMoveDialogue;
+    if (currentExists) {
+        askMoveDialogue =
+            QMessageBox::question(nullptr, BuildConfig.LAUNCHER_DISPLAYNAME, message, QMessageBox::Yes | QMessageBox::No, QMessageBox::Yes);
+    } else {
+        QMessageBox box(QMessageBox::Question, BuildConfig.LAUNCHER_DISPLAYNAME, message, QMessageBox::No);
+        box.setInformativeText(tr("Moving takes the data away from %1, linking has both launchers share the same files. Both are "
+                                  "immediate when the data stays on the same drive, and copy it otherwise.")
+                                   .arg(name));
+        auto copyButton = box.addButton(tr("Copy"), QMessageBox::YesRole);
+        auto moveButton = box.addButton(tr("Move"), QMessageBox::YesRole);
+        auto linkButton = box.addButton(tr("Link"), QMessageBox::YesRole);
+        box.setDefaultButton(copyButton);
+        box.exec();
+
+        askMoveDialogue = QMessageBox::Yes;
+        if (box.clickedButton() == moveButton)
+            method = DataMigrationTask::Method::Move;
+        else if (box.clickedButton() == linkButton)
+            method = DataMigrationTask::Method::Link;
+        else if (box.clickedButton() != copyButton)
+            askMoveDialogue = QMessageBox::No;
+    }
 
     auto setDoNotMigrate = [&nomigratePath] {
         QFile file(nomigratePath);
@@ -1819,7 +2069,7 @@ bool Application::handleDataMigration(const QString& currentData,
         matcher->add(std::make_shared<SimplePrefixMatcher>("themes/"));
 
         ProgressDialog diag;
-        DataMigrationTask task(nullptr, oldData, currentData, matcher);
+        DataMigrationTask task(nullptr, oldData, currentData, matcher, method);
         if (diag.execWithTask(&task)) {
             qDebug() << "<> Migration succeeded";
             setDoNotMigrate();
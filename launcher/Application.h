@@ -47,10 +47,13 @@
 
 #include <BaseInstance.h>
 
+#include "HeadlessRunner.h"
+#include "StartupProfiler.h"
 #include "minecraft/launch/MinecraftServerTarget.h"
 #include "ui/themes/CatPack.h"
 
 class LaunchController;
+class LaunchPreparer;
 class LocalPeer;
 class InstanceWindow;
 class MainWindow;
@@ -64,6 +67,7 @@ class AccountList;
 class IconList;
 class QNetworkAccessManager;
 class JavaInstallList;
+class JavaCheckCache;
 class ExternalUpdater;
 class BaseProfilerFactory;
 class BaseDetachedToolFactory;
@@ -77,6 +81,16 @@ namespace Meta {
 class Index;
 }
 
+namespace Net {
+class ConnectionPrewarmer;
+class ContentStore;
+class PeerCache;
+}
+
+namespace Hashing {
+class HashCache;
+}
+
 #if defined(APPLICATION)
 #undef APPLICATION
 #endif
@@ -103,6 +117,8 @@ class Application : public QApplication {
     virtual ~Application();
 
     bool event(QEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    bool notify(QObject* receiver, QEvent* event) override;
 
     std::shared_ptr<SettingsObject> settings() const { return m_settings; }
 
@@ -114,6 +130,9 @@ class Application : public QApplication {
 
     shared_qobject_ptr<ExternalUpdater> updater() { return m_updater; }
 
+    /// null until the launcher has finished starting up, and when it runs without a window
+    LaunchPreparer* launchPreparer() const { return m_launchPreparer.get(); }
+
     void triggerUpdateCheck();
 
     std::shared_ptr<TranslationsModel> translations();
@@ -138,6 +157,17 @@ class Application : public QApplication {
 
     shared_qobject_ptr<HttpMetaCache> metacache();
 
+    std::shared_ptr<Net::ContentStore> contentStore() const { return m_contentStore; }
+
+    /// null unless sharing downloads with peers on the network is enabled
+    shared_qobject_ptr<Net::PeerCache> peerCache() const { return m_peerCache; }
+
+    std::shared_ptr<Net::ConnectionPrewarmer> connectionPrewarmer() const { return m_connectionPrewarmer; }
+
+    std::shared_ptr<Hashing::HashCache> hashCache() const { return m_hashCache; }
+
+    std::shared_ptr<JavaCheckCache> javaCheckCache() const { return m_javaCheckCache; }
+
     shared_qobject_ptr<Meta::Index> metadataIndex();
 
     void updateCapabilities();
@@ -217,6 +247,10 @@ class Application : public QApplication {
     bool handleDataMigration(const QString& currentData, const QString& oldData, const QString& name, const QString& configFile) const;
     bool createSetupWizard();
     void performMainStartupAction();
+    /* Does what was asked for with --headless instead of showing any window, and quits once done. */
+    void startHeadless();
+    /* Starts what isn't needed to show the first window, once it has been shown. */
+    void startDeferredSubsystems();
 
     // sets the fatal error message and m_status to Failed.
     void showFatalErrorMessage(const QString& title, const QString& content);
@@ -228,13 +262,24 @@ class Application : public QApplication {
 
    private:
     QDateTime startTime;
+    StartupProfiler m_startupProfiler;
+    bool m_profileStartup = false;
+    bool m_firstPaintSeen = false;
+    bool m_deferredStarted = false;
+    bool m_translationsIndexRequested = false;
 
     shared_qobject_ptr<QNetworkAccessManager> m_network;
 
     shared_qobject_ptr<ExternalUpdater> m_updater;
+    shared_qobject_ptr<LaunchPreparer> m_launchPreparer;
     shared_qobject_ptr<AccountList> m_accounts;
 
     shared_qobject_ptr<HttpMetaCache> m_metacache;
+    std::shared_ptr<Net::ContentStore> m_contentStore;
+    shared_qobject_ptr<Net::PeerCache> m_peerCache;
+    std::shared_ptr<Net::ConnectionPrewarmer> m_connectionPrewarmer;
+    std::shared_ptr<Hashing::HashCache> m_hashCache;
+    std::shared_ptr<JavaCheckCache> m_javaCheckCache;
     shared_qobject_ptr<Meta::Index> m_metadataIndex;
 
     std::shared_ptr<SettingsObject> m_settings;
@@ -293,5 +338,7 @@ class Application : public QApplication {
     bool m_liveCheck = false;
     QList<QUrl> m_urlsToImport;
     QString m_instanceIdToShowWindowOf;
+    bool m_headless = false;
+    HeadlessRunner::Actions m_headlessActions;
     std::unique_ptr<QFile> logFile;
 };
@@ -51,6 +51,7 @@
 #include "BuildConfig.h"
 #include "Commandline.h"
 #include "FileSystem.h"
+#include "tasks/CpuExecutor.h"
 
 BaseInstance::BaseInstance(SettingsObjectPtr globalSettings, SettingsObjectPtr settings, const QString& rootDir) : QObject()
 {
@@ -69,6 +70,7 @@ BaseInstance::BaseInstance(SettingsObjectPtr globalSettings, SettingsObjectPtr s
     m_settings->registerSetting("lastTimePlayed", 0);
 
     m_settings->registerSetting("linkedInstances", "[]");
+    m_settings->registerSetting("overlayBaseInstance", "");
 
     // Game time override
     auto gameTimeOverride = m_settings->registerSetting("OverrideGameTime", false);
@@ -225,6 +227,16 @@ bool BaseInstance::isLinkedToInstanceId(const QString& id) const
     return linkedInstances.contains(id);
 }
 
+QString BaseInstance::overlayBaseId() const
+{
+    return m_settings->get("overlayBaseInstance").toString();
+}
+
+void BaseInstance::setOverlayBaseId(const QString& id)
+{
+    m_settings->set("overlayBaseInstance", id);
+}
+
 void BaseInstance::iconUpdated(QString key)
 {
     if (iconKey() == key) {
@@ -268,6 +280,8 @@ void BaseInstance::setRunning(bool running)
         return;
 
     m_isRunning = running;
+    // background work makes way for the game while it runs
+    CpuExecutor::setGameRunning(running);
 
     if (!m_settings->get("RecordGameTime").toBool()) {
         emit runningStatusChanged(running);
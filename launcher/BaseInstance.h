@@ -49,6 +49,7 @@
 
 #include "BaseVersionList.h"
 #include "MessageLevel.h"
+#include "launch/LogLevelClassifier.h"
 #include "minecraft/auth/MinecraftAccount.h"
 #include "pathmatcher/IPathMatcher.h"
 #include "settings/INIFile.h"
@@ -147,8 +148,8 @@ class BaseInstance : public QObject, public std::enable_shared_from_this<BaseIns
     void setManagedPack(const QString& type, const QString& id, const QString& name, const QString& versionId, const QString& version);
     void copyManagedPack(BaseInstance& other);
 
-    /// guess log level from a line of game log
-    virtual MessageLevel::Enum guessLevel([[maybe_unused]] const QString& line, MessageLevel::Enum level) { return level; }
+    /// classifier guessing the log level of lines of game log, nullptr if the log format is unknown
+    virtual LogLevelClassifier::Ptr getLogLevelClassifier() { return nullptr; }
 
     virtual QStringList extraArguments();
 
@@ -268,6 +269,10 @@ class BaseInstance : public QObject, public std::enable_shared_from_this<BaseIns
     bool removeLinkedInstanceId(const QString& id);
     bool isLinkedToInstanceId(const QString& id) const;
 
+    /// the instance whose game folder this one shares through links, empty if it has a game folder of its own
+    QString overlayBaseId() const;
+    void setOverlayBaseId(const QString& id);
+
    protected:
     void changeStatus(Status newStatus);
 
@@ -0,0 +1,277 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "CacheCleanupTask.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <vector>
+
+#include "Application.h"
+#include "FileSystem.h"
+#include "InstanceList.h"
+#include "StringUtils.h"
+#include "minecraft/AssetsUtils.h"
+#include "minecraft/Component.h"
+#include "minecraft/MinecraftInstance.h"
+#include "minecraft/PackProfile.h"
+#include "net/HttpMetaCache.h"
+#include "tasks/CpuExecutor.h"
+
+namespace {
+
+// bases whose files are kept exactly when an instance uses them
+const QStringList REFERENCED_BASES = { "libraries", "asset_objects", "asset_indexes" };
+// files nothing keeps track of, which old instances may still need
+const QStringList KEPT_BASES = { "root", "translations", "versions", "minecraftforge", "fmllibs", "liteloader" };
+
+// anything written more recently may belong to an instance that is still being created
+constexpr qint64 GRACE_PERIOD_SECS = 24 * 60 * 60;
+
+}  // namespace
+
+CacheCleanupTask::CacheCleanupTask(qint64 budget, QObject* parent) : Task(parent), m_budget(budget)
+{
+    connect(&m_watcher, &QFutureWatcher<Result>::finished, this, &CacheCleanupTask::cleaned);
+}
+
+QString CacheCleanupTask::summary() const
+{
+    QStringList lines;
+    lines << tr("Removed %n unused file(s), %1.", "", m_report.unusedRemoved).arg(StringUtils::humanReadableFileSize(m_report.unusedBytes));
+    lines << tr("Removed %n old download(s), %1.", "", m_report.evicted).arg(StringUtils::humanReadableFileSize(m_report.evictedBytes));
+    lines << tr("%1 of downloads are left in the cache.").arg(StringUtils::humanReadableFileSize(m_report.cacheBytes));
+    if (m_report.failures > 0)
+        lines << tr("%n file(s) could not be removed.", "", m_report.failures);
+    if (!m_report.keptUnusedReason.isEmpty())
+        lines << tr("Unused libraries and assets were kept: %1").arg(m_report.keptUnusedReason);
+    return lines.join('\n');
+}
+
+void CacheCleanupTask::executeTask()
+{
+    m_nextInstance = 0;
+    m_references.clear();
+    m_assetIndexes.clear();
+    m_keptUnusedReason.clear();
+    setStatus(tr("Finding what instances use"));
+    nextInstance();
+}
+
+void CacheCleanupTask::nextInstance()
+{
+    auto instances = APPLICATION->instances();
+    while (m_nextInstance < instances->count()) {
+        setProgress(m_nextInstance, instances->count());
+        auto inst = std::dynamic_pointer_cast<MinecraftInstance>(instances->at(m_nextInstance++));
+        if (!inst)
+            continue;
+
+        // the components have to be resolved to know which libraries they need
+        auto components = inst->getPackProfile();
+        if (!components->getCurrentTask())
+            components->reload(Net::Mode::Offline);
+        if (auto resolving = components->getCurrentTask()) {
+            connect(resolving.get(), &Task::finished, this, [this, inst] {
+                collectReferences(inst.get());
+                nextInstance();
+            });
+            return;
+        }
+        collectReferences(inst.get());
+    }
+    clean();
+}
+
+void CacheCleanupTask::collectReferences(MinecraftInstance* inst)
+{
+    auto profile = inst->getPackProfile()->getProfile();
+    if (!profile || profile->getProblemSeverity() == ProblemSeverity::Error) {
+        qWarning() << "Could not resolve the components of" << inst->name() << "to find the files it uses";
+        if (m_keptUnusedReason.isEmpty())
+            m_keptUnusedReason = tr("the components of %1 could not be loaded.").arg(inst->name());
+        return;
+    }
+
+    auto metacache = APPLICATION->metacache();
+    QList<LibraryPtr> libraries;
+    libraries.append(profile->getLibraries());
+    libraries.append(profile->getNativeLibraries());
+    libraries.append(profile->getMavenFiles());
+    for (auto agent : profile->getAgents())
+        libraries.append(agent->library());
+    libraries.append(profile->getMainJar());
+    for (auto& library : libraries) {
+        if (!library)
+            continue;
+        for (auto& file : library->getDownloadFiles(inst->runtimeContext(), metacache.get(), inst->getLocalLibraryPath()))
+            m_references.insert(QDir::cleanPath(file));
+    }
+
+    if (auto assets = profile->getMinecraftAssets())
+        m_assetIndexes.insert(assets->id);
+
+    // the metadata the components were resolved from, so they resolve offline again
+    auto components = inst->getPackProfile();
+    auto metaPath = metacache->getBasePath("meta");
+    for (int i = 0; i < components->rowCount(); i++) {
+        auto component = components->getComponent(static_cast<size_t>(i));
+        m_references.insert(QDir::cleanPath(FS::PathCombine(metaPath, component->getID(), component->getVersion() + ".json")));
+    }
+}
+
+void CacheCleanupTask::clean()
+{
+    setStatus(tr("Removing unused downloads"));
+    setProgress(0, 0);
+
+    // the metacache is only to be touched here, so everything the worker needs from it is gathered first
+    auto metacache = APPLICATION->metacache();
+    bool haveReferences = m_keptUnusedReason.isEmpty();
+    QList<CacheFile> entries;
+    QList<CacheFile> roots;
+    for (auto& base : metacache->getBases()) {
+        if (KEPT_BASES.contains(base))
+            continue;
+        bool referenced = REFERENCED_BASES.contains(base);
+        if (!haveReferences && (referenced || base == "meta"))
+            continue;
+        if (referenced) {
+            // these are looked through as folders, files downloaded without the metacache are just as unused
+            roots.append({ base, {}, metacache->getBasePath(base) });
+            continue;
+        }
+        for (auto& entry : metacache->getEntries(base)) {
+            // the version lists are what picking a version from works off
+            if (base == "meta" && QFileInfo(entry->getRelativePath()).fileName() == "index.json")
+                continue;
+            entries.append({ base, entry->getRelativePath(), QDir::cleanPath(entry->getFullPath()) });
+        }
+    }
+
+    m_watcher.setFuture(CpuExecutor::run(CpuExecutor::Priority::Background,
+                                         [budget = m_budget, references = m_references, assetIndexes = m_assetIndexes,
+                                          reason = m_keptUnusedReason, entries, roots] {
+                                             CpuExecutor::YieldToGame yield;
+                                             return cleanUp(budget, references, assetIndexes, reason, entries, roots);
+                                         }));
+}
+
+auto CacheCleanupTask::cleanUp(qint64 budget,
+                               QSet<QString> references,
+                               QSet<QString> assetIndexes,
+                               QString keptUnusedReason,
+                               QList<CacheFile> entries,
+                               QList<CacheFile> roots) -> Result
+{
+    Result out;
+    auto& report = out.report;
+    auto cutoff = QDateTime::currentDateTimeUtc().addSecs(-GRACE_PERIOD_SECS);
+
+    // the objects of the asset indexes in use are used as well
+    auto rootOf = [&roots](const QString& base) {
+        auto it = std::find_if(roots.begin(), roots.end(), [&base](const CacheFile& root) { return root.base == base; });
+        return it == roots.end() ? QString() : it->path;
+    };
+    auto indexesPath = rootOf("asset_indexes");
+    auto objectsPath = rootOf("asset_objects");
+    if (keptUnusedReason.isEmpty() && !indexesPath.isEmpty()) {
+        for (auto& id : assetIndexes) {
+            auto indexPath = QDir::cleanPath(FS::PathCombine(indexesPath, id + ".json"));
+            references.insert(indexPath);
+            AssetsIndex index;
+            if (!AssetsUtils::loadAssetsIndexJson(id, indexPath, index)) {
+                keptUnusedReason = tr("the asset index %1 could not be read.").arg(id);
+                break;
+            }
+            for (auto& object : index.objects)
+                references.insert(QDir::cleanPath(FS::PathCombine(objectsPath, object.second.getRelPath())));
+        }
+    }
+    report.keptUnusedReason = keptUnusedReason;
+
+    auto remove = [&](const CacheFile& file) {
+        if (!QFile::remove(file.path)) {
+            qWarning() << "Failed to remove" << file.path << "from the cache";
+            report.failures++;
+            return false;
+        }
+        out.removed.append(file);
+        return true;
+    };
+
+    if (keptUnusedReason.isEmpty()) {
+        for (auto& root : roots) {
+            QDir rootDir(root.path);
+            QDirIterator iter(root.path, QDir::Files | QDir::Hidden | QDir::System, QDirIterator::Subdirectories);
+            while (iter.hasNext()) {
+                QFileInfo info(iter.next());
+                auto path = QDir::cleanPath(info.absoluteFilePath());
+                if (references.contains(path) || info.lastModified().toUTC() > cutoff)
+                    continue;
+                auto size = info.size();
+                if (remove({ root.base, rootDir.relativeFilePath(path), path })) {
+                    report.unusedRemoved++;
+                    report.unusedBytes += size;
+                }
+            }
+            // and the folders that were left empty, deepest first
+            QStringList folders;
+            QDirIterator dirs(root.path, QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+            while (dirs.hasNext())
+                folders.append(dirs.next());
+            std::sort(folders.begin(), folders.end(), [](const QString& a, const QString& b) { return a.size() > b.size(); });
+            for (auto& folder : folders)
+                rootDir.rmdir(folder);
+        }
+    }
+
+    // the rest goes least recently used first, until it fits the budget
+    struct Candidate {
+        const CacheFile* file;
+        qint64 size;
+        QDateTime used;
+    };
+    std::vector<Candidate> candidates;
+    for (auto& entry : entries) {
+        if (references.contains(entry.path))
+            continue;
+        QFileInfo info(entry.path);
+        if (!info.isFile())
+            continue;
+        auto used = std::max(info.lastModified(), info.lastRead());
+        candidates.push_back({ &entry, info.size(), used });
+        report.cacheBytes += info.size();
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.used < b.used; });
+    for (auto& candidate : candidates) {
+        if (report.cacheBytes <= budget)
+            break;
+        if (remove(*candidate.file)) {
+            report.evicted++;
+            report.evictedBytes += candidate.size;
+            report.cacheBytes -= candidate.size;
+        }
+    }
+    return out;
+}
+
+void CacheCleanupTask::cleaned()
+{
+    auto result = m_watcher.result();
+    m_report = result.report;
+
+    auto metacache = APPLICATION->metacache();
+    for (auto& file : result.removed)
+        metacache->removeEntry(file.base, file.relativePath);
+
+    qDebug() << "Cache cleaned up:" << summary();
+    emitSucceeded();
+}
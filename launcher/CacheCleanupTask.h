@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+#include "tasks/Task.h"
+
+class MinecraftInstance;
+
+/** Removes downloads the launcher no longer needs.
+ *
+ *  Libraries, asset objects and asset indexes that no instance uses are deleted outright. Then, while the rest of the
+ *  downloads the metacache knows about take up more than the budget, the least recently used of them go, leaving
+ *  alone anything an instance needs to launch offline.
+ *
+ *  What an instance uses is only known once its components are resolved. When that fails for any instance, unused
+ *  libraries and assets are kept, as well as all metadata.
+ */
+class CacheCleanupTask : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<CacheCleanupTask>;
+
+    struct Report {
+        int unusedRemoved = 0;
+        qint64 unusedBytes = 0;
+        int evicted = 0;
+        qint64 evictedBytes = 0;
+        // what is left in the cache, not counting what instances use
+        qint64 cacheBytes = 0;
+        int failures = 0;
+        // why unused libraries and assets were kept, if they were
+        QString keptUnusedReason;
+    };
+
+    /* 'budget' is how many bytes of downloads to keep, besides what the instances use. */
+    explicit CacheCleanupTask(qint64 budget, QObject* parent = nullptr);
+
+    const Report& report() const { return m_report; }
+    /* The report, in words. */
+    QString summary() const;
+
+   protected:
+    void executeTask() override;
+
+   private:
+    struct CacheFile {
+        QString base;
+        QString relativePath;
+        QString path;
+    };
+    struct Result {
+        Report report;
+        QList<CacheFile> removed;
+    };
+
+    void nextInstance();
+    void collectReferences(MinecraftInstance* inst);
+    void clean();
+    void cleaned();
+
+    static Result cleanUp(qint64 budget,
+                          QSet<QString> references,
+                          QSet<QString> assetIndexes,
+                          QString keptUnusedReason,
+                          QList<CacheFile> entries,
+                          QList<CacheFile> roots);
+
+   private:
+    qint64 m_budget;
+    int m_nextInstance = 0;
+
+    // the files instances use, as clean absolute paths
+    QSet<QString> m_references;
+    QSet<QString> m_assetIndexes;
+    QString m_keptUnusedReason;
+
+    QFutureWatcher<Result> m_watcher;
+    Report m_report;
+};
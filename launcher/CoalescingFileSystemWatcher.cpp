@@ -0,0 +1,50 @@
+#include "CoalescingFileSystemWatcher.h"
+
+CoalescingFileSystemWatcher::CoalescingFileSystemWatcher(QObject* parent) : QObject(parent), m_watcher(this), m_quiet_timer(this)
+{
+    m_quiet_timer.setSingleShot(true);
+    connect(&m_quiet_timer, &QTimer::timeout, this, &CoalescingFileSystemWatcher::flush);
+
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &CoalescingFileSystemWatcher::pathChanged);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &CoalescingFileSystemWatcher::pathChanged);
+}
+
+QStringList CoalescingFileSystemWatcher::addPaths(const QStringList& paths)
+{
+    return m_watcher.addPaths(paths);
+}
+
+QStringList CoalescingFileSystemWatcher::removePaths(const QStringList& paths)
+{
+    auto failed = m_watcher.removePaths(paths);
+
+    // Nobody is interested in these anymore
+    for (auto const& path : paths)
+        if (!failed.contains(path))
+            m_pending.remove(path);
+    if (m_pending.isEmpty())
+        m_quiet_timer.stop();
+
+    return failed;
+}
+
+void CoalescingFileSystemWatcher::pathChanged(const QString& path)
+{
+    if (m_pending.isEmpty())
+        m_batch_age.start();
+    m_pending.insert(path);
+
+    auto remaining = m_max_delay - static_cast<int>(m_batch_age.elapsed());
+    m_quiet_timer.start(qMax(0, qMin(m_quiet_period, remaining)));
+}
+
+void CoalescingFileSystemWatcher::flush()
+{
+    m_quiet_timer.stop();
+    if (m_pending.isEmpty())
+        return;
+
+    QSet<QString> changed;
+    changed.swap(m_pending);
+    emit pathsChanged(changed);
+}
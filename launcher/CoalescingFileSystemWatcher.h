@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFileSystemWatcher>
+#include <QSet>
+#include <QTimer>
+
+/** A QFileSystemWatcher that batches change notifications.
+ *
+ *  Writing a bunch of files to a watched directory (e.g. installing a modpack update) makes QFileSystemWatcher
+ *  fire once per file. This instead waits until the paths have been quiet for a while, and then reports every
+ *  path that changed in the meantime at once.
+ *  To not starve the listeners when something keeps writing, a batch is never held back longer than maxDelay().
+ */
+class CoalescingFileSystemWatcher : public QObject {
+    Q_OBJECT
+   public:
+    static constexpr int s_default_quiet_period = 250;
+    static constexpr int s_default_max_delay = 2000;
+
+    explicit CoalescingFileSystemWatcher(QObject* parent = nullptr);
+
+    /** Same as QFileSystemWatcher's. Returns the paths that couldn't be watched. */
+    QStringList addPaths(const QStringList& paths);
+    QStringList removePaths(const QStringList& paths);
+    bool addPath(const QString& path) { return addPaths({ path }).isEmpty(); }
+    bool removePath(const QString& path) { return removePaths({ path }).isEmpty(); }
+
+    /** How long, in milliseconds, nothing must change before a batch is reported. */
+    void setQuietPeriod(int msecs) { m_quiet_period = msecs; }
+    [[nodiscard]] int quietPeriod() const { return m_quiet_period; }
+
+    /** The longest, in milliseconds, a change can wait before being reported. */
+    void setMaxDelay(int msecs) { m_max_delay = msecs; }
+    [[nodiscard]] int maxDelay() const { return m_max_delay; }
+
+    /** Reports the pending changes right away, if there are any. */
+    void flush();
+
+    /** Whether something changed that wasn't reported yet. */
+    [[nodiscard]] bool hasPendingChanges() const { return !m_pending.isEmpty(); }
+
+   signals:
+    /** Emitted with every watched path, file or directory, that changed since the last batch. */
+    void pathsChanged(QSet<QString> paths);
+
+   private slots:
+    void pathChanged(const QString& path);
+
+   private:
+    QFileSystemWatcher m_watcher;
+    QTimer m_quiet_timer;
+    QElapsedTimer m_batch_age;
+    QSet<QString> m_pending;
+
+    int m_quiet_period = s_default_quiet_period;
+    int m_max_delay = s_default_max_delay;
+};
@@ -0,0 +1,376 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "CryptoHash.h"
+
+#include <QIODevice>
+
+#include <algorithm>
+#include <cstring>
+
+#include <cpufeatures.h>
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && \
+    (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__))
+#define CRYPTOHASH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CRYPTOHASH_TARGET
+#else
+#define CRYPTOHASH_TARGET __attribute__((target("sha,sse4.1")))
+#endif
+// the intrinsics need to be enabled per function, the ARM ones for the whole build
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define CRYPTOHASH_ARM
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr qint64 READ_CHUNK_SIZE = 256 * 1024;
+
+const uint32_t SHA1_INIT[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+const uint32_t SHA256_INIT[8] = { 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19 };
+
+[[maybe_unused]] alignas(16) const uint32_t SHA256_K[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE,
+    0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA,
+    0x5CB0A9DC, 0x76F988DA, 0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967, 0x27B70A85,
+    0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+    0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070, 0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F,
+    0x682E6FF3, 0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+#if defined(CRYPTOHASH_X86)
+
+/* Each step is four rounds, and works out the message words four steps ahead. */
+#define SHA1_STEP(i, f, W, NEXT, AFTER, BEFORE)                                       \
+    e = (i) == 0 ? _mm_add_epi32(e, W) : _mm_sha1nexte_epu32(previous, W);           \
+    previous = abcd;                                                                  \
+    if ((i) >= 3 && (i) <= 18)                                                        \
+        NEXT = _mm_sha1msg2_epu32(NEXT, W);                                           \
+    abcd = _mm_sha1rnds4_epu32(abcd, e, f);                                           \
+    if ((i) >= 1 && (i) <= 16)                                                        \
+        BEFORE = _mm_sha1msg1_epu32(BEFORE, W);                                       \
+    if ((i) >= 2 && (i) <= 17)                                                        \
+        AFTER = _mm_xor_si128(AFTER, W);
+
+CRYPTOHASH_TARGET void sha1Blocks(uint32_t* state, const unsigned char* blocks, size_t count)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+    __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+    for (; count > 0; count--, blocks += 64) {
+        auto abcdSaved = abcd;
+        auto e0Saved = e0;
+        auto m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks)), byteSwap);
+        auto m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16)), byteSwap);
+        auto m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 32)), byteSwap);
+        auto m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 48)), byteSwap);
+        __m128i e = e0;
+        __m128i previous = abcd;
+
+        SHA1_STEP(0, 0, m0, m1, m2, m3)
+        SHA1_STEP(1, 0, m1, m2, m3, m0)
+        SHA1_STEP(2, 0, m2, m3, m0, m1)
+        SHA1_STEP(3, 0, m3, m0, m1, m2)
+        SHA1_STEP(4, 0, m0, m1, m2, m3)
+        SHA1_STEP(5, 1, m1, m2, m3, m0)
+        SHA1_STEP(6, 1, m2, m3, m0, m1)
+        SHA1_STEP(7, 1, m3, m0, m1, m2)
+        SHA1_STEP(8, 1, m0, m1, m2, m3)
+        SHA1_STEP(9, 1, m1, m2, m3, m0)
+        SHA1_STEP(10, 2, m2, m3, m0, m1)
+        SHA1_STEP(11, 2, m3, m0, m1, m2)
+        SHA1_STEP(12, 2, m0, m1, m2, m3)
+        SHA1_STEP(13, 2, m1, m2, m3, m0)
+        SHA1_STEP(14, 2, m2, m3, m0, m1)
+        SHA1_STEP(15, 3, m3, m0, m1, m2)
+        SHA1_STEP(16, 3, m0, m1, m2, m3)
+        SHA1_STEP(17, 3, m1, m2, m3, m0)
+        SHA1_STEP(18, 3, m2, m3, m0, m1)
+        SHA1_STEP(19, 3, m3, m0, m1, m2)
+
+        e0 = _mm_sha1nexte_epu32(previous, e0Saved);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+#undef SHA1_STEP
+
+#define SHA256_STEP(i, W, NEXT, BEFORE)                                                                  \
+    msg = _mm_add_epi32(W, _mm_load_si128(reinterpret_cast<const __m128i*>(SHA256_K + 4 * (i))));     \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                                               \
+    if ((i) >= 3 && (i) <= 14) {                                                                       \
+        NEXT = _mm_add_epi32(NEXT, _mm_alignr_epi8(W, BEFORE, 4));                                     \
+        NEXT = _mm_sha256msg2_epu32(NEXT, W);                                                          \
+    }                                                                                                  \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));                      \
+    if ((i) >= 1 && (i) <= 12)                                                                         \
+        BEFORE = _mm_sha256msg1_epu32(BEFORE, W);
+
+CRYPTOHASH_TARGET void sha256Blocks(uint32_t* state, const unsigned char* blocks, size_t count)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // the instructions want the state as ABEF and CDGH
+    auto dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+    auto efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+    auto state0 = _mm_alignr_epi8(dcba, efgh, 8);
+    auto state1 = _mm_blend_epi16(efgh, dcba, 0xF0);
+
+    for (; count > 0; count--, blocks += 64) {
+        auto state0Saved = state0;
+        auto state1Saved = state1;
+        auto m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks)), byteSwap);
+        auto m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16)), byteSwap);
+        auto m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 32)), byteSwap);
+        auto m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 48)), byteSwap);
+        __m128i msg;
+
+        SHA256_STEP(0, m0, m1, m3)
+        SHA256_STEP(1, m1, m2, m0)
+        SHA256_STEP(2, m2, m3, m1)
+        SHA256_STEP(3, m3, m0, m2)
+        SHA256_STEP(4, m0, m1, m3)
+        SHA256_STEP(5, m1, m2, m0)
+        SHA256_STEP(6, m2, m3, m1)
+        SHA256_STEP(7, m3, m0, m2)
+        SHA256_STEP(8, m0, m1, m3)
+        SHA256_STEP(9, m1, m2, m0)
+        SHA256_STEP(10, m2, m3, m1)
+        SHA256_STEP(11, m3, m0, m2)
+        SHA256_STEP(12, m0, m1, m3)
+        SHA256_STEP(13, m1, m2, m0)
+        SHA256_STEP(14, m2, m3, m1)
+        SHA256_STEP(15, m3, m0, m2)
+
+        state0 = _mm_add_epi32(state0, state0Saved);
+        state1 = _mm_add_epi32(state1, state1Saved);
+    }
+
+    auto feba = _mm_shuffle_epi32(state0, 0x1B);
+    auto dchg = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#undef SHA256_STEP
+
+bool haveShaInstructions()
+{
+    auto& features = Sys::getCpuFeatures();
+    return features.sha && features.sse42;
+}
+
+#elif defined(CRYPTOHASH_ARM)
+
+uint32x4_t loadWords(const unsigned char* data)
+{
+    return vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+}
+
+void sha1Blocks(uint32_t* state, const unsigned char* blocks, size_t count)
+{
+    const uint32_t k[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+    auto abcd = vld1q_u32(state);
+    auto e0 = state[4];
+
+    for (; count > 0; count--, blocks += 64) {
+        auto abcdSaved = abcd;
+        auto e0Saved = e0;
+        uint32x4_t w[4] = { loadWords(blocks), loadWords(blocks + 16), loadWords(blocks + 32), loadWords(blocks + 48) };
+        auto e = e0;
+
+        // four rounds at a time, working out the message words four steps ahead
+        for (int i = 0; i < 20; i++) {
+            auto& current = w[i % 4];
+            auto words = vaddq_u32(current, vdupq_n_u32(k[i / 5]));
+            auto nextE = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (i < 5)
+                abcd = vsha1cq_u32(abcd, e, words);
+            else if (i < 10 || i >= 15)
+                abcd = vsha1pq_u32(abcd, e, words);
+            else
+                abcd = vsha1mq_u32(abcd, e, words);
+            e = nextE;
+            if (i < 16)
+                current = vsha1su1q_u32(vsha1su0q_u32(current, w[(i + 1) % 4], w[(i + 2) % 4]), w[(i + 3) % 4]);
+        }
+
+        e0 = e + e0Saved;
+        abcd = vaddq_u32(abcd, abcdSaved);
+    }
+
+    vst1q_u32(state, abcd);
+    state[4] = e0;
+}
+
+void sha256Blocks(uint32_t* state, const unsigned char* blocks, size_t count)
+{
+    auto state0 = vld1q_u32(state);
+    auto state1 = vld1q_u32(state + 4);
+
+    for (; count > 0; count--, blocks += 64) {
+        auto state0Saved = state0;
+        auto state1Saved = state1;
+        uint32x4_t w[4] = { loadWords(blocks), loadWords(blocks + 16), loadWords(blocks + 32), loadWords(blocks + 48) };
+
+        for (int i = 0; i < 16; i++) {
+            auto& current = w[i % 4];
+            auto words = vaddq_u32(current, vld1q_u32(SHA256_K + 4 * i));
+            if (i < 12)
+                current = vsha256su1q_u32(vsha256su0q_u32(current, w[(i + 1) % 4]), w[(i + 2) % 4], w[(i + 3) % 4]);
+            auto previous = state0;
+            state0 = vsha256hq_u32(state0, state1, words);
+            state1 = vsha256h2q_u32(state1, previous, words);
+        }
+
+        state0 = vaddq_u32(state0, state0Saved);
+        state1 = vaddq_u32(state1, state1Saved);
+    }
+
+    vst1q_u32(state, state0);
+    vst1q_u32(state + 4, state1);
+}
+
+bool haveShaInstructions()
+{
+    return Sys::getCpuFeatures().armSha2;
+}
+
+#endif
+
+CryptoHash::BlockFunction blockFunctionFor(QCryptographicHash::Algorithm algorithm)
+{
+#if defined(CRYPTOHASH_X86) || defined(CRYPTOHASH_ARM)
+    static const auto hardware = haveShaInstructions();
+    static const auto sha1 = Sys::pickKernel<CryptoHash::BlockFunction>({ { hardware, sha1Blocks } }, nullptr);
+    static const auto sha256 = Sys::pickKernel<CryptoHash::BlockFunction>({ { hardware, sha256Blocks } }, nullptr);
+    switch (algorithm) {
+        case QCryptographicHash::Sha1:
+            return sha1;
+        case QCryptographicHash::Sha256:
+            return sha256;
+        default:
+            return nullptr;
+    }
+#else
+    Q_UNUSED(algorithm);
+    return nullptr;
+#endif
+}
+
+}  // namespace
+
+CryptoHash::CryptoHash(QCryptographicHash::Algorithm algorithm) : m_algorithm(algorithm), m_blocks(blockFunctionFor(algorithm))
+{
+    if (!m_blocks)
+        m_fallback = std::make_unique<QCryptographicHash>(algorithm);
+    reset();
+}
+
+CryptoHash::~CryptoHash() = default;
+
+bool CryptoHash::isAccelerated(QCryptographicHash::Algorithm algorithm)
+{
+    return blockFunctionFor(algorithm) != nullptr;
+}
+
+void CryptoHash::reset()
+{
+    if (m_fallback) {
+        m_fallback->reset();
+        return;
+    }
+    if (m_algorithm == QCryptographicHash::Sha1)
+        std::memcpy(m_state, SHA1_INIT, sizeof(SHA1_INIT));
+    else
+        std::memcpy(m_state, SHA256_INIT, sizeof(SHA256_INIT));
+    m_length = 0;
+    m_buffered = 0;
+}
+
+void CryptoHash::addData(const char* data, qsizetype length)
+{
+    if (m_fallback) {
+        m_fallback->addData(QByteArray::fromRawData(data, length));
+        return;
+    }
+    if (length <= 0)
+        return;
+
+    auto bytes = reinterpret_cast<const unsigned char*>(data);
+    m_length += static_cast<uint64_t>(length);
+    if (m_buffered > 0) {
+        auto taken = std::min<qsizetype>(length, 64 - m_buffered);
+        std::memcpy(m_buffer + m_buffered, bytes, static_cast<size_t>(taken));
+        m_buffered += static_cast<int>(taken);
+        bytes += taken;
+        length -= taken;
+        if (m_buffered < 64)
+            return;
+        m_blocks(m_state, m_buffer, 1);
+        m_buffered = 0;
+    }
+    auto blocks = static_cast<size_t>(length / 64);
+    if (blocks > 0)
+        m_blocks(m_state, bytes, blocks);
+    auto left = static_cast<int>(length % 64);
+    std::memcpy(m_buffer, bytes + blocks * 64, static_cast<size_t>(left));
+    m_buffered = left;
+}
+
+bool CryptoHash::addData(QIODevice* device)
+{
+    if (m_fallback)
+        return m_fallback->addData(device);
+    if (!device->isReadable())
+        return false;
+
+    QByteArray chunk(READ_CHUNK_SIZE, Qt::Uninitialized);
+    qint64 read;
+    while ((read = device->read(chunk.data(), READ_CHUNK_SIZE)) > 0)
+        addData(chunk.constData(), read);
+    return read == 0 || device->atEnd();
+}
+
+QByteArray CryptoHash::result() const
+{
+    if (m_fallback)
+        return m_fallback->result();
+
+    // the padding goes through a copy, so more data can still be added
+    uint32_t state[8];
+    std::memcpy(state, m_state, sizeof(state));
+    unsigned char tail[128] = {};
+    std::memcpy(tail, m_buffer, static_cast<size_t>(m_buffered));
+    tail[m_buffered] = 0x80;
+    int tailSize = m_buffered < 56 ? 64 : 128;
+    auto bits = m_length * 8;
+    for (int i = 0; i < 8; i++)
+        tail[tailSize - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+    m_blocks(state, tail, static_cast<size_t>(tailSize / 64));
+
+    int words = m_algorithm == QCryptographicHash::Sha1 ? 5 : 8;
+    QByteArray digest(words * 4, Qt::Uninitialized);
+    for (int i = 0; i < words; i++) {
+        digest[4 * i] = static_cast<char>(state[i] >> 24);
+        digest[4 * i + 1] = static_cast<char>(state[i] >> 16);
+        digest[4 * i + 2] = static_cast<char>(state[i] >> 8);
+        digest[4 * i + 3] = static_cast<char>(state[i]);
+    }
+    return digest;
+}
+
+QByteArray CryptoHash::hash(const QByteArray& data, QCryptographicHash::Algorithm algorithm)
+{
+    CryptoHash hash(algorithm);
+    hash.addData(data);
+    return hash.result();
+}
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QCryptographicHash>
+
+#include <cstdint>
+#include <memory>
+
+class QIODevice;
+
+/** A QCryptographicHash that does SHA-1 and SHA-256 with the CPU's SHA instructions, when it has them.
+ *
+ *  Qt only uses those when it was built against a crypto library that does, which most builds aren't, and checking
+ *  the downloads of a whole instance against their SHA-1 is bound on hashing. Every other algorithm, and every CPU
+ *  without the instructions, is left to QCryptographicHash.
+ */
+class CryptoHash {
+   public:
+    explicit CryptoHash(QCryptographicHash::Algorithm algorithm);
+    ~CryptoHash();
+
+    void reset();
+    void addData(const char* data, qsizetype length);
+    void addData(const QByteArray& data) { addData(data.constData(), data.size()); }
+    /* Reads the device to its end, returns false if it couldn't be read. */
+    bool addData(QIODevice* device);
+
+    /* The digest of what was added so far, more data can be added afterwards. */
+    QByteArray result() const;
+
+    static QByteArray hash(const QByteArray& data, QCryptographicHash::Algorithm algorithm);
+
+    /* Whether the algorithm is done with the CPU's SHA instructions. */
+    static bool isAccelerated(QCryptographicHash::Algorithm algorithm);
+
+    using BlockFunction = void (*)(uint32_t* state, const unsigned char* blocks, size_t count);
+
+   private:
+    QCryptographicHash::Algorithm m_algorithm;
+    std::unique_ptr<QCryptographicHash> m_fallback;
+
+    BlockFunction m_blocks = nullptr;
+    uint32_t m_state[8];
+    uint64_t m_length = 0;
+    unsigned char m_buffer[64];
+    int m_buffered = 0;
+};
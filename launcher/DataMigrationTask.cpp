@@ -15,69 +15,50 @@
 DataMigrationTask::DataMigrationTask(QObject* parent,
                                      const QString& sourcePath,
                                      const QString& targetPath,
-                                     const IPathMatcher::Ptr pathMatcher)
-    : Task(parent), m_sourcePath(sourcePath), m_targetPath(targetPath), m_pathMatcher(pathMatcher), m_copy(sourcePath, targetPath)
+                                     const IPathMatcher::Ptr pathMatcher,
+                                     Method method)
+    : Task(parent)
+    , m_sourcePath(sourcePath)
+    , m_targetPath(targetPath)
+    , m_pathMatcher(pathMatcher)
+    , m_method(method)
+    , m_copy(sourcePath, targetPath)
 {
     m_copy.matcher(m_pathMatcher.get()).whitelist(true);
+    m_copy.cloneWhenPossible(method == Method::Copy).moveWhenPossible(method == Method::Move).linkWhenPossible(method == Method::Link);
 }
 
 void DataMigrationTask::executeTask()
 {
     setStatus(tr("Scanning files..."));
 
-    // 1. Scan
-    // Check how many files we gotta copy
-    m_copyFuture = QtConcurrent::run(QThreadPool::globalInstance(), [&] {
-        return m_copy(true);  // dry run to collect amount of files
-    });
-    connect(&m_copyFutureWatcher, &QFutureWatcher<bool>::finished, this, &DataMigrationTask::dryRunFinished);
-    connect(&m_copyFutureWatcher, &QFutureWatcher<bool>::canceled, this, &DataMigrationTask::dryRunAborted);
-    m_copyFutureWatcher.setFuture(m_copyFuture);
-}
-
-void DataMigrationTask::dryRunFinished()
-{
-    disconnect(&m_copyFutureWatcher, &QFutureWatcher<bool>::finished, this, &DataMigrationTask::dryRunFinished);
-    disconnect(&m_copyFutureWatcher, &QFutureWatcher<bool>::canceled, this, &DataMigrationTask::dryRunAborted);
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-    if (!m_copyFuture.isValid() || !m_copyFuture.result()) {
-#else
-    if (!m_copyFuture.result()) {
-#endif
-        emitFailed(tr("Failed to scan source path."));
-        return;
-    }
-
-    // 2. Copy
-    // Actually copy all files now.
-    m_toCopy = m_copy.totalCopied();
-    connect(&m_copy, &FS::copy::fileCopied, [&, this](const QString& relativeName) {
+    // the files are all found before the first one is copied, so the progress goes by their size from the start
+    connect(&m_copy, &FS::copy::copyProgress, this, [this](qsizetype, qsizetype, const QString& relativeName) {
         QString shortenedName = relativeName;
         // shorten the filename to hopefully fit into one line
         if (shortenedName.length() > 50)
             shortenedName = relativeName.left(20) + "…" + relativeName.right(29);
-        setProgress(m_copy.totalCopied(), m_toCopy);
-        setStatus(tr("Copying %1…").arg(shortenedName));
-    });
-    m_copyFuture = QtConcurrent::run(QThreadPool::globalInstance(), [&] {
-        return m_copy(false);  // actually copy now
+        switch (m_method) {
+            case Method::Move:
+                setStatus(tr("Moving %1…").arg(shortenedName));
+                break;
+            case Method::Link:
+                setStatus(tr("Linking %1…").arg(shortenedName));
+                break;
+            default:
+                setStatus(tr("Copying %1…").arg(shortenedName));
+                break;
+        }
     });
+    connect(&m_copy, &FS::copy::sizeProgress, this, [this](qint64 done, qint64 total) { setProgress(done, total); });
+    m_copyFuture = QtConcurrent::run(QThreadPool::globalInstance(), [&] { return m_copy(); });
     connect(&m_copyFutureWatcher, &QFutureWatcher<bool>::finished, this, &DataMigrationTask::copyFinished);
     connect(&m_copyFutureWatcher, &QFutureWatcher<bool>::canceled, this, &DataMigrationTask::copyAborted);
     m_copyFutureWatcher.setFuture(m_copyFuture);
 }
 
-void DataMigrationTask::dryRunAborted()
-{
-    emitFailed(tr("Aborted"));
-}
-
 void DataMigrationTask::copyFinished()
 {
-    disconnect(&m_copyFutureWatcher, &QFutureWatcher<bool>::finished, this, &DataMigrationTask::copyFinished);
-    disconnect(&m_copyFutureWatcher, &QFutureWatcher<bool>::canceled, this, &DataMigrationTask::copyAborted);
-
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
     if (!m_copyFuture.isValid() || !m_copyFuture.result()) {
 #else
@@ -18,15 +18,20 @@
 class DataMigrationTask : public Task {
     Q_OBJECT
    public:
-    explicit DataMigrationTask(QObject* parent, const QString& sourcePath, const QString& targetPath, IPathMatcher::Ptr pathmatcher);
+    /* How the files get to the new data directory. Move and Link fall back to copying when both aren't on the same filesystem. */
+    enum class Method { Copy, Move, Link };
+
+    explicit DataMigrationTask(QObject* parent,
+                               const QString& sourcePath,
+                               const QString& targetPath,
+                               IPathMatcher::Ptr pathmatcher,
+                               Method method = Method::Copy);
     ~DataMigrationTask() override = default;
 
    protected:
     virtual void executeTask() override;
 
    protected slots:
-    void dryRunFinished();
-    void dryRunAborted();
     void copyFinished();
     void copyAborted();
 
@@ -34,9 +39,9 @@ class DataMigrationTask : public Task {
     const QString& m_sourcePath;
     const QString& m_targetPath;
     const IPathMatcher::Ptr m_pathMatcher;
+    const Method m_method;
 
     FS::copy m_copy;
-    int m_toCopy = 0;
     QFuture<bool> m_copyFuture;
     QFutureWatcher<bool> m_copyFutureWatcher;
 };
@@ -37,15 +37,58 @@
 #include "FileIgnoreProxy.h"
 
 #include <QDebug>
+#include <QDirIterator>
 #include <QFileSystemModel>
+#include <QFutureWatcher>
+#include <QLocale>
 #include <QSortFilterProxyModel>
 #include <QStack>
 #include <algorithm>
 #include "FileSystem.h"
 #include "SeparatorPrefixTree.h"
 #include "StringUtils.h"
+#include "tasks/CpuExecutor.h"
+
+FileIgnoreProxy::FileIgnoreProxy(QString root, QObject* parent) : QSortFilterProxyModel(parent), root(root), m_rootDir(root) {}
+
+FileIgnoreProxy::~FileIgnoreProxy()
+{
+    // stop summing up folder sizes nobody is going to look at
+    *m_destroyed = true;
+}
+
+void FileIgnoreProxy::setSourceModel(QAbstractItemModel* model)
+{
+    QSortFilterProxyModel::setSourceModel(model);
+    if (model) {
+        connect(model, &QAbstractItemModel::modelReset, this, [this] {
+            m_sortKeys.clear();
+            m_folderSizes.clear();
+        });
+    }
+}
+
+auto FileIgnoreProxy::sortKey(const QModelIndex& sourceIndex) const -> SortKey
+{
+    auto fsm = static_cast<QFileSystemModel*>(sourceModel());
+    auto name = fsm->fileName(sourceIndex);
+    auto& cached = m_sortKeys[sourceIndex.internalPointer()];
+    if (cached.key.isNull() || cached.name != name) {
+        cached.name = name;
+        cached.key = StringUtils::naturalSortKey(name, Qt::CaseInsensitive);
+    }
+    return cached;
+}
+
+int FileIgnoreProxy::compareNames(const QModelIndex& left, const QModelIndex& right) const
+{
+    auto leftKey = sortKey(left);
+    auto rightKey = sortKey(right);
+    if (auto result = leftKey.key.compare(rightKey.key); result != 0)
+        return result;
+    return leftKey.name.compare(rightKey.name, Qt::CaseInsensitive);
+}
 
-FileIgnoreProxy::FileIgnoreProxy(QString root, QObject* parent) : QSortFilterProxyModel(parent), root(root) {}
 // NOTE: Sadly, we have to do sorting ourselves.
 bool FileIgnoreProxy::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
@@ -55,25 +98,26 @@ bool FileIgnoreProxy::lessThan(const QModelIndex& left, const QModelIndex& right
     }
     bool asc = sortOrder() == Qt::AscendingOrder ? true : false;
 
-    QFileInfo leftFileInfo = fsm->fileInfo(left);
-    QFileInfo rightFileInfo = fsm->fileInfo(right);
+    // this runs for every comparison, so stick to what the model has cached instead of building QFileInfos
+    bool leftIsDir = fsm->isDir(left);
+    bool rightIsDir = fsm->isDir(right);
 
-    if (!leftFileInfo.isDir() && rightFileInfo.isDir()) {
+    if (!leftIsDir && rightIsDir) {
         return !asc;
     }
-    if (leftFileInfo.isDir() && !rightFileInfo.isDir()) {
+    if (leftIsDir && !rightIsDir) {
         return asc;
     }
 
     // sort and proxy model breaks the original model...
     if (sortColumn() == 0) {
-        return StringUtils::naturalCompare(leftFileInfo.fileName(), rightFileInfo.fileName(), Qt::CaseInsensitive) < 0;
+        return compareNames(left, right) < 0;
     }
     if (sortColumn() == 1) {
-        auto leftSize = leftFileInfo.size();
-        auto rightSize = rightFileInfo.size();
-        if ((leftSize == rightSize) || (leftFileInfo.isDir() && rightFileInfo.isDir())) {
-            return StringUtils::naturalCompare(leftFileInfo.fileName(), rightFileInfo.fileName(), Qt::CaseInsensitive) < 0 ? asc : !asc;
+        auto leftSize = fsm->size(left);
+        auto rightSize = fsm->size(right);
+        if ((leftSize == rightSize) || (leftIsDir && rightIsDir)) {
+            return compareNames(left, right) < 0 ? asc : !asc;
         }
         return leftSize < rightSize;
     }
@@ -114,6 +158,12 @@ QVariant FileIgnoreProxy::data(const QModelIndex& index, int role) const
         }
     }
 
+    if (index.column() == 1 && role == Qt::DisplayRole) {
+        QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
+        if (fsm && fsm->isDir(sourceIndex))
+            return folderSize(sourceIndex);
+    }
+
     return sourceIndex.data(role);
 }
 
@@ -128,9 +178,40 @@ bool FileIgnoreProxy::setData(const QModelIndex& index, const QVariant& value, i
     return QSortFilterProxyModel::sourceModel()->setData(sourceIndex, value, role);
 }
 
+QVariant FileIgnoreProxy::folderSize(const QModelIndex& sourceIndex) const
+{
+    auto fsm = static_cast<QFileSystemModel*>(sourceModel());
+    auto path = fsm->filePath(sourceIndex);
+    if (auto it = m_folderSizes.constFind(path); it != m_folderSizes.cend()) {
+        if (*it < 0)
+            return {};
+        return QLocale::system().formattedDataSize(*it);
+    }
+
+    m_folderSizes.insert(path, -1);
+    auto self = const_cast<FileIgnoreProxy*>(this);
+    auto watcher = new QFutureWatcher<qint64>(self);
+    connect(watcher, &QFutureWatcher<qint64>::finished, self, [self, watcher, path, index = QPersistentModelIndex(sourceIndex)] {
+        self->m_folderSizes.insert(path, watcher->result());
+        watcher->deleteLater();
+        if (auto proxyIndex = self->mapFromSource(index); proxyIndex.isValid())
+            emit self->dataChanged(proxyIndex, proxyIndex, { Qt::DisplayRole });
+    });
+    watcher->setFuture(CpuExecutor::run(CpuExecutor::Priority::Background, [path, destroyed = m_destroyed] {
+        qint64 size = 0;
+        QDirIterator it(path, QDir::Files | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext() && !*destroyed) {
+            it.next();
+            size += it.fileInfo().size();
+        }
+        return size;
+    }));
+    return {};
+}
+
 QString FileIgnoreProxy::relPath(const QString& path) const
 {
-    return QDir(root).relativeFilePath(path);
+    return m_rootDir.relativeFilePath(path);
 }
 
 bool FileIgnoreProxy::setFilterState(QModelIndex index, Qt::CheckState state)
@@ -197,24 +278,20 @@ bool FileIgnoreProxy::setFilterState(QModelIndex index, Qt::CheckState state)
             emit dataChanged(up, up, { Qt::CheckStateRole });
             up = up.parent();
         }
-        // and everything below the index
-        QModelIndex doing = index;
-        int row = 0;
+        // and everything below the index, a whole range of rows at a time
         QStack<QModelIndex> todo;
-        while (1) {
-            auto node = this->index(row, 0, doing);
-            if (!node.isValid()) {
-                if (!todo.size()) {
-                    break;
-                } else {
-                    doing = todo.pop();
-                    row = 0;
-                    continue;
-                }
+        todo.push(index);
+        while (!todo.isEmpty()) {
+            auto parent = todo.pop();
+            auto rows = rowCount(parent);
+            if (rows == 0)
+                continue;
+            emit dataChanged(this->index(0, 0, parent), this->index(rows - 1, 0, parent), { Qt::CheckStateRole });
+            for (int row = 0; row < rows; row++) {
+                auto node = this->index(row, 0, parent);
+                if (hasChildren(node))
+                    todo.push(node);
             }
-            emit dataChanged(node, node, { Qt::CheckStateRole });
-            todo.push(node);
-            row++;
         }
         // siblings and unrelated nodes are ignored
     }
@@ -261,13 +338,17 @@ bool FileIgnoreProxy::filterAcceptsRow(int sourceRow, const QModelIndex& sourceP
     QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
     QFileSystemModel* fsm = qobject_cast<QFileSystemModel*>(sourceModel());
 
-    auto fileInfo = fsm->fileInfo(index);
-    return !ignoreFile(fileInfo);
+    return !ignoreFile(fsm->fileName(index), fsm->filePath(index));
 }
 
 bool FileIgnoreProxy::ignoreFile(QFileInfo fileInfo) const
 {
-    return m_ignoreFiles.contains(fileInfo.fileName()) || m_ignoreFilePaths.covers(relPath(fileInfo.absoluteFilePath()));
+    return ignoreFile(fileInfo.fileName(), fileInfo.absoluteFilePath());
+}
+
+bool FileIgnoreProxy::ignoreFile(const QString& fileName, const QString& filePath) const
+{
+    return m_ignoreFiles.contains(fileName) || m_ignoreFilePaths.covers(relPath(filePath));
 }
 
 bool FileIgnoreProxy::filterFile(const QString& fileName) const
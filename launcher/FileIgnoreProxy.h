@@ -36,8 +36,14 @@
 
 #pragma once
 
+#include <QDir>
 #include <QFileInfo>
+#include <QHash>
 #include <QSortFilterProxyModel>
+
+#include <atomic>
+#include <memory>
+
 #include "SeparatorPrefixTree.h"
 
 class FileIgnoreProxy : public QSortFilterProxyModel {
@@ -45,6 +51,10 @@ class FileIgnoreProxy : public QSortFilterProxyModel {
 
    public:
     FileIgnoreProxy(QString root, QObject* parent);
+    virtual ~FileIgnoreProxy();
+
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
+
     // NOTE: Sadly, we have to do sorting ourselves.
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const;
 
@@ -76,10 +86,28 @@ class FileIgnoreProxy : public QSortFilterProxyModel {
     bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const;
 
     bool ignoreFile(QFileInfo file) const;
+    bool ignoreFile(const QString& fileName, const QString& filePath) const;
+
+   private:
+    struct SortKey {
+        QString name;
+        QString key;
+    };
+    // keyed by the source model's internal pointer, the name is checked on every use in case the node got reused
+    SortKey sortKey(const QModelIndex& sourceIndex) const;
+    int compareNames(const QModelIndex& left, const QModelIndex& right) const;
+
+    QVariant folderSize(const QModelIndex& sourceIndex) const;
 
    private:
     const QString root;
+    const QDir m_rootDir;
     SeparatorPrefixTree<'/'> blocked;
     QStringList m_ignoreFiles;
     SeparatorPrefixTree<'/'> m_ignoreFilePaths;
+
+    mutable QHash<const void*, SortKey> m_sortKeys;
+    // folder sizes are summed up in the background, -1 while that's still going
+    mutable QHash<QString, qint64> m_folderSizes;
+    std::shared_ptr<std::atomic_bool> m_destroyed = std::make_shared<std::atomic_bool>(false);
 };
@@ -45,13 +45,27 @@
 #include <QDirIterator>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QMutex>
 #include <QSaveFile>
+#include <QSettings>
+#include <QSemaphore>
+#include <QSet>
 #include <QStandardPaths>
 #include <QStorageInfo>
 #include <QTextStream>
+#include <QThread>
 #include <QUrl>
 #include <QtNetwork>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <system_error>
+#include <thread>
 
 #include "DesktopServices.h"
 #include "StringUtils.h"
@@ -307,15 +321,41 @@ void copyFolderAttributes(QString src, QString dst, QString relative)
     }
 }
 
+// how many files are written to one device at a time, over all copies; enough to keep an SSD busy without making a
+// hard drive seek back and forth all the time
+static constexpr int COPY_WRITERS_PER_DEVICE = 4;
+static constexpr auto COPY_PROGRESS_INTERVAL = std::chrono::milliseconds(100);
+
+static QSemaphore& deviceWriters(const QString& deviceRoot)
+{
+    static QMutex mutex;
+    static std::map<QString, std::unique_ptr<QSemaphore>> writers;
+    QMutexLocker locker(&mutex);
+    auto& semaphore = writers[deviceRoot];
+    if (!semaphore)
+        semaphore = std::make_unique<QSemaphore>(COPY_WRITERS_PER_DEVICE);
+    return *semaphore;
+}
+
+static bool clone_file_on_same_fs(const QString& src, const QString& dst, std::error_code& ec);
+
 /**
  * @brief Copies a directory and it's contents from src to dest
+ * Everything to copy is collected and the folders are made first, then the files are copied on a few threads.
+ * fs::copy already uses the platform's fast paths (copy_file_range/sendfile, CopyFile2, fcopyfile).
+ * With cloneWhenPossible the filesystems are checked once, and the files are cloned until a clone fails.
+ * With linkWhenPossible or moveWhenPossible the files are hard linked or renamed instead when both ends are on the same
+ * filesystem, and copied when that fails.
  * @param offset subdirectory form src to copy to dest
- * @return if there was an error during the filecopy
+ * @return if every file was copied
  */
 bool copy::operator()(const QString& offset, bool dryRun)
 {
     using copy_opts = fs::copy_options;
     m_copied = 0;  // reset counter
+    m_bytesCloned = 0;
+    m_bytesCopied = 0;
+    m_bytesLinked = 0;
     m_failedPaths.clear();
 
 // NOTE always deep copy on windows. the alternatives are too messy.
@@ -326,8 +366,6 @@ bool copy::operator()(const QString& offset, bool dryRun)
     auto src = PathCombine(m_src.absolutePath(), offset);
     auto dst = PathCombine(m_dst.absolutePath(), offset);
 
-    std::error_code err;
-
     fs::copy_options opt = copy_opts::none;
 
     // The default behavior is to follow symlinks
@@ -337,29 +375,28 @@ bool copy::operator()(const QString& offset, bool dryRun)
     if (m_overwrite)
         opt |= copy_opts::overwrite_existing;
 
-    // Function that'll do the actual copying
-    auto copy_file = [&](QString src_path, QString relative_dst_path) {
+    struct PlannedFile {
+        QString src_path;
+        QString relative_dst_path;
+        qint64 size;
+        bool cloneable;
+        bool linkable;
+        bool cloned = false;
+        bool linked = false;
+        std::error_code err;
+    };
+    std::vector<PlannedFile> plan;
+    qint64 totalSize = 0;
+    bool linking = m_linkWhenPossible || m_moveWhenPossible;
+    auto planFile = [&](const QFileInfo& info, QString relative_dst_path) {
         if (m_matcher && (m_matcher->matches(relative_dst_path) != m_whitelist))
             return;
-
-        auto dst_path = PathCombine(dst, relative_dst_path);
-        if (!dryRun) {
-            ensureFilePathExists(dst_path);
-#ifdef Q_OS_WIN32
-            copyFolderAttributes(src, dst, relative_dst_path);
-#endif
-            fs::copy(StringUtils::toStdString(src_path), StringUtils::toStdString(dst_path), opt, err);
-        }
-        if (err) {
-            qWarning() << "Failed to copy files:" << QString::fromStdString(err.message());
-            qDebug() << "Source file:" << src_path;
-            qDebug() << "Destination file:" << dst_path;
-            m_failedPaths.append(dst_path);
-            emit copyFailed(relative_dst_path);
-            return;
-        }
-        m_copied++;
-        emit fileCopied(relative_dst_path);
+        // a clone would follow the link, and existing files are left to fs::copy to refuse
+        bool shortcut = !(info.isSymLink() && !m_followSymlinks) && (m_overwrite || !QFileInfo::exists(PathCombine(dst, relative_dst_path)));
+        // a hard link or a rename would take the symlink itself, where a copy follows it
+        bool linkable = linking && shortcut && !info.isSymLink();
+        plan.push_back({ info.filePath(), relative_dst_path, info.size(), m_cloneWhenPossible && shortcut, linkable });
+        totalSize += info.size();
     };
 
     // We can't use copy_opts::recursive because we need to take into account the
@@ -372,14 +409,143 @@ bool copy::operator()(const QString& offset, bool dryRun)
         auto src_path = source_it.next();
         auto relative_path = src_dir.relativeFilePath(src_path);
 
-        copy_file(src_path, relative_path);
+        planFile(source_it.fileInfo(), relative_path);
     }
 
     // If the root src is not a directory, the previous iterator won't run.
     if (!fs::is_directory(StringUtils::toStdString(src)))
-        copy_file(src, "");
+        planFile(QFileInfo(src), "");
 
-    return err.value() == 0;
+    if (dryRun) {
+        m_copied = plan.size();
+        return true;
+    }
+
+    // every destination folder once, instead of a mkpath per file
+    QSet<QString> folders;
+    for (auto& file : plan) {
+        auto folder = QFileInfo(PathCombine(dst, file.relative_dst_path)).path();
+        if (folders.contains(folder))
+            continue;
+        folders.insert(folder);
+        ensureFolderPathExists(folder);
+#ifdef Q_OS_WIN32
+        copyFolderAttributes(src, dst, file.relative_dst_path);
+#endif
+    }
+
+    // the folders exist now, so both ends can be looked at
+    auto dstInfo = statFS(dst);
+    std::atomic<bool> cloning = m_cloneWhenPossible && !plan.empty();
+    if (cloning) {
+        auto srcInfo = statFS(src);
+        cloning = srcInfo.rootPath == dstInfo.rootPath && srcInfo.fsType == dstInfo.fsType && canCloneOnFS(srcInfo);
+        qDebug() << "Cloning" << (cloning ? "possible" : "not possible") << "from" << srcInfo.fsTypeName << "to" << dstInfo.fsTypeName;
+    }
+    if (linking && !plan.empty()) {
+        linking = statFS(src).rootPath == dstInfo.rootPath;
+        qDebug() << (m_moveWhenPossible ? "Moving" : "Hard linking") << (linking ? "possible" : "not possible") << "to" << dstInfo.rootPath;
+    }
+
+    // the workers take files in order; this thread reports progress every so often until they are done
+    auto& writers = deviceWriters(dstInfo.rootPath);
+    std::atomic<size_t> next{ 0 };
+    std::atomic<size_t> done{ 0 };
+    std::atomic<size_t> lastDone{ 0 };
+    std::atomic<qint64> doneSize{ 0 };
+    std::mutex mutex;
+    std::condition_variable finished;
+    int running = std::clamp(QThread::idealThreadCount(), 1, COPY_WRITERS_PER_DEVICE);
+    if (m_maxThreads > 0)
+        running = std::min(running, m_maxThreads);
+    running = std::min<int>(running, int(plan.size()));
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < running; i++) {
+        workers.emplace_back([&] {
+            for (size_t index; (index = next++) < plan.size();) {
+                auto& file = plan[index];
+                auto dst_path = PathCombine(dst, file.relative_dst_path);
+                if (linking && file.linkable) {
+                    std::error_code err;
+                    if (m_moveWhenPossible)
+                        fs::rename(StringUtils::toStdString(file.src_path), StringUtils::toStdString(dst_path), err);
+                    else
+                        fs::create_hard_link(StringUtils::toStdString(file.src_path), StringUtils::toStdString(dst_path), err);
+                    // copied below when that fails, a few files may well be on another mount or at their link limit
+                    file.linked = !err;
+                }
+                if (!file.linked && cloning && file.cloneable) {
+                    file.cloned = clone_file_on_same_fs(file.src_path, dst_path, file.err);
+                    if (file.cloned) {
+                        std::error_code ignored;
+                        fs::permissions(StringUtils::toStdString(dst_path), fs::status(StringUtils::toStdString(file.src_path)).permissions(),
+                                        ignored);
+                    } else {
+                        // the first failure decides for the rest, there is no point in trying every file
+                        qDebug() << "Clone failed, copying the remaining files:" << QString::fromStdString(file.err.message());
+                        cloning = false;
+                        file.err.clear();
+                        fs::remove(StringUtils::toStdString(dst_path), file.err);
+                        file.err.clear();
+                    }
+                }
+                if (!file.cloned && !file.linked) {
+                    writers.acquire();
+                    fs::copy(StringUtils::toStdString(file.src_path), StringUtils::toStdString(dst_path), opt, file.err);
+                    writers.release();
+                }
+                lastDone = index;
+                doneSize += file.size;
+                done++;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            running--;
+            finished.notify_one();
+        });
+    }
+
+    size_t reported = 0;
+    auto report = [&] {
+        if (const size_t current = done; current != reported) {
+            reported = current;
+            emit copyProgress(current, plan.size(), plan[lastDone].relative_dst_path);
+            emit sizeProgress(doneSize, totalSize);
+        }
+    };
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!finished.wait_for(lock, COPY_PROGRESS_INTERVAL, [&] { return running == 0; })) {
+            lock.unlock();
+            report();
+            lock.lock();
+        }
+    }
+    for (auto& worker : workers)
+        worker.join();
+    report();
+
+    for (auto& file : plan) {
+        if (file.err) {
+            auto dst_path = PathCombine(dst, file.relative_dst_path);
+            qWarning() << "Failed to copy files:" << QString::fromStdString(file.err.message());
+            qDebug() << "Source file:" << file.src_path;
+            qDebug() << "Destination file:" << dst_path;
+            m_failedPaths.append(dst_path);
+            emit copyFailed(file.relative_dst_path);
+            continue;
+        }
+        m_copied++;
+        (file.linked ? m_bytesLinked : file.cloned ? m_bytesCloned : m_bytesCopied) += file.size;
+    }
+    if (m_cloneWhenPossible)
+        qDebug() << "Cloned" << StringUtils::humanReadableFileSize(m_bytesCloned) << "and copied"
+                 << StringUtils::humanReadableFileSize(m_bytesCopied);
+    if (m_linkWhenPossible || m_moveWhenPossible)
+        qDebug() << (m_moveWhenPossible ? "Moved" : "Hard linked") << StringUtils::humanReadableFileSize(m_bytesLinked) << "and copied"
+                 << StringUtils::humanReadableFileSize(m_bytesCopied);
+
+    return m_failedPaths.isEmpty();
 }
 
 /// qDebug print support for the LinkPair struct
@@ -391,6 +557,31 @@ QDebug operator<<(QDebug debug, const LinkPair& lp)
     return debug;
 }
 
+#if defined Q_OS_WIN32 && !defined SYMBOLIC_LINK_FLAG_ALLOW_UNPRIVILEGED_CREATE
+#define SYMBOLIC_LINK_FLAG_ALLOW_UNPRIVILEGED_CREATE 0x2
+#endif
+
+/// std::filesystem doesn't always ask Windows for a symlink without elevation, even when developer mode allows one
+static void createSymlink(const QString& src, const QString& dst, bool directory, std::error_code& err)
+{
+#if defined Q_OS_WIN32
+    if (canSymlinkUnprivileged()) {
+        DWORD flags = SYMBOLIC_LINK_FLAG_ALLOW_UNPRIVILEGED_CREATE;
+        if (directory)
+            flags |= SYMBOLIC_LINK_FLAG_DIRECTORY;
+        if (CreateSymbolicLinkW((LPCWSTR)QDir::toNativeSeparators(dst).utf16(), (LPCWSTR)QDir::toNativeSeparators(src).utf16(), flags))
+            err.clear();
+        else
+            err = std::error_code(int(GetLastError()), std::system_category());
+        return;
+    }
+#endif
+    if (directory)
+        fs::create_directory_symlink(StringUtils::toStdString(src), StringUtils::toStdString(dst), err);
+    else
+        fs::create_symlink(StringUtils::toStdString(src), StringUtils::toStdString(dst), err);
+}
+
 bool create_link::operator()(const QString& offset, bool dryRun)
 {
     m_linked = 0;  // reset counter
@@ -484,11 +675,11 @@ bool create_link::make_links()
         } else if (fs::is_directory(src_path_std)) {
             if (m_debug)
                 qDebug() << "making directory_symlink:" << src_path << "to" << dst_path;
-            fs::create_directory_symlink(src_path_std, dst_path_std, m_os_err);
+            createSymlink(src_path, dst_path, true, m_os_err);
         } else {
             if (m_debug)
                 qDebug() << "making symlink:" << src_path << "to" << dst_path;
-            fs::create_symlink(src_path_std, dst_path_std, m_os_err);
+            createSymlink(src_path, dst_path, false, m_os_err);
         }
 
         if (m_os_err) {
@@ -514,98 +705,190 @@ void create_link::runPrivileged(const QString& offset)
     m_path_results.clear();
     m_links_to_make.clear();
 
-    bool gotResults = false;
-
     make_link_list(offset);
 
-    QString serverName = BuildConfig.LAUNCHER_APP_BINARY_NAME + "_filelink_server" + StringUtils::getRandomAlphaNumeric();
+    auto linker = PrivilegedLinker::instance();
+    disconnect(m_privilegedConnection);
+    m_privilegedConnection = connect(linker, &PrivilegedLinker::batchFinished, this,
+                                     [this](quint64 id, const QList<LinkResult>& results, bool gotResults) {
+                                         if (id != m_privilegedBatch)
+                                             return;
+                                         disconnect(m_privilegedConnection);
+                                         for (auto result : results) {
+                                             if (result.err_value) {
+                                                 qDebug() << "privileged link fail" << result.src << "to" << result.dst << "code"
+                                                          << result.err_value << result.err_msg;
+                                                 emit linkFailed(result.src, result.dst, result.err_msg, result.err_value);
+                                             } else {
+                                                 m_linked++;
+                                                 emit fileLinked(result.src, result.dst);
+                                             }
+                                             m_path_results.append(result);
+                                         }
+                                         emit finishedPrivileged(gotResults);
+                                     });
+    // the results are delivered through this thread's event loop, so the id is set before they can arrive
+    m_privilegedBatch = linker->submit(m_links_to_make, m_useHardLinks);
+}
 
-    connect(&m_linkServer, &QLocalServer::newConnection, this, [&]() {
-        qDebug() << "Client connected, sending out pairs";
-        // construct block of data to send
-        QByteArray block;
-        QDataStream out(&block, QIODevice::WriteOnly);
+PrivilegedLinker* PrivilegedLinker::instance()
+{
+    static PrivilegedLinker* linker = [] {
+        qRegisterMetaType<QList<FS::LinkResult>>();
+        auto linker = new PrivilegedLinker();
+        // the copy tasks ask for links from their own threads, the connection to the helper lives with the application
+        linker->moveToThread(QCoreApplication::instance()->thread());
+        return linker;
+    }();
+    return linker;
+}
 
-        qint32 blocksize = quint32(sizeof(quint32));
-        for (auto link : m_links_to_make) {
-            blocksize += quint32(link.src.size());
-            blocksize += quint32(link.dst.size());
+PrivilegedLinker::PrivilegedLinker() : m_server(new QLocalServer(this))
+{
+    connect(m_server, &QLocalServer::newConnection, this, [this] {
+        auto connection = m_server->nextPendingConnection();
+        if (m_connection) {
+            connection->deleteLater();
+            return;
         }
-        qDebug() << "About to write block of size:" << blocksize;
-        out << blocksize;
+        qDebug() << "filelink helper connected";
+        // nobody else gets to join once the helper has
+        m_server->close();
+        m_connection = connection;
+        m_blockSize = 0;
+        connect(m_connection, &QLocalSocket::readyRead, this, &PrivilegedLinker::readResults);
+        connect(m_connection, &QLocalSocket::disconnected, m_connection, &QLocalSocket::deleteLater);
+        sendNext();
+    });
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &PrivilegedLinker::shutdown);
+}
 
-        out << quint32(m_links_to_make.length());
-        for (auto link : m_links_to_make) {
-            out << link.src;
-            out << link.dst;
-        }
+quint64 PrivilegedLinker::submit(const QList<LinkPair>& links, bool useHardLinks)
+{
+    Batch batch{ m_nextId++, links, useHardLinks };
+    QMetaObject::invokeMethod(this, [this, batch] { enqueue(batch); }, Qt::QueuedConnection);
+    return batch.id;
+}
 
-        QLocalSocket* clientConnection = m_linkServer.nextPendingConnection();
-        connect(clientConnection, &QLocalSocket::disconnected, clientConnection, &QLocalSocket::deleteLater);
+void PrivilegedLinker::enqueue(Batch batch)
+{
+    m_queue.append(batch);
+    if (!m_process)
+        startHelper();
+    else
+        sendNext();
+}
 
-        connect(clientConnection, &QLocalSocket::readyRead, this, [&, clientConnection]() {
-            QDataStream in;
-            quint32 blockSize = 0;
-            in.setDevice(clientConnection);
+void PrivilegedLinker::startHelper()
+{
+    QString serverName = BuildConfig.LAUNCHER_APP_BINARY_NAME + "_filelink_server" + StringUtils::getRandomAlphaNumeric();
 
-            qDebug() << "Reading path results from client";
-            qDebug() << "bytes available" << clientConnection->bytesAvailable();
+    qDebug() << "Listening on pipe" << serverName;
+    if (!m_server->listen(serverName)) {
+        qDebug() << "Unable to start local pipe server on" << serverName << ":" << m_server->errorString();
+        helperExited();
+        return;
+    }
 
-            // Relies on the fact that QDataStream serializes a quint32 into
-            // sizeof(quint32) bytes
-            if (clientConnection->bytesAvailable() < (int)sizeof(quint32))
-                return;
-            qDebug() << "reading block size";
-            in >> blockSize;
+    m_process = new ExternalLinkFileProcess(serverName, this);
+    connect(m_process, &ExternalLinkFileProcess::processExited, this, &PrivilegedLinker::helperExited);
+    connect(m_process, &ExternalLinkFileProcess::finished, m_process, &QObject::deleteLater);
+    m_process->start();
+}
 
-            qDebug() << "blocksize is" << blockSize;
-            qDebug() << "bytes available" << clientConnection->bytesAvailable();
-            if (clientConnection->bytesAvailable() < blockSize || in.atEnd())
-                return;
+void PrivilegedLinker::sendNext()
+{
+    if (!m_connection || m_inFlight || m_queue.isEmpty())
+        return;
 
-            quint32 numResults;
-            in >> numResults;
-            qDebug() << "numResults" << numResults;
-
-            for (quint32 i = 0; i < numResults; i++) {
-                FS::LinkResult result;
-                in >> result.src;
-                in >> result.dst;
-                in >> result.err_msg;
-                qint32 err_value;
-                in >> err_value;
-                result.err_value = err_value;
-                if (result.err_value) {
-                    qDebug() << "privileged link fail" << result.src << "to" << result.dst << "code" << result.err_value << result.err_msg;
-                    emit linkFailed(result.src, result.dst, result.err_msg, result.err_value);
-                } else {
-                    qDebug() << "privileged link success" << result.src << "to" << result.dst;
-                    m_linked++;
-                    emit fileLinked(result.src, result.dst);
-                }
-                m_path_results.append(result);
-            }
-            gotResults = true;
-            qDebug() << "results received, closing connection";
-            clientConnection->close();
-        });
+    const auto& batch = m_queue.first();
+    qDebug() << "sending" << batch.links.length() << "links to the filelink helper";
 
-        qint64 byteswritten = clientConnection->write(block);
-        bool bytesflushed = clientConnection->flush();
-        qDebug() << "block flushed" << byteswritten << bytesflushed;
-    });
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out << batch.useHardLinks;
+    out << quint32(batch.links.length());
+    for (auto link : batch.links) {
+        out << link.src;
+        out << link.dst;
+    }
 
-    qDebug() << "Listening on pipe" << serverName;
-    if (!m_linkServer.listen(serverName)) {
-        qDebug() << "Unable to start local pipe server on" << serverName << ":" << m_linkServer.errorString();
-        return;
+    QByteArray block;
+    QDataStream header(&block, QIODevice::WriteOnly);
+    header << quint32(payload.size());
+    block += payload;
+
+    m_inFlight = true;
+    m_connection->write(block);
+    m_connection->flush();
+}
+
+void PrivilegedLinker::readResults()
+{
+    QDataStream in(m_connection);
+    while (m_inFlight) {
+        if (m_blockSize == 0) {
+            // Relies on the fact that QDataStream serializes a quint32 into
+            // sizeof(quint32) bytes
+            if (m_connection->bytesAvailable() < (int)sizeof(quint32))
+                return;
+            in >> m_blockSize;
+        }
+        if (m_connection->bytesAvailable() < m_blockSize)
+            return;
+        m_blockSize = 0;
+
+        quint32 numResults;
+        in >> numResults;
+        QList<LinkResult> results;
+        for (quint32 i = 0; i < numResults; i++) {
+            FS::LinkResult result;
+            in >> result.src;
+            in >> result.dst;
+            in >> result.err_msg;
+            qint32 err_value;
+            in >> err_value;
+            result.err_value = err_value;
+            results.append(result);
+        }
+
+        auto batch = m_queue.takeFirst();
+        m_inFlight = false;
+        qDebug() << "filelink helper made" << results.length() << "links";
+        emit batchFinished(batch.id, results, true);
+        sendNext();
     }
+}
 
-    ExternalLinkFileProcess* linkFileProcess = new ExternalLinkFileProcess(serverName, m_useHardLinks, this);
-    connect(linkFileProcess, &ExternalLinkFileProcess::processExited, this, [&]() { emit finishedPrivileged(gotResults); });
-    connect(linkFileProcess, &ExternalLinkFileProcess::finished, linkFileProcess, &QObject::deleteLater);
+void PrivilegedLinker::helperExited()
+{
+    qDebug() << "filelink helper exited";
+    // the thread deletes itself once it's done
+    m_process = nullptr;
+    if (m_connection) {
+        disconnect(m_connection, nullptr, this, nullptr);
+        m_connection->deleteLater();
+        m_connection = nullptr;
+    }
+    m_server->close();
+    m_inFlight = false;
+    m_blockSize = 0;
+
+    auto failed = m_queue;
+    m_queue.clear();
+    for (const auto& batch : failed)
+        emit batchFinished(batch.id, {}, false);
+}
 
-    linkFileProcess->start();
+void PrivilegedLinker::shutdown()
+{
+    if (!m_process)
+        return;
+    // the helper exits once the connection is gone
+    auto process = m_process;
+    if (m_connection)
+        m_connection->disconnectFromServer();
+    process->wait(5000);
 }
 
 void ExternalLinkFileProcess::runLinkFile()
@@ -614,8 +897,6 @@ void ExternalLinkFileProcess::runLinkFile()
         PathCombine(QCoreApplication::instance()->applicationDirPath(), BuildConfig.LAUNCHER_APP_BINARY_NAME + "_filelink");
     QString params = "-s " + m_server;
 
-    params += " -H " + QVariant(m_useHardLinks).toString();
-
 #if defined Q_OS_WIN32
     SHELLEXECUTEINFO ShExecInfo;
 
@@ -638,7 +919,10 @@ void ExternalLinkFileProcess::runLinkFile()
     ShExecInfo.nShow = SW_HIDE;
     ShExecInfo.hInstApp = NULL;
 
-    ShellExecuteEx(&ShExecInfo);
+    if (!ShellExecuteEx(&ShExecInfo)) {
+        qWarning() << "Could not start the filelink helper, error" << GetLastError();
+        return;
+    }
 
     WaitForSingleObject(ShExecInfo.hProcess, INFINITE);
     CloseHandle(ShExecInfo.hProcess);
@@ -1282,9 +1566,6 @@ bool clone::operator()(const QString& offset, bool dryRun)
  */
 bool clone_file(const QString& src, const QString& dst, std::error_code& ec)
 {
-    auto src_path = StringUtils::toStdString(QDir::toNativeSeparators(QFileInfo(src).absoluteFilePath()));
-    auto dst_path = StringUtils::toStdString(QDir::toNativeSeparators(QFileInfo(dst).absoluteFilePath()));
-
     FilesystemInfo srcinfo = statFS(src);
     FilesystemInfo dstinfo = statFS(dst);
 
@@ -1294,6 +1575,18 @@ bool clone_file(const QString& src, const QString& dst, std::error_code& ec)
         return false;
     }
 
+    return clone_file_on_same_fs(src, dst, ec);
+}
+
+/**
+ * @brief clone/reflink file from src to dst, where the caller already knows both are on the same filesystem
+ *
+ */
+static bool clone_file_on_same_fs(const QString& src, const QString& dst, std::error_code& ec)
+{
+    auto src_path = StringUtils::toStdString(QDir::toNativeSeparators(QFileInfo(src).absoluteFilePath()));
+    auto dst_path = StringUtils::toStdString(QDir::toNativeSeparators(QFileInfo(dst).absoluteFilePath()));
+
 #if defined(Q_OS_WIN)
 
     if (!win_ioctl_clone(src_path, dst_path, ec)) {
@@ -1583,6 +1876,20 @@ bool canLink(const QString& src, const QString& dst)
     return canLinkOnFS(src) && canLinkOnFS(dst);
 }
 
+bool canSymlinkUnprivileged()
+{
+#if defined Q_OS_WIN32
+    // developer mode is only looked up once, turning it on takes a restart of the launcher to notice
+    static const bool developerMode =
+        QSettings(R"(HKEY_LOCAL_MACHINE\SOFTWARE\Microsoft\Windows\CurrentVersion\AppModelUnlock)", QSettings::NativeFormat)
+            .value("AllowDevelopmentWithoutDevLicense", 0)
+            .toInt() == 1;
+    return developerMode;
+#else
+    return true;
+#endif
+}
+
 uintmax_t hardLinkCount(const QString& path)
 {
     std::error_code err;
@@ -1594,6 +1901,28 @@ uintmax_t hardLinkCount(const QString& path)
     return count;
 }
 
+bool shareFile(const QString& src, const QString& dst, bool allowHardLink)
+{
+    if (!ensureFilePathExists(dst))
+        return false;
+    if (QFileInfo::exists(dst) && !QFile::remove(dst))
+        return false;
+
+    std::error_code err;
+    if (canClone(src, dst) && clone_file(src, dst, err))
+        return true;
+
+    if (allowHardLink && canLink(src, dst) && statFS(src).rootPath == statFS(dst).rootPath) {
+        err.clear();
+        fs::create_hard_link(StringUtils::toStdString(src), StringUtils::toStdString(dst), err);
+        if (!err)
+            return true;
+        qDebug() << "Failed to hard link" << src << "to" << dst << ":" << QString::fromStdString(err.message());
+    }
+
+    return QFile::copy(src, dst);
+}
+
 #ifdef Q_OS_WIN
 // returns 8.3 file format from long path
 QString shortPathName(const QString& file)
@@ -1623,14 +1952,29 @@ bool fitsInLocal8bit(const QString& string)
 
 QString getPathNameInLocal8bit(const QString& file)
 {
+    // launching goes through every library on the classpath, and the answer doesn't change for a path that exists
+    static QMutex s_mutex;
+    static QHash<QString, QString> s_cache;
+    {
+        QMutexLocker locker(&s_mutex);
+        auto it = s_cache.constFind(file);
+        if (it != s_cache.constEnd())
+            return *it;
+    }
+
+    auto result = file;
     if (!fitsInLocal8bit(file)) {
         auto path = shortPathName(file);
-        if (!path.isEmpty()) {
-            return path;
+        if (path.isEmpty()) {
+            // in case shortPathName fails just return the path as is, and try again next time: the file may not exist yet
+            return file;
         }
-        // in case shortPathName fails just return the path as is
+        result = path;
     }
-    return file;
+
+    QMutexLocker locker(&s_mutex);
+    s_cache.insert(file, result);
+    return result;
 }
 #endif
 
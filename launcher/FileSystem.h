@@ -40,11 +40,13 @@
 #include "Exception.h"
 #include "pathmatcher/IPathMatcher.h"
 
+#include <atomic>
 #include <system_error>
 
 #include <QDir>
 #include <QFlags>
 #include <QLocalServer>
+#include <QLocalSocket>
 #include <QObject>
 #include <QPair>
 #include <QThread>
@@ -130,15 +132,46 @@ class copy : public QObject {
         m_overwrite = overwrite;
         return *this;
     }
+    /// reflink/clone the files instead when both ends are on the same clone capable filesystem, copying the rest
+    copy& cloneWhenPossible(const bool clone)
+    {
+        m_cloneWhenPossible = clone;
+        return *this;
+    }
+    /// hard link the files instead when both ends are on the same filesystem, copying the rest
+    copy& linkWhenPossible(const bool link)
+    {
+        m_linkWhenPossible = link;
+        return *this;
+    }
+    /// move the files instead when both ends are on the same filesystem, copying the rest; the source keeps its folders
+    copy& moveWhenPossible(const bool move)
+    {
+        m_moveWhenPossible = move;
+        return *this;
+    }
+    /// at most this many files are copied at once, 0 picks a number for the destination device
+    copy& maxThreads(const int count)
+    {
+        m_maxThreads = count;
+        return *this;
+    }
 
     bool operator()(bool dryRun = false) { return operator()(QString(), dryRun); }
 
     qsizetype totalCopied() { return m_copied; }
     qsizetype totalFailed() { return m_failedPaths.length(); }
     QStringList failed() { return m_failedPaths; }
+    qint64 bytesCloned() { return m_bytesCloned; }
+    qint64 bytesCopied() { return m_bytesCopied; }
+    /// hard linked or moved
+    qint64 bytesLinked() { return m_bytesLinked; }
 
    signals:
-    void fileCopied(const QString& relativeName);
+    /// sent every so often while copying, with the file that was copied last
+    void copyProgress(qsizetype done, qsizetype total, const QString& relativeName);
+    /// sent along with copyProgress, in bytes
+    void sizeProgress(qint64 done, qint64 total);
     void copyFailed(const QString& relativeName);
     // TODO: maybe add a "shouldCopy" signal in the future?
 
@@ -150,9 +183,16 @@ class copy : public QObject {
     const IPathMatcher* m_matcher = nullptr;
     bool m_whitelist = false;
     bool m_overwrite = false;
+    bool m_cloneWhenPossible = false;
+    bool m_linkWhenPossible = false;
+    bool m_moveWhenPossible = false;
+    int m_maxThreads = 0;
     QDir m_src;
     QDir m_dst;
     qsizetype m_copied;
+    qint64 m_bytesCloned = 0;
+    qint64 m_bytesCopied = 0;
+    qint64 m_bytesLinked = 0;
     QStringList m_failedPaths;
 };
 
@@ -171,9 +211,7 @@ struct LinkResult {
 class ExternalLinkFileProcess : public QThread {
     Q_OBJECT
    public:
-    ExternalLinkFileProcess(QString server, bool useHardLinks, QObject* parent = nullptr)
-        : QThread(parent), m_useHardLinks(useHardLinks), m_server(server)
-    {}
+    ExternalLinkFileProcess(QString server, QObject* parent = nullptr) : QThread(parent), m_server(server) {}
 
     void run() override
     {
@@ -187,11 +225,54 @@ class ExternalLinkFileProcess : public QThread {
    private:
     void runLinkFile();
 
-    bool m_useHardLinks = false;
-
     QString m_server;
 };
 
+/**
+ * @brief the elevated filelink helper, started once and kept for the rest of the session
+ *
+ * Batches of links are queued and sent to the helper one after the other over the same connection, so only the first
+ * one pays for starting the process and for the UAC prompt. If the helper goes away, because the prompt was declined or
+ * it crashed, what was queued fails and the next batch starts a new one.
+ */
+class PrivilegedLinker : public QObject {
+    Q_OBJECT
+   public:
+    static PrivilegedLinker* instance();
+
+    /* Queues the links to be made by the helper, safe to call from any thread. Returns the id batchFinished reports. */
+    quint64 submit(const QList<LinkPair>& links, bool useHardLinks);
+
+   signals:
+    /* gotResults is false if the helper went away before it made the links. */
+    void batchFinished(quint64 id, const QList<FS::LinkResult>& results, bool gotResults);
+
+   private:
+    struct Batch {
+        quint64 id;
+        QList<LinkPair> links;
+        bool useHardLinks;
+    };
+
+    PrivilegedLinker();
+
+    void enqueue(Batch batch);
+    void startHelper();
+    void sendNext();
+    void readResults();
+    void helperExited();
+    void shutdown();
+
+    QLocalServer* m_server;
+    QLocalSocket* m_connection = nullptr;
+    ExternalLinkFileProcess* m_process = nullptr;
+    QList<Batch> m_queue;
+    // the batch the helper is working on, it's the first one queued
+    bool m_inFlight = false;
+    quint32 m_blockSize = 0;
+    std::atomic<quint64> m_nextId{ 1 };
+};
+
 /**
  * @brief links (a file / a directory and it's contents) from src to dest
  */
@@ -274,7 +355,8 @@ class create_link : public QObject {
     bool m_debug = false;
     std::error_code m_os_err;
 
-    QLocalServer m_linkServer;
+    quint64 m_privilegedBatch = 0;
+    QMetaObject::Connection m_privilegedConnection;
 };
 
 /**
@@ -551,10 +633,25 @@ bool canLinkOnFS(FilesystemType type);
  */
 bool canLink(const QString& src, const QString& dst);
 
+/**
+ * @brief if symbolic links can be made without elevation
+ * always true outside of Windows, where it takes developer mode to be on
+ */
+bool canSymlinkUnprivileged();
+
 uintmax_t hardLinkCount(const QString& path);
 
+/**
+ * @brief make dst hold the same contents as src, sharing the underlying data when possible
+ * tries a reflink/clone first, then a hard link if allowed, and falls back to a plain copy
+ * @return if dst now holds the contents of src
+ */
+bool shareFile(const QString& src, const QString& dst, bool allowHardLink = true);
+
 #ifdef Q_OS_WIN
 QString getPathNameInLocal8bit(const QString& file);
 #endif
 
 }  // namespace FS
+
+Q_DECLARE_METATYPE(FS::LinkResult)
@@ -36,57 +36,146 @@
 #include "GZip.h"
 #include <zlib.h>
 #include <QByteArray>
+#include <QIODevice>
 
-bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes)
+#include <cstring>
+#include <limits>
+
+namespace {
+// how much is read from or written to devices at once
+constexpr int CHUNK_SIZE = 64 * 1024;
+// don't trust a trailer saying the data is bigger than this, it's most likely lying
+constexpr qint64 MAX_PREALLOCATION = 512 * 1024 * 1024;
+// deflate can't make data smaller than about this many times
+constexpr qint64 MAX_DEFLATE_RATIO = 1032;
+
+// the uncompressed size the gzip trailer gives, if it's believable. 0 if it isn't
+qint64 trailerSize(const char* trailer, qint64 compressedSize)
 {
-    if (compressedBytes.size() == 0) {
-        uncompressedBytes = compressedBytes;
-        return true;
-    }
+    auto bytes = reinterpret_cast<const unsigned char*>(trailer);
+    qint64 size = qint64(bytes[0]) | (qint64(bytes[1]) << 8) | (qint64(bytes[2]) << 16) | (qint64(bytes[3]) << 24);
+    // it's the size modulo 4 GiB, and only of the last member if there's more than one
+    if (size > compressedSize * MAX_DEFLATE_RATIO || size > MAX_PREALLOCATION)
+        return 0;
+    return size;
+}
 
-    unsigned uncompLength = compressedBytes.size();
-    uncompressedBytes.clear();
-    uncompressedBytes.resize(uncompLength);
+/* Inflates the stream that refill hands over, a piece at a time, into out. refill returns false once there's no more */
+template <typename Refill>
+bool inflateStream(QByteArray& out, qint64 sizeHint, Refill refill)
+{
+    // with a byte to spare, an exact hint is done without ever running out of room
+    int capacity = sizeHint > 0 ? static_cast<int>(sizeHint) + 1 : CHUNK_SIZE;
+    out.clear();
+    out.resize(capacity);
 
     z_stream strm;
     memset(&strm, 0, sizeof(strm));
-    strm.next_in = (Bytef*)compressedBytes.data();
-    strm.avail_in = compressedBytes.size();
-
-    bool done = false;
-
     if (inflateInit2(&strm, (16 + MAX_WBITS)) != Z_OK) {
         return false;
     }
 
+    bool inputDone = false;
     int err = Z_OK;
-
-    while (!done) {
+    while (true) {
+        if (strm.avail_in == 0 && !inputDone) {
+            inputDone = !refill(strm);
+        }
         // If our output buffer is too small
-        if (strm.total_out >= uncompLength) {
-            uncompressedBytes.resize(uncompLength * 2);
-            uncompLength *= 2;
+        if (strm.total_out >= static_cast<uLong>(capacity)) {
+            if (capacity > std::numeric_limits<int>::max() / 2) {
+                err = Z_MEM_ERROR;
+                break;
+            }
+            capacity *= 2;
+            out.resize(capacity);
         }
 
-        strm.next_out = reinterpret_cast<Bytef*>((uncompressedBytes.data() + strm.total_out));
-        strm.avail_out = uncompLength - strm.total_out;
+        strm.next_out = reinterpret_cast<Bytef*>(out.data() + strm.total_out);
+        strm.avail_out = capacity - strm.total_out;
 
         // Inflate another chunk.
-        err = inflate(&strm, Z_SYNC_FLUSH);
-        if (err == Z_STREAM_END)
-            done = true;
-        else if (err != Z_OK) {
+        err = inflate(&strm, Z_NO_FLUSH);
+        if (err == Z_STREAM_END) {
+            break;
+        }
+        if (err == Z_BUF_ERROR) {
+            // out of input or room, get more of whichever it is. Without any more input, it's cut short
+            if (inputDone && strm.avail_in == 0 && strm.avail_out > 0)
+                break;
+            continue;
+        }
+        if (err != Z_OK) {
             break;
         }
     }
 
-    if (inflateEnd(&strm) != Z_OK || !done) {
+    if (inflateEnd(&strm) != Z_OK || err != Z_STREAM_END) {
         return false;
     }
 
-    uncompressedBytes.resize(strm.total_out);
+    out.resize(strm.total_out);
     return true;
 }
+}  // namespace
+
+bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes)
+{
+    if (compressedBytes.size() == 0) {
+        uncompressedBytes = compressedBytes;
+        return true;
+    }
+
+    // start from what the trailer says, or from the compressed size if it can't be believed
+    qint64 sizeHint = 0;
+    if (compressedBytes.size() >= 4) {
+        sizeHint = trailerSize(compressedBytes.constData() + compressedBytes.size() - 4, compressedBytes.size());
+    }
+    if (sizeHint == 0) {
+        sizeHint = compressedBytes.size();
+    }
+
+    bool given = false;
+    return inflateStream(uncompressedBytes, sizeHint, [&](z_stream& strm) {
+        if (given)
+            return false;
+        given = true;
+        strm.next_in = (Bytef*)compressedBytes.data();
+        strm.avail_in = compressedBytes.size();
+        return true;
+    });
+}
+
+bool GZip::unzip(QIODevice& device, QByteArray& uncompressedBytes)
+{
+    if (device.atEnd()) {
+        uncompressedBytes.clear();
+        return true;
+    }
+
+    qint64 sizeHint = 0;
+    if (!device.isSequential()) {
+        auto start = device.pos();
+        auto compressedSize = device.size() - start;
+        if (compressedSize >= 4 && device.seek(device.size() - 4)) {
+            auto trailer = device.read(4);
+            if (trailer.size() == 4)
+                sizeHint = trailerSize(trailer.constData(), compressedSize);
+        }
+        if (!device.seek(start))
+            return false;
+    }
+
+    QByteArray chunk;
+    return inflateStream(uncompressedBytes, sizeHint, [&](z_stream& strm) {
+        chunk = device.read(CHUNK_SIZE);
+        if (chunk.isEmpty())
+            return false;
+        strm.next_in = (Bytef*)chunk.data();
+        strm.avail_in = chunk.size();
+        return true;
+    });
+}
 
 bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
 {
@@ -95,10 +184,6 @@ bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
         return true;
     }
 
-    unsigned compLength = qMin(uncompressedBytes.size(), 16);
-    compressedBytes.clear();
-    compressedBytes.resize(compLength);
-
     z_stream zs;
     memset(&zs, 0, sizeof(zs));
 
@@ -106,26 +191,18 @@ bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
         return false;
     }
 
+    // deflateBound leaves out the gzip header and trailer
+    compressedBytes.clear();
+    compressedBytes.resize(static_cast<int>(deflateBound(&zs, uncompressedBytes.size())) + 18);
+
     zs.next_in = (Bytef*)uncompressedBytes.data();
     zs.avail_in = uncompressedBytes.size();
+    zs.next_out = reinterpret_cast<Bytef*>(compressedBytes.data());
+    zs.avail_out = compressedBytes.size();
 
-    int ret;
-    compressedBytes.resize(uncompressedBytes.size());
-
-    unsigned offset = 0;
-    unsigned temp = 0;
-    do {
-        auto remaining = compressedBytes.size() - offset;
-        if (remaining < 1) {
-            compressedBytes.resize(compressedBytes.size() * 2);
-        }
-        zs.next_out = reinterpret_cast<Bytef*>((compressedBytes.data() + offset));
-        temp = zs.avail_out = compressedBytes.size() - offset;
-        ret = deflate(&zs, Z_FINISH);
-        offset += temp - zs.avail_out;
-    } while (ret == Z_OK);
-
-    compressedBytes.resize(offset);
+    // that's enough room to do it all at once
+    int ret = deflate(&zs, Z_FINISH);
+    compressedBytes.resize(zs.total_out);
 
     if (deflateEnd(&zs) != Z_OK) {
         return false;
@@ -136,3 +213,36 @@ bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
     }
     return true;
 }
+
+bool GZip::zip(const QByteArray& uncompressedBytes, QIODevice& device)
+{
+    if (uncompressedBytes.size() == 0) {
+        return true;
+    }
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (16 + MAX_WBITS), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    zs.next_in = (Bytef*)uncompressedBytes.data();
+    zs.avail_in = uncompressedBytes.size();
+
+    QByteArray chunk(CHUNK_SIZE, Qt::Uninitialized);
+    int ret;
+    do {
+        zs.next_out = reinterpret_cast<Bytef*>(chunk.data());
+        zs.avail_out = chunk.size();
+        ret = deflate(&zs, Z_FINISH);
+        auto produced = chunk.size() - zs.avail_out;
+        if (produced > 0 && device.write(chunk.constData(), produced) != produced) {
+            ret = Z_ERRNO;
+            break;
+        }
+    } while (ret == Z_OK || ret == Z_BUF_ERROR);
+
+    auto endRet = deflateEnd(&zs);
+    return ret == Z_STREAM_END && endRet == Z_OK;
+}
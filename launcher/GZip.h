@@ -1,8 +1,15 @@
 #pragma once
 #include <QByteArray>
 
+class QIODevice;
+
 class GZip {
    public:
     static bool unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes);
     static bool zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes);
+
+    /* Like unzip, but reads the compressed data from the device as it goes, instead of all of it up front. */
+    static bool unzip(QIODevice& device, QByteArray& uncompressedBytes);
+    /* Like zip, but writes the compressed data to the device as it goes. */
+    static bool zip(const QByteArray& uncompressedBytes, QIODevice& device);
 };
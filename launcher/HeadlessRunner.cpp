@@ -0,0 +1,355 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "HeadlessRunner.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <cstdio>
+#include <memory>
+
+#include "Application.h"
+#include "FileIgnoreProxy.h"
+#include "FileSystem.h"
+#include "InstanceImportTask.h"
+#include "InstanceList.h"
+#include "MMCZip.h"
+#include "minecraft/MinecraftInstance.h"
+#include "minecraft/PackProfile.h"
+#include "minecraft/mod/ModFolderModel.h"
+#include "modplatform/ModIndex.h"
+#include "modplatform/flame/FlameCheckUpdate.h"
+#include "modplatform/modrinth/ModrinthCheckUpdate.h"
+#include "modplatform/modrinth/ModrinthPackExportTask.h"
+#include "settings/SettingsObject.h"
+#include "tasks/SequentialTask.h"
+
+namespace {
+
+ModPlatform::ProviderCapabilities ProviderCaps;
+
+/* Looks for updates of all the mods of an instance that know where they come from, like the mod update dialog does
+ * once it has made sure they have metadata. */
+class ModUpdateCheck : public Task {
+   public:
+    explicit ModUpdateCheck(std::shared_ptr<MinecraftInstance> instance) : m_instance(std::move(instance)) {}
+
+    QJsonObject result() const
+    {
+        return { { "updates", m_updates }, { "failures", m_failures }, { "untracked", m_untracked } };
+    }
+
+    bool canAbort() const override { return true; }
+
+    bool abort() override
+    {
+        if (m_checks)
+            return m_checks->abort();
+        emitAborted();
+        return true;
+    }
+
+   protected:
+    void executeTask() override
+    {
+        setStatus(tr("Reading the mods of %1").arg(m_instance->name()));
+        m_model = m_instance->loaderModList();
+        if (m_model->isUpToDate()) {
+            check();
+            return;
+        }
+        m_modelUpdated = connect(m_model.get(), &ResourceFolderModel::updateFinished, this, [this] {
+            disconnect(m_modelUpdated);
+            check();
+        });
+        if (!m_model->isUpdating())
+            m_model->update();
+    }
+
+   private:
+    void check()
+    {
+        for (auto* mod : m_model->allMods()) {
+            if (!mod->enabled())
+                continue;
+            if (!mod->metadata()) {
+                m_untracked.append(mod->name());
+                continue;
+            }
+            (mod->metadata()->provider == ModPlatform::ResourceProvider::MODRINTH ? m_modrinth : m_flame).append(mod);
+        }
+
+        auto profile = m_instance->getPackProfile();
+        m_versions = { profile->getComponent("net.minecraft")->getVersion() };
+        auto loaders = profile->getSupportedModLoaders();
+
+        // the providers don't depend on each other
+        m_checks = makeShared<ConcurrentTask>(nullptr, tr("Checking for updates"));
+        auto addCheck = [this](shared_qobject_ptr<CheckUpdateTask> check) {
+            connect(check.get(), &CheckUpdateTask::checkFailed, this, [this](Mod* mod, QString reason, QUrl) {
+                m_failures.append(QJsonObject{ { "name", mod->name() }, { "reason", reason } });
+            });
+            connect(check.get(), &Task::succeeded, this, [this, check] {
+                for (auto& update : check->getUpdatable()) {
+                    m_updates.append(QJsonObject{ { "name", update.name },
+                                                  { "oldVersion", update.old_version },
+                                                  { "newVersion", update.new_version },
+                                                  { "provider", ProviderCaps.name(update.provider) } });
+                }
+            });
+            m_checks->addTask(check);
+        };
+        if (!m_modrinth.isEmpty())
+            addCheck(makeShared<ModrinthCheckUpdate>(m_modrinth, m_versions, loaders, m_model));
+        if (!m_flame.isEmpty())
+            addCheck(makeShared<FlameCheckUpdate>(m_flame, m_versions, loaders, m_model));
+
+        connect(m_checks.get(), &Task::status, this, &Task::setStatus);
+        connect(m_checks.get(), &Task::progress, this, &Task::setProgress);
+        connect(m_checks.get(), &Task::succeeded, this, &ModUpdateCheck::emitSucceeded);
+        connect(m_checks.get(), &Task::failed, this, &ModUpdateCheck::emitFailed);
+        connect(m_checks.get(), &Task::aborted, this, &ModUpdateCheck::emitAborted);
+        m_checks->start();
+    }
+
+    std::shared_ptr<MinecraftInstance> m_instance;
+    std::shared_ptr<ModFolderModel> m_model;
+    QMetaObject::Connection m_modelUpdated;
+    ConcurrentTask::Ptr m_checks;
+
+    // the update checks only keep references to these
+    QList<Mod*> m_modrinth;
+    QList<Mod*> m_flame;
+    std::list<Version> m_versions;
+
+    QJsonArray m_updates;
+    QJsonArray m_failures;
+    QJsonArray m_untracked;
+};
+
+/* What the export dialogs leave out unless they are told otherwise. */
+std::shared_ptr<FileIgnoreProxy> exportFilter(InstancePtr instance, bool modpack)
+{
+    if (modpack) {
+        const QDir root(instance->gameRoot());
+        auto proxy = std::make_shared<FileIgnoreProxy>(instance->gameRoot(), nullptr);
+        proxy->ignoreFilesWithPath().insert({ "logs", "crash-reports", ".cache", ".fabric", ".quilt" });
+        proxy->ignoreFilesWithName().append({ ".DS_Store", "thumbs.db", "Thumbs.db" });
+        for (const QString& file : root.entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::AllDirs | QDir::Hidden)) {
+            if (!(file == "mods" || file == "coremods" || file == "datapacks" || file == "config" || file == "options.txt" ||
+                  file == "servers.dat"))
+                proxy->blockedPaths().insert(file);
+        }
+        if (auto mcInstance = std::dynamic_pointer_cast<MinecraftInstance>(instance)) {
+            const QDir index = mcInstance->loaderModList()->indexDir();
+            if (index.exists())
+                proxy->ignoreFilesWithPath().insert(root.relativeFilePath(index.absolutePath()));
+        }
+        return proxy;
+    }
+
+    auto proxy = std::make_shared<FileIgnoreProxy>(instance->instanceRoot(), nullptr);
+    auto prefix = QDir(instance->instanceRoot()).relativeFilePath(instance->gameRoot());
+    proxy->ignoreFilesWithPath().insert({ FS::PathCombine(prefix, "logs"), FS::PathCombine(prefix, "crash-reports"),
+                                          FS::PathCombine(prefix, ".cache"), FS::PathCombine(prefix, ".fabric"),
+                                          FS::PathCombine(prefix, ".quilt") });
+    proxy->ignoreFilesWithName().append({ ".DS_Store", "thumbs.db", "Thumbs.db" });
+
+    // what was left out the last time the instance was exported from the dialog
+    QFile ignoreFile(FS::PathCombine(instance->instanceRoot(), ".packignore"));
+    if (ignoreFile.open(QIODevice::ReadOnly)) {
+        auto data = QString::fromUtf8(ignoreFile.readAll());
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+        proxy->setBlockedPaths(data.split('\n', Qt::SkipEmptyParts));
+#else
+        proxy->setBlockedPaths(data.split('\n', QString::SkipEmptyParts));
+#endif
+    }
+    return proxy;
+}
+
+}  // namespace
+
+HeadlessRunner::HeadlessRunner(Actions actions, QObject* parent) : QObject(parent), m_actions(std::move(actions))
+{
+    m_tasks = makeShared<ConcurrentTask>(nullptr, tr("Headless actions"), APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
+    connect(m_tasks.get(), &Task::finished, this, &HeadlessRunner::allDone);
+}
+
+void HeadlessRunner::start()
+{
+    for (auto& url : m_actions.import)
+        add("import", url.toString(), importTask(url));
+
+    // in the order they happen to each instance
+    for (auto& id : m_actions.update)
+        add("update", id, updateTask(id));
+    for (auto& id : m_actions.checkModUpdates) {
+        std::function<QJsonObject()> result;
+        auto task = checkModUpdatesTask(id, result);
+        add("checkModUpdates", id, task, result);
+    }
+    for (auto& [id, output] : m_actions.exports)
+        add("export", id, exportTask(id, output));
+
+    if (m_running.isEmpty()) {
+        allDone();
+        return;
+    }
+    m_tasks->start();
+}
+
+void HeadlessRunner::add(const QString& name, const QString& target, Task::Ptr task, std::function<QJsonObject()> result)
+{
+    if (!task)
+        return;
+
+    m_running.insert(task.get(), { name, target });
+    connect(task.get(), &Task::status, this, [this, task = task.get()](QString status) {
+        report(m_running[task], "status", { { "status", status } });
+    });
+    connect(task.get(), &Task::progress, this, [this, task = task.get()](qint64 current, qint64 total) {
+        auto& action = m_running[task];
+        // one line per percent is plenty for whoever reads this
+        int percent = total > 0 ? static_cast<int>(current * 100 / total) : 0;
+        if (percent == action.percent)
+            return;
+        action.percent = percent;
+        report(action, "progress", { { "current", double(current) }, { "total", double(total) } });
+    });
+    connect(task.get(), &Task::succeeded, this, [this, task = task.get(), result] {
+        auto& action = m_running[task];
+        action.done = true;
+        QJsonObject data;
+        if (!task->warnings().isEmpty())
+            data.insert("warnings", QJsonArray::fromStringList(task->warnings()));
+        if (result) {
+            auto extra = result();
+            for (auto it = extra.constBegin(); it != extra.constEnd(); ++it)
+                data.insert(it.key(), it.value());
+        }
+        report(action, "succeeded", data);
+    });
+    connect(task.get(), &Task::failed, this, [this, task = task.get()](QString reason) {
+        auto& action = m_running[task];
+        action.done = true;
+        m_failed = true;
+        report(action, "failed", { { "reason", reason } });
+    });
+    connect(task.get(), &Task::aborted, this, [this, task = task.get()] {
+        auto& action = m_running[task];
+        action.done = true;
+        m_failed = true;
+        report(action, "failed", { { "reason", tr("Aborted") } });
+    });
+
+    if (name == "import") {
+        m_tasks->addTask(task);
+        return;
+    }
+    auto& queue = m_instanceQueues[target];
+    if (!queue) {
+        queue = makeShared<SequentialTask>(nullptr, tr("Working on %1").arg(target));
+        m_tasks->addTask(queue);
+    }
+    queue->addTask(task);
+}
+
+void HeadlessRunner::reject(const QString& name, const QString& target, const QString& reason)
+{
+    m_failed = true;
+    report({ name, target }, "failed", { { "reason", reason } });
+}
+
+void HeadlessRunner::report(const Action& action, const QString& event, QJsonObject data)
+{
+    data.insert("action", action.name);
+    data.insert("target", action.target);
+    data.insert("event", event);
+    // stdout is only for these, the log goes to stderr
+    auto line = QJsonDocument(data).toJson(QJsonDocument::Compact);
+    fprintf(stdout, "%s\n", line.constData());
+    fflush(stdout);
+}
+
+void HeadlessRunner::allDone()
+{
+    for (auto& action : m_running) {
+        if (!action.done) {
+            m_failed = true;
+            report(action, "skipped");
+        }
+    }
+    report({}, "finished", { { "success", !m_failed } });
+
+    // the tasks may still be on the stack
+    QMetaObject::invokeMethod(this, [this] { emit finished(!m_failed); }, Qt::QueuedConnection);
+}
+
+Task::Ptr HeadlessRunner::updateTask(const QString& id)
+{
+    auto instance = APPLICATION->instances()->getInstanceById(id);
+    if (!instance) {
+        reject("update", id, tr("There is no instance with this ID"));
+        return nullptr;
+    }
+    auto task = instance->createUpdateTask(Net::Mode::Online);
+    if (!task)
+        report({ "update", id }, "succeeded");
+    return task;
+}
+
+Task::Ptr HeadlessRunner::importTask(const QUrl& url)
+{
+    auto import = new InstanceImportTask(url);
+    import->setName(QFileInfo(url.fileName()).completeBaseName());
+    import->setIcon("default");
+    // nobody is there to confirm updating a pack that is already installed
+    import->setConfirmUpdate(false);
+    return Task::Ptr(APPLICATION->instances()->wrapInstanceTask(import));
+}
+
+Task::Ptr HeadlessRunner::checkModUpdatesTask(const QString& id, std::function<QJsonObject()>& result)
+{
+    auto instance = std::dynamic_pointer_cast<MinecraftInstance>(APPLICATION->instances()->getInstanceById(id));
+    if (!instance) {
+        reject("checkModUpdates", id, tr("There is no Minecraft instance with this ID"));
+        return nullptr;
+    }
+    auto task = makeShared<ModUpdateCheck>(instance);
+    result = [check = task.get()] { return check->result(); };
+    return task;
+}
+
+Task::Ptr HeadlessRunner::exportTask(const QString& id, const QString& output)
+{
+    auto instance = APPLICATION->instances()->getInstanceById(id);
+    if (!instance) {
+        reject("export", id, tr("There is no instance with this ID"));
+        return nullptr;
+    }
+
+    bool modpack = output.endsWith(".mrpack");
+    auto filter = exportFilter(instance, modpack);
+    auto excluded = [filter](const QString& file) { return filter->filterFile(file); };
+
+    if (modpack) {
+        auto settings = instance->settings();
+        auto name = settings->get("ExportName").toString();
+        return makeShared<ModrinthPackExportTask>(name.isEmpty() ? instance->name() : name, settings->get("ExportVersion").toString(),
+                                                  settings->get("ExportSummary").toString(),
+                                                  settings->get("ExportOptionalFiles").toBool(), instance, output, excluded);
+    }
+
+    QFileInfoList files;
+    if (!MMCZip::collectFileListRecursively(instance->instanceRoot(), nullptr, &files, excluded)) {
+        reject("export", id, tr("Unable to export instance"));
+        return nullptr;
+    }
+    return makeShared<MMCZip::ExportToZipTask>(output, instance->instanceRoot(), files, "", true, true);
+}
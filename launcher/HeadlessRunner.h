@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QStringList>
+#include <QUrl>
+
+#include <functional>
+
+#include "tasks/ConcurrentTask.h"
+
+/** Runs what was asked for on the command line with --headless, without any window, and exits once it's done.
+ *
+ *  Everything done to one instance happens in order: it is updated, checked for mod updates and then exported.
+ *  Different instances, and imports, are worked on at the same time.
+ *
+ *  Progress is written to stdout as JSON, one object per line, with the "action" and "target" it is about and an
+ *  "event": "status", "progress", "succeeded", "failed" or "skipped" (when an earlier action on the same instance failed).
+ *  The last line is a "finished" event, with whether everything went well.
+ */
+class HeadlessRunner : public QObject {
+    Q_OBJECT
+   public:
+    struct Actions {
+        QStringList update;
+        QList<QUrl> import;
+        QStringList checkModUpdates;
+        // instance ID, and the file to export it to
+        QList<QPair<QString, QString>> exports;
+
+        bool isEmpty() const { return update.isEmpty() && import.isEmpty() && checkModUpdates.isEmpty() && exports.isEmpty(); }
+    };
+
+    explicit HeadlessRunner(Actions actions, QObject* parent = nullptr);
+
+    void start();
+
+   signals:
+    void finished(bool success);
+
+   private:
+    struct Action {
+        QString name;
+        QString target;
+        bool done = false;
+        int percent = -1;
+    };
+
+    /* Reports on 'task', and queues it after what was already queued for the same instance, if any. */
+    void add(const QString& name, const QString& target, Task::Ptr task, std::function<QJsonObject()> result = {});
+    /* An action that failed before it could even start. */
+    void reject(const QString& name, const QString& target, const QString& reason);
+    void report(const Action& action, const QString& event, QJsonObject data = {});
+    void allDone();
+
+    Task::Ptr updateTask(const QString& id);
+    Task::Ptr importTask(const QUrl& url);
+    Task::Ptr checkModUpdatesTask(const QString& id, std::function<QJsonObject()>& result);
+    Task::Ptr exportTask(const QString& id, const QString& output);
+
+   private:
+    Actions m_actions;
+    ConcurrentTask::Ptr m_tasks;
+    QHash<QString, ConcurrentTask::Ptr> m_instanceQueues;
+    QHash<Task*, Action> m_running;
+    bool m_failed = false;
+};
@@ -125,6 +125,11 @@ bool InstanceCopyPrefs::isUseCloneEnabled() const
     return useClone;
 }
 
+bool InstanceCopyPrefs::isUseOverlayEnabled() const
+{
+    return useOverlay;
+}
+
 // ======= Setters =======
 void InstanceCopyPrefs::enableCopySaves(bool b)
 {
@@ -189,4 +194,9 @@ void InstanceCopyPrefs::enableDontLinkSaves(bool b)
 void InstanceCopyPrefs::enableUseClone(bool b)
 {
     useClone = b;
+}
+
+void InstanceCopyPrefs::enableUseOverlay(bool b)
+{
+    useOverlay = b;
 }
\ No newline at end of file
@@ -25,6 +25,7 @@ struct InstanceCopyPrefs {
     [[nodiscard]] bool isUseHardLinksEnabled() const;
     [[nodiscard]] bool isDontLinkSavesEnabled() const;
     [[nodiscard]] bool isUseCloneEnabled() const;
+    [[nodiscard]] bool isUseOverlayEnabled() const;
     // Setters
     void enableCopySaves(bool b);
     void enableKeepPlaytime(bool b);
@@ -39,6 +40,7 @@ struct InstanceCopyPrefs {
     void enableUseHardLinks(bool b);
     void enableDontLinkSaves(bool b);
     void enableUseClone(bool b);
+    void enableUseOverlay(bool b);
 
    protected:  // data
     bool copySaves = true;
@@ -54,4 +56,5 @@ struct InstanceCopyPrefs {
     bool useHardLinks = false;
     bool dontLinkSaves = false;
     bool useClone = false;
+    bool useOverlay = false;
 };
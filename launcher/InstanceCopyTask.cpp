@@ -2,9 +2,11 @@
 #include <QDebug>
 #include <QtConcurrentRun>
 #include "FileSystem.h"
+#include "InstanceOverlay.h"
 #include "NullInstance.h"
 #include "pathmatcher/RegexpMatcher.h"
 #include "settings/INISettingsObject.h"
+#include "tasks/CpuExecutor.h"
 
 InstanceCopyTask::InstanceCopyTask(InstancePtr origInstance, const InstanceCopyPrefs& prefs)
 {
@@ -15,8 +17,13 @@ InstanceCopyTask::InstanceCopyTask(InstancePtr origInstance, const InstanceCopyP
     m_useHardLinks = prefs.isLinkRecursivelyEnabled() && prefs.isUseHardLinksEnabled();
     m_copySaves = prefs.isLinkRecursivelyEnabled() && prefs.isDontLinkSavesEnabled() && prefs.isCopySavesEnabled();
     m_useClone = prefs.isUseCloneEnabled();
+    m_useOverlay = prefs.isUseOverlayEnabled();
 
     QString filters = prefs.getSelectedFiltersAsRegex();
+    if (m_useOverlay) {
+        // the game folder is filled from the original by the overlay itself
+        filters = "^[.]?minecraft/|^[.]prism-overlay$";
+    }
     if (m_useLinks || m_useHardLinks) {
         if (!filters.isEmpty())
             filters += "|";
@@ -37,6 +44,8 @@ InstanceCopyTask::InstanceCopyTask(InstancePtr origInstance, const InstanceCopyP
 void InstanceCopyTask::executeTask()
 {
     setStatus(tr("Copying instance %1").arg(m_origInstance->name()));
+    // copy the settings as they are now, not as they were before the last few changes
+    m_origInstance->settings()->saveNow();
 
     auto copySaves = [&]() {
         QFileInfo mcDir(FS::PathCombine(m_stagingPath, "minecraft"));
@@ -55,7 +64,21 @@ void InstanceCopyTask::executeTask()
     };
 
     m_copyFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this, copySaves] {
-        if (m_useClone) {
+        if (m_useOverlay) {
+            FS::copy folderCopy(m_origInstance->instanceRoot(), m_stagingPath);
+            folderCopy.followSymlinks(false).matcher(m_matcher.get());
+            if (!folderCopy())
+                return false;
+
+            // same folder name as the original, so the game root is found the same way
+            auto gameRoot = FS::PathCombine(m_stagingPath, QFileInfo(m_origInstance->gameRoot()).fileName());
+            InstanceOverlay overlay(m_origInstance->gameRoot(), gameRoot, InstanceOverlay::manifestPath(m_stagingPath));
+            if (!overlay.materialize()) {
+                qWarning() << "Failed to create the overlay:" << overlay.errorString();
+                return false;
+            }
+            return true;
+        } else if (m_useClone) {
             FS::clone folderClone(m_origInstance->instanceRoot(), m_stagingPath);
             folderClone.matcher(m_matcher.get());
 
@@ -69,7 +92,8 @@ void InstanceCopyTask::executeTask()
 
             if (!folderLink()) {
 #if defined Q_OS_WIN32
-                if (!m_useHardLinks) {
+                // in developer mode the links are made without elevation, so it wouldn't help with whatever went wrong
+                if (!m_useHardLinks && !FS::canSymlinkUnprivileged()) {
                     qDebug() << "EXPECTED: Link failure, Windows requires permissions for symlinks";
 
                     qDebug() << "attempting to run with privelage";
@@ -114,8 +138,14 @@ void InstanceCopyTask::executeTask()
 
             return !there_were_errors;
         } else {
+            // clones when both folders are on a reflink capable filesystem, which makes the copy nearly free
+            // a running game gets the disk first, the copy threads started from here inherit the lower I/O priority
+            CpuExecutor::YieldToGame yield;
             FS::copy folderCopy(m_origInstance->instanceRoot(), m_stagingPath);
-            folderCopy.followSymlinks(false).matcher(m_matcher.get());
+            folderCopy.followSymlinks(false).cloneWhenPossible(true).matcher(m_matcher.get());
+            folderCopy.maxThreads(CpuExecutor::gameRunning() ? 1 : 0);
+            connect(&folderCopy, &FS::copy::copyProgress, this,
+                    [this](qsizetype done, qsizetype total, const QString&) { setProgress(done, total); });
 
             return folderCopy();
         }
@@ -142,6 +172,10 @@ void InstanceCopyTask::copyFinished()
     if (!m_keepPlaytime) {
         inst->resetTimePlayed();
     }
+    if (m_useOverlay) {
+        inst->setOverlayBaseId(m_origInstance->id());
+        inst->addLinkedInstanceId(m_origInstance->id());
+    }
     if (m_useLinks) {
         inst->addLinkedInstanceId(m_origInstance->id());
         auto allowed_symlinks_file = QFileInfo(FS::PathCombine(inst->gameRoot(), "allowed_symlinks.txt"));
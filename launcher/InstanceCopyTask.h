@@ -34,4 +34,5 @@ class InstanceCopyTask : public InstanceTask {
     bool m_copySaves = false;
     bool m_linkRecursively = false;
     bool m_useClone = false;
+    bool m_useOverlay = false;
 };
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "InstanceDeleteTask.h"
+
+#include <QDebug>
+
+#include <filesystem>
+
+#include "FileSystem.h"
+#include "StringUtils.h"
+#include "tasks/CpuExecutor.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// deep enough to count the worlds of an instance one by one, without walking all of their files first
+constexpr int PROGRESS_DEPTH = 3;
+
+/* What to remove to get rid of 'path', deepest first. Only real folders are looked into, never symlinks or junctions. */
+void collect(const fs::path& path, int depth, std::vector<fs::path>& out)
+{
+    std::error_code err;
+    if (depth < PROGRESS_DEPTH && fs::symlink_status(path, err).type() == fs::file_type::directory) {
+        for (auto it = fs::directory_iterator(path, err); !err && it != fs::directory_iterator(); it.increment(err))
+            collect(it->path(), depth + 1, out);
+    }
+    out.push_back(path);
+}
+
+}  // namespace
+
+InstanceDeleteTask::InstanceDeleteTask(QStringList paths, QObject* parent)
+    : Task(parent), m_paths(std::move(paths)), m_counters(std::make_shared<Counters>())
+{
+    m_progressTimer.setInterval(100);
+    connect(&m_progressTimer, &QTimer::timeout, this, [this] { setProgress(m_counters->done, m_counters->total); });
+    connect(&m_watcher, &QFutureWatcher<QString>::finished, this, [this] {
+        m_progressTimer.stop();
+        auto error = m_watcher.result();
+        if (error.isEmpty())
+            emitSucceeded();
+        else
+            emitFailed(error);
+    });
+}
+
+void InstanceDeleteTask::executeTask()
+{
+    setStatus(tr("Deleting files"));
+    m_progressTimer.start();
+    m_watcher.setFuture(CpuExecutor::run(CpuExecutor::Priority::Background, [paths = m_paths, counters = m_counters] {
+        CpuExecutor::YieldToGame yield;
+
+        std::vector<fs::path> entries;
+        for (auto& path : paths)
+            collect(StringUtils::toStdString(path), 0, entries);
+        counters->total = static_cast<qint64>(entries.size());
+
+        QString error;
+        for (auto& entry : entries) {
+            std::error_code err;
+            fs::remove_all(entry, err);
+            if (err && error.isEmpty())
+                error = QString::fromStdString(err.message());
+            counters->done++;
+        }
+        if (!error.isEmpty())
+            qWarning() << "Failed to remove files:" << error;
+        return error;
+    }));
+}
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QFutureWatcher>
+#include <QStringList>
+#include <QTimer>
+
+#include <atomic>
+#include <memory>
+
+#include "tasks/Task.h"
+
+/** Deletes folders on a background worker, reporting how far it got.
+ *
+ *  Whoever creates it should first move what is to be deleted out of the way, so nothing has to wait for this.
+ */
+class InstanceDeleteTask : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<InstanceDeleteTask>;
+
+    explicit InstanceDeleteTask(QStringList paths, QObject* parent = nullptr);
+
+   protected:
+    void executeTask() override;
+
+   private:
+    struct Counters {
+        std::atomic<qint64> done = 0;
+        std::atomic<qint64> total = 0;
+    };
+
+    QStringList m_paths;
+    std::shared_ptr<Counters> m_counters;
+    QFutureWatcher<QString> m_watcher;
+    QTimer m_progressTimer;
+};
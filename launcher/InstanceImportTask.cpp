@@ -54,10 +54,12 @@
 
 #include "net/ApiDownload.h"
 
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QtConcurrentRun>
 #include <algorithm>
 
-#include <quazip/quazipdir.h>
+#include <quazip/quazipfile.h>
 
 InstanceImportTask::InstanceImportTask(const QUrl& sourceUrl, QWidget* parent, QMap<QString, QString>&& extra_info)
     : m_sourceUrl(sourceUrl), m_extra_info(extra_info), m_parent(parent)
@@ -76,6 +78,8 @@ bool InstanceImportTask::abort()
         m_extractFuture.cancel();
         m_extractFuture.waitForFinished();
     }
+    for (auto& watcher : m_chunkWatchers)
+        watcher->waitForFinished();
 
     return Task::abort();
 }
@@ -91,7 +95,7 @@ void InstanceImportTask::executeTask()
         setStatus(tr("Downloading modpack:\n%1").arg(m_sourceUrl.toString()));
         m_downloadRequired = true;
 
-        downloadFromUrl();
+        streamFromUrl();
     }
 }
 
@@ -135,25 +139,269 @@ void InstanceImportTask::downloadAborted()
     m_filesNetJob.reset();
 }
 
-void InstanceImportTask::processZipPack()
+// how much of an archive one range request asks for, at most; each range is extracted once it is there
+static constexpr qint64 STREAM_CHUNK_SIZE = 8 * 1024 * 1024;
+
+void InstanceImportTask::streamFromUrl()
 {
-    setStatus(tr("Extracting modpack"));
-    QDir extractDir(m_stagingPath);
-    qDebug() << "Attempting to create instance from" << m_archivePath;
+    // the archive is only ever partly there, which is nothing to keep in the cache
+    m_streamFile.reset(new QTemporaryFile(m_stagingPath + ".XXXXXX.zip"));
+    if (!m_streamFile->open()) {
+        downloadFromUrl();
+        return;
+    }
+    m_streamFile->close();
+    m_archivePath = m_streamFile->fileName();
+
+    m_tail = std::make_shared<Net::RangeSink::Received>();
+    // the jobs here are replaced from their own signals, so they have to go through deleteLater
+    m_filesNetJob = makeShared<NetJob>(tr("Modpack download"), APPLICATION->network());
+    m_filesNetJob->addNetAction(Net::ApiDownload::makeRange(m_sourceUrl, m_archivePath, -MMCZip::END_OF_DIRECTORY_SEARCH, -1, m_tail));
+    connect(m_filesNetJob.get(), &NetJob::succeeded, this, &InstanceImportTask::tailFetched);
+    connect(m_filesNetJob.get(), &NetJob::failed, this, &InstanceImportTask::stopStreaming);
+    connect(m_filesNetJob.get(), &NetJob::aborted, this, &InstanceImportTask::downloadAborted);
+    m_filesNetJob->start();
+}
 
-    // open the zip and find relevant files in it
+void InstanceImportTask::stopStreaming(const QString& reason)
+{
+    qDebug() << "Not streaming" << m_sourceUrl << "-" << reason;
+    m_packZip.reset();
+    m_streamFile.reset();
+    m_filesNetJob.reset();
+    downloadFromUrl();
+}
+
+void InstanceImportTask::tailFetched()
+{
+    m_filesNetJob.reset();
+    auto tail = *m_tail;
+    if (tail.whole || (tail.start == 0 && tail.length == tail.total)) {
+        // the server doesn't do ranges and sent all of it, or there is no more to it
+        processZipPack();
+        return;
+    }
+    if (tail.total < 0) {
+        stopStreaming("the server didn't say how big the archive is");
+        return;
+    }
+
+    QFile file(m_archivePath);
+    QByteArray bytes;
+    if (file.open(QIODevice::ReadOnly) && file.seek(tail.start))
+        bytes = file.read(tail.length);
+    qint64 offset;
+    qint64 size;
+    if (tail.start + bytes.size() != tail.total || !MMCZip::findCentralDirectory(bytes, tail.total, offset, size)) {
+        stopStreaming("the central directory wasn't found at the end of the archive");
+        return;
+    }
+    if (offset >= tail.start) {
+        directoryFetched(offset, size);
+        return;
+    }
+
+    // a directory with many entries starts before the end that was asked for
+    auto rest = std::make_shared<Net::RangeSink::Received>();
+    m_filesNetJob = makeShared<NetJob>(tr("Modpack download"), APPLICATION->network());
+    m_filesNetJob->addNetAction(Net::ApiDownload::makeRange(m_sourceUrl, m_archivePath, offset, tail.start - 1, rest));
+    connect(m_filesNetJob.get(), &NetJob::succeeded, this, [this, offset, size] {
+        m_filesNetJob.reset();
+        directoryFetched(offset, size);
+    });
+    connect(m_filesNetJob.get(), &NetJob::failed, this, &InstanceImportTask::stopStreaming);
+    connect(m_filesNetJob.get(), &NetJob::aborted, this, &InstanceImportTask::downloadAborted);
+    m_filesNetJob->start();
+}
+
+void InstanceImportTask::directoryFetched(qint64 offset, qint64 size)
+{
+    QFile file(m_archivePath);
+    QByteArray directory;
+    if (file.open(QIODevice::ReadOnly) && file.seek(offset))
+        directory = file.read(size);
+    file.close();
+    auto spans = MMCZip::readEntrySpans(directory, offset);
+
+    // QuaZip only reads the central directory when opening, which is all there is of the file so far
     m_packZip.reset(new QuaZip(m_archivePath));
-    if (!m_packZip->open(QuaZip::mdUnzip)) {
-        emitFailed(tr("Unable to open supplied modpack zip file."));
+    if (!spans || !m_packZip->open(QuaZip::mdUnzip)) {
+        stopStreaming("the central directory couldn't be read");
+        return;
+    }
+    MMCZip::EntryIndex index(m_packZip.get());
+    auto names = index.fileNames();
+    if (names.size() != spans->size()) {
+        stopStreaming("the central directory has entries QuaZip doesn't list");
         return;
     }
 
-    QuaZipDir packZipDir(m_packZip.get());
+    // telling a Flame pack's overrides apart takes its manifest, so every manifest there is comes first; they are small
+    QList<int> manifests;
+    for (int i = 0; i < names.size(); i++) {
+        if (names[i] == "manifest.json" || names[i].endsWith("/manifest.json"))
+            manifests.append(i);
+    }
+    if (manifests.isEmpty()) {
+        streamEntries(*spans, names, manifests);
+        return;
+    }
+
+    m_filesNetJob = makeShared<NetJob>(tr("Modpack download"), APPLICATION->network());
+    for (auto i : manifests) {
+        auto& span = spans->at(i);
+        m_filesNetJob->addNetAction(Net::ApiDownload::makeRange(m_sourceUrl, m_archivePath, span.begin, span.end - 1,
+                                                                std::make_shared<Net::RangeSink::Received>()));
+    }
+    connect(m_filesNetJob.get(), &NetJob::succeeded, this, [this, spans = *spans, names, manifests] {
+        m_filesNetJob.reset();
+        streamEntries(spans, names, manifests);
+    });
+    connect(m_filesNetJob.get(), &NetJob::failed, this, &InstanceImportTask::stopStreaming);
+    connect(m_filesNetJob.get(), &NetJob::aborted, this, &InstanceImportTask::downloadAborted);
+    m_filesNetJob->start();
+}
+
+void InstanceImportTask::streamEntries(const QList<MMCZip::EntrySpan>& spans, const QStringList& names, const QList<int>& fetched)
+{
+    MMCZip::EntryIndex index(m_packZip.get());
+    auto layout = detectPack(index);
+    m_packZip.reset();
+    if (!layout) {
+        emitFailed(tr("Archive does not contain a recognized modpack type."));
+        return;
+    }
+    setStatus(tr("Downloading and extracting modpack:\n%1").arg(m_sourceUrl.toString()));
+    m_streamRoot = layout->root;
+    m_streamTarget = layout->target;
+
+    // the names the entries are extracted by, which are relative to the root as extractSubDir sees them
+    QList<int> wanted;
+    QHash<int, QString> relativeNames;
+    for (int i = 0; i < names.size(); i++) {
+        if (!names[i].startsWith(m_streamRoot))
+            continue;
+        auto relative = QDir::fromNativeSeparators(names[i].mid(m_streamRoot.size()));
+        if (relative.startsWith('/'))
+            relative = relative.mid(1);
+        if (layout->filter && !layout->filter(relative))
+            continue;
+        relativeNames.insert(i, relative);
+        if (!fetched.contains(i))
+            wanted.append(i);
+    }
+    std::sort(wanted.begin(), wanted.end(), [&spans](int a, int b) { return spans[a].begin < spans[b].begin; });
+
+    QSet<QString> alreadyThere;
+    for (auto i : fetched) {
+        if (relativeNames.contains(i))
+            alreadyThere.insert(relativeNames[i]);
+    }
+    m_streamDownloading = true;
+    if (!alreadyThere.isEmpty())
+        extractChunk(alreadyThere);
+
+    // entries that follow each other in the archive are fetched together, up to a chunk at a time
+    m_filesNetJob = makeShared<NetJob>(tr("Modpack download"), APPLICATION->network());
+    for (int first = 0; first < wanted.size();) {
+        auto begin = spans[wanted[first]].begin;
+        auto end = spans[wanted[first]].end;
+        QSet<QString> chunk{ relativeNames[wanted[first]] };
+        int next = first + 1;
+        for (; next < wanted.size() && spans[wanted[next]].begin == end && spans[wanted[next]].end - begin <= STREAM_CHUNK_SIZE; next++) {
+            end = spans[wanted[next]].end;
+            chunk.insert(relativeNames[wanted[next]]);
+        }
+        first = next;
+
+        auto received = std::make_shared<Net::RangeSink::Received>();
+        auto dl = Net::ApiDownload::makeRange(m_sourceUrl, m_archivePath, begin, end - 1, received);
+        connect(dl.get(), &Task::succeeded, this, [this, chunk, received, begin, end] {
+            if (!received->whole && (received->start > begin || received->start + received->length < end)) {
+                m_streamError = tr("The server sent a different part of the modpack than was asked for.");
+                m_filesNetJob->abort();
+                return;
+            }
+            extractChunk(chunk);
+        });
+        m_filesNetJob->addNetAction(dl);
+    }
+
+    auto downloaded = [this](const QString& error) {
+        if (!isRunning())
+            return;
+        m_streamDownloading = false;
+        if (m_streamError.isEmpty())
+            m_streamError = error;
+        chunkExtracted();
+    };
+    connect(m_filesNetJob.get(), &NetJob::succeeded, this, [downloaded] { downloaded({}); });
+    connect(m_filesNetJob.get(), &NetJob::failed, this, downloaded);
+    connect(m_filesNetJob.get(), &NetJob::aborted, this, [downloaded] { downloaded(tr("Aborted")); });
+    connect(m_filesNetJob.get(), &NetJob::progress, this, &InstanceImportTask::downloadProgressChanged);
+    connect(m_filesNetJob.get(), &NetJob::stepProgress, this, &InstanceImportTask::propagateStepProgress);
+    m_filesNetJob->start();
+}
+
+void InstanceImportTask::extractChunk(const QSet<QString>& relativeNames)
+{
+    m_chunksExtracting++;
+    auto& watcher = m_chunkWatchers.emplace_back(std::make_unique<QFutureWatcher<std::optional<QStringList>>>());
+    connect(watcher.get(), &QFutureWatcher<std::optional<QStringList>>::finished, this, [this, watcher = watcher.get()] {
+        m_chunksExtracting--;
+        if (!watcher->result().has_value() && m_streamError.isEmpty()) {
+            m_streamError = tr("Failed to extract modpack");
+            if (m_filesNetJob)
+                m_filesNetJob->abort();
+        }
+        chunkExtracted();
+    });
+    // every chunk has its own handle on the archive, so they are extracted alongside each other and the downloads
+    watcher->setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [archive = m_archivePath, root = m_streamRoot,
+                                                                         target = m_streamTarget, relativeNames] {
+        QuaZip zip(archive);
+        if (!zip.open(QuaZip::mdUnzip))
+            return std::optional<QStringList>();
+        return MMCZip::extractSubDir(&zip, root, target, [&relativeNames](const QString& name) { return relativeNames.contains(name); });
+    }));
+}
+
+void InstanceImportTask::chunkExtracted()
+{
+    if (!isRunning() || m_streamDownloading || m_chunksExtracting > 0)
+        return;
+
+    m_filesNetJob.reset();
+    m_streamFile.reset();
+    if (!m_streamError.isEmpty()) {
+        emitFailed(m_streamError);
+        return;
+    }
+    processExtracted();
+}
+
+/* Only the manifest and the overrides of a Flame pack are used, the manifest names the overrides folder. */
+static MMCZip::FilterFunction flameFilter(MMCZip::EntryIndex& index, const QString& root)
+{
+    QuaZipFile manifestFile(index.zip());
+    if (!index.setCurrentFile(root + "manifest.json") || !manifestFile.open(QIODevice::ReadOnly))
+        return nullptr;
+    auto manifest = QJsonDocument::fromJson(manifestFile.readAll());
+    if (!manifest.isObject())
+        return nullptr;
+    // the same default as Flame::loadManifest
+    auto overrides = manifest.object().value("overrides").toString("overrides") + '/';
+    return [overrides](const QString& name) { return name == "manifest.json" || name.startsWith(overrides); };
+}
+
+std::optional<InstanceImportTask::PackLayout> InstanceImportTask::detectPack(MMCZip::EntryIndex& index)
+{
+    PackLayout layout;
+    QDir extractDir(m_stagingPath);
 
     // https://docs.modrinth.com/docs/modpacks/format_definition/#storage
-    bool modrinthFound = packZipDir.exists("/modrinth.index.json");
-    bool technicFound = packZipDir.exists("/bin/modpack.jar") || packZipDir.exists("/bin/version.json");
-    QString root;
+    bool modrinthFound = index.contains("modrinth.index.json");
+    bool technicFound = index.contains("bin/modpack.jar") || index.contains("bin/version.json");
 
     // NOTE: Prioritize modpack platforms that aren't searched for recursively.
     // Especially Flame has a very common filename for its manifest, which may appear inside overrides for example
@@ -161,6 +409,9 @@ void InstanceImportTask::processZipPack()
         // process as Modrinth pack
         qDebug() << "Modrinth:" << modrinthFound;
         m_modpackType = ModpackType::Modrinth;
+        layout.filter = [](const QString& name) {
+            return name == "modrinth.index.json" || name.startsWith("overrides/") || name.startsWith("client-overrides/");
+        };
     } else if (technicFound) {
         // process as Technic pack
         qDebug() << "Technic:" << technicFound;
@@ -170,27 +421,50 @@ void InstanceImportTask::processZipPack()
     } else {
         QStringList paths_to_ignore{ "overrides/" };
 
-        if (QString mmcRoot = MMCZip::findFolderOfFileInZip(m_packZip.get(), "instance.cfg", paths_to_ignore); !mmcRoot.isNull()) {
+        if (auto mmcRoot = index.findFolderOf("instance.cfg", paths_to_ignore)) {
             // process as MultiMC instance/pack
-            qDebug() << "MultiMC:" << mmcRoot;
-            root = mmcRoot;
+            qDebug() << "MultiMC:" << *mmcRoot;
+            layout.root = *mmcRoot;
             m_modpackType = ModpackType::MultiMC;
-        } else if (QString flameRoot = MMCZip::findFolderOfFileInZip(m_packZip.get(), "manifest.json", paths_to_ignore);
-                   !flameRoot.isNull()) {
+        } else if (auto flameRoot = index.findFolderOf("manifest.json", paths_to_ignore)) {
             // process as Flame pack
-            qDebug() << "Flame:" << flameRoot;
-            root = flameRoot;
+            qDebug() << "Flame:" << *flameRoot;
+            layout.root = *flameRoot;
             m_modpackType = ModpackType::Flame;
+            layout.filter = flameFilter(index, layout.root);
         }
     }
-    if (m_modpackType == ModpackType::Unknown) {
+    if (m_modpackType == ModpackType::Unknown)
+        return std::nullopt;
+
+    layout.target = extractDir.absolutePath();
+    return layout;
+}
+
+void InstanceImportTask::processZipPack()
+{
+    setStatus(tr("Extracting modpack"));
+    qDebug() << "Attempting to create instance from" << m_archivePath;
+
+    // open the zip and find relevant files in it
+    m_packZip.reset(new QuaZip(m_archivePath));
+    if (!m_packZip->open(QuaZip::mdUnzip)) {
+        emitFailed(tr("Unable to open supplied modpack zip file."));
+        return;
+    }
+
+    // everything needed to tell the pack type is in the central directory, which is read once
+    MMCZip::EntryIndex index(m_packZip.get());
+    auto layout = detectPack(index);
+    if (!layout) {
         emitFailed(tr("Archive does not contain a recognized modpack type."));
         return;
     }
 
     // make sure we extract just the pack
     m_extractFuture =
-        QtConcurrent::run(QThreadPool::globalInstance(), MMCZip::extractSubDir, m_packZip.get(), root, extractDir.absolutePath());
+        QtConcurrent::run(QThreadPool::globalInstance(), [zip = m_packZip.get(), root = layout->root, target = layout->target,
+                                                          filter = layout->filter] { return MMCZip::extractSubDir(zip, root, target, filter); });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &InstanceImportTask::extractFinished);
     m_extractFutureWatcher.setFuture(m_extractFuture);
 }
@@ -206,6 +480,11 @@ void InstanceImportTask::extractFinished()
         return;
     }
 
+    processExtracted();
+}
+
+void InstanceImportTask::processExtracted()
+{
     QDir extractDir(m_stagingPath);
 
     qDebug() << "Fixing permissions for extracted pack files...";
@@ -37,16 +37,25 @@
 
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QTemporaryFile>
 #include <QUrl>
 #include "InstanceTask.h"
 #include "QObjectPtr.h"
 #include "modplatform/flame/PackManifest.h"
 #include "net/NetJob.h"
+#include "net/RangeSink.h"
 #include "settings/SettingsObject.h"
 
+#include <functional>
+#include <memory>
 #include <optional>
+#include <vector>
 
 class QuaZip;
+namespace MMCZip {
+class EntryIndex;
+struct EntrySpan;
+}  // namespace MMCZip
 
 class InstanceImportTask : public InstanceTask {
     Q_OBJECT
@@ -61,7 +70,17 @@ class InstanceImportTask : public InstanceTask {
     virtual void executeTask() override;
 
    private:
+    /* Which entries of the archive make up the pack, and where they go. */
+    struct PackLayout {
+        QString root;
+        QString target;
+        // entries the instance doesn't use are left in the archive instead of being extracted to be thrown away later
+        std::function<bool(const QString&)> filter;
+    };
+    std::optional<PackLayout> detectPack(MMCZip::EntryIndex& index);
+
     void processZipPack();
+    void processExtracted();
     void processMultiMC();
     void processTechnic();
     void processFlame();
@@ -98,4 +117,24 @@ class InstanceImportTask : public InstanceTask {
     // FIXME: nuke
     QWidget* m_parent;
     void downloadFromUrl();
+
+    // Streaming imports fetch the central directory of the archive with a range request first, then the entries the
+    // pack is made of in ranges of a few of them, each extracted as soon as it is there.
+    void streamFromUrl();
+    void tailFetched();
+    void directoryFetched(qint64 offset, qint64 size);
+    void streamEntries(const QList<MMCZip::EntrySpan>& spans, const QStringList& names, const QList<int>& fetched);
+    void extractChunk(const QSet<QString>& relativeNames);
+    void chunkExtracted();
+    /* Goes on with the whole archive, for servers that don't do ranges and archives that can't be read from their end. */
+    void stopStreaming(const QString& reason);
+
+    std::unique_ptr<QTemporaryFile> m_streamFile;
+    std::shared_ptr<Net::RangeSink::Received> m_tail;
+    QString m_streamRoot;
+    QString m_streamTarget;
+    bool m_streamDownloading = false;
+    QString m_streamError;
+    std::vector<std::unique_ptr<QFutureWatcher<std::optional<QStringList>>>> m_chunkWatchers;
+    int m_chunksExtracting = 0;
 };
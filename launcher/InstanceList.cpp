@@ -34,6 +34,7 @@
  *      limitations under the License.
  */
 
+#include <QDataStream>
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
@@ -44,6 +45,7 @@
 #include <QJsonDocument>
 #include <QMimeData>
 #include <QPair>
+#include <QSaveFile>
 #include <QSet>
 #include <QStack>
 #include <QTextStream>
@@ -51,16 +53,19 @@
 #include <QTimer>
 #include <QUuid>
 #include <QXmlStreamReader>
+#include <QtConcurrentMap>
 
 #include "BaseInstance.h"
 #include "ExponentialSeries.h"
 #include "FileSystem.h"
+#include "InstanceDeleteTask.h"
 #include "InstanceList.h"
 #include "InstanceTask.h"
 #include "NullInstance.h"
 #include "WatchLock.h"
 #include "minecraft/MinecraftInstance.h"
 #include "settings/INISettingsObject.h"
+#include "settings/Setting.h"
 
 #ifdef Q_OS_WIN32
 #include <Windows.h>
@@ -68,6 +73,9 @@
 
 const static int GROUP_FILE_FORMAT_VERSION = 1;
 
+constexpr quint32 CONFIG_SNAPSHOT_MAGIC = 0x504C4953;  // "PLIS"
+constexpr quint32 CONFIG_SNAPSHOT_VERSION = 1;
+
 InstanceList::InstanceList(SettingsObjectPtr settings, const QString& instDir, QObject* parent)
     : QAbstractListModel(parent), m_globalSettings(settings)
 {
@@ -81,6 +89,7 @@ InstanceList::InstanceList(SettingsObjectPtr settings, const QString& instDir, Q
 
     // NOTE: canonicalPath requires the path to exist. Do not move this above the creation block!
     m_instDir = QDir(instDir).canonicalPath();
+    m_snapshotFile = QDir("cache").absoluteFilePath("instancecfgs.dat");
     m_watcher = new QFileSystemWatcher(this);
     connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &InstanceList::instanceDirContentsChanged);
     m_watcher->addPath(m_instDir);
@@ -141,12 +150,8 @@ QMimeData* InstanceList::mimeData(const QModelIndexList& indexes) const
 
 QStringList InstanceList::getLinkedInstancesById(const QString& id) const
 {
-    QStringList linkedInstances;
-    for (auto inst : m_instances) {
-        if (inst->isLinkedToInstanceId(id))
-            linkedInstances.append(inst->id());
-    }
-    return linkedInstances;
+    updateSettingIndexes();
+    return m_linkingInstances.value(id);
 }
 
 int InstanceList::rowCount(const QModelIndex& parent) const
@@ -254,7 +259,7 @@ void InstanceList::setInstanceGroup(const InstanceId& id, GroupId name)
     auto iter = m_instanceGroupIndex.find(inst->id());
     if (iter != m_instanceGroupIndex.end()) {
         if (*iter != name) {
-            decreaseGroupCount(*iter);
+            removeFromGroup(id, *iter);
             *iter = name;
             changed = true;
         }
@@ -264,7 +269,7 @@ void InstanceList::setInstanceGroup(const InstanceId& id, GroupId name)
     }
 
     if (changed) {
-        increaseGroupCount(name);
+        addToGroup(id, name);
         auto idx = getInstIndex(inst.get());
         emit dataChanged(index(idx), index(idx), { GroupRole });
         saveGroupList();
@@ -273,27 +278,26 @@ void InstanceList::setInstanceGroup(const InstanceId& id, GroupId name)
 
 QStringList InstanceList::getGroups()
 {
-    return m_groupNameCache.keys();
+    return m_groupMembers.keys();
 }
 
 void InstanceList::deleteGroup(const GroupId& name)
 {
-    m_groupNameCache.remove(name);
+    auto members = m_groupMembers.take(name);
     m_collapsedGroups.remove(name);
 
     bool removed = false;
     qDebug() << "Delete group" << name;
-    for (auto& instance : m_instances) {
-        const QString& instID = instance->id();
-        const QString instGroupName = getInstanceGroup(instID);
-        if (instGroupName == name) {
-            m_instanceGroupIndex.remove(instID);
-            qDebug() << "Remove" << instID << "from group" << name;
-            removed = true;
-            auto idx = getInstIndex(instance.get());
-            if (idx >= 0)
-                emit dataChanged(index(idx), index(idx), { GroupRole });
-        }
+    for (auto& instID : members) {
+        auto iter = m_instanceGroupIndex.find(instID);
+        if (iter == m_instanceGroupIndex.end() || *iter != name)
+            continue;
+        m_instanceGroupIndex.erase(iter);
+        qDebug() << "Remove" << instID << "from group" << name;
+        removed = true;
+        auto idx = m_rowById.value(instID, -1);
+        if (idx >= 0)
+            emit dataChanged(index(idx), index(idx), { GroupRole });
     }
     if (removed)
         saveGroupList();
@@ -301,24 +305,23 @@ void InstanceList::deleteGroup(const GroupId& name)
 
 void InstanceList::renameGroup(const QString& src, const QString& dst)
 {
-    m_groupNameCache.remove(src);
+    auto members = m_groupMembers.take(src);
     if (m_collapsedGroups.remove(src))
         m_collapsedGroups.insert(dst);
 
     bool modified = false;
     qDebug() << "Rename group" << src << "to" << dst;
-    for (auto& instance : m_instances) {
-        const QString& instID = instance->id();
-        const QString instGroupName = getInstanceGroup(instID);
-        if (instGroupName == src) {
-            m_instanceGroupIndex[instID] = dst;
-            increaseGroupCount(dst);
-            qDebug() << "Set" << instID << "group to" << dst;
-            modified = true;
-            auto idx = getInstIndex(instance.get());
-            if (idx >= 0)
-                emit dataChanged(index(idx), index(idx), { GroupRole });
-        }
+    for (auto& instID : members) {
+        auto iter = m_instanceGroupIndex.find(instID);
+        if (iter == m_instanceGroupIndex.end() || *iter != src)
+            continue;
+        *iter = dst;
+        addToGroup(instID, dst);
+        qDebug() << "Set" << instID << "group to" << dst;
+        modified = true;
+        auto idx = m_rowById.value(instID, -1);
+        if (idx >= 0)
+            emit dataChanged(index(idx), index(idx), { GroupRole });
     }
     if (modified)
         saveGroupList();
@@ -337,13 +340,13 @@ bool InstanceList::trashInstance(const InstanceId& id)
         return false;
     }
 
-    QString cachedGroupId = m_instanceGroupIndex[id];
+    QString cachedGroupId = m_instanceGroupIndex.value(id);
 
     qDebug() << "Will trash instance" << id;
     QString trashedLoc;
 
     if (m_instanceGroupIndex.remove(id)) {
-        decreaseGroupCount(cachedGroupId);
+        removeFromGroup(id, cachedGroupId);
         saveGroupList();
     }
 
@@ -381,34 +384,60 @@ void InstanceList::undoTrashInstance()
     QFile(top.trashPath).rename(top.polyPath);
 
     m_instanceGroupIndex[top.id] = top.groupName;
-    increaseGroupCount(top.groupName);
+    addToGroup(top.id, top.groupName);
 
     saveGroupList();
     emit instancesChanged();
 }
 
-void InstanceList::deleteInstance(const InstanceId& id)
+Task::Ptr InstanceList::deleteInstance(const InstanceId& id)
 {
     auto inst = getInstanceById(id);
     if (!inst) {
         qDebug() << "Cannot delete instance" << id << ". No such instance is present (deleted externally?).";
-        return;
+        return nullptr;
     }
 
-    QString cachedGroupId = m_instanceGroupIndex[id];
+    QString cachedGroupId = m_instanceGroupIndex.value(id);
 
     if (m_instanceGroupIndex.remove(id)) {
-        decreaseGroupCount(cachedGroupId);
+        removeFromGroup(id, cachedGroupId);
         saveGroupList();
     }
 
     qDebug() << "Will delete instance" << id;
-    if (!FS::deletePath(inst->instanceRoot())) {
-        qWarning() << "Deletion of instance" << id << "has not been completely successful ...";
-        return;
+
+    // moving it out of the instances folder takes it off the list right away, the files can take their time
+    auto path = inst->instanceRoot();
+    auto staged = getStagedInstancePath();
+    if (!staged.isEmpty()) {
+        auto moved = FS::PathCombine(staged, id);
+        if (QDir().rename(path, moved)) {
+            path = staged;
+            emit instancesChanged();
+        } else {
+            qWarning() << "Couldn't move instance" << id << "out of the way, deleting it where it is";
+            QDir().rmdir(staged);
+        }
     }
 
-    qDebug() << "Instance" << id << "has been deleted by the launcher.";
+    // the class data archives are only good for this instance
+    auto task = makeShared<InstanceDeleteTask>(QStringList{ path, FS::PathCombine("cache", "cds", id) });
+    connect(task.get(), &Task::succeeded, this, [id] { qDebug() << "Instance" << id << "has been deleted by the launcher."; });
+    connect(task.get(), &Task::failed, this,
+            [id] { qWarning() << "Deletion of instance" << id << "has not been completely successful ..."; });
+    // keep it around until it's done
+    m_deletions.append(task);
+    connect(task.get(), &Task::finished, this, [this, raw = task.get()] {
+        for (auto it = m_deletions.begin(); it != m_deletions.end(); ++it) {
+            if (it->get() == raw) {
+                m_deletions.erase(it);
+                break;
+            }
+        }
+    });
+    task->start();
+    return task;
 }
 
 static QMap<InstanceId, InstanceLocator> getIdMapping(const QList<InstancePtr>& list)
@@ -426,29 +455,45 @@ static QMap<InstanceId, InstanceLocator> getIdMapping(const QList<InstancePtr>&
     return out;
 }
 
-QList<InstanceId> InstanceList::discoverInstances()
+QList<InstanceId> InstanceList::discoverInstanceIds(const QString& instDir, int* statCount)
 {
-    qDebug() << "Discovering instances in" << m_instDir;
     QList<InstanceId> out;
-    QDirIterator iter(m_instDir, QDir::Dirs | QDir::NoDot | QDir::NoDotDot | QDir::Readable | QDir::Hidden, QDirIterator::FollowSymlinks);
+    int stats = 0;
+    // only needed when there are symlinks, but then it's needed for all of them
+    QString canonicalInstDir;
+
+    // the directory read gives us names and types, so the only thing left to look at is each instance.cfg
+    QDirIterator iter(instDir, QDir::Dirs | QDir::NoDot | QDir::NoDotDot | QDir::Readable | QDir::Hidden, QDirIterator::FollowSymlinks);
     while (iter.hasNext()) {
         QString subDir = iter.next();
-        QFileInfo dirInfo(subDir);
-        if (!QFileInfo(FS::PathCombine(subDir, "instance.cfg")).exists())
+        stats++;
+        if (!QFileInfo::exists(FS::PathCombine(subDir, "instance.cfg")))
             continue;
         // if it is a symlink, ignore it if it goes to the instance folder
+        auto dirInfo = iter.fileInfo();
         if (dirInfo.isSymLink()) {
-            QFileInfo targetInfo(dirInfo.symLinkTarget());
-            QFileInfo instDirInfo(m_instDir);
-            if (targetInfo.canonicalPath() == instDirInfo.canonicalFilePath()) {
+            if (canonicalInstDir.isNull()) {
+                canonicalInstDir = QFileInfo(instDir).canonicalFilePath();
+                stats++;
+            }
+            stats++;
+            if (QFileInfo(dirInfo.symLinkTarget()).canonicalPath() == canonicalInstDir) {
                 qDebug() << "Ignoring symlink" << subDir << "that leads into the instances folder";
                 continue;
             }
         }
-        auto id = dirInfo.fileName();
-        out.append(id);
-        qDebug() << "Found instance ID" << id;
+        out.append(dirInfo.fileName());
     }
+    if (statCount)
+        *statCount = stats;
+    return out;
+}
+
+QList<InstanceId> InstanceList::discoverInstances()
+{
+    qDebug() << "Discovering instances in" << m_instDir;
+    auto out = discoverInstanceIds(m_instDir);
+    qDebug() << "Found" << out.size() << "instances";
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
     instanceSet = QSet<QString>(out.begin(), out.end());
 #else
@@ -464,18 +509,60 @@ InstanceList::InstListError InstanceList::loadList()
 
     QList<InstancePtr> newList;
 
+    QList<InstanceId> newIds;
     for (auto& id : discoverInstances()) {
         if (existingIds.contains(id)) {
             auto instPair = existingIds[id];
             existingIds.remove(id);
             qDebug() << "Should keep and soft-reload" << id;
         } else {
-            InstancePtr instPtr = loadInstance(id);
-            if (instPtr) {
-                newList.append(instPtr);
+            newIds.append(id);
+        }
+    }
+
+    if (!m_snapshotsLoaded) {
+        loadConfigSnapshot();
+    }
+
+    // reading the instance configs is what takes time, especially on slow or network drives, so read them all at once.
+    // the ones that didn't change since they were last read only need a stat to be sure of that.
+    auto configs = QtConcurrent::blockingMapped<QList<ConfigSnapshot>>(
+        newIds, [instDir = m_instDir, snapshots = m_configSnapshots](const InstanceId& id) {
+            auto path = FS::PathCombine(instDir, id, "instance.cfg");
+            ConfigSnapshot read;
+            read.identity = Hashing::FileIdentity::of(path);
+            auto known = snapshots.constFind(id);
+            if (read.identity.isValid() && known != snapshots.constEnd() && known->identity == read.identity) {
+                return *known;
             }
+            read.config.loadFile(path);
+            return read;
+        });
+    bool snapshotsChanged = false;
+    for (int i = 0; i < newIds.size(); i++) {
+        auto& id = newIds.at(i);
+        auto& read = configs.at(i);
+        auto known = m_configSnapshots.constFind(id);
+        if (known == m_configSnapshots.constEnd() || known->identity != read.identity) {
+            m_configSnapshots.insert(id, read);
+            snapshotsChanged = true;
+        }
+        InstancePtr instPtr = loadInstance(id, read.config);
+        if (instPtr) {
+            newList.append(instPtr);
         }
     }
+    for (auto it = m_configSnapshots.begin(); it != m_configSnapshots.end();) {
+        if (!instanceSet.contains(it.key())) {
+            it = m_configSnapshots.erase(it);
+            snapshotsChanged = true;
+        } else {
+            it++;
+        }
+    }
+    if (snapshotsChanged) {
+        saveConfigSnapshot();
+    }
 
     // TODO: looks like a general algorithm with a few specifics inserted. Do something about it.
     if (!existingIds.isEmpty()) {
@@ -490,6 +577,7 @@ InstanceList::InstListError InstanceList::loadList()
         auto removeNow = [&]() {
             beginRemoveRows(QModelIndex(), front_bookmark, back_bookmark);
             m_instances.erase(m_instances.begin() + front_bookmark, m_instances.begin() + back_bookmark + 1);
+            reindexRows();
             endRemoveRows();
             front_bookmark = -1;
             back_bookmark = currentItem;
@@ -521,11 +609,90 @@ InstanceList::InstListError InstanceList::loadList()
     return NoError;
 }
 
+void InstanceList::loadConfigSnapshot()
+{
+    m_snapshotsLoaded = true;
+    m_configSnapshots.clear();
+
+    QFile file(m_snapshotFile);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic, version, count;
+    QString instDir;
+    in >> magic >> version >> instDir >> count;
+    if (in.status() != QDataStream::Ok || magic != CONFIG_SNAPSHOT_MAGIC || version != CONFIG_SNAPSHOT_VERSION) {
+        qWarning() << "Ignoring instance config snapshot with unknown format:" << m_snapshotFile;
+        return;
+    }
+    // it's of another instance folder
+    if (instDir != m_instDir)
+        return;
+
+    QHash<InstanceId, ConfigSnapshot> snapshots;
+    for (quint32 i = 0; i < count; i++) {
+        InstanceId id;
+        ConfigSnapshot snapshot;
+        QMap<QString, QVariant> config;
+        in >> id >> snapshot.identity.size >> snapshot.identity.mtime >> snapshot.identity.inode >> config;
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "Instance config snapshot is corrupted, starting over:" << m_snapshotFile;
+            return;
+        }
+        for (auto it = config.constBegin(); it != config.constEnd(); it++) {
+            snapshot.config.insert(it.key(), it.value());
+        }
+        snapshots.insert(id, snapshot);
+    }
+    m_configSnapshots = snapshots;
+}
+
+void InstanceList::saveConfigSnapshot()
+{
+    QDir().mkpath(QFileInfo(m_snapshotFile).absolutePath());
+
+    QSaveFile file(m_snapshotFile);
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << "Failed to save instance config snapshot:" << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+
+    out << CONFIG_SNAPSHOT_MAGIC << CONFIG_SNAPSHOT_VERSION << m_instDir << static_cast<quint32>(m_configSnapshots.size());
+    for (auto it = m_configSnapshots.constBegin(); it != m_configSnapshots.constEnd(); it++) {
+        const auto& snapshot = it.value();
+        out << it.key() << snapshot.identity.size << snapshot.identity.mtime << snapshot.identity.inode
+            << static_cast<const QMap<QString, QVariant>&>(snapshot.config);
+    }
+
+    if (!file.commit())
+        qWarning() << "Failed to save instance config snapshot:" << file.errorString();
+}
+
+namespace {
+// without the current session, if it's running
+qint64 recordedPlayTime(BaseInstance* inst)
+{
+    return inst->settings()->get("totalTimePlayed").toLongLong();
+}
+}  // namespace
+
 void InstanceList::updateTotalPlayTime()
 {
     totalPlayTime = 0;
+    m_playTimes.clear();
+    m_runningIds.clear();
     for (auto const& itr : m_instances) {
-        totalPlayTime += itr.get()->totalTimePlayed();
+        auto time = recordedPlayTime(itr.get());
+        totalPlayTime += time;
+        m_playTimes.insert(itr->id(), time);
+        if (itr->isRunning())
+            m_runningIds.insert(itr->id());
     }
 }
 
@@ -539,13 +706,56 @@ void InstanceList::saveNow()
 void InstanceList::add(const QList<InstancePtr>& t)
 {
     beginInsertRows(QModelIndex(), m_instances.count(), m_instances.count() + t.size() - 1);
-    m_instances.append(t);
     for (auto& ptr : t) {
+        m_rowById.insert(ptr->id(), m_instances.count());
+        m_instances.append(ptr);
         connect(ptr.get(), &BaseInstance::propertiesChanged, this, &InstanceList::propertiesChanged);
+        connect(ptr.get(), &BaseInstance::runningStatusChanged, this, [this, id = ptr->id()](bool running) {
+            if (running)
+                m_runningIds.insert(id);
+            else
+                m_runningIds.remove(id);
+        });
+        connect(ptr->settings().get(), &SettingsObject::SettingChanged, this, [this](const Setting& setting, QVariant) {
+            if (setting.id() == "ManagedPackName" || setting.id() == "linkedInstances")
+                m_settingIndexesDirty = true;
+        });
     }
+    m_settingIndexesDirty = true;
     endInsertRows();
 }
 
+void InstanceList::reindexRows()
+{
+    m_rowById.clear();
+    for (int i = 0; i < m_instances.count(); i++) {
+        m_rowById.insert(m_instances.at(i)->id(), i);
+    }
+    m_settingIndexesDirty = true;
+}
+
+void InstanceList::updateSettingIndexes() const
+{
+    if (!m_settingIndexesDirty)
+        return;
+    m_settingIndexesDirty = false;
+
+    m_instanceByManagedName.clear();
+    m_linkingInstances.clear();
+    for (auto& instance : m_instances) {
+        auto managedName = instance->getManagedPackName();
+        // the first one wins, like it did when looking through the list
+        if (!managedName.isEmpty() && !m_instanceByManagedName.contains(managedName))
+            m_instanceByManagedName.insert(managedName, instance);
+
+        for (auto& linkedId : instance->getLinkedInstances()) {
+            auto& linking = m_linkingInstances[linkedId];
+            if (linking.isEmpty() || linking.last() != instance->id())
+                linking.append(instance->id());
+        }
+    }
+}
+
 void InstanceList::resumeWatch()
 {
     if (m_watchLevel > 0) {
@@ -575,12 +785,10 @@ InstancePtr InstanceList::getInstanceById(QString instId) const
 {
     if (instId.isEmpty())
         return InstancePtr();
-    for (auto& inst : m_instances) {
-        if (inst->id() == instId) {
-            return inst;
-        }
-    }
-    return InstancePtr();
+    auto row = m_rowById.value(instId, -1);
+    if (row < 0)
+        return InstancePtr();
+    return m_instances.at(row);
 }
 
 InstancePtr InstanceList::getInstanceByManagedName(const QString& managed_name) const
@@ -588,12 +796,8 @@ InstancePtr InstanceList::getInstanceByManagedName(const QString& managed_name)
     if (managed_name.isEmpty())
         return {};
 
-    for (auto instance : m_instances) {
-        if (instance->getManagedPackName() == managed_name)
-            return instance;
-    }
-
-    return {};
+    updateSettingIndexes();
+    return m_instanceByManagedName.value(managed_name);
 }
 
 QModelIndex InstanceList::getInstanceIndexById(const QString& id) const
@@ -603,13 +807,12 @@ QModelIndex InstanceList::getInstanceIndexById(const QString& id) const
 
 int InstanceList::getInstIndex(BaseInstance* inst) const
 {
-    int count = m_instances.count();
-    for (int i = 0; i < count; i++) {
-        if (inst == m_instances[i].get()) {
-            return i;
-        }
-    }
-    return -1;
+    if (!inst)
+        return -1;
+    auto row = m_rowById.constFind(inst->id());
+    if (row == m_rowById.cend() || m_instances.at(*row).get() != inst)
+        return -1;
+    return *row;
 }
 
 void InstanceList::propertiesChanged(BaseInstance* inst)
@@ -617,18 +820,23 @@ void InstanceList::propertiesChanged(BaseInstance* inst)
     int i = getInstIndex(inst);
     if (i != -1) {
         emit dataChanged(index(i), index(i));
-        updateTotalPlayTime();
+        // only this instance's time could have changed
+        auto time = recordedPlayTime(inst);
+        auto& previous = m_playTimes[inst->id()];
+        totalPlayTime += time - previous;
+        previous = time;
     }
 }
 
-InstancePtr InstanceList::loadInstance(const InstanceId& id)
+InstancePtr InstanceList::loadInstance(const InstanceId& id, const INIFile& config)
 {
     if (!m_groupsLoaded) {
         loadGroupList();
     }
 
     auto instanceRoot = FS::PathCombine(m_instDir, id);
-    auto instanceSettings = std::make_shared<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"));
+    auto instanceSettings = std::make_shared<INISettingsObject>(FS::PathCombine(instanceRoot, "instance.cfg"), config);
+    instanceSettings->setWriteBehind(true);
     InstancePtr inst;
 
     instanceSettings->registerSetting("InstanceType", "");
@@ -646,21 +854,25 @@ InstancePtr InstanceList::loadInstance(const InstanceId& id)
     return inst;
 }
 
-void InstanceList::increaseGroupCount(const QString& group)
+void InstanceList::addToGroup(const InstanceId& id, const GroupId& group)
 {
     if (group.isEmpty())
         return;
 
-    ++m_groupNameCache[group];
+    m_groupMembers[group].insert(id);
 }
 
-void InstanceList::decreaseGroupCount(const QString& group)
+void InstanceList::removeFromGroup(const InstanceId& id, const GroupId& group)
 {
     if (group.isEmpty())
         return;
 
-    if (--m_groupNameCache[group] < 1) {
-        m_groupNameCache.remove(group);
+    auto members = m_groupMembers.find(group);
+    if (members == m_groupMembers.end())
+        return;
+    members->remove(id);
+    if (members->isEmpty()) {
+        m_groupMembers.erase(members);
         m_collapsedGroups.remove(group);
     }
 }
@@ -767,7 +979,7 @@ void InstanceList::loadGroupList()
     }
 
     m_instanceGroupIndex.clear();
-    m_groupNameCache.clear();
+    m_groupMembers.clear();
 
     // Iterate through all the groups.
     QJsonObject groupMapping = rootObj.value("groups").toObject();
@@ -802,7 +1014,7 @@ void InstanceList::loadGroupList()
 
         for (auto value : instancesArray) {
             m_instanceGroupIndex[value.toString()] = groupName;
-            increaseGroupCount(groupName);
+            addToGroup(value.toString(), groupName);
         }
     }
     m_groupsLoaded = true;
@@ -824,8 +1036,10 @@ void InstanceList::on_InstFolderChanged([[maybe_unused]] const Setting& setting,
         }
         m_instDir = newInstDir;
         m_groupsLoaded = false;
+        m_snapshotsLoaded = false;
         beginRemoveRows(QModelIndex(), 0, count());
         m_instances.erase(m_instances.begin(), m_instances.end());
+        reindexRows();
         endRemoveRows();
         emit instancesChanged();
     }
@@ -1002,7 +1216,7 @@ bool InstanceList::commitStagedInstance(const QString& path,
             }
 
             m_instanceGroupIndex[instID] = groupName;
-            increaseGroupCount(groupName);
+            addToGroup(instID, groupName);
         }
 
         instanceSet.insert(instID);
@@ -1022,8 +1236,12 @@ bool InstanceList::destroyStagingPath(const QString& keyPath)
 
 int InstanceList::getTotalPlayTime()
 {
-    updateTotalPlayTime();
-    return totalPlayTime;
+    auto total = totalPlayTime;
+    for (auto& id : m_runningIds) {
+        if (auto inst = getInstanceById(id))
+            total += inst->lastTimePlayed();
+    }
+    return static_cast<int>(total);
 }
 
 #include "InstanceList.moc"
@@ -36,6 +36,7 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QPair>
@@ -43,6 +44,9 @@
 #include <QStack>
 
 #include "BaseInstance.h"
+#include "modplatform/helpers/HashCache.h"
+#include "settings/INIFile.h"
+#include "tasks/Task.h"
 
 class QFileSystemWatcher;
 class InstanceTask;
@@ -95,11 +99,14 @@ class InstanceList : public QAbstractListModel {
     int count() const { return m_instances.count(); }
 
     InstListError loadList();
+
+    /* The IDs of the instances in the given folder, with a single stat for each of its subfolders that isn't a symlink.
+     * If given, statCount is set to the number of stats this took beyond reading the folder. */
+    static QList<InstanceId> discoverInstanceIds(const QString& instDir, int* statCount = nullptr);
+
     void saveNow();
 
-    /* O(n) */
     InstancePtr getInstanceById(QString id) const;
-    /* O(n) */
     InstancePtr getInstanceByManagedName(const QString& managed_name) const;
     QModelIndex getInstanceIndexById(const QString& id) const;
     QStringList getGroups();
@@ -113,7 +120,8 @@ class InstanceList : public QAbstractListModel {
     bool trashInstance(const InstanceId& id);
     bool trashedSomething();
     void undoTrashInstance();
-    void deleteInstance(const InstanceId& id);
+    /* Takes the instance off the list right away, and deletes its files in the background with the returned task. */
+    Task::Ptr deleteInstance(const InstanceId& id);
 
     // Wrap an instance creation task in some more task machinery and make it ready to be used
     Task* wrapInstanceTask(InstanceTask* task);
@@ -170,6 +178,7 @@ class InstanceList : public QAbstractListModel {
 
    private:
     int getInstIndex(BaseInstance* inst) const;
+    /* Sums up the play time of all the instances again, after the list was loaded */
     void updateTotalPlayTime();
     void suspendWatch();
     void resumeWatch();
@@ -177,28 +186,61 @@ class InstanceList : public QAbstractListModel {
     void loadGroupList();
     void saveGroupList();
     QList<InstanceId> discoverInstances();
-    InstancePtr loadInstance(const InstanceId& id);
+    /* Makes the instance with the given ID from its already read instance.cfg */
+    InstancePtr loadInstance(const InstanceId& id, const INIFile& config);
+
+    void addToGroup(const InstanceId& id, const GroupId& group);
+    void removeFromGroup(const InstanceId& id, const GroupId& group);
+
+    /* Finds the rows of all the instances again, after some were removed */
+    void reindexRows();
+    /* Indexes the instances by the settings other instances are looked up by, if any of those changed */
+    void updateSettingIndexes() const;
 
-    void increaseGroupCount(const QString& group);
-    void decreaseGroupCount(const QString& group);
+    void loadConfigSnapshot();
+    void saveConfigSnapshot();
 
    private:
+    /* An instance.cfg as it was last read, and the identity the file had back then. */
+    struct ConfigSnapshot {
+        Hashing::FileIdentity identity;
+        INIFile config;
+    };
+
     int m_watchLevel = 0;
-    int totalPlayTime = 0;
+    // recorded play time of all the instances, kept up to date as single instances change
+    qint64 totalPlayTime = 0;
+    QHash<InstanceId, qint64> m_playTimes;
+    // their current sessions are added on top when the total is asked for
+    QSet<InstanceId> m_runningIds;
     bool m_dirty = false;
     QList<InstancePtr> m_instances;
-    // id -> refs
-    QMap<QString, int> m_groupNameCache;
+    // id -> row in m_instances
+    QHash<InstanceId, int> m_rowById;
+    // group -> ids of the instances in it, only groups with instances are here
+    QMap<GroupId, QSet<InstanceId>> m_groupMembers;
+
+    // built when they're first needed after the instances or their settings changed
+    mutable bool m_settingIndexesDirty = true;
+    mutable QHash<QString, InstancePtr> m_instanceByManagedName;
+    // id -> ids of the instances linked to it
+    mutable QHash<InstanceId, QStringList> m_linkingInstances;
 
     SettingsObjectPtr m_globalSettings;
     QString m_instDir;
     QFileSystemWatcher* m_watcher;
     // FIXME: this is so inefficient that looking at it is almost painful.
     QSet<QString> m_collapsedGroups;
-    QMap<InstanceId, GroupId> m_instanceGroupIndex;
+    QHash<InstanceId, GroupId> m_instanceGroupIndex;
     QSet<InstanceId> instanceSet;
     bool m_groupsLoaded = false;
     bool m_instancesProbed = false;
 
+    // so instance.cfg files don't have to be read again at startup unless they changed
+    QString m_snapshotFile;
+    QHash<InstanceId, ConfigSnapshot> m_configSnapshots;
+    bool m_snapshotsLoaded = false;
+
     QStack<TrashHistoryItem> m_trashHistory;
+    QList<Task::Ptr> m_deletions;
 };
@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "InstanceOverlay.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "FileSystem.h"
+#include "StringUtils.h"
+
+// Snippet from https://github.com/gulrak/filesystem#using-it-as-single-file-header
+
+#ifdef __APPLE__
+#include <Availability.h>  // for deployment target to support pre-catalina targets without std::fs
+#endif                     // __APPLE__
+
+#if ((defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || (defined(__cplusplus) && __cplusplus >= 201703L)) && defined(__has_include)
+#if __has_include(<filesystem>) && (!defined(__MAC_OS_X_VERSION_MIN_REQUIRED) || __MAC_OS_X_VERSION_MIN_REQUIRED >= 101500)
+#define GHC_USE_STD_FS
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif  // MacOS min version check
+#endif  // Other OSes version check
+
+#ifndef GHC_USE_STD_FS
+#include <ghc/filesystem.hpp>
+namespace fs = ghc::filesystem;
+#endif
+
+InstanceOverlay::InstanceOverlay(const QString& baseRoot, const QString& overlayRoot, const QString& manifestPath)
+    : m_baseRoot(baseRoot), m_overlayRoot(overlayRoot), m_manifestPath(manifestPath)
+{}
+
+const QStringList& InstanceOverlay::privatePaths()
+{
+    static const QStringList paths = { "saves",          "config",          "logs",         "crash-reports",
+                                       "screenshots",    "options.txt",     "optionsof.txt", "optionsshaders.txt",
+                                       "servers.dat",    "servers.dat_old", "usercache.json", "usernamecache.json",
+                                       "allowed_symlinks.txt" };
+    return paths;
+}
+
+QString InstanceOverlay::manifestPath(const QString& instanceRoot)
+{
+    return FS::PathCombine(instanceRoot, ".prism-overlay");
+}
+
+InstanceOverlay::Stat InstanceOverlay::stat(const QString& path)
+{
+    QFileInfo info(path);
+    if (!info.exists())
+        return {};
+    return { info.size(), info.lastModified().toMSecsSinceEpoch() };
+}
+
+QHash<QString, InstanceOverlay::Placed> InstanceOverlay::loadManifest() const
+{
+    QHash<QString, Placed> manifest;
+    QFile file(m_manifestPath);
+    if (!file.open(QIODevice::ReadOnly))
+        return manifest;
+
+    // one "size modified baseSize baseModified path" line per placed file, separated by tabs
+    while (!file.atEnd()) {
+        auto line = QString::fromUtf8(file.readLine());
+        if (line.endsWith('\n'))
+            line.chop(1);
+        auto parts = line.split('\t');
+        if (parts.size() < 5)
+            continue;
+        Placed placed{ { parts[0].toLongLong(), parts[1].toLongLong() }, { parts[2].toLongLong(), parts[3].toLongLong() } };
+        manifest.insert(parts.mid(4).join('\t'), placed);
+    }
+    return manifest;
+}
+
+bool InstanceOverlay::saveManifest(const QHash<QString, Placed>& manifest)
+{
+    QSaveFile file(m_manifestPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        m_error = QObject::tr("Couldn't write %1: %2").arg(m_manifestPath, file.errorString());
+        return false;
+    }
+    for (auto it = manifest.cbegin(); it != manifest.cend(); ++it) {
+        auto& placed = it.value();
+        file.write(QString("%1\t%2\t%3\t%4\t%5\n")
+                       .arg(placed.overlay.size)
+                       .arg(placed.overlay.modified)
+                       .arg(placed.base.size)
+                       .arg(placed.base.modified)
+                       .arg(it.key())
+                       .toUtf8());
+    }
+    if (!file.commit()) {
+        m_error = QObject::tr("Couldn't write %1: %2").arg(m_manifestPath, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+bool InstanceOverlay::placeFile(const QString& relative, Method method)
+{
+    auto src = FS::PathCombine(m_baseRoot, relative);
+    auto dst = FS::PathCombine(m_overlayRoot, relative);
+    if (!FS::ensureFilePathExists(dst))
+        return false;
+
+    std::error_code err;
+    switch (method) {
+        case Method::HardLink:
+            fs::create_hard_link(StringUtils::toStdString(src), StringUtils::toStdString(dst), err);
+            if (!err)
+                return true;
+            break;
+        case Method::Clone:
+            if (FS::clone_file(src, dst, err))
+                return true;
+            fs::remove(StringUtils::toStdString(dst), err);
+            break;
+        case Method::Copy:
+            break;
+    }
+    return QFile::copy(src, dst);
+}
+
+bool InstanceOverlay::materialize()
+{
+    m_error.clear();
+    m_placed = 0;
+    m_removed = 0;
+
+    if (!QFileInfo(m_baseRoot).isDir()) {
+        m_error = QObject::tr("The base game folder %1 doesn't exist").arg(m_baseRoot);
+        return false;
+    }
+    if (!FS::ensureFolderPathExists(m_overlayRoot)) {
+        m_error = QObject::tr("Couldn't create the game folder %1").arg(m_overlayRoot);
+        return false;
+    }
+
+    // first see what became of the files placed last time
+    QHash<QString, Placed> manifest;
+    const auto previous = loadManifest();
+    for (auto it = previous.cbegin(); it != previous.cend(); ++it) {
+        auto& relative = it.key();
+        auto& placed = it.value();
+        auto overlayPath = FS::PathCombine(m_overlayRoot, relative);
+        auto overlay = stat(overlayPath);
+        auto base = stat(FS::PathCombine(m_baseRoot, relative));
+
+        if (overlay.size < 0) {
+            // deleted by the user, don't bring it back as long as the base has it
+            if (base.size >= 0)
+                manifest.insert(relative, { {}, placed.base });
+            continue;
+        }
+        // changed or put there by the user, so it belongs to the overlay now
+        if (placed.overlay.size < 0 || overlay != placed.overlay)
+            continue;
+        if (base != placed.base) {
+            if (!QFile::remove(overlayPath)) {
+                m_error = QObject::tr("Couldn't remove the outdated file %1").arg(overlayPath);
+                return false;
+            }
+            m_removed++;
+            continue;
+        }
+        manifest.insert(relative, placed);
+    }
+
+    const auto method = [this] {
+        if (FS::canLink(m_baseRoot, m_overlayRoot) && FS::statFS(m_baseRoot).rootPath == FS::statFS(m_overlayRoot).rootPath)
+            return Method::HardLink;
+        if (FS::canClone(m_baseRoot, m_overlayRoot))
+            return Method::Clone;
+        return Method::Copy;
+    }();
+
+    bool complete = true;
+    auto place = [&](const QString& relative) {
+        if (manifest.contains(relative))
+            return;
+        auto overlayPath = FS::PathCombine(m_overlayRoot, relative);
+        if (QFileInfo::exists(overlayPath) || QFileInfo(overlayPath).isSymLink())
+            return;
+        if (!placeFile(relative, method)) {
+            qWarning() << "Couldn't place" << relative << "in the overlay at" << m_overlayRoot;
+            complete = false;
+            return;
+        }
+        manifest.insert(relative, { stat(overlayPath), stat(FS::PathCombine(m_baseRoot, relative)) });
+        m_placed++;
+    };
+
+    QDir baseDir(m_baseRoot);
+    for (auto& entry : baseDir.entryInfoList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot)) {
+        auto name = entry.fileName();
+        auto overlayPath = FS::PathCombine(m_overlayRoot, name);
+
+        if (privatePaths().contains(name)) {
+            if (QFileInfo::exists(overlayPath))
+                continue;
+            bool copied = true;
+            if (entry.isDir()) {
+                FS::copy folderCopy(entry.filePath(), overlayPath);
+                copied = folderCopy.followSymlinks(false)();
+            } else {
+                copied = QFile::copy(entry.filePath(), overlayPath);
+            }
+            if (!copied) {
+                qWarning() << "Couldn't copy" << name << "into the overlay at" << m_overlayRoot;
+                complete = false;
+            }
+            continue;
+        }
+
+        if (!entry.isDir() || entry.isSymLink()) {
+            place(name);
+            continue;
+        }
+        QDirIterator it(entry.filePath(), QDir::Files | QDir::Hidden | QDir::System, QDirIterator::Subdirectories);
+        while (it.hasNext())
+            place(baseDir.relativeFilePath(it.next()));
+    }
+    qDebug() << "Overlay at" << m_overlayRoot << "placed" << m_placed << "files and removed" << m_removed;
+
+    if (!saveManifest(manifest))
+        return false;
+    if (!complete)
+        m_error = QObject::tr("Some files couldn't be placed in %1").arg(m_overlayRoot);
+    return complete;
+}
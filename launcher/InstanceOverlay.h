@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Fills an overlay instance's game folder from the game folder of its base instance.
+ *
+ * Files the overlay doesn't have of its own are hard linked (or reflinked, or copied as a last resort) from the base,
+ * so many instances of one pack share the disk space of their mods, resource packs and so on. The paths in
+ * privatePaths() are copied once instead, because the game writes to them.
+ * What was placed is remembered in a manifest, so files the base no longer has or has replaced are taken out again,
+ * while files the user changed in the overlay are kept.
+ */
+class InstanceOverlay {
+   public:
+    InstanceOverlay(const QString& baseRoot, const QString& overlayRoot, const QString& manifestPath);
+
+    /// the top level entries of the game folder that every overlay gets its own copy of
+    static const QStringList& privatePaths();
+    /// where an overlay instance remembers what was placed in its game folder
+    static QString manifestPath(const QString& instanceRoot);
+
+    bool materialize();
+
+    QString errorString() const { return m_error; }
+    int placed() const { return m_placed; }
+    int removed() const { return m_removed; }
+
+   private:
+    struct Stat {
+        qint64 size = -1;
+        qint64 modified = -1;
+
+        bool operator==(const Stat& other) const { return size == other.size && modified == other.modified; }
+        bool operator!=(const Stat& other) const { return !(*this == other); }
+    };
+    /// what a placed file looked like in the overlay and in the base; a missing overlay means the user deleted it
+    struct Placed {
+        Stat overlay;
+        Stat base;
+    };
+    enum class Method { HardLink, Clone, Copy };
+
+    QHash<QString, Placed> loadManifest() const;
+    bool saveManifest(const QHash<QString, Placed>& manifest);
+    bool placeFile(const QString& relative, Method method);
+    static Stat stat(const QString& path);
+
+    QString m_baseRoot;
+    QString m_overlayRoot;
+    QString m_manifestPath;
+    QString m_error;
+    int m_placed = 0;
+    int m_removed = 0;
+};
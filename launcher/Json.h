@@ -166,25 +166,81 @@ T ensureIsType(const QJsonValue& value, const T default_ = T(), const QString& w
     }
 }
 
-/// @throw JsonException
-template <typename T>
-T requireIsType(const QJsonObject& parent, const QString& key, const QString& what = "__placeholder__")
+namespace detail {
+inline const QString& placeholder()
+{
+    static const QString value = QStringLiteral("__placeholder__");
+    return value;
+}
+
+inline QString describeKey(const QString& what, const QString& key)
+{
+    return QString(what).replace(placeholder(), '\'' + key + '\'');
+}
+
+/*
+ * Member lookups take the key as a QLatin1String where possible, which QJsonObject compares without building a QString,
+ * and only put together the description of the member when something goes wrong.
+ */
+template <typename T, typename Key>
+T requireMember(const QJsonObject& parent, Key key, const QString& what)
 {
-    const QString localWhat = QString(what).replace("__placeholder__", '\'' + key + '\'');
-    if (!parent.contains(key)) {
+    const QJsonValue value = parent.value(key);
+    if (value.isUndefined()) {
+        const QString localWhat = describeKey(what, key);
         throw JsonException(localWhat + "s parent does not contain " + localWhat);
     }
-    return requireIsType<T>(parent.value(key), localWhat);
+    try {
+        return requireIsType<T>(value, what);
+    } catch (const JsonException& e) {
+        throw JsonException(describeKey(e.cause(), key));
+    }
 }
 
-template <typename T>
-T ensureIsType(const QJsonObject& parent, const QString& key, const T default_ = T(), const QString& what = "__placeholder__")
+template <typename T, typename Key>
+T ensureMember(const QJsonObject& parent, Key key, const T& default_, const QString& what)
 {
-    const QString localWhat = QString(what).replace("__placeholder__", '\'' + key + '\'');
-    if (!parent.contains(key)) {
+    const QJsonValue value = parent.value(key);
+    if (value.isUndefined()) {
         return default_;
     }
-    return ensureIsType<T>(parent.value(key), default_, localWhat);
+    return ensureIsType<T>(value, default_, what);
+}
+}  // namespace detail
+
+/// @throw JsonException
+template <typename T>
+T requireIsType(const QJsonObject& parent, const QString& key, const QString& what = detail::placeholder())
+{
+    return detail::requireMember<T>(parent, key, what);
+}
+/// @throw JsonException
+template <typename T>
+T requireIsType(const QJsonObject& parent, QLatin1String key, const QString& what = detail::placeholder())
+{
+    return detail::requireMember<T>(parent, key, what);
+}
+/// @throw JsonException
+template <typename T, size_t N>
+T requireIsType(const QJsonObject& parent, const char (&key)[N], const QString& what = detail::placeholder())
+{
+    return detail::requireMember<T>(parent, QLatin1String(key, int(N - 1)), what);
+}
+
+template <typename T>
+T ensureIsType(const QJsonObject& parent, const QString& key, const T default_ = T(), const QString& what = detail::placeholder())
+{
+    return detail::ensureMember<T>(parent, key, default_, what);
+}
+template <typename T>
+T ensureIsType(const QJsonObject& parent, QLatin1String key, const T default_ = T(), const QString& what = detail::placeholder())
+{
+    return detail::ensureMember<T>(parent, key, default_, what);
+}
+template <typename T, size_t N>
+T ensureIsType(const QJsonObject& parent, const char (&key)[N], const T default_ = T(), const QString& what = detail::placeholder())
+{
+    return detail::ensureMember<T>(parent, QLatin1String(key, int(N - 1)), default_, what);
 }
 
 template <typename T>
@@ -218,48 +274,105 @@ QVector<T> ensureIsArrayOf(const QJsonValue& value, const QVector<T> default_, c
     return ensureIsArrayOf<T>(value, what);
 }
 
-/// @throw JsonException
-template <typename T>
-QVector<T> requireIsArrayOf(const QJsonObject& parent, const QString& key, const QString& what = "__placeholder__")
+namespace detail {
+template <typename T, typename Key>
+QVector<T> requireArrayMember(const QJsonObject& parent, Key key, const QString& what)
 {
-    const QString localWhat = QString(what).replace("__placeholder__", '\'' + key + '\'');
-    if (!parent.contains(key)) {
+    const QJsonValue value = parent.value(key);
+    if (value.isUndefined()) {
+        const QString localWhat = describeKey(what, key);
         throw JsonException(localWhat + "s parent does not contain " + localWhat);
     }
-    return ensureIsArrayOf<T>(parent.value(key), localWhat);
+    try {
+        return ensureIsArrayOf<T>(value, what);
+    } catch (const JsonException& e) {
+        throw JsonException(describeKey(e.cause(), key));
+    }
+}
+
+template <typename T, typename Key>
+QVector<T> ensureArrayMember(const QJsonObject& parent, Key key, const QVector<T>& default_, const QString& what)
+{
+    const QJsonValue value = parent.value(key);
+    if (value.isUndefined()) {
+        return default_;
+    }
+    try {
+        return ensureIsArrayOf<T>(value, default_, what);
+    } catch (const JsonException& e) {
+        throw JsonException(describeKey(e.cause(), key));
+    }
+}
+}  // namespace detail
+
+/// @throw JsonException
+template <typename T>
+QVector<T> requireIsArrayOf(const QJsonObject& parent, const QString& key, const QString& what = detail::placeholder())
+{
+    return detail::requireArrayMember<T>(parent, key, what);
+}
+/// @throw JsonException
+template <typename T, size_t N>
+QVector<T> requireIsArrayOf(const QJsonObject& parent, const char (&key)[N], const QString& what = detail::placeholder())
+{
+    return detail::requireArrayMember<T>(parent, QLatin1String(key, int(N - 1)), what);
 }
 
 template <typename T>
 QVector<T> ensureIsArrayOf(const QJsonObject& parent,
                            const QString& key,
                            const QVector<T>& default_ = QVector<T>(),
-                           const QString& what = "__placeholder__")
+                           const QString& what = detail::placeholder())
 {
-    const QString localWhat = QString(what).replace("__placeholder__", '\'' + key + '\'');
-    if (!parent.contains(key)) {
-        return default_;
-    }
-    return ensureIsArrayOf<T>(parent.value(key), default_, localWhat);
+    return detail::ensureArrayMember<T>(parent, key, default_, what);
+}
+template <typename T, size_t N>
+QVector<T> ensureIsArrayOf(const QJsonObject& parent,
+                           const char (&key)[N],
+                           const QVector<T>& default_ = QVector<T>(),
+                           const QString& what = detail::placeholder())
+{
+    return detail::ensureArrayMember<T>(parent, QLatin1String(key, int(N - 1)), default_, what);
 }
 
 // this macro part could be replaced by variadic functions that just pass on their arguments, but that wouldn't work well with IDE helpers
-#define JSON_HELPERFUNCTIONS(NAME, TYPE)                                                                              \
-    inline TYPE require##NAME(const QJsonValue& value, const QString& what = "Value")                                 \
-    {                                                                                                                 \
-        return requireIsType<TYPE>(value, what);                                                                      \
-    }                                                                                                                 \
-    inline TYPE ensure##NAME(const QJsonValue& value, const TYPE default_ = TYPE(), const QString& what = "Value")    \
-    {                                                                                                                 \
-        return ensureIsType<TYPE>(value, default_, what);                                                             \
-    }                                                                                                                 \
-    inline TYPE require##NAME(const QJsonObject& parent, const QString& key, const QString& what = "__placeholder__") \
-    {                                                                                                                 \
-        return requireIsType<TYPE>(parent, key, what);                                                                \
-    }                                                                                                                 \
-    inline TYPE ensure##NAME(const QJsonObject& parent, const QString& key, const TYPE default_ = TYPE(),             \
-                             const QString& what = "__placeholder")                                                   \
-    {                                                                                                                 \
-        return ensureIsType<TYPE>(parent, key, default_, what);                                                       \
+#define JSON_HELPERFUNCTIONS(NAME, TYPE)                                                                                     \
+    inline TYPE require##NAME(const QJsonValue& value, const QString& what = "Value")                                        \
+    {                                                                                                                        \
+        return requireIsType<TYPE>(value, what);                                                                             \
+    }                                                                                                                        \
+    inline TYPE ensure##NAME(const QJsonValue& value, const TYPE default_ = TYPE(), const QString& what = "Value")           \
+    {                                                                                                                        \
+        return ensureIsType<TYPE>(value, default_, what);                                                                    \
+    }                                                                                                                        \
+    inline TYPE require##NAME(const QJsonObject& parent, const QString& key, const QString& what = detail::placeholder())    \
+    {                                                                                                                        \
+        return requireIsType<TYPE>(parent, key, what);                                                                       \
+    }                                                                                                                        \
+    inline TYPE require##NAME(const QJsonObject& parent, QLatin1String key, const QString& what = detail::placeholder())     \
+    {                                                                                                                        \
+        return requireIsType<TYPE>(parent, key, what);                                                                       \
+    }                                                                                                                        \
+    template <size_t N>                                                                                                      \
+    inline TYPE require##NAME(const QJsonObject& parent, const char(&key)[N], const QString& what = detail::placeholder())   \
+    {                                                                                                                        \
+        return requireIsType<TYPE>(parent, key, what);                                                                       \
+    }                                                                                                                        \
+    inline TYPE ensure##NAME(const QJsonObject& parent, const QString& key, const TYPE default_ = TYPE(),                    \
+                             const QString& what = detail::placeholder())                                                    \
+    {                                                                                                                        \
+        return ensureIsType<TYPE>(parent, key, default_, what);                                                              \
+    }                                                                                                                        \
+    inline TYPE ensure##NAME(const QJsonObject& parent, QLatin1String key, const TYPE default_ = TYPE(),                     \
+                             const QString& what = detail::placeholder())                                                    \
+    {                                                                                                                        \
+        return ensureIsType<TYPE>(parent, key, default_, what);                                                              \
+    }                                                                                                                        \
+    template <size_t N>                                                                                                      \
+    inline TYPE ensure##NAME(const QJsonObject& parent, const char(&key)[N], const TYPE default_ = TYPE(),                   \
+                             const QString& what = detail::placeholder())                                                    \
+    {                                                                                                                        \
+        return ensureIsType<TYPE>(parent, key, default_, what);                                                              \
     }
 
 JSON_HELPERFUNCTIONS(Array, QJsonArray)
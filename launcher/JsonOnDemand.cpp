@@ -0,0 +1,559 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "JsonOnDemand.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <cctype>
+#include <cstring>
+#include <limits>
+
+namespace Json::OnDemand {
+
+// the Qt DOM silently gives up at this depth too
+static constexpr int MAX_DEPTH = 1024;
+
+struct Node {
+    Type type;
+    // strings: whether there is anything to unescape
+    bool escaped = false;
+    // byte range of the value, without the quotes for strings
+    int begin = 0;
+    int end = 0;
+    // the node after this value and everything inside it
+    int next = 0;
+};
+
+struct DocumentData {
+    QByteArray bytes;
+    QVector<Node> nodes;
+};
+
+namespace {
+
+class Parser {
+   public:
+    explicit Parser(DocumentData& out) : m_out(out), m_data(out.bytes.constData()), m_size(out.bytes.size()) {}
+
+    bool parse()
+    {
+        skipWhitespace();
+        if (!parseValue(0))
+            return false;
+        skipWhitespace();
+        if (m_pos != m_size)
+            return fail(QStringLiteral("garbage at the end of the document"));
+        return true;
+    }
+
+    QString error;
+    int errorOffset = -1;
+
+   private:
+    bool fail(const QString& message)
+    {
+        error = message;
+        errorOffset = m_pos;
+        return false;
+    }
+
+    void skipWhitespace()
+    {
+        while (m_pos < m_size) {
+            const char c = m_data[m_pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+                break;
+            ++m_pos;
+        }
+    }
+
+    int addNode(Type type, int begin)
+    {
+        m_out.nodes.append(Node{ type, false, begin, begin, 0 });
+        return m_out.nodes.size() - 1;
+    }
+
+    void finishNode(int node, int end)
+    {
+        auto& n = m_out.nodes[node];
+        n.end = end;
+        n.next = m_out.nodes.size();
+    }
+
+    bool parseValue(int depth)
+    {
+        if (m_pos >= m_size)
+            return fail(QStringLiteral("unterminated value"));
+        switch (m_data[m_pos]) {
+            case '{':
+                return parseObject(depth + 1);
+            case '[':
+                return parseArray(depth + 1);
+            case '"':
+                return parseString();
+            case 't':
+                return parseLiteral("true", Type::Bool);
+            case 'f':
+                return parseLiteral("false", Type::Bool);
+            case 'n':
+                return parseLiteral("null", Type::Null);
+            default:
+                return parseNumber();
+        }
+    }
+
+    bool parseObject(int depth)
+    {
+        if (depth > MAX_DEPTH)
+            return fail(QStringLiteral("too deeply nested document"));
+        const int node = addNode(Type::Object, m_pos++);
+        skipWhitespace();
+        if (m_pos < m_size && m_data[m_pos] == '}') {
+            finishNode(node, ++m_pos);
+            return true;
+        }
+        while (true) {
+            if (m_pos >= m_size || m_data[m_pos] != '"')
+                return fail(QStringLiteral("object keys must be strings"));
+            if (!parseString())
+                return false;
+            skipWhitespace();
+            if (m_pos >= m_size || m_data[m_pos] != ':')
+                return fail(QStringLiteral("missing name separator"));
+            ++m_pos;
+            skipWhitespace();
+            if (!parseValue(depth))
+                return false;
+            skipWhitespace();
+            if (m_pos >= m_size)
+                return fail(QStringLiteral("unterminated object"));
+            if (m_data[m_pos] == '}')
+                break;
+            if (m_data[m_pos] != ',')
+                return fail(QStringLiteral("missing value separator"));
+            ++m_pos;
+            skipWhitespace();
+        }
+        finishNode(node, ++m_pos);
+        return true;
+    }
+
+    bool parseArray(int depth)
+    {
+        if (depth > MAX_DEPTH)
+            return fail(QStringLiteral("too deeply nested document"));
+        const int node = addNode(Type::Array, m_pos++);
+        skipWhitespace();
+        if (m_pos < m_size && m_data[m_pos] == ']') {
+            finishNode(node, ++m_pos);
+            return true;
+        }
+        while (true) {
+            if (!parseValue(depth))
+                return false;
+            skipWhitespace();
+            if (m_pos >= m_size)
+                return fail(QStringLiteral("unterminated array"));
+            if (m_data[m_pos] == ']')
+                break;
+            if (m_data[m_pos] != ',')
+                return fail(QStringLiteral("missing value separator"));
+            ++m_pos;
+            skipWhitespace();
+        }
+        finishNode(node, ++m_pos);
+        return true;
+    }
+
+    bool parseString()
+    {
+        const int node = addNode(Type::String, ++m_pos);
+        bool escaped = false;
+        while (true) {
+            // plain text is skipped in one go, nothing gets decoded here
+            const char* stop = m_data + m_pos;
+            const char* const limit = m_data + m_size;
+            while (stop < limit && *stop != '"' && *stop != '\\' && static_cast<unsigned char>(*stop) >= 0x20)
+                ++stop;
+            m_pos = stop - m_data;
+            if (m_pos >= m_size)
+                return fail(QStringLiteral("unterminated string"));
+
+            const char c = m_data[m_pos];
+            if (c == '"')
+                break;
+            if (c != '\\')
+                return fail(QStringLiteral("control character in string"));
+
+            escaped = true;
+            if (++m_pos >= m_size)
+                return fail(QStringLiteral("unterminated string"));
+            switch (m_data[m_pos]) {
+                case '"':
+                case '\\':
+                case '/':
+                case 'b':
+                case 'f':
+                case 'n':
+                case 'r':
+                case 't':
+                    ++m_pos;
+                    break;
+                case 'u':
+                    for (int i = 1; i <= 4; i++) {
+                        if (m_pos + i >= m_size || !std::isxdigit(static_cast<unsigned char>(m_data[m_pos + i])))
+                            return fail(QStringLiteral("invalid unicode escape"));
+                    }
+                    m_pos += 5;
+                    break;
+                default:
+                    return fail(QStringLiteral("invalid escape sequence"));
+            }
+        }
+        finishNode(node, m_pos++);
+        m_out.nodes[node].escaped = escaped;
+        return true;
+    }
+
+    bool parseLiteral(const char* literal, Type type)
+    {
+        const int length = static_cast<int>(std::strlen(literal));
+        if (m_size - m_pos < length || std::memcmp(m_data + m_pos, literal, length) != 0)
+            return fail(QStringLiteral("illegal value"));
+        finishNode(addNode(type, m_pos), m_pos + length);
+        m_pos += length;
+        return true;
+    }
+
+    bool parseNumber()
+    {
+        const int begin = m_pos;
+        const auto isDigit = [this] { return m_pos < m_size && m_data[m_pos] >= '0' && m_data[m_pos] <= '9'; };
+        const auto skipDigits = [&] {
+            if (!isDigit())
+                return false;
+            while (isDigit())
+                ++m_pos;
+            return true;
+        };
+
+        if (m_pos < m_size && m_data[m_pos] == '-')
+            ++m_pos;
+        if (m_pos < m_size && m_data[m_pos] == '0')
+            ++m_pos;
+        else if (!skipDigits())
+            return fail(QStringLiteral("illegal value"));
+        if (m_pos < m_size && m_data[m_pos] == '.') {
+            ++m_pos;
+            if (!skipDigits())
+                return fail(QStringLiteral("illegal number"));
+        }
+        if (m_pos < m_size && (m_data[m_pos] == 'e' || m_data[m_pos] == 'E')) {
+            ++m_pos;
+            if (m_pos < m_size && (m_data[m_pos] == '+' || m_data[m_pos] == '-'))
+                ++m_pos;
+            if (!skipDigits())
+                return fail(QStringLiteral("illegal number"));
+        }
+        finishNode(addNode(Type::Double, begin), m_pos);
+        return true;
+    }
+
+    DocumentData& m_out;
+    const char* m_data;
+    int m_size;
+    int m_pos = 0;
+};
+
+const Node& nodeAt(const DocumentData* d, int node)
+{
+    return d->nodes.at(node);
+}
+
+QString decodeString(const DocumentData* d, const Node& n)
+{
+    const char* data = d->bytes.constData() + n.begin;
+    const int size = n.end - n.begin;
+    if (!n.escaped)
+        return QString::fromUtf8(data, size);
+
+    // the parser already checked every escape
+    QString out;
+    out.reserve(size);
+    int runStart = 0;
+    for (int i = 0; i < size; i++) {
+        if (data[i] != '\\')
+            continue;
+        if (i > runStart)
+            out += QString::fromUtf8(data + runStart, i - runStart);
+        const char c = data[++i];
+        switch (c) {
+            case 'b':
+                out += '\b';
+                break;
+            case 'f':
+                out += '\f';
+                break;
+            case 'n':
+                out += '\n';
+                break;
+            case 'r':
+                out += '\r';
+                break;
+            case 't':
+                out += '\t';
+                break;
+            case 'u':
+                // surrogate pairs are two escapes that end up next to each other
+                out += QChar(static_cast<char16_t>(QByteArray::fromRawData(data + i + 1, 4).toUShort(nullptr, 16)));
+                i += 4;
+                break;
+            default:
+                out += QLatin1Char(c);
+        }
+        runStart = i + 1;
+    }
+    if (runStart < size)
+        out += QString::fromUtf8(data + runStart, size - runStart);
+    return out;
+}
+
+bool isIntegral(const char* data, int size)
+{
+    for (int i = 0; i < size; i++) {
+        if (data[i] == '.' || data[i] == 'e' || data[i] == 'E')
+            return false;
+    }
+    // leaves room for accumulating without overflow
+    return size <= 18;
+}
+
+qint64 parseIntegral(const char* data, int size)
+{
+    const bool negative = data[0] == '-';
+    qint64 value = 0;
+    for (int i = negative ? 1 : 0; i < size; i++)
+        value = value * 10 + (data[i] - '0');
+    return negative ? -value : value;
+}
+
+}  // namespace
+
+Type Value::type() const
+{
+    return d ? nodeAt(d, node).type : Type::Undefined;
+}
+
+bool Value::toBool(bool defaultValue) const
+{
+    if (type() != Type::Bool)
+        return defaultValue;
+    return d->bytes.at(nodeAt(d, node).begin) == 't';
+}
+
+double Value::toDouble(double defaultValue) const
+{
+    if (type() != Type::Double)
+        return defaultValue;
+    const auto& n = nodeAt(d, node);
+    const char* data = d->bytes.constData() + n.begin;
+    const int size = n.end - n.begin;
+    if (isIntegral(data, size))
+        return static_cast<double>(parseIntegral(data, size));
+    return QByteArray::fromRawData(data, size).toDouble();
+}
+
+qint64 Value::toInteger(qint64 defaultValue) const
+{
+    if (type() != Type::Double)
+        return defaultValue;
+    const auto& n = nodeAt(d, node);
+    const char* data = d->bytes.constData() + n.begin;
+    const int size = n.end - n.begin;
+    if (isIntegral(data, size))
+        return parseIntegral(data, size);
+    const double value = toDouble();
+    if (value >= static_cast<double>(std::numeric_limits<qint64>::max()) ||
+        value <= static_cast<double>(std::numeric_limits<qint64>::min()))
+        return defaultValue;
+    return static_cast<qint64>(value);
+}
+
+QString Value::toString(const QString& defaultValue) const
+{
+    if (type() != Type::String)
+        return defaultValue;
+    return decodeString(d, nodeAt(d, node));
+}
+
+Array Value::toArray() const
+{
+    return isArray() ? Array(d, node) : Array();
+}
+
+Object Value::toObject() const
+{
+    return isObject() ? Object(d, node) : Object();
+}
+
+QJsonValue Value::toJsonValue() const
+{
+    switch (type()) {
+        case Type::Null:
+            return QJsonValue(QJsonValue::Null);
+        case Type::Bool:
+            return toBool();
+        case Type::Double:
+            return toDouble();
+        case Type::String:
+            return toString();
+        case Type::Array: {
+            QJsonArray array;
+            for (auto value : toArray())
+                array.append(value.toJsonValue());
+            return array;
+        }
+        case Type::Object: {
+            QJsonObject object;
+            const auto obj = toObject();
+            for (auto iter = obj.begin(); iter != obj.end(); ++iter)
+                object.insert(iter.key(), iter.value().toJsonValue());
+            return object;
+        }
+        case Type::Undefined:
+            break;
+    }
+    return QJsonValue(QJsonValue::Undefined);
+}
+
+QString Object::const_iterator::key() const
+{
+    return decodeString(d, nodeAt(d, node));
+}
+
+bool Object::const_iterator::keyEquals(QLatin1String key) const
+{
+    const auto& n = nodeAt(d, node);
+    if (n.escaped)
+        return decodeString(d, n) == key;
+    return n.end - n.begin == key.size() && std::memcmp(d->bytes.constData() + n.begin, key.data(), key.size()) == 0;
+}
+
+Value Object::const_iterator::value() const
+{
+    return Value(d, node + 1);
+}
+
+Object::const_iterator& Object::const_iterator::operator++()
+{
+    node = nodeAt(d, node + 1).next;
+    return *this;
+}
+
+Object::const_iterator Object::begin() const
+{
+    return d ? const_iterator(d, node + 1) : const_iterator(nullptr, -1);
+}
+
+Object::const_iterator Object::end() const
+{
+    return d ? const_iterator(d, nodeAt(d, node).next) : const_iterator(nullptr, -1);
+}
+
+int Object::size() const
+{
+    int count = 0;
+    for (auto iter = begin(); iter != end(); ++iter)
+        count++;
+    return count;
+}
+
+Value Object::value(QLatin1String key) const
+{
+    Value found;
+    for (auto iter = begin(); iter != end(); ++iter) {
+        if (iter.keyEquals(key))
+            found = iter.value();
+    }
+    return found;
+}
+
+Array::const_iterator& Array::const_iterator::operator++()
+{
+    node = nodeAt(d, node).next;
+    return *this;
+}
+
+Array::const_iterator Array::begin() const
+{
+    return d ? const_iterator(d, node + 1) : const_iterator(nullptr, -1);
+}
+
+Array::const_iterator Array::end() const
+{
+    return d ? const_iterator(d, nodeAt(d, node).next) : const_iterator(nullptr, -1);
+}
+
+int Array::size() const
+{
+    int count = 0;
+    for (auto iter = begin(); iter != end(); ++iter)
+        count++;
+    return count;
+}
+
+Document Document::parse(const QByteArray& data)
+{
+    Document doc;
+    if (data.size() >= std::numeric_limits<int>::max()) {
+        doc.m_error = QStringLiteral("document too large");
+        doc.m_errorOffset = 0;
+        return doc;
+    }
+
+    auto parsed = QSharedPointer<DocumentData>::create();
+    parsed->bytes = data;
+    // a rough guess that saves most of the regrowing on typical documents
+    parsed->nodes.reserve(data.size() / 16);
+    Parser parser(*parsed);
+    if (!parser.parse()) {
+        doc.m_error = parser.error;
+        doc.m_errorOffset = parser.errorOffset;
+        return doc;
+    }
+    parsed->nodes.squeeze();
+    doc.m_data = parsed;
+    return doc;
+}
+
+Value Document::root() const
+{
+    return m_data ? Value(m_data.data(), 0) : Value();
+}
+
+Document requireDocument(const QByteArray& data, const QString& what)
+{
+    auto doc = Document::parse(data);
+    if (doc.isNull())
+        throw JsonException(what + ": Error parsing JSON: " + doc.errorString() + " at offset " + QString::number(doc.errorOffset()));
+    return doc;
+}
+
+}  // namespace Json::OnDemand
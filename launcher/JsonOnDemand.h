@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QLatin1String>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include "Json.h"
+
+/*
+ * A read-only JSON façade for large documents, such as asset indexes and pack lists.
+ *
+ * Parsing validates the whole document and records where each value starts and ends, without building a QJsonDocument.
+ * Strings and numbers are only converted when they are asked for, and keys are compared against the raw bytes.
+ * Values refer to the document they came from and stay usable as long as any copy of it is around.
+ */
+namespace Json::OnDemand {
+
+enum class Type : quint8 { Null, Bool, Double, String, Array, Object, Undefined };
+
+struct DocumentData;
+class Document;
+class Array;
+class Object;
+
+class Value {
+   public:
+    Value() = default;
+
+    Type type() const;
+    bool isNull() const { return type() == Type::Null; }
+    bool isBool() const { return type() == Type::Bool; }
+    bool isDouble() const { return type() == Type::Double; }
+    bool isString() const { return type() == Type::String; }
+    bool isArray() const { return type() == Type::Array; }
+    bool isObject() const { return type() == Type::Object; }
+    bool isUndefined() const { return type() == Type::Undefined; }
+
+    bool toBool(bool defaultValue = false) const;
+    double toDouble(double defaultValue = 0) const;
+    /// integral numbers are read without going through a double
+    qint64 toInteger(qint64 defaultValue = 0) const;
+    QString toString(const QString& defaultValue = {}) const;
+    Array toArray() const;
+    Object toObject() const;
+
+    /// builds the Qt DOM for this value, for handing it to code that expects one
+    QJsonValue toJsonValue() const;
+
+   private:
+    friend class Document;
+    friend class Array;
+    friend class Object;
+    Value(const DocumentData* d, int node) : d(d), node(node) {}
+
+    const DocumentData* d = nullptr;
+    int node = -1;
+};
+
+class Object {
+   public:
+    Object() = default;
+
+    class const_iterator {
+       public:
+        QString key() const;
+        bool keyEquals(QLatin1String key) const;
+        Value value() const;
+        Value operator*() const { return value(); }
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+
+       private:
+        friend class Object;
+        const_iterator(const DocumentData* d, int node) : d(d), node(node) {}
+        const DocumentData* d;
+        int node;
+    };
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    bool isEmpty() const { return begin() == end(); }
+    /// walks all members, so prefer iterating when visiting more than a few
+    int size() const;
+
+    /// the last member with this key, like QJsonObject, or an undefined value
+    Value value(QLatin1String key) const;
+    Value operator[](QLatin1String key) const { return value(key); }
+    bool contains(QLatin1String key) const { return !value(key).isUndefined(); }
+
+   private:
+    friend class Value;
+    Object(const DocumentData* d, int node) : d(d), node(node) {}
+    const DocumentData* d = nullptr;
+    int node = -1;
+};
+
+class Array {
+   public:
+    Array() = default;
+
+    class const_iterator {
+       public:
+        Value operator*() const { return Value(d, node); }
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+
+       private:
+        friend class Array;
+        const_iterator(const DocumentData* d, int node) : d(d), node(node) {}
+        const DocumentData* d;
+        int node;
+    };
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    bool isEmpty() const { return begin() == end(); }
+    /// walks all elements
+    int size() const;
+
+   private:
+    friend class Value;
+    Array(const DocumentData* d, int node) : d(d), node(node) {}
+    const DocumentData* d = nullptr;
+    int node = -1;
+};
+
+class Document {
+   public:
+    Document() = default;
+
+    /// a null document with errorString and errorOffset set when data isn't valid JSON
+    static Document parse(const QByteArray& data);
+
+    bool isNull() const { return !m_data; }
+    Value root() const;
+    bool isObject() const { return root().isObject(); }
+    bool isArray() const { return root().isArray(); }
+    Object object() const { return root().toObject(); }
+    Array array() const { return root().toArray(); }
+
+    QString errorString() const { return m_error; }
+    int errorOffset() const { return m_errorOffset; }
+
+   private:
+    QSharedPointer<const DocumentData> m_data;
+    QString m_error;
+    int m_errorOffset = -1;
+};
+
+/// @throw JsonException
+Document requireDocument(const QByteArray& data, const QString& what = "Document");
+
+}  // namespace Json::OnDemand
@@ -57,6 +57,7 @@
 #include "BuildConfig.h"
 #include "JavaCommon.h"
 #include "launch/steps/TextPrint.h"
+#include "minecraft/launch/WaitForAccountRefresh.h"
 #include "tasks/Task.h"
 
 LaunchController::LaunchController(QObject* parent) : Task(parent) {}
@@ -245,6 +246,11 @@ void LaunchController::login()
             }
             /* fallthrough */
             case AccountState::Working: {
+                // the account was good to play online last time, so get the launch ready while the refresh is going on
+                if (canLaunchWhileRefreshing()) {
+                    launchInstance(true);
+                    return;
+                }
                 // refresh is in progress, we need to wait for it to finish to proceed.
                 ProgressDialog progDialog(m_parentWidget);
                 if (m_online) {
@@ -282,7 +288,16 @@ void LaunchController::login()
     emitFailed(tr("Failed to launch."));
 }
 
-void LaunchController::launchInstance()
+bool LaunchController::canLaunchWhileRefreshing()
+{
+    // anything else needs the refresh to be done to know what to ask the user
+    if (!m_online || m_demo || !m_accountToUse->ownsMinecraft() || !m_accountToUse->hasProfile())
+        return false;
+    auto task = m_accountToUse->currentTask();
+    return task && task->isRunning();
+}
+
+void LaunchController::launchInstance(bool waitForAccountRefresh)
 {
     Q_ASSERT_X(m_instance != NULL, "launchInstance", "instance is NULL");
     Q_ASSERT_X(m_session.get() != nullptr, "launchInstance", "session is NULL");
@@ -299,6 +314,10 @@ void LaunchController::launchInstance()
         return;
     }
 
+    if (waitForAccountRefresh) {
+        m_launcher->insertStepBeforeGame(makeShared<WaitForAccountRefresh>(m_launcher.get(), m_accountToUse, m_session));
+    }
+
     auto console = qobject_cast<InstanceWindow*>(m_parentWidget);
     auto showConsole = m_instance->settings()->get("ShowConsole").toBool();
     if (!console && showConsole) {
@@ -72,7 +72,9 @@ class LaunchController : public Task {
 
    private:
     void login();
-    void launchInstance();
+    /// with waitForAccountRefresh, the refresh the account is going through is only waited for right before the game starts
+    void launchInstance(bool waitForAccountRefresh = false);
+    bool canLaunchWhileRefreshing();
     void decideAccount();
 
    private slots:
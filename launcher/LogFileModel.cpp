@@ -0,0 +1,295 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "LogFileModel.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTemporaryFile>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#include <zlib.h>
+
+#include "tasks/CpuExecutor.h"
+
+namespace {
+// lines are handed to the model after every this many bytes, so the view fills up while the rest is being looked at
+constexpr qint64 INDEX_BATCH_SIZE = 4 * 1024 * 1024;
+constexpr qint64 INFLATE_CHUNK_SIZE = 1024 * 1024;
+// a line is cut off at this many bytes when shown, some logs have huge ones that no view lays out quickly
+constexpr qint64 MAX_SHOWN_LINE = 16 * 1024;
+
+char foldCase(char c)
+{
+    return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+}
+
+bool matchesAt(const char* at, const QByteArray& what)
+{
+    for (int i = 0; i < what.size(); i++) {
+        if (foldCase(at[i]) != foldCase(what[i]))
+            return false;
+    }
+    return true;
+}
+
+bool inflateInto(QFile& in, QIODevice& out)
+{
+    z_stream stream{};
+    // 16 makes zlib expect a gzip header
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK)
+        return false;
+
+    QByteArray input;
+    QByteArray output(INFLATE_CHUNK_SIZE, Qt::Uninitialized);
+    int result = Z_OK;
+    bool ok = true;
+    while (ok) {
+        if (stream.avail_in == 0) {
+            input = in.read(INFLATE_CHUNK_SIZE);
+            if (input.isEmpty())
+                break;
+            stream.next_in = reinterpret_cast<Bytef*>(input.data());
+            stream.avail_in = input.size();
+        }
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = output.size();
+        result = inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+            ok = false;
+            break;
+        }
+        auto have = output.size() - int(stream.avail_out);
+        if (have > 0 && out.write(output.constData(), have) != have)
+            ok = false;
+        // files of several gzip members are just the members one after the other
+        if (result == Z_STREAM_END && inflateReset(&stream) != Z_OK)
+            ok = false;
+    }
+    inflateEnd(&stream);
+    return ok && (result == Z_STREAM_END || (result == Z_OK && stream.total_in == 0));
+}
+}  // namespace
+
+struct LogFileModel::Source {
+    QString path;
+    QFile file;
+    std::unique_ptr<QTemporaryFile> inflated;
+    const char* data = nullptr;
+    qint64 size = 0;
+
+    // the model, while it still wants what is found; taken under the lock, so the model can't go away while posting to it
+    QMutex lock;
+    LogFileModel* model = nullptr;
+    std::atomic<bool> cancelled{ false };
+
+    void post(std::vector<qint64> lineEnds, bool done)
+    {
+        QMutexLocker locker(&lock);
+        if (!model)
+            return;
+        QMetaObject::invokeMethod(
+            model, [model = model, lineEnds = std::move(lineEnds), done] { model->indexed(lineEnds, done); }, Qt::QueuedConnection);
+    }
+
+    void fail(const QString& reason)
+    {
+        QMutexLocker locker(&lock);
+        if (!model)
+            return;
+        QMetaObject::invokeMethod(
+            model,
+            [model = model, reason] {
+                model->m_loading = false;
+                model->showMessage(reason);
+                emit model->loadFailed(reason);
+            },
+            Qt::QueuedConnection);
+    }
+
+    void index()
+    {
+        QFile* mapped = &file;
+        if (path.endsWith(".gz")) {
+            inflated.reset(new QTemporaryFile());
+            if (!inflated->open() || !inflateInto(file, *inflated) || !inflated->flush()) {
+                fail(LogFileModel::tr("The file (%1) is not readable.").arg(path));
+                return;
+            }
+            mapped = inflated.get();
+        }
+
+        size = mapped->size();
+        if (size > 0) {
+            data = reinterpret_cast<const char*>(mapped->map(0, size));
+            if (!data) {
+                fail(LogFileModel::tr("The file (%1) is not readable: %2").arg(path, mapped->errorString()));
+                return;
+            }
+        }
+
+        std::vector<qint64> batch;
+        for (qint64 from = 0; from < size && !cancelled; from += INDEX_BATCH_SIZE) {
+            auto end = std::min(size, from + INDEX_BATCH_SIZE);
+            for (auto at = data + from; auto newline = static_cast<const char*>(std::memchr(at, '\n', data + end - at));
+                 at = newline + 1) {
+                batch.push_back(newline - data);
+            }
+            if (end == size && data[size - 1] != '\n')
+                batch.push_back(size);
+            post(std::move(batch), false);
+            batch = {};
+        }
+        post({}, true);
+    }
+};
+
+LogFileModel::LogFileModel(QObject* parent) : QAbstractListModel(parent) {}
+
+LogFileModel::~LogFileModel()
+{
+    clear();
+}
+
+bool LogFileModel::load(const QString& path)
+{
+    clear();
+
+    auto source = std::make_shared<Source>();
+    source->path = path;
+    source->file.setFileName(path);
+    if (!source->file.open(QIODevice::ReadOnly))
+        return false;
+    source->model = this;
+
+    m_source = source;
+    m_loading = true;
+    CpuExecutor::post(CpuExecutor::Priority::Interactive, [source] { source->index(); });
+    return true;
+}
+
+void LogFileModel::clear()
+{
+    beginResetModel();
+    if (m_source) {
+        QMutexLocker locker(&m_source->lock);
+        m_source->model = nullptr;
+        m_source->cancelled = true;
+    }
+    // the worker keeps its own reference, the mapping goes away with the last one
+    m_source.reset();
+    m_lineEnds = {};
+    m_loading = false;
+    m_message.clear();
+    endResetModel();
+}
+
+void LogFileModel::showMessage(const QString& message)
+{
+    beginResetModel();
+    m_lineEnds = {};
+    m_message = message;
+    endResetModel();
+}
+
+void LogFileModel::indexed(const std::vector<qint64>& lineEnds, bool done)
+{
+    if (!lineEnds.empty()) {
+        beginInsertRows({}, int(m_lineEnds.size()), int(m_lineEnds.size() + lineEnds.size() - 1));
+        m_lineEnds.insert(m_lineEnds.end(), lineEnds.begin(), lineEnds.end());
+        endInsertRows();
+    }
+    if (done) {
+        m_loading = false;
+        emit loaded();
+    }
+}
+
+int LogFileModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+        return 0;
+    if (!m_message.isEmpty())
+        return 1;
+    return int(m_lineEnds.size());
+}
+
+QVariant LogFileModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount() || role != Qt::DisplayRole)
+        return {};
+    if (!m_message.isEmpty())
+        return m_message;
+
+    auto start = rowStart(index.row());
+    auto end = m_lineEnds[index.row()];
+    if (end > start && m_source->data[end - 1] == '\r')
+        end--;
+    auto line = QString::fromUtf8(m_source->data + start, int(std::min(end - start, MAX_SHOWN_LINE)));
+    if (end - start > MAX_SHOWN_LINE)
+        line += "…";
+    return line;
+}
+
+qint64 LogFileModel::indexedSize() const
+{
+    if (m_lineEnds.empty())
+        return 0;
+    return std::min(m_lineEnds.back() + 1, m_source->size);
+}
+
+QString LogFileModel::text() const
+{
+    if (m_lineEnds.empty())
+        return {};
+    return QString::fromUtf8(m_source->data, int(std::min<qint64>(indexedSize(), std::numeric_limits<int>::max())));
+}
+
+qint64 LogFileModel::find(const QByteArray& what, qint64 from, bool backward) const
+{
+    auto size = indexedSize();
+    if (what.isEmpty() || what.size() > size)
+        return -1;
+    auto data = m_source->data;
+    auto last = size - what.size();
+
+    if (backward) {
+        for (auto at = std::min(from - 1, last); at >= 0; at--) {
+            if (matchesAt(data + at, what))
+                return at;
+        }
+        return -1;
+    }
+
+    // the first byte is looked for in both cases with memchr, which is a lot faster than comparing every byte
+    auto lower = foldCase(what[0]);
+    auto upper = lower >= 'a' && lower <= 'z' ? char(lower - 'a' + 'A') : lower;
+    for (auto at = std::max<qint64>(from, 0); at <= last;) {
+        auto lowerHit = static_cast<const char*>(std::memchr(data + at, lower, last - at + 1));
+        auto upperHit = upper == lower ? nullptr : static_cast<const char*>(std::memchr(data + at, upper, last - at + 1));
+        const char* hit = !lowerHit ? upperHit : !upperHit ? lowerHit : std::min(lowerHit, upperHit);
+        if (!hit)
+            return -1;
+        if (matchesAt(hit, what))
+            return hit - data;
+        at = hit - data + 1;
+    }
+    return -1;
+}
+
+int LogFileModel::rowAt(qint64 offset) const
+{
+    auto it = std::lower_bound(m_lineEnds.begin(), m_lineEnds.end(), offset);
+    return int(std::min<size_t>(it - m_lineEnds.begin(), m_lineEnds.empty() ? 0 : m_lineEnds.size() - 1));
+}
+
+qint64 LogFileModel::rowStart(int row) const
+{
+    return row <= 0 || m_lineEnds.empty() ? 0 : m_lineEnds[std::min<size_t>(row, m_lineEnds.size()) - 1] + 1;
+}
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+/** The lines of a log file of any size, for a view that only draws the ones that are visible.
+ *
+ *  The file is mapped into memory, .gz ones after being inflated into a temporary file, and its lines are found on a
+ *  worker thread. They show up in batches as they are found, so the start of a huge log can be read right away. Nothing
+ *  but the line ends is kept in memory, each line is only made a QString when it is shown.
+ */
+class LogFileModel : public QAbstractListModel {
+    Q_OBJECT
+   public:
+    explicit LogFileModel(QObject* parent = nullptr);
+    ~LogFileModel() override;
+
+    /* Starts showing the file at path, returns false if it can't be opened. */
+    bool load(const QString& path);
+    void clear();
+    /* Shows the message instead of a file. */
+    void showMessage(const QString& message);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    bool isLoading() const { return m_loading; }
+    /* How much of the file has been split into lines so far, everything when it's done loading. */
+    qint64 indexedSize() const;
+
+    /* The text of the lines found so far. */
+    QString text() const;
+
+    /* Where what is first found from the byte at from on, or last found before it going backward, ignoring the case of
+     * ASCII letters; -1 if it isn't. The raw bytes are searched, so nothing has to be converted to text. */
+    qint64 find(const QByteArray& what, qint64 from, bool backward) const;
+    /* The row holding the byte at offset. */
+    int rowAt(qint64 offset) const;
+    /* Where the row starts in the file. */
+    qint64 rowStart(int row) const;
+
+   signals:
+    void loaded();
+    void loadFailed(const QString& reason);
+
+   private:
+    struct Source;
+
+    void indexed(const std::vector<qint64>& lineEnds, bool done);
+
+    std::shared_ptr<Source> m_source;
+    // where each line ends, at its newline or at the end of the file
+    std::vector<qint64> m_lineEnds;
+    bool m_loading = false;
+    QString m_message;
+};
@@ -39,6 +39,21 @@
 #include <QTextDecoder>
 #include "MessageLevel.h"
 
+#include <cstring>
+
+namespace {
+QString decodeLine(QTextDecoder& decoder, const char* data, qsizetype size)
+{
+    // carriage returns are rare enough that checking for them is cheaper than always copying the line
+    if (!std::memchr(data, '\r', size)) {
+        return decoder.toUnicode(data, static_cast<int>(size));
+    }
+    QByteArray stripped(data, size);
+    stripped.replace('\r', QByteArray());
+    return decoder.toUnicode(stripped);
+}
+}  // namespace
+
 LoggedProcess::LoggedProcess(QObject* parent) : QProcess(parent)
 {
     // QProcess has a strange interface... let's map a lot of those into a few.
@@ -56,31 +71,41 @@ LoggedProcess::~LoggedProcess()
     }
 }
 
-QStringList LoggedProcess::reprocess(const QByteArray& data, QTextDecoder& decoder)
+QStringList LoggedProcess::reprocess(const QByteArray& data, QTextDecoder& decoder, QByteArray& leftover)
 {
-    auto str = decoder.toUnicode(data);
-
-    if (!m_leftover_line.isEmpty()) {
-        str.prepend(m_leftover_line);
-        m_leftover_line = "";
+    QStringList lines;
+    const char* end = data.constData() + data.size();
+    const char* lineStart = data.constData();
+
+    // look for the line ends in the raw bytes, so every line is only decoded once
+    while (auto lineEnd = static_cast<const char*>(std::memchr(lineStart, '\n', end - lineStart))) {
+        if (leftover.isEmpty()) {
+            lines.append(decodeLine(decoder, lineStart, lineEnd - lineStart));
+        } else {
+            // the line started in a previous chunk
+            leftover.append(lineStart, lineEnd - lineStart);
+            lines.append(decodeLine(decoder, leftover.constData(), leftover.size()));
+            leftover.clear();
+        }
+        lineStart = lineEnd + 1;
     }
 
-    auto lines = str.remove(QChar::CarriageReturn).split(QChar::LineFeed);
-
-    m_leftover_line = lines.takeLast();
+    leftover.append(lineStart, end - lineStart);
     return lines;
 }
 
 void LoggedProcess::on_stdErr()
 {
-    auto lines = reprocess(readAllStandardError(), m_err_decoder);
-    emit log(lines, MessageLevel::StdErr);
+    auto lines = reprocess(readAllStandardError(), m_err_decoder, m_err_leftover);
+    if (!lines.isEmpty())
+        emit log(lines, MessageLevel::StdErr);
 }
 
 void LoggedProcess::on_stdOut()
 {
-    auto lines = reprocess(readAllStandardOutput(), m_out_decoder);
-    emit log(lines, MessageLevel::StdOut);
+    auto lines = reprocess(readAllStandardOutput(), m_out_decoder, m_out_leftover);
+    if (!lines.isEmpty())
+        emit log(lines, MessageLevel::StdOut);
 }
 
 void LoggedProcess::on_exit(int exit_code, QProcess::ExitStatus status)
@@ -77,12 +77,15 @@ class LoggedProcess : public QProcess {
    private:
     void changeState(LoggedProcess::State state);
 
-    QStringList reprocess(const QByteArray& data, QTextDecoder& decoder);
+    /// splits the data into lines and decodes the complete ones, keeping the incomplete last one in `leftover`
+    QStringList reprocess(const QByteArray& data, QTextDecoder& decoder, QByteArray& leftover);
 
    private:
     QTextDecoder m_err_decoder = QTextDecoder(QTextCodec::codecForLocale());
     QTextDecoder m_out_decoder = QTextDecoder(QTextCodec::codecForLocale());
-    QString m_leftover_line;
+    // raw bytes of the incomplete last line of each stream
+    QByteArray m_err_leftover;
+    QByteArray m_out_leftover;
     bool m_killed = false;
     State m_state = NotRunning;
     int m_exit_code = 0;
@@ -42,13 +42,74 @@
 
 #include <QCoreApplication>
 #include <QDebug>
+#include <QThread>
+#include <QtEndian>
 #include <QUrl>
 
 #if defined(LAUNCHER_APPLICATION)
 #include <QtConcurrentRun>
+#include <deque>
+#include "tasks/CpuExecutor.h"
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
 namespace MMCZip {
+namespace {
+// formats that are compressed already, deflating them again only costs time
+bool isCompressedFormat(const QString& name)
+{
+    static const QStringList suffixes = { "jar", "zip", "png", "jpg", "jpeg", "gif", "webp", "ogg", "mp3", "gz", "xz", "zst", "7z", "mrpack" };
+    auto dot = name.lastIndexOf('.');
+    return dot != -1 && suffixes.contains(name.mid(dot + 1), Qt::CaseInsensitive);
+}
+
+// like JlCompress::compressFile, but already compressed formats are stored as they are
+bool compressFile(QuaZip* zip, const QString& fileName, const QString& fileDest)
+{
+    QFile inFile(fileName);
+    if (!inFile.open(QIODevice::ReadOnly))
+        return false;
+
+    bool store = isCompressedFormat(fileDest);
+    QuaZipFile outFile(zip);
+    if (!outFile.open(QIODevice::WriteOnly, QuaZipNewInfo(fileDest, fileName), nullptr, 0, store ? 0 : Z_DEFLATED,
+                      store ? 0 : Z_DEFAULT_COMPRESSION))
+        return false;
+    if (!JlCompress::copyData(inFile, outFile) || outFile.getZipError() != UNZ_OK)
+        return false;
+    outFile.close();
+    return outFile.getZipError() == UNZ_OK;
+}
+
+// moves the compressed data of the current entry into a new entry of the other zip, without inflating and deflating it again
+bool copyRawEntry(const QuaZipFileInfo64& info, QuaZipFile& fileInsideMod, QuaZipFile& zipOutFile)
+{
+    int method = 0;
+    int level = 0;
+    if (!fileInsideMod.open(QIODevice::ReadOnly, &method, &level, true))
+        return false;
+
+    QuaZipNewInfo info_out(fileInsideMod.getActualFileName());
+    info_out.dateTime = info.dateTime;
+    info_out.externalAttr = info.externalAttr;
+    info_out.uncompressedSize = info.uncompressedSize;
+    if (!zipOutFile.open(QIODevice::WriteOnly, info_out, nullptr, info.crc, method, level, true)) {
+        fileInsideMod.close();
+        return false;
+    }
+    bool copied = JlCompress::copyData(fileInsideMod, zipOutFile);
+    zipOutFile.close();
+    fileInsideMod.close();
+    return copied && zipOutFile.getZipError() == ZIP_OK;
+}
+}  // namespace
+
 // ours
 bool mergeZipFiles(QuaZip* into, QFileInfo from, QSet<QString>& contained, const FilterFunction& filter)
 {
@@ -69,6 +130,16 @@ bool mergeZipFiles(QuaZip* into, QFileInfo from, QSet<QString>& contained, const
         }
         contained.insert(filename);
 
+        // encrypted entries would lose their flag in a raw copy, so only those go the long way
+        QuaZipFileInfo64 info;
+        if (modZip.getCurrentFileInfo(&info) && !(info.flags & 1)) {
+            if (!copyRawEntry(info, fileInsideMod, zipOutFile)) {
+                qCritical() << "Failed to copy data of " << filename << " into the jar";
+                return false;
+            }
+            continue;
+        }
+
         if (!fileInsideMod.open(QIODevice::ReadOnly)) {
             qCritical() << "Failed to open " << filename << " from " << from.fileName();
             return false;
@@ -109,7 +180,7 @@ bool compressDirFiles(QuaZip* zip, QString dir, QFileInfoList files, bool follow
                 srcPath = e.canonicalFilePath();
             }
         }
-        if (!JlCompress::compressFile(zip, srcPath, filePath))
+        if (!compressFile(zip, srcPath, filePath))
             return false;
     }
 
@@ -169,7 +240,7 @@ bool createModdedJar(QString sourceJarPath, QString targetJarPath, const QList<M
         } else if (mod->type() == ResourceType::SINGLEFILE) {
             // FIXME: buggy - does not work with addedFiles
             auto filename = mod->fileinfo();
-            if (!JlCompress::compressFile(&zipOut, filename.absoluteFilePath(), filename.fileName())) {
+            if (!compressFile(&zipOut, filename.absoluteFilePath(), filename.fileName())) {
                 zipOut.close();
                 QFile::remove(targetJarPath);
                 qCritical() << "Failed to add" << mod->fileinfo().fileName() << "to the jar.";
@@ -267,7 +338,7 @@ bool findFilesInZip(QuaZip* zip, const QString& what, QStringList& result, const
 }
 
 // ours
-std::optional<QStringList> extractSubDir(QuaZip* zip, const QString& subdir, const QString& target)
+std::optional<QStringList> extractSubDir(QuaZip* zip, const QString& subdir, const QString& target, const FilterFunction& filter)
 {
     auto target_top_dir = QUrl::fromLocalFile(target);
 
@@ -286,6 +357,16 @@ std::optional<QStringList> extractSubDir(QuaZip* zip, const QString& subdir, con
         return std::nullopt;
     }
 
+    // Work out where everything goes from the central directory first, so nothing is written when an entry would end up
+    // outside of the target, and every folder can be made before the files are extracted.
+    struct PlannedEntry {
+        unz64_file_pos pos;
+        QString original_name;
+        QString target_file_path;
+        bool done = false;
+    };
+    std::vector<PlannedEntry> plan;
+    QSet<QString> folders;
     do {
         QString file_name = zip->getCurrentFileName();
 #ifdef Q_OS_WIN
@@ -301,11 +382,14 @@ std::optional<QStringList> extractSubDir(QuaZip* zip, const QString& subdir, con
         if (relative_file_name.startsWith('/'))
             relative_file_name = relative_file_name.mid(1);
 
+        if (filter && !filter(relative_file_name))
+            continue;
+
         // Fix weird "folders with a single file get squashed" thing
         QString sub_path;
         if (relative_file_name.contains('/') && !relative_file_name.endsWith('/')) {
             sub_path = relative_file_name.section('/', 0, -2) + '/';
-            FS::ensureFolderPathExists(FS::PathCombine(target, sub_path));
+            folders.insert(FS::PathCombine(target, sub_path));
 
             relative_file_name = relative_file_name.split('/').last();
         }
@@ -325,18 +409,76 @@ std::optional<QStringList> extractSubDir(QuaZip* zip, const QString& subdir, con
             return std::nullopt;
         }
 
-        if (!JlCompress::extractFile(zip, "", target_file_path)) {
-            qWarning() << "Failed to extract file" << original_name << "to" << target_file_path;
-            JlCompress::removeFile(extracted);
+        PlannedEntry entry{ {}, original_name, target_file_path };
+        if (unzGetFilePos64(zip->getUnzFile(), &entry.pos) != UNZ_OK) {
+            qWarning() << "Failed to locate file" << original_name << "in the archive";
             return std::nullopt;
         }
+        plan.push_back(entry);
+    } while (zip->goToNextFile());
+
+    for (auto& folder : folders)
+        FS::ensureFolderPathExists(folder);
 
-        extracted.append(target_file_path);
-        QFile::setPermissions(target_file_path,
+    auto extractEntry = [](QuaZip* from, PlannedEntry& entry) {
+        // QuaZip only lets QuaZipFile open the current file if it thinks there is one
+        if ((!from->hasCurrentFile() && !from->goToFirstFile()) || unzGoToFilePos64(from->getUnzFile(), &entry.pos) != UNZ_OK)
+            return false;
+        if (!JlCompress::extractFile(from, "", entry.target_file_path)) {
+            qWarning() << "Failed to extract file" << entry.original_name << "to" << entry.target_file_path;
+            return false;
+        }
+        QFile::setPermissions(entry.target_file_path,
                               QFileDevice::Permission::ReadUser | QFileDevice::Permission::WriteUser | QFileDevice::Permission::ExeUser);
+        entry.done = true;
+        return true;
+    };
 
-        qDebug() << "Extracted file" << relative_file_name << "to" << target_file_path;
-    } while (zip->goToNextFile());
+    // Archives on disk are split into runs of entries, each extracted by a thread with its own handle on the file, so
+    // large packs aren't bound to one core. A handful of entries, or an archive that isn't a file, isn't worth it.
+    constexpr size_t ENTRIES_PER_WORKER = 32;
+    auto workers = std::min<size_t>(std::clamp(QThread::idealThreadCount(), 1, 8), plan.size() / ENTRIES_PER_WORKER);
+    bool ok = true;
+    if (workers <= 1 || zip->getZipName().isEmpty()) {
+        for (auto& entry : plan) {
+            if (!extractEntry(zip, entry)) {
+                ok = false;
+                break;
+            }
+        }
+    } else {
+        std::atomic<bool> failed{ false };
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < workers; i++) {
+            auto begin = plan.begin() + plan.size() * i / workers;
+            auto end = plan.begin() + plan.size() * (i + 1) / workers;
+            threads.emplace_back([&, begin, end] {
+                QuaZip handle(zip->getZipName());
+                if (!handle.open(QuaZip::mdUnzip)) {
+                    qWarning() << "Could not open archive for unzipping:" << zip->getZipName() << "Error:" << handle.getZipError();
+                    failed = true;
+                    return;
+                }
+                for (auto it = begin; it != end && !failed; ++it) {
+                    if (!extractEntry(&handle, *it))
+                        failed = true;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        ok = !failed;
+    }
+
+    for (auto& entry : plan) {
+        if (entry.done)
+            extracted.append(entry.target_file_path);
+    }
+    if (!ok) {
+        JlCompress::removeFile(extracted);
+        return std::nullopt;
+    }
+    qDebug() << "Extracted" << extracted.size() << "files to" << target;
 
     return extracted;
 }
@@ -434,11 +576,115 @@ bool collectFileListRecursively(const QString& rootDir, const QString& subDir, Q
 }
 
 #if defined(LAUNCHER_APPLICATION)
+namespace {
+// files this big are compressed by the writer while it streams them, so they are never held in memory whole
+constexpr qint64 PARALLEL_ENTRY_LIMIT = 64 * 1024 * 1024;
+// how many bytes of source files may be read and waiting to be written at once
+constexpr qint64 PARALLEL_BYTES_IN_FLIGHT = 256 * 1024 * 1024;
+
+struct CompressedEntry {
+    QByteArray data;
+    quint32 crc = 0;
+    qint64 size = 0;
+    bool stored = true;
+    bool ok = false;
+    // the previous export has this file as it is, so its entry can be copied instead
+    bool unchanged = false;
+};
+
+// reads a file and deflates it into a raw stream, which the writer puts in the zip as it is
+CompressedEntry compressEntry(const QString& path, bool store, std::optional<quint32> previousCrc)
+{
+    CompressedEntry entry;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return entry;
+    auto bytes = file.readAll();
+    if (file.error() != QFileDevice::NoError)
+        return entry;
+
+    entry.size = bytes.size();
+    entry.crc = crc32(crc32(0, nullptr, 0), reinterpret_cast<const Bytef*>(bytes.constData()), bytes.size());
+    entry.ok = true;
+
+    // the caller only passes a crc when the sizes match already
+    if (previousCrc && *previousCrc == entry.crc) {
+        entry.unchanged = true;
+        return entry;
+    }
+
+    if (!store && !bytes.isEmpty()) {
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK) {
+            QByteArray deflated(deflateBound(&zs, bytes.size()), Qt::Uninitialized);
+            zs.next_in = reinterpret_cast<Bytef*>(bytes.data());
+            zs.avail_in = bytes.size();
+            zs.next_out = reinterpret_cast<Bytef*>(deflated.data());
+            zs.avail_out = deflated.size();
+            auto ret = deflate(&zs, Z_FINISH);
+            deflated.resize(zs.total_out);
+            deflateEnd(&zs);
+            // keep the original when deflate doesn't make it smaller
+            if (ret == Z_STREAM_END && deflated.size() < bytes.size()) {
+                entry.data = std::move(deflated);
+                entry.stored = false;
+                return entry;
+            }
+        }
+    }
+    entry.data = std::move(bytes);
+    return entry;
+}
+
+// for files too big to hold in memory: only tells whether the previous export has the file as it is, by streaming it through crc32
+CompressedEntry checkUnchanged(const QString& path, quint32 previousCrc)
+{
+    CompressedEntry entry;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return entry;
+
+    auto crc = crc32(0, nullptr, 0);
+    QByteArray buffer(1024 * 1024, Qt::Uninitialized);
+    qint64 read;
+    while ((read = file.read(buffer.data(), buffer.size())) > 0) {
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(buffer.constData()), read);
+        entry.size += read;
+    }
+    if (read < 0)
+        return entry;
+
+    entry.crc = crc;
+    entry.ok = true;
+    entry.unchanged = crc == previousCrc;
+    return entry;
+}
+
+bool writeCompressedEntry(QuaZip* zip, const QString& name, const QString& source, const CompressedEntry& entry)
+{
+    QuaZipNewInfo info(name, source);
+    info.uncompressedSize = entry.size;
+    QuaZipFile file(zip);
+    if (!file.open(QIODevice::WriteOnly, info, nullptr, entry.crc, entry.stored ? 0 : Z_DEFLATED, Z_DEFAULT_COMPRESSION, true))
+        return false;
+    if (file.write(entry.data) != entry.data.size())
+        return false;
+    // raw entries are closed with the crc and size given to open()
+    file.close();
+    return file.getZipError() == ZIP_OK;
+}
+}  // namespace
+
 void ExportToZipTask::executeTask()
 {
     setStatus("Adding files...");
     setProgress(0, m_files.length());
-    m_build_zip_future = QtConcurrent::run(QThreadPool::globalInstance(), [this]() { return exportZip(); });
+    m_build_zip_future = QtConcurrent::run(QThreadPool::globalInstance(), [this]() {
+        // the entries are compressed on the executor, which already makes way for a running game
+        CpuExecutor::YieldToGame yield;
+        return exportZip();
+    });
     connect(&m_build_zip_watcher, &QFutureWatcher<ZipResult>::finished, this, &ExportToZipTask::finish);
     m_build_zip_watcher.setFuture(m_build_zip_future);
 }
@@ -448,6 +694,29 @@ auto ExportToZipTask::exportZip() -> ZipResult
     if (!m_dir.exists()) {
         return ZipResult(tr("Folder doesn't exist"));
     }
+
+    // An earlier export at the output path is moved aside, so its entries can still be read while the new one is written
+    auto previousPath = m_previous_path;
+    if (!previousPath.isEmpty() && QFileInfo(previousPath).isFile() && QFileInfo(previousPath) == QFileInfo(m_output_path)) {
+        auto moved = m_output_path + ".previous";
+        QFile::remove(moved);
+        if (QFile::rename(m_output_path, moved))
+            m_moved_previous_path = previousPath = moved;
+        else
+            previousPath.clear();
+    }
+    QuaZip previous(previousPath);
+    std::unique_ptr<EntryIndex> previousIndex;
+    QHash<QString, QuaZipFileInfo64> previousEntries;
+    if (!previousPath.isEmpty() && QFileInfo(previousPath).isFile() && previous.open(QuaZip::mdUnzip)) {
+        previousIndex = std::make_unique<EntryIndex>(&previous);
+        for (auto& info : previous.getFileInfoList64()) {
+            // encrypted entries can't be copied over as they are
+            if (!(info.flags & 0x1))
+                previousEntries.insert(info.name, info);
+        }
+    }
+
     if (!m_output.isOpen() && !m_output.open(QuaZip::mdCreate)) {
         return ZipResult(tr("Could not create file"));
     }
@@ -462,24 +731,97 @@ auto ExportToZipTask::exportZip() -> ZipResult
         indexFile.write(m_extra_files[fileName]);
     }
 
+    // The files are read and deflated on the CpuExecutor, a few ahead of this thread, which writes them to the zip in order.
+    // Big files are streamed in here instead, so the memory in use stays bounded.
+    struct Pending {
+        QString absolute;
+        QString relative;
+        qint64 size;
+        QFuture<CompressedEntry> entry;
+        bool streamed = false;
+    };
+    std::deque<Pending> pending;
+    qint64 bytesInFlight = 0;
+    const auto maxPending = static_cast<size_t>(std::max(2, CpuExecutor::maxThreadCount() * 2));
+
+    auto writeNext = [this, &pending, &bytesInFlight, &previous, &previousIndex, &previousEntries]() -> ZipResult {
+        auto next = std::move(pending.front());
+        pending.pop_front();
+        if (!next.streamed)
+            bytesInFlight -= next.size;
+
+        setStatus("Compressing: " + next.relative);
+        setProgress(m_progress + 1, m_progressTotal);
+        auto name = m_destination_prefix + next.relative;
+        CompressedEntry entry;
+        if (next.entry.isValid())
+            entry = next.entry.result();
+
+        bool written = false;
+        if (entry.unchanged && static_cast<qint64>(previousEntries.value(name).uncompressedSize) == entry.size &&
+            previousIndex->setCurrentFile(name)) {
+            QuaZipFile in(&previous);
+            QuaZipFile out(&m_output);
+            written = copyRawEntry(previousEntries.value(name), in, out);
+        }
+        if (!written) {
+            // when the previous entry couldn't be copied after all, there's no compressed data for it either
+            if (next.streamed || entry.unchanged)
+                written = compressFile(&m_output, next.absolute, name);
+            else
+                written = entry.ok && writeCompressedEntry(&m_output, name, next.absolute, entry);
+        }
+        if (!written)
+            return ZipResult(tr("Could not read and compress %1").arg(next.relative));
+        return ZipResult();
+    };
+
     for (const QFileInfo& file : m_files) {
         if (m_build_zip_future.isCanceled())
             return ZipResult();
 
         auto absolute = file.absoluteFilePath();
         auto relative = m_dir.relativeFilePath(absolute);
-        setStatus("Compressing: " + relative);
-        setProgress(m_progress + 1, m_progressTotal);
         if (m_follow_symlinks) {
             if (file.isSymLink())
                 absolute = file.symLinkTarget();
             else
                 absolute = file.canonicalFilePath();
         }
+        if (m_exclude_files.contains(relative)) {
+            setProgress(m_progress + 1, m_progressTotal);
+            continue;
+        }
+
+        Pending next{ absolute, relative, file.size(), {} };
+        next.streamed = next.size >= PARALLEL_ENTRY_LIMIT;
+
+        std::optional<quint32> previousCrc;
+        if (auto it = previousEntries.constFind(m_destination_prefix + relative);
+            it != previousEntries.constEnd() && static_cast<qint64>(it->uncompressedSize) == next.size)
+            previousCrc = it->crc;
 
-        if (!m_exclude_files.contains(relative) && !JlCompress::compressFile(&m_output, absolute, m_destination_prefix + relative)) {
-            return ZipResult(tr("Could not read and compress %1").arg(relative));
+        while (!pending.empty() &&
+               (pending.size() >= maxPending || (!next.streamed && bytesInFlight + next.size > PARALLEL_BYTES_IN_FLIGHT))) {
+            if (auto result = writeNext(); result.has_value())
+                return result;
         }
+        if (!next.streamed) {
+            bool store = isCompressedFormat(relative);
+            next.entry = CpuExecutor::run(CpuExecutor::Priority::Bulk,
+                                          [absolute, store, previousCrc] { return compressEntry(absolute, store, previousCrc); });
+            bytesInFlight += next.size;
+        } else if (previousCrc) {
+            auto crc = *previousCrc;
+            next.entry = CpuExecutor::run(CpuExecutor::Priority::Bulk, [absolute, crc] { return checkUnchanged(absolute, crc); });
+        }
+        pending.push_back(std::move(next));
+    }
+    while (!pending.empty()) {
+        if (m_build_zip_future.isCanceled())
+            return ZipResult();
+        if (auto result = writeNext(); result.has_value())
+            return result;
     }
 
     m_output.close();
@@ -491,13 +833,23 @@ auto ExportToZipTask::exportZip() -> ZipResult
 
 void ExportToZipTask::finish()
 {
+    // the earlier export moved aside comes back if there is nothing to replace it
+    auto restorePrevious = [this] {
+        if (!m_moved_previous_path.isEmpty())
+            QFile::rename(m_moved_previous_path, m_output_path);
+    };
+
     if (m_build_zip_future.isCanceled()) {
         QFile::remove(m_output_path);
+        restorePrevious();
         emitAborted();
     } else if (auto result = m_build_zip_future.result(); result.has_value()) {
         QFile::remove(m_output_path);
+        restorePrevious();
         emitFailed(result.value());
     } else {
+        if (!m_moved_previous_path.isEmpty())
+            QFile::remove(m_moved_previous_path);
         emitSucceeded();
     }
 }
@@ -514,4 +866,189 @@ bool ExportToZipTask::abort()
 }
 #endif
 
+EntryIndex::EntryIndex(QuaZip* zip) : m_zip(zip)
+{
+    for (bool more = zip->goToFirstFile(); more; more = zip->goToNextFile()) {
+        auto name = zip->getCurrentFileName();
+
+        unz64_file_pos pos;
+        if (unzGetFilePos64(zip->getUnzFile(), &pos) != UNZ_OK)
+            continue;
+
+        m_names.append(name);
+        m_entries.insert(name, pos);
+#if defined(Q_OS_WIN)
+        m_folded_names.insert(name.toLower(), name);
+#endif
+
+        // Archives don't need to have entries for directories, so derive them from the file paths
+        for (auto slash = name.indexOf('/'); slash > 0; slash = name.indexOf('/', slash + 1))
+            m_dirs.insert(name.left(slash));
+    }
+}
+
+auto EntryIndex::find(const QString& name) const -> QHash<QString, unz64_file_pos>::const_iterator
+{
+    auto it = m_entries.constFind(name);
+#if defined(Q_OS_WIN)
+    if (it == m_entries.constEnd()) {
+        auto folded = m_folded_names.constFind(name.toLower());
+        if (folded != m_folded_names.constEnd())
+            it = m_entries.constFind(folded.value());
+    }
+#endif
+    return it;
+}
+
+bool EntryIndex::contains(const QString& name) const
+{
+    return find(name) != m_entries.constEnd();
+}
+
+bool EntryIndex::containsDir(const QString& dir) const
+{
+    auto path = dir;
+    while (path.startsWith('/'))
+        path.remove(0, 1);
+    while (path.endsWith('/'))
+        path.chop(1);
+
+    return path.isEmpty() ? !m_names.isEmpty() : m_dirs.contains(path);
+}
+
+std::optional<QString> EntryIndex::findFolderOf(const QString& what, const QStringList& ignore_paths) const
+{
+    std::optional<QString> found;
+    int foundDepth = 0;
+    for (auto& name : m_names) {
+        if (!(name == what || name.endsWith('/' + what)))
+            continue;
+        auto folder = name.left(name.size() - what.size());
+        auto depth = folder.count('/');
+        if (found && (depth > foundDepth || (depth == foundDepth && folder >= *found)))
+            continue;
+        // ignored folders are matched by name at any depth, with their trailing slash
+        const auto parts = folder.split('/', Qt::SkipEmptyParts);
+        if (std::any_of(parts.begin(), parts.end(), [&](const QString& part) { return ignore_paths.contains(part + '/'); }))
+            continue;
+        found = folder;
+        foundDepth = depth;
+    }
+    return found;
+}
+
+bool EntryIndex::setCurrentFile(const QString& name)
+{
+    auto it = find(name);
+    if (it == m_entries.constEnd())
+        return false;
+
+    // QuaZip only lets QuaZipFile open the current file if it thinks there is one, which isn't the case after
+    // the scan went past the last entry. Going to the first file is cheap, and keeps its state consistent.
+    if (!m_zip->hasCurrentFile() && !m_zip->goToFirstFile())
+        return false;
+
+    auto pos = it.value();
+    return unzGoToFilePos64(m_zip->getUnzFile(), &pos) == UNZ_OK;
+}
+
+namespace {
+constexpr quint32 END_OF_DIRECTORY_SIGNATURE = 0x06054b50;
+constexpr quint32 ZIP64_END_OF_DIRECTORY_SIGNATURE = 0x06064b50;
+constexpr quint32 ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+constexpr quint32 DIRECTORY_ENTRY_SIGNATURE = 0x02014b50;
+constexpr int END_OF_DIRECTORY_SIZE = 22;
+constexpr int ZIP64_LOCATOR_SIZE = 20;
+constexpr int ZIP64_END_OF_DIRECTORY_SIZE = 56;
+constexpr int DIRECTORY_ENTRY_SIZE = 46;
+
+template <typename T>
+T readLE(const QByteArray& data, qint64 at)
+{
+    return qFromLittleEndian<T>(data.constData() + at);
+}
+}  // namespace
+
+bool findCentralDirectory(const QByteArray& tail, qint64 archiveSize, qint64& offset, qint64& size)
+{
+    const qint64 tailOffset = archiveSize - tail.size();
+    // the record is followed by its comment only, so the last signature that has room for the record is it
+    for (qint64 at = tail.size() - END_OF_DIRECTORY_SIZE; at >= 0; at--) {
+        if (readLE<quint32>(tail, at) != END_OF_DIRECTORY_SIGNATURE)
+            continue;
+        if (at + END_OF_DIRECTORY_SIZE + readLE<quint16>(tail, at + 20) != tail.size())
+            continue;
+
+        size = readLE<quint32>(tail, at + 12);
+        offset = readLE<quint32>(tail, at + 16);
+        if (size != 0xFFFFFFFF && offset != 0xFFFFFFFF)
+            return offset + size <= tailOffset + at;
+
+        // ZIP64 keeps the real values in a record of its own, which a locator right before this one points to
+        auto locator = at - ZIP64_LOCATOR_SIZE;
+        if (locator < 0 || readLE<quint32>(tail, locator) != ZIP64_LOCATOR_SIGNATURE)
+            return false;
+        auto record = static_cast<qint64>(readLE<quint64>(tail, locator + 8)) - tailOffset;
+        if (record < 0 || record + ZIP64_END_OF_DIRECTORY_SIZE > locator || readLE<quint32>(tail, record) != ZIP64_END_OF_DIRECTORY_SIGNATURE)
+            return false;
+        size = static_cast<qint64>(readLE<quint64>(tail, record + 40));
+        offset = static_cast<qint64>(readLE<quint64>(tail, record + 48));
+        return offset >= 0 && size >= 0 && offset + size <= tailOffset + record;
+    }
+    return false;
+}
+
+std::optional<QList<EntrySpan>> readEntrySpans(const QByteArray& directory, qint64 directoryOffset)
+{
+    QList<EntrySpan> spans;
+    for (qint64 at = 0; at + DIRECTORY_ENTRY_SIZE <= directory.size();) {
+        if (readLE<quint32>(directory, at) != DIRECTORY_ENTRY_SIGNATURE)
+            break;
+        auto compressedSize = readLE<quint32>(directory, at + 20);
+        auto uncompressedSize = readLE<quint32>(directory, at + 24);
+        auto nameLength = readLE<quint16>(directory, at + 28);
+        auto extraLength = readLE<quint16>(directory, at + 30);
+        auto commentLength = readLE<quint16>(directory, at + 32);
+        qint64 localOffset = readLE<quint32>(directory, at + 42);
+        auto extra = at + DIRECTORY_ENTRY_SIZE + nameLength;
+        auto next = extra + extraLength + commentLength;
+        if (next > directory.size())
+            return std::nullopt;
+
+        if (localOffset == 0xFFFFFFFF) {
+            // the ZIP64 extra field has the sizes that didn't fit first, then the offset
+            for (auto field = extra; field + 4 <= extra + extraLength;) {
+                auto id = readLE<quint16>(directory, field);
+                auto length = readLE<quint16>(directory, field + 2);
+                if (id == 0x0001) {
+                    auto value = field + 4 + (uncompressedSize == 0xFFFFFFFF ? 8 : 0) + (compressedSize == 0xFFFFFFFF ? 8 : 0);
+                    if (value + 8 > field + 4 + length)
+                        return std::nullopt;
+                    localOffset = static_cast<qint64>(readLE<quint64>(directory, value));
+                    break;
+                }
+                field += 4 + length;
+            }
+        }
+        if (localOffset < 0 || localOffset >= directoryOffset)
+            return std::nullopt;
+
+        spans.append({ localOffset, directoryOffset });
+        at = next;
+    }
+
+    // entries end where the next one in the file starts, which doesn't have to be the next one in the directory
+    QList<qint64> starts;
+    starts.reserve(spans.size());
+    for (auto& span : spans)
+        starts.append(span.begin);
+    std::sort(starts.begin(), starts.end());
+    for (auto& span : spans) {
+        auto next = std::upper_bound(starts.begin(), starts.end(), span.begin);
+        if (next != starts.end())
+            span.end = *next;
+    }
+    return spans;
+}
+
 }  // namespace MMCZip
@@ -107,8 +107,9 @@ bool findFilesInZip(QuaZip* zip, const QString& what, QStringList& result, const
 
 /**
  * Extract a subdirectory from an archive
+ * \param filter if given, only the entries it returns true for are extracted; it gets their path relative to subdir
  */
-std::optional<QStringList> extractSubDir(QuaZip* zip, const QString& subdir, const QString& target);
+std::optional<QStringList> extractSubDir(QuaZip* zip, const QString& subdir, const QString& target, const FilterFunction& filter = nullptr);
 
 bool extractRelFile(QuaZip* zip, const QString& file, const QString& target);
 
@@ -151,6 +152,67 @@ bool extractFile(QString fileCompressed, QString file, QString dir);
  */
 bool collectFileListRecursively(const QString& rootDir, const QString& subDir, QFileInfoList* files, FilterFunction excludeFilter);
 
+/**
+ * Index of the entries of an open archive, built with a single pass over its central directory.
+ *
+ * QuaZip::setCurrentFile and QuaZipDir scan the whole central directory on every call, which adds up
+ * quickly on jars with thousands of entries. Lookups here are hash lookups, and selecting an entry
+ * jumps straight to it.
+ */
+class EntryIndex {
+   public:
+    explicit EntryIndex(QuaZip* zip);
+
+    bool contains(const QString& name) const;
+    /* Whether any entry lives under the given directory, like QuaZipDir::exists on an absolute path. */
+    bool containsDir(const QString& dir) const;
+    QStringList fileNames() const { return m_names; }
+    /* The folder, ending in a slash, holding the least nested file of that name outside the ignored folders; like findFolderOfFileInZip. */
+    std::optional<QString> findFolderOf(const QString& what, const QStringList& ignore_paths = {}) const;
+
+    QuaZip* zip() const { return m_zip; }
+
+    /* Makes the entry the zip's current file, as QuaZip::setCurrentFile would. */
+    bool setCurrentFile(const QString& name);
+
+   private:
+    auto find(const QString& name) const -> QHash<QString, unz64_file_pos>::const_iterator;
+
+    QuaZip* m_zip;
+    QStringList m_names;
+    QHash<QString, unz64_file_pos> m_entries;
+    QSet<QString> m_dirs;
+#if defined(Q_OS_WIN)
+    // Lowercase names to real names, since QuaZip matches names case-insensitively on Windows by default
+    QHash<QString, QString> m_folded_names;
+#endif
+};
+
+/** Where an entry is in an archive: from its local header to where the next entry, or the central directory, starts. */
+struct EntrySpan {
+    qint64 begin = 0;
+    qint64 end = 0;
+};
+
+/* How many bytes from its end the central directory of an archive is found within, at the most; the size of the end of
+ * central directory record with the longest comment it can have. */
+constexpr qint64 END_OF_DIRECTORY_SEARCH = 22 + 0xFFFF;
+
+/**
+ * Finds the central directory of an archive from its last bytes, for archives that aren't all there yet.
+ * \param tail the last bytes of the archive, END_OF_DIRECTORY_SEARCH of them or all of it if it's smaller
+ * \param archiveSize the size of the whole archive
+ * \return false if tail has no end of central directory record, or a ZIP64 one that isn't in tail
+ */
+bool findCentralDirectory(const QByteArray& tail, qint64 archiveSize, qint64& offset, qint64& size);
+
+/**
+ * Reads the spans of the entries from the central directory, in its order; the same order QuaZip and EntryIndex go in.
+ * \param directory all of the central directory
+ * \param directoryOffset where the directory starts in the archive, which is where the last entry ends
+ */
+std::optional<QList<EntrySpan>> readEntrySpans(const QByteArray& directory, qint64 directoryOffset);
+
 #if defined(LAUNCHER_APPLICATION)
 class ExportToZipTask : public Task {
    public:
@@ -182,6 +244,9 @@ class ExportToZipTask : public Task {
 
     void setExcludeFiles(QStringList excludeFiles) { m_exclude_files = excludeFiles; }
     void addExtraFile(QString fileName, QByteArray data) { m_extra_files.insert(fileName, data); }
+    /* Entries of this earlier export are copied over as they are when their file didn't change, instead of being compressed again.
+     * It may be the output path itself. */
+    void setPreviousArchive(QString path) { m_previous_path = path; }
 
     using ZipResult = std::optional<QString>;
 
@@ -201,6 +266,9 @@ class ExportToZipTask : public Task {
     bool m_follow_symlinks;
     QStringList m_exclude_files;
     QHash<QString, QByteArray> m_extra_files;
+    QString m_previous_path;
+    // where an earlier export at the output path was moved to while it is read
+    QString m_moved_previous_path;
 
     QFuture<ZipResult> m_build_zip_future;
     QFutureWatcher<ZipResult> m_build_zip_watcher;
@@ -0,0 +1,129 @@
+#include "MTPixmapCache.h"
+
+#include <QMutexLocker>
+#include <QtGlobal>
+
+#include <sys.h>
+
+#include "Metrics.h"
+
+namespace {
+// out of every 100 bytes of the total, by consumer; screenshot thumbnails are 16 times the size of an icon
+constexpr int SHARES[] = { 25, 10, 5, 60 };
+constexpr qint64 MIN_TOTAL = 32 * 1024 * 1024;
+constexpr qint64 MAX_TOTAL = 256 * 1024 * 1024;
+
+qint64 costOf(const QPixmap& pixmap)
+{
+    return qMax<qint64>(1, qint64(pixmap.width()) * pixmap.height() * qMax(1, pixmap.depth()) / 8);
+}
+}  // namespace
+
+PixmapCache& PixmapCache::instance()
+{
+    static PixmapCache s_instance;
+    return s_instance;
+}
+
+PixmapCache::PixmapCache()
+{
+    // a 128th of the memory: 128 MiB with 16 GiB, about 8000 icons at 64x64 in all
+    setTotalBudget(qBound(MIN_TOTAL, qint64(Sys::getSystemRam() / 128), MAX_TOTAL));
+}
+
+void PixmapCache::setTotalBudget(qint64 total)
+{
+    for (int consumer = 0; consumer < CONSUMERS; consumer++) {
+        auto budget = total / 100 * SHARES[consumer];
+        m_budgets[consumer] = budget;
+        for (auto& shard : m_shards[consumer]) {
+            QMutexLocker locker(&shard.lock);
+            shard.budget = budget / SHARDS;
+            shard.evictOverBudget();
+        }
+    }
+}
+
+qint64 PixmapCache::budget(Consumer consumer)
+{
+    return instance().m_budgets[int(consumer)];
+}
+
+PixmapCache::Shard& PixmapCache::shardFor(const Key& key)
+{
+    return m_shards[int(key.consumer)][key.id % SHARDS];
+}
+
+void PixmapCache::Shard::evictOverBudget()
+{
+    while (cost > budget && !entries.empty()) {
+        auto& last = entries.back();
+        cost -= last.cost;
+        index.erase(last.id);
+        entries.pop_back();
+        Metrics::count("pixmapcache.evictions");
+    }
+}
+
+PixmapCache::Key PixmapCache::insert(Consumer consumer, const QPixmap& pixmap)
+{
+    auto& cache = instance();
+    Key key{ cache.m_nextId++, consumer };
+    auto& shard = cache.shardFor(key);
+    auto cost = costOf(pixmap);
+
+    QMutexLocker locker(&shard.lock);
+    if (cost > shard.budget) {
+        return {};
+    }
+    shard.entries.push_front({ key.id, pixmap, cost });
+    shard.index[key.id] = shard.entries.begin();
+    shard.cost += cost;
+    shard.evictOverBudget();
+    return key;
+}
+
+bool PixmapCache::find(const Key& key, QPixmap* pixmap)
+{
+    if (!key.isValid()) {
+        return false;
+    }
+    auto& shard = instance().shardFor(key);
+    QMutexLocker locker(&shard.lock);
+    auto it = shard.index.find(key.id);
+    if (it == shard.index.end()) {
+        Metrics::count("pixmapcache.misses");
+        return false;
+    }
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    *pixmap = it->second->pixmap;
+    return true;
+}
+
+void PixmapCache::remove(const Key& key)
+{
+    if (!key.isValid()) {
+        return;
+    }
+    auto& shard = instance().shardFor(key);
+    QMutexLocker locker(&shard.lock);
+    auto it = shard.index.find(key.id);
+    if (it == shard.index.end()) {
+        return;
+    }
+    shard.cost -= it->second->cost;
+    shard.entries.erase(it->second);
+    shard.index.erase(it);
+}
+
+void PixmapCache::clear()
+{
+    for (auto& consumer : instance().m_shards) {
+        for (auto& shard : consumer) {
+            QMutexLocker locker(&shard.lock);
+            shard.entries.clear();
+            shard.index.clear();
+            shard.cost = 0;
+        }
+    }
+}
@@ -24,9 +24,11 @@ MessageLevel::Enum MessageLevel::getLevel(const QString& levelName)
 
 MessageLevel::Enum MessageLevel::fromLine(QString& line)
 {
-    // Level prefix
-    int endmark = line.indexOf("]!");
-    if (line.startsWith("!![") && endmark != -1) {
+    // Level prefix, most lines don't have one so check the cheap part first
+    if (!line.startsWith("!!["))
+        return MessageLevel::Unknown;
+    int endmark = line.indexOf("]!", 3);
+    if (endmark != -1) {
         auto level = MessageLevel::getLevel(line.left(endmark).mid(3));
         line = line.mid(endmark + 2);
         return level;
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "Metrics.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace Metrics {
+
+namespace {
+
+struct Histogram {
+    // upper bounds are 1, 2, 4, ... 2^(BUCKETS - 2), and the last bucket takes everything above
+    static constexpr int BUCKETS = 32;
+
+    qint64 count = 0;
+    double sum = 0.;
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    std::array<qint64, BUCKETS> buckets{};
+
+    void add(double value)
+    {
+        count++;
+        sum += value;
+        min = qMin(min, value);
+        max = qMax(max, value);
+
+        int bucket = value <= 1. ? 0 : static_cast<int>(std::ceil(std::log2(value)));
+        buckets[qMin(bucket, BUCKETS - 1)]++;
+    }
+
+    QJsonObject toJson() const
+    {
+        QJsonObject bucket_counts;
+        for (int i = 0; i < BUCKETS; i++) {
+            if (buckets[i] == 0)
+                continue;
+            auto bound = i == BUCKETS - 1 ? QString("inf") : QString::number(qint64(1) << i);
+            bucket_counts[bound] = buckets[i];
+        }
+        return {
+            { "count", count }, { "sum", sum }, { "mean", count ? sum / count : 0. }, { "min", min }, { "max", max }, { "buckets", bucket_counts },
+        };
+    }
+};
+
+struct Registry {
+    QMutex mutex;
+    QHash<QString, qint64> counters;
+    QHash<QString, Histogram> histograms;
+};
+
+Registry& registry()
+{
+    static Registry s_registry;
+    return s_registry;
+}
+
+}  // namespace
+
+void count(const QString& name, qint64 by)
+{
+    auto& reg = registry();
+    QMutexLocker locker(&reg.mutex);
+    reg.counters[name] += by;
+}
+
+void observe(const QString& name, double value)
+{
+    auto& reg = registry();
+    QMutexLocker locker(&reg.mutex);
+    reg.histograms[name].add(value);
+}
+
+QJsonObject snapshot()
+{
+    auto& reg = registry();
+    QMutexLocker locker(&reg.mutex);
+
+    QJsonObject out;
+    for (auto it = reg.counters.cbegin(); it != reg.counters.cend(); it++)
+        out[it.key()] = it.value();
+    for (auto it = reg.histograms.cbegin(); it != reg.histograms.cend(); it++)
+        out[it.key()] = it.value().toJson();
+    return out;
+}
+
+void reset()
+{
+    auto& reg = registry();
+    QMutexLocker locker(&reg.mutex);
+    reg.counters.clear();
+    reg.histograms.clear();
+}
+
+}  // namespace Metrics
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+/** A launcher-wide registry of named counters and histograms.
+ *
+ *  Meant for numbers that only make sense in aggregate, like how often the metadata cache saves us a
+ *  download, or how fast each host serves us. Everything lives in memory until the launcher exits.
+ *  All the functions are thread-safe.
+ */
+namespace Metrics {
+
+/* Adds by to the named counter. */
+void count(const QString& name, qint64 by = 1);
+
+/* Adds a sample to the named histogram. */
+void observe(const QString& name, double value);
+
+/** Everything recorded so far.
+ *
+ *  Counters map to their value. Histograms map to an object with their count, sum, mean, min, max,
+ *  and how many samples fell at or under each power of two ("buckets").
+ */
+QJsonObject snapshot();
+
+void reset();
+
+}  // namespace Metrics
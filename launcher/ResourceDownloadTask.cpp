@@ -53,7 +53,9 @@ ResourceDownloadTask::ResourceDownloadTask(ModPlatform::IndexedPack::Ptr pack,
         }
     }
 
-    m_filesNetJob->addNetAction(Net::ApiDownload::makeFile(m_pack_version.downloadUrl, dir.absoluteFilePath(getFilename())));
+    // resources are shared between instances through the content store, when the platform gives us a usable hash
+    m_filesNetJob->addNetAction(Net::ApiDownload::makeStored(m_pack_version.downloadUrl, dir.absoluteFilePath(getFilename()),
+                                                             m_pack_version.hash_type, m_pack_version.hash));
     connect(m_filesNetJob.get(), &NetJob::succeeded, this, &ResourceDownloadTask::downloadSucceeded);
     connect(m_filesNetJob.get(), &NetJob::progress, this, &ResourceDownloadTask::downloadProgressChanged);
     connect(m_filesNetJob.get(), &NetJob::stepProgress, this, &ResourceDownloadTask::propagateStepProgress);
@@ -0,0 +1,281 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "SamplingProfiler.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QHash>
+#include <QMetaEnum>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FileSystem.h"
+
+namespace SamplingProfiler {
+
+namespace {
+
+constexpr auto SAMPLE_INTERVAL = std::chrono::milliseconds(10);
+// how often the GUI thread is asked how long it takes to get to a posted event
+constexpr int PROBE_EVERY_SAMPLES = 10;
+// handlers, and posted events waited for, longer than this are what makes the launcher feel slow
+constexpr qint64 SLOW_MS = 50;
+constexpr int SUMMARY_LINES = 10;
+
+std::atomic<bool> s_enabled = false;
+
+struct Frame {
+    const char* className;
+    int eventType;
+    qint64 start;
+    // spent in the handlers this one ran into, they get the blame for that time
+    qint64 childMs = 0;
+};
+
+struct HandlerStats {
+    quint64 count = 0;
+    qint64 totalMs = 0;
+    qint64 maxMs = 0;
+};
+
+struct Profiler {
+    std::mutex mutex;
+    QString path;
+    QElapsedTimer clock;
+    QThread* guiThread = nullptr;
+
+    // the GUI thread's handlers, innermost last
+    std::vector<Frame> stack;
+    QHash<const void*, QString> tasks;
+
+    QHash<QString, quint64> samples;
+    QHash<QString, HandlerStats> slowHandlers;
+
+    std::atomic<bool> probePending = false;
+    quint64 probes = 0;
+    quint64 slowProbes = 0;
+    qint64 totalLatencyMs = 0;
+    qint64 maxLatencyMs = 0;
+
+    std::thread sampler;
+    std::condition_variable wakeUp;
+    bool stopping = false;
+};
+
+Profiler& profiler()
+{
+    static Profiler s_profiler;
+    return s_profiler;
+}
+
+QString eventName(int type)
+{
+    static const auto types = QMetaEnum::fromType<QEvent::Type>();
+    auto key = types.valueToKey(type);
+    return key ? QString::fromLatin1(key) : QString::number(type);
+}
+
+QString frameName(const Frame& frame)
+{
+    return QString::fromLatin1(frame.className) + "::" + eventName(frame.eventType);
+}
+
+// the collapsed format splits frames at ';' and the count off at the last space
+QString collapsedFrame(QString name)
+{
+    return name.replace(';', ':').replace('\n', ' ');
+}
+
+void probe(Profiler& prof)
+{
+    if (prof.probePending.exchange(true))
+        return;
+    qint64 posted;
+    {
+        std::lock_guard<std::mutex> lock(prof.mutex);
+        posted = prof.clock.elapsed();
+    }
+    QMetaObject::invokeMethod(
+        QCoreApplication::instance(),
+        [&prof, posted] {
+            std::lock_guard<std::mutex> lock(prof.mutex);
+            auto latency = prof.clock.elapsed() - posted;
+            prof.probes++;
+            prof.totalLatencyMs += latency;
+            prof.maxLatencyMs = std::max(prof.maxLatencyMs, latency);
+            if (latency > SLOW_MS)
+                prof.slowProbes++;
+            prof.probePending = false;
+        },
+        Qt::QueuedConnection);
+}
+
+void sample(Profiler& prof)
+{
+    std::unique_lock<std::mutex> lock(prof.mutex);
+    for (int tick = 0; !prof.stopping; tick++) {
+        QString gui = "gui";
+        if (prof.stack.empty())
+            gui += ";[idle]";
+        for (auto& frame : prof.stack)
+            gui += ';' + collapsedFrame(frameName(frame));
+        prof.samples[gui]++;
+
+        for (auto& task : prof.tasks)
+            prof.samples["tasks;" + collapsedFrame(task)]++;
+
+        if (tick % PROBE_EVERY_SAMPLES == 0) {
+            lock.unlock();
+            probe(prof);
+            lock.lock();
+        }
+        prof.wakeUp.wait_for(lock, SAMPLE_INTERVAL, [&prof] { return prof.stopping; });
+    }
+}
+
+}  // namespace
+
+void start(const QString& path)
+{
+    auto& prof = profiler();
+    if (s_enabled)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(prof.mutex);
+        prof.path = path;
+        prof.clock.start();
+        prof.guiThread = QCoreApplication::instance()->thread();
+        prof.stack.clear();
+        prof.samples.clear();
+        prof.slowHandlers.clear();
+        prof.probes = prof.slowProbes = 0;
+        prof.totalLatencyMs = prof.maxLatencyMs = 0;
+        prof.stopping = false;
+    }
+    s_enabled = true;
+    prof.sampler = std::thread([&prof] { sample(prof); });
+    qDebug() << "Sampling the launcher every" << SAMPLE_INTERVAL.count() << "ms into" << path;
+}
+
+void stop()
+{
+    if (!s_enabled.exchange(false))
+        return;
+
+    auto& prof = profiler();
+    {
+        std::lock_guard<std::mutex> lock(prof.mutex);
+        prof.stopping = true;
+    }
+    prof.wakeUp.notify_all();
+    prof.sampler.join();
+
+    std::lock_guard<std::mutex> lock(prof.mutex);
+
+    QStringList stacks = prof.samples.keys();
+    std::sort(stacks.begin(), stacks.end());
+    QByteArray out;
+    for (auto& stack : stacks)
+        out += stack.toUtf8() + ' ' + QByteArray::number(prof.samples.value(stack)) + '\n';
+
+    try {
+        FS::write(prof.path, out);
+        qDebug() << "Wrote" << stacks.size() << "sampled stacks to" << prof.path;
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write sampled stacks to" << prof.path << ":" << e.cause();
+    }
+
+    if (prof.probes > 0) {
+        qInfo().nospace() << "GUI thread latency: " << prof.totalLatencyMs / qint64(prof.probes) << " ms on average, "
+                          << prof.maxLatencyMs << " ms at most, over " << SLOW_MS << " ms " << prof.slowProbes << " of "
+                          << prof.probes << " times";
+    }
+    QStringList handlers = prof.slowHandlers.keys();
+    std::sort(handlers.begin(), handlers.end(), [&prof](const QString& a, const QString& b) {
+        return prof.slowHandlers.value(a).totalMs > prof.slowHandlers.value(b).totalMs;
+    });
+    for (auto& handler : handlers.mid(0, SUMMARY_LINES)) {
+        auto stats = prof.slowHandlers.value(handler);
+        qInfo().nospace() << "Slow event handler " << handler << ": " << stats.count << " times, " << stats.totalMs << " ms in total, "
+                          << stats.maxMs << " ms at most";
+    }
+}
+
+bool isEnabled()
+{
+    return s_enabled;
+}
+
+HandlerScope::HandlerScope(QObject* receiver, QEvent* event)
+{
+    if (!s_enabled || !receiver || !event)
+        return;
+    auto& prof = profiler();
+    if (QThread::currentThread() != prof.guiThread)
+        return;
+    std::lock_guard<std::mutex> lock(prof.mutex);
+    prof.stack.push_back({ receiver->metaObject()->className(), event->type(), prof.clock.elapsed() });
+    m_active = true;
+}
+
+HandlerScope::~HandlerScope()
+{
+    if (!m_active)
+        return;
+    auto& prof = profiler();
+    std::lock_guard<std::mutex> lock(prof.mutex);
+    // stopped and started again while the handler ran
+    if (prof.stack.empty())
+        return;
+    auto frame = prof.stack.back();
+    prof.stack.pop_back();
+
+    auto duration = prof.clock.elapsed() - frame.start;
+    if (!prof.stack.empty())
+        prof.stack.back().childMs += duration;
+    if (duration <= SLOW_MS)
+        return;
+
+    auto name = frameName(frame);
+    // the handlers around a slow one are just as slow, they only count if they were slow on their own
+    auto self = duration - frame.childMs;
+    if (self > SLOW_MS) {
+        auto& stats = prof.slowHandlers[name];
+        stats.count++;
+        stats.totalMs += self;
+        stats.maxMs = std::max(stats.maxMs, self);
+    }
+    if (prof.stack.empty())
+        qWarning().nospace() << "Slow event handler: " << name << " took " << duration << " ms";
+}
+
+void taskStarted(const void* task, const QString& name)
+{
+    if (!s_enabled)
+        return;
+    auto& prof = profiler();
+    std::lock_guard<std::mutex> lock(prof.mutex);
+    prof.tasks.insert(task, name);
+}
+
+void taskFinished(const void* task)
+{
+    if (!s_enabled)
+        return;
+    auto& prof = profiler();
+    std::lock_guard<std::mutex> lock(prof.mutex);
+    prof.tasks.remove(task);
+}
+
+}  // namespace SamplingProfiler
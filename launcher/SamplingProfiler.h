@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QString>
+
+class QEvent;
+class QObject;
+
+/** Opt-in sampling of what keeps the launcher busy, written out as collapsed stacks for a flame graph.
+ *
+ *  While it runs, the GUI thread keeps a stack of the event handlers it is in, each named after the class of the
+ *  object getting the event and the type of the event. A thread of its own looks at that stack and at the tasks in
+ *  flight every few milliseconds, and counts how often it saw each of them. It also measures how long the GUI thread
+ *  takes to get to a posted event, and handlers that take too long are logged as they finish.
+ *
+ *  The counts are written as one "frame;frame;frame count" line per stack, which flamegraph.pl and
+ *  https://www.speedscope.app read. Nothing is recorded unless start() was called, and every call here returns right
+ *  away then. All the functions are thread-safe.
+ */
+namespace SamplingProfiler {
+
+/* Starts sampling. The collapsed stacks are written to path by stop(). */
+void start(const QString& path);
+
+/* Writes the samples out, logs a summary and stops sampling. */
+void stop();
+
+bool isEnabled();
+
+/* Keeps the event on the GUI thread's stack of handlers while it lives. Does nothing on other threads. */
+class HandlerScope {
+   public:
+    HandlerScope(QObject* receiver, QEvent* event);
+    ~HandlerScope();
+
+    HandlerScope(const HandlerScope&) = delete;
+    HandlerScope& operator=(const HandlerScope&) = delete;
+
+   private:
+    bool m_active = false;
+};
+
+/* Keeps track of the tasks in flight, by the name they are shown with in the samples. */
+void taskStarted(const void* task, const QString& name);
+void taskFinished(const void* task);
+
+}  // namespace SamplingProfiler
@@ -15,15 +15,46 @@
 
 #include "SkinUtils.h"
 #include "Application.h"
+#include "FileSystem.h"
 #include "net/HttpMetaCache.h"
 
+#include <QCryptographicHash>
+#include <QDebug>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QPainter>
+#include <QPixmapCache>
+#include <QUrl>
 
 namespace SkinUtils {
+namespace {
+QPixmap drawFace(const QPixmap& skinTexture, int height, int width)
+{
+    QPixmap skin = QPixmap(8, 8);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    skin.fill(QColorConstants::Transparent);
+#else
+    skin.fill(QColor(0, 0, 0, 0));
+#endif
+    QPainter painter(&skin);
+    painter.drawPixmap(0, 0, skinTexture.copy(8, 8, 8, 8));
+    painter.drawPixmap(0, 0, skinTexture.copy(40, 8, 8, 8));
+    painter.end();
+    return skin.scaled(height, width, Qt::KeepAspectRatio);
+}
+
+QString texturePath(const QString& id)
+{
+    auto base = APPLICATION->metacache()->getBasePath("skins");
+    if (base.isEmpty() || id.isEmpty()) {
+        return {};
+    }
+    return FS::PathCombine(base, "textures", id + ".png");
+}
+}  // namespace
+
 /*
  * Given a username, return a pixmap of the cached skin (if it exists), QPixmap() otherwise
  */
@@ -34,19 +65,72 @@ QPixmap getFaceFromCache(QString username, int height, int width)
     if (fskin.exists()) {
         QPixmap skinTexture(fskin.fileName());
         if (!skinTexture.isNull()) {
-            QPixmap skin = QPixmap(8, 8);
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-            skin.fill(QColorConstants::Transparent);
-#else
-            skin.fill(QColor(0, 0, 0, 0));
-#endif
-            QPainter painter(&skin);
-            painter.drawPixmap(0, 0, skinTexture.copy(8, 8, 8, 8));
-            painter.drawPixmap(0, 0, skinTexture.copy(40, 8, 8, 8));
-            return skin.scaled(height, width, Qt::KeepAspectRatio);
+            return drawFace(skinTexture, height, width);
         }
     }
 
     return QPixmap();
 }
+
+QPixmap getFace(const QByteArray& skinPng, int size)
+{
+    if (skinPng.isEmpty()) {
+        return {};
+    }
+    // every view asks for the faces of every account whenever the accounts change, only the first has to decode them
+    const QString key =
+        QString("SkinFace:%1:%2").arg(QString::fromLatin1(QCryptographicHash::hash(skinPng, QCryptographicHash::Md5).toHex())).arg(size);
+    QPixmap face;
+    if (!QPixmapCache::find(key, &face)) {
+        QPixmap skinTexture;
+        if (!skinTexture.loadFromData(skinPng, "PNG")) {
+            return {};
+        }
+        face = drawFace(skinTexture, size, size);
+        QPixmapCache::insert(key, face);
+    }
+    return face;
+}
+
+QString textureId(const QString& url)
+{
+    QUrl parsed(url);
+    if (parsed.host() != "textures.minecraft.net" || !parsed.path().startsWith("/texture/")) {
+        return {};
+    }
+    auto id = parsed.fileName();
+    for (auto c : id) {
+        if (!c.isLetterOrNumber()) {
+            return {};
+        }
+    }
+    return id;
+}
+
+QByteArray cachedTexture(const QString& id)
+{
+    auto path = texturePath(id);
+    if (path.isEmpty() || !QFile::exists(path)) {
+        return {};
+    }
+    try {
+        return FS::read(path);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to read cached skin texture:" << e.cause();
+        return {};
+    }
+}
+
+void cacheTexture(const QString& id, const QByteArray& data)
+{
+    auto path = texturePath(id);
+    if (path.isEmpty() || data.isEmpty()) {
+        return;
+    }
+    try {
+        FS::write(path, data);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to cache skin texture:" << e.cause();
+    }
+}
 }  // namespace SkinUtils
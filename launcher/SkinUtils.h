@@ -15,8 +15,19 @@
 
 #pragma once
 
+#include <QByteArray>
 #include <QPixmap>
+#include <QString>
 
 namespace SkinUtils {
 QPixmap getFaceFromCache(QString id, int height = 64, int width = 64);
-}
+
+/* The face on the skin, drawn once per skin and size and kept in the QPixmapCache after that. Null if it isn't a PNG. */
+QPixmap getFace(const QByteArray& skinPng, int size = 64);
+
+/* The hash textures.minecraft.net names the texture at url after, empty for any other url. */
+QString textureId(const QString& url);
+/* The texture with the id as any account last downloaded it, empty if none did. */
+QByteArray cachedTexture(const QString& id);
+void cacheTexture(const QString& id, const QByteArray& data);
+}  // namespace SkinUtils
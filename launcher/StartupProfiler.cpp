@@ -0,0 +1,32 @@
+#include "StartupProfiler.h"
+
+void StartupProfiler::start()
+{
+    m_timer.start();
+    m_lastMark = 0;
+    m_phases.clear();
+}
+
+void StartupProfiler::mark(const QString& phase)
+{
+    if (!m_timer.isValid())
+        return;
+
+    auto now = m_timer.elapsed();
+    m_phases.append({ phase, now - m_lastMark, now });
+    m_lastMark = now;
+}
+
+QStringList StartupProfiler::report() const
+{
+    int width = 0;
+    for (auto& phase : m_phases) {
+        width = qMax(width, phase.name.size());
+    }
+
+    QStringList out;
+    for (auto& phase : m_phases) {
+        out.append(QString("%1 %2 ms (at %3 ms)").arg(phase.name + ':', -(width + 1)).arg(phase.duration, 6).arg(phase.end, 6));
+    }
+    return out;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/** Records how long each phase of the launcher's startup took.
+ *
+ *  Each call to mark() ends the phase that started with the previous one, so the phases add up to the time spent
+ *  since start(). Meant to be cheap enough to always be on, the report is only printed when asked for.
+ */
+class StartupProfiler {
+   public:
+    void start();
+
+    /* Ends the current phase, and names it. */
+    void mark(const QString& phase);
+
+    qint64 elapsed() const { return m_timer.isValid() ? m_timer.elapsed() : 0; }
+
+    /* One line per phase, with its duration and the time since start at its end. */
+    QStringList report() const;
+
+   private:
+    struct Phase {
+        QString name;
+        qint64 duration;
+        qint64 end;
+    };
+
+    QElapsedTimer m_timer;
+    qint64 m_lastMark = 0;
+    QList<Phase> m_phases;
+};
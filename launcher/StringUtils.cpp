@@ -116,6 +116,32 @@ int StringUtils::naturalCompare(const QString& s1, const QString& s2, Qt::CaseSe
     return QString::compare(s1, s2, cs);
 }
 
+QString StringUtils::naturalSortKey(const QString& s, Qt::CaseSensitivity cs)
+{
+    QString key;
+    key.reserve(s.size() + 4);
+    for (int i = 0; i < s.size();) {
+        auto c = s.at(i);
+        if (c.isSpace()) {
+            i++;
+        } else if (c.isDigit()) {
+            // leading zeros don't count, and a longer number is a bigger one
+            while (i < s.size() && s.at(i).digitValue() == 0)
+                i++;
+            int start = i;
+            while (i < s.size() && s.at(i).isDigit())
+                i++;
+            // the length goes first, below any printable character so numbers sort before letters
+            key.append(QChar(static_cast<char16_t>(1 + qMin(i - start, 0x1e))));
+            key.append(QStringView(s).mid(start, i - start));
+        } else {
+            key.append(cs == Qt::CaseInsensitive ? c.toLower() : c);
+            i++;
+        }
+    }
+    return key;
+}
+
 QString StringUtils::truncateUrlHumanFriendly(QUrl& url, int max_len, bool hard_limit)
 {
     auto display_options = QUrl::RemoveUserInfo | QUrl::RemoveFragment | QUrl::NormalizePathSegments;
@@ -69,6 +69,14 @@ inline QString fromStdString(string s)
 
 int naturalCompare(const QString& s1, const QString& s2, Qt::CaseSensitivity cs);
 
+/**
+ * @brief A key to precompute for strings that get sorted over and over again.
+ * Keys sort like naturalCompare when compared with QString::compare, with numbers in numeric order,
+ * except that the other characters compare by code point instead of locale-aware.
+ * Strings with equal keys should be ordered by comparing the strings themselves.
+ */
+QString naturalSortKey(const QString& s, Qt::CaseSensitivity cs);
+
 /**
  * @brief Truncate a url while keeping its readability py placing the `...` in the middle of the path
  * @param url Url to truncate
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "Tracing.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <atomic>
+
+#include "FileSystem.h"
+
+namespace Tracing {
+
+namespace {
+
+std::atomic<bool> s_enabled = false;
+
+struct Recorder {
+    QMutex mutex;
+    QString path;
+    QElapsedTimer clock;
+    QJsonArray events;
+};
+
+Recorder& recorder()
+{
+    static Recorder s_recorder;
+    return s_recorder;
+}
+
+void record(QJsonObject event)
+{
+    auto& rec = recorder();
+    event["pid"] = QCoreApplication::applicationPid();
+    event["tid"] = static_cast<qint64>(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+
+    QMutexLocker locker(&rec.mutex);
+    if (!event.contains("ts"))
+        event["ts"] = static_cast<qint64>(rec.clock.nsecsElapsed() / 1000);
+    rec.events.append(event);
+}
+
+}  // namespace
+
+void start(const QString& path)
+{
+    auto& rec = recorder();
+    QMutexLocker locker(&rec.mutex);
+    rec.path = path;
+    rec.events = {};
+    rec.clock.start();
+    s_enabled = true;
+}
+
+void stop()
+{
+    if (!s_enabled.exchange(false))
+        return;
+
+    auto& rec = recorder();
+    QMutexLocker locker(&rec.mutex);
+
+    QJsonObject trace;
+    trace["traceEvents"] = rec.events;
+    trace["displayTimeUnit"] = "ms";
+    rec.events = {};
+
+    try {
+        FS::write(rec.path, QJsonDocument(trace).toJson(QJsonDocument::Compact));
+        qDebug() << "Wrote trace to" << rec.path;
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write trace to" << rec.path << ":" << e.cause();
+    }
+}
+
+bool isEnabled()
+{
+    return s_enabled;
+}
+
+qint64 now()
+{
+    if (!s_enabled)
+        return 0;
+    auto& rec = recorder();
+    QMutexLocker locker(&rec.mutex);
+    return rec.clock.nsecsElapsed() / 1000;
+}
+
+void begin(const char* category, const QString& name, const QString& id, const QJsonObject& args)
+{
+    if (!s_enabled)
+        return;
+    record({ { "ph", "b" }, { "cat", category }, { "name", name }, { "id", id }, { "args", args } });
+}
+
+void end(const char* category, const QString& name, const QString& id, const QJsonObject& args)
+{
+    if (!s_enabled)
+        return;
+    record({ { "ph", "e" }, { "cat", category }, { "name", name }, { "id", id }, { "args", args } });
+}
+
+void complete(const char* category, const QString& name, qint64 start, qint64 duration, const QJsonObject& args)
+{
+    if (!s_enabled)
+        return;
+    record({ { "ph", "X" }, { "cat", category }, { "name", name }, { "ts", start }, { "dur", duration }, { "args", args } });
+}
+
+}  // namespace Tracing
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+/** Opt-in tracing of what the launcher is doing, written out as Chrome trace-event JSON.
+ *
+ *  The trace can be opened in chrome://tracing or https://ui.perfetto.dev. Nothing is recorded unless
+ *  start() was called, and every call here returns right away then. All the functions are thread-safe.
+ */
+namespace Tracing {
+
+/* Starts recording. The trace is written to path by stop(). */
+void start(const QString& path);
+
+/* Writes the recorded trace out, and stops recording. */
+void stop();
+
+bool isEnabled();
+
+/* Microseconds since recording started, for use with complete(). */
+qint64 now();
+
+/* Starts a span that can end on another thread, or overlap other spans. Matched to its end() by category and id. */
+void begin(const char* category, const QString& name, const QString& id, const QJsonObject& args = {});
+void end(const char* category, const QString& name, const QString& id, const QJsonObject& args = {});
+
+/* Records a span that is already over, from its start (as given by now()) and its duration in microseconds. */
+void complete(const char* category, const QString& name, qint64 start, qint64 duration, const QJsonObject& args = {});
+
+}  // namespace Tracing
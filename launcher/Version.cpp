@@ -10,102 +10,89 @@ Version::Version(QString str) : m_string(std::move(str))
     parse();
 }
 
-#define VERSION_OPERATOR(return_on_different)                                               \
-    bool exclude_our_sections = false;                                                      \
-    bool exclude_their_sections = false;                                                    \
-                                                                                            \
-    const auto size = qMax(m_sections.size(), other.m_sections.size());                     \
-    for (int i = 0; i < size; ++i) {                                                        \
-        Section sec1 = (i >= m_sections.size()) ? Section() : m_sections.at(i);             \
-        Section sec2 = (i >= other.m_sections.size()) ? Section() : other.m_sections.at(i); \
-                                                                                            \
-        { /* Don't include appendixes in the comparison */                                  \
-            if (sec1.isAppendix())                                                          \
-                exclude_our_sections = true;                                                \
-            if (sec2.isAppendix())                                                          \
-                exclude_their_sections = true;                                              \
-                                                                                            \
-            if (exclude_our_sections) {                                                     \
-                sec1 = Section();                                                           \
-                if (sec2.m_isNull)                                                          \
-                    break;                                                                  \
-            }                                                                               \
-                                                                                            \
-            if (exclude_their_sections) {                                                   \
-                sec2 = Section();                                                           \
-                if (sec1.m_isNull)                                                          \
-                    break;                                                                  \
-            }                                                                               \
-        }                                                                                   \
-                                                                                            \
-        if (sec1 != sec2)                                                                   \
-            return return_on_different;                                                     \
+int Version::compare(const Version& other) const
+{
+    static const Section s_null;
+    bool exclude_our_sections = false;
+    bool exclude_their_sections = false;
+
+    const auto size = qMax(m_sections.size(), other.m_sections.size());
+    for (int i = 0; i < size; ++i) {
+        const Section* sec1 = (i >= m_sections.size()) ? &s_null : &m_sections.at(i);
+        const Section* sec2 = (i >= other.m_sections.size()) ? &s_null : &other.m_sections.at(i);
+
+        { /* Don't include appendixes in the comparison */
+            if (sec1->isAppendix())
+                exclude_our_sections = true;
+            if (sec2->isAppendix())
+                exclude_their_sections = true;
+
+            if (exclude_our_sections) {
+                sec1 = &s_null;
+                if (sec2->m_isNull)
+                    break;
+            }
+
+            if (exclude_their_sections) {
+                sec2 = &s_null;
+                if (sec1->m_isNull)
+                    break;
+            }
+        }
+
+        if (*sec1 != *sec2)
+            return *sec1 < *sec2 ? -1 : 1;
     }
+    return 0;
+}
 
 bool Version::operator<(const Version& other) const
 {
-    VERSION_OPERATOR(sec1 < sec2)
-
-    return false;
+    return compare(other) < 0;
 }
 bool Version::operator==(const Version& other) const
 {
-    VERSION_OPERATOR(false)
-
-    return true;
+    return compare(other) == 0;
 }
 bool Version::operator!=(const Version& other) const
 {
-    return !operator==(other);
+    return compare(other) != 0;
 }
 bool Version::operator<=(const Version& other) const
 {
-    return *this < other || *this == other;
+    return compare(other) <= 0;
 }
 bool Version::operator>(const Version& other) const
 {
-    return !(*this <= other);
+    return compare(other) > 0;
 }
 bool Version::operator>=(const Version& other) const
 {
-    return !(*this < other);
+    return compare(other) >= 0;
 }
 
 void Version::parse()
 {
     m_sections.clear();
-    QString currentSection;
 
     if (m_string.isEmpty())
         return;
 
-    auto classChange = [&](QChar lastChar, QChar currentChar) {
-        if (lastChar.isNull())
-            return false;
-        if (lastChar.isDigit() != currentChar.isDigit())
-            return true;
-
-        const QList<QChar> s_separators{ '.', '-', '+' };
-        if (s_separators.contains(currentChar) && currentSection.at(0) != currentChar)
-            return true;
-
-        return false;
-    };
+    auto isSeparator = [](QChar c) { return c == '.' || c == '-' || c == '+'; };
 
-    currentSection += m_string.at(0);
+    // a section starts where digits and other characters meet, or at a separator that doesn't repeat the section's first one
+    int start = 0;
     for (int i = 1; i < m_string.size(); ++i) {
-        const auto& current_char = m_string.at(i);
-        if (classChange(m_string.at(i - 1), current_char)) {
-            if (!currentSection.isEmpty())
-                m_sections.append(Section(currentSection));
-            currentSection = "";
+        const QChar last_char = m_string.at(i - 1);
+        const QChar current_char = m_string.at(i);
+        if (last_char.isNull())
+            continue;
+        if (last_char.isDigit() != current_char.isDigit() || (isSeparator(current_char) && m_string.at(start) != current_char)) {
+            m_sections.append(Section(m_string.mid(start, i - start)));
+            start = i;
         }
-
-        currentSection += current_char;
     }
-
-    if (!currentSection.isEmpty())
-        m_sections.append(Section(currentSection));
+    m_sections.append(Section(m_string.mid(start)));
 }
 
 /// qDebug print support for the Version class
@@ -37,9 +37,9 @@
 #pragma once
 
 #include <QDebug>
-#include <QList>
 #include <QString>
 #include <QStringView>
+#include <QVector>
 
 class QUrl;
 
@@ -61,6 +61,7 @@ class Version {
     friend QDebug operator<<(QDebug debug, const Version& v);
 
    private:
+    /// one run of digits and the text after it, parsed once so comparing two versions doesn't allocate
     struct Section {
         explicit Section(QString fullString) : m_fullString(std::move(fullString))
         {
@@ -83,38 +84,34 @@ class Version {
                 m_numPart = numPart.toInt();
             }
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-            auto stringPart = QStringView{ m_fullString }.mid(cutoff);
-#else
-            auto stringPart = m_fullString.midRef(cutoff);
-#endif
-
-            if (!stringPart.isEmpty()) {
+            if (cutoff < m_fullString.size()) {
                 m_isNull = false;
-                m_stringPart = stringPart.toString();
+                m_stringPart = m_fullString.mid(cutoff);
+                m_isAppendix = m_stringPart.startsWith('+');
+                m_isPreRelease = m_stringPart.startsWith('-') && m_stringPart.length() > 1;
             }
         }
 
         explicit Section() = default;
 
         bool m_isNull = true;
+        bool m_isAppendix = false;
+        bool m_isPreRelease = false;
 
         int m_numPart = 0;
         QString m_stringPart;
 
         QString m_fullString;
 
-        [[nodiscard]] inline bool isAppendix() const { return m_stringPart.startsWith('+'); }
-        [[nodiscard]] inline bool isPreRelease() const { return m_stringPart.startsWith('-') && m_stringPart.length() > 1; }
+        [[nodiscard]] inline bool isAppendix() const { return m_isAppendix; }
+        [[nodiscard]] inline bool isPreRelease() const { return m_isPreRelease; }
 
         inline bool operator==(const Section& other) const
         {
-            if (m_isNull && !other.m_isNull)
-                return false;
-            if (!m_isNull && other.m_isNull)
+            if (m_isNull != other.m_isNull)
                 return false;
 
-            if (!m_isNull && !other.m_isNull) {
+            if (!m_isNull) {
                 return (m_numPart == other.m_numPart) && (m_stringPart == other.m_stringPart);
             }
 
@@ -123,10 +120,11 @@ class Version {
 
         inline bool operator<(const Section& other) const
         {
-            static auto unequal_is_less = [](Section const& non_null) -> bool {
+            // whether a section is less than a missing one, e.g. "1.0" < "1" is false but "1-rc1" < "1" is true
+            auto unequal_is_less = [](Section const& non_null) -> bool {
                 if (non_null.m_stringPart.isEmpty())
                     return non_null.m_numPart == 0;
-                return (non_null.m_stringPart != QLatin1Char('.')) && non_null.isPreRelease();
+                return non_null.isPreRelease();
             };
 
             if (!m_isNull && other.m_isNull)
@@ -148,7 +146,8 @@ class Version {
                 return false;
             }
 
-            return m_fullString < other.m_fullString;
+            // two missing sections are equal
+            return false;
         }
 
         inline bool operator!=(const Section& other) const { return !(*this == other); }
@@ -157,7 +156,9 @@ class Version {
 
    private:
     QString m_string;
-    QList<Section> m_sections;
+    QVector<Section> m_sections;
 
     void parse();
+    /// negative, zero or positive when this version is older than, the same as or newer than the other one
+    int compare(const Version& other) const;
 };
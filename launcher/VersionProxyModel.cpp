@@ -44,6 +44,18 @@
 class VersionFilterModel : public QSortFilterProxyModel {
     Q_OBJECT
    public:
+    /* What the filters and the views look at of a version, so it isn't worked out again for every keystroke and repaint. */
+    struct Row {
+        bool cached = false;
+        QString version;
+        bool recommended = false;
+        bool latest = false;
+        // the roles filtered on, as the filters see them
+        QHash<int, QString> fields;
+        // what the last filtering made of it, -1 if it wasn't filtered since it changed
+        signed char accepted = -1;
+    };
+
     VersionFilterModel(VersionProxyModel* parent) : QSortFilterProxyModel(parent)
     {
         m_parent = parent;
@@ -51,29 +63,88 @@ class VersionFilterModel : public QSortFilterProxyModel {
         sort(0, Qt::DescendingOrder);
     }
 
-    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
+    void setSourceModel(QAbstractItemModel* source) override
     {
-        const auto& filters = m_parent->filters();
-        const QString& search = m_parent->search();
-        const QModelIndex idx = sourceModel()->index(source_row, 0, source_parent);
+        if (sourceModel())
+            disconnect(sourceModel(), nullptr, this, nullptr);
+        m_rows.clear();
+        // before the base class connects its own, so the cache is up to date by the time it filters again
+        if (source) {
+            connect(source, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+                for (int i = topLeft.row(); i <= bottomRight.row() && i < m_rows.size(); i++)
+                    m_rows[i] = Row();
+            });
+            auto clear = [this] { m_rows.clear(); };
+            connect(source, &QAbstractItemModel::rowsAboutToBeInserted, this, clear);
+            connect(source, &QAbstractItemModel::rowsAboutToBeRemoved, this, clear);
+            connect(source, &QAbstractItemModel::rowsAboutToBeMoved, this, clear);
+            connect(source, &QAbstractItemModel::layoutAboutToBeChanged, this, clear);
+            connect(source, &QAbstractItemModel::modelAboutToBeReset, this, clear);
+        }
+        QSortFilterProxyModel::setSourceModel(source);
+    }
+
+    const Row& row(int source_row) const
+    {
+        if (m_rows.size() != sourceModel()->rowCount())
+            m_rows.resize(sourceModel()->rowCount());
+        auto& row = m_rows[source_row];
+        if (!row.cached) {
+            auto idx = sourceModel()->index(source_row, 0);
+            row.version = sourceModel()->data(idx, BaseVersionList::VersionRole).toString();
+            row.recommended = sourceModel()->data(idx, BaseVersionList::RecommendedRole).toBool();
+            row.latest = sourceModel()->data(idx, BaseVersionList::LatestRole).toBool();
+            row.cached = true;
+        }
+        return row;
+    }
 
-        if (!search.isEmpty() && !sourceModel()->data(idx, BaseVersionList::VersionRole).toString().contains(search, Qt::CaseInsensitive))
+    const Row& row(const QModelIndex& index) const { return row(mapToSource(index).row()); }
+
+    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override
+    {
+        if (source_parent.isValid())
             return false;
+        row(source_row);
+        auto& cached = m_rows[source_row];
+
+        // a longer search only drops versions
+        if (m_narrowing && cached.accepted == 0)
+            return false;
+        cached.accepted = accepts(source_row, cached) ? 1 : 0;
+        return cached.accepted;
+    }
 
+    /* When 'narrowing', only what the previous filtering accepted can make it through this one. */
+    void filterChanged(bool narrowing = false)
+    {
+        m_narrowing = narrowing;
+        invalidateFilter();
+        m_narrowing = false;
+    }
+
+   private:
+    bool accepts(int source_row, Row& cached) const
+    {
+        const QString& search = m_parent->search();
+        if (!search.isEmpty() && !cached.version.contains(search, Qt::CaseInsensitive))
+            return false;
+
+        const auto& filters = m_parent->filters();
         for (auto it = filters.begin(); it != filters.end(); ++it) {
-            auto data = sourceModel()->data(idx, it.key());
-            auto match = data.toString();
-            if (!it.value()->accepts(match)) {
+            auto field = cached.fields.constFind(it.key());
+            if (field == cached.fields.constEnd())
+                field = cached.fields.insert(it.key(), sourceModel()->data(sourceModel()->index(source_row, 0), it.key()).toString());
+            if (!it.value()->accepts(*field))
                 return false;
-            }
         }
         return true;
     }
 
-    void filterChanged() { invalidateFilter(); }
-
    private:
     VersionProxyModel* m_parent;
+    mutable QVector<Row> m_rows;
+    bool m_narrowing = false;
 };
 
 VersionProxyModel::VersionProxyModel(QObject* parent) : QAbstractProxyModel(parent)
@@ -153,7 +224,7 @@ QVariant VersionProxyModel::data(const QModelIndex& index, int role) const
         case Qt::DisplayRole: {
             switch (column) {
                 case Name: {
-                    QString version = sourceModel()->data(parentIndex, BaseVersionList::VersionRole).toString();
+                    const QString& version = filterModel->row(parentIndex).version;
                     if (version == m_currentVersion) {
                         return tr("%1 (installed)").arg(version);
                     }
@@ -177,14 +248,11 @@ QVariant VersionProxyModel::data(const QModelIndex& index, int role) const
         }
         case Qt::ToolTipRole: {
             if (column == Name && hasRecommended) {
-                auto value = sourceModel()->data(parentIndex, BaseVersionList::RecommendedRole);
-                if (value.toBool()) {
+                auto& row = filterModel->row(parentIndex);
+                if (row.recommended) {
                     return tr("Recommended");
-                } else if (hasLatest) {
-                    auto value = sourceModel()->data(parentIndex, BaseVersionList::LatestRole);
-                    if (value.toBool()) {
-                        return tr("Latest");
-                    }
+                } else if (hasLatest && row.latest) {
+                    return tr("Latest");
                 }
             } else {
                 return sourceModel()->data(parentIndex, BaseVersionList::VersionIdRole);
@@ -194,14 +262,11 @@ QVariant VersionProxyModel::data(const QModelIndex& index, int role) const
             switch (column) {
                 case Name: {
                     if (hasRecommended) {
-                        auto recommenced = sourceModel()->data(parentIndex, BaseVersionList::RecommendedRole);
-                        if (recommenced.toBool()) {
+                        auto& row = filterModel->row(parentIndex);
+                        if (row.recommended) {
                             return APPLICATION->getThemedIcon("star");
-                        } else if (hasLatest) {
-                            auto latest = sourceModel()->data(parentIndex, BaseVersionList::LatestRole);
-                            if (latest.toBool()) {
-                                return APPLICATION->getThemedIcon("bug");
-                            }
+                        } else if (hasLatest && row.latest) {
+                            return APPLICATION->getThemedIcon("bug");
                         }
                         QPixmap pixmap;
                         QPixmapCache::find("placeholder", &pixmap);
@@ -341,8 +406,7 @@ QModelIndex VersionProxyModel::getRecommended() const
     }
     int recommended = 0;
     for (int i = 0; i < rowCount(); i++) {
-        auto value = sourceModel()->data(mapToSource(index(i, 0)), BaseVersionList::RecommendedRole);
-        if (value.toBool()) {
+        if (filterModel->row(mapToSource(index(i, 0))).recommended) {
             recommended = i;
         }
     }
@@ -353,8 +417,7 @@ QModelIndex VersionProxyModel::getVersion(const QString& version) const
 {
     int found = -1;
     for (int i = 0; i < rowCount(); i++) {
-        auto value = sourceModel()->data(mapToSource(index(i, 0)), BaseVersionList::VersionRole);
-        if (value.toString() == version) {
+        if (filterModel->row(mapToSource(index(i, 0))).version == version) {
             found = i;
         }
     }
@@ -379,8 +442,10 @@ void VersionProxyModel::setFilter(const BaseVersionList::ModelRoles column, Filt
 
 void VersionProxyModel::setSearch(const QString& search)
 {
+    // typing on in the search field only narrows down what is shown already
+    bool narrowing = search.contains(m_search, Qt::CaseInsensitive);
     m_search = search;
-    filterModel->filterChanged();
+    filterModel->filterChanged(narrowing);
 }
 
 const VersionProxyModel::FilterMap& VersionProxyModel::filters() const
@@ -76,15 +76,13 @@ FileLinkApp::FileLinkApp(int& argc, char** argv) : QCoreApplication(argc, argv),
     QCommandLineParser parser;
     parser.setApplicationDescription(QObject::tr("a batch MKLINK program for windows to be used with prismlauncher"));
 
-    parser.addOptions({ { { "s", "server" }, "Join the specified server on launch", "pipe name" },
-                        { { "H", "hard" }, "use hard links instead of symbolic", "true/false" } });
+    parser.addOptions({ { { "s", "server" }, "Join the specified server on launch", "pipe name" } });
     parser.addHelpOption();
     parser.addVersionOption();
 
     parser.process(arguments());
 
     QString serverToJoin = parser.value("server");
-    m_useHardLinks = QVariant(parser.value("hard")).toBool();
 
     qDebug() << "link program launched";
 
@@ -146,6 +144,7 @@ void FileLinkApp::runLink()
     std::error_code os_err;
 
     qDebug() << "creating links";
+    m_path_results.clear();
 
     for (auto link : m_links_to_make) {
         QString src_path = link.src;
@@ -179,24 +178,14 @@ void FileLinkApp::runLink()
     }
 
     sendResults();
-    qDebug() << "done, should exit soon";
+    qDebug() << "done, waiting for more links until the launcher disconnects";
 }
 
 void FileLinkApp::sendResults()
 {
     // construct block of data to send
-    QByteArray block;
-    QDataStream out(&block, QIODevice::WriteOnly);
-
-    qint32 blocksize = quint32(sizeof(quint32));
-    for (auto result : m_path_results) {
-        blocksize += quint32(result.src.size());
-        blocksize += quint32(result.dst.size());
-        blocksize += quint32(result.err_msg.size());
-        blocksize += quint32(sizeof(quint32));
-    }
-    qDebug() << "About to write block of size:" << blocksize;
-    out << blocksize;
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
 
     out << quint32(m_path_results.length());
     for (auto result : m_path_results) {
@@ -206,6 +195,12 @@ void FileLinkApp::sendResults()
         out << quint32(result.err_value);
     }
 
+    QByteArray block;
+    QDataStream header(&block, QIODevice::WriteOnly);
+    qDebug() << "About to write block of size:" << payload.size();
+    header << quint32(payload.size());
+    block += payload;
+
     qint64 byteswritten = socket.write(block);
     bool bytesflushed = socket.flush();
     qDebug() << "block flushed" << byteswritten << bytesflushed;
@@ -213,35 +208,40 @@ void FileLinkApp::sendResults()
 
 void FileLinkApp::readPathPairs()
 {
-    m_links_to_make.clear();
-    qDebug() << "Reading path pairs from server";
-    qDebug() << "bytes available" << socket.bytesAvailable();
-    if (blockSize == 0) {
-        // Relies on the fact that QDataStream serializes a quint32 into
-        // sizeof(quint32) bytes
-        if (socket.bytesAvailable() < (int)sizeof(quint32))
+    // the launcher keeps the connection for the whole session, and sends a block for every batch of links
+    while (true) {
+        qDebug() << "Reading path pairs from server";
+        qDebug() << "bytes available" << socket.bytesAvailable();
+        if (blockSize == 0) {
+            // Relies on the fact that QDataStream serializes a quint32 into
+            // sizeof(quint32) bytes
+            if (socket.bytesAvailable() < (int)sizeof(quint32))
+                return;
+            qDebug() << "reading block size";
+            in >> blockSize;
+        }
+        qDebug() << "blocksize is" << blockSize;
+        if (socket.bytesAvailable() < blockSize)
             return;
-        qDebug() << "reading block size";
-        in >> blockSize;
-    }
-    qDebug() << "blocksize is" << blockSize;
-    qDebug() << "bytes available" << socket.bytesAvailable();
-    if (socket.bytesAvailable() < blockSize || in.atEnd())
-        return;
-
-    quint32 numLinks;
-    in >> numLinks;
-    qDebug() << "numLinks" << numLinks;
-
-    for (quint32 i = 0; i < numLinks; i++) {
-        FS::LinkPair pair;
-        in >> pair.src;
-        in >> pair.dst;
-        qDebug() << "link" << pair.src << "to" << pair.dst;
-        m_links_to_make.append(pair);
-    }
+        blockSize = 0;
+
+        m_links_to_make.clear();
+        in >> m_useHardLinks;
+
+        quint32 numLinks;
+        in >> numLinks;
+        qDebug() << "numLinks" << numLinks;
 
-    runLink();
+        for (quint32 i = 0; i < numLinks; i++) {
+            FS::LinkPair pair;
+            in >> pair.src;
+            in >> pair.dst;
+            qDebug() << "link" << pair.src << "to" << pair.dst;
+            m_links_to_make.append(pair);
+        }
+
+        runLink();
+    }
 }
 
 FileLinkApp::~FileLinkApp()
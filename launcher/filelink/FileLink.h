@@ -54,6 +54,7 @@ class FileLinkApp : public QCoreApplication {
 
     Status m_status = Status::Starting;
 
+    // for the batch being made, each one says what kind of links it wants
     bool m_useHardLinks = false;
 
     QDateTime m_startTime;
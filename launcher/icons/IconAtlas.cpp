@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "IconAtlas.h"
+
+#include <QApplication>
+#include <QImageReader>
+#include <QPainter>
+#include <QStyle>
+#include <QStyleOption>
+
+IconAtlas::IconAtlas()
+{
+    m_pixmaps.setMaxCost(maxCost);
+}
+
+QString IconAtlas::cacheKey(const QString& path, const QSize& size, QIcon::Mode mode)
+{
+    return QString("%1|%2x%3|%4").arg(path).arg(size.width()).arg(size.height()).arg(int(mode));
+}
+
+QPixmap IconAtlas::find(const QString& path, const QSize& size, QIcon::Mode mode) const
+{
+    if (auto pixmap = m_pixmaps.object(cacheKey(path, size, mode))) {
+        return *pixmap;
+    }
+    return {};
+}
+
+void IconAtlas::insert(const QString& path, const QSize& size, QIcon::Mode mode, const QPixmap& pixmap)
+{
+    if (pixmap.isNull()) {
+        return;
+    }
+    const int cost = qMax(1, int(qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8 / 1024));
+    m_pixmaps.insert(cacheKey(path, size, mode), new QPixmap(pixmap), cost);
+}
+
+void IconAtlas::remove(const QString& path)
+{
+    const QString prefix = path + '|';
+    for (auto& key : m_pixmaps.keys()) {
+        if (key.startsWith(prefix)) {
+            m_pixmaps.remove(key);
+        }
+    }
+}
+
+QImage IconAtlas::decode(const QString& path, const QSize& size)
+{
+    QImageReader reader(path);
+    // handlers that can't decode to a smaller size directly get scaled by the reader
+    reader.setScaledSize(size);
+    return reader.read();
+}
+
+FileIconEngine::FileIconEngine(QString path, QSize size, bool scalable, std::shared_ptr<IconAtlas> atlas)
+    : m_path(std::move(path)), m_size(size), m_scalable(scalable), m_atlas(std::move(atlas))
+{}
+
+QSize FileIconEngine::fittedSize(const QSize& size) const
+{
+    if (!m_size.isValid()) {
+        return size;
+    }
+    // never scale raster images up, just like QIcon
+    if (!m_scalable && m_size.width() <= size.width() && m_size.height() <= size.height()) {
+        return m_size;
+    }
+    return m_size.scaled(size, Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+}
+
+QSize FileIconEngine::actualSize(const QSize& size, [[maybe_unused]] QIcon::Mode mode, [[maybe_unused]] QIcon::State state)
+{
+    return fittedSize(size);
+}
+
+QPixmap FileIconEngine::pixmap(const QSize& size, QIcon::Mode mode, [[maybe_unused]] QIcon::State state)
+{
+    const QSize fitted = fittedSize(size);
+    QPixmap pixmap = m_atlas->find(m_path, fitted, mode);
+    if (!pixmap.isNull()) {
+        return pixmap;
+    }
+
+    QPixmap normal = m_atlas->find(m_path, fitted);
+    if (normal.isNull()) {
+        normal = QPixmap::fromImage(IconAtlas::decode(m_path, fitted));
+        m_atlas->insert(m_path, fitted, QIcon::Normal, normal);
+    }
+    if (mode == QIcon::Normal || normal.isNull()) {
+        return normal;
+    }
+
+    QStyleOption opt(0);
+    opt.palette = QApplication::palette();
+    pixmap = QApplication::style()->generatedIconPixmap(mode, normal, &opt);
+    m_atlas->insert(m_path, fitted, mode, pixmap);
+    return pixmap;
+}
+
+void FileIconEngine::paint(QPainter* painter, const QRect& rect, QIcon::Mode mode, QIcon::State state)
+{
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const QPixmap pixmap = this->pixmap(rect.size() * dpr, mode, state);
+    if (pixmap.isNull()) {
+        return;
+    }
+    const QSize size = pixmap.size() / dpr;
+    painter->drawPixmap(QStyle::alignedRect(Qt::LeftToRight, Qt::AlignCenter, size, rect), pixmap);
+}
+
+QIconEngine* FileIconEngine::clone() const
+{
+    return new FileIconEngine(*this);
+}
+
+QString FileIconEngine::key() const
+{
+    return "FileIconEngine";
+}
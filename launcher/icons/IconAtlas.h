@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QCache>
+#include <QIconEngine>
+#include <QImage>
+#include <QPixmap>
+#include <QString>
+#include <memory>
+
+/**
+ * Scaled pixmaps of the file based icons, keyed by file, size and mode.
+ *
+ * Only the sizes that actually get drawn are kept, never the full size images, and the whole atlas stays under a fixed
+ * memory budget. Evicted pixmaps are decoded again when they are needed.
+ * Not thread safe, use it from the GUI thread only. Decoding itself can happen anywhere.
+ */
+class IconAtlas {
+   public:
+    /// memory budget of the atlas, in KiB
+    static constexpr int maxCost = 32 * 1024;
+
+    IconAtlas();
+
+    QPixmap find(const QString& path, const QSize& size, QIcon::Mode mode = QIcon::Normal) const;
+    void insert(const QString& path, const QSize& size, QIcon::Mode mode, const QPixmap& pixmap);
+    /// drop every size of the given file
+    void remove(const QString& path);
+
+    /// decode the file straight to the given size. Safe to call from any thread.
+    static QImage decode(const QString& path, const QSize& size);
+
+   private:
+    static QString cacheKey(const QString& path, const QSize& size, QIcon::Mode mode);
+
+    mutable QCache<QString, QPixmap> m_pixmaps;
+};
+
+/**
+ * Icon engine for an icon file, which only reads the image header up front and leaves decoding to the atlas.
+ */
+class FileIconEngine : public QIconEngine {
+   public:
+    FileIconEngine(QString path, QSize size, bool scalable, std::shared_ptr<IconAtlas> atlas);
+
+    void paint(QPainter* painter, const QRect& rect, QIcon::Mode mode, QIcon::State state) override;
+    QPixmap pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) override;
+    QSize actualSize(const QSize& size, QIcon::Mode mode, QIcon::State state) override;
+    QIconEngine* clone() const override;
+    QString key() const override;
+
+    /// the size a pixmap requested at the given size ends up with
+    QSize fittedSize(const QSize& size) const;
+
+   private:
+    QString m_path;
+    QSize m_size;
+    bool m_scalable = false;
+    std::shared_ptr<IconAtlas> m_atlas;
+};
@@ -39,15 +39,37 @@
 #include <QDebug>
 #include <QEventLoop>
 #include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QGuiApplication>
+#include <QImageReader>
 #include <QMap>
 #include <QMimeData>
 #include <QSet>
 #include <QUrl>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+#include <QtMath>
 #include "icons/IconUtils.h"
 
 #define MAX_SIZE 1024
 
-IconList::IconList(const QStringList& builtinPaths, QString path, QObject* parent) : QAbstractListModel(parent)
+namespace {
+QString iconKeyOf(const QFileInfo& file)
+{
+    // The icon doesnt have a suffix, but it can have other .s in the name, so we account for those as well
+    if (!IconUtils::isIconSuffix(file.suffix()))
+        return file.fileName();
+    return file.completeBaseName();
+}
+
+bool isScalableFormat(const QByteArray& format)
+{
+    return format == "svg" || format == "svgz";
+}
+}  // namespace
+
+IconList::IconList(const QStringList& builtinPaths, QString path, QObject* parent)
+    : QAbstractListModel(parent), m_atlas(std::make_shared<IconAtlas>())
 {
     QSet<QString> builtinNames;
 
@@ -125,13 +147,8 @@ void IconList::directoryChanged(const QString& path)
 
     for (auto remove : to_remove) {
         qDebug() << "Removing " << remove;
-        QFileInfo rmfile(remove);
-        QString key = rmfile.completeBaseName();
-
-        QString suffix = rmfile.suffix();
-        // The icon doesnt have a suffix, but it can have other .s in the name, so we account for those as well
-        if (!IconUtils::isIconSuffix(suffix))
-            key = rmfile.fileName();
+        QString key = iconKeyOf(QFileInfo(remove));
+        m_atlas->remove(remove);
 
         int idx = getIconIndex(key);
         if (idx == -1)
@@ -149,24 +166,78 @@ void IconList::directoryChanged(const QString& path)
         emit iconUpdated(key);
     }
 
+    QStringList to_load;
     for (auto add : to_add) {
         qDebug() << "Adding " << add;
+        to_load.append(add);
+    }
+    // until they are loaded, instances using these icons get the fallback icon
+    loadIconFiles(to_load);
 
-        QFileInfo addfile(add);
-        QString key = addfile.completeBaseName();
-
-        QString suffix = addfile.suffix();
-        // The icon doesnt have a suffix, but it can have other .s in the name, so we account for those as well
-        if (!IconUtils::isIconSuffix(suffix))
-            key = addfile.fileName();
+    sortIconList();
+}
 
-        if (addIcon(key, QString(), addfile.filePath(), IconType::FileBased)) {
-            m_watcher->addPath(add);
-            emit iconUpdated(key);
+void IconList::loadIconFiles(const QStringList& paths)
+{
+    QStringList toLoad;
+    for (auto& path : paths) {
+        if (!m_pendingFiles.contains(path)) {
+            m_pendingFiles.insert(path);
+            toLoad.append(path);
         }
     }
+    if (toLoad.isEmpty())
+        return;
 
-    sortIconList();
+    // the size the instance view draws icons at, so the first paint doesn't have to decode anything
+    const int previewSide = qCeil(48 * qApp->devicePixelRatio());
+    auto watcher = new QFutureWatcher<QList<LoadedIcon>>(this);
+    connect(watcher, &QFutureWatcher<QList<LoadedIcon>>::finished, this, [this, watcher] {
+        iconFilesLoaded(watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([toLoad, previewSide] {
+        return QtConcurrent::blockingMapped<QList<LoadedIcon>>(toLoad, [previewSide](const QString& path) {
+            LoadedIcon loaded;
+            loaded.path = path;
+            QImageReader reader(path);
+            if (!reader.canRead())
+                return loaded;
+            loaded.size = reader.size();
+            loaded.scalable = isScalableFormat(reader.format());
+            loaded.previewSize = FileIconEngine(path, loaded.size, loaded.scalable, nullptr).fittedSize(QSize(previewSide, previewSide));
+            // decode straight to the preview size, the full size image is never kept around
+            reader.setScaledSize(loaded.previewSize);
+            loaded.preview = reader.read();
+            return loaded;
+        });
+    }));
+}
+
+void IconList::iconFilesLoaded(const QList<LoadedIcon>& loaded)
+{
+    bool added = false;
+    for (auto& file : loaded) {
+        m_pendingFiles.remove(file.path);
+        if (file.preview.isNull())
+            continue;
+
+        QString key = iconKeyOf(QFileInfo(file.path));
+        m_atlas->remove(file.path);
+        m_atlas->insert(file.path, file.previewSize, QIcon::Normal, QPixmap::fromImage(file.preview));
+
+        added |= !name_index.contains(key);
+        putIcon(key, QString(), fileIcon(file), file.path, IconType::FileBased);
+        m_watcher->addPath(file.path);
+        emit iconUpdated(key);
+    }
+    if (added)
+        sortIconList();
+}
+
+QIcon IconList::fileIcon(const LoadedIcon& loaded) const
+{
+    return QIcon(new FileIconEngine(loaded.path, loaded.size, loaded.scalable, m_atlas));
 }
 
 void IconList::fileChanged(const QString& path)
@@ -175,17 +246,11 @@ void IconList::fileChanged(const QString& path)
     QFileInfo checkfile(path);
     if (!checkfile.exists())
         return;
-    QString key = checkfile.completeBaseName();
+    QString key = iconKeyOf(checkfile);
     int idx = getIconIndex(key);
     if (idx == -1)
         return;
-    QIcon icon(path);
-    if (!icon.availableSizes().size())
-        return;
-
-    icons[idx].m_images[IconType::FileBased].icon = icon;
-    dataChanged(index(idx), index(idx));
-    emit iconUpdated(key);
+    loadIconFiles({ path });
 }
 
 void IconList::SettingChanged(const Setting& setting, QVariant value)
@@ -356,15 +421,26 @@ bool IconList::addThemeIcon(const QString& key)
 bool IconList::addIcon(const QString& key, const QString& name, const QString& path, const IconType type)
 {
     // replace the icon even? is the input valid?
-    QIcon icon(path);
-    if (icon.isNull())
+    QImageReader reader(path);
+    if (!reader.canRead())
         return false;
+    LoadedIcon loaded;
+    loaded.path = path;
+    loaded.size = reader.size();
+    loaded.scalable = isScalableFormat(reader.format());
+    m_atlas->remove(path);
+    putIcon(key, name, fileIcon(loaded), path, type);
+    return true;
+}
+
+void IconList::putIcon(const QString& key, const QString& name, const QIcon& icon, const QString& path, const IconType type)
+{
     auto iter = name_index.find(key);
     if (iter != name_index.end()) {
         auto& oldOne = icons[*iter];
         oldOne.replace(type, icon, path);
         dataChanged(index(*iter), index(*iter));
-        return true;
+        return;
     }
     // add a new icon
     beginInsertRows(QModelIndex(), icons.size(), icons.size());
@@ -377,7 +453,6 @@ bool IconList::addIcon(const QString& key, const QString& name, const QString& p
         name_index[key] = icons.size() - 1;
     }
     endInsertRows();
-    return true;
 }
 
 void IconList::saveIcon(const QString& key, const QString& path, const char* format) const
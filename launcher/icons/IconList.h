@@ -38,9 +38,11 @@
 #include <QDir>
 #include <QFile>
 #include <QMutex>
+#include <QSet>
 #include <QtGui/QIcon>
 #include <memory>
 
+#include "IconAtlas.h"
 #include "MMCIcon.h"
 #include "settings/Setting.h"
 
@@ -92,6 +94,20 @@ class IconList : public QAbstractListModel {
     void reindex();
     void sortIconList();
 
+    /// a probed icon file, along with its pixmap at the size most views draw it at
+    struct LoadedIcon {
+        QString path;
+        QSize size;
+        bool scalable = false;
+        QImage preview;
+        QSize previewSize;
+    };
+    /// probe and decode the given icon files on the worker pool, then add or replace them
+    void loadIconFiles(const QStringList& paths);
+    void iconFilesLoaded(const QList<LoadedIcon>& loaded);
+    QIcon fileIcon(const LoadedIcon& loaded) const;
+    void putIcon(const QString& key, const QString& name, const QIcon& icon, const QString& path, IconType type);
+
    public slots:
     void directoryChanged(const QString& path);
 
@@ -105,4 +121,7 @@ class IconList : public QAbstractListModel {
     QMap<QString, int> name_index;
     QVector<MMCIcon> icons;
     QDir m_dir;
+    std::shared_ptr<IconAtlas> m_atlas;
+    // files being loaded on the worker pool
+    QSet<QString> m_pendingFiles;
 };
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "JavaCheckCache.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace {
+constexpr quint32 JAVA_CHECK_CACHE_MAGIC = 0x504C4A43;  // "PLJC"
+constexpr quint32 JAVA_CHECK_CACHE_VERSION = 1;
+}  // namespace
+
+JavaCheckCache::JavaCheckCache(QString index_file) : m_index_file(std::move(index_file))
+{
+    load();
+}
+
+bool JavaCheckCache::lookup(const QString& path, JavaCheckResult& result)
+{
+    auto it = m_entries.constFind(QFileInfo(path).absoluteFilePath());
+    if (it == m_entries.constEnd())
+        return false;
+
+    auto identity = Hashing::FileIdentity::of(path);
+    if (!identity.isValid() || identity != it->identity)
+        return false;
+
+    result.mojangPlatform = it->mojangPlatform;
+    result.realPlatform = it->realPlatform;
+    result.javaVersion = it->javaVersion;
+    result.javaVendor = it->javaVendor;
+    result.outLog = it->outLog;
+    result.errorLog = it->errorLog;
+    result.is_64bit = it->is_64bit;
+    result.validity = JavaCheckResult::Validity::Valid;
+    return true;
+}
+
+void JavaCheckCache::insert(const QString& path, const JavaCheckResult& result)
+{
+    auto key = QFileInfo(path).absoluteFilePath();
+    auto identity = Hashing::FileIdentity::of(path);
+    if (result.validity != JavaCheckResult::Validity::Valid || !identity.isValid()) {
+        // don't keep anything around for a binary that's gone bad
+        if (m_entries.remove(key))
+            save();
+        return;
+    }
+
+    Entry entry;
+    entry.identity = identity;
+    entry.mojangPlatform = result.mojangPlatform;
+    entry.realPlatform = result.realPlatform;
+    entry.javaVersion = result.javaVersion.toString();
+    entry.javaVendor = result.javaVendor;
+    entry.outLog = result.outLog;
+    entry.errorLog = result.errorLog;
+    entry.is_64bit = result.is_64bit;
+    m_entries.insert(key, entry);
+    save();
+}
+
+void JavaCheckCache::load()
+{
+    QFile file(m_index_file);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic, version, count;
+    in >> magic >> version >> count;
+    if (in.status() != QDataStream::Ok || magic != JAVA_CHECK_CACHE_MAGIC || version != JAVA_CHECK_CACHE_VERSION) {
+        qWarning() << "Ignoring java check cache with unknown format:" << m_index_file;
+        return;
+    }
+
+    QHash<QString, Entry> entries;
+    for (quint32 i = 0; i < count; i++) {
+        QString path;
+        Entry entry;
+        in >> path >> entry.identity.size >> entry.identity.mtime >> entry.identity.inode >> entry.mojangPlatform >> entry.realPlatform >>
+            entry.javaVersion >> entry.javaVendor >> entry.outLog >> entry.errorLog >> entry.is_64bit;
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "Java check cache is corrupted, starting over:" << m_index_file;
+            return;
+        }
+        entries.insert(path, entry);
+    }
+    m_entries = entries;
+}
+
+void JavaCheckCache::save()
+{
+    QDir().mkpath(QFileInfo(m_index_file).absolutePath());
+
+    QSaveFile file(m_index_file);
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << "Failed to save java check cache:" << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+
+    out << JAVA_CHECK_CACHE_MAGIC << JAVA_CHECK_CACHE_VERSION << static_cast<quint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); it++) {
+        const auto& entry = it.value();
+        out << it.key() << entry.identity.size << entry.identity.mtime << entry.identity.inode << entry.mojangPlatform << entry.realPlatform
+            << entry.javaVersion << entry.javaVendor << entry.outLog << entry.errorLog << entry.is_64bit;
+    }
+
+    if (!file.commit())
+        qWarning() << "Failed to save java check cache:" << file.errorString();
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include "JavaChecker.h"
+#include "modplatform/helpers/HashCache.h"
+
+/** Persistent cache of what the java checker found out about java binaries.
+ *
+ *  Entries are keyed by the path of the binary, and are only used while it still has the identity it had when it was probed,
+ *  so updating or replacing a java install makes it get probed again.
+ *  Only plain checks of working installs are cached: anything that failed may well work next time around.
+ */
+class JavaCheckCache {
+   public:
+    explicit JavaCheckCache(QString index_file);
+
+    /* Fills in the result for the java binary at the given path, if it was probed before and hasn't changed since. */
+    bool lookup(const QString& path, JavaCheckResult& result);
+
+    /* Records a valid result of probing the java binary at the given path. */
+    void insert(const QString& path, const JavaCheckResult& result);
+
+   private:
+    struct Entry {
+        Hashing::FileIdentity identity;
+        QString mojangPlatform;
+        QString realPlatform;
+        QString javaVersion;
+        QString javaVendor;
+        QString outLog;
+        QString errorLog;
+        bool is_64bit = false;
+    };
+
+    void load();
+    void save();
+
+    QString m_index_file;
+    QHash<QString, Entry> m_entries;
+};
@@ -37,18 +37,45 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QHash>
 #include <QMap>
+#include <QPointer>
 #include <QProcess>
 
 #include "Application.h"
 #include "Commandline.h"
 #include "FileSystem.h"
+#include "JavaCheckCache.h"
 #include "JavaUtils.h"
 
+namespace {
+// the plain checks running right now, by binary, so another check of the same one can wait for it instead
+QHash<QString, QPointer<JavaChecker>> s_running;
+}  // namespace
+
 JavaChecker::JavaChecker(QObject* parent) : QObject(parent) {}
 
+bool JavaChecker::isPlainCheck() const
+{
+    // anything else is checking whether the settings work, not what the binary is
+    return m_args.isEmpty() && m_minMem == 0 && m_maxMem == 0 && m_permGen == 64;
+}
+
 void JavaChecker::performCheck()
 {
+    auto cache = APPLICATION->javaCheckCache();
+    if (cache && isPlainCheck()) {
+        JavaCheckResult result;
+        result.path = m_path;
+        result.id = m_id;
+        if (cache->lookup(m_path, result)) {
+            qDebug() << "Using cached java checker result for" << m_path;
+            // callers expect the result to arrive later on, like it does from the process
+            QMetaObject::invokeMethod(this, [this, result] { emit checkFinished(result); }, Qt::QueuedConnection);
+            return;
+        }
+    }
+
     QString checkerJar = JavaUtils::getJavaCheckPath();
 
     if (checkerJar.isEmpty()) {
@@ -59,6 +86,23 @@ void JavaChecker::performCheck()
     checkerJar = FS::getPathNameInLocal8bit(checkerJar);
 #endif
 
+    if (isPlainCheck()) {
+        if (auto running = s_running.value(m_path)) {
+            qDebug() << "Waiting for the running java checker of" << m_path;
+            connect(running, &JavaChecker::checkFinished, this, [this](JavaCheckResult result) {
+                result.id = m_id;
+                emit checkFinished(result);
+            });
+            return;
+        }
+        s_running.insert(m_path, this);
+        // connected before anyone waiting for this check is, so they can check again as soon as they hear of it
+        connect(this, &JavaChecker::checkFinished, this, [this, path = m_path] {
+            if (s_running.value(path) == this)
+                s_running.remove(path);
+        });
+    }
+
     QStringList args;
 
     process.reset(new QProcess());
@@ -178,6 +222,8 @@ void JavaChecker::finished(int exitcode, QProcess::ExitStatus status)
     result.javaVersion = java_version;
     result.javaVendor = java_vendor;
     qDebug() << "Java checker succeeded.";
+    if (auto cache = APPLICATION->javaCheckCache(); cache && isPlainCheck())
+        cache->insert(m_path, result);
     emit checkFinished(result);
 }
 
@@ -41,6 +41,8 @@ class JavaChecker : public QObject {
     void checkFinished(JavaCheckResult result);
 
    private:
+    bool isPlainCheck() const;
+
     QProcessPtr process;
     QTimer killTimer;
     QString m_stdout;
@@ -16,6 +16,15 @@
 #include "JavaCheckerJob.h"
 
 #include <QDebug>
+#include <QThread>
+
+namespace {
+// every check is a whole JVM starting up, and those aren't shy about using cores
+int maxConcurrentChecks()
+{
+    return qBound(1, QThread::idealThreadCount() / 2, 4);
+}
+}  // namespace
 
 void JavaCheckerJob::partFinished(JavaCheckResult result)
 {
@@ -24,18 +33,33 @@ void JavaCheckerJob::partFinished(JavaCheckResult result)
     setProgress(num_finished, javacheckers.size());
 
     javaresults.replace(result.id, result);
+    emit resultReady(result);
 
     if (num_finished == javacheckers.size()) {
         emitSucceeded();
+        return;
+    }
+    startNextChecks();
+}
+
+void JavaCheckerJob::startNextChecks()
+{
+    while (num_started < javacheckers.size() && num_started - num_finished < maxConcurrentChecks()) {
+        auto checker = javacheckers.at(num_started++);
+        connect(checker.get(), &JavaChecker::checkFinished, this, &JavaCheckerJob::partFinished);
+        checker->performCheck();
     }
 }
 
 void JavaCheckerJob::executeTask()
 {
     qDebug() << m_job_name.toLocal8Bit() << " started.";
-    for (auto iter : javacheckers) {
+    for (int i = 0; i < javacheckers.size(); i++) {
         javaresults.append(JavaCheckResult());
-        connect(iter.get(), &JavaChecker::checkFinished, this, &JavaCheckerJob::partFinished);
-        iter->performCheck();
     }
+    if (javacheckers.isEmpty()) {
+        emitSucceeded();
+        return;
+    }
+    startNextChecks();
 }
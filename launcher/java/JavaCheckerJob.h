@@ -32,19 +32,26 @@ class JavaCheckerJob : public Task {
     bool addJavaCheckerAction(JavaCheckerPtr base)
     {
         javacheckers.append(base);
-        // if this is already running, the action needs to be started right away!
+        // if this is already running, the action needs to be queued up right away!
         if (isRunning()) {
+            javaresults.append(JavaCheckResult());
             setProgress(num_finished, javacheckers.size());
-            connect(base.get(), &JavaChecker::checkFinished, this, &JavaCheckerJob::partFinished);
-            base->performCheck();
+            startNextChecks();
         }
         return true;
     }
     QList<JavaCheckResult> getResults() { return javaresults; }
 
+   signals:
+    /* Emitted for each check as soon as it's done, so results can be shown before the whole job is. */
+    void resultReady(JavaCheckResult result);
+
    private slots:
     void partFinished(JavaCheckResult result);
 
+   private:
+    void startNextChecks();
+
    protected:
     virtual void executeTask() override;
 
@@ -53,4 +60,5 @@ class JavaCheckerJob : public Task {
     QList<JavaCheckerPtr> javacheckers;
     QList<JavaCheckResult> javaresults;
     int num_finished = 0;
+    int num_started = 0;
 };
@@ -38,6 +38,7 @@
 #include <QtXml>
 
 #include <QDebug>
+#include <QtConcurrentRun>
 
 #include "java/JavaCheckerJob.h"
 #include "java/JavaInstallList.h"
@@ -146,6 +147,24 @@ void JavaInstallList::sortVersions()
     endResetModel();
 }
 
+void JavaInstallList::addLoadedInstall(JavaInstallPtr install)
+{
+    int row = static_cast<int>(std::upper_bound(m_vlist.begin(), m_vlist.end(), install, sortJavas) - m_vlist.begin());
+    beginInsertRows(QModelIndex(), row, row);
+    m_vlist.insert(row, install);
+    endInsertRows();
+}
+
+static JavaInstallPtr makeInstall(const JavaCheckResult& result)
+{
+    JavaInstallPtr javaVersion(new JavaInstall());
+
+    javaVersion->id = result.javaVersion;
+    javaVersion->arch = result.realPlatform;
+    javaVersion->path = result.path;
+    return javaVersion;
+}
+
 JavaListLoadTask::JavaListLoadTask(JavaInstallList* vlist) : Task()
 {
     m_list = vlist;
@@ -158,12 +177,26 @@ void JavaListLoadTask::executeTask()
 {
     setStatus(tr("Detecting Java installations..."));
 
-    JavaUtils ju;
-    QList<QString> candidate_paths = ju.FindJavaPaths();
+    // looking for javas means going through a lot of places on disk, don't do it on the GUI thread
+    connect(&m_pathsWatcher, &QFutureWatcher<QList<QString>>::finished, this, &JavaListLoadTask::javaPathsFound, Qt::UniqueConnection);
+    m_pathsWatcher.setFuture(QtConcurrent::run([] {
+        JavaUtils ju;
+        return ju.FindJavaPaths();
+    }));
+}
+
+void JavaListLoadTask::javaPathsFound()
+{
+    QList<QString> candidate_paths = m_pathsWatcher.result();
 
     m_job.reset(new JavaCheckerJob("Java detection"));
     connect(m_job.get(), &Task::finished, this, &JavaListLoadTask::javaCheckerFinished);
     connect(m_job.get(), &Task::progress, this, &Task::setProgress);
+    connect(m_job.get(), &JavaCheckerJob::resultReady, this, [this](JavaCheckResult result) {
+        if (result.validity == JavaCheckResult::Validity::Valid) {
+            m_list->addLoadedInstall(makeInstall(result));
+        }
+    });
 
     qDebug() << "Probing the following Java paths: ";
     int id = 0;
@@ -189,11 +222,7 @@ void JavaListLoadTask::javaCheckerFinished()
     qDebug() << "Found the following valid Java installations:";
     for (JavaCheckResult result : results) {
         if (result.validity == JavaCheckResult::Validity::Valid) {
-            JavaInstallPtr javaVersion(new JavaInstall());
-
-            javaVersion->id = result.javaVersion;
-            javaVersion->arch = result.realPlatform;
-            javaVersion->path = result.path;
+            JavaInstallPtr javaVersion = makeInstall(result);
             candidates.append(javaVersion);
 
             qDebug() << " " << javaVersion->id.toString() << javaVersion->arch << javaVersion->path;
@@ -18,6 +18,8 @@
 #include <QAbstractListModel>
 #include <QObject>
 
+#include <QFutureWatcher>
+
 #include "BaseVersionList.h"
 #include "tasks/Task.h"
 
@@ -46,6 +48,8 @@ class JavaInstallList : public BaseVersionList {
 
    public slots:
     void updateListData(QList<BaseVersion::Ptr> versions) override;
+    /* Shows a java install found while the list is still being loaded. */
+    void addLoadedInstall(JavaInstallPtr install);
 
    protected:
     void load();
@@ -66,9 +70,11 @@ class JavaListLoadTask : public Task {
 
     void executeTask() override;
    public slots:
+    void javaPathsFound();
     void javaCheckerFinished();
 
    protected:
+    QFutureWatcher<QList<QString>> m_pathsWatcher;
     shared_qobject_ptr<JavaCheckerJob> m_job;
     JavaInstallList* m_list;
     JavaInstall* m_currentRecommended;
@@ -33,10 +33,15 @@
  *      limitations under the License.
  */
 
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QString>
 #include <QStringList>
+#include <QtConcurrentMap>
 
 #include <settings/Setting.h>
 
@@ -48,6 +53,47 @@
 
 #define IBUS "@im=ibus"
 
+namespace {
+struct DirEntry {
+    QString name;
+    QString canonicalPath;
+};
+
+struct DirListing {
+    QDateTime modified;
+    QList<DirEntry> entries;
+};
+
+QMutex s_dirListingsMutex;
+QHash<QString, DirListing> s_dirListings;
+
+/* The subdirectories of a directory java installs are looked for in, remembered for as long as the directory doesn't change. */
+QList<DirEntry> javaDirEntries(const QString& dirPath)
+{
+    QFileInfo info(dirPath);
+    if (!info.isDir())
+        return {};
+
+    auto path = info.absoluteFilePath();
+    auto modified = info.lastModified();
+    {
+        QMutexLocker locker(&s_dirListingsMutex);
+        auto it = s_dirListings.constFind(path);
+        if (it != s_dirListings.constEnd() && it->modified == modified)
+            return it->entries;
+    }
+
+    QList<DirEntry> entries;
+    for (auto& entry : QDir(path).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        entries.append({ entry.fileName(), entry.canonicalFilePath() });
+    }
+
+    QMutexLocker locker(&s_dirListingsMutex);
+    s_dirListings.insert(path, { modified, entries });
+    return entries;
+}
+}  // namespace
+
 JavaUtils::JavaUtils() {}
 
 QString stripVariableEntries(QString name, QString target, QString remove)
@@ -243,89 +289,114 @@ QList<QString> JavaUtils::FindJavaPaths()
 {
     QList<JavaInstallPtr> java_candidates;
 
-    // Oracle
-    QList<JavaInstallPtr> JRE64s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\JavaSoft\\Java Runtime Environment", "JavaHome");
-    QList<JavaInstallPtr> JDK64s = this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\JavaSoft\\Java Development Kit", "JavaHome");
-    QList<JavaInstallPtr> JRE32s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\JavaSoft\\Java Runtime Environment", "JavaHome");
-    QList<JavaInstallPtr> JDK32s = this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\JavaSoft\\Java Development Kit", "JavaHome");
-
-    // Oracle for Java 9 and newer
-    QList<JavaInstallPtr> NEWJRE64s = this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\JavaSoft\\JRE", "JavaHome");
-    QList<JavaInstallPtr> NEWJDK64s = this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\JavaSoft\\JDK", "JavaHome");
-    QList<JavaInstallPtr> NEWJRE32s = this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\JavaSoft\\JRE", "JavaHome");
-    QList<JavaInstallPtr> NEWJDK32s = this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\JavaSoft\\JDK", "JavaHome");
-
-    // AdoptOpenJDK
-    QList<JavaInstallPtr> ADOPTOPENJRE32s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\AdoptOpenJDK\\JRE", "Path", "\\hotspot\\MSI");
-    QList<JavaInstallPtr> ADOPTOPENJRE64s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\AdoptOpenJDK\\JRE", "Path", "\\hotspot\\MSI");
-    QList<JavaInstallPtr> ADOPTOPENJDK32s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\AdoptOpenJDK\\JDK", "Path", "\\hotspot\\MSI");
-    QList<JavaInstallPtr> ADOPTOPENJDK64s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\AdoptOpenJDK\\JDK", "Path", "\\hotspot\\MSI");
-
-    // Eclipse Foundation
-    QList<JavaInstallPtr> FOUNDATIONJDK32s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\Eclipse Foundation\\JDK", "Path", "\\hotspot\\MSI");
-    QList<JavaInstallPtr> FOUNDATIONJDK64s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\Eclipse Foundation\\JDK", "Path", "\\hotspot\\MSI");
-
-    // Eclipse Adoptium
-    QList<JavaInstallPtr> ADOPTIUMJRE32s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\Eclipse Adoptium\\JRE", "Path", "\\hotspot\\MSI");
-    QList<JavaInstallPtr> ADOPTIUMJRE64s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\Eclipse Adoptium\\JRE", "Path", "\\hotspot\\MSI");
-    QList<JavaInstallPtr> ADOPTIUMJDK32s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\Eclipse Adoptium\\JDK", "Path", "\\hotspot\\MSI");
-    QList<JavaInstallPtr> ADOPTIUMJDK64s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\Eclipse Adoptium\\JDK", "Path", "\\hotspot\\MSI");
-
-    // Microsoft
-    QList<JavaInstallPtr> MICROSOFTJDK64s =
-        this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\Microsoft\\JDK", "Path", "\\hotspot\\MSI");
-
-    // Azul Zulu
-    QList<JavaInstallPtr> ZULU64s = this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\Azul Systems\\Zulu", "InstallationPath");
-    QList<JavaInstallPtr> ZULU32s = this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\Azul Systems\\Zulu", "InstallationPath");
-
-    // BellSoft Liberica
-    QList<JavaInstallPtr> LIBERICA64s = this->FindJavaFromRegistryKey(KEY_WOW64_64KEY, "SOFTWARE\\BellSoft\\Liberica", "InstallationPath");
-    QList<JavaInstallPtr> LIBERICA32s = this->FindJavaFromRegistryKey(KEY_WOW64_32KEY, "SOFTWARE\\BellSoft\\Liberica", "InstallationPath");
+    struct RegistryQuery {
+        DWORD keyType;
+        QString keyName;
+        QString keyJavaDir;
+        QString subkeySuffix;
+    };
+    enum {
+        // Oracle
+        JRE64s,
+        JDK64s,
+        JRE32s,
+        JDK32s,
+        // Oracle for Java 9 and newer
+        NEWJRE64s,
+        NEWJDK64s,
+        NEWJRE32s,
+        NEWJDK32s,
+        // AdoptOpenJDK
+        ADOPTOPENJRE32s,
+        ADOPTOPENJRE64s,
+        ADOPTOPENJDK32s,
+        ADOPTOPENJDK64s,
+        // Eclipse Foundation
+        FOUNDATIONJDK32s,
+        FOUNDATIONJDK64s,
+        // Eclipse Adoptium
+        ADOPTIUMJRE32s,
+        ADOPTIUMJRE64s,
+        ADOPTIUMJDK32s,
+        ADOPTIUMJDK64s,
+        // Microsoft
+        MICROSOFTJDK64s,
+        // Azul Zulu
+        ZULU64s,
+        ZULU32s,
+        // BellSoft Liberica
+        LIBERICA64s,
+        LIBERICA32s,
+    };
+    // in the same order as above
+    const QList<RegistryQuery> queries = {
+        { KEY_WOW64_64KEY, "SOFTWARE\\JavaSoft\\Java Runtime Environment", "JavaHome" },
+        { KEY_WOW64_64KEY, "SOFTWARE\\JavaSoft\\Java Development Kit", "JavaHome" },
+        { KEY_WOW64_32KEY, "SOFTWARE\\JavaSoft\\Java Runtime Environment", "JavaHome" },
+        { KEY_WOW64_32KEY, "SOFTWARE\\JavaSoft\\Java Development Kit", "JavaHome" },
+
+        { KEY_WOW64_64KEY, "SOFTWARE\\JavaSoft\\JRE", "JavaHome" },
+        { KEY_WOW64_64KEY, "SOFTWARE\\JavaSoft\\JDK", "JavaHome" },
+        { KEY_WOW64_32KEY, "SOFTWARE\\JavaSoft\\JRE", "JavaHome" },
+        { KEY_WOW64_32KEY, "SOFTWARE\\JavaSoft\\JDK", "JavaHome" },
+
+        { KEY_WOW64_32KEY, "SOFTWARE\\AdoptOpenJDK\\JRE", "Path", "\\hotspot\\MSI" },
+        { KEY_WOW64_64KEY, "SOFTWARE\\AdoptOpenJDK\\JRE", "Path", "\\hotspot\\MSI" },
+        { KEY_WOW64_32KEY, "SOFTWARE\\AdoptOpenJDK\\JDK", "Path", "\\hotspot\\MSI" },
+        { KEY_WOW64_64KEY, "SOFTWARE\\AdoptOpenJDK\\JDK", "Path", "\\hotspot\\MSI" },
+
+        { KEY_WOW64_32KEY, "SOFTWARE\\Eclipse Foundation\\JDK", "Path", "\\hotspot\\MSI" },
+        { KEY_WOW64_64KEY, "SOFTWARE\\Eclipse Foundation\\JDK", "Path", "\\hotspot\\MSI" },
+
+        { KEY_WOW64_32KEY, "SOFTWARE\\Eclipse Adoptium\\JRE", "Path", "\\hotspot\\MSI" },
+        { KEY_WOW64_64KEY, "SOFTWARE\\Eclipse Adoptium\\JRE", "Path", "\\hotspot\\MSI" },
+        { KEY_WOW64_32KEY, "SOFTWARE\\Eclipse Adoptium\\JDK", "Path", "\\hotspot\\MSI" },
+        { KEY_WOW64_64KEY, "SOFTWARE\\Eclipse Adoptium\\JDK", "Path", "\\hotspot\\MSI" },
+
+        { KEY_WOW64_64KEY, "SOFTWARE\\Microsoft\\JDK", "Path", "\\hotspot\\MSI" },
+
+        { KEY_WOW64_64KEY, "SOFTWARE\\Azul Systems\\Zulu", "InstallationPath" },
+        { KEY_WOW64_32KEY, "SOFTWARE\\Azul Systems\\Zulu", "InstallationPath" },
+
+        { KEY_WOW64_64KEY, "SOFTWARE\\BellSoft\\Liberica", "InstallationPath" },
+        { KEY_WOW64_32KEY, "SOFTWARE\\BellSoft\\Liberica", "InstallationPath" },
+    };
+    // every vendor has its own keys, so go through them all at once
+    auto found = QtConcurrent::blockingMapped<QList<QList<JavaInstallPtr>>>(queries, [this](const RegistryQuery& query) {
+        return this->FindJavaFromRegistryKey(query.keyType, query.keyName, query.keyJavaDir, query.subkeySuffix);
+    });
 
     // List x64 before x86
-    java_candidates.append(JRE64s);
-    java_candidates.append(NEWJRE64s);
-    java_candidates.append(ADOPTOPENJRE64s);
-    java_candidates.append(ADOPTIUMJRE64s);
+    java_candidates.append(found[JRE64s]);
+    java_candidates.append(found[NEWJRE64s]);
+    java_candidates.append(found[ADOPTOPENJRE64s]);
+    java_candidates.append(found[ADOPTIUMJRE64s]);
     java_candidates.append(MakeJavaPtr("C:/Program Files/Java/jre8/bin/javaw.exe"));
     java_candidates.append(MakeJavaPtr("C:/Program Files/Java/jre7/bin/javaw.exe"));
     java_candidates.append(MakeJavaPtr("C:/Program Files/Java/jre6/bin/javaw.exe"));
-    java_candidates.append(JDK64s);
-    java_candidates.append(NEWJDK64s);
-    java_candidates.append(ADOPTOPENJDK64s);
-    java_candidates.append(FOUNDATIONJDK64s);
-    java_candidates.append(ADOPTIUMJDK64s);
-    java_candidates.append(MICROSOFTJDK64s);
-    java_candidates.append(ZULU64s);
-    java_candidates.append(LIBERICA64s);
-
-    java_candidates.append(JRE32s);
-    java_candidates.append(NEWJRE32s);
-    java_candidates.append(ADOPTOPENJRE32s);
-    java_candidates.append(ADOPTIUMJRE32s);
+    java_candidates.append(found[JDK64s]);
+    java_candidates.append(found[NEWJDK64s]);
+    java_candidates.append(found[ADOPTOPENJDK64s]);
+    java_candidates.append(found[FOUNDATIONJDK64s]);
+    java_candidates.append(found[ADOPTIUMJDK64s]);
+    java_candidates.append(found[MICROSOFTJDK64s]);
+    java_candidates.append(found[ZULU64s]);
+    java_candidates.append(found[LIBERICA64s]);
+
+    java_candidates.append(found[JRE32s]);
+    java_candidates.append(found[NEWJRE32s]);
+    java_candidates.append(found[ADOPTOPENJRE32s]);
+    java_candidates.append(found[ADOPTIUMJRE32s]);
     java_candidates.append(MakeJavaPtr("C:/Program Files (x86)/Java/jre8/bin/javaw.exe"));
     java_candidates.append(MakeJavaPtr("C:/Program Files (x86)/Java/jre7/bin/javaw.exe"));
     java_candidates.append(MakeJavaPtr("C:/Program Files (x86)/Java/jre6/bin/javaw.exe"));
-    java_candidates.append(JDK32s);
-    java_candidates.append(NEWJDK32s);
-    java_candidates.append(ADOPTOPENJDK32s);
-    java_candidates.append(FOUNDATIONJDK32s);
-    java_candidates.append(ADOPTIUMJDK32s);
-    java_candidates.append(ZULU32s);
-    java_candidates.append(LIBERICA32s);
+    java_candidates.append(found[JDK32s]);
+    java_candidates.append(found[NEWJDK32s]);
+    java_candidates.append(found[ADOPTOPENJDK32s]);
+    java_candidates.append(found[FOUNDATIONJDK32s]);
+    java_candidates.append(found[ADOPTIUMJDK32s]);
+    java_candidates.append(found[ZULU32s]);
+    java_candidates.append(found[LIBERICA32s]);
 
     java_candidates.append(MakeJavaPtr(this->GetDefaultJava()->path));
 
@@ -351,16 +422,14 @@ QList<QString> JavaUtils::FindJavaPaths()
     javas.append("/Library/Internet Plug-Ins/JavaAppletPlugin.plugin/Contents/Home/bin/java");
     javas.append("/System/Library/Frameworks/JavaVM.framework/Versions/Current/Commands/java");
     QDir libraryJVMDir("/Library/Java/JavaVirtualMachines/");
-    QStringList libraryJVMJavas = libraryJVMDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    foreach (const QString& java, libraryJVMJavas) {
-        javas.append(libraryJVMDir.absolutePath() + "/" + java + "/Contents/Home/bin/java");
-        javas.append(libraryJVMDir.absolutePath() + "/" + java + "/Contents/Home/jre/bin/java");
+    for (auto& java : javaDirEntries(libraryJVMDir.absolutePath())) {
+        javas.append(libraryJVMDir.absolutePath() + "/" + java.name + "/Contents/Home/bin/java");
+        javas.append(libraryJVMDir.absolutePath() + "/" + java.name + "/Contents/Home/jre/bin/java");
     }
     QDir systemLibraryJVMDir("/System/Library/Java/JavaVirtualMachines/");
-    QStringList systemLibraryJVMJavas = systemLibraryJVMDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    foreach (const QString& java, systemLibraryJVMJavas) {
-        javas.append(systemLibraryJVMDir.absolutePath() + "/" + java + "/Contents/Home/bin/java");
-        javas.append(systemLibraryJVMDir.absolutePath() + "/" + java + "/Contents/Commands/java");
+    for (auto& java : javaDirEntries(systemLibraryJVMDir.absolutePath())) {
+        javas.append(systemLibraryJVMDir.absolutePath() + "/" + java.name + "/Contents/Home/bin/java");
+        javas.append(systemLibraryJVMDir.absolutePath() + "/" + java.name + "/Contents/Commands/java");
     }
 
     auto home = qEnvironmentVariable("HOME");
@@ -379,48 +448,49 @@ QList<QString> JavaUtils::FindJavaPaths()
 {
     QList<QString> javas;
     javas.append(this->GetDefaultJava()->path);
-    auto scanJavaDir = [&](const QString& dirPath) {
-        QDir dir(dirPath);
-        if (!dir.exists())
-            return;
-        auto entries = dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
-        for (auto& entry : entries) {
-            QString prefix;
-            prefix = entry.canonicalFilePath();
-            javas.append(FS::PathCombine(prefix, "jre/bin/java"));
-            javas.append(FS::PathCombine(prefix, "bin/java"));
-        }
+
+    auto home = qEnvironmentVariable("HOME");
+    QStringList javaDirs = {
+        // oracle RPMs
+        "/usr/java",
+        // general locations used by distro packaging
+        "/usr/lib/jvm",
+        "/usr/lib64/jvm",
+        "/usr/lib32/jvm",
+        // javas stored in Prism Launcher's folder
+        "java",
+        // manually installed JDKs in /opt
+        "/opt/jdk",
+        "/opt/jdks",
+        // flatpak
+        "/app/jdk",
+        // javas downloaded by IntelliJ
+        FS::PathCombine(home, ".jdks"),
+        // javas downloaded by sdkman
+        FS::PathCombine(home, ".sdkman/candidates/java"),
+        // javas downloaded by gradle (toolchains)
+        FS::PathCombine(home, ".gradle/jdks"),
     };
     // java installed in a snap is installed in the standard directory, but underneath $SNAP
     auto snap = qEnvironmentVariable("SNAP");
-    auto scanJavaDirs = [&](const QString& dirPath) {
-        scanJavaDir(dirPath);
-        if (!snap.isNull()) {
-            scanJavaDir(snap + dirPath);
+    if (!snap.isNull()) {
+        for (int i = javaDirs.size() - 1; i >= 0; i--) {
+            javaDirs.insert(i + 1, snap + javaDirs.at(i));
         }
-    };
-    // oracle RPMs
-    scanJavaDirs("/usr/java");
-    // general locations used by distro packaging
-    scanJavaDirs("/usr/lib/jvm");
-    scanJavaDirs("/usr/lib64/jvm");
-    scanJavaDirs("/usr/lib32/jvm");
-    // javas stored in Prism Launcher's folder
-    scanJavaDirs("java");
-    // manually installed JDKs in /opt
-    scanJavaDirs("/opt/jdk");
-    scanJavaDirs("/opt/jdks");
-    // flatpak
-    scanJavaDirs("/app/jdk");
-
-    auto home = qEnvironmentVariable("HOME");
+    }
 
-    // javas downloaded by IntelliJ
-    scanJavaDirs(FS::PathCombine(home, ".jdks"));
-    // javas downloaded by sdkman
-    scanJavaDirs(FS::PathCombine(home, ".sdkman/candidates/java"));
-    // javas downloaded by gradle (toolchains)
-    scanJavaDirs(FS::PathCombine(home, ".gradle/jdks"));
+    // these are all over the place, possibly on slow or network backed disks, so look at them all at once
+    auto scanned = QtConcurrent::blockingMapped<QList<QStringList>>(javaDirs, [](const QString& dirPath) {
+        QStringList found;
+        for (auto& entry : javaDirEntries(dirPath)) {
+            found.append(FS::PathCombine(entry.canonicalPath, "jre/bin/java"));
+            found.append(FS::PathCombine(entry.canonicalPath, "bin/java"));
+        }
+        return found;
+    });
+    for (auto& found : scanned) {
+        javas.append(found);
+    }
 
     javas.append(getMinecraftJavaBundle());
     javas = addJavasFromEnv(javas);
@@ -470,21 +540,18 @@ QStringList getMinecraftJavaBundle()
     QStringList javas;
     while (!processpaths.isEmpty()) {
         auto dirPath = processpaths.takeFirst();
-        QDir dir(dirPath);
-        if (!dir.exists())
-            continue;
-        auto entries = dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+        auto entries = javaDirEntries(dirPath);
         auto binFound = false;
         for (auto& entry : entries) {
-            if (entry.baseName() == "bin") {
-                javas.append(FS::PathCombine(entry.canonicalFilePath(), executable));
+            if (entry.name.section('.', 0, 0) == "bin") {
+                javas.append(FS::PathCombine(entry.canonicalPath, executable));
                 binFound = true;
                 break;
             }
         }
         if (!binFound) {
             for (auto& entry : entries) {
-                processpaths << entry.canonicalFilePath();
+                processpaths << entry.canonicalPath;
             }
         }
     }
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "JvmTuning.h"
+
+#include <QFile>
+#include <QThread>
+
+#include <sys.h>
+
+namespace JvmTuning {
+
+namespace {
+
+// what vanilla needs comfortably, and what every mod adds on average
+constexpr int BASE_HEAP_MIB = 2048;
+constexpr int HEAP_PER_MOD_MIB = 16;
+// a bigger heap only makes the collections longer
+constexpr int MAX_HEAP_MIB = 16384;
+// what's left for the system and the game's off-heap memory
+constexpr int RESERVED_MIB = 2048;
+
+int roundUp(int value, int step)
+{
+    return (value + step - 1) / step * step;
+}
+
+bool choosesCollector(const QStringList& arguments)
+{
+    for (auto& argument : arguments) {
+        if (argument.startsWith("-XX:+Use") && argument.endsWith("GC"))
+            return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+QString Profile::describe() const
+{
+    auto heap = QString("%1-%2 MiB heap").arg(minHeapMiB).arg(maxHeapMiB);
+    return flags.isEmpty() ? heap : heap + ", " + flags.join(' ');
+}
+
+Machine currentMachine()
+{
+    Machine machine;
+    machine.memoryMiB = Sys::getSystemRam() / Sys::mebibyte;
+    machine.cpus = qMax(1, QThread::idealThreadCount());
+#ifdef Q_OS_LINUX
+    // only usable when it's not disabled entirely
+    QFile thp("/sys/kernel/mm/transparent_hugepage/enabled");
+    if (thp.open(QIODevice::ReadOnly))
+        machine.transparentHugePages = !thp.readAll().contains("[never]");
+#endif
+    return machine;
+}
+
+Profile choose(const Machine& machine, Game game)
+{
+    Profile profile;
+
+    int available = static_cast<int>(qMin<uint64_t>(machine.memoryMiB, INT32_MAX));
+    int limit = qMax(1024, qMin(MAX_HEAP_MIB, available - RESERVED_MIB));
+    if (!game.is64bit)
+        limit = qMin(limit, 1024);
+
+    profile.maxHeapMiB = qMin(limit, roundUp(BASE_HEAP_MIB + game.mods * HEAP_PER_MOD_MIB, 512));
+    // give the rest back to the system when the game doesn't use it, but don't make it grow from nothing
+    profile.minHeapMiB = qMax(512, roundUp(profile.maxHeapMiB / 2, 256));
+
+    // OpenJ9 has collectors of its own, and the user may have chosen one already
+    if (game.javaVersion.major() < 8 || game.javaVendor.contains("OpenJ9") || game.javaVendor.contains("IBM") ||
+        choosesCollector(game.userArguments))
+        return profile;
+
+    if (game.javaVersion.major() >= 21 && profile.maxHeapMiB >= 8192 && machine.cpus >= 4) {
+        // generational ZGC keeps pauses short on big heaps, and is the only mode left from Java 23 on
+        profile.flags << "-XX:+UseZGC";
+        if (game.javaVersion.major() < 23)
+            profile.flags << "-XX:+ZGenerational";
+    } else {
+        profile.flags << "-XX:+UseG1GC"
+                      << "-XX:MaxGCPauseMillis=50"
+                      // the game allocates a lot of large arrays, bigger regions keep them out of the humongous ones
+                      << QString("-XX:G1HeapRegionSize=%1M").arg(profile.maxHeapMiB >= 12288 ? 16 : 8) << "-XX:+ParallelRefProcEnabled";
+    }
+    // mods like to call System.gc() when loading worlds, which stops everything for a full collection
+    profile.flags << "-XX:+DisableExplicitGC";
+
+    if (machine.transparentHugePages)
+        profile.flags << "-XX:+UseTransparentHugePages";
+
+    return profile;
+}
+
+}  // namespace JvmTuning
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+
+#include "java/JavaVersion.h"
+
+/** Picks the heap size and garbage collector flags for a game, so that users don't have to tune them by hand. */
+namespace JvmTuning {
+
+struct Machine {
+    uint64_t memoryMiB = 0;
+    int cpus = 1;
+    bool transparentHugePages = false;
+};
+
+struct Game {
+    JavaVersion javaVersion;
+    // empty for HotSpot based ones, which is all of them but OpenJ9
+    QString javaVendor;
+    bool is64bit = true;
+    int mods = 0;
+    // flags the user passes to Java, which take precedence
+    QStringList userArguments;
+};
+
+struct Profile {
+    int minHeapMiB = 0;
+    int maxHeapMiB = 0;
+    QStringList flags;
+
+    /** The profile in a few words, for the launch log. */
+    QString describe() const;
+};
+
+/** What this machine has to offer. */
+Machine currentMachine();
+
+Profile choose(const Machine& machine, Game game);
+
+}  // namespace JvmTuning
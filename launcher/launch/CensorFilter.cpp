@@ -0,0 +1,123 @@
+#include "CensorFilter.h"
+
+#include <QQueue>
+
+#include <algorithm>
+
+CensorFilter::CensorFilter(const QMap<QString, QString>& replacements)
+{
+    m_nodes.append(Node());
+
+    // build the trie
+    for (auto iter = replacements.begin(); iter != replacements.end(); iter++) {
+        const auto& key = iter.key();
+        if (key.isEmpty())
+            continue;
+
+        int node = 0;
+        for (auto c : key) {
+            int next = child(node, c);
+            if (next == -1) {
+                next = m_nodes.size();
+                m_nodes.append(Node());
+                auto& children = m_nodes[node].children;
+                auto pos = std::lower_bound(children.begin(), children.end(), c,
+                                            [](const QPair<QChar, int>& entry, QChar value) { return entry.first < value; });
+                children.insert(pos, { c, next });
+            }
+            node = next;
+        }
+        m_nodes[node].key = m_keys.size();
+        m_keys.append(key);
+        m_replacements.append(iter.value());
+    }
+
+    // link every node to the longest proper suffix of it that is also in the trie, breadth first so the suffixes are done
+    // before the nodes that need them
+    QQueue<int> queue;
+    for (auto& entry : m_nodes[0].children)
+        queue.enqueue(entry.second);
+    while (!queue.isEmpty()) {
+        int node = queue.dequeue();
+        for (auto& entry : m_nodes[node].children) {
+            int next = entry.second;
+            int fail = m_nodes[node].fail;
+            int target = child(fail, entry.first);
+            while (target == -1 && fail != 0) {
+                fail = m_nodes[fail].fail;
+                target = child(fail, entry.first);
+            }
+            fail = target == -1 ? 0 : target;
+            m_nodes[next].fail = fail;
+            m_nodes[next].output = m_nodes[fail].key != -1 ? fail : m_nodes[fail].output;
+            queue.enqueue(next);
+        }
+    }
+}
+
+int CensorFilter::child(int node, QChar c) const
+{
+    const auto& children = m_nodes[node].children;
+    auto pos = std::lower_bound(children.begin(), children.end(), c,
+                                [](const QPair<QChar, int>& entry, QChar value) { return entry.first < value; });
+    if (pos == children.end() || pos->first != c)
+        return -1;
+    return pos->second;
+}
+
+int CensorFilter::step(int node, QChar c) const
+{
+    int next = child(node, c);
+    while (next == -1 && node != 0) {
+        node = m_nodes[node].fail;
+        next = child(node, c);
+    }
+    return next == -1 ? 0 : next;
+}
+
+QString CensorFilter::apply(const QString& in) const
+{
+    if (m_keys.isEmpty())
+        return in;
+
+    // matches to replace, as (start, key) pairs, sorted and not overlapping
+    QVector<QPair<int, int>> found;
+    int node = 0;
+    for (int i = 0; i < in.size(); i++) {
+        node = step(node, in[i]);
+
+        // try the strings ending here from the longest one down, until one fits
+        int candidate = m_nodes[node].key != -1 ? node : m_nodes[node].output;
+        while (candidate != -1) {
+            int key = m_nodes[candidate].key;
+            int start = i - m_keys[key].size() + 1;
+
+            // matches are found by where they end, so the ones that start after this one are inside it
+            int keep = found.size();
+            while (keep > 0 && found[keep - 1].first >= start)
+                keep--;
+            if (keep > 0 && found[keep - 1].first + m_keys[found[keep - 1].second].size() > start) {
+                // overlaps a match that starts first
+                candidate = m_nodes[candidate].output;
+                continue;
+            }
+            found.resize(keep);
+            found.append({ start, key });
+            break;
+        }
+    }
+
+    if (found.isEmpty())
+        return in;
+
+    QString out;
+    out.reserve(in.size());
+    int pos = 0;
+    for (auto& entry : found) {
+        out.append(in.constData() + pos, entry.first - pos);
+        out.append(m_replacements[entry.second]);
+        pos = entry.first + m_keys[entry.second].size();
+    }
+    out.append(in.constData() + pos, in.size() - pos);
+    return out;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+/**
+ * Replaces a set of strings (access tokens, profile IDs...) all at once.
+ *
+ * The strings are compiled into an Aho-Corasick automaton, so a line is scanned only once no matter how many strings
+ * there are, and it is only copied when something has to be replaced.
+ * Where two strings overlap, the one starting first (or the longest one, if they start at the same place) wins.
+ */
+class CensorFilter {
+   public:
+    CensorFilter() = default;
+    explicit CensorFilter(const QMap<QString, QString>& replacements);
+
+    bool isEmpty() const { return m_replacements.isEmpty(); }
+
+    QString apply(const QString& in) const;
+
+   private:
+    struct Node {
+        // sorted by character
+        QVector<QPair<QChar, int>> children;
+        int fail = 0;
+        // the string ending at this node, -1 if none
+        int key = -1;
+        // the closest node down the fail links that ends a string, -1 if none
+        int output = -1;
+    };
+
+    int child(int node, QChar c) const;
+    int step(int node, QChar c) const;
+
+   private:
+    QVector<Node> m_nodes;
+    QVector<QString> m_keys;
+    QVector<QString> m_replacements;
+};
@@ -27,6 +27,9 @@ class LaunchStep : public Task {
     explicit LaunchStep(LaunchTask* parent) : Task(nullptr), m_parent(parent) { bind(parent); };
     virtual ~LaunchStep(){};
 
+    /// whether this is the step that runs the game, the launch is timed up to its first log line
+    virtual bool startsGame() const { return false; }
+
    private: /* methods */
     void bind(LaunchTask* parent);
 
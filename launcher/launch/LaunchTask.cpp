@@ -71,6 +71,17 @@ void LaunchTask::prependStep(shared_qobject_ptr<LaunchStep> step)
     m_steps.prepend(step);
 }
 
+void LaunchTask::insertStepBeforeGame(shared_qobject_ptr<LaunchStep> step)
+{
+    for (int i = 0; i < m_steps.size(); i++) {
+        if (m_steps[i]->startsGame()) {
+            m_steps.insert(i, step);
+            return;
+        }
+    }
+    m_steps.append(step);
+}
+
 void LaunchTask::executeTask()
 {
     m_instance->setCrashed(false);
@@ -79,6 +90,8 @@ void LaunchTask::executeTask()
         emitSucceeded();
     }
     state = LaunchTask::Running;
+    m_timings.started = QDateTime::currentDateTime();
+    m_launchTimer.start();
     onStepFinished();
 }
 
@@ -92,28 +105,68 @@ void LaunchTask::onStepFinished()
 {
     // initial -> just start the first step
     if (currentStep == -1) {
-        currentStep++;
-        m_steps[currentStep]->start();
+        startStep(0);
         return;
     }
 
     auto step = m_steps[currentStep];
+    recordStepTiming();
     if (step->wasSuccessful()) {
         // end?
         if (currentStep == m_steps.size() - 1) {
             finalizeSteps(true, QString());
         } else {
-            currentStep++;
-            step = m_steps[currentStep];
-            step->start();
+            startStep(currentStep + 1);
         }
     } else {
         finalizeSteps(false, step->failReason());
     }
 }
 
+void LaunchTask::startStep(int index)
+{
+    currentStep = index;
+    m_stepTimer.start();
+    m_steps[currentStep]->start();
+}
+
+void LaunchTask::recordStepTiming()
+{
+    // everything after the game started is not part of the launch
+    if (m_timingsReported)
+        return;
+    m_timings.steps.append({ m_steps[currentStep]->metaObject()->className(), m_stepTimer.elapsed() });
+}
+
+void LaunchTask::checkFirstGameLine(MessageLevel::Enum level)
+{
+    // the steps log their own messages at the launcher level, anything else is coming from a process
+    if (m_timingsReported || level == MessageLevel::Launcher || currentStep < 0 || currentStep >= m_steps.size())
+        return;
+    if (!m_steps[currentStep]->startsGame())
+        return;
+
+    m_timings.firstGameLine = m_launchTimer.elapsed();
+    recordStepTiming();
+    reportTimings(true);
+}
+
+void LaunchTask::reportTimings(bool reachedGame)
+{
+    if (m_timingsReported || !m_launchTimer.isValid())
+        return;
+    m_timingsReported = true;
+
+    onLogLine(m_timings.summary() + "\n", MessageLevel::Launcher);
+    // launches that fail early say nothing about how long launching takes
+    if (reachedGame)
+        LaunchTimings::appendToHistory(m_instance->instanceRoot(), m_timings);
+}
+
 void LaunchTask::finalizeSteps(bool successful, const QString& error)
 {
+    // the game never logged anything, still show where the time went
+    reportTimings(false);
     for (auto step = currentStep; step >= 0; step--) {
         m_steps[step]->finalize();
     }
@@ -132,17 +185,20 @@ void LaunchTask::onProgressReportingRequested()
 
 void LaunchTask::setCensorFilter(QMap<QString, QString> filter)
 {
-    m_censorFilter = filter;
+    m_censorReplacements = filter;
+    m_censorFilter = CensorFilter(filter);
+}
+
+void LaunchTask::addCensorFilter(const QMap<QString, QString>& filter)
+{
+    for (auto it = filter.cbegin(); it != filter.cend(); ++it)
+        m_censorReplacements.insert(it.key(), it.value());
+    m_censorFilter = CensorFilter(m_censorReplacements);
 }
 
 QString LaunchTask::censorPrivateInfo(QString in)
 {
-    auto iter = m_censorFilter.begin();
-    while (iter != m_censorFilter.end()) {
-        in.replace(iter.key(), iter.value());
-        iter++;
-    }
-    return in;
+    return m_censorFilter.apply(in);
 }
 
 void LaunchTask::proceed()
@@ -211,18 +267,39 @@ shared_qobject_ptr<LogModel> LaunchTask::getLogModel()
                                           "You may have to fix your mods because the game is still logging to files and"
                                           " likely wasting harddrive space at an alarming rate!")
                                            .arg(m_logModel->getMaxLines()));
+        // nobody sees the lines until a log page shows them, which may well be never
+        m_logModel->holdLines(true);
     }
     return m_logModel;
 }
 
 void LaunchTask::onLogLines(const QStringList& lines, MessageLevel::Enum defaultLevel)
 {
+    checkFirstGameLine(defaultLevel);
+
+    auto classifier = m_instance->getLogLevelClassifier();
+    QVector<LogModel::LogLine> processed;
+    processed.reserve(lines.size());
     for (auto& line : lines) {
-        onLogLine(line, defaultLevel);
+        processed.append(processLogLine(classifier.get(), line, defaultLevel));
     }
+
+    auto& model = *getLogModel();
+    model.appendLines(processed);
 }
 
 void LaunchTask::onLogLine(QString line, MessageLevel::Enum level)
+{
+    checkFirstGameLine(level);
+
+    auto classifier = m_instance->getLogLevelClassifier();
+    auto processed = processLogLine(classifier.get(), std::move(line), level);
+
+    auto& model = *getLogModel();
+    model.append(processed.level, processed.line);
+}
+
+LogModel::LogLine LaunchTask::processLogLine(const LogLevelClassifier* classifier, QString line, MessageLevel::Enum level)
 {
     // if the launcher part set a log level, use it
     auto innerLevel = MessageLevel::fromLine(line);
@@ -231,15 +308,14 @@ void LaunchTask::onLogLine(QString line, MessageLevel::Enum level)
     }
 
     // If the level is still undetermined, guess level
-    if (level == MessageLevel::StdErr || level == MessageLevel::StdOut || level == MessageLevel::Unknown) {
-        level = m_instance->guessLevel(line, level);
+    if (classifier && (level == MessageLevel::StdErr || level == MessageLevel::StdOut || level == MessageLevel::Unknown)) {
+        level = classifier->classify(line, level);
     }
 
     // censor private user info
     line = censorPrivateInfo(line);
 
-    auto& model = *getLogModel();
-    model.append(level, line);
+    return { level, line };
 }
 
 void LaunchTask::emitSucceeded()
@@ -37,9 +37,12 @@
 
 #pragma once
 #include <QObjectPtr.h>
+#include <QElapsedTimer>
 #include <QProcess>
 #include "BaseInstance.h"
+#include "CensorFilter.h"
 #include "LaunchStep.h"
+#include "LaunchTimings.h"
 #include "LogModel.h"
 #include "LoggedProcess.h"
 #include "MessageLevel.h"
@@ -59,7 +62,11 @@ class LaunchTask : public Task {
 
     void appendStep(shared_qobject_ptr<LaunchStep> step);
     void prependStep(shared_qobject_ptr<LaunchStep> step);
+    /// inserts the step right before the step that starts the game, or at the end if there is none
+    void insertStepBeforeGame(shared_qobject_ptr<LaunchStep> step);
     void setCensorFilter(QMap<QString, QString> filter);
+    /// censors these too, on top of what is censored already
+    void addCensorFilter(const QMap<QString, QString>& filter);
 
     InstancePtr instance() { return m_instance; }
 
@@ -113,14 +120,25 @@ class LaunchTask : public Task {
     void onProgressReportingRequested();
 
    private: /*methods */
+    void startStep(int index);
+    void recordStepTiming();
+    void reportTimings(bool reachedGame);
+    void checkFirstGameLine(MessageLevel::Enum level);
     void finalizeSteps(bool successful, const QString& error);
+    LogModel::LogLine processLogLine(const LogLevelClassifier* classifier, QString line, MessageLevel::Enum level);
 
    protected: /* data */
     InstancePtr m_instance;
     shared_qobject_ptr<LogModel> m_logModel;
     QList<shared_qobject_ptr<LaunchStep>> m_steps;
-    QMap<QString, QString> m_censorFilter;
+    CensorFilter m_censorFilter;
+    QMap<QString, QString> m_censorReplacements;
     int currentStep = -1;
     State state = NotStarted;
     qint64 m_pid = -1;
+
+    QElapsedTimer m_launchTimer;
+    QElapsedTimer m_stepTimer;
+    LaunchTimings m_timings;
+    bool m_timingsReported = false;
 };
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "LaunchTimings.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "FileSystem.h"
+
+namespace {
+
+QString historyPath(const QString& instanceRoot)
+{
+    return FS::PathCombine(instanceRoot, "launch_timings.json");
+}
+
+QJsonObject toJson(const LaunchTimings& timings)
+{
+    QJsonArray steps;
+    for (auto& step : timings.steps)
+        steps.append(QJsonObject{ { "name", step.name }, { "ms", step.ms } });
+    return QJsonObject{
+        { "started", timings.started.toString(Qt::ISODate) },
+        { "steps", steps },
+        { "firstGameLine", timings.firstGameLine },
+    };
+}
+
+LaunchTimings fromJson(const QJsonObject& obj)
+{
+    LaunchTimings timings;
+    timings.started = QDateTime::fromString(obj["started"].toString(), Qt::ISODate);
+    for (auto step : obj["steps"].toArray()) {
+        auto stepObj = step.toObject();
+        timings.steps.append({ stepObj["name"].toString(), static_cast<qint64>(stepObj["ms"].toDouble()) });
+    }
+    timings.firstGameLine = static_cast<qint64>(obj["firstGameLine"].toDouble(-1));
+    return timings;
+}
+
+}  // namespace
+
+QString LaunchTimings::summary() const
+{
+    QStringList parts;
+    for (auto& step : steps)
+        parts << QCoreApplication::translate("LaunchTimings", "%1 %2 ms").arg(step.name).arg(step.ms);
+
+    if (firstGameLine < 0)
+        return QCoreApplication::translate("LaunchTimings", "Launch steps: %1").arg(parts.join(", "));
+    return QCoreApplication::translate("LaunchTimings", "First game log line after %1 ms. Launch steps: %2")
+        .arg(firstGameLine)
+        .arg(parts.join(", "));
+}
+
+QList<LaunchTimings> LaunchTimings::loadHistory(const QString& instanceRoot)
+{
+    QList<LaunchTimings> history;
+    QFile file(historyPath(instanceRoot));
+    if (!file.open(QIODevice::ReadOnly))
+        return history;
+
+    for (auto entry : QJsonDocument::fromJson(file.readAll()).array())
+        history.append(fromJson(entry.toObject()));
+    return history;
+}
+
+void LaunchTimings::appendToHistory(const QString& instanceRoot, const LaunchTimings& timings)
+{
+    auto history = loadHistory(instanceRoot);
+    history.prepend(timings);
+
+    QJsonArray array;
+    for (int i = 0; i < history.size() && i < HISTORY_SIZE; i++)
+        array.append(toJson(history.at(i)));
+
+    try {
+        FS::write(historyPath(instanceRoot), QJsonDocument(array).toJson(QJsonDocument::Compact));
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Couldn't save the launch timings:" << e.cause();
+    }
+}
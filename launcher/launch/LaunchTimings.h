@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+
+/** How long the steps of one launch took, up to the first line the game logged.
+ *
+ *  The last few of these are kept in the instance folder, so a slow step can be traced back to the update or the
+ *  modpack change that made it slow.
+ */
+struct LaunchTimings {
+    struct Step {
+        QString name;
+        qint64 ms = 0;
+    };
+
+    QDateTime started;
+    QList<Step> steps;
+    // since the launch started, -1 if the game never logged anything
+    qint64 firstGameLine = -1;
+
+    /** One line with all the timings, for the log. */
+    QString summary() const;
+
+    static constexpr int HISTORY_SIZE = 10;
+
+    /** The last launches of the instance in that folder, newest first. */
+    static QList<LaunchTimings> loadHistory(const QString& instanceRoot);
+    /** Adds the launch to the history, dropping the oldest launch once there are HISTORY_SIZE of them. */
+    static void appendToHistory(const QString& instanceRoot, const LaunchTimings& timings);
+};
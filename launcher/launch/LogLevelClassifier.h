@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QString>
+#include <memory>
+
+#include "MessageLevel.h"
+
+/// Guesses the level of lines of game log, for instance types that know what their logs look like
+class LogLevelClassifier {
+   public:
+    using Ptr = std::shared_ptr<LogLevelClassifier>;
+
+   public:
+    virtual ~LogLevelClassifier() {}
+    /// returns the level of the line, or `level` if there is nothing to tell from it
+    virtual MessageLevel::Enum classify(const QString& line, MessageLevel::Enum level) const = 0;
+};
@@ -2,7 +2,9 @@
 
 LogModel::LogModel(QObject* parent) : QAbstractListModel(parent)
 {
-    m_content.resize(m_maxLines);
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(m_flushInterval);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LogModel::flush);
 }
 
 int LogModel::rowCount(const QModelIndex& parent) const
@@ -10,21 +12,20 @@ int LogModel::rowCount(const QModelIndex& parent) const
     if (parent.isValid())
         return 0;
 
-    return m_numLines;
+    return m_content.size();
 }
 
 QVariant LogModel::data(const QModelIndex& index, int role) const
 {
-    if (index.row() < 0 || index.row() >= m_numLines)
+    if (index.row() < 0 || index.row() >= m_content.size())
         return QVariant();
 
     auto row = index.row();
-    auto realRow = (row + m_firstLine) % m_maxLines;
     if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        return m_content[realRow].line;
+        return m_content.line(row);
     }
     if (role == LevelRole) {
-        return m_content[realRow].level;
+        return m_content.level(row);
     }
 
     return QVariant();
@@ -35,25 +36,84 @@ void LogModel::append(MessageLevel::Enum level, QString line)
     if (m_suspended) {
         return;
     }
-    int lineNum = (m_firstLine + m_numLines) % m_maxLines;
-    // overflow
-    if (m_numLines == m_maxLines) {
-        if (m_stopOnOverflow) {
+    m_pending.append({ level, std::move(line) });
+    queued();
+}
+
+void LogModel::appendLines(const QVector<LogLine>& lines)
+{
+    if (m_suspended || lines.isEmpty()) {
+        return;
+    }
+    m_pending.append(lines);
+    queued();
+}
+
+void LogModel::queued()
+{
+    if (!m_held) {
+        if (!m_flushTimer.isActive())
+            m_flushTimer.start();
+        return;
+    }
+
+    // the same lines commitLines() would keep, trimmed now and then so a chatty game can't pile them up
+    if (m_stopOnOverflow) {
+        int available = qMax(0, m_maxLines - m_content.size());
+        if (m_pending.size() > available)
+            m_pending.resize(available);
+    } else if (m_pending.size() > 2 * m_maxLines) {
+        m_pending.remove(0, m_pending.size() - m_maxLines);
+    }
+}
+
+void LogModel::flush()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty())
+        return;
+
+    QVector<LogLine> lines;
+    lines.swap(m_pending);
+    commitLines(lines);
+}
+
+void LogModel::commitLines(const QVector<LogLine>& lines)
+{
+    int count = lines.size();
+    int first = 0;
+
+    if (m_stopOnOverflow) {
+        int available = m_maxLines - m_content.size();
+        if (available <= 0) {
             // nothing more to do, the buffer is full
             return;
         }
-        beginRemoveRows(QModelIndex(), 0, 0);
-        m_firstLine = (m_firstLine + 1) % m_maxLines;
-        m_numLines--;
+        count = qMin(count, available);
+    } else if (count > m_maxLines) {
+        // only the newest lines would survive anyway
+        first = count - m_maxLines;
+        count = m_maxLines;
+    }
+
+    // overflow
+    int overflow = m_content.size() + count - m_maxLines;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        m_content.removeFirst(overflow);
         endRemoveRows();
-    } else if (m_numLines == m_maxLines - 1 && m_stopOnOverflow) {
-        level = MessageLevel::Fatal;
-        line = m_overflowMessage;
     }
-    beginInsertRows(QModelIndex(), m_numLines, m_numLines);
-    m_numLines++;
-    m_content[lineNum].level = level;
-    m_content[lineNum].line = line;
+
+    beginInsertRows(QModelIndex(), m_content.size(), m_content.size() + count - 1);
+    for (int i = 0; i < count; i++) {
+        // the last line that fits tells the user why nothing else shows up
+        if (m_stopOnOverflow && m_content.size() == m_maxLines - 1) {
+            m_content.append(MessageLevel::Fatal, m_overflowMessage);
+        } else {
+            auto& line = lines[first + i];
+            m_content.append(line.level, line.line);
+        }
+    }
     endInsertRows();
 }
 
@@ -67,59 +127,82 @@ bool LogModel::suspended()
     return m_suspended;
 }
 
+void LogModel::holdLines(bool hold)
+{
+    if (hold == m_held)
+        return;
+    m_held = hold;
+    if (hold) {
+        m_flushTimer.stop();
+    } else {
+        flush();
+    }
+}
+
+bool LogModel::linesHeld() const
+{
+    return m_held;
+}
+
+void LogModel::setFlushInterval(int interval)
+{
+    m_flushInterval = interval;
+    m_flushTimer.setInterval(interval);
+}
+
 void LogModel::clear()
 {
+    m_flushTimer.stop();
+    m_pending.clear();
+
     beginResetModel();
-    m_firstLine = 0;
-    m_numLines = 0;
+    m_content.clear();
     endResetModel();
 }
 
 QString LogModel::toPlainText()
 {
+    flush();
+
     QString out;
-    out.reserve(m_numLines * 80);
-    for (int i = 0; i < m_numLines; i++) {
-        QString& line = m_content[(m_firstLine + i) % m_maxLines].line;
-        out.append(line + '\n');
+    out.reserve(m_content.size() * 80);
+    for (int i = 0; i < m_content.size(); i++) {
+        out.append(m_content.line(i) + '\n');
     }
     out.squeeze();
     return out;
 }
 
+int LogModel::find(const QString& what, int from, bool reverse, Qt::CaseSensitivity cs) const
+{
+    int count = m_content.size();
+    if (count == 0)
+        return -1;
+    from = qBound(0, from, count - 1);
+
+    int row = m_content.find(what, from, reverse, cs);
+    if (row == -1) {
+        // wrap around
+        row = m_content.find(what, reverse ? count - 1 : 0, reverse, cs);
+    }
+    return row;
+}
+
 void LogModel::setMaxLines(int maxLines)
 {
     // no-op
     if (maxLines == m_maxLines) {
         return;
     }
-    // if it all still fits in the buffer, just resize it
-    if (m_firstLine + m_numLines < m_maxLines) {
-        m_maxLines = maxLines;
-        m_content.resize(maxLines);
-        return;
-    }
-    // otherwise, we need to reorganize the data because it crosses the wrap boundary
-    QVector<entry> newContent;
-    newContent.resize(maxLines);
-    if (m_numLines <= maxLines) {
-        // if it all fits in the new buffer, just copy it over
-        for (int i = 0; i < m_numLines; i++) {
-            newContent[i] = m_content[(m_firstLine + i) % m_maxLines];
-        }
-        m_content.swap(newContent);
-    } else {
-        // if it doesn't fit, part of the data needs to be thrown away (the oldest log messages)
-        int lead = m_numLines - maxLines;
+    // the queued lines were meant for the old buffer
+    flush();
+    // if it doesn't fit, part of the data needs to be thrown away (the oldest log messages)
+    int lead = m_content.size() - maxLines;
+    if (lead > 0) {
         beginRemoveRows(QModelIndex(), 0, lead - 1);
-        for (int i = 0; i < maxLines; i++) {
-            newContent[i] = m_content[(m_firstLine + lead + i) % m_maxLines];
-        }
-        m_numLines = m_maxLines;
-        m_content.swap(newContent);
+        m_content.removeFirst(lead);
         endRemoveRows();
     }
-    m_firstLine = 0;
     m_maxLines = maxLines;
 }
 
@@ -2,6 +2,9 @@
 
 #include <QAbstractListModel>
 #include <QString>
+#include <QTimer>
+#include <QVector>
+#include "LogStore.h"
 #include "MessageLevel.h"
 
 class LogModel : public QAbstractListModel {
@@ -12,13 +15,37 @@ class LogModel : public QAbstractListModel {
     int rowCount(const QModelIndex& parent = QModelIndex()) const;
     QVariant data(const QModelIndex& index, int role) const;
 
+    struct LogLine {
+        MessageLevel::Enum level;
+        QString line;
+    };
+
+    /** Queues lines to be added to the model.
+     *
+     *  Lines are committed in batches, at most once per m_flushInterval, so that a chatty game doesn't flood the GUI
+     *  with model signals for every single line.
+     */
     void append(MessageLevel::Enum, QString line);
+    void appendLines(const QVector<LogLine>& lines);
+    /** Commits all the queued lines right away, with a single insertion (and removal, on overflow) of rows. */
+    void flush();
     void clear();
 
     void suspend(bool suspend);
     bool suspended();
 
+    /** While held, lines are only queued, without any model updates, and no more of them are kept than fit in the model.
+     *
+     *  For when nobody is looking at the log. The queued lines are all committed at once when it's released.
+     */
+    void holdLines(bool hold);
+    bool linesHeld() const;
+    /** How long lines are queued for before they are committed, when they aren't held. */
+    void setFlushInterval(int interval);
+
     QString toPlainText();
+    /// row of the next line containing `what`, starting at `from` and wrapping around, -1 if there is none
+    int find(const QString& what, int from, bool reverse = false, Qt::CaseSensitivity cs = Qt::CaseInsensitive) const;
 
     int getMaxLines();
     void setMaxLines(int maxLines);
@@ -30,22 +57,22 @@ class LogModel : public QAbstractListModel {
 
     enum Roles { LevelRole = Qt::UserRole };
 
-   private /* types */:
-    struct entry {
-        MessageLevel::Enum level;
-        QString line;
-    };
+   private:
+    void commitLines(const QVector<LogLine>& lines);
+    void queued();
 
    private: /* data */
-    QVector<entry> m_content;
+    LogStore m_content;
+    // lines waiting for the next flush
+    QVector<LogLine> m_pending;
+    QTimer m_flushTimer;
+    // about one frame at 60 Hz
+    int m_flushInterval = 16;
     int m_maxLines = 1000;
-    // first line in the circular buffer
-    int m_firstLine = 0;
-    // number of lines occupied in the circular buffer
-    int m_numLines = 0;
     bool m_stopOnOverflow = false;
     QString m_overflowMessage = "OVERFLOW";
     bool m_suspended = false;
+    bool m_held = false;
     bool m_lineWrap = true;
 
    private:
@@ -0,0 +1,217 @@
+#include "LogStore.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+LogStore::LogStore(qsizetype blockSize, int memoryBlocks) : m_blockSize(blockSize), m_memoryBlocks(memoryBlocks) {}
+
+LogStore::~LogStore()
+{
+    clear();
+}
+
+void LogStore::append(MessageLevel::Enum level, const QString& line)
+{
+    auto utf8 = line.toUtf8();
+
+    if (m_blocks.isEmpty() || (m_blocks.last().size > 0 && m_blocks.last().size + utf8.size() > m_blockSize)) {
+        sealBlock();
+    }
+
+    auto& block = m_blocks.last();
+    block.data.append(utf8);
+    block.size += utf8.size();
+
+    m_offsets.append(m_totalSize);
+    m_levels.append(static_cast<quint8>(level));
+    m_totalSize += utf8.size();
+}
+
+void LogStore::removeFirst(int count)
+{
+    count = std::min(count, size());
+    if (count <= 0)
+        return;
+    if (count == size()) {
+        clear();
+        return;
+    }
+    m_firstLine += count;
+
+    // drop the blocks that only had removed lines in them
+    auto firstOffset = m_offsets[m_firstLine];
+    int dropped = 0;
+    while (dropped < m_blocks.size() - 1 && m_blocks[dropped + 1].offset <= firstOffset) {
+        auto& block = m_blocks[dropped];
+        if (block.mapped) {
+            m_spillFile->unmap(block.mapped);
+            m_spilledBlocks--;
+        }
+        dropped++;
+    }
+    m_blocks.remove(0, dropped);
+    if (m_spilledBlocks == 0) {
+        // nothing in there is used anymore
+        m_spillFile.reset();
+    }
+
+    compact();
+}
+
+void LogStore::clear()
+{
+    for (auto& block : m_blocks) {
+        if (block.mapped)
+            m_spillFile->unmap(block.mapped);
+    }
+    m_blocks.clear();
+    m_spillFile.reset();
+    m_spilledBlocks = 0;
+    m_offsets.clear();
+    m_levels.clear();
+    m_firstLine = 0;
+    m_totalSize = 0;
+}
+
+QString LogStore::line(int row) const
+{
+    if (row < 0 || row >= size())
+        return {};
+
+    int index = m_firstLine + row;
+    auto start = m_offsets[index];
+    auto& block = m_blocks[blockOf(start)];
+    return QString::fromUtf8(block.bytes() + (start - block.offset), lineEnd(index) - start);
+}
+
+MessageLevel::Enum LogStore::level(int row) const
+{
+    if (row < 0 || row >= size())
+        return MessageLevel::Unknown;
+    return static_cast<MessageLevel::Enum>(m_levels[m_firstLine + row]);
+}
+
+int LogStore::find(const QString& what, int from, bool reverse, Qt::CaseSensitivity cs) const
+{
+    if (what.isEmpty() || from < 0 || from >= size())
+        return -1;
+
+    if (cs == Qt::CaseInsensitive) {
+        // folding case needs the decoded text
+        for (int row = from; row >= 0 && row < size(); row += reverse ? -1 : 1) {
+            if (line(row).contains(what, cs))
+                return row;
+        }
+        return -1;
+    }
+
+    // UTF-8 is searchable as bytes, so look through whole blocks at once and only check the hits
+    const auto needle = what.toUtf8();
+    auto rowOf = [this](qint64 offset) {
+        return int(std::upper_bound(m_offsets.begin() + m_firstLine, m_offsets.end(), offset) - m_offsets.begin()) - 1;
+    };
+    // matches can't go across lines
+    auto fits = [this, &needle](int index, qint64 offset) { return offset + needle.size() <= lineEnd(index); };
+
+    if (!reverse) {
+        qint64 offset = m_offsets[m_firstLine + from];
+        for (int b = blockOf(offset); b < m_blocks.size(); b++) {
+            auto& block = m_blocks[b];
+            auto haystack = QByteArray::fromRawData(block.bytes(), block.size);
+            qsizetype local = std::max<qint64>(offset - block.offset, 0);
+            while ((local = haystack.indexOf(needle, local)) != -1) {
+                qint64 hit = block.offset + local;
+                int index = rowOf(hit);
+                if (fits(index, hit))
+                    return index - m_firstLine;
+                local++;
+            }
+        }
+    } else {
+        const qint64 first = m_offsets[m_firstLine];
+        int index = m_firstLine + from;
+        qint64 offset = lineEnd(index) - needle.size();
+        for (int b = blockOf(m_offsets[index]); b >= 0 && offset >= first; b--) {
+            auto& block = m_blocks[b];
+            auto haystack = QByteArray::fromRawData(block.bytes(), block.size);
+            qsizetype local = std::min<qint64>(offset - block.offset, block.size - 1);
+            while (local >= 0 && (local = haystack.lastIndexOf(needle, local)) != -1) {
+                qint64 hit = block.offset + local;
+                if (hit < first)
+                    return -1;
+                int hitIndex = rowOf(hit);
+                if (fits(hitIndex, hit))
+                    return hitIndex - m_firstLine;
+                local--;
+            }
+            offset = block.offset - 1;
+        }
+    }
+    return -1;
+}
+
+int LogStore::blockOf(qint64 offset) const
+{
+    auto iter = std::upper_bound(m_blocks.begin(), m_blocks.end(), offset, [](qint64 value, const Block& block) { return value < block.offset; });
+    return int(iter - m_blocks.begin()) - 1;
+}
+
+qint64 LogStore::lineEnd(int index) const
+{
+    return index + 1 < m_offsets.size() ? m_offsets[index + 1] : m_totalSize;
+}
+
+void LogStore::sealBlock()
+{
+    Block block;
+    block.offset = m_totalSize;
+    block.data.reserve(m_blockSize);
+    m_blocks.append(block);
+
+    // keep the block being written to, and the newest full ones, in memory
+    while (m_blocks.size() - m_spilledBlocks > m_memoryBlocks + 1) {
+        auto& oldest = m_blocks[m_spilledBlocks];
+        spillBlock(oldest);
+        if (!oldest.mapped)
+            break;
+        m_spilledBlocks++;
+    }
+}
+
+void LogStore::spillBlock(Block& block)
+{
+    if (!m_spillFile) {
+        m_spillFile = std::make_unique<QTemporaryFile>();
+        if (!m_spillFile->open()) {
+            qWarning() << "Couldn't create a file for old log lines, keeping them in memory:" << m_spillFile->errorString();
+            m_spillFile.reset();
+            return;
+        }
+    }
+
+    auto position = m_spillFile->size();
+    if (!m_spillFile->seek(position) || m_spillFile->write(block.data) != block.size || !m_spillFile->flush()) {
+        qWarning() << "Couldn't write old log lines to" << m_spillFile->fileName() << ", keeping them in memory:"
+                   << m_spillFile->errorString();
+        return;
+    }
+    auto mapped = m_spillFile->map(position, block.size);
+    if (!mapped) {
+        qWarning() << "Couldn't map old log lines from" << m_spillFile->fileName() << ", keeping them in memory:"
+                   << m_spillFile->errorString();
+        return;
+    }
+    block.mapped = mapped;
+    block.data = QByteArray();
+}
+
+void LogStore::compact()
+{
+    // removing from the front of the index is linear, so only do it once in a while
+    if (m_firstLine < 4096 || m_firstLine < m_offsets.size() / 2)
+        return;
+    m_offsets.remove(0, m_firstLine);
+    m_levels.remove(0, m_firstLine);
+    m_firstLine = 0;
+}
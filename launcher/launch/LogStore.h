@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QTemporaryFile>
+#include <QVector>
+
+#include <memory>
+
+#include "MessageLevel.h"
+
+/**
+ * Compact storage for the lines of a game log.
+ *
+ * Lines are kept as UTF-8 in fixed size blocks, with an index of where each line starts, so looking up a line is a
+ * binary search. Only the newest blocks stay in memory: older ones are written to a temporary file and memory mapped,
+ * which lets the OS page them out, so a long session doesn't keep the whole log in RAM.
+ */
+class LogStore {
+   public:
+    explicit LogStore(qsizetype blockSize = 1 << 20, int memoryBlocks = 4);
+    ~LogStore();
+
+    void append(MessageLevel::Enum level, const QString& line);
+    /// drops the `count` oldest lines
+    void removeFirst(int count);
+    void clear();
+
+    int size() const { return m_offsets.size() - m_firstLine; }
+    QString line(int row) const;
+    MessageLevel::Enum level(int row) const;
+
+    /**
+     * Finds the first row from `from` (included) that contains `what`, going backwards if `reverse` is true.
+     * Returns -1 if there is none.
+     */
+    int find(const QString& what, int from, bool reverse = false, Qt::CaseSensitivity cs = Qt::CaseSensitive) const;
+
+   private:
+    struct Block {
+        // global offset of the first byte of the block
+        qint64 offset = 0;
+        // either in memory or mapped from the spill file
+        QByteArray data;
+        uchar* mapped = nullptr;
+        qsizetype size = 0;
+
+        const char* bytes() const { return mapped ? reinterpret_cast<const char*>(mapped) : data.constData(); }
+    };
+
+    int blockOf(qint64 offset) const;
+    qint64 lineEnd(int index) const;
+    void sealBlock();
+    void spillBlock(Block& block);
+    void compact();
+
+   private:
+    qsizetype m_blockSize;
+    int m_memoryBlocks;
+
+    QVector<Block> m_blocks;
+    // offset and level of each line, including the removed ones up to the next compaction
+    QVector<qint64> m_offsets;
+    QVector<quint8> m_levels;
+    // index of the first line still in the log
+    int m_firstLine = 0;
+    qint64 m_totalSize = 0;
+    // where the blocks that don't fit in memory go, created on first use
+    std::unique_ptr<QTemporaryFile> m_spillFile;
+    int m_spilledBlocks = 0;
+};
@@ -17,6 +17,8 @@
 
 #include <launch/LaunchTask.h>
 
+#include "minecraft/ServerAddressCache.h"
+
 LookupServerAddress::LookupServerAddress(LaunchTask* parent) : LaunchStep(parent), m_dnsLookup(new QDnsLookup(this))
 {
     connect(m_dnsLookup, &QDnsLookup::finished, this, &LookupServerAddress::on_dnsLookupFinished);
@@ -44,6 +46,13 @@ bool LookupServerAddress::abort()
 
 void LookupServerAddress::executeTask()
 {
+    // launching into the same server again, or one the servers page has pinged, doesn't need to wait for DNS
+    if (auto cached = ServerAddressCache::lookup(m_lookupAddress)) {
+        emit logLine(QString("Using the resolved server address %1 with port %2\n").arg(cached->host, QString::number(cached->port)),
+                     MessageLevel::Launcher);
+        resolve(cached->host, cached->port);
+        return;
+    }
     m_dnsLookup->lookup();
 }
 
@@ -55,6 +64,8 @@ void LookupServerAddress::on_dnsLookupFinished()
     }
 
     if (m_dnsLookup->error() != QDnsLookup::NoError) {
+        if (m_dnsLookup->error() == QDnsLookup::NotFoundError)
+            ServerAddressCache::store(m_lookupAddress, { m_lookupAddress, 25565 }, ServerAddressCache::NO_RECORD_TTL_SECONDS);
         emit logLine(QString("Failed to resolve server address (this is NOT an error!) %1: %2\n")
                          .arg(m_dnsLookup->name(), m_dnsLookup->errorString()),
                      MessageLevel::Launcher);
@@ -75,6 +86,7 @@ void LookupServerAddress::on_dnsLookupFinished()
 
     const auto& firstRecord = records.at(0);
     quint16 port = firstRecord.port();
+    ServerAddressCache::store(m_lookupAddress, { firstRecord.target(), port }, firstRecord.timeToLive());
 
     emit logLine(
         QString("Resolved server address %1 to %2 with port %3\n").arg(m_dnsLookup->name(), firstRecord.target(), QString::number(port)),
@@ -23,6 +23,23 @@
 #include "Application.h"
 #include "BuildConfig.h"
 
+#include <QCryptographicHash>
+#include <QSaveFile>
+
+namespace {
+/*
+ * Snapshots are stored next to the JSON files they were parsed from:
+ *
+ *   header: magic, format version, identity of the JSON file (size, mtime, inode)
+ *   body:   whatever the entity writes in writeSnapshot()
+ *
+ * A snapshot is only used while the JSON file still has the identity it had when the snapshot was made.
+ */
+constexpr quint32 SNAPSHOT_MAGIC = 0x504C4D53;  // "PLMS"
+constexpr quint32 SNAPSHOT_VERSION = 2;
+constexpr auto SNAPSHOT_STREAM_VERSION = QDataStream::Qt_5_12;
+}  // namespace
+
 class ParsingValidator : public Net::Validator {
    public: /* con/des */
     ParsingValidator(Meta::BaseEntity* entity) : m_entity(entity){};
@@ -39,6 +56,11 @@ class ParsingValidator : public Net::Validator {
     bool validate(QNetworkReply&) override
     {
         auto fname = m_entity->localFilename();
+        // what is shown already came from the same file, parsing it again would only make the views start over
+        if (m_entity->isLoaded() && m_entity->localMatches(m_data)) {
+            qDebug() << "Meta file" << fname << "is unchanged";
+            return true;
+        }
         try {
             auto doc = Json::requireDocument(m_data, fname);
             auto obj = Json::requireObject(doc, fname);
@@ -68,17 +90,28 @@ QUrl Meta::BaseEntity::url() const
     }
 }
 
+QString Meta::BaseEntity::localFilePath() const
+{
+    return QDir("meta").absoluteFilePath(localFilename());
+}
+
 bool Meta::BaseEntity::loadLocalFile()
 {
-    const QString fname = QDir("meta").absoluteFilePath(localFilename());
+    const QString fname = localFilePath();
     if (!QFile::exists(fname)) {
         return false;
     }
+    const QString snapshot = fname + ".snapshot";
+    const auto identity = Hashing::FileIdentity::of(fname);
+    if (loadSnapshot(snapshot, identity)) {
+        return true;
+    }
     // TODO: check if the file has the expected checksum
     try {
         auto doc = Json::requireDocument(fname, fname);
         auto obj = Json::requireObject(doc, fname);
         parse(obj);
+        saveSnapshot(snapshot, identity);
         return true;
     } catch (const Exception& e) {
         qDebug() << QString("Unable to parse file %1: %2").arg(fname, e.cause());
@@ -88,6 +121,50 @@ bool Meta::BaseEntity::loadLocalFile()
     }
 }
 
+bool Meta::BaseEntity::loadSnapshot(const QString& path, const Hashing::FileIdentity& source)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    // read straight from the mapping, the strings are copied out of it anyway
+    const auto size = file.size();
+    const uchar* mapped = file.map(0, size);
+    const QByteArray data =
+        mapped ? QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<int>(size)) : file.readAll();
+
+    QDataStream stream(data);
+    stream.setVersion(SNAPSHOT_STREAM_VERSION);
+    quint32 magic = 0, version = 0;
+    Hashing::FileIdentity identity;
+    stream >> magic >> version >> identity.size >> identity.mtime >> identity.inode;
+    if (stream.status() != QDataStream::Ok || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || identity != source) {
+        return false;
+    }
+    if (!readSnapshot(stream)) {
+        qDebug() << "Ignoring unreadable metadata snapshot" << path;
+        return false;
+    }
+    return true;
+}
+
+void Meta::BaseEntity::saveSnapshot(const QString& path, const Hashing::FileIdentity& source) const
+{
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(SNAPSHOT_STREAM_VERSION);
+        stream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << source.size << source.mtime << source.inode;
+        if (!writeSnapshot(stream)) {
+            return;
+        }
+    }
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qDebug() << "Couldn't write metadata snapshot" << path << file.errorString();
+    }
+}
+
 void Meta::BaseEntity::load(Net::Mode loadType)
 {
     // load local file if nothing is loaded yet
@@ -100,28 +177,95 @@ void Meta::BaseEntity::load(Net::Mode loadType)
     if (loadType == Net::Mode::Offline || !shouldStartRemoteUpdate()) {
         return;
     }
-    m_updateTask.reset(new NetJob(QObject::tr("Download of meta file %1").arg(localFilename()), APPLICATION->network()));
+    NetJob::Ptr job(new NetJob(QObject::tr("Download of meta file %1").arg(localFilename()), APPLICATION->network()));
+    addUpdateTo(job);
+    job->start();
+}
+
+void Meta::BaseEntity::addUpdateTo(const NetJob::Ptr& job)
+{
     auto url = this->url();
     auto entry = APPLICATION->metacache()->resolveEntry("meta", localFilename());
     entry->setStale(true);
+    // the cache entry provides the ETag, so an unchanged file costs a 304 and no parsing
     auto dl = Net::ApiDownload::makeCached(url, entry);
     /*
      * The validator parses the file and loads it into the object.
      * If that fails, the file is not written to storage.
      */
     dl->addValidator(new ParsingValidator(this));
-    m_updateTask->addNetAction(dl);
+    job->addNetAction(dl);
+    m_updateTask = job;
     m_updateStatus = UpdateStatus::InProgress;
-    QObject::connect(m_updateTask.get(), &NetJob::succeeded, [&]() {
+    // follow the download itself, the job may carry other files that fail independently
+    QObject::connect(dl.get(), &Task::succeeded, [this]() {
         m_loadStatus = LoadStatus::Remote;
         m_updateStatus = UpdateStatus::Succeeded;
-        m_updateTask.reset();
     });
-    QObject::connect(m_updateTask.get(), &NetJob::failed, [&]() {
-        m_updateStatus = UpdateStatus::Failed;
+    auto failed = [this]() { m_updateStatus = UpdateStatus::Failed; };
+    QObject::connect(dl.get(), &Task::failed, failed);
+    QObject::connect(dl.get(), &Task::aborted, failed);
+    QObject::connect(job.get(), &Task::finished, [this, owner = job.get()]() {
+        if (m_updateTask.get() != owner) {
+            return;
+        }
+        // aborted before the download got to run
+        if (m_updateStatus == UpdateStatus::InProgress) {
+            m_updateStatus = UpdateStatus::Failed;
+        }
         m_updateTask.reset();
     });
-    m_updateTask->start();
+}
+
+void Meta::BaseEntity::markUpToDate()
+{
+    if (!isLoaded() && loadLocalFile()) {
+        m_loadStatus = LoadStatus::Local;
+    }
+    if (isLoaded()) {
+        m_updateStatus = UpdateStatus::Succeeded;
+    }
+}
+
+bool Meta::BaseEntity::localMatchesSha256() const
+{
+    if (m_sha256.isEmpty()) {
+        return false;
+    }
+    return localSha256().compare(m_sha256, Qt::CaseInsensitive) == 0;
+}
+
+bool Meta::BaseEntity::localMatches(const QByteArray& data) const
+{
+    const QString local = localSha256();
+    if (local.isEmpty()) {
+        return false;
+    }
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex()) == local;
+}
+
+QString Meta::BaseEntity::localSha256() const
+{
+    const QString fname = localFilePath();
+    const auto identity = Hashing::FileIdentity::of(fname);
+    if (!identity.isValid()) {
+        return {};
+    }
+    auto cache = APPLICATION->hashCache();
+    QString hash = cache ? cache->lookup(fname, identity, "sha256") : QString();
+    if (hash.isEmpty()) {
+        QFile file(fname);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return {};
+        }
+        QCryptographicHash sha256(QCryptographicHash::Sha256);
+        sha256.addData(&file);
+        hash = QString::fromLatin1(sha256.result().toHex());
+        if (cache) {
+            cache->insert(fname, identity, "sha256", hash);
+        }
+    }
+    return hash.toLower();
 }
 
 bool Meta::BaseEntity::isLoaded() const
@@ -135,6 +279,11 @@ bool Meta::BaseEntity::shouldStartRemoteUpdate() const
     return m_updateStatus != UpdateStatus::InProgress;
 }
 
+bool Meta::BaseEntity::wasUpdated() const
+{
+    return m_updateStatus == UpdateStatus::Succeeded;
+}
+
 Task::Ptr Meta::BaseEntity::getCurrentTask()
 {
     if (m_updateStatus == UpdateStatus::InProgress) {
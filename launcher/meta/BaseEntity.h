@@ -17,7 +17,9 @@
 
 #include <QJsonObject>
 #include <QObject>
+#include <QDataStream>
 #include "QObjectPtr.h"
+#include "modplatform/helpers/HashCache.h"
 
 #include "net/Mode.h"
 #include "net/NetJob.h"
@@ -39,16 +41,43 @@ class BaseEntity {
 
     bool isLoaded() const;
     bool shouldStartRemoteUpdate() const;
+    /// whether the local copy was refreshed from the remote during this session
+    bool wasUpdated() const;
 
     void load(Net::Mode loadType);
     Task::Ptr getCurrentTask();
 
+    /// checksum of the remote file, as listed by the entity above this one. Empty if unknown
+    QString sha256() const { return m_sha256; }
+    void setSha256(const QString& sha256) { m_sha256 = sha256; }
+    /// whether the local file has the checksum listed for the remote one
+    bool localMatchesSha256() const;
+    /// whether the local file holds exactly data, so a download of it changes nothing
+    bool localMatches(const QByteArray& data) const;
+
+    /// download the remote file as part of a shared job, instead of in a job of its own
+    void addUpdateTo(const NetJob::Ptr& job);
+    /// treat the local file as refreshed, because it's known to match the remote one
+    void markUpToDate();
+
    protected: /* methods */
     bool loadLocalFile();
 
+    /// write what parse() read in a compact form, entities without snapshots return false
+    virtual bool writeSnapshot([[maybe_unused]] QDataStream& out) const { return false; }
+    virtual bool readSnapshot([[maybe_unused]] QDataStream& in) { return false; }
+
+   private:
+    QString localFilePath() const;
+    /// lower case hex, empty if there is no local file
+    QString localSha256() const;
+    bool loadSnapshot(const QString& path, const Hashing::FileIdentity& source);
+    void saveSnapshot(const QString& path, const Hashing::FileIdentity& source) const;
+
    private:
     LoadStatus m_loadStatus = LoadStatus::NotLoaded;
     UpdateStatus m_updateStatus = UpdateStatus::NotDone;
     NetJob::Ptr m_updateTask;
+    QString m_sha256;
 };
 }  // namespace Meta
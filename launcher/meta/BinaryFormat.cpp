@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BinaryFormat.h"
+
+#include "Index.h"
+#include "JsonFormat.h"
+#include "Version.h"
+#include "VersionList.h"
+
+namespace Meta {
+
+static void writeRequires(QDataStream& out, const RequireSet& reqs)
+{
+    out << quint32(reqs.size());
+    for (auto& require : reqs) {
+        out << require.uid << require.equalsVersion << require.suggests;
+    }
+}
+
+static bool readRequires(QDataStream& in, RequireSet* ptr)
+{
+    quint32 count = 0;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+        Require require;
+        in >> require.uid >> require.equalsVersion >> require.suggests;
+        ptr->insert(require);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+void writeIndex(QDataStream& out, const Index* index)
+{
+    const auto lists = index->lists();
+    out << quint32(lists.size());
+    for (auto& list : lists) {
+        out << list->uid() << list->name() << list->sha256();
+    }
+}
+
+bool readIndex(QDataStream& in, Index* ptr)
+{
+    quint32 count = 0;
+    in >> count;
+    QVector<VersionList::Ptr> lists;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+        QString uid, name, sha256;
+        in >> uid >> name >> sha256;
+        auto list = std::make_shared<VersionList>(uid);
+        list->setName(name);
+        list->setSha256(sha256);
+        lists.append(list);
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+    ptr->merge(std::make_shared<Index>(lists));
+    return true;
+}
+
+void writeVersionList(QDataStream& out, const VersionList* list)
+{
+    const auto versions = list->versions();
+    out << list->uid() << list->name() << quint32(versions.size());
+    for (auto& version : versions) {
+        out << version->version() << version->type() << version->rawTime() << version->isRecommended() << version->isVolatile()
+            << version->sha256();
+        writeRequires(out, version->requiredSet());
+        writeRequires(out, version->conflictSet());
+    }
+}
+
+bool readVersionList(QDataStream& in, VersionList* ptr)
+{
+    QString uid, name;
+    quint32 count = 0;
+    in >> uid >> name >> count;
+    if (in.status() != QDataStream::Ok || uid != ptr->uid()) {
+        return false;
+    }
+
+    QVector<Version::Ptr> versions;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+        QString id, type, sha256;
+        qint64 time = 0;
+        bool recommended = false, volatile_ = false;
+        RequireSet reqs, conflicts;
+        in >> id >> type >> time >> recommended >> volatile_ >> sha256;
+        if (!readRequires(in, &reqs) || !readRequires(in, &conflicts)) {
+            return false;
+        }
+
+        auto version = std::make_shared<Version>(uid, id);
+        version->setType(type);
+        version->setTime(time);
+        version->setRecommended(recommended);
+        version->setVolatile(volatile_);
+        version->setRequires(reqs, conflicts);
+        version->setProvidesRecommendations();
+        version->setSha256(sha256);
+        versions.append(version);
+    }
+    if (in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    auto list = std::make_shared<VersionList>(uid);
+    list->setName(name);
+    list->setVersions(versions);
+    ptr->merge(list);
+    return true;
+}
+
+}  // namespace Meta
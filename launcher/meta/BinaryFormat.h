@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QDataStream>
+
+namespace Meta {
+class Index;
+class VersionList;
+
+/*
+ * Compact snapshots of parsed metadata, so the big JSON files only need to be parsed once after they change.
+ * The readers build the whole entity before merging it, so a truncated or corrupt snapshot leaves the target untouched.
+ */
+void writeIndex(QDataStream& out, const Index* index);
+bool readIndex(QDataStream& in, Index* ptr);
+void writeVersionList(QDataStream& out, const VersionList* list);
+bool readVersionList(QDataStream& in, VersionList* ptr);
+}  // namespace Meta
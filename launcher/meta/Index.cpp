@@ -15,6 +15,7 @@
 
 #include "Index.h"
 
+#include "BinaryFormat.h"
 #include "JsonFormat.h"
 #include "VersionList.h"
 
@@ -94,6 +95,17 @@ void Index::parse(const QJsonObject& obj)
     parseIndex(obj, this);
 }
 
+bool Index::writeSnapshot(QDataStream& out) const
+{
+    writeIndex(out, this);
+    return true;
+}
+
+bool Index::readSnapshot(QDataStream& in)
+{
+    return readIndex(in, this);
+}
+
 void Index::merge(const std::shared_ptr<Index>& other)
 {
     const QVector<VersionList::Ptr> lists = std::dynamic_pointer_cast<Index>(other)->m_lists;
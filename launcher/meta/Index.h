@@ -51,6 +51,10 @@ class Index : public QAbstractListModel, public BaseEntity {
     void merge(const std::shared_ptr<Index>& other);
     void parse(const QJsonObject& obj) override;
 
+   protected:
+    bool writeSnapshot(QDataStream& out) const override;
+    bool readSnapshot(QDataStream& in) override;
+
    private:
     QVector<VersionList::Ptr> m_lists;
     QHash<QString, VersionList::Ptr> m_uids;
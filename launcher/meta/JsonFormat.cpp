@@ -41,6 +41,7 @@ static std::shared_ptr<Index> parseIndexInternal(const QJsonObject& obj)
     std::transform(objects.begin(), objects.end(), std::back_inserter(lists), [](const QJsonObject& obj) {
         VersionList::Ptr list = std::make_shared<VersionList>(requireString(obj, "uid"));
         list->setName(ensureString(obj, "name", QString()));
+        list->setSha256(ensureString(obj, "sha256", QString()));
         return list;
     });
     return std::make_shared<Index>(lists);
@@ -81,6 +82,7 @@ static VersionList::Ptr parseVersionListInternal(const QJsonObject& obj)
     std::transform(versionsRaw.begin(), versionsRaw.end(), std::back_inserter(versions), [uid](const QJsonObject& vObj) {
         auto version = parseCommonVersion(uid, vObj);
         version->setProvidesRecommendations();
+        version->setSha256(ensureString(vObj, "sha256", QString()));
         return version;
     });
 
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SyncTask.h"
+
+#include <QSet>
+
+#include "Application.h"
+#include "meta/Index.h"
+#include "meta/VersionList.h"
+
+namespace Meta {
+
+SyncTask::SyncTask(QList<Version::Ptr> versions, QSet<QString> installedUids, QObject* parent)
+    : Task(parent), m_versions(std::move(versions)), m_installedUids(std::move(installedUids))
+{}
+
+void SyncTask::executeTask()
+{
+    setStatus(tr("Checking metadata for updates"));
+    auto index = APPLICATION->metadataIndex();
+    m_job.reset(new NetJob(tr("Metadata index update"), APPLICATION->network()));
+    if (!index->wasUpdated() && index->shouldStartRemoteUpdate()) {
+        index->addUpdateTo(m_job);
+    }
+    runJob(&SyncTask::syncLists);
+}
+
+void SyncTask::syncLists()
+{
+    auto index = APPLICATION->metadataIndex();
+    m_job.reset(new NetJob(tr("Metadata list update"), APPLICATION->network()));
+    QSet<QString> seen;
+    for (auto& version : m_versions) {
+        if (seen.contains(version->uid())) {
+            continue;
+        }
+        seen.insert(version->uid());
+        auto list = index->get(version->uid());
+        if (list->wasUpdated() || !list->shouldStartRemoteUpdate()) {
+            continue;
+        }
+        // the checksums in an index that couldn't be refreshed may be outdated themselves
+        if (index->wasUpdated() && list->localMatchesSha256()) {
+            list->markUpToDate();
+            continue;
+        }
+        list->addUpdateTo(m_job);
+    }
+    runJob(&SyncTask::syncVersions);
+}
+
+void SyncTask::addRequiredVersions()
+{
+    auto index = APPLICATION->metadataIndex();
+    QSet<QString> seen;
+    for (auto& version : m_versions) {
+        seen.insert(version->uid() + ':' + version->version());
+    }
+    // the list grows as we go, so what the added versions require is followed too
+    for (int i = 0; i < m_versions.size(); i++) {
+        auto required = m_versions[i]->requiredSet();
+        for (auto& req : required) {
+            auto version = req.equalsVersion;
+            if (version.isEmpty() && !m_installedUids.contains(req.uid)) {
+                version = req.suggests;
+            }
+            if (version.isEmpty() || seen.contains(req.uid + ':' + version)) {
+                continue;
+            }
+            seen.insert(req.uid + ':' + version);
+            m_versions.append(index->get(req.uid, version));
+        }
+    }
+}
+
+void SyncTask::syncVersions()
+{
+    addRequiredVersions();
+
+    auto index = APPLICATION->metadataIndex();
+    m_job.reset(new NetJob(tr("Metadata update"), APPLICATION->network()));
+    for (auto& version : m_versions) {
+        if (version->wasUpdated() || !version->shouldStartRemoteUpdate()) {
+            continue;
+        }
+        if (index->get(version->uid())->wasUpdated() && version->localMatchesSha256()) {
+            version->markUpToDate();
+            continue;
+        }
+        version->addUpdateTo(m_job);
+    }
+    runJob(nullptr);
+}
+
+void SyncTask::runJob(void (SyncTask::*next)())
+{
+    auto finish = [this, next]() {
+        m_job.reset();
+        if (!isRunning()) {
+            return;
+        }
+        if (next) {
+            (this->*next)();
+        } else {
+            emitSucceeded();
+        }
+    };
+    if (m_job->size() == 0) {
+        finish();
+        return;
+    }
+    connect(m_job.get(), &Task::finished, this, finish);
+    connect(m_job.get(), &Task::progress, this, &SyncTask::setProgress);
+    connect(m_job.get(), &Task::failed, this, [](const QString& reason) { qWarning() << "Metadata update failed:" << reason; });
+    m_job->start();
+}
+
+bool SyncTask::abort()
+{
+    if (m_job) {
+        m_job->abort();
+    }
+    emitAborted();
+    return true;
+}
+
+}  // namespace Meta
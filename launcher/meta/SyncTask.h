@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QSet>
+
+#include "meta/Version.h"
+#include "net/NetJob.h"
+#include "tasks/Task.h"
+
+namespace Meta {
+
+/**
+ * Brings the metadata of a set of versions up to date in one sweep.
+ *
+ * The index is refreshed once per session. It lists the checksums of the version lists, which in turn list the
+ * checksums of their versions, so a local file that matches is known to be current without asking for it.
+ * Everything else is fetched together, one job per level. Failing to fetch something isn't fatal, whatever is on
+ * disk stays usable and loading it is left to the caller.
+ *
+ * Once the lists are in, they tell what their versions require. Those versions are fetched in the same sweep, so
+ * dependency resolution finds them on disk instead of waiting for another one: the exact versions that are required,
+ * and the suggested versions of uids that aren't installed, as the resolver would add them.
+ */
+class SyncTask : public Task {
+    Q_OBJECT
+   public:
+    explicit SyncTask(QList<Version::Ptr> versions, QSet<QString> installedUids = {}, QObject* parent = nullptr);
+    ~SyncTask() override = default;
+
+    bool canAbort() const override { return true; }
+    bool abort() override;
+
+   protected:
+    void executeTask() override;
+
+   private:
+    void syncLists();
+    void syncVersions();
+    /// add the versions that the ones to sync require, as far as the loaded lists know
+    void addRequiredVersions();
+    /// run the pending downloads, if there are any, and continue with the next step once they are done
+    void runJob(void (SyncTask::*next)());
+
+   private:
+    QList<Version::Ptr> m_versions;
+    QSet<QString> m_installedUids;
+    NetJob::Ptr m_job;
+};
+
+}  // namespace Meta
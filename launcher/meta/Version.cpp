@@ -71,6 +71,9 @@ void Meta::Version::mergeFromList(const Meta::Version::Ptr& other)
     if (m_volatile != other->m_volatile) {
         setVolatile(other->m_volatile);
     }
+    if (!other->sha256().isEmpty()) {
+        setSha256(other->sha256());
+    }
 }
 
 void Meta::Version::merge(const Version::Ptr& other)
@@ -86,9 +89,13 @@ QString Meta::Version::localFilename() const
     return m_uid + '/' + m_version + ".json";
 }
 
-::Version Meta::Version::toComparableVersion() const
+const ::Version& Meta::Version::toComparableVersion() const
 {
-    return { const_cast<Meta::Version*>(this)->descriptor() };
+    // most versions are only shown, never compared, so they don't parse their version up front
+    if (!m_comparableVersion) {
+        m_comparableVersion = ::Version(m_version);
+    }
+    return *m_comparableVersion;
 }
 
 void Meta::Version::setType(const QString& type)
@@ -22,6 +22,7 @@
 #include <QStringList>
 #include <QVector>
 #include <memory>
+#include <optional>
 
 #include "minecraft/VersionFile.h"
 
@@ -50,6 +51,8 @@ class Version : public QObject, public BaseVersion, public BaseEntity {
     QDateTime time() const;
     qint64 rawTime() const { return m_time; }
     const Meta::RequireSet& requiredSet() const { return m_requires; }
+    const Meta::RequireSet& conflictSet() const { return m_conflicts; }
+    bool isVolatile() const { return m_volatile; }
     VersionFilePtr data() const { return m_data; }
     bool isRecommended() const { return m_recommended; }
     bool isLoaded() const { return m_data != nullptr; }
@@ -60,7 +63,8 @@ class Version : public QObject, public BaseVersion, public BaseEntity {
 
     QString localFilename() const override;
 
-    [[nodiscard]] ::Version toComparableVersion() const;
+    /// parsed on first use and kept, the version string never changes
+    [[nodiscard]] const ::Version& toComparableVersion() const;
 
    public:  // for usage by format parsers only
     void setType(const QString& type);
@@ -82,6 +86,7 @@ class Version : public QObject, public BaseVersion, public BaseEntity {
     QString m_name;
     QString m_uid;
     QString m_version;
+    mutable std::optional<::Version> m_comparableVersion;
     QString m_type;
     qint64 m_time = 0;
     Meta::RequireSet m_requires;
@@ -17,6 +17,7 @@
 
 #include <QDateTime>
 
+#include "BinaryFormat.h"
 #include "JsonFormat.h"
 #include "Version.h"
 
@@ -171,6 +172,17 @@ void VersionList::parse(const QJsonObject& obj)
     parseVersionList(obj, this);
 }
 
+bool VersionList::writeSnapshot(QDataStream& out) const
+{
+    writeVersionList(out, this);
+    return true;
+}
+
+bool VersionList::readSnapshot(QDataStream& in)
+{
+    return readVersionList(in, this);
+}
+
 // FIXME: this is dumb, we have 'recommended' as part of the metadata already...
 static const Meta::Version::Ptr& getBetterVersion(const Meta::Version::Ptr& a, const Meta::Version::Ptr& b)
 {
@@ -191,6 +203,7 @@ void VersionList::mergeFromIndex(const VersionList::Ptr& other)
     if (m_name != other->m_name) {
         setName(other->m_name);
     }
+    setSha256(other->sha256());
 }
 
 void VersionList::merge(const VersionList::Ptr& other)
@@ -210,7 +223,7 @@ void VersionList::merge(const VersionList::Ptr& other)
         if (m_lookup.contains(version->version())) {
             m_lookup.value(version->version())->mergeFromList(version);
         } else {
-            m_lookup.insert(version->uid(), version);
+            m_lookup.insert(version->version(), version);
         }
         // connect it.
         setupAddedVersion(m_versions.size(), version);
@@ -65,6 +65,10 @@ class VersionList : public BaseVersionList, public BaseEntity {
     void mergeFromIndex(const VersionList::Ptr& other);
     void parse(const QJsonObject& obj) override;
 
+   protected:
+    bool writeSnapshot(QDataStream& out) const override;
+    bool readSnapshot(QDataStream& in) override;
+
    signals:
     void nameChanged(const QString& name);
 
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AssetObjectRegistry.h"
+
+#include <algorithm>
+#include <numeric>
+
+static int hexDigit(QChar c)
+{
+    const auto u = c.unicode();
+    if (u >= '0' && u <= '9')
+        return u - '0';
+    if (u >= 'a' && u <= 'f')
+        return u - 'a' + 10;
+    if (u >= 'A' && u <= 'F')
+        return u - 'A' + 10;
+    return -1;
+}
+
+bool AssetHash::fromHex(const QString& hex, AssetHash& out)
+{
+    out = AssetHash();
+    if (hex.size() != int(out.bytes.size()) * 2)
+        return false;
+    for (size_t i = 0; i < out.bytes.size(); i++) {
+        const int high = hexDigit(hex[int(i) * 2]);
+        const int low = hexDigit(hex[int(i) * 2 + 1]);
+        if (high < 0 || low < 0) {
+            out = AssetHash();
+            return false;
+        }
+        out.bytes[i] = quint8(high << 4 | low);
+    }
+    return true;
+}
+
+QString AssetHash::toHex() const
+{
+    static const char digits[] = "0123456789abcdef";
+    QString out(int(bytes.size()) * 2, Qt::Uninitialized);
+    auto data = out.data();
+    for (auto byte : bytes) {
+        *data++ = QLatin1Char(digits[byte >> 4]);
+        *data++ = QLatin1Char(digits[byte & 0xf]);
+    }
+    return out;
+}
+
+AssetObjectRegistry& AssetObjectRegistry::instance()
+{
+    static AssetObjectRegistry registry;
+    return registry;
+}
+
+int AssetObjectRegistry::lowerBound(const AssetHash& hash) const
+{
+    auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), hash, [this](Id id, const AssetHash& value) { return m_hashes[id] < value; });
+    return int(it - m_sorted.begin());
+}
+
+QVector<AssetObjectRegistry::Id> AssetObjectRegistry::intern(const QVector<AssetHash>& hashes)
+{
+    QVector<Id> ids(hashes.size());
+
+    // visit the new hashes in order, so equal ones are next to each other and the additions come out sorted
+    std::vector<int> order(hashes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&hashes](int a, int b) { return hashes[a] < hashes[b]; });
+
+    QWriteLocker locker(&m_lock);
+    const auto oldSize = m_sorted.size();
+    for (size_t i = 0; i < order.size(); i++) {
+        const auto& hash = hashes[order[i]];
+        if (i > 0 && hash == hashes[order[i - 1]]) {
+            ids[order[i]] = ids[order[i - 1]];
+            continue;
+        }
+        // only the part from before this call is sorted yet
+        auto it = std::lower_bound(m_sorted.begin(), m_sorted.begin() + oldSize, hash,
+                                   [this](Id id, const AssetHash& value) { return m_hashes[id] < value; });
+        if (it != m_sorted.begin() + oldSize && m_hashes[*it] == hash) {
+            ids[order[i]] = *it;
+            continue;
+        }
+        const Id id = Id(m_hashes.size());
+        m_hashes.push_back(hash);
+        m_sorted.push_back(id);
+        ids[order[i]] = id;
+    }
+    std::inplace_merge(m_sorted.begin(), m_sorted.begin() + oldSize, m_sorted.end(),
+                       [this](Id a, Id b) { return m_hashes[a] < m_hashes[b]; });
+    return ids;
+}
+
+AssetObjectRegistry::Id AssetObjectRegistry::intern(const AssetHash& hash)
+{
+    {
+        QReadLocker locker(&m_lock);
+        const int pos = lowerBound(hash);
+        if (pos < int(m_sorted.size()) && m_hashes[m_sorted[pos]] == hash)
+            return m_sorted[pos];
+    }
+    return intern(QVector<AssetHash>{ hash }).first();
+}
+
+AssetHash AssetObjectRegistry::hash(Id id) const
+{
+    QReadLocker locker(&m_lock);
+    return id < m_hashes.size() ? m_hashes[id] : AssetHash();
+}
+
+QString AssetObjectRegistry::hexName(Id id) const
+{
+    return hash(id).toHex();
+}
+
+QString AssetObjectRegistry::relativePath(Id id) const
+{
+    const auto name = hexName(id);
+    QString out;
+    out.reserve(name.size() + 3);
+    out.append(name.constData(), 2);
+    out.append('/');
+    out.append(name);
+    return out;
+}
+
+int AssetObjectRegistry::size() const
+{
+    QReadLocker locker(&m_lock);
+    return int(m_hashes.size());
+}
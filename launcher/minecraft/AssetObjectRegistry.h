@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+#include <array>
+#include <vector>
+
+/// the SHA-1 an asset object is stored and downloaded under
+struct AssetHash {
+    std::array<quint8, 20> bytes{};
+
+    /// false and a zero hash unless hex is exactly 40 hex digits
+    static bool fromHex(const QString& hex, AssetHash& out);
+    QString toHex() const;
+
+    bool operator==(const AssetHash& other) const { return bytes == other.bytes; }
+    bool operator!=(const AssetHash& other) const { return bytes != other.bytes; }
+    bool operator<(const AssetHash& other) const { return bytes < other.bytes; }
+};
+
+inline size_t qHash(const AssetHash& hash, size_t seed = 0)
+{
+    return qHashBits(hash.bytes.data(), hash.bytes.size(), seed);
+}
+
+/*
+ * The hashes of all asset objects the launcher has read about, each stored once.
+ *
+ * Indexes for different game versions share most of their objects, so they refer to hashes by a small id instead of
+ * each holding their own copy. Ids stay valid for the life of the process.
+ */
+class AssetObjectRegistry {
+   public:
+    using Id = quint32;
+
+    static AssetObjectRegistry& instance();
+
+    /// ids for these hashes, adding the ones not seen before; done in one go so reading an index takes the lock once
+    QVector<Id> intern(const QVector<AssetHash>& hashes);
+    Id intern(const AssetHash& hash);
+
+    AssetHash hash(Id id) const;
+    /// the 40 hex digit name of the object file
+    QString hexName(Id id) const;
+    /// "xx/<hash>", where the object lives below assets/objects and the resources server
+    QString relativePath(Id id) const;
+
+    int size() const;
+
+   private:
+    // lookups are a binary search over m_sorted, which holds ids in order of their hash
+    int lowerBound(const AssetHash& hash) const;
+
+    mutable QReadWriteLock m_lock;
+    std::vector<AssetHash> m_hashes;
+    std::vector<Id> m_sorted;
+};
@@ -38,14 +38,17 @@
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonParseError>
-#include <QVariant>
+#include <QSet>
+#include <QtConcurrentMap>
+
+#include <filesystem>
 
 #include "AssetsUtils.h"
 #include "BuildConfig.h"
+#include "CryptoHash.h"
 #include "FileSystem.h"
+#include "JsonOnDemand.h"
+#include "StringUtils.h"
 #include "net/ApiDownload.h"
 #include "net/ChecksumValidator.h"
 #include "net/Download.h"
@@ -64,17 +67,64 @@ QSet<QString> collectPathsFromDir(QString dirPath)
 
     QSet<QString> out;
 
-    QDirIterator iter(dirPath, QDirIterator::Subdirectories);
+    QDirIterator iter(dirPath, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
     while (iter.hasNext()) {
-        QString value = iter.next();
-        QFileInfo info(value);
-        if (info.isFile()) {
-            out.insert(value);
-            qDebug() << value;
-        }
+        out.insert(iter.next());
     }
     return out;
 }
+
+/*
+ * Objects live in 256 folders named after the first two characters of their hash. Listing only the folders the index
+ * uses, in parallel, is much cheaper than looking at thousands of files one at a time.
+ * Returns the size of every present object, by hash.
+ */
+QHash<AssetHash, qint64> listObjects(const QVector<QPair<QString, AssetObject>>& objects)
+{
+    QSet<QString> bucketSet;
+    for (auto& entry : objects)
+        bucketSet.insert(entry.second.getRelPath().left(2));
+    const QStringList buckets = bucketSet.values();
+
+    using Listing = QHash<AssetHash, qint64>;
+    const auto listings = QtConcurrent::blockingMapped<QList<Listing>>(buckets, [](const QString& bucket) {
+        Listing files;
+        QDirIterator iter("assets/objects/" + bucket, QDir::Files | QDir::Hidden);
+        while (iter.hasNext()) {
+            iter.next();
+            AssetHash hash;
+            if (!AssetHash::fromHex(iter.fileName(), hash))
+                continue;
+            // on Windows the size comes with the listing, elsewhere this is one stat per file, still in parallel
+            files.insert(hash, iter.fileInfo().size());
+        }
+        return files;
+    });
+    Listing present;
+    for (auto& listing : listings)
+        present.insert(listing);
+    return present;
+}
+
+/*
+ * Written next to a reconstructed folder once everything in the index is in it. Not inside it, because old versions
+ * of the game take every file in there for a resource.
+ */
+QString reconstructedStampPath(const QString& targetPath)
+{
+    QFileInfo target(targetPath);
+    return FS::PathCombine(target.absolutePath(), "." + target.fileName() + ".prism-assets");
+}
+
+QByteArray indexHash(const QString& indexPath)
+{
+    QFile file(indexPath);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    CryptoHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return hash.result().toHex();
+}
 }  // namespace
 
 namespace AssetsUtils {
@@ -112,13 +162,13 @@ bool loadAssetsIndexJson(const QString& assetsId, const QString& path, AssetsInd
     QByteArray jsonData = file.readAll();
     file.close();
 
-    QJsonParseError parseError;
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonData, &parseError);
+    // indexes hold thousands of objects, so they are read straight from the text instead of building a QJsonDocument
+    auto jsonDoc = Json::OnDemand::Document::parse(jsonData);
 
     // Fail if the JSON is invalid.
-    if (parseError.error != QJsonParseError::NoError) {
-        qCritical() << "Failed to parse assets index file:" << parseError.errorString() << "at offset "
-                    << QString::number(parseError.offset);
+    if (jsonDoc.isNull()) {
+        qCritical() << "Failed to parse assets index file:" << jsonDoc.errorString() << "at offset "
+                    << QString::number(jsonDoc.errorOffset());
         return false;
     }
 
@@ -128,44 +178,50 @@ bool loadAssetsIndexJson(const QString& assetsId, const QString& path, AssetsInd
         return false;
     }
 
-    QJsonObject root = jsonDoc.object();
+    auto root = jsonDoc.object();
 
-    QJsonValue isVirtual = root.value("virtual");
+    auto isVirtual = root.value(QLatin1String("virtual"));
     if (!isVirtual.isUndefined()) {
         index.isVirtual = isVirtual.toBool(false);
     }
 
-    QJsonValue mapToResources = root.value("map_to_resources");
+    auto mapToResources = root.value(QLatin1String("map_to_resources"));
     if (!mapToResources.isUndefined()) {
         index.mapToResources = mapToResources.toBool(false);
     }
 
-    QJsonValue objects = root.value("objects");
-    QVariantMap map = objects.toVariant().toMap();
-
-    for (QVariantMap::const_iterator iter = map.begin(); iter != map.end(); ++iter) {
-        // qDebug() << iter.key();
-
-        QVariant variant = iter.value();
-        QVariantMap nested_objects = variant.toMap();
+    auto objects = root.value(QLatin1String("objects")).toObject();
+    const int count = objects.size();
+    index.objects.reserve(count);
+    QVector<AssetHash> hashes;
+    hashes.reserve(count);
+    for (auto iter = objects.begin(); iter != objects.end(); ++iter) {
+        auto nested_objects = iter.value().toObject();
 
         AssetObject object;
-
-        for (QVariantMap::const_iterator nested_iter = nested_objects.begin(); nested_iter != nested_objects.end(); ++nested_iter) {
-            // qDebug() << nested_iter.key() << nested_iter.value().toString();
-            QString key = nested_iter.key();
-            QVariant value = nested_iter.value();
-
-            if (key == "hash") {
-                object.hash = value.toString();
-            } else if (key == "size") {
-                object.size = value.toDouble();
+        AssetHash hash;
+        bool validHash = false;
+
+        for (auto nested_iter = nested_objects.begin(); nested_iter != nested_objects.end(); ++nested_iter) {
+            if (nested_iter.keyEquals(QLatin1String("hash"))) {
+                validHash = AssetHash::fromHex(nested_iter.value().toString(), hash);
+            } else if (nested_iter.keyEquals(QLatin1String("size"))) {
+                object.size = nested_iter.value().toInteger();
             }
         }
 
-        index.objects.insert(iter.key(), object);
+        if (!validHash) {
+            qWarning() << "Skipping asset" << iter.key() << "without a valid hash in" << path;
+            continue;
+        }
+        index.objects.append({ iter.key(), object });
+        hashes.append(hash);
     }
 
+    const auto ids = AssetObjectRegistry::instance().intern(hashes);
+    for (int i = 0; i < ids.size(); i++)
+        index.objects[i].second.hashId = ids[i];
+
     return true;
 }
 
@@ -238,31 +294,78 @@ bool reconstructAssets(QString assetsId, QString resourcesFolder)
     }
 
     if (!targetPath.isNull()) {
+        // nothing to do when the folder was already completed from this very index
+        const auto stampPath = reconstructedStampPath(targetPath);
+        const auto stamp = indexHash(indexPath);
+        {
+            QFile stampFile(stampPath);
+            if (!stamp.isEmpty() && QFileInfo(targetPath).isDir() && stampFile.open(QIODevice::ReadOnly) && stampFile.readAll() == stamp) {
+                qDebug() << "Assets in" << targetPath << "are up to date";
+                return true;
+            }
+        }
+
         auto presentFiles = collectPathsFromDir(targetPath);
-        for (QString map : index.objects.keys()) {
-            AssetObject asset_object = index.objects.value(map);
+        const auto presentObjects = listObjects(index.objects);
+
+        // the shared folders are only read from, so they can be hard links into the object store; an instance's
+        // resources get reflinks or copies, which are safe to change
+        FS::ensureFolderPathExists(targetPath);
+        const bool canClone = FS::canClone(objectDir.path(), targetPath);
+        const bool canHardLink = removeLeftovers && FS::canLink(objectDir.path(), targetPath) &&
+                                 FS::statFS(objectDir.path()).rootPath == FS::statFS(targetPath).rootPath;
+        if (canClone)
+            qDebug() << "Reflinking assets into" << targetPath;
+        else if (canHardLink)
+            qDebug() << "Hard linking assets into" << targetPath;
+
+        bool complete = true;
+        int placed = 0;
+        for (auto& entry : index.objects) {
+            auto& map = entry.first;
+            auto& asset_object = entry.second;
             QString target_path = FS::PathCombine(targetPath, map);
-            QFile target(target_path);
-
-            QString tlk = asset_object.hash.left(2);
 
-            QString original_path = FS::PathCombine(objectDir.path(), tlk, asset_object.hash);
-            QFile original(original_path);
-            if (!original.exists())
+            if (presentObjects.value(asset_object.hash(), -1) != asset_object.size) {
+                complete = false;
                 continue;
+            }
 
-            presentFiles.remove(target_path);
+            if (presentFiles.remove(target_path))
+                continue;
 
-            if (!target.exists()) {
-                QFileInfo info(target_path);
-                QDir target_dir = info.dir();
+            QString original_path = FS::PathCombine(objectDir.path(), asset_object.getRelPath());
+            if (!FS::ensureFilePathExists(target_path)) {
+                complete = false;
+                continue;
+            }
 
-                qDebug() << target_dir.path();
-                FS::ensureFolderPathExists(target_dir.path());
+            std::error_code err;
+            bool done = canClone && FS::clone_file(original_path, target_path, err);
+            if (!done && canHardLink) {
+                err.clear();
+                std::filesystem::create_hard_link(StringUtils::toStdString(original_path), StringUtils::toStdString(target_path), err);
+                done = !err;
+            }
+            if (!done)
+                done = QFile::copy(original_path, target_path);
+            if (!done) {
+                qWarning() << "Failed to place" << original_path << "at" << target_path;
+                complete = false;
+                continue;
+            }
+            placed++;
+        }
+        qDebug() << "Placed" << placed << "assets in" << targetPath;
 
-                bool couldCopy = original.copy(target_path);
-                qDebug() << " Copying" << original_path << "to" << target_path << QString::number(couldCopy);
+        if (complete && !stamp.isEmpty()) {
+            try {
+                FS::write(stampPath, stamp);
+            } catch (const FS::FileSystemException& e) {
+                qWarning() << "Failed to write" << stampPath << ":" << e.cause();
             }
+        } else {
+            QFile::remove(stampPath);
         }
 
         // TODO: Write last used time to virtualRoot/.lastused
@@ -280,41 +383,55 @@ bool reconstructAssets(QString assetsId, QString resourcesFolder)
 Net::NetRequest::Ptr AssetObject::getDownloadAction()
 {
     QFileInfo objectFile(getLocalPath());
-    if ((!objectFile.isFile()) || (objectFile.size() != size)) {
-        auto objectDL = Net::ApiDownload::makeFile(getUrl(), objectFile.filePath());
-        if (hash.size()) {
-            auto rawHash = QByteArray::fromHex(hash.toLatin1());
-            objectDL->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, rawHash));
-        }
-        objectDL->setProgress(objectDL->getProgress(), size);
-        return objectDL;
-    }
+    if ((!objectFile.isFile()) || (objectFile.size() != size))
+        return makeDownloadAction();
     return nullptr;
 }
 
-QString AssetObject::getLocalPath()
+Net::NetRequest::Ptr AssetObject::makeDownloadAction()
+{
+    auto objectDL = Net::ApiDownload::makeFile(getUrl(), getLocalPath());
+    const auto rawHash = hash();
+    objectDL->addValidator(new Net::ChecksumValidator(
+        QCryptographicHash::Sha1, QByteArray(reinterpret_cast<const char*>(rawHash.bytes.data()), int(rawHash.bytes.size()))));
+    objectDL->setProgress(objectDL->getProgress(), size);
+    objectDL->setPriority(Net::NetRequest::Priority::Bulk);
+    return objectDL;
+}
+
+QString AssetObject::getLocalPath() const
 {
     return "assets/objects/" + getRelPath();
 }
 
-QUrl AssetObject::getUrl()
+QUrl AssetObject::getUrl() const
 {
     return BuildConfig.RESOURCE_BASE + getRelPath();
 }
 
-QString AssetObject::getRelPath()
+QString AssetObject::getRelPath() const
 {
-    return hash.left(2) + "/" + hash;
+    return AssetObjectRegistry::instance().relativePath(hashId);
+}
+
+AssetHash AssetObject::hash() const
+{
+    return AssetObjectRegistry::instance().hash(hashId);
 }
 
 NetJob::Ptr AssetsIndex::getDownloadJob()
 {
+    const auto present = listObjects(objects);
+
     auto job = makeShared<NetJob>(QObject::tr("Assets for %1").arg(id), APPLICATION->network());
-    for (auto& object : objects.values()) {
-        auto dl = object.getDownloadAction();
-        if (dl) {
-            job->addNetAction(dl);
-        }
+    QSet<AssetObjectRegistry::Id> queued;
+    for (auto& entry : objects) {
+        auto& object = entry.second;
+        // several names often share one object
+        if (present.value(object.hash(), -1) == object.size || queued.contains(object.hashId))
+            continue;
+        queued.insert(object.hashId);
+        job->addNetAction(object.makeDownloadAction());
     }
     if (job->size())
         return job;
@@ -15,26 +15,33 @@
 
 #pragma once
 
-#include <QMap>
+#include <QPair>
+#include <QVector>
 #include <QString>
+#include "minecraft/AssetObjectRegistry.h"
 #include "net/NetJob.h"
 #include "net/NetRequest.h"
 
 struct AssetObject {
-    QString getRelPath();
-    QUrl getUrl();
-    QString getLocalPath();
+    QString getRelPath() const;
+    QUrl getUrl() const;
+    QString getLocalPath() const;
+    AssetHash hash() const;
+    /// null when the object is already there with the right size
     Net::NetRequest::Ptr getDownloadAction();
+    Net::NetRequest::Ptr makeDownloadAction();
 
-    QString hash;
-    qint64 size;
+    /// where the hash is kept in the AssetObjectRegistry
+    AssetObjectRegistry::Id hashId = 0;
+    qint64 size = 0;
 };
 
 struct AssetsIndex {
     NetJob::Ptr getDownloadJob();
 
     QString id;
-    QMap<QString, AssetObject> objects;
+    /// asset names and their objects, in index order
+    QVector<QPair<QString, AssetObject>> objects;
     bool isVirtual = false;
     bool mapToResources = false;
 };
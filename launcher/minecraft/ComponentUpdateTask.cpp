@@ -7,6 +7,7 @@
 #include "Version.h"
 #include "cassert"
 #include "meta/Index.h"
+#include "meta/SyncTask.h"
 #include "meta/Version.h"
 #include "minecraft/OneSixVersionFormat.h"
 #include "minecraft/ProfileUtils.h"
@@ -150,8 +151,46 @@ static LoadResult loadIndex(Task::Ptr& loadTask, Net::Mode netmode)
 }
 }  // namespace
 
+bool ComponentUpdateTask::syncMetadata()
+{
+    QList<Meta::Version::Ptr> versions;
+    QSet<QString> installedUids;
+    for (auto component : d->m_list->d->components) {
+        installedUids.insert(component->m_uid);
+        if (component->m_loaded || component->m_version.isEmpty() || QFile::exists(component->getFilename())) {
+            continue;
+        }
+        const QString key = component->m_uid + ':' + component->m_version;
+        if (d->syncedVersions.contains(key)) {
+            continue;
+        }
+        d->syncedVersions.insert(key);
+        versions.append(APPLICATION->metadataIndex()->get(component->m_uid, component->m_version));
+    }
+    if (versions.isEmpty()) {
+        return false;
+    }
+
+    // what they require comes along, so resolving the dependencies usually doesn't need another sweep
+    d->syncTask.reset(new Meta::SyncTask(versions, installedUids));
+    connect(d->syncTask.get(), &Task::status, this, &ComponentUpdateTask::setStatus);
+    connect(d->syncTask.get(), &Task::finished, this, [this]() {
+        d->syncTask.reset();
+        if (isRunning()) {
+            loadComponents();
+        }
+    });
+    d->syncTask->start();
+    return true;
+}
+
 void ComponentUpdateTask::loadComponents()
 {
+    // fetch whatever is out of date in one go first, then everything loads from disk below
+    if (d->netmode == Net::Mode::Online && syncMetadata()) {
+        return;
+    }
+
     LoadResult result = LoadResult::LoadedLocal;
     size_t taskIndex = 0;
     size_t componentIndex = 0;
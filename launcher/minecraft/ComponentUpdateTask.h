@@ -21,6 +21,7 @@ class ComponentUpdateTask : public Task {
 
    private:
     void loadComponents();
+    bool syncMetadata();
     void resolveDependencies(bool checkOnly);
 
     void remoteLoadSucceeded(size_t index);
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <QList>
+#include <QSet>
 #include <QString>
 #include <cstddef>
 #include "net/Mode.h"
+#include "tasks/Task.h"
 
 class PackProfile;
 
@@ -20,6 +22,9 @@ struct ComponentUpdateTaskData {
     QList<RemoteLoadStatus> remoteLoadStatusList;
     bool remoteLoadSuccessful = true;
     size_t remoteTasksInProgress = 0;
+    // metadata versions that went through a sync already, as uid:version
+    QSet<QString> syncedVersions;
+    Task::Ptr syncTask;
     ComponentUpdateTask::Mode mode;
     Net::Mode netmode;
 };
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2022 Sefa Eyeoglu <contact@scrumplex.net>
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * This file incorporates work covered by the following copyright and
+ * permission notice:
+ *
+ *      Copyright 2013-2021 MultiMC Contributors
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "GradleSpecifier.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+namespace {
+struct Pool {
+    QMutex mutex;
+    QSet<QString> strings;
+    QHash<QString, int> names{ { QStringLiteral("::"), 0 } };
+};
+
+Pool& pool()
+{
+    static Pool s_pool;
+    return s_pool;
+}
+}  // namespace
+
+QString GradleSpecifier::intern(const QString& value)
+{
+    if (value.isEmpty())
+        return value;
+
+    auto& p = pool();
+    QMutexLocker locker(&p.mutex);
+    auto it = p.strings.constFind(value);
+    if (it != p.strings.constEnd())
+        return *it;
+    p.strings.insert(value);
+    return value;
+}
+
+int GradleSpecifier::internName(const QString& groupId, const QString& artifactId, const QString& classifier)
+{
+    auto key = groupId + ':' + artifactId + ':' + classifier;
+
+    auto& p = pool();
+    QMutexLocker locker(&p.mutex);
+    auto it = p.names.constFind(key);
+    if (it != p.names.constEnd())
+        return *it;
+    int id = p.names.size();
+    p.names.insert(key, id);
+    return id;
+}
@@ -54,24 +54,26 @@ struct GradleSpecifier {
          4 "jdk15"
          5 "jar"
         */
-        QRegularExpression matcher(
+        static const QRegularExpression s_matcher(
             QRegularExpression::anchoredPattern("([^:@]+):([^:@]+):([^:@]+)"
                                                 "(?::([^:@]+))?"
                                                 "(?:@([^:@]+))?"));
-        QRegularExpressionMatch match = matcher.match(value);
+        QRegularExpressionMatch match = s_matcher.match(value);
         m_valid = match.hasMatch();
         if (!m_valid) {
             m_invalidValue = value;
+            m_nameId = internName(m_groupId, m_artifactId, m_classifier);
             return *this;
         }
-        auto elements = match.captured();
-        m_groupId = match.captured(1);
-        m_artifactId = match.captured(2);
-        m_version = match.captured(3);
-        m_classifier = match.captured(4);
+        // the same few groups and artifacts show up in every instance, so they all share one copy of each
+        m_groupId = intern(match.captured(1));
+        m_artifactId = intern(match.captured(2));
+        m_version = intern(match.captured(3));
+        m_classifier = intern(match.captured(4));
         if (match.lastCapturedIndex() >= 5) {
             m_extension = match.captured(5);
         }
+        m_nameId = internName(m_groupId, m_artifactId, m_classifier);
         return *this;
     }
     QString serialize() const
@@ -120,35 +122,41 @@ struct GradleSpecifier {
     inline QString version() const { return m_version; }
     inline QString groupId() const { return m_groupId; }
     inline QString artifactId() const { return m_artifactId; }
-    inline void setClassifier(const QString& classifier) { m_classifier = classifier; }
+    inline void setClassifier(const QString& classifier)
+    {
+        m_classifier = intern(classifier);
+        m_nameId = internName(m_groupId, m_artifactId, m_classifier);
+    }
     inline QString classifier() const { return m_classifier; }
     inline QString extension() const { return m_extension; }
     inline QString artifactPrefix() const { return m_groupId + ":" + m_artifactId; }
-    bool matchName(const GradleSpecifier& other) const
-    {
-        return other.artifactId() == artifactId() && other.groupId() == groupId() && other.classifier() == classifier();
-    }
+    /** Identifies the group, artifact and classifier, the same for every specifier with the same ones. */
+    inline int nameId() const { return m_nameId; }
+    bool matchName(const GradleSpecifier& other) const { return other.m_nameId == m_nameId; }
     bool operator==(const GradleSpecifier& other) const
     {
-        if (m_groupId != other.m_groupId)
-            return false;
-        if (m_artifactId != other.m_artifactId)
+        if (m_nameId != other.m_nameId)
             return false;
         if (m_version != other.m_version)
             return false;
-        if (m_classifier != other.m_classifier)
-            return false;
         if (m_extension != other.m_extension)
             return false;
         return true;
     }
 
    private:
+    /// The pooled copy of 'value', shared by everything that interned an equal string.
+    static QString intern(const QString& value);
+    /// A number for the name, the same for every specifier with that group, artifact and classifier.
+    static int internName(const QString& groupId, const QString& artifactId, const QString& classifier);
+
     QString m_invalidValue;
     QString m_groupId;
     QString m_artifactId;
     QString m_version;
     QString m_classifier;
     DefaultVariable<QString> m_extension = DefaultVariable<QString>("jar");
+    // the name with an empty group, artifact and classifier
+    int m_nameId = 0;
     bool m_valid = false;
 };
@@ -0,0 +1,352 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "InstanceRepairTask.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+
+#include <algorithm>
+
+#include "Application.h"
+#include "CryptoHash.h"
+#include "FileSystem.h"
+#include "minecraft/AssetsUtils.h"
+#include "minecraft/MinecraftInstance.h"
+#include "minecraft/PackProfile.h"
+#include "minecraft/mod/MetadataHandler.h"
+#include "net/ApiDownload.h"
+#include "net/ChecksumValidator.h"
+#include "net/HttpMetaCache.h"
+#include "tasks/CpuExecutor.h"
+
+namespace {
+
+// a few chunks per worker, so the ones with big files in them don't hold up the end
+constexpr int CHUNKS_PER_WORKER = 4;
+
+bool algorithmFor(const QString& hashFormat, QCryptographicHash::Algorithm& algorithm)
+{
+    auto format = hashFormat.toLower();
+    if (format == "md5")
+        algorithm = QCryptographicHash::Md5;
+    else if (format == "sha1")
+        algorithm = QCryptographicHash::Sha1;
+    else if (format == "sha256")
+        algorithm = QCryptographicHash::Sha256;
+    else if (format == "sha512")
+        algorithm = QCryptographicHash::Sha512;
+    else
+        return false;
+    return true;
+}
+
+}  // namespace
+
+InstanceRepairTask::InstanceRepairTask(std::shared_ptr<MinecraftInstance> inst, QObject* parent) : Task(parent), m_inst(std::move(inst))
+{
+    connect(&m_planWatcher, &QFutureWatcher<Plan>::finished, this, &InstanceRepairTask::planned);
+}
+
+QString InstanceRepairTask::summary() const
+{
+    QStringList lines;
+    lines << tr("Checked %n file(s).", "", m_report.checked);
+    if (m_report.repaired == 0 && m_report.unrepairable.isEmpty())
+        lines << tr("Nothing was broken.");
+    else
+        lines << tr("Downloaded %n broken or missing file(s) again.", "", m_report.repaired);
+    if (!m_report.unrepairable.isEmpty())
+        lines << tr("These are broken or missing, and can't be downloaded again:\n%1").arg(m_report.unrepairable.join('\n'));
+    return lines.join('\n');
+}
+
+void InstanceRepairTask::executeTask()
+{
+    m_files.clear();
+    m_broken.clear();
+    m_chunks.clear();
+    m_hasIndex = false;
+    m_indexRepaired = false;
+    m_report = {};
+
+    // the components have to be resolved to know which files the instance needs
+    setStatus(tr("Loading the components of the instance"));
+    auto components = m_inst->getPackProfile();
+    if (!components->getCurrentTask())
+        components->reload(Net::Mode::Offline);
+    if (auto resolving = components->getCurrentTask()) {
+        connect(resolving.get(), &Task::finished, this, &InstanceRepairTask::collect);
+        return;
+    }
+    collect();
+}
+
+void InstanceRepairTask::collect()
+{
+    if (!isRunning())
+        return;
+
+    auto profile = m_inst->getPackProfile()->getProfile();
+    if (!profile || profile->getProblemSeverity() == ProblemSeverity::Error) {
+        emitFailed(tr("The components of %1 could not be loaded, so it isn't known which files it needs.").arg(m_inst->name()));
+        return;
+    }
+
+    auto metacache = APPLICATION->metacache();
+    auto librariesPath = metacache->getBasePath("libraries");
+    auto addLibraries = [&](const QList<LibraryPtr>& libraries, const QString& overridePath) {
+        for (auto& library : libraries) {
+            if (!library)
+                continue;
+            bool local = library->isLocal();
+            library->forEachDownload(m_inst->runtimeContext(), [&](const QString& storage, const QString& url, const QString& sha1) {
+                File file{ File::Kind::Library };
+                if (local) {
+                    file.path = FS::PathCombine(overridePath, QFileInfo(storage).fileName());
+                } else {
+                    file.path = FS::PathCombine(librariesPath, storage);
+                    file.url = url;
+                    file.cacheRelative = storage;
+                }
+                file.expected = sha1.toLower();
+                m_files.append(file);
+            });
+        }
+    };
+
+    QList<LibraryPtr> libraries;
+    libraries.append(profile->getLibraries());
+    libraries.append(profile->getNativeLibraries());
+    libraries.append(profile->getMavenFiles());
+    for (auto agent : profile->getAgents())
+        libraries.append(agent->library());
+    libraries.append(profile->getMainJar());
+    addLibraries(libraries, m_inst->getLocalLibraryPath());
+    addLibraries(profile->getJarMods(), m_inst->jarModsDir());
+
+    if (auto assets = profile->getMinecraftAssets()) {
+        m_index = { File::Kind::AssetIndex };
+        m_index.cacheRelative = assets->id + ".json";
+        m_index.path = FS::PathCombine(metacache->getBasePath("asset_indexes"), m_index.cacheRelative);
+        m_index.expected = assets->sha1.toLower();
+        m_index.url = assets->url;
+        m_hasIndex = true;
+    }
+    plan();
+}
+
+void InstanceRepairTask::plan()
+{
+    setStatus(tr("Finding the files of the instance"));
+    m_planWatcher.setFuture(CpuExecutor::run(CpuExecutor::Priority::Interactive,
+                                             [index = m_hasIndex ? m_index : File{ File::Kind::AssetIndex }, modsDir = m_inst->modsRoot()] {
+                                                 return makePlan(index, modsDir);
+                                             }));
+}
+
+auto InstanceRepairTask::makePlan(File index, QString modsDir) -> Plan
+{
+    Plan out;
+
+    // the objects are only known from an intact index
+    if (!index.path.isEmpty()) {
+        AssetsIndex assets;
+        out.indexBroken = !isIntact(index) || !AssetsUtils::loadAssetsIndexJson(QFileInfo(index.path).completeBaseName(), index.path, assets);
+        QSet<QString> seen;
+        for (auto& entry : assets.objects) {
+            auto& object = entry.second;
+            File file{ File::Kind::AssetObject };
+            file.path = object.getLocalPath();
+            // objects are shared between all the names with the same content
+            if (out.indexBroken || seen.contains(file.path))
+                continue;
+            seen.insert(file.path);
+            auto hash = object.hash();
+            file.expected = QString::fromLatin1(QByteArray(reinterpret_cast<const char*>(hash.bytes.data()), int(hash.bytes.size())).toHex());
+            file.url = object.getUrl().toString();
+            file.size = object.size;
+            out.files.append(file);
+        }
+    }
+
+    QDir indexDir(FS::PathCombine(modsDir, ".index"));
+    for (auto& name : indexDir.entryList({ "*.pw.toml" }, QDir::Files)) {
+        auto mod = Metadata::get(indexDir, name);
+        if (!mod.isValid() || mod.filename.isEmpty())
+            continue;
+        File file{ File::Kind::Mod };
+        file.path = FS::PathCombine(modsDir, mod.filename);
+        if (!QFileInfo::exists(file.path) && QFileInfo::exists(file.path + ".disabled"))
+            file.path += ".disabled";
+        // the CurseForge fingerprint isn't a hash of the file as it is, it can only be checked to be there
+        if (algorithmFor(mod.hash_format, file.algorithm))
+            file.expected = mod.hash.toLower();
+        file.url = mod.url.toString();
+        out.files.append(file);
+    }
+    return out;
+}
+
+bool InstanceRepairTask::isIntact(const File& file)
+{
+    QFile data(file.path);
+    if (!data.open(QIODevice::ReadOnly))
+        return false;
+    if (file.size >= 0 && data.size() != file.size)
+        return false;
+    if (file.expected.isEmpty())
+        return true;
+    CryptoHash hash(file.algorithm);
+    return hash.addData(&data) && hash.result().toHex() == file.expected.toLatin1();
+}
+
+void InstanceRepairTask::planned()
+{
+    if (!isRunning())
+        return;
+
+    auto result = m_planWatcher.result();
+    if (m_hasIndex) {
+        if (result.indexBroken && !m_indexRepaired) {
+            repairIndex();
+            return;
+        }
+        m_report.checked++;
+        if (result.indexBroken)
+            m_report.unrepairable << m_index.path;
+        else if (m_indexRepaired)
+            m_report.repaired++;
+    }
+    m_files.append(result.files);
+    check();
+}
+
+void InstanceRepairTask::repairIndex()
+{
+    qDebug() << "Downloading the asset index" << m_index.path << "again, it is broken";
+    setStatus(tr("Downloading the asset index again"));
+    m_indexRepaired = true;
+    QFile::remove(m_index.path);
+
+    auto entry = APPLICATION->metacache()->resolveEntry("asset_indexes", m_index.cacheRelative);
+    entry->setStale(true);
+    auto dl = Net::ApiDownload::makeCached(m_index.url, entry);
+    if (!m_index.expected.isEmpty())
+        dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, QByteArray::fromHex(m_index.expected.toLatin1())));
+
+    m_job = makeShared<NetJob>(tr("Asset index for %1").arg(m_inst->name()), APPLICATION->network());
+    m_job->addNetAction(dl);
+    // whether it worked is found out by checking it again
+    connect(m_job.get(), &NetJob::succeeded, this, &InstanceRepairTask::plan);
+    connect(m_job.get(), &NetJob::failed, this, &InstanceRepairTask::plan);
+    connect(m_job.get(), &NetJob::aborted, this, &InstanceRepairTask::emitAborted);
+    m_job->start();
+}
+
+void InstanceRepairTask::check()
+{
+    setStatus(tr("Checking %n file(s)", "", m_files.size()));
+    if (m_files.isEmpty()) {
+        redownload();
+        return;
+    }
+
+    // every chunk takes every n-th file, so the big ones that are listed together are spread out
+    int chunks = std::min<int>(m_files.size(), CpuExecutor::maxThreadCount() * CHUNKS_PER_WORKER);
+    m_chunksLeft = chunks;
+    setProgress(0, chunks);
+    for (int chunk = 0; chunk < chunks; chunk++) {
+        auto watcher = std::make_unique<QFutureWatcher<QList<int>>>();
+        connect(watcher.get(), &QFutureWatcher<QList<int>>::finished, this,
+                [this, finished = watcher.get()] { chunkChecked(finished->result()); });
+        watcher->setFuture(CpuExecutor::run(CpuExecutor::Priority::Bulk, [files = m_files, chunk, chunks] {
+            QList<int> broken;
+            for (int i = chunk; i < files.size(); i += chunks) {
+                if (!isIntact(files[i]))
+                    broken.append(i);
+            }
+            return broken;
+        }));
+        m_chunks.push_back(std::move(watcher));
+    }
+}
+
+void InstanceRepairTask::chunkChecked(const QList<int>& broken)
+{
+    if (!isRunning())
+        return;
+    m_broken.append(broken);
+    m_chunksLeft--;
+    setProgress(static_cast<qint64>(m_chunks.size()) - m_chunksLeft, static_cast<qint64>(m_chunks.size()));
+    if (m_chunksLeft == 0)
+        redownload();
+}
+
+void InstanceRepairTask::redownload()
+{
+    m_report.checked += m_files.size();
+    std::sort(m_broken.begin(), m_broken.end());
+
+    auto metacache = APPLICATION->metacache();
+    m_job = makeShared<NetJob>(tr("Broken files of %1").arg(m_inst->name()), APPLICATION->network());
+    for (auto i : m_broken) {
+        auto& file = m_files[i];
+        if (file.url.isEmpty()) {
+            qWarning() << file.path << "is broken or missing, and can't be downloaded again";
+            m_report.unrepairable << file.path;
+            continue;
+        }
+        qDebug() << "Downloading" << file.path << "again, it is broken or missing";
+        // otherwise the metacache would ask whether the broken file is still current
+        QFile::remove(file.path);
+
+        Net::Download::Ptr dl;
+        if (file.kind == File::Kind::Library) {
+            auto entry = metacache->resolveEntry("libraries", file.cacheRelative);
+            entry->setStale(true);
+            dl = Net::ApiDownload::makeCached(file.url, entry, Net::Download::Option::MakeEternal);
+        } else {
+            dl = Net::ApiDownload::makeFile(file.url, file.path);
+        }
+        if (!file.expected.isEmpty())
+            dl->addValidator(new Net::ChecksumValidator(file.algorithm, QByteArray::fromHex(file.expected.toLatin1())));
+        dl->setPriority(Net::NetRequest::Priority::Bulk);
+        m_job->addNetAction(dl);
+    }
+
+    if (m_job->size() == 0) {
+        m_job.reset();
+        emitSucceeded();
+        return;
+    }
+
+    setStatus(tr("Downloading %n broken file(s) again", "", m_job->size()));
+    connect(m_job.get(), &NetJob::succeeded, this, [this] {
+        m_report.repaired += m_job->size();
+        emitSucceeded();
+    });
+    connect(m_job.get(), &NetJob::failed, this, [this](QString reason) {
+        auto failed = m_job->getFailedFiles();
+        m_report.repaired += m_job->size() - failed.size();
+        m_report.unrepairable << failed;
+        emitFailed(tr("Some broken files could not be downloaded again:\n%1").arg(reason));
+    });
+    connect(m_job.get(), &NetJob::aborted, this, &InstanceRepairTask::emitAborted);
+    connect(m_job.get(), &NetJob::progress, this, &InstanceRepairTask::progress);
+    connect(m_job.get(), &NetJob::stepProgress, this, &InstanceRepairTask::propagateStepProgress);
+    m_job->start();
+}
+
+bool InstanceRepairTask::abort()
+{
+    if (m_job && m_job->isRunning())
+        return m_job->abort();
+    // what the workers find afterwards is ignored
+    emitAborted();
+    return true;
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QCryptographicHash>
+#include <QFutureWatcher>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+#include "net/NetJob.h"
+#include "tasks/Task.h"
+
+class MinecraftInstance;
+
+/** Checks the files an instance is made of against their expected hashes, and downloads the broken ones again.
+ *
+ *  That is the libraries and jar mods of its components, the asset index and its objects, and the mods that have
+ *  metadata from a platform. Everything is hashed in parallel, each file read once, and only what is missing or
+ *  doesn't match is downloaded again.
+ *
+ *  Files without a known hash are only checked to be there. Local files, and mods without a download URL, can't be
+ *  downloaded again and are reported instead.
+ */
+class InstanceRepairTask : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<InstanceRepairTask>;
+
+    struct Report {
+        int checked = 0;
+        int repaired = 0;
+        // broken files that could not be downloaded again
+        QStringList unrepairable;
+    };
+
+    explicit InstanceRepairTask(std::shared_ptr<MinecraftInstance> inst, QObject* parent = nullptr);
+
+    const Report& report() const { return m_report; }
+    /* The report, in words. */
+    QString summary() const;
+
+    bool canAbort() const override { return true; }
+
+   public slots:
+    bool abort() override;
+
+   protected:
+    void executeTask() override;
+
+   private:
+    struct File {
+        enum class Kind { Library, AssetIndex, AssetObject, Mod };
+        Kind kind;
+        QString path;
+        QCryptographicHash::Algorithm algorithm = QCryptographicHash::Sha1;
+        // lower case hex, empty when the file can only be checked to be there
+        QString expected;
+        // empty when the file can't be downloaded again
+        QString url;
+        // where the metacache keeps track of it, for libraries
+        QString cacheRelative;
+        qint64 size = -1;
+    };
+    struct Plan {
+        QList<File> files;
+        bool indexBroken = false;
+    };
+
+    void collect();
+    void plan();
+    void planned();
+    void repairIndex();
+    void check();
+    void chunkChecked(const QList<int>& broken);
+    void redownload();
+
+    static Plan makePlan(File index, QString modsDir);
+    static bool isIntact(const File& file);
+
+   private:
+    std::shared_ptr<MinecraftInstance> m_inst;
+
+    QList<File> m_files;
+    // the asset index, if the instance has one
+    File m_index;
+    bool m_hasIndex = false;
+    bool m_indexRepaired = false;
+
+    QFutureWatcher<Plan> m_planWatcher;
+    std::vector<std::unique_ptr<QFutureWatcher<QList<int>>>> m_chunks;
+    int m_chunksLeft = 0;
+    QList<int> m_broken;
+
+    NetJob::Ptr m_job;
+    Report m_report;
+};
@@ -0,0 +1,149 @@
+#include "LaunchPlan.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include "BuildConfig.h"
+#include "FileSystem.h"
+#include "minecraft/Component.h"
+#include "minecraft/MinecraftInstance.h"
+#include "minecraft/PackProfile.h"
+#include "modplatform/helpers/HashCache.h"
+
+namespace {
+constexpr quint32 LAUNCH_PLAN_MAGIC = 0x504C4C50;  // "PLLP"
+constexpr quint32 LAUNCH_PLAN_VERSION = 1;
+
+QString planPath(MinecraftInstance* instance)
+{
+    return FS::PathCombine("cache", "launchplans", instance->id() + ".dat");
+}
+
+/// everything the launch is computed from that can change without touching any library
+QByteArray keyFor(MinecraftInstance* instance)
+{
+    QCryptographicHash key(QCryptographicHash::Sha1);
+    key.addData(BuildConfig.printableVersionString().toUtf8());
+
+    auto context = instance->runtimeContext();
+    for (auto& part : { context.javaArchitecture, context.javaRealArchitecture, context.javaPath, context.system }) {
+        key.addData(part.toUtf8());
+        key.addData("\0", 1);
+    }
+
+    QFile pack(FS::PathCombine(instance->instanceRoot(), "mmc-pack.json"));
+    if (pack.open(QIODevice::ReadOnly))
+        key.addData(&pack);
+
+    QDir patches(FS::PathCombine(instance->instanceRoot(), "patches"));
+    for (auto& name : patches.entryList({ "*.json" }, QDir::Files, QDir::Name)) {
+        key.addData(name.toUtf8());
+        QFile patch(patches.absoluteFilePath(name));
+        if (patch.open(QIODevice::ReadOnly))
+            key.addData(&patch);
+    }
+    return key.result();
+}
+
+/// the libraries and the metadata they come from
+QStringList filesOf(MinecraftInstance* instance)
+{
+    QStringList files;
+    // the jar modded minecraft.jar is built during every launch, it doesn't come from the update
+    QDir bin(instance->binRoot());
+    for (auto& library : instance->getClassPath() + instance->getNativeJars()) {
+        if (!library.startsWith(bin.absolutePath() + '/'))
+            files.append(library);
+    }
+
+    auto components = instance->getPackProfile();
+    QDir meta("meta");
+    for (int i = 0; i < components->rowCount(); i++) {
+        auto component = components->getComponent(i);
+        auto metaFile = meta.absoluteFilePath(component->getID() + '/' + component->getVersion() + ".json");
+        if (QFileInfo::exists(metaFile))
+            files.append(metaFile);
+    }
+    return files;
+}
+}  // namespace
+
+namespace LaunchPlan {
+
+bool isUpToDate(MinecraftInstance* instance)
+{
+    QFile file(planPath(instance));
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic, version, count;
+    QByteArray key;
+    in >> magic >> version >> key >> count;
+    if (in.status() != QDataStream::Ok || magic != LAUNCH_PLAN_MAGIC || version != LAUNCH_PLAN_VERSION)
+        return false;
+    if (key != keyFor(instance))
+        return false;
+
+    for (quint32 i = 0; i < count; i++) {
+        QString path;
+        Hashing::FileIdentity identity;
+        in >> path >> identity.size >> identity.mtime >> identity.inode;
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "Launch plan is corrupted, doing a full update:" << file.fileName();
+            return false;
+        }
+        if (Hashing::FileIdentity::of(path) != identity) {
+            qDebug() << "Launch plan for" << instance->id() << "is out of date because of" << path;
+            return false;
+        }
+    }
+    return true;
+}
+
+void save(MinecraftInstance* instance)
+{
+    auto path = planPath(instance);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << "Failed to save launch plan:" << file.errorString();
+        return;
+    }
+
+    // take the key first, anything changing after that makes the plan outdated instead of wrong
+    auto key = keyFor(instance);
+    auto files = filesOf(instance);
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+
+    out << LAUNCH_PLAN_MAGIC << LAUNCH_PLAN_VERSION << key << static_cast<quint32>(files.size());
+    for (auto& filePath : files) {
+        auto identity = Hashing::FileIdentity::of(filePath);
+        if (!identity.isValid()) {
+            // the launch would have to fetch it, so there is no plan to save
+            file.cancelWriting();
+            invalidate(instance);
+            return;
+        }
+        out << filePath << identity.size << identity.mtime << identity.inode;
+    }
+
+    if (!file.commit())
+        qWarning() << "Failed to save launch plan:" << file.errorString();
+}
+
+void invalidate(MinecraftInstance* instance)
+{
+    QFile::remove(planPath(instance));
+}
+
+}  // namespace LaunchPlan
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QString>
+
+class MinecraftInstance;
+
+/**
+ * What a successful update verified about an instance: the files it launches with, and what they were computed from.
+ *
+ * While the components, the patches and the runtime context are the same, and all those files are untouched, there is
+ * nothing an online update could find to do, so launching can go straight to loading the local metadata.
+ * Checking that only takes a hash of a few small files and a stat call per library.
+ */
+namespace LaunchPlan {
+
+/// whether the plan saved by the last successful update still holds
+bool isUpToDate(MinecraftInstance* instance);
+
+/// records the files the instance launches with, right after an update made sure they are all there
+void save(MinecraftInstance* instance);
+
+/// forgets the saved plan, so the next launch does a full update
+void invalidate(MinecraftInstance* instance);
+
+}  // namespace LaunchPlan
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "LaunchPreparer.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+#include "Application.h"
+#include "InstanceList.h"
+#include "minecraft/LaunchPlan.h"
+#include "minecraft/MinecraftInstance.h"
+#include "tasks/CpuExecutor.h"
+
+namespace {
+// component edits come in bursts, one preparation after the last of them is enough
+constexpr int SETTLE_DELAY_MS = 30 * 1000;
+constexpr int FIRST_IDLE_CHECK_MS = 2 * 60 * 1000;
+constexpr int IDLE_CHECK_INTERVAL_MS = 30 * 60 * 1000;
+// how many of the instances played last are kept prepared
+constexpr int RECENTLY_PLAYED = 3;
+}  // namespace
+
+LaunchPreparer::LaunchPreparer(QObject* parent) : QObject(parent)
+{
+    m_settleTimer.setSingleShot(true);
+    m_settleTimer.setInterval(SETTLE_DELAY_MS);
+    connect(&m_settleTimer, &QTimer::timeout, this, &LaunchPreparer::prepareNext);
+
+    m_idleTimer.setInterval(IDLE_CHECK_INTERVAL_MS);
+    connect(&m_idleTimer, &QTimer::timeout, this, &LaunchPreparer::queueRecentlyPlayed);
+    m_idleTimer.start();
+    QTimer::singleShot(FIRST_IDLE_CHECK_MS, this, &LaunchPreparer::queueRecentlyPlayed);
+}
+
+LaunchPreparer::~LaunchPreparer()
+{
+    if (m_task && m_task->isRunning()) {
+        m_cancelled = true;
+        m_task->abort();
+    }
+}
+
+bool LaunchPreparer::enabled() const
+{
+    return APPLICATION->settings()->get("PrepareLaunchInBackground").toBool();
+}
+
+void LaunchPreparer::schedule(const QString& instanceId)
+{
+    if (!enabled()) {
+        return;
+    }
+    // it changed, so whatever made it fail may be gone
+    m_failed.remove(instanceId);
+    if (!m_queue.contains(instanceId)) {
+        m_queue.append(instanceId);
+    }
+    m_settleTimer.start();
+}
+
+void LaunchPreparer::queueRecentlyPlayed()
+{
+    if (!enabled() || CpuExecutor::gameRunning()) {
+        return;
+    }
+    auto instances = APPLICATION->instances();
+    QList<InstancePtr> played;
+    for (int i = 0; i < instances->count(); i++) {
+        auto instance = instances->at(i);
+        if (instance->lastLaunch() > 0) {
+            played.append(instance);
+        }
+    }
+    std::sort(played.begin(), played.end(), [](const InstancePtr& a, const InstancePtr& b) { return a->lastLaunch() > b->lastLaunch(); });
+
+    for (auto& instance : played.mid(0, RECENTLY_PLAYED)) {
+        if (!m_failed.contains(instance->id()) && !m_queue.contains(instance->id())) {
+            m_queue.append(instance->id());
+        }
+    }
+    prepareNext();
+}
+
+void LaunchPreparer::prepareNext()
+{
+    // a running game gets the disk and the network, the queue waits for the next time
+    if (m_task || !enabled() || CpuExecutor::gameRunning()) {
+        return;
+    }
+    while (!m_queue.isEmpty()) {
+        auto id = m_queue.takeFirst();
+        auto instance = std::dynamic_pointer_cast<MinecraftInstance>(APPLICATION->instances()->getInstanceById(id));
+        if (!instance || instance->isRunning() || !instance->canLaunch()) {
+            continue;
+        }
+        instance->updateRuntimeContext();
+        if (LaunchPlan::isUpToDate(instance.get())) {
+            continue;
+        }
+
+        qDebug() << "Preparing" << instance->name() << "for its next launch";
+        m_current = instance;
+        m_cancelled = false;
+        m_task = instance->createUpdateTask(Net::Mode::Online);
+        connect(m_task.get(), &Task::finished, this, &LaunchPreparer::preparationFinished);
+        // the launch does its own update, the two would only get in each other's way
+        connect(instance.get(), &BaseInstance::launchTaskChanged, this, [this] {
+            if (m_task && m_task->isRunning()) {
+                qDebug() << "Launching" << m_current->name() << "before it was prepared";
+                m_cancelled = true;
+                m_task->abort();
+            }
+        });
+        m_task->start();
+        return;
+    }
+}
+
+void LaunchPreparer::preparationFinished()
+{
+    if (m_task->wasSuccessful()) {
+        qDebug() << "Prepared" << m_current->name() << "for its next launch";
+        m_failed.remove(m_current->id());
+    } else if (!m_cancelled) {
+        qDebug() << "Couldn't prepare" << m_current->name() << "for its next launch:" << m_task->failReason();
+        m_failed.insert(m_current->id());
+    }
+    disconnect(m_current.get(), nullptr, this, nullptr);
+    m_current.reset();
+    m_task.reset();
+    QTimer::singleShot(0, this, &LaunchPreparer::prepareNext);
+}
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+#include "BaseInstance.h"
+#include "tasks/Task.h"
+
+/** Does the checks a launch would start with, ahead of time and in the background.
+ *
+ *  After the components of an instance change, and every now and then for the instances played last, the instance is
+ *  updated the way a launch would update it. Instances are prepared one at a time and never while a game is running.
+ *  A successful update saves the instance's launch plan, so the next launch only loads the local metadata before
+ *  starting the game.
+ */
+class LaunchPreparer : public QObject {
+    Q_OBJECT
+   public:
+    explicit LaunchPreparer(QObject* parent = nullptr);
+    ~LaunchPreparer() override;
+
+    /* Prepares the instance once it hasn't changed for a little while. */
+    void schedule(const QString& instanceId);
+
+   private:
+    bool enabled() const;
+    void queueRecentlyPlayed();
+    void prepareNext();
+    void preparationFinished();
+
+    QStringList m_queue;
+    // instances whose update failed aren't tried again until they change
+    QSet<QString> m_failed;
+    QTimer m_settleTimer;
+    QTimer m_idleTimer;
+
+    InstancePtr m_current;
+    Task::Ptr m_task;
+    bool m_cancelled = false;
+};
@@ -36,6 +36,34 @@
 #include "LaunchProfile.h"
 #include <Version.h>
 
+LaunchProfile::LaunchProfile(const LaunchProfile& other)
+    : ProblemProvider(other)
+    , m_minecraftVersion(other.m_minecraftVersion)
+    , m_minecraftVersionType(other.m_minecraftVersionType)
+    , m_minecraftAssets(other.m_minecraftAssets)
+    , m_minecraftArguments(other.m_minecraftArguments)
+    , m_addnJvmArguments(other.m_addnJvmArguments)
+    , m_tweakers(other.m_tweakers)
+    , m_mainClass(other.m_mainClass)
+    , m_appletClass(other.m_appletClass)
+    , m_libraries(other.m_libraries)
+    , m_libraryIndex(other.m_libraryIndex)
+    , m_nativeLibraryIndex(other.m_nativeLibraryIndex)
+    , m_modIndex(other.m_modIndex)
+    , m_mavenFiles(other.m_mavenFiles)
+    , m_agents(other.m_agents)
+    , m_mainJar(other.m_mainJar)
+    , m_nativeLibraries(other.m_nativeLibraries)
+    , m_traits(other.m_traits)
+    , m_jarMods(other.m_jarMods)
+    , m_mods(other.m_mods)
+    , m_compatibleJavaMajors(other.m_compatibleJavaMajors)
+    , m_problemSeverity(other.m_problemSeverity)
+{
+    QMutexLocker locker(&other.m_libraryFilesLock);
+    m_libraryFiles = other.m_libraryFiles;
+}
+
 void LaunchProfile::clear()
 {
     m_minecraftVersion.clear();
@@ -47,12 +75,20 @@ void LaunchProfile::clear()
     m_mainClass.clear();
     m_appletClass.clear();
     m_libraries.clear();
+    m_libraryIndex.clear();
     m_mavenFiles.clear();
     m_agents.clear();
     m_traits.clear();
     m_jarMods.clear();
     m_mainJar.reset();
     m_problemSeverity = ProblemSeverity::None;
+    invalidateLibraryFiles();
+}
+
+void LaunchProfile::invalidateLibraryFiles()
+{
+    QMutexLocker locker(&m_libraryFilesLock);
+    m_libraryFiles = {};
 }
 
 static void applyString(const QString& from, QString& to)
@@ -121,41 +157,41 @@ void LaunchProfile::applyTweakers(const QStringList& tweakers)
 
 void LaunchProfile::applyJarMods(const QList<LibraryPtr>& jarMods)
 {
+    invalidateLibraryFiles();
     this->m_jarMods.append(jarMods);
 }
 
-static int findLibraryByName(QList<LibraryPtr>* haystack, const GradleSpecifier& needle)
+// The position of the one library with that name, or -1 if there are none or several
+static int findLibraryByName(const QHash<int, int>& index, const GradleSpecifier& needle)
 {
-    int retval = -1;
-    for (int i = 0; i < haystack->size(); ++i) {
-        if (haystack->at(i)->rawName().matchName(needle)) {
-            // only one is allowed.
-            if (retval != -1)
-                return -1;
-            retval = i;
-        }
-    }
-    return retval;
+    return index.value(needle.nameId(), -1);
+}
+
+static void appendLibrary(QList<LibraryPtr>& list, QHash<int, int>& index, LibraryPtr library)
+{
+    auto id = library->rawName().nameId();
+    // only one is allowed, so names in there more than once aren't looked for anymore
+    index.insert(id, index.contains(id) ? -1 : list.size());
+    list.append(library);
 }
 
 void LaunchProfile::applyMods(const QList<LibraryPtr>& mods)
 {
-    QList<LibraryPtr>* list = &m_mods;
     for (auto& mod : mods) {
         auto modCopy = Library::limitedCopy(mod);
 
         // find the mod by name.
-        const int index = findLibraryByName(list, mod->rawName());
+        const int index = findLibraryByName(m_modIndex, mod->rawName());
         // mod not found? just add it.
         if (index < 0) {
-            list->append(modCopy);
+            appendLibrary(m_mods, m_modIndex, modCopy);
             return;
         }
 
-        auto existingLibrary = list->at(index);
+        auto existingLibrary = m_mods.at(index);
         // if we are higher it means we should update
         if (Version(mod->version()) > Version(existingLibrary->version())) {
-            list->replace(index, modCopy);
+            m_mods.replace(index, modCopy);
         }
     }
 }
@@ -167,22 +203,25 @@ void LaunchProfile::applyCompatibleJavaMajors(QList<int>& javaMajor)
 
 void LaunchProfile::applyLibrary(LibraryPtr library, const RuntimeContext& runtimeContext)
 {
+    invalidateLibraryFiles();
     if (!library->isActive(runtimeContext)) {
         return;
     }
 
     QList<LibraryPtr>* list = &m_libraries;
+    QHash<int, int>* nameIndex = &m_libraryIndex;
     if (library->isNative()) {
         list = &m_nativeLibraries;
+        nameIndex = &m_nativeLibraryIndex;
     }
 
     auto libraryCopy = Library::limitedCopy(library);
 
     // find the library by name.
-    const int index = findLibraryByName(list, library->rawName());
+    const int index = findLibraryByName(*nameIndex, library->rawName());
     // library not found? just add it.
     if (index < 0) {
-        list->append(libraryCopy);
+        appendLibrary(*list, *nameIndex, libraryCopy);
         return;
     }
 
@@ -228,6 +267,7 @@ const LibraryPtr LaunchProfile::getMainJar() const
 
 void LaunchProfile::applyMainJar(LibraryPtr jar)
 {
+    invalidateLibraryFiles();
     if (jar) {
         m_mainJar = jar;
     }
@@ -340,6 +380,17 @@ void LaunchProfile::getLibraryFiles(const RuntimeContext& runtimeContext,
                                     const QString& overridePath,
                                     const QString& tempPath) const
 {
+    // everything the files depend on, besides the profile itself
+    auto key = QStringList{ runtimeContext.javaArchitecture, runtimeContext.javaRealArchitecture, runtimeContext.system, overridePath,
+                            tempPath }
+                   .join('\n');
+    QMutexLocker locker(&m_libraryFilesLock);
+    if (m_libraryFiles.key == key) {
+        jars = m_libraryFiles.jars;
+        nativeJars = m_libraryFiles.nativeJars;
+        return;
+    }
+
     QStringList native32, native64;
     jars.clear();
     nativeJars.clear();
@@ -364,4 +415,6 @@ void LaunchProfile::getLibraryFiles(const RuntimeContext& runtimeContext,
     } else if (runtimeContext.javaArchitecture == "64") {
         nativeJars.append(native64);
     }
+
+    m_libraryFiles = { key, jars, nativeJars };
 }
@@ -35,12 +35,18 @@
 
 #pragma once
 #include <ProblemProvider.h>
+#include <QHash>
+#include <QMutex>
 #include <QString>
 #include "Agent.h"
 #include "Library.h"
 
 class LaunchProfile : public ProblemProvider {
    public:
+    LaunchProfile() = default;
+    /// the copy shares everything with the original until either of them is changed
+    LaunchProfile(const LaunchProfile& other);
+    LaunchProfile& operator=(const LaunchProfile&) = delete;
     virtual ~LaunchProfile() {}
 
    public: /* application of profile variables from patches */
@@ -90,6 +96,9 @@ class LaunchProfile : public ProblemProvider {
     ProblemSeverity getProblemSeverity() const override;
     const QList<PatchProblem> getProblems() const override;
 
+   private:
+    void invalidateLibraryFiles();
+
    private:
     /// the version of Minecraft - jar to use
     QString m_minecraftVersion;
@@ -126,6 +135,11 @@ class LaunchProfile : public ProblemProvider {
     /// the list of libraries
     QList<LibraryPtr> m_libraries;
 
+    /// where the libraries are in their lists, by GradleSpecifier::nameId(). -1 for names that are there more than once.
+    QHash<int, int> m_libraryIndex;
+    QHash<int, int> m_nativeLibraryIndex;
+    QHash<int, int> m_modIndex;
+
     /// the list of maven files to be placed in the libraries folder, but not acted upon
     QList<LibraryPtr> m_mavenFiles;
 
@@ -151,4 +165,13 @@ class LaunchProfile : public ProblemProvider {
     QList<int> m_compatibleJavaMajors;
 
     ProblemSeverity m_problemSeverity = ProblemSeverity::None;
+
+    /// the last result of getLibraryFiles, and what it was for. Builds of the class path ask for the same thing many times over.
+    struct LibraryFiles {
+        QString key;
+        QStringList jars;
+        QStringList nativeJars;
+    };
+    mutable QMutex m_libraryFilesLock;
+    mutable LibraryFiles m_libraryFiles;
 };
@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "LevelDat.h"
+
+#include <zlib.h>
+#include <QBuffer>
+#include <QDebug>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+enum TagType : quint8 {
+    End = 0,
+    Byte = 1,
+    Short = 2,
+    Int = 3,
+    Long = 4,
+    Float = 5,
+    Double = 6,
+    ByteArray = 7,
+    String = 8,
+    List = 9,
+    Compound = 10,
+    IntArray = 11,
+    LongArray = 12,
+};
+
+// same limit as the NBT reader in Minecraft itself
+constexpr int maxDepth = 512;
+
+/// gzip stream from a device, inflated in chunks as it gets consumed
+class InflateStream {
+   public:
+    explicit InflateStream(QIODevice& device) : m_device(device)
+    {
+        memset(&m_strm, 0, sizeof(m_strm));
+        m_ok = inflateInit2(&m_strm, 16 + MAX_WBITS) == Z_OK;
+    }
+    ~InflateStream()
+    {
+        if (m_ok)
+            inflateEnd(&m_strm);
+    }
+
+    bool read(char* out, qint64 len)
+    {
+        while (len > 0) {
+            if (!fill())
+                return false;
+            auto chunk = qMin(len, m_outLen - m_outPos);
+            memcpy(out, m_out + m_outPos, chunk);
+            m_outPos += chunk;
+            out += chunk;
+            len -= chunk;
+        }
+        return true;
+    }
+
+    bool skip(qint64 len)
+    {
+        while (len > 0) {
+            if (!fill())
+                return false;
+            auto chunk = qMin(len, m_outLen - m_outPos);
+            m_outPos += chunk;
+            len -= chunk;
+        }
+        return true;
+    }
+
+   private:
+    bool fill()
+    {
+        if (m_outPos < m_outLen)
+            return true;
+        if (!m_ok || m_ended)
+            return false;
+        m_outPos = m_outLen = 0;
+        while (m_outLen == 0) {
+            if (m_strm.avail_in == 0) {
+                auto got = m_device.read(m_in, sizeof(m_in));
+                if (got <= 0)
+                    return false;
+                m_strm.next_in = reinterpret_cast<Bytef*>(m_in);
+                m_strm.avail_in = static_cast<uInt>(got);
+            }
+            m_strm.next_out = reinterpret_cast<Bytef*>(m_out);
+            m_strm.avail_out = sizeof(m_out);
+            auto err = inflate(&m_strm, Z_NO_FLUSH);
+            m_outLen = sizeof(m_out) - m_strm.avail_out;
+            if (err == Z_STREAM_END) {
+                m_ended = true;
+                break;
+            }
+            if (err != Z_OK) {
+                m_ok = false;
+                return false;
+            }
+        }
+        return m_outLen > 0;
+    }
+
+    QIODevice& m_device;
+    z_stream m_strm;
+    bool m_ok = false;
+    bool m_ended = false;
+    char m_in[16 * 1024];
+    char m_out[16 * 1024];
+    qint64 m_outPos = 0;
+    qint64 m_outLen = 0;
+};
+
+/// big endian NBT primitives on top of the inflated stream
+class NbtStream {
+   public:
+    explicit NbtStream(QIODevice& device) : m_in(device) {}
+
+    bool readType(quint8& type) { return m_in.read(reinterpret_cast<char*>(&type), 1); }
+
+    template <typename T>
+    bool readNumber(T& value)
+    {
+        char buf[sizeof(T)];
+        if (!m_in.read(buf, sizeof(T)))
+            return false;
+        value = qFromBigEndian<T>(buf);
+        return true;
+    }
+
+    bool readName(QByteArray& name)
+    {
+        quint16 len;
+        if (!readNumber(len))
+            return false;
+        name.resize(len);
+        return m_in.read(name.data(), len);
+    }
+
+    bool readString(QString& value)
+    {
+        QByteArray bytes;
+        if (!readName(bytes))
+            return false;
+        value = QString::fromUtf8(bytes);
+        return true;
+    }
+
+    bool skipName()
+    {
+        quint16 len;
+        return readNumber(len) && m_in.skip(len);
+    }
+
+    bool skipPayload(quint8 type, int depth = 0)
+    {
+        if (depth > maxDepth)
+            return false;
+        switch (type) {
+            case Byte:
+                return m_in.skip(1);
+            case Short:
+                return m_in.skip(2);
+            case Int:
+            case Float:
+                return m_in.skip(4);
+            case Long:
+            case Double:
+                return m_in.skip(8);
+            case ByteArray:
+                return skipArray(1);
+            case IntArray:
+                return skipArray(4);
+            case LongArray:
+                return skipArray(8);
+            case String:
+                return skipName();
+            case List: {
+                quint8 elementType;
+                qint32 len;
+                if (!readType(elementType) || !readNumber(len) || len < 0)
+                    return false;
+                // fixed size elements are skipped in one go
+                switch (elementType) {
+                    case End:
+                        return true;
+                    case Byte:
+                        return m_in.skip(len);
+                    case Short:
+                        return m_in.skip(qint64(len) * 2);
+                    case Int:
+                    case Float:
+                        return m_in.skip(qint64(len) * 4);
+                    case Long:
+                    case Double:
+                        return m_in.skip(qint64(len) * 8);
+                    default:
+                        for (qint32 i = 0; i < len; i++) {
+                            if (!skipPayload(elementType, depth + 1))
+                                return false;
+                        }
+                        return true;
+                }
+            }
+            case Compound: {
+                quint8 childType;
+                while (readType(childType)) {
+                    if (childType == End)
+                        return true;
+                    if (!skipName() || !skipPayload(childType, depth + 1))
+                        return false;
+                }
+                return false;
+            }
+            default:
+                return false;
+        }
+    }
+
+   private:
+    bool skipArray(qint64 elementSize)
+    {
+        qint32 len;
+        return readNumber(len) && len >= 0 && m_in.skip(len * elementSize);
+    }
+
+    InflateStream m_in;
+};
+
+enum class Result { Failed, Done, Complete };
+
+Result readWorldGenSettings(NbtStream& in, LevelDat::Summary& summary)
+{
+    quint8 type;
+    QByteArray name;
+    while (in.readType(type)) {
+        if (type == End)
+            return Result::Done;
+        if (!in.readName(name))
+            return Result::Failed;
+        if (type == Long && name == "seed") {
+            qint64 seed;
+            if (!in.readNumber(seed))
+                return Result::Failed;
+            summary.seed = seed;
+            if (summary.isComplete())
+                return Result::Complete;
+        } else if (!in.skipPayload(type, 2)) {
+            return Result::Failed;
+        }
+    }
+    return Result::Failed;
+}
+
+Result readData(NbtStream& in, LevelDat::Summary& summary)
+{
+    quint8 type;
+    QByteArray name;
+    while (in.readType(type)) {
+        if (type == End)
+            return Result::Done;
+        if (!in.readName(name))
+            return Result::Failed;
+
+        bool ok = true;
+        if (type == String && name == "LevelName") {
+            QString levelName;
+            ok = in.readString(levelName);
+            summary.levelName = levelName;
+        } else if (type == Long && name == "LastPlayed") {
+            qint64 lastPlayed;
+            ok = in.readNumber(lastPlayed);
+            summary.lastPlayed = lastPlayed;
+        } else if (type == Int && name == "GameType") {
+            qint32 gameType;
+            ok = in.readNumber(gameType);
+            summary.gameType = gameType;
+        } else if (type == Long && name == "RandomSeed") {
+            qint64 randomSeed;
+            ok = in.readNumber(randomSeed);
+            summary.randomSeed = randomSeed;
+        } else if (type == Compound && name == "WorldGenSettings") {
+            auto result = readWorldGenSettings(in, summary);
+            if (result != Result::Done)
+                return result;
+        } else {
+            ok = in.skipPayload(type, 1);
+        }
+        if (!ok)
+            return Result::Failed;
+        if (summary.isComplete())
+            return Result::Complete;
+    }
+    return Result::Failed;
+}
+
+}  // namespace
+
+namespace LevelDat {
+
+std::optional<Summary> readSummary(QIODevice& device)
+{
+    NbtStream in(device);
+
+    // the root is an unnamed compound
+    quint8 type;
+    QByteArray name;
+    if (!in.readType(type) || type != Compound || !in.readName(name) || !name.isEmpty())
+        return std::nullopt;
+
+    Summary summary;
+    bool foundData = false;
+    while (true) {
+        if (!in.readType(type))
+            return std::nullopt;
+        if (type == End)
+            break;
+        if (!in.readName(name))
+            return std::nullopt;
+        if (type == Compound && name == "Data") {
+            auto result = readData(in, summary);
+            if (result == Result::Failed)
+                return std::nullopt;
+            if (result == Result::Complete)
+                return summary;
+            foundData = true;
+        } else if (!in.skipPayload(type)) {
+            return std::nullopt;
+        }
+    }
+    if (!foundData) {
+        qWarning() << "Unable to read NBT tags from level.dat: there is no Data compound";
+        return std::nullopt;
+    }
+    return summary;
+}
+
+std::optional<Summary> readSummary(const QByteArray& gzipped)
+{
+    QBuffer buffer;
+    buffer.setData(gzipped);
+    if (!buffer.open(QIODevice::ReadOnly))
+        return std::nullopt;
+    return readSummary(buffer);
+}
+
+}  // namespace LevelDat
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include <optional>
+
+namespace LevelDat {
+
+/// The few values the launcher shows for a world
+struct Summary {
+    std::optional<QString> levelName;
+    std::optional<int64_t> lastPlayed;
+    std::optional<int> gameType;
+    /// WorldGenSettings.seed, used since 1.16
+    std::optional<int64_t> seed;
+    /// the old place of the seed
+    std::optional<int64_t> randomSeed;
+
+    bool isComplete() const { return levelName && lastPlayed && gameType && seed; }
+};
+
+/**
+ * Reads the summary from a gzipped level.dat, without building the NBT tree.
+ *
+ * The file is inflated as it is read, subtrees that aren't needed (player data, data packs, dimensions...) are skipped
+ * without being stored, and reading stops as soon as everything was found.
+ * Returns nullopt if the data isn't a level.dat with a Data compound in it.
+ */
+std::optional<Summary> readSummary(QIODevice& device);
+std::optional<Summary> readSummary(const QByteArray& gzipped);
+
+}  // namespace LevelDat
@@ -37,6 +37,8 @@
 #include "MinecraftInstance.h"
 #include "net/NetRequest.h"
 
+#include "Application.h"
+
 #include <BuildConfig.h>
 #include <FileSystem.h>
 #include <net/ApiDownload.h>
@@ -75,20 +77,55 @@ void Library::getApplicableFiles(const RuntimeContext& runtimeContext,
     }
 }
 
+namespace {
+/* The mirrors of the repository 'url' is in, from the LibraryMirrors setting, with the same path below them.
+ * Each line of it is a repository URL followed by its mirrors, separated by spaces. */
+QList<QUrl> mirrorsFor(const QString& url)
+{
+    static QString s_setting;
+    static QList<QPair<QString, QStringList>> s_mirrors;
+    auto setting = APPLICATION->settings()->get("LibraryMirrors").toString();
+    if (setting != s_setting) {
+        s_setting = setting;
+        s_mirrors.clear();
+        for (auto& line : setting.split('\n')) {
+            auto urls = line.split(' ', Qt::SkipEmptyParts);
+            if (urls.size() >= 2)
+                s_mirrors.append({ urls.takeFirst(), urls });
+        }
+    }
+
+    QList<QUrl> out;
+    for (auto& [repository, mirrors] : s_mirrors) {
+        if (!url.startsWith(repository))
+            continue;
+        for (auto& mirror : mirrors)
+            out.append(QUrl(mirror + url.mid(repository.size())));
+    }
+    return out;
+}
+}  // namespace
+
 QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeContext,
                                                   class HttpMetaCache* cache,
                                                   QStringList& failedLocalFiles,
-                                                  const QString& overridePath) const
+                                                  const QString& overridePath,
+                                                  const QHash<QString, QFileInfo>& knownFiles) const
 {
     QList<Net::NetRequest::Ptr> out;
     bool stale = isAlwaysStale();
     bool local = isLocal();
 
+    auto fileInfo = [&knownFiles](const QString& path) {
+        auto known = knownFiles.constFind(path);
+        return known != knownFiles.constEnd() ? *known : QFileInfo(path);
+    };
+
     auto check_local_file = [&](QString storage) {
         QFileInfo fileinfo(storage);
         QString fileName = fileinfo.fileName();
         auto fullPath = FS::PathCombine(overridePath, fileName);
-        QFileInfo localFileInfo(fullPath);
+        QFileInfo localFileInfo = fileInfo(fullPath);
         if (!localFileInfo.exists()) {
             failedLocalFiles.append(localFileInfo.filePath());
             return false;
@@ -100,7 +137,7 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
         if (local) {
             return check_local_file(storage);
         }
-        auto entry = cache->resolveEntry("libraries", storage);
+        auto entry = cache->resolveEntry("libraries", storage, fileInfo(FS::PathCombine(cache->getBasePath("libraries"), storage)));
         if (stale) {
             entry->setStale(true);
         }
@@ -118,15 +155,41 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
             auto rawSha1 = QByteArray::fromHex(sha1.toLatin1());
             auto dl = Net::ApiDownload::makeCached(url, entry, options);
             dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, rawSha1));
+            // what the mirrors send is checked just the same
+            dl->setMirrors(mirrorsFor(url));
+            dl->setPriority(Net::NetRequest::Priority::Bulk);
             qDebug() << "Checksummed Download for:" << rawName().serialize() << "storage:" << storage << "url:" << url;
             out.append(dl);
         } else {
-            out.append(Net::ApiDownload::makeCached(url, entry, options));
+            auto dl = Net::ApiDownload::makeCached(url, entry, options);
+            dl->setPriority(Net::NetRequest::Priority::Bulk);
+            out.append(dl);
             qDebug() << "Download for:" << rawName().serialize() << "storage:" << storage << "url:" << url;
         }
         return true;
     };
 
+    forEachDownload(runtimeContext, [&](const QString& storage, const QString& url, const QString& sha1) { add_download(storage, url, sha1); });
+    return out;
+}
+
+QStringList Library::getDownloadFiles(const RuntimeContext& runtimeContext, class HttpMetaCache* cache, const QString& overridePath) const
+{
+    QStringList out;
+    bool local = isLocal();
+    forEachDownload(runtimeContext, [&](const QString& storage, const QString&, const QString&) {
+        if (local) {
+            out.append(FS::PathCombine(overridePath, QFileInfo(storage).fileName()));
+        } else {
+            out.append(FS::PathCombine(cache->getBasePath("libraries"), storage));
+        }
+    });
+    return out;
+}
+
+void Library::forEachDownload(const RuntimeContext& runtimeContext,
+                              const std::function<void(const QString& storage, const QString& url, const QString& sha1)>& visit) const
+{
     QString raw_storage = storageSuffix(runtimeContext);
     if (m_mojangDownloads) {
         if (isNative()) {
@@ -141,18 +204,18 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
                     if (nat32info) {
                         auto cooked_storage = raw_storage;
                         cooked_storage.replace("${arch}", "32");
-                        add_download(cooked_storage, nat32info->url, nat32info->sha1);
+                        visit(cooked_storage, nat32info->url, nat32info->sha1);
                     }
                     auto nat64info = m_mojangDownloads->getDownloadInfo(nat64Classifier);
                     if (nat64info) {
                         auto cooked_storage = raw_storage;
                         cooked_storage.replace("${arch}", "64");
-                        add_download(cooked_storage, nat64info->url, nat64info->sha1);
+                        visit(cooked_storage, nat64info->url, nat64info->sha1);
                     }
                 } else {
                     auto info = m_mojangDownloads->getDownloadInfo(nativeClassifier);
                     if (info) {
-                        add_download(raw_storage, info->url, info->sha1);
+                        visit(raw_storage, info->url, info->sha1);
                     }
                 }
             } else {
@@ -161,7 +224,7 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
         } else {
             if (m_mojangDownloads->artifact) {
                 auto artifact = m_mojangDownloads->artifact;
-                add_download(raw_storage, artifact->url, artifact->sha1);
+                visit(raw_storage, artifact->url, artifact->sha1);
             } else {
                 qDebug() << "Ignoring java library" << m_name.serialize() << "because it has no artifact";
             }
@@ -185,15 +248,14 @@ QList<Net::NetRequest::Ptr> Library::getDownloads(const RuntimeContext& runtimeC
         if (raw_storage.contains("${arch}")) {
             QString cooked_storage = raw_storage;
             QString cooked_dl = raw_dl;
-            add_download(cooked_storage.replace("${arch}", "32"), cooked_dl.replace("${arch}", "32"), QString());
+            visit(cooked_storage.replace("${arch}", "32"), cooked_dl.replace("${arch}", "32"), QString());
             cooked_storage = raw_storage;
             cooked_dl = raw_dl;
-            add_download(cooked_storage.replace("${arch}", "64"), cooked_dl.replace("${arch}", "64"), QString());
+            visit(cooked_storage.replace("${arch}", "64"), cooked_dl.replace("${arch}", "64"), QString());
         } else {
-            add_download(raw_storage, raw_dl, QString());
+            visit(raw_storage, raw_dl, QString());
         }
     }
-    return out;
 }
 
 bool Library::isActive(const RuntimeContext& runtimeContext) const
@@ -35,12 +35,15 @@
 
 #pragma once
 #include <QDir>
+#include <QFileInfo>
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QPair>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
+#include <functional>
 #include <memory>
 
 #include "GradleSpecifier.h"
@@ -144,13 +147,22 @@ class Library {
     bool isForge() const;
 
     // Get a list of downloads for this library
+    // Files in `knownFiles` (by absolute path) aren't looked at again, so they can be checked elsewhere beforehand
     QList<Net::NetRequest::Ptr> getDownloads(const RuntimeContext& runtimeContext,
                                              class HttpMetaCache* cache,
                                              QStringList& failedLocalFiles,
-                                             const QString& overridePath) const;
+                                             const QString& overridePath,
+                                             const QHash<QString, QFileInfo>& knownFiles = {}) const;
+
+    // Get the files getDownloads() looks at to decide what to download
+    QStringList getDownloadFiles(const RuntimeContext& runtimeContext, class HttpMetaCache* cache, const QString& overridePath) const;
 
     QString getCompatibleNative(const RuntimeContext& runtimeContext) const;
 
+    /// Calls `visit` with the storage path, URL and SHA-1 (if known) of every file of the library to download
+    void forEachDownload(const RuntimeContext& runtimeContext,
+                         const std::function<void(const QString& storage, const QString& url, const QString& sha1)>& visit) const;
+
    private: /* methods */
     /// the default storage prefix used by Prism Launcher
     static QString defaultStoragePrefix();
@@ -47,6 +47,7 @@
 #include "FileSystem.h"
 #include "MMCTime.h"
 #include "java/JavaVersion.h"
+#include "java/JvmTuning.h"
 #include "pathmatcher/MultiMatcher.h"
 #include "pathmatcher/RegexpMatcher.h"
 
@@ -64,6 +65,7 @@
 #include "minecraft/launch/ModMinecraftJar.h"
 #include "minecraft/launch/ReconstructAssets.h"
 #include "minecraft/launch/ScanModFolders.h"
+#include "minecraft/launch/StartJavaEarly.h"
 #include "minecraft/launch/VerifyJavaInstall.h"
 
 #include "java/JavaUtils.h"
@@ -81,15 +83,21 @@
 #include "WorldList.h"
 
 #include "AssetsUtils.h"
+#include "LaunchPlan.h"
+#include "LaunchPreparer.h"
 #include "MinecraftLoadAndCheck.h"
+#include "MinecraftLogLevelClassifier.h"
 #include "MinecraftUpdate.h"
 #include "PackProfile.h"
 #include "minecraft/gameoptions/GameOptions.h"
 #include "minecraft/update/FoldersTask.h"
+#include "modplatform/helpers/HashCache.h"
 
 #include "tools/BaseProfiler.h"
 
 #include <QActionGroup>
+#include <QTimer>
+#include <QCryptographicHash>
 
 #ifdef Q_OS_LINUX
 #include "MangoHud.h"
@@ -121,6 +129,12 @@ MinecraftInstance::MinecraftInstance(SettingsObjectPtr globalSettings, SettingsO
     : BaseInstance(globalSettings, settings, rootDir)
 {
     m_components.reset(new PackProfile(this));
+    // what a launch would check is done ahead of time, so it doesn't have to wait for it
+    connect(m_components.get(), &PackProfile::saved, this, [this] {
+        if (auto preparer = APPLICATION->launchPreparer()) {
+            preparer->schedule(id());
+        }
+    });
 }
 
 void MinecraftInstance::saveNow()
@@ -165,6 +179,7 @@ void MinecraftInstance::loadSpecificSettings()
         m_settings->registerOverride(global_settings->getSetting("MinMemAlloc"), memorySetting);
         m_settings->registerOverride(global_settings->getSetting("MaxMemAlloc"), memorySetting);
         m_settings->registerOverride(global_settings->getSetting("PermGen"), memorySetting);
+        m_settings->registerOverride(global_settings->getSetting("AutoTuneJvm"), memorySetting);
 
         // Native library workarounds
         auto nativeLibraryWorkaroundsOverride = m_settings->registerSetting("OverrideNativeWorkarounds", false);
@@ -184,6 +199,9 @@ void MinecraftInstance::loadSpecificSettings()
         auto miscellaneousOverride = m_settings->registerSetting("OverrideMiscellaneous", false);
         m_settings->registerOverride(global_settings->getSetting("CloseAfterLaunch"), miscellaneousOverride);
         m_settings->registerOverride(global_settings->getSetting("QuitAfterGameStop"), miscellaneousOverride);
+        m_settings->registerOverride(global_settings->getSetting("PrespawnJava"), miscellaneousOverride);
+        m_settings->registerOverride(global_settings->getSetting("UseClassDataSharing"), miscellaneousOverride);
+        m_settings->registerOverride(global_settings->getSetting("UseGameLogChannel"), miscellaneousOverride);
 
         // Legacy-related options
         auto legacySettings = m_settings->registerSetting("OverrideLegacySettings", false);
@@ -208,6 +226,7 @@ void MinecraftInstance::loadSpecificSettings()
     m_settings->registerSetting("ExportSummary", "");
     m_settings->registerSetting("ExportAuthor", "");
     m_settings->registerSetting("ExportOptionalFiles", true);
+    m_settings->registerSetting("ExportLastArchive", "");
 
     qDebug() << "Instance-type specific settings were loaded!";
 
@@ -304,12 +323,77 @@ QString MinecraftInstance::binRoot() const
     return FS::PathCombine(gameRoot(), "bin");
 }
 
-QString MinecraftInstance::getNativePath() const
+QString MinecraftInstance::getNativePath()
 {
-    QDir natives_dir(FS::PathCombine(instanceRoot(), "natives/"));
+    // key the directory by what ends up in it, so launches (of any instance) with the same natives can reuse it
+    QCryptographicHash key(QCryptographicHash::Sha1);
+    auto cache = APPLICATION->hashCache();
+    for (auto& jar : getNativeJars()) {
+        auto identity = Hashing::FileIdentity::of(jar);
+        auto hash = cache ? cache->lookup(jar, identity, "sha1") : QString();
+        if (hash.isEmpty()) {
+            QFile file(jar);
+            QCryptographicHash content(QCryptographicHash::Sha1);
+            if (file.open(QIODevice::ReadOnly) && content.addData(&file)) {
+                hash = QString::fromLatin1(content.result().toHex());
+                if (cache)
+                    cache->insert(jar, identity, "sha1", hash);
+            } else {
+                // can't tell what's in there, so don't share the directory with anything else
+                hash = jar;
+            }
+        }
+        key.addData(hash.toUtf8());
+    }
+    key.addData(needsJnilibHack() ? "jnilib-hack" : "");
+
+    QDir natives_dir(FS::PathCombine("cache", "natives", QString::fromLatin1(key.result().toHex())));
     return natives_dir.absolutePath();
 }
 
+QString MinecraftInstance::classDataArchivePath(const QStringList& classPath)
+{
+    // dynamic archives only exist since Java 13
+    auto javaVersion = getJavaVersion();
+    if (javaVersion.major() < 13)
+        return {};
+
+    // an archive is only good for the exact Java and classpath it was made with, jars included
+    auto javaPath = FS::ResolveExecutable(settings()->get("JavaPath").toString());
+    QCryptographicHash key(QCryptographicHash::Sha1);
+    key.addData(javaPath.toUtf8());
+    key.addData(javaVersion.toString().toUtf8());
+    key.addData(QByteArray::number(QFileInfo(javaPath).lastModified().toMSecsSinceEpoch()));
+    for (auto& entry : classPath) {
+        key.addData(entry.toUtf8());
+        key.addData(QByteArray::number(QFileInfo(entry).lastModified().toMSecsSinceEpoch()));
+    }
+
+    QDir archives(FS::PathCombine("cache", "cds", id()));
+    if (!FS::ensureFolderPathExists(archives.path()))
+        return {};
+
+    auto name = QString::fromLatin1(key.result().toHex()) + ".jsa";
+    for (auto& stale : archives.entryList({ "*.jsa" }, QDir::Files)) {
+        if (stale != name)
+            archives.remove(stale);
+    }
+    return archives.absoluteFilePath(name);
+}
+
+qint64 MinecraftInstance::classDataArchivesSize() const
+{
+    qint64 size = 0;
+    for (auto& archive : QDir(FS::PathCombine("cache", "cds", id())).entryInfoList({ "*.jsa" }, QDir::Files))
+        size += archive.size();
+    return size;
+}
+
+bool MinecraftInstance::needsJnilibHack()
+{
+    return getJavaVersion().major() >= 8;
+}
+
 QString MinecraftInstance::getLocalLibraryPath() const
 {
     QDir libraries_dir(FS::PathCombine(instanceRoot(), "libraries/"));
@@ -502,6 +586,13 @@ QStringList MinecraftInstance::javaArguments()
 
     int min = settings()->get("MinMemAlloc").toInt();
     int max = settings()->get("MaxMemAlloc").toInt();
+    JvmTuning::Profile jvmProfile;
+    bool autoTune = settings()->get("AutoTuneJvm").toBool();
+    if (autoTune) {
+        jvmProfile = this->jvmProfile();
+        min = jvmProfile.minHeapMiB;
+        max = jvmProfile.maxHeapMiB;
+    }
     if (min < max) {
         args << QString("-Xms%1m").arg(min);
         args << QString("-Xmx%1m").arg(max);
@@ -521,6 +612,9 @@ QStringList MinecraftInstance::javaArguments()
 
     args << "-Duser.language=en";
 
+    if (autoTune)
+        args << jvmProfile.flags;
+
     if (javaVersion.isModular() && shouldApplyOnlineFixes())
         // allow reflective access to java.net - required by the skin fix
         args << "--add-opens"
@@ -529,6 +623,18 @@ QStringList MinecraftInstance::javaArguments()
     return args;
 }
 
+JvmTuning::Profile MinecraftInstance::jvmProfile()
+{
+    JvmTuning::Game game;
+    game.javaVersion = getJavaVersion();
+    game.javaVendor = settings()->get("JavaVendor").toString();
+    game.is64bit = settings()->get("JavaArchitecture").toString() != "32";
+    // the mod list may not be loaded yet, and what matters is only how many there are
+    game.mods = QDir(modsRoot()).entryList({ "*.jar", "*.zip" }, QDir::Files).size();
+    game.userArguments = extraArguments();
+    return JvmTuning::choose(JvmTuning::currentMachine(), game);
+}
+
 QString MinecraftInstance::getLauncher()
 {
     // use legacy launcher if the traits are set
@@ -900,6 +1006,12 @@ QStringList MinecraftInstance::verboseDescription(AuthSessionPtr session, Minecr
     out << "";
     out << "Launcher: " + getLauncher();
     out << "";
+
+    if (settings->get("AutoTuneJvm").toBool()) {
+        out << "JVM profile:";
+        out << "  " + jvmProfile().describe();
+        out << "";
+    }
     return out;
 }
 
@@ -926,46 +1038,11 @@ QMap<QString, QString> MinecraftInstance::createCensorFilterFromSession(AuthSess
     return filter;
 }
 
-MessageLevel::Enum MinecraftInstance::guessLevel(const QString& line, MessageLevel::Enum level)
-{
-    QRegularExpression re("\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
-    auto match = re.match(line);
-    if (match.hasMatch()) {
-        // New style logs from log4j
-        QString timestamp = match.captured("timestamp");
-        QString levelStr = match.captured("level");
-        if (levelStr == "INFO")
-            level = MessageLevel::Message;
-        if (levelStr == "WARN")
-            level = MessageLevel::Warning;
-        if (levelStr == "ERROR")
-            level = MessageLevel::Error;
-        if (levelStr == "FATAL")
-            level = MessageLevel::Fatal;
-        if (levelStr == "TRACE" || levelStr == "DEBUG")
-            level = MessageLevel::Debug;
-    } else {
-        // Old style forge logs
-        if (line.contains("[INFO]") || line.contains("[CONFIG]") || line.contains("[FINE]") || line.contains("[FINER]") ||
-            line.contains("[FINEST]"))
-            level = MessageLevel::Message;
-        if (line.contains("[SEVERE]") || line.contains("[STDERR]"))
-            level = MessageLevel::Error;
-        if (line.contains("[WARNING]"))
-            level = MessageLevel::Warning;
-        if (line.contains("[DEBUG]"))
-            level = MessageLevel::Debug;
-    }
-    if (line.contains("overwriting existing"))
-        return MessageLevel::Fatal;
-    // NOTE: this diverges from the real regexp. no unicode, the first section is + instead of *
-    static const QString javaSymbol = "([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$][a-zA-Z\\d_$]*";
-    if (line.contains("Exception in thread") || line.contains(QRegularExpression("\\s+at " + javaSymbol)) ||
-        line.contains(QRegularExpression("Caused by: " + javaSymbol)) ||
-        line.contains(QRegularExpression("([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$]?[a-zA-Z\\d_$]*(Exception|Error|Throwable)")) ||
-        line.contains(QRegularExpression("... \\d+ more$")))
-        return MessageLevel::Error;
-    return level;
+LogLevelClassifier::Ptr MinecraftInstance::getLogLevelClassifier()
+{
+    // stateless, so all the instances can share it
+    static auto classifier = std::make_shared<MinecraftLogLevelClassifier>();
+    return classifier;
 }
 
 IPathMatcher::Ptr MinecraftInstance::getLogFileMatcher()
@@ -1083,11 +1160,24 @@ shared_qobject_ptr<LaunchTask> MinecraftInstance::createLaunchTask(AuthSessionPt
         if (!session->demo) {
             process->appendStep(makeShared<ClaimAccount>(pptr, session));
         }
-        process->appendStep(makeShared<Update>(pptr, Net::Mode::Online));
+        // nothing changed since the last successful update, so there is nothing to fetch, only the local metadata to load
+        m_components->saveNow();
+        if (LaunchPlan::isUpToDate(this)) {
+            process->appendStep(makeShared<Update>(pptr, Net::Mode::Offline));
+        } else {
+            process->appendStep(makeShared<Update>(pptr, Net::Mode::Online));
+        }
     } else {
         process->appendStep(makeShared<Update>(pptr, Net::Mode::Offline));
     }
 
+    auto launchStep = makeShared<LauncherPartLaunch>(pptr);
+
+    // everything Java needs is known once the components are resolved, so it can start up while the rest is done
+    if (settings()->get("PrespawnJava").toBool()) {
+        process->appendStep(makeShared<StartJavaEarly>(pptr, launchStep));
+    }
+
     // if there are any jar mods
     {
         process->appendStep(makeShared<ModMinecraftJar>(pptr));
@@ -1120,11 +1210,10 @@ shared_qobject_ptr<LaunchTask> MinecraftInstance::createLaunchTask(AuthSessionPt
 
     {
         // actually launch the game
-        auto step = makeShared<LauncherPartLaunch>(pptr);
-        step->setWorkingDirectory(gameRoot());
-        step->setAuthSession(session);
-        step->setServerToJoin(serverToJoin);
-        process->appendStep(step);
+        launchStep->setWorkingDirectory(gameRoot());
+        launchStep->setAuthSession(session);
+        launchStep->setServerToJoin(serverToJoin);
+        process->appendStep(launchStep);
     }
 
     // run post-exit command if that's needed
@@ -1154,6 +1243,7 @@ std::shared_ptr<ModFolderModel> MinecraftInstance::loaderModList()
     if (!m_loader_mod_list) {
         bool is_indexed = !APPLICATION->settings()->get("ModMetadataDisabled").toBool();
         m_loader_mod_list.reset(new ModFolderModel(modsRoot(), this, is_indexed));
+        watchIdleModels();
     }
     return m_loader_mod_list;
 }
@@ -1163,6 +1253,7 @@ std::shared_ptr<ModFolderModel> MinecraftInstance::coreModList()
     if (!m_core_mod_list) {
         bool is_indexed = !APPLICATION->settings()->get("ModMetadataDisabled").toBool();
         m_core_mod_list.reset(new ModFolderModel(coreModsDir(), this, is_indexed));
+        watchIdleModels();
     }
     return m_core_mod_list;
 }
@@ -1172,6 +1263,7 @@ std::shared_ptr<ModFolderModel> MinecraftInstance::nilModList()
     if (!m_nil_mod_list) {
         bool is_indexed = !APPLICATION->settings()->get("ModMetadataDisabled").toBool();
         m_nil_mod_list.reset(new ModFolderModel(nilModsDir(), this, is_indexed, false));
+        watchIdleModels();
     }
     return m_nil_mod_list;
 }
@@ -1180,6 +1272,7 @@ std::shared_ptr<ResourcePackFolderModel> MinecraftInstance::resourcePackList()
 {
     if (!m_resource_pack_list) {
         m_resource_pack_list.reset(new ResourcePackFolderModel(resourcePacksDir(), this));
+        watchIdleModels();
     }
     return m_resource_pack_list;
 }
@@ -1188,6 +1281,7 @@ std::shared_ptr<TexturePackFolderModel> MinecraftInstance::texturePackList()
 {
     if (!m_texture_pack_list) {
         m_texture_pack_list.reset(new TexturePackFolderModel(texturePacksDir(), this));
+        watchIdleModels();
     }
     return m_texture_pack_list;
 }
@@ -1196,6 +1290,7 @@ std::shared_ptr<ShaderPackFolderModel> MinecraftInstance::shaderPackList()
 {
     if (!m_shader_pack_list) {
         m_shader_pack_list.reset(new ShaderPackFolderModel(shaderPacksDir(), this));
+        watchIdleModels();
     }
     return m_shader_pack_list;
 }
@@ -1204,10 +1299,72 @@ std::shared_ptr<WorldList> MinecraftInstance::worldList()
 {
     if (!m_world_list) {
         m_world_list.reset(new WorldList(worldDir(), this));
+        watchIdleModels();
     }
     return m_world_list;
 }
 
+namespace {
+
+// how often the folder models are looked at, they go once nobody used them for one to two of these
+constexpr int MODEL_RELEASE_INTERVAL_MS = 3 * 60 * 1000;
+
+bool isBusy(const ResourceFolderModel& model)
+{
+    return model.isUpdating() || model.hasPendingParseTasks();
+}
+
+bool isBusy(const WorldList& model)
+{
+    return model.isUpdating();
+}
+
+// returns whether the model is still around
+template <typename Model>
+bool releaseIfIdle(std::shared_ptr<Model>& model, const QSet<const void*>& wasIdle, QSet<const void*>& isIdle)
+{
+    if (!model)
+        return false;
+    if (model.use_count() > 1 || isBusy(*model))
+        return true;
+    if (wasIdle.contains(model.get())) {
+        model.reset();
+        return false;
+    }
+    isIdle.insert(model.get());
+    return true;
+}
+
+}  // namespace
+
+void MinecraftInstance::watchIdleModels()
+{
+    if (!m_model_release_timer) {
+        m_model_release_timer = new QTimer(this);
+        m_model_release_timer->setInterval(MODEL_RELEASE_INTERVAL_MS);
+        connect(m_model_release_timer, &QTimer::timeout, this, &MinecraftInstance::releaseIdleModels);
+    }
+    if (!m_model_release_timer->isActive())
+        m_model_release_timer->start();
+}
+
+void MinecraftInstance::releaseIdleModels()
+{
+    // what they parsed is in their details caches on disk, so they are quick to bring back
+    QSet<const void*> idle;
+    bool any = false;
+    any |= releaseIfIdle(m_loader_mod_list, m_idle_models, idle);
+    any |= releaseIfIdle(m_core_mod_list, m_idle_models, idle);
+    any |= releaseIfIdle(m_nil_mod_list, m_idle_models, idle);
+    any |= releaseIfIdle(m_resource_pack_list, m_idle_models, idle);
+    any |= releaseIfIdle(m_texture_pack_list, m_idle_models, idle);
+    any |= releaseIfIdle(m_shader_pack_list, m_idle_models, idle);
+    any |= releaseIfIdle(m_world_list, m_idle_models, idle);
+    m_idle_models = idle;
+    if (!any)
+        m_model_release_timer->stop();
+}
+
 std::shared_ptr<GameOptions> MinecraftInstance::gameOptionsModel()
 {
     if (!m_game_options) {
@@ -36,12 +36,16 @@
 
 #pragma once
 #include <java/JavaVersion.h>
+#include <java/JvmTuning.h>
 #include <QDir>
 #include <QProcess>
+#include <QSet>
 #include "BaseInstance.h"
 #include "minecraft/launch/MinecraftServerTarget.h"
 #include "minecraft/mod/Mod.h"
 
+class QTimer;
+
 class ModFolderModel;
 class ResourceFolderModel;
 class ResourcePackFolderModel;
@@ -95,8 +99,18 @@ class MinecraftInstance : public BaseInstance {
     // Path to the instance's minecraft bin directory.
     QString binRoot() const;
 
-    // where to put the natives during/before launch
-    QString getNativePath() const;
+    // where the natives are extracted to, shared by all the instances with the same native jars
+    QString getNativePath();
+
+    // where the class data (AppCDS) archive for this classpath and the instance's Java goes, empty if the Java can't make one.
+    // archives made for another classpath or Java are removed
+    QString classDataArchivePath(const QStringList& classPath);
+
+    // how much space the instance's class data archives take up
+    qint64 classDataArchivesSize() const;
+
+    // whether .jnilib natives have to be renamed to .dylib for the instance's Java
+    bool needsJnilibHack();
 
     // where the instance-local libraries should be
     QString getLocalLibraryPath() const;
@@ -128,6 +142,8 @@ class MinecraftInstance : public BaseInstance {
     QString createLaunchScript(AuthSessionPtr session, MinecraftServerTargetPtr serverToJoin);
     /// get arguments passed to java
     QStringList javaArguments();
+    /// the heap size and collector flags picked for this instance, used instead of the memory settings when AutoTuneJvm is set
+    JvmTuning::Profile jvmProfile();
     QString getLauncher();
     bool shouldApplyOnlineFixes();
 
@@ -139,7 +155,7 @@ class MinecraftInstance : public BaseInstance {
     QProcessEnvironment createLaunchEnvironment() override;
 
     /// guess log level from a line of minecraft log
-    MessageLevel::Enum guessLevel(const QString& line, MessageLevel::Enum level) override;
+    LogLevelClassifier::Ptr getLogLevelClassifier() override;
 
     IPathMatcher::Ptr getLogFileMatcher() override;
 
@@ -162,6 +178,12 @@ class MinecraftInstance : public BaseInstance {
    protected:
     QMap<QString, QString> createCensorFilterFromSession(AuthSessionPtr session);
 
+   private:
+    /* The folder models only the instance still holds on to are dropped once they were left alone for a while,
+     * instead of keeping what they parsed around for as long as the launcher runs. */
+    void watchIdleModels();
+    void releaseIdleModels();
+
    protected:  // data
     std::shared_ptr<PackProfile> m_components;
     mutable std::shared_ptr<ModFolderModel> m_loader_mod_list;
@@ -172,6 +194,11 @@ class MinecraftInstance : public BaseInstance {
     mutable std::shared_ptr<TexturePackFolderModel> m_texture_pack_list;
     mutable std::shared_ptr<WorldList> m_world_list;
     mutable std::shared_ptr<GameOptions> m_game_options;
+
+   private:
+    QTimer* m_model_release_timer = nullptr;
+    // the models that were already idle the last time they were looked at
+    QSet<const void*> m_idle_models;
 };
 
 using MinecraftInstancePtr = std::shared_ptr<MinecraftInstance>;
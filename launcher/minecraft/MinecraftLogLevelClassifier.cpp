@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MinecraftLogLevelClassifier.h"
+
+#include <QLatin1String>
+
+#include <algorithm>
+
+namespace {
+
+// NOTE: like the regular expressions this replaces, only ASCII is considered
+bool isDigit(QChar c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isSpace(QChar c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+bool isSymbolStart(QChar c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$';
+}
+
+bool isSymbolChar(QChar c)
+{
+    return isSymbolStart(c) || isDigit(c);
+}
+
+bool matchesAt(const QString& line, qsizetype pos, QLatin1String literal)
+{
+    if (pos < 0 || pos + literal.size() > line.size())
+        return false;
+    for (qsizetype i = 0; i < literal.size(); i++) {
+        if (line[pos + i] != QLatin1Char(literal[i]))
+            return false;
+    }
+    return true;
+}
+
+/// `[hh:mm:ss] [thread/LEVEL]` anywhere in the line, puts the LEVEL bounds into `begin` and `end`
+bool findLog4jLevel(const QString& line, qsizetype& begin, qsizetype& end)
+{
+    const qsizetype size = line.size();
+    for (qsizetype start = line.indexOf('['); start != -1; start = line.indexOf('[', start + 1)) {
+        qsizetype i = start + 1;
+        while (i < size && (isDigit(line[i]) || line[i] == ':'))
+            i++;
+        if (i == start + 1 || !matchesAt(line, i, QLatin1String("] [")))
+            continue;
+        i += 3;
+
+        // the thread name goes up to the first slash
+        qsizetype slash = line.indexOf('/', i);
+        if (slash == -1)
+            return false;
+        if (slash == i)
+            continue;
+
+        qsizetype close = line.indexOf(']', slash + 1);
+        if (close == -1)
+            return false;
+        if (close == slash + 1)
+            continue;
+
+        begin = slash + 1;
+        end = close;
+        return true;
+    }
+    return false;
+}
+
+MessageLevel::Enum log4jLevel(const QString& line, qsizetype begin, qsizetype end, MessageLevel::Enum level)
+{
+    auto is = [&](QLatin1String name) { return end - begin == name.size() && matchesAt(line, begin, name); };
+
+    if (is(QLatin1String("INFO")))
+        return MessageLevel::Message;
+    if (is(QLatin1String("WARN")))
+        return MessageLevel::Warning;
+    if (is(QLatin1String("ERROR")))
+        return MessageLevel::Error;
+    if (is(QLatin1String("FATAL")))
+        return MessageLevel::Fatal;
+    if (is(QLatin1String("TRACE")) || is(QLatin1String("DEBUG")))
+        return MessageLevel::Debug;
+    return level;
+}
+
+/// old Forge logs have `[LEVEL]` tags somewhere in the line, the most specific one wins
+MessageLevel::Enum legacyForgeLevel(const QString& line, MessageLevel::Enum level)
+{
+    // the longest tag is WARNING
+    constexpr qsizetype maxTagSize = 7;
+
+    int rank = 0;
+    for (qsizetype start = line.indexOf('['); start != -1; start = line.indexOf('[', start + 1)) {
+        qsizetype close = line.indexOf(']', start + 1);
+        if (close == -1)
+            break;
+        qsizetype tagSize = close - start - 1;
+        if (tagSize < 4 || tagSize > maxTagSize)
+            continue;
+
+        auto is = [&](QLatin1String name) { return tagSize == name.size() && matchesAt(line, start + 1, name); };
+        if (is(QLatin1String("DEBUG"))) {
+            // nothing beats this one
+            return MessageLevel::Debug;
+        } else if (is(QLatin1String("WARNING"))) {
+            rank = std::max(rank, 3);
+        } else if (is(QLatin1String("SEVERE")) || is(QLatin1String("STDERR"))) {
+            rank = std::max(rank, 2);
+        } else if (is(QLatin1String("INFO")) || is(QLatin1String("CONFIG")) || is(QLatin1String("FINE")) ||
+                   is(QLatin1String("FINER")) || is(QLatin1String("FINEST"))) {
+            rank = std::max(rank, 1);
+        }
+    }
+
+    switch (rank) {
+        case 3:
+            return MessageLevel::Warning;
+        case 2:
+            return MessageLevel::Error;
+        case 1:
+            return MessageLevel::Message;
+        default:
+            return level;
+    }
+}
+
+/// a qualified java name, like `java.lang.Object`, at `pos`
+bool isJavaSymbolAt(const QString& line, qsizetype pos)
+{
+    const qsizetype size = line.size();
+    if (pos >= size || !isSymbolStart(line[pos]))
+        return false;
+    pos++;
+    while (pos < size && isSymbolChar(line[pos]))
+        pos++;
+    return pos + 1 < size && line[pos] == '.' && isSymbolStart(line[pos + 1]);
+}
+
+/// `<whitespace>at java.symbol` or `Caused by: java.symbol`
+bool hasStackFrame(const QString& line)
+{
+    QLatin1String at("at ");
+    for (qsizetype pos = line.indexOf(at); pos != -1; pos = line.indexOf(at, pos + 1)) {
+        if (pos > 0 && isSpace(line[pos - 1]) && isJavaSymbolAt(line, pos + at.size()))
+            return true;
+    }
+
+    QLatin1String causedBy("Caused by: ");
+    for (qsizetype pos = line.indexOf(causedBy); pos != -1; pos = line.indexOf(causedBy, pos + 1)) {
+        if (isJavaSymbolAt(line, pos + causedBy.size()))
+            return true;
+    }
+    return false;
+}
+
+/// a qualified name ending in Exception, Error or Throwable, like `java.lang.NullPointerException`
+bool hasThrowableName(const QString& line)
+{
+    for (auto suffix : { QLatin1String("Exception"), QLatin1String("Error"), QLatin1String("Throwable") }) {
+        for (qsizetype pos = line.indexOf(suffix); pos != -1; pos = line.indexOf(suffix, pos + 1)) {
+            // the rest of the simple name
+            qsizetype i = pos;
+            while (i > 0 && isSymbolChar(line[i - 1]))
+                i--;
+            if (i < 2 || line[i - 1] != '.')
+                continue;
+            // and the package (or outer class) it is in
+            for (i -= 2; i >= 0 && isSymbolChar(line[i]); i--) {
+                if (isSymbolStart(line[i]))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+/// the `... 42 more` at the end of a stack trace
+bool hasMoreFrames(const QString& line)
+{
+    qsizetype end = line.size();
+    if (end > 0 && line[end - 1] == '\n')
+        end--;
+
+    QLatin1String more(" more");
+    if (!matchesAt(line, end - more.size(), more))
+        return false;
+
+    qsizetype digits = end - more.size();
+    qsizetype i = digits;
+    while (i > 0 && isDigit(line[i - 1]))
+        i--;
+    if (i == digits || i < 4 || line[i - 1] != ' ')
+        return false;
+    for (qsizetype j = i - 4; j < i - 1; j++) {
+        if (line[j] == '\n')
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+MessageLevel::Enum MinecraftLogLevelClassifier::classify(const QString& line, MessageLevel::Enum level) const
+{
+    qsizetype begin, end;
+    if (findLog4jLevel(line, begin, end)) {
+        // New style logs from log4j
+        level = log4jLevel(line, begin, end, level);
+    } else {
+        // Old style forge logs
+        level = legacyForgeLevel(line, level);
+    }
+
+    if (line.contains(QLatin1String("overwriting existing")))
+        return MessageLevel::Fatal;
+    if (line.contains(QLatin1String("Exception in thread")) || hasStackFrame(line) || hasThrowableName(line) || hasMoreFrames(line))
+        return MessageLevel::Error;
+    return level;
+}
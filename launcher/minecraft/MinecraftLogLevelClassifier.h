@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "launch/LogLevelClassifier.h"
+
+/**
+ * Classifies lines of Minecraft logs, both the log4j ones (`[12:34:56] [main/INFO]: ...`)
+ * and the ones of old Forge versions (`2013-01-01 12:34:56 [INFO] ...`).
+ * Java stack traces are reported as errors.
+ *
+ * This runs on every line the game prints, so it scans the line by hand instead of using regular expressions.
+ */
+class MinecraftLogLevelClassifier : public LogLevelClassifier {
+   public:
+    MessageLevel::Enum classify(const QString& line, MessageLevel::Enum level) const override;
+};
@@ -22,36 +22,22 @@
 #include <quazip/quazip.h>
 #include "minecraft/VersionFilterData.h"
 #include "net/NetJob.h"
-#include "tasks/Task.h"
+#include "tasks/DependencyTask.h"
 
 class MinecraftVersion;
 class MinecraftInstance;
 
-// FIXME: This looks very similar to a SequentialTask. Maybe we can reduce code duplications? :^)
-
-class MinecraftUpdate : public Task {
+class MinecraftUpdate : public DependencyTask {
     Q_OBJECT
    public:
     explicit MinecraftUpdate(MinecraftInstance* inst, QObject* parent = 0);
     virtual ~MinecraftUpdate(){};
 
     void executeTask() override;
-    bool canAbort() const override;
-
-   private slots:
-    bool abort() override;
-    void subtaskSucceeded();
-    void subtaskFailed(QString error);
 
-   private:
-    void next();
+   protected slots:
+    void emitSucceeded() override;
 
    private:
     MinecraftInstance* m_inst = nullptr;
-    QList<Task::Ptr> m_tasks;
-    QString m_preFailure;
-    int m_currentTask = -1;
-    bool m_abort = false;
-    bool m_failed_out_of_order = false;
-    QString m_fail_reason;
 };
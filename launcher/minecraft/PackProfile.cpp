@@ -58,6 +58,7 @@
 #include "ComponentUpdateTask.h"
 #include "PackProfile.h"
 #include "PackProfile_p.h"
+#include "meta/Version.h"
 #include "minecraft/mod/Mod.h"
 #include "modplatform/ModIndex.h"
 
@@ -244,6 +245,8 @@ void PackProfile::scheduleSave()
         qDebug() << "Component list should never save if it didn't successfully load, instance:" << d->m_instance->name();
         return;
     }
+    // the components no longer match what was resolved
+    d->resolvedFrom.clear();
     if (!d->dirty) {
         d->dirty = true;
         qDebug() << "Component list save is scheduled for" << d->m_instance->name();
@@ -277,6 +280,42 @@ void PackProfile::save_internal()
     auto filename = componentsFilePath();
     savePackProfile(filename, d->components);
     d->dirty = false;
+    // the file was written from the components in memory, so it doesn't make the resolution outdated
+    if (!d->resolvedFrom.isEmpty()) {
+        d->resolvedFrom.insert(filename, Hashing::FileIdentity::of(filename));
+    }
+    emit saved();
+}
+
+QMap<QString, Hashing::FileIdentity> PackProfile::resolutionInputs() const
+{
+    QMap<QString, Hashing::FileIdentity> inputs;
+    auto addInput = [&inputs](const QString& path) { inputs.insert(path, Hashing::FileIdentity::of(path)); };
+    addInput(componentsFilePath());
+    for (auto component : d->components) {
+        // tracked even when it doesn't exist, a custom patch showing up replaces the metadata
+        addInput(patchFilePathForUid(component->getID()));
+        if (component->m_metaVersion) {
+            addInput(QDir("meta").absoluteFilePath(component->m_metaVersion->localFilename()));
+        }
+    }
+    return inputs;
+}
+
+bool PackProfile::isResolutionCurrent(Net::Mode netmode) const
+{
+    if (!d->loaded || d->resolvedFrom.isEmpty()) {
+        return false;
+    }
+    if (netmode == Net::Mode::Online) {
+        // an online reload is there to refresh the metadata, unless that already happened in this session
+        for (auto component : d->components) {
+            if (component->m_metaVersion && !component->m_metaVersion->wasUpdated()) {
+                return false;
+            }
+        }
+    }
+    return resolutionInputs() == d->resolvedFrom;
 }
 
 bool PackProfile::load()
@@ -322,6 +361,12 @@ void PackProfile::reload(Net::Mode netmode)
     // flush any scheduled saves to not lose state
     saveNow();
 
+    // nothing the resolution depends on changed, keep the components and the launch profile made from them
+    if (isResolutionCurrent(netmode)) {
+        qDebug() << "Component list of" << d->m_instance->name() << "is unchanged since it was resolved, not reloading";
+        return;
+    }
+
     // FIXME: differentiate when a reapply is required by propagating state from components
     invalidateLaunchProfile();
 
@@ -350,12 +395,14 @@ void PackProfile::updateSucceeded()
     qDebug() << "Component list update/resolve task succeeded for" << d->m_instance->name();
     d->m_updateTask.reset();
     invalidateLaunchProfile();
+    d->resolvedFrom = resolutionInputs();
 }
 
 void PackProfile::updateFailed(const QString& error)
 {
     qDebug() << "Component list update/resolve task failed for" << d->m_instance->name() << "Reason:" << error;
     d->m_updateTask.reset();
+    d->resolvedFrom.clear();
     invalidateLaunchProfile();
 }
 
@@ -933,13 +980,41 @@ bool PackProfile::installAgents_internal(QStringList filepaths)
 std::shared_ptr<LaunchProfile> PackProfile::getProfile() const
 {
     if (!d->m_profile) {
+        auto& partials = d->m_partialProfiles;
+
+        // what decides which libraries are used
+        auto context = d->m_instance->runtimeContext();
+        auto contextKey = QStringList{ context.javaArchitecture, context.javaRealArchitecture, context.system }.join('\n');
+        if (contextKey != d->m_partialProfilesContext) {
+            partials.clear();
+            d->m_partialProfilesContext = contextKey;
+        }
+
+        // keep what was built from the components that are still the same, in the same place
+        int kept = 0;
+        for (; kept < partials.size() && kept < d->components.size(); kept++) {
+            auto& partial = partials[kept];
+            auto component = d->components[kept];
+            if (partial.component.lock() != component || partial.file != component->getVersionFile() ||
+                partial.enabled != component->isEnabled() || partial.severity != component->getProblemSeverity()) {
+                break;
+            }
+        }
+        while (partials.size() > kept) {
+            partials.removeLast();
+        }
+
         try {
-            auto profile = std::make_shared<LaunchProfile>();
-            for (auto file : d->components) {
-                qDebug() << "Applying" << file->getID() << (file->getProblemSeverity() == ProblemSeverity::Error ? "ERROR" : "GOOD");
-                file->applyTo(profile.get());
+            for (int i = kept; i < d->components.size(); i++) {
+                auto component = d->components[i];
+                auto severity = component->getProblemSeverity();
+                qDebug() << "Applying" << component->getID() << (severity == ProblemSeverity::Error ? "ERROR" : "GOOD");
+                auto profile = partials.isEmpty() ? std::make_shared<LaunchProfile>()
+                                                  : std::make_shared<LaunchProfile>(*partials.last().profile);
+                component->applyTo(profile.get());
+                partials.append({ component, component->getVersionFile(), component->isEnabled(), severity, profile });
             }
-            d->m_profile = profile;
+            d->m_profile = partials.isEmpty() ? std::make_shared<LaunchProfile>() : partials.last().profile;
         } catch (const Exception& error) {
             qWarning() << "Couldn't apply profile patches because: " << error.cause();
         }
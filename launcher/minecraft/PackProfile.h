@@ -49,6 +49,7 @@
 #include "Component.h"
 #include "LaunchProfile.h"
 #include "modplatform/ModIndex.h"
+#include "modplatform/helpers/HashCache.h"
 #include "net/Mode.h"
 
 class MinecraftInstance;
@@ -131,6 +132,8 @@ class PackProfile : public QAbstractListModel {
 
    signals:
     void minecraftChanged();
+    /// the component list was written to disk, after it changed
+    void saved();
 
    public:
     /// get the profile component by id
@@ -160,6 +163,11 @@ class PackProfile : public QAbstractListModel {
     QString componentsFilePath() const;
     QString patchesPattern() const;
 
+    /// identities of the files that the current components were resolved from
+    QMap<QString, Hashing::FileIdentity> resolutionInputs() const;
+    /// whether reloading would resolve the components to the same thing again
+    bool isResolutionCurrent(Net::Mode netmode) const;
+
    private slots:
     void save_internal();
     void updateSucceeded();
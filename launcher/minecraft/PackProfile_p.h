@@ -5,11 +5,21 @@
 #include <QTimer>
 #include <map>
 #include "Component.h"
+#include "modplatform/helpers/HashCache.h"
 
 class MinecraftInstance;
 using ComponentContainer = QList<ComponentPtr>;
 using ComponentIndex = QMap<QString, ComponentPtr>;
 
+// the launch profile as it was after applying a component, and what went into it
+struct PartialLaunchProfile {
+    std::weak_ptr<Component> component;
+    std::shared_ptr<VersionFile> file;
+    bool enabled = false;
+    ProblemSeverity severity = ProblemSeverity::None;
+    std::shared_ptr<LaunchProfile> profile;
+};
+
 struct PackProfileData {
     // the instance this belongs to
     MinecraftInstance* m_instance;
@@ -17,6 +27,14 @@ struct PackProfileData {
     // the launch profile (volatile, temporary thing created on demand)
     std::shared_ptr<LaunchProfile> m_profile;
 
+    // the profile after each component, so rebuilding it starts after the last one that's still the same. They share
+    // their lists with each other, only what a component adds is copied.
+    QList<PartialLaunchProfile> m_partialProfiles;
+    QString m_partialProfilesContext;
+
+    // identities of the files the components were last resolved from, empty when they have to be resolved again
+    QMap<QString, Hashing::FileIdentity> resolvedFrom;
+
     // persistent list of components and related machinery
     ComponentContainer components;
     ComponentIndex componentIndex;
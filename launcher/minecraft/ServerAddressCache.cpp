@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ServerAddressCache.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDnsLookup>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+#include "FileSystem.h"
+#include "Json.h"
+
+namespace ServerAddressCache {
+
+namespace {
+
+struct Entry {
+    Target target;
+    qint64 expires = 0;
+    qint64 ttl = 0;
+};
+
+struct Cache {
+    QMutex mutex;
+    QHash<QString, Entry> entries;
+    QSet<QString> refreshing;
+    QString path;
+};
+
+Cache& cache()
+{
+    static Cache s_cache;
+    return s_cache;
+}
+
+// NOTE: the cache's mutex must be held
+QByteArray serialize(const Cache& c)
+{
+    QJsonObject entries;
+    for (auto it = c.entries.cbegin(); it != c.entries.cend(); ++it) {
+        entries.insert(it.key(), QJsonObject{ { "host", it->target.host },
+                                              { "port", it->target.port },
+                                              { "expires", double(it->expires) },
+                                              { "ttl", double(it->ttl) } });
+    }
+    return QJsonDocument(QJsonObject{ { "formatVersion", 1 }, { "entries", entries } }).toJson(QJsonDocument::Compact);
+}
+
+void save(const QString& path, const QByteArray& data)
+{
+    if (path.isEmpty())
+        return;
+    try {
+        FS::write(path, data);
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Couldn't save the server address cache:" << e.cause();
+    }
+}
+
+void refresh(const QString& host)
+{
+    auto lookup = new QDnsLookup(QDnsLookup::SRV, QString("_minecraft._tcp.%1").arg(host));
+    QObject::connect(lookup, &QDnsLookup::finished, lookup, [lookup, host] {
+        auto records = lookup->serviceRecords();
+        if (lookup->error() == QDnsLookup::NoError && !records.isEmpty()) {
+            store(host, { records.first().target(), records.first().port() }, records.first().timeToLive());
+        } else if (lookup->error() == QDnsLookup::NoError || lookup->error() == QDnsLookup::NotFoundError) {
+            store(host, { host, 25565 }, NO_RECORD_TTL_SECONDS);
+        }
+        // anything else may well go away, keep what's there until it expires
+
+        auto& c = cache();
+        QMutexLocker locker(&c.mutex);
+        c.refreshing.remove(host);
+        lookup->deleteLater();
+    });
+    lookup->lookup();
+}
+
+}  // namespace
+
+std::optional<Target> lookup(const QString& host)
+{
+    auto key = host.toLower();
+    auto now = QDateTime::currentMSecsSinceEpoch();
+
+    auto& c = cache();
+    QMutexLocker locker(&c.mutex);
+    auto it = c.entries.constFind(key);
+    if (it == c.entries.cend() || it->expires <= now)
+        return std::nullopt;
+
+    // keep hosts in use fresh, instead of making someone wait once they expire
+    if (it->expires - now < it->ttl / 4 && !c.refreshing.contains(key) && QCoreApplication::instance()) {
+        c.refreshing.insert(key);
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [key] { refresh(key); }, Qt::QueuedConnection);
+    }
+    return it->target;
+}
+
+void store(const QString& host, const Target& target, int ttl_seconds)
+{
+    qint64 ttl = qint64(qBound(60, ttl_seconds, 24 * 60 * 60)) * 1000;
+
+    QString path;
+    QByteArray data;
+    {
+        auto& c = cache();
+        QMutexLocker locker(&c.mutex);
+        c.entries.insert(host.toLower(), { target, QDateTime::currentMSecsSinceEpoch() + ttl, ttl });
+        path = c.path;
+        if (!path.isEmpty())
+            data = serialize(c);
+    }
+    save(path, data);
+}
+
+void setPersistPath(const QString& path)
+{
+    auto& c = cache();
+    QMutexLocker locker(&c.mutex);
+    c.path = path;
+    if (!QFileInfo::exists(path))
+        return;
+
+    try {
+        auto obj = Json::requireObject(Json::requireDocument(FS::read(path), "Server address cache"));
+        if (Json::requireInteger(obj, "formatVersion") != 1)
+            return;
+
+        auto now = QDateTime::currentMSecsSinceEpoch();
+        auto entries = Json::requireObject(obj, "entries");
+        for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+            auto entry = Json::requireObject(it.value());
+            auto expires = static_cast<qint64>(Json::requireDouble(entry, "expires"));
+            if (expires <= now)
+                continue;
+            Target target{ Json::requireString(entry, "host"), static_cast<quint16>(Json::requireInteger(entry, "port")) };
+            c.entries.insert(it.key(), { target, expires, static_cast<qint64>(Json::requireDouble(entry, "ttl")) });
+        }
+    } catch (const Exception& e) {
+        qWarning() << "Couldn't load the server address cache:" << e.cause();
+    }
+}
+
+void clear()
+{
+    QString path;
+    {
+        auto& c = cache();
+        QMutexLocker locker(&c.mutex);
+        c.entries.clear();
+        path = c.path;
+    }
+    if (!path.isEmpty())
+        FS::deletePath(path);
+}
+
+}  // namespace ServerAddressCache
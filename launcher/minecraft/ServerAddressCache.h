@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QString>
+
+#include <optional>
+
+/** Remembers where server host names point to, after looking up their _minecraft._tcp SRV records.
+ *
+ *  Entries live as long as the record's TTL says, and once most of that is gone, using one looks the name up again in
+ *  the background, so a host in regular use never has to wait for the lookup. With a persist path set, the cache
+ *  survives restarts.
+ *
+ *  Only the SRV records are cached: the game looks up the host itself, and needs the name rather than an address to
+ *  reach servers behind proxies.
+ *
+ *  All the functions here are thread-safe, refreshes run on the main thread.
+ */
+namespace ServerAddressCache {
+
+struct Target {
+    QString host;
+    quint16 port = 25565;
+};
+
+/** How long not having an SRV record is remembered, most servers don't have one. */
+constexpr int NO_RECORD_TTL_SECONDS = 600;
+
+/** Where that host name points to, if it's known and not expired. */
+std::optional<Target> lookup(const QString& host);
+
+/** Remembers the lookup's result, the TTL is kept between a minute and a day. */
+void store(const QString& host, const Target& target, int ttl_seconds);
+
+/** Where to keep the cache on disk, also loading what's there. Without one, it's only kept in memory. */
+void setPersistPath(const QString& path);
+
+/** Drops everything, including what's on disk. */
+void clear();
+
+}  // namespace ServerAddressCache
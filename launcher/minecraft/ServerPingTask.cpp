@@ -0,0 +1,333 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ServerPingTask.h"
+
+#include <QDataStream>
+#include <QDeadlineTimer>
+#include <QDnsLookup>
+#include <QHash>
+#include <QHostAddress>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QTcpSocket>
+
+#include "Json.h"
+#include "minecraft/launch/MinecraftServerTarget.h"
+
+namespace ServerPing {
+
+namespace {
+
+// a whole ping, from looking up the address to the pong
+constexpr int TIMEOUT_MS = 5000;
+// status responses are small, except for modded servers listing all their mods
+constexpr int MAX_PACKET_SIZE = 2 * 1024 * 1024;
+// tells the server we don't know which version it is, so it answers with its own
+constexpr qint32 UNKNOWN_PROTOCOL = -1;
+
+struct CachedStatus {
+    Status status;
+    QDeadlineTimer expiry;
+};
+
+struct Cache {
+    QMutex mutex;
+    QHash<QString, CachedStatus> statuses;
+};
+
+Cache& cache()
+{
+    static Cache s_cache;
+    return s_cache;
+}
+
+QByteArray encodeString(const QString& value)
+{
+    auto utf8 = value.toUtf8();
+    return encodeVarInt(utf8.size()) + utf8;
+}
+
+QByteArray frame(const QByteArray& packet)
+{
+    return encodeVarInt(packet.size()) + packet;
+}
+
+// descriptions are either plain strings or chat components, with their children in "extra"
+QString flattenChat(const QJsonValue& value)
+{
+    if (value.isString())
+        return value.toString();
+    if (value.isArray()) {
+        QString text;
+        for (auto child : value.toArray())
+            text += flattenChat(child);
+        return text;
+    }
+    auto obj = value.toObject();
+    return Json::ensureString(obj, "text") + flattenChat(obj.value("extra"));
+}
+
+}  // namespace
+
+std::optional<Status> cachedStatus(const QString& address)
+{
+    auto& c = cache();
+    QMutexLocker locker(&c.mutex);
+    auto it = c.statuses.find(address);
+    if (it == c.statuses.end())
+        return std::nullopt;
+    if (it->expiry.hasExpired()) {
+        c.statuses.erase(it);
+        return std::nullopt;
+    }
+    return it->status;
+}
+
+void cacheStatus(const QString& address, const Status& status)
+{
+    auto& c = cache();
+    QMutexLocker locker(&c.mutex);
+    c.statuses.insert(address, { status, QDeadlineTimer(STATUS_TTL_SECONDS * 1000) });
+}
+
+QByteArray encodeVarInt(qint32 value)
+{
+    QByteArray out;
+    auto bits = static_cast<quint32>(value);
+    do {
+        quint8 byte = bits & 0x7F;
+        bits >>= 7;
+        if (bits)
+            byte |= 0x80;
+        out.append(static_cast<char>(byte));
+    } while (bits);
+    return out;
+}
+
+bool decodeVarInt(const QByteArray& data, int& offset, qint32& value)
+{
+    quint32 bits = 0;
+    for (int i = 0; i < 5; i++) {
+        if (offset + i >= data.size())
+            return false;
+        auto byte = static_cast<quint8>(data.at(offset + i));
+        bits |= quint32(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            offset += i + 1;
+            value = static_cast<qint32>(bits);
+            return true;
+        }
+    }
+    // longer than any VarInt can be
+    return false;
+}
+
+QByteArray statusRequest(const QString& host, quint16 port)
+{
+    QByteArray handshake = encodeVarInt(0x00) + encodeVarInt(UNKNOWN_PROTOCOL) + encodeString(host);
+    handshake.append(static_cast<char>(port >> 8));
+    handshake.append(static_cast<char>(port & 0xFF));
+    // the next state is status
+    handshake += encodeVarInt(1);
+
+    return frame(handshake) + frame(encodeVarInt(0x00));
+}
+
+Status parseStatus(const QByteArray& json)
+{
+    auto obj = Json::requireObject(Json::requireDocument(json, "Server status"), "Server status");
+
+    Status status;
+    status.up = true;
+    static const QRegularExpression s_formatting("§.");
+    status.motd = flattenChat(obj.value("description")).remove(s_formatting).trimmed();
+    status.version = Json::ensureString(Json::ensureObject(obj, "version"), "name").remove(s_formatting);
+
+    auto players = Json::ensureObject(obj, "players");
+    status.currentPlayers = Json::ensureInteger(players, "online");
+    status.maxPlayers = Json::ensureInteger(players, "max");
+
+    auto favicon = Json::ensureString(obj, "favicon");
+    static const QString s_prefix = QStringLiteral("data:image/png;base64,");
+    if (favicon.startsWith(s_prefix))
+        status.icon = QByteArray::fromBase64(favicon.mid(s_prefix.size()).remove('\n').toLatin1());
+
+    return status;
+}
+
+}  // namespace ServerPing
+
+ServerPingTask::ServerPingTask(QString address, QObject* parent) : Task(parent, false), m_address(std::move(address))
+{
+    m_timeout.setSingleShot(true);
+    m_timeout.setInterval(ServerPing::TIMEOUT_MS);
+    connect(&m_timeout, &QTimer::timeout, this, [this] { finish(tr("Timed out")); });
+}
+
+bool ServerPingTask::abort()
+{
+    m_timeout.stop();
+    if (m_dnsLookup)
+        m_dnsLookup->abort();
+    if (m_socket) {
+        disconnect(m_socket, nullptr, this, nullptr);
+        m_socket->abort();
+    }
+    emitAborted();
+    return true;
+}
+
+void ServerPingTask::executeTask()
+{
+    setStatus(tr("Pinging %1").arg(m_address));
+    if (auto cached = ServerPing::cachedStatus(m_address)) {
+        m_status = *cached;
+        emitSucceeded();
+        return;
+    }
+
+    m_timeout.start();
+    auto target = MinecraftServerTarget::parse(m_address.trimmed());
+    if (target.address.isEmpty()) {
+        finish(tr("No address"));
+        return;
+    }
+
+    // like the game, only look for an SRV record if no port was given, and there's a name to look it up for
+    if (target.port != 25565 || !QHostAddress(target.address).isNull()) {
+        connectTo({ target.address, target.port });
+        return;
+    }
+    if (auto cached = ServerAddressCache::lookup(target.address)) {
+        connectTo(*cached);
+        return;
+    }
+
+    m_dnsLookup = new QDnsLookup(QDnsLookup::SRV, QString("_minecraft._tcp.%1").arg(target.address), this);
+    connect(m_dnsLookup, &QDnsLookup::finished, this, &ServerPingTask::lookupFinished);
+    m_dnsLookup->lookup();
+}
+
+void ServerPingTask::lookupFinished()
+{
+    if (isFinished())
+        return;
+
+    auto host = MinecraftServerTarget::parse(m_address.trimmed()).address;
+    ServerAddressCache::Target target{ host, 25565 };
+    auto records = m_dnsLookup->serviceRecords();
+    auto error = m_dnsLookup->error();
+    if (error == QDnsLookup::NoError && !records.isEmpty()) {
+        target = { records.first().target(), records.first().port() };
+        ServerAddressCache::store(host, target, records.first().timeToLive());
+    } else if (error == QDnsLookup::NoError || error == QDnsLookup::NotFoundError) {
+        // most servers don't have a record, which is worth remembering too. Other errors may well go away.
+        ServerAddressCache::store(host, target, ServerAddressCache::NO_RECORD_TTL_SECONDS);
+    }
+    m_dnsLookup->deleteLater();
+    m_dnsLookup = nullptr;
+
+    connectTo(target);
+}
+
+void ServerPingTask::connectTo(const ServerAddressCache::Target& target)
+{
+    m_socket = new QTcpSocket(this);
+    connect(m_socket, &QTcpSocket::connected, this, [this, target] {
+        m_socket->write(ServerPing::statusRequest(target.host, target.port));
+        m_pingTimer.start();
+    });
+    connect(m_socket, &QTcpSocket::readyRead, this, &ServerPingTask::readResponse);
+    connect(m_socket, &QTcpSocket::disconnected, this, [this] {
+        // some servers hang up right after the status instead of answering the ping
+        finish(m_gotStatus ? QString() : tr("Connection closed"));
+    });
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)  // QAbstractSocket::errorOccurred added in 5.15
+    connect(m_socket, &QTcpSocket::errorOccurred, this, [this] {
+#else
+    connect(m_socket, QOverload<QAbstractSocket::SocketError>::of(&QTcpSocket::error), this, [this] {
+#endif
+        finish(m_gotStatus ? QString() : m_socket->errorString());
+    });
+    m_socket->connectToHost(target.host, target.port);
+}
+
+void ServerPingTask::readResponse()
+{
+    m_buffer += m_socket->readAll();
+    while (!isFinished()) {
+        int offset = 0;
+        qint32 length;
+        if (!ServerPing::decodeVarInt(m_buffer, offset, length)) {
+            if (m_buffer.size() >= 5)
+                finish(tr("Invalid response"));
+            return;
+        }
+        if (length <= 0 || length > ServerPing::MAX_PACKET_SIZE) {
+            finish(tr("Invalid response"));
+            return;
+        }
+        if (m_buffer.size() < offset + length)
+            return;
+
+        auto packet = m_buffer.mid(offset, length);
+        m_buffer.remove(0, offset + length);
+
+        int position = 0;
+        qint32 id;
+        if (!ServerPing::decodeVarInt(packet, position, id)) {
+            finish(tr("Invalid response"));
+            return;
+        }
+
+        if (!m_gotStatus) {
+            qint32 size;
+            if (id != 0x00 || !ServerPing::decodeVarInt(packet, position, size) || size < 0 || position + size > packet.size()) {
+                finish(tr("Invalid response"));
+                return;
+            }
+            try {
+                m_status = ServerPing::parseStatus(packet.mid(position, size));
+            } catch (const Json::JsonException& e) {
+                finish(tr("Invalid response: %1").arg(e.cause()));
+                return;
+            }
+            m_gotStatus = true;
+            // good enough if the server doesn't answer the ping
+            m_status.ping = static_cast<int>(m_pingTimer.elapsed());
+
+            QByteArray ping = ServerPing::encodeVarInt(0x01);
+            QDataStream(&ping, QIODevice::Append) << qint64(QDateTime::currentMSecsSinceEpoch());
+            m_socket->write(ServerPing::encodeVarInt(ping.size()) + ping);
+            m_pingTimer.restart();
+        } else if (id == 0x01) {
+            m_status.ping = static_cast<int>(m_pingTimer.elapsed());
+            finish();
+            return;
+        }
+    }
+}
+
+void ServerPingTask::finish(const QString& error)
+{
+    if (isFinished())
+        return;
+
+    m_timeout.stop();
+    if (m_socket) {
+        disconnect(m_socket, nullptr, this, nullptr);
+        m_socket->abort();
+    }
+
+    if (!error.isEmpty()) {
+        m_status = {};
+        m_status.error = error;
+    }
+    ServerPing::cacheStatus(m_address, m_status);
+    emitSucceeded();
+}
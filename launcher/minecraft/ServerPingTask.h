@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QString>
+#include <QTimer>
+
+#include <optional>
+
+#include "minecraft/ServerAddressCache.h"
+#include "tasks/Task.h"
+
+class QDnsLookup;
+class QTcpSocket;
+
+namespace ServerPing {
+
+/** What a server answered to a status request. */
+struct Status {
+    bool up = false;
+    // round trip of a ping packet, in milliseconds
+    int ping = 0;
+    QString motd;
+    QString version;
+    int currentPlayers = 0;
+    int maxPlayers = 0;
+    // the server's icon as PNG data, empty if it has none
+    QByteArray icon;
+    QString error;
+};
+
+/** How long a status stays in the cache. */
+constexpr int STATUS_TTL_SECONDS = 60;
+
+/** The status of the server at that address, if it was asked for less than STATUS_TTL_SECONDS ago. */
+std::optional<Status> cachedStatus(const QString& address);
+void cacheStatus(const QString& address, const Status& status);
+
+QByteArray encodeVarInt(qint32 value);
+/** Reads a VarInt at offset and moves it past it. Returns false if data ends before the VarInt does or it's malformed. */
+bool decodeVarInt(const QByteArray& data, int& offset, qint32& value);
+
+/** The handshake packet announcing a status request, followed by the status request itself. */
+QByteArray statusRequest(const QString& host, quint16 port);
+
+/** Reads a status response's JSON, throwing Json::JsonException if it doesn't look like one. */
+Status parseStatus(const QByteArray& json);
+
+}  // namespace ServerPing
+
+/** Asks a server for its status with the Server List Ping protocol of Minecraft 1.7 and later.
+ *
+ *  Answers from the last STATUS_TTL_SECONDS are reused, and SRV lookups go through the ServerAddressCache. Unless aborted, the task succeeds:
+ *  a server that can't be reached is reported as down, with the reason in the status' error.
+ */
+class ServerPingTask : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<ServerPingTask>;
+
+    explicit ServerPingTask(QString address, QObject* parent = nullptr);
+    virtual ~ServerPingTask() = default;
+
+    const QString& address() const { return m_address; }
+    const ServerPing::Status& status() const { return m_status; }
+
+    bool canAbort() const override { return true; }
+    bool abort() override;
+
+   protected:
+    void executeTask() override;
+
+   private:
+    void lookupFinished();
+    void connectTo(const ServerAddressCache::Target& target);
+    void readResponse();
+    void finish(const QString& error = {});
+
+   private:
+    QString m_address;
+    ServerPing::Status m_status;
+
+    QDnsLookup* m_dnsLookup = nullptr;
+    QTcpSocket* m_socket = nullptr;
+    QTimer m_timeout;
+    QElapsedTimer m_pingTimer;
+    QByteArray m_buffer;
+    bool m_gotStatus = false;
+};
@@ -40,6 +40,7 @@
 #include <QDirIterator>
 #include <QSaveFile>
 #include <QString>
+#include <QTemporaryDir>
 
 #include <FileSystem.h>
 #include <MMCZip.h>
@@ -51,6 +52,8 @@
 #include <tag_string.h>
 #include <sstream>
 #include "GZip.h"
+#include "LevelDat.h"
+#include "tasks/CpuExecutor.h"
 
 #include <QCoreApplication>
 
@@ -187,18 +190,14 @@ bool putLevelDatDataToFS(const QFileInfo& file, QByteArray& data)
     if (!f.open(QIODevice::WriteOnly)) {
         return false;
     }
-    QByteArray compressed;
-    if (!GZip::zip(data, compressed)) {
-        return false;
-    }
-    if (f.write(compressed) != compressed.size()) {
+    if (!GZip::zip(data, f)) {
         f.cancelWriting();
         return false;
     }
     return f.commit();
 }
 
-int64_t calculateWorldSize(const QFileInfo& file)
+int64_t World::calculateSize(const QFileInfo& file)
 {
     if (file.isFile() && file.suffix() == "zip") {
         return file.size();
@@ -206,24 +205,25 @@ int64_t calculateWorldSize(const QFileInfo& file)
         QDirIterator it(file.absoluteFilePath(), QDir::Files, QDirIterator::Subdirectories);
         int64_t total = 0;
         while (it.hasNext()) {
-            total += it.fileInfo().size();
             it.next();
+            total += it.fileInfo().size();
         }
         return total;
     }
     return -1;
 }
 
-World::World(const QFileInfo& file)
+World::World(const QFileInfo& file, bool calculateSize)
 {
-    repath(file);
+    repath(file, calculateSize);
 }
 
-void World::repath(const QFileInfo& file)
+void World::repath(const QFileInfo& file, bool calculateSize)
 {
     m_containerFile = file;
     m_folderName = file.fileName();
-    m_size = calculateWorldSize(file);
+    // zips are a single stat, folders get their size calculated later if asked to
+    m_size = calculateSize || !file.isDir() ? World::calculateSize(file) : -1;
     if (file.isFile() && file.suffix() == "zip") {
         m_iconFile = QString();
         readFromZip(file);
@@ -250,13 +250,14 @@ bool World::resetIcon()
 
 void World::readFromFS(const QFileInfo& file)
 {
-    auto bytes = getLevelDatDataFromFS(file);
-    if (bytes.isEmpty()) {
+    auto fullFilePath = getLevelDatFromFS(file);
+    QFile levelDat(fullFilePath);
+    if (fullFilePath.isNull() || !levelDat.open(QIODevice::ReadOnly)) {
         is_valid = false;
         return;
     }
-    loadFromLevelDat(bytes);
     levelDatTime = file.lastModified();
+    loadFromLevelDat(levelDat);
 }
 
 void World::readFromZip(const QFileInfo& file)
@@ -289,36 +290,79 @@ void World::readFromZip(const QFileInfo& file)
     if (!is_valid) {
         return;
     }
-    loadFromLevelDat(zippedFile.readAll());
+    loadFromLevelDat(zippedFile);
     zippedFile.close();
 }
 
 bool World::install(const QString& to, const QString& name)
 {
-    auto finalPath = FS::PathCombine(to, FS::DirNameFromString(m_actualName, to));
-    if (!FS::ensureFolderPathExists(finalPath)) {
-        return false;
+    return copyTo(to, m_actualName, name).isEmpty();
+}
+
+Task::Ptr World::installTask(const QString& to, const QString& name) const
+{
+    return makeShared<CpuTask>([world = *this, to, name] { return world.copyTo(to, world.m_actualName, name); });
+}
+
+Task::Ptr World::snapshotTask(const QString& to) const
+{
+    auto folderName = m_folderName + QDateTime::currentDateTime().toString("_yyyy-MM-dd_HH-mm-ss");
+    return makeShared<CpuTask>([world = *this, to, folderName] { return world.copyTo(to, folderName, QString()); });
+}
+
+QString World::copyTo(const QString& to, const QString& folderName, const QString& name) const
+{
+    if (!FS::ensureFolderPathExists(to)) {
+        return QCoreApplication::translate("World", "Could not create the folder %1.").arg(to);
     }
+
+    // the world is put together next to the folder it goes to, so it only shows up there once it is complete
+    QTemporaryDir staging(FS::PathCombine(QFileInfo(to).absolutePath(), ".world-XXXXXX"));
+    if (!staging.isValid()) {
+        return QCoreApplication::translate("World", "Could not create a temporary folder next to %1.").arg(to);
+    }
+    auto stagedPath = staging.path();
+
     bool ok = false;
     if (m_containerFile.isFile()) {
         QuaZip zip(m_containerFile.absoluteFilePath());
         if (!zip.open(QuaZip::mdUnzip)) {
-            return false;
+            return QCoreApplication::translate("World", "Could not open %1.").arg(m_containerFile.absoluteFilePath());
         }
-        ok = !MMCZip::extractSubDir(&zip, m_containerOffsetPath, finalPath);
+        ok = MMCZip::extractSubDir(&zip, m_containerOffsetPath, stagedPath).has_value();
     } else if (m_containerFile.isDir()) {
         QString from = m_containerFile.filePath();
-        ok = FS::copy(from, finalPath)();
+        // a clone shares the data with the original until either changes, so even a big world is copied in no time
+        if (FS::canClone(from, stagedPath)) {
+            FS::clone cloner(from, stagedPath);
+            ok = cloner() && cloner.totalFailed() == 0;
+            if (!ok) {
+                qWarning() << "Could not clone world" << from << "falling back to copying it";
+                FS::deletePath(stagedPath);
+                FS::ensureFolderPathExists(stagedPath);
+            }
+        }
+        if (!ok) {
+            ok = FS::copy(from, stagedPath)();
+        }
+    }
+    if (!ok) {
+        return QCoreApplication::translate("World", "Could not copy the files of %1.").arg(m_actualName);
+    }
+
+    auto finalPath = FS::PathCombine(to, FS::DirNameFromString(folderName, to));
+    if (!QDir().rename(stagedPath, finalPath)) {
+        return QCoreApplication::translate("World", "Could not move the world to %1.").arg(finalPath);
     }
+    staging.setAutoRemove(false);
 
-    if (ok && !name.isEmpty() && m_actualName != name) {
-        QFileInfo finalPathInfo(finalPath);
-        World newWorld(finalPathInfo);
+    if (!name.isEmpty() && m_actualName != name) {
+        World newWorld(QFileInfo(finalPath), false);
         if (newWorld.isValid()) {
             newWorld.rename(name);
         }
     }
-    return ok;
+    return {};
 }
 
 bool World::rename(const QString& newName)
@@ -357,114 +401,21 @@ bool World::rename(const QString& newName)
     return true;
 }
 
-namespace {
-
-optional<QString> read_string(nbt::value& parent, const char* name)
-{
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::String) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_string>();
-        return QString::fromStdString(tag_str.get());
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "String NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to string.";
-        return nullopt;
-    }
-}
-
-optional<int64_t> read_long(nbt::value& parent, const char* name)
+void World::loadFromLevelDat(QIODevice& levelDat)
 {
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::Long) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_long>();
-        return tag_str.get();
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "Long NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to long.";
-        return nullopt;
-    }
-}
-
-optional<int> read_int(nbt::value& parent, const char* name)
-{
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::Int) {
-            return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_int>();
-        return tag_str.get();
-    } catch ([[maybe_unused]] const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "Int NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch ([[maybe_unused]] const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to int.";
-        return nullopt;
-    }
-}
-
-GameType read_gametype(nbt::value& parent, const char* name)
-{
-    return GameType(read_int(parent, name));
-}
-
-}  // namespace
-
-void World::loadFromLevelDat(QByteArray data)
-{
-    auto levelData = parseLevelDat(data);
-    if (!levelData) {
+    auto summary = LevelDat::readSummary(levelDat);
+    if (!summary) {
+        qWarning() << "Unable to read NBT tags from" << m_folderName;
         is_valid = false;
         return;
     }
+    is_valid = true;
 
-    nbt::value* valPtr = nullptr;
-    try {
-        valPtr = &levelData->at("Data");
-    } catch (const std::out_of_range& e) {
-        qWarning() << "Unable to read NBT tags from " << m_folderName << ":" << e.what();
-        is_valid = false;
-        return;
-    }
-    nbt::value& val = *valPtr;
-
-    is_valid = val.get_type() == nbt::tag_type::Compound;
-    if (!is_valid)
-        return;
-
-    auto name = read_string(val, "LevelName");
-    m_actualName = name ? *name : m_folderName;
-
-    auto timestamp = read_long(val, "LastPlayed");
-    m_lastPlayed = timestamp ? QDateTime::fromMSecsSinceEpoch(*timestamp) : levelDatTime;
-
-    m_gameType = read_gametype(val, "GameType");
+    m_actualName = summary->levelName ? *summary->levelName : m_folderName;
+    m_lastPlayed = summary->lastPlayed ? QDateTime::fromMSecsSinceEpoch(*summary->lastPlayed) : levelDatTime;
+    m_gameType = GameType(summary->gameType);
 
-    optional<int64_t> randomSeed;
-    try {
-        auto& WorldGen_val = val.at("WorldGenSettings");
-        randomSeed = read_long(WorldGen_val, "seed");
-    } catch (const std::out_of_range&) {
-    }
-    if (!randomSeed) {
-        randomSeed = read_long(val, "RandomSeed");
-    }
+    optional<int64_t> randomSeed = summary->seed ? summary->seed : summary->randomSeed;
     m_randomSeed = randomSeed ? *randomSeed : 0;
 
     qDebug() << "World Name:" << m_actualName;
@@ -16,8 +16,11 @@
 #pragma once
 #include <QDateTime>
 #include <QFileInfo>
+#include <QIODevice>
 #include <optional>
 
+#include "tasks/Task.h"
+
 struct GameType {
     GameType() = default;
     GameType(std::optional<int> original);
@@ -31,7 +34,7 @@ struct GameType {
 
 class World {
    public:
-    World(const QFileInfo& file);
+    World(const QFileInfo& file, bool calculateSize = true);
     QString folderName() const { return m_folderName; }
     QString name() const { return m_actualName; }
     QString iconFile() const { return m_iconFile; }
@@ -47,12 +50,20 @@ class World {
     // replace this world with a copy of the other
     bool replace(World& with);
     // change the world's filesystem path (used by world lists for *MAGIC* purposes)
-    void repath(const QFileInfo& file);
+    void repath(const QFileInfo& file, bool calculateSize = true);
+    // set the size, for worlds that were read without calculating it
+    void setBytes(int64_t bytes) { m_size = bytes; }
+    // add up the size of all the files of a world, which can take a while for big worlds
+    static int64_t calculateSize(const QFileInfo& file);
     // remove the icon file, if any
     bool resetIcon();
 
     bool rename(const QString& to);
     bool install(const QString& to, const QString& name = QString());
+    // like install, in the background
+    Task::Ptr installTask(const QString& to, const QString& name = QString()) const;
+    // copy the world into its own folder in 'to', named after it and the current time
+    Task::Ptr snapshotTask(const QString& to) const;
 
     // WEAK compare operator - used for replacing worlds
     bool operator==(const World& other) const;
@@ -73,9 +84,11 @@ class World {
     QString canonicalFilePath() const { return m_containerFile.canonicalFilePath(); }
 
    private:
+    // the error, if the world could not be copied into 'to' under a folder named after 'folderName'
+    QString copyTo(const QString& to, const QString& folderName, const QString& name) const;
     void readFromZip(const QFileInfo& file);
     void readFromFS(const QFileInfo& file);
-    void loadFromLevelDat(QByteArray data);
+    void loadFromLevelDat(QIODevice& levelDat);
 
    protected:
     QFileInfo m_containerFile;
@@ -85,7 +98,7 @@ class World {
     QString m_iconFile;
     QDateTime levelDatTime;
     QDateTime m_lastPlayed;
-    int64_t m_size;
+    int64_t m_size = -1;
     int64_t m_randomSeed = 0;
     GameType m_gameType;
     bool is_valid = false;
@@ -37,22 +37,37 @@
 
 #include <FileSystem.h>
 #include <QDebug>
-#include <QFileSystemWatcher>
 #include <QMimeData>
 #include <QString>
 #include <QUrl>
 #include <QUuid>
 #include <Qt>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
 #include "Application.h"
 
+namespace {
+struct CalculateWorldSize {
+    using result_type = WorldList::WorldSize;
+    WorldList::WorldSize operator()(const QString& path) const { return { path, World::calculateSize(QFileInfo(path)) }; }
+};
+}  // namespace
+
 WorldList::WorldList(const QString& dir, BaseInstance* instance) : QAbstractListModel(), m_instance(instance), m_dir(dir)
 {
     FS::ensureFolderPathExists(m_dir.absolutePath());
     m_dir.setFilter(QDir::Readable | QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
     m_dir.setSorting(QDir::Name | QDir::IgnoreCase | QDir::LocaleAware);
-    m_watcher = new QFileSystemWatcher(this);
+    m_watcher = new CoalescingFileSystemWatcher(this);
     is_watching = false;
-    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &WorldList::directoryChanged);
+    connect(m_watcher, &CoalescingFileSystemWatcher::pathsChanged, this, &WorldList::directoriesChanged);
+    connect(&m_readWatcher, &QFutureWatcher<QList<CachedWorld>>::finished, this, &WorldList::worldsRead);
+    connect(&m_sizeWatcher, &QFutureWatcher<WorldSize>::resultReadyAt, this, &WorldList::worldSizeReady);
+}
+
+WorldList::~WorldList()
+{
+    m_sizeWatcher.cancel();
 }
 
 void WorldList::startWatching()
@@ -87,26 +102,110 @@ bool WorldList::update()
     if (!isValid())
         return false;
 
-    QList<World> newWorlds;
+    // worlds are still being read, look again once that's done
+    if (m_readWatcher.isRunning()) {
+        m_updateQueued = true;
+        return true;
+    }
+
     m_dir.refresh();
-    auto folderContents = m_dir.entryInfoList();
-    // if there are any untracked files...
-    for (QFileInfo entry : folderContents) {
+    m_entries.clear();
+    QList<QFileInfo> toRead;
+    for (const QFileInfo& entry : m_dir.entryInfoList()) {
         if (!entry.isDir())
             continue;
+        m_entries.append(entry);
 
-        World w(entry);
-        if (w.isValid()) {
-            newWorlds.append(w);
+        // saving a world replaces its level.dat, which touches the folder
+        auto cached = m_cache.constFind(entry.absoluteFilePath());
+        if (cached == m_cache.constEnd() || cached->modified != entry.lastModified()) {
+            toRead.append(entry);
         }
     }
+
+    if (toRead.isEmpty()) {
+        applyWorlds();
+        return true;
+    }
+    m_readWatcher.setFuture(QtConcurrent::run([toRead] {
+        QList<CachedWorld> read;
+        for (auto& entry : toRead) {
+            auto modified = entry.lastModified();
+            read.append({ modified, World(entry, false) });
+        }
+        return read;
+    }));
+    return true;
+}
+
+void WorldList::worldsRead()
+{
+    for (auto& cached : m_readWatcher.result()) {
+        m_cache.insert(cached.world.container().absoluteFilePath(), cached);
+    }
+    applyWorlds();
+
+    if (m_updateQueued) {
+        m_updateQueued = false;
+        update();
+    }
+}
+
+void WorldList::applyWorlds()
+{
+    QList<World> newWorlds;
+    QHash<QString, CachedWorld> cache;
+    for (auto& entry : m_entries) {
+        auto path = entry.absoluteFilePath();
+        auto cached = m_cache.constFind(path);
+        if (cached == m_cache.constEnd())
+            continue;
+        // also forgets the worlds that are gone
+        cache.insert(path, *cached);
+        if (cached->world.isValid()) {
+            newWorlds.append(cached->world);
+        }
+    }
+    m_cache.swap(cache);
+
     beginResetModel();
     worlds.swap(newWorlds);
     endResetModel();
-    return true;
+
+    calculateSizes();
+}
+
+void WorldList::calculateSizes()
+{
+    QStringList paths;
+    for (auto& world : worlds) {
+        if (world.bytes() < 0) {
+            paths.append(world.container().absoluteFilePath());
+        }
+    }
+    m_sizeWatcher.cancel();
+    if (paths.isEmpty())
+        return;
+    m_sizeWatcher.setFuture(QtConcurrent::mapped(paths, CalculateWorldSize()));
+}
+
+void WorldList::worldSizeReady(int resultIndex)
+{
+    auto size = m_sizeWatcher.resultAt(resultIndex);
+    auto cached = m_cache.find(size.path);
+    if (cached != m_cache.end()) {
+        cached->world.setBytes(size.bytes);
+    }
+    for (int row = 0; row < worlds.size(); row++) {
+        if (worlds[row].container().absoluteFilePath() == size.path) {
+            worlds[row].setBytes(size.bytes);
+            emit dataChanged(index(row, SizeColumn), index(row, SizeColumn));
+            break;
+        }
+    }
 }
 
-void WorldList::directoryChanged(QString path)
+void WorldList::directoriesChanged([[maybe_unused]] const QSet<QString>& paths)
 {
     update();
 }
@@ -193,6 +292,9 @@ QVariant WorldList::data(const QModelIndex& index, int role) const
                     return world.lastPlayed();
 
                 case SizeColumn:
+                    if (world.bytes() < 0) {
+                        return tr("Calculating...");
+                    }
                     return locale.formattedDataSize(world.bytes());
 
                 case InfoColumn:
@@ -374,14 +476,32 @@ Qt::DropActions WorldList::supportedDropActions() const
     return Qt::CopyAction | Qt::MoveAction;
 }
 
-void WorldList::installWorld(QFileInfo filename)
+Task::Ptr WorldList::installWorld(QFileInfo filename)
 {
     qDebug() << "installing: " << filename.absoluteFilePath();
-    World w(filename);
+    World w(filename, false);
     if (!w.isValid()) {
-        return;
+        return nullptr;
     }
-    w.install(m_dir.absolutePath());
+    auto task = w.installTask(m_dir.absolutePath());
+    runTask(task);
+    return task;
+}
+
+void WorldList::runTask(Task::Ptr task)
+{
+    m_tasks.append(task);
+    connect(task.get(), &Task::failed, this, [](QString reason) { qWarning() << "Failed to add a world:" << reason; });
+    connect(task.get(), &Task::finished, this, [this, raw = task.get()] {
+        for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+            if (it->get() == raw) {
+                m_tasks.erase(it);
+                break;
+            }
+        }
+        update();
+    });
+    task->start();
 }
 
 bool WorldList::dropMimeData(const QMimeData* data,
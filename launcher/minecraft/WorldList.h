@@ -16,11 +16,15 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QDateTime>
 #include <QDir>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QList>
 #include <QMimeData>
 #include <QString>
 #include "BaseInstance.h"
+#include "CoalescingFileSystemWatcher.h"
 #include "minecraft/World.h"
 
 class QFileSystemWatcher;
@@ -33,6 +37,7 @@ class WorldList : public QAbstractListModel {
     enum Roles { ObjectRole = Qt::UserRole + 1, FolderRole, SeedRole, NameRole, GameModeRole, LastPlayedRole, SizeRole, IconFileRole };
 
     WorldList(const QString& dir, BaseInstance* instance);
+    virtual ~WorldList();
 
     virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
 
@@ -44,11 +49,17 @@ class WorldList : public QAbstractListModel {
     bool empty() const { return size() == 0; }
     World& operator[](size_t index) { return worlds[index]; }
 
-    /// Reloads the mod list and returns true if the list changed.
+    /// Rereads the worlds that changed in the background, and returns false if the folder can't be read.
+    /// World sizes are calculated afterwards and filled in as they come.
     virtual bool update();
+    /// Whether worlds are being read or measured.
+    bool isUpdating() const { return m_updateQueued || m_readWatcher.isRunning() || m_sizeWatcher.isRunning(); }
 
-    /// Install a world from location
-    void installWorld(QFileInfo filename);
+    /// Install a world from location, in the background. Returns null if it isn't a world
+    Task::Ptr installWorld(QFileInfo filename);
+
+    /// Runs a task that adds worlds, and rereads the worlds once it's done
+    void runTask(Task::Ptr task);
 
     /// Deletes the mod at the given index.
     virtual bool deleteWorld(int index);
@@ -84,16 +95,40 @@ class WorldList : public QAbstractListModel {
 
     const QList<World>& allWorlds() const { return worlds; }
 
+    struct WorldSize {
+        QString path;
+        int64_t bytes = -1;
+    };
+
    private slots:
-    void directoryChanged(QString path);
+    void directoriesChanged(const QSet<QString>& paths);
+    void worldsRead();
+    void worldSizeReady(int resultIndex);
 
    signals:
     void changed();
 
    protected:
     BaseInstance* m_instance;
-    QFileSystemWatcher* m_watcher;
+    CoalescingFileSystemWatcher* m_watcher;
     bool is_watching;
     QDir m_dir;
     QList<World> worlds;
+
+   private:
+    void applyWorlds();
+    void calculateSizes();
+
+    /// a world as it was read, along with the modification time of its folder back then
+    struct CachedWorld {
+        QDateTime modified;
+        World world;
+    };
+    QHash<QString, CachedWorld> m_cache;
+    QList<QFileInfo> m_entries;
+    QFutureWatcher<QList<CachedWorld>> m_readWatcher;
+    QFutureWatcher<WorldSize> m_sizeWatcher;
+    bool m_updateQueued = false;
+    /// installs, copies and snapshots still going
+    QList<Task::Ptr> m_tasks;
 };
@@ -128,6 +128,9 @@ void profileToJSONV3(QJsonObject& parent, MinecraftProfile p, const char* tokenN
         skinObj["variant"] = p.skin.variant;
         if (p.skin.data.size()) {
             skinObj["data"] = QString::fromLatin1(p.skin.data.toBase64());
+            if (!p.skin.etag.isEmpty()) {
+                skinObj["etag"] = p.skin.etag;
+            }
         }
         out["skin"] = skinObj;
     }
@@ -188,6 +191,7 @@ MinecraftProfile profileFromJSONV3(const QJsonObject& parent, const char* tokenN
         if (dataV.isString()) {
             // TODO: validate base64
             out.skin.data = QByteArray::fromBase64(dataV.toString().toLatin1());
+            out.skin.etag = skinObj.value("etag").toString();
         } else if (!dataV.isUndefined()) {
             qWarning() << "skin data is something unexpected";
             return MinecraftProfile();
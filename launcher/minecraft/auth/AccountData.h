@@ -55,6 +55,13 @@ struct Token {
 
     Validity validity = Validity::None;
     bool persistent = true;
+
+    //! whether the token is known and stays valid for at least that many more seconds
+    bool isFresh(qint64 marginSecs) const
+    {
+        return validity != Validity::None && !token.isEmpty() && notAfter.isValid() &&
+               QDateTime::currentDateTimeUtc().secsTo(notAfter) > marginSecs;
+    }
 };
 
 struct Skin {
@@ -63,6 +70,8 @@ struct Skin {
     QString variant;
 
     QByteArray data;
+    //! ETag of the response the data came from, so the skin is only downloaded again when it changed
+    QString etag;
 };
 
 struct Cape {
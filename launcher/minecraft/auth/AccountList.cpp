@@ -44,6 +44,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include <QRandomGenerator>
 #include <QTextStream>
 #include <QTimer>
 
@@ -59,12 +60,18 @@ AccountList::AccountList(QObject* parent) : QAbstractListModel(parent)
     m_refreshTimer = new QTimer(this);
     m_refreshTimer->setSingleShot(true);
     connect(m_refreshTimer, &QTimer::timeout, this, &AccountList::fillQueue);
-    m_nextTimer = new QTimer(this);
-    m_nextTimer->setSingleShot(true);
-    connect(m_nextTimer, &QTimer::timeout, this, &AccountList::tryNext);
+
+    // changes tend to come in bursts, like when the tokens of all accounts are refreshed at once
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SAVE_DELAY_MS);
+    connect(m_saveTimer, &QTimer::timeout, this, &AccountList::saveList);
 }
 
-AccountList::~AccountList() noexcept {}
+AccountList::~AccountList() noexcept
+{
+    saveNow();
+}
 
 int AccountList::findAccountByProfileId(const QString& profileId) const
 {
@@ -242,7 +249,7 @@ void AccountList::onListChanged()
 {
     if (m_autosave)
         // TODO: Alert the user if this fails.
-        saveList();
+        m_saveTimer->start();
 
     emit listChanged();
 }
@@ -250,11 +257,17 @@ void AccountList::onListChanged()
 void AccountList::onDefaultAccountChanged()
 {
     if (m_autosave)
-        saveList();
+        m_saveTimer->start();
 
     emit defaultAccountChanged();
 }
 
+void AccountList::saveNow()
+{
+    if (m_saveTimer->isActive())
+        saveList();
+}
+
 int AccountList::count() const
 {
     return m_accounts.count();
@@ -439,6 +452,7 @@ bool AccountList::loadList()
     // Read the file and close it.
     QByteArray jsonData = file.readAll();
     file.close();
+    m_savedData = jsonData;
 
     QJsonParseError parseError;
     QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonData, &parseError);
@@ -505,6 +519,7 @@ bool AccountList::loadV3(QJsonObject& root)
 
 bool AccountList::saveList()
 {
+    m_saveTimer->stop();
     if (m_listFilePath.isEmpty()) {
         qCritical() << "Can't save Mojang account list. No file path given and no default set.";
         return false;
@@ -544,7 +559,12 @@ bool AccountList::saveList()
     root.insert("accounts", accounts);
 
     // Create a JSON document object to convert our JSON to bytes.
-    QJsonDocument doc(root);
+    auto data = QJsonDocument(root).toJson();
+    // refreshing a token often ends up with what we had
+    if (data == m_savedData && QFileInfo::exists(m_listFilePath)) {
+        qDebug() << "Account list didn't change, not writing it again";
+        return true;
+    }
 
     // Now that we're done building the JSON object, we can write it to the file.
     qDebug() << "Writing account list to file.";
@@ -558,10 +578,11 @@ bool AccountList::saveList()
     }
 
     // Write the JSON to the file.
-    file.write(doc.toJson());
+    file.write(data);
     file.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::WriteUser);
     if (file.commit()) {
         qDebug() << "Saved account list to" << m_listFilePath;
+        m_savedData = data;
         return true;
     } else {
         qDebug() << "Failed to save accounts to" << m_listFilePath;
@@ -585,11 +606,22 @@ bool AccountList::anyAccountIsValid()
     return false;
 }
 
+bool AccountList::isRefreshDue(const MinecraftAccountPtr& account) const
+{
+    if (m_refreshing.contains(account->internalId()) || !account->shouldRefresh()) {
+        return false;
+    }
+    auto backoff = m_backoff.constFind(account->internalId());
+    return backoff == m_backoff.constEnd() || backoff->retryAt <= QDateTime::currentDateTimeUtc();
+}
+
 void AccountList::fillQueue()
 {
-    if (m_defaultAccount && m_defaultAccount->shouldRefresh()) {
+    if (m_defaultAccount && isRefreshDue(m_defaultAccount)) {
         auto idToRefresh = m_defaultAccount->internalId();
-        m_refreshQueue.push_back(idToRefresh);
+        if (!m_refreshQueue.contains(idToRefresh)) {
+            m_refreshQueue.push_front(idToRefresh);
+        }
         qDebug() << "AccountList: Queued default account with internal ID " << idToRefresh << " to refresh first";
     }
 
@@ -599,12 +631,40 @@ void AccountList::fillQueue()
             continue;
         }
 
-        if (account->shouldRefresh()) {
+        if (isRefreshDue(account)) {
             auto idToRefresh = account->internalId();
             queueRefresh(idToRefresh);
         }
     }
     tryNext();
+    scheduleNextCheck();
+}
+
+void AccountList::scheduleNextCheck()
+{
+    auto now = QDateTime::currentDateTimeUtc();
+    // accounts that are in use now may become free at any time, so look again every hour regardless
+    auto next = now.addSecs(3600);
+    for (auto& account : m_accounts) {
+        if (m_refreshing.contains(account->internalId())) {
+            continue;
+        }
+        auto due = account->refreshDue();
+        if (!due.isValid()) {
+            continue;
+        }
+        auto backoff = m_backoff.constFind(account->internalId());
+        if (backoff != m_backoff.constEnd() && backoff->retryAt > due) {
+            due = backoff->retryAt;
+        }
+        if (due < next) {
+            next = due;
+        }
+    }
+
+    // spread out the refreshes of accounts that expire at the same time, and of launchers that started together
+    auto delay = qMax<qint64>(0, now.msecsTo(next)) + QRandomGenerator::global()->bounded(30 * 1000);
+    m_refreshTimer->start(static_cast<int>(qMin<qint64>(delay, 3600 * 1000)));
 }
 
 void AccountList::requestRefresh(QString accountId)
@@ -613,11 +673,11 @@ void AccountList::requestRefresh(QString accountId)
     if (index != -1) {
         m_refreshQueue.removeAt(index);
     }
+    // asked for explicitly, so don't hold it back after earlier failures
+    m_backoff.remove(accountId);
     m_refreshQueue.push_front(accountId);
     qDebug() << "AccountList: Pushed account with internal ID " << accountId << " to the front of the queue";
-    if (!isActive()) {
-        tryNext();
-    }
+    tryNext();
 }
 
 void AccountList::queueRefresh(QString accountId)
@@ -631,41 +691,52 @@ void AccountList::queueRefresh(QString accountId)
 
 void AccountList::tryNext()
 {
-    while (m_refreshQueue.length()) {
+    while (m_refreshQueue.length() && m_refreshing.size() < MAX_PARALLEL_REFRESHES) {
         auto accountId = m_refreshQueue.front();
         m_refreshQueue.pop_front();
-        for (int i = 0; i < count(); i++) {
-            auto account = at(i);
-            if (account->internalId() == accountId) {
-                m_currentTask = account->refresh();
-                if (m_currentTask) {
-                    connect(m_currentTask.get(), &Task::succeeded, this, &AccountList::authSucceeded);
-                    connect(m_currentTask.get(), &Task::failed, this, &AccountList::authFailed);
-                    m_currentTask->start();
-                    qDebug() << "RefreshSchedule: Processing account " << account->accountDisplayString() << " with internal ID "
-                             << accountId;
-                    return;
-                }
+        if (m_refreshing.contains(accountId)) {
+            continue;
+        }
+        MinecraftAccountPtr account;
+        for (auto& candidate : m_accounts) {
+            if (candidate->internalId() == accountId) {
+                account = candidate;
+                break;
             }
         }
-        qDebug() << "RefreshSchedule: Account with with internal ID " << accountId << " not found.";
+        if (!account) {
+            qDebug() << "RefreshSchedule: Account with with internal ID " << accountId << " not found.";
+            continue;
+        }
+        auto task = account->refresh();
+        if (!task) {
+            continue;
+        }
+        m_refreshing.insert(accountId, task);
+        connect(task.get(), &Task::finished, this,
+                [this, accountId, task = task.get()] { refreshFinished(accountId, task->wasSuccessful(), task->failReason()); });
+        qDebug() << "RefreshSchedule: Processing account " << account->accountDisplayString() << " with internal ID " << accountId;
+        // may already be running, if something else asked the account for a refresh
+        task->start();
     }
-    // if we get here, no account needed refreshing. Schedule refresh in an hour.
-    m_refreshTimer->start(1000 * 3600);
 }
 
-void AccountList::authSucceeded()
+void AccountList::refreshFinished(const QString& accountId, bool successful, const QString& reason)
 {
-    qDebug() << "RefreshSchedule: Background account refresh succeeded";
-    m_currentTask.reset();
-    m_nextTimer->start(1000 * 20);
-}
-
-void AccountList::authFailed(QString reason)
-{
-    qDebug() << "RefreshSchedule: Background account refresh failed: " << reason;
-    m_currentTask.reset();
-    m_nextTimer->start(1000 * 20);
+    m_refreshing.remove(accountId);
+    if (successful) {
+        qDebug() << "RefreshSchedule: Background account refresh succeeded";
+        m_backoff.remove(accountId);
+    } else {
+        auto& backoff = m_backoff[accountId];
+        backoff.failures++;
+        // one minute, doubling up to six hours, give or take a quarter so the retries of many accounts don't line up
+        qint64 delay = qMin<qint64>(60LL << qMin(backoff.failures - 1, 16), 6 * 3600);
+        delay = delay * (75 + QRandomGenerator::global()->bounded(51)) / 100;
+        backoff.retryAt = QDateTime::currentDateTimeUtc().addSecs(delay);
+        qDebug() << "RefreshSchedule: Background account refresh failed: " << reason << ", retrying in" << delay << "seconds";
+    }
+    fillQueue();
 }
 
 bool AccountList::isActive() const
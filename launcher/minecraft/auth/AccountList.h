@@ -39,6 +39,8 @@
 #include "minecraft/auth/AuthFlow.h"
 
 #include <QAbstractListModel>
+#include <QDateTime>
+#include <QHash>
 #include <QObject>
 #include <QSharedPointer>
 #include <QVariant>
@@ -99,6 +101,8 @@ class AccountList : public QAbstractListModel {
     bool loadList();
     bool loadV3(QJsonObject& root);
     bool saveList();
+    /* Writes changes that are waiting for more of them right away, if there are any. */
+    void saveNow();
 
     MinecraftAccountPtr defaultAccount() const;
     void setDefaultAccount(MinecraftAccountPtr profileId);
@@ -138,14 +142,31 @@ class AccountList : public QAbstractListModel {
    private slots:
     void tryNext();
 
-    void authSucceeded();
-    void authFailed(QString reason);
+   private:
+    void refreshFinished(const QString& accountId, bool successful, const QString& reason);
+    //! arms the refresh timer for when the next account is due, or in an hour at most
+    void scheduleNextCheck();
+    bool isRefreshDue(const MinecraftAccountPtr& account) const;
 
    protected:
+    struct RefreshBackoff {
+        int failures = 0;
+        QDateTime retryAt;
+    };
+
+    // the accounts are independent of each other, so a few of them are refreshed at once
+    static constexpr int MAX_PARALLEL_REFRESHES = 3;
+
+    // how long changes wait for more of them before the list is saved
+    static constexpr int SAVE_DELAY_MS = 1000;
+
     QList<QString> m_refreshQueue;
     QTimer* m_refreshTimer;
-    QTimer* m_nextTimer;
-    shared_qobject_ptr<AuthFlow> m_currentTask;
+    QTimer* m_saveTimer;
+    // what the list file holds, as far as we know
+    QByteArray m_savedData;
+    QHash<QString, shared_qobject_ptr<AuthFlow>> m_refreshing;
+    QHash<QString, RefreshBackoff> m_backoff;
 
     /*!
      * Called whenever the list changes.
@@ -66,8 +66,13 @@ void AuthFlow::nextStep()
         return;
     }
     m_currentStep = m_steps.front();
-    qDebug() << "AuthFlow:" << m_currentStep->describe();
     m_steps.pop_front();
+    if (m_currentStep->canSkip()) {
+        qDebug() << "AuthFlow: Skipping, still valid:" << m_currentStep->describe();
+        nextStep();
+        return;
+    }
+    qDebug() << "AuthFlow:" << m_currentStep->describe();
     connect(m_currentStep.get(), &AuthStep::finished, this, &AuthFlow::stepFinished);
 
     m_currentStep->perform();
@@ -32,6 +32,9 @@ class AuthStep : public QObject {
 
     virtual QString describe() = 0;
 
+    /** Whether what this step would get is still known and valid, so that a refresh can go on without it. */
+    virtual bool canSkip() const { return false; }
+
    public slots:
     virtual void perform() = 0;
 
@@ -37,7 +37,6 @@
 
 #include "MinecraftAccount.h"
 
-#include <QColor>
 #include <QCryptographicHash>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -48,8 +47,7 @@
 
 #include <QDebug>
 
-#include <QPainter>
-
+#include "SkinUtils.h"
 #include "minecraft/auth/AccountData.h"
 #include "minecraft/auth/AuthFlow.h"
 
@@ -103,20 +101,7 @@ AccountState MinecraftAccount::accountState() const
 
 QPixmap MinecraftAccount::getFace() const
 {
-    QPixmap skinTexture;
-    if (!skinTexture.loadFromData(data.minecraftProfile.skin.data, "PNG")) {
-        return QPixmap();
-    }
-    QPixmap skin = QPixmap(8, 8);
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-    skin.fill(QColorConstants::Transparent);
-#else
-    skin.fill(QColor(0, 0, 0, 0));
-#endif
-    QPainter painter(&skin);
-    painter.drawPixmap(0, 0, skinTexture.copy(8, 8, 8, 8));
-    painter.drawPixmap(0, 0, skinTexture.copy(40, 8, 8, 8));
-    return skin.scaled(64, 64, Qt::KeepAspectRatio);
+    return SkinUtils::getFace(data.minecraftProfile.skin.data);
 }
 
 shared_qobject_ptr<AuthFlow> MinecraftAccount::login(bool useDeviceCode)
@@ -204,35 +189,42 @@ bool MinecraftAccount::shouldRefresh() const
 {
     /*
      * Never refresh accounts that are being used by the game, it breaks the game session.
-     * Always refresh accounts that have not been refreshed yet during this session.
-     * Don't refresh broken accounts.
-     * Refresh accounts that would expire in the next 12 hours (fresh token validity is 24 hours).
      */
     if (isInUse()) {
         return false;
     }
+    auto due = refreshDue();
+    return due.isValid() && due <= QDateTime::currentDateTimeUtc();
+}
+
+QDateTime MinecraftAccount::refreshDue() const
+{
+    /*
+     * Always refresh accounts that have not been refreshed yet during this session.
+     * Don't refresh broken accounts.
+     * Refresh accounts that would expire in the next 12 hours (fresh token validity is 24 hours).
+     *
+     * The Minecraft token is the one that runs out first, the Xbox ones are valid for much longer and the MSA one is
+     * renewed from its refresh token anyway.
+     */
     switch (data.validity_) {
         case Validity::Certain: {
             break;
         }
         case Validity::None: {
-            return false;
+            return QDateTime();
         }
         case Validity::Assumed: {
-            return true;
+            return QDateTime::currentDateTimeUtc();
         }
     }
-    auto now = QDateTime::currentDateTimeUtc();
     auto issuedTimestamp = data.yggdrasilToken.issueInstant;
     auto expiresTimestamp = data.yggdrasilToken.notAfter;
 
     if (!expiresTimestamp.isValid()) {
         expiresTimestamp = issuedTimestamp.addSecs(24 * 3600);
     }
-    if (now.secsTo(expiresTimestamp) < (12 * 3600)) {
-        return true;
-    }
-    return false;
+    return expiresTimestamp.addSecs(-12 * 3600);
 }
 
 void MinecraftAccount::fillSession(AuthSessionPtr session)
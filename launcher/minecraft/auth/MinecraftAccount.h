@@ -143,6 +143,8 @@ class MinecraftAccount : public QObject, public Usable {
     AccountData* accountData() { return &data; }
 
     bool shouldRefresh() const;
+    //! when the account should be refreshed next, whether it is in use or not. invalid if it shouldn't be refreshed at all.
+    QDateTime refreshDue() const;
 
     void fillSession(AuthSessionPtr session);
 
@@ -184,6 +184,11 @@ bool parseMinecraftProfile(QByteArray& data, MinecraftProfile& output)
             continue;
         }
         // we deal with only the active skin
+        // the skin didn't change if it's at the same place, don't forget what was downloaded from there
+        if (skinOut.url == output.skin.url) {
+            skinOut.data = output.skin.data;
+            skinOut.etag = output.skin.etag;
+        }
         output.skin = skinOut;
         break;
     }
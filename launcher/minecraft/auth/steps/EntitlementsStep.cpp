@@ -20,6 +20,12 @@ QString EntitlementsStep::describe()
     return tr("Determining game ownership.");
 }
 
+bool EntitlementsStep::canSkip() const
+{
+    // already checked since the launcher started
+    return m_data->minecraftEntitlement.validity == Validity::Certain;
+}
+
 void EntitlementsStep::perform()
 {
     auto uuid = QUuid::createUuid();
@@ -32,6 +38,7 @@ void EntitlementsStep::perform()
 
     m_response.reset(new QByteArray());
     m_task = Net::Download::makeByteArray(url, m_response);
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
     m_task->addHeaderProxy(new Net::StaticHeaderProxy(headers));
 
     connect(m_task.get(), &Task::finished, this, &EntitlementsStep::onRequestDone);
@@ -4,6 +4,8 @@
 #include <QNetworkRequest>
 
 #include "Application.h"
+#include "SkinUtils.h"
+#include "net/StaticHeaderProxy.h"
 
 GetSkinStep::GetSkinStep(AccountData* data) : AuthStep(data) {}
 
@@ -14,10 +16,27 @@ QString GetSkinStep::describe()
 
 void GetSkinStep::perform()
 {
-    QUrl url(m_data->minecraftProfile.skin.url);
+    auto& skin = m_data->minecraftProfile.skin;
+    // textures.minecraft.net names textures after their hash, so one that is known doesn't have to be asked for again
+    if (auto id = SkinUtils::textureId(skin.url); !id.isEmpty()) {
+        if (skin.data.isEmpty()) {
+            skin.data = SkinUtils::cachedTexture(id);
+        }
+        if (!skin.data.isEmpty()) {
+            emit finished(AccountTaskState::STATE_SUCCEEDED, tr("Got skin"));
+            return;
+        }
+    }
+
+    QUrl url(skin.url);
 
     m_response.reset(new QByteArray());
     m_task = Net::Download::makeByteArray(url, m_response);
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
+    // only download the skin again if it changed
+    if (!skin.data.isEmpty() && !skin.etag.isEmpty()) {
+        m_task->addHeaderProxy(new Net::StaticHeaderProxy({ { "If-None-Match", skin.etag.toUtf8() } }));
+    }
 
     connect(m_task.get(), &Task::finished, this, &GetSkinStep::onRequestDone);
 
@@ -27,7 +46,11 @@ void GetSkinStep::perform()
 
 void GetSkinStep::onRequestDone()
 {
-    if (m_task->error() == QNetworkReply::NoError)
-        m_data->minecraftProfile.skin.data = *m_response;
+    auto& skin = m_data->minecraftProfile.skin;
+    if (m_task->error() == QNetworkReply::NoError && m_task->replyStatusCode() != 304) {
+        skin.data = *m_response;
+        skin.etag = QString::fromUtf8(m_task->replyHeader("ETag"));
+        SkinUtils::cacheTexture(SkinUtils::textureId(skin.url), skin.data);
+    }
     emit finished(AccountTaskState::STATE_SUCCEEDED, tr("Got skin"));
 }
@@ -38,6 +38,7 @@ void LauncherLoginStep::perform()
 
     m_response.reset(new QByteArray());
     m_task = Net::Upload::makeByteArray(url, m_response, requestBody.toUtf8());
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
     m_task->addHeaderProxy(new Net::StaticHeaderProxy(headers));
 
     connect(m_task.get(), &Task::finished, this, &LauncherLoginStep::onRequestDone);
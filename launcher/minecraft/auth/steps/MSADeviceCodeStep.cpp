@@ -66,6 +66,7 @@ void MSADeviceCodeStep::perform()
     };
     m_response.reset(new QByteArray());
     m_task = Net::Upload::makeByteArray(url, m_response, payload);
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
     m_task->addHeaderProxy(new Net::StaticHeaderProxy(headers));
 
     connect(m_task.get(), &Task::finished, this, &MSADeviceCodeStep::deviceAutorizationFinished);
@@ -176,6 +177,7 @@ void MSADeviceCodeStep::authenticateUser()
     };
     m_response.reset(new QByteArray());
     m_task = Net::Upload::makeByteArray(url, m_response, payload);
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
     m_task->addHeaderProxy(new Net::StaticHeaderProxy(headers));
 
     connect(m_task.get(), &Task::finished, this, &MSADeviceCodeStep::authenticationFinished);
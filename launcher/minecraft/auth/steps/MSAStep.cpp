@@ -83,6 +83,15 @@ QString MSAStep::describe()
     return tr("Logging in with Microsoft account.");
 }
 
+bool MSAStep::canSkip() const
+{
+    // the Microsoft token is only needed to get a new Xbox user token, and only if the Xbox tokens made from it are running out
+    if (!m_silent || m_data->msaClientID != m_clientId)
+        return false;
+    return m_data->msaToken.isFresh(5 * 60) || m_data->userToken.isFresh(3600) ||
+           (m_data->xboxApiToken.isFresh(3600) && m_data->mojangservicesToken.isFresh(3600));
+}
+
 void MSAStep::perform()
 {
     if (m_silent) {
@@ -48,6 +48,7 @@ class MSAStep : public AuthStep {
     void perform() override;
 
     QString describe() override;
+    bool canSkip() const override;
 
    signals:
     void authorizeWithBrowser(const QUrl& url);
@@ -23,6 +23,7 @@ void MinecraftProfileStep::perform()
 
     m_response.reset(new QByteArray());
     m_task = Net::Download::makeByteArray(url, m_response);
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
     m_task->addHeaderProxy(new Net::StaticHeaderProxy(headers));
 
     connect(m_task.get(), &Task::finished, this, &MinecraftProfileStep::onRequestDone);
@@ -20,6 +20,11 @@ QString XboxAuthorizationStep::describe()
     return tr("Getting authorization to access %1 services.").arg(m_authorizationKind);
 }
 
+bool XboxAuthorizationStep::canSkip() const
+{
+    return m_token->isFresh(3600);
+}
+
 void XboxAuthorizationStep::perform()
 {
     QString xbox_auth_template = R"XXX(
@@ -43,6 +48,7 @@ void XboxAuthorizationStep::perform()
     };
     m_response.reset(new QByteArray());
     m_task = Net::Upload::makeByteArray(url, m_response, xbox_auth_data.toUtf8());
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
     m_task->addHeaderProxy(new Net::StaticHeaderProxy(headers));
 
     connect(m_task.get(), &Task::finished, this, &XboxAuthorizationStep::onRequestDone);
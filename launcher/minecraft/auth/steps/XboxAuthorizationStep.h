@@ -15,6 +15,7 @@ class XboxAuthorizationStep : public AuthStep {
     void perform() override;
 
     QString describe() override;
+    bool canSkip() const override;
 
    private:
     bool processSTSError();
@@ -15,6 +15,13 @@ QString XboxProfileStep::describe()
     return tr("Fetching Xbox profile.");
 }
 
+bool XboxProfileStep::canSkip() const
+{
+    // the profile only goes to the log, so only get it along with a new Xbox API token
+    auto issued = m_data->xboxApiToken.issueInstant;
+    return issued.isValid() && issued.secsTo(QDateTime::currentDateTimeUtc()) > 5 * 60;
+}
+
 void XboxProfileStep::perform()
 {
     QUrl url("https://profile.xboxlive.com/users/me/profile/settings");
@@ -35,6 +42,7 @@ void XboxProfileStep::perform()
 
     m_response.reset(new QByteArray());
     m_task = Net::Download::makeByteArray(url, m_response);
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
     m_task->addHeaderProxy(new Net::StaticHeaderProxy(headers));
 
     connect(m_task.get(), &Task::finished, this, &XboxProfileStep::onRequestDone);
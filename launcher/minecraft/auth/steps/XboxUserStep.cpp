@@ -14,6 +14,11 @@ QString XboxUserStep::describe()
     return tr("Logging in as an Xbox user.");
 }
 
+bool XboxUserStep::canSkip() const
+{
+    return m_data->userToken.isFresh(3600) || (m_data->xboxApiToken.isFresh(3600) && m_data->mojangservicesToken.isFresh(3600));
+}
+
 void XboxUserStep::perform()
 {
     QString xbox_auth_template = R"XXX(
@@ -39,6 +44,7 @@ void XboxUserStep::perform()
     };
     m_response.reset(new QByteArray());
     m_task = Net::Upload::makeByteArray(url, m_response, xbox_auth_data.toUtf8());
+    m_task->setPriority(Net::NetRequest::Priority::Interactive);
     m_task->addHeaderProxy(new Net::StaticHeaderProxy(headers));
 
     connect(m_task.get(), &Task::finished, this, &XboxUserStep::onRequestDone);
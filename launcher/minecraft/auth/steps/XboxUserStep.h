@@ -15,6 +15,7 @@ class XboxUserStep : public AuthStep {
     void perform() override;
 
     QString describe() override;
+    bool canSkip() const override;
 
    private slots:
     void onRequestDone();
@@ -4,37 +4,42 @@
 #include "FileSystem.h"
 
 namespace {
-bool load(const QString& path, std::vector<GameOptionItem>& contents, int& version)
+bool load(const QString& path, QByteArray& contents, std::vector<GameOptionLine>& lines, int& version)
 {
     contents.clear();
+    lines.clear();
     QFile file(path);
     if (!file.open(QFile::ReadOnly)) {
         qWarning() << "Failed to read options file.";
         return false;
     }
+    // modded options files can have thousands of lines, so only find where they are here
+    contents = file.readAll();
     version = 0;
-    while (!file.atEnd()) {
-        auto line = file.readLine();
-        if (line.endsWith('\n')) {
-            line.chop(1);
+    for (int start = 0; start < contents.size();) {
+        int end = contents.indexOf('\n', start);
+        if (end == -1) {
+            end = contents.size();
         }
-        auto separatorIndex = line.indexOf(':');
-        if (separatorIndex == -1) {
+        GameOptionLine line{ start, static_cast<int>(contents.indexOf(':', start)), end };
+        start = end + 1;
+        if (line.separator == -1 || line.separator >= line.end) {
             continue;
         }
-        auto key = QString::fromUtf8(line.data(), separatorIndex);
-        auto value = QString::fromUtf8(line.data() + separatorIndex + 1, line.size() - 1 - separatorIndex);
-        qDebug() << "!!" << key << "!!";
-        if (key == "version") {
-            version = value.toInt();
+        if (contents.mid(line.start, line.separator - line.start) == "version") {
+            version = contents.mid(line.separator + 1, line.end - line.separator - 1).toInt();
             continue;
         }
-        contents.emplace_back(GameOptionItem{ key, value });
+        lines.push_back(line);
     }
     qDebug() << "Loaded" << path << "with version:" << version;
     return true;
 }
-bool save(const QString& path, std::vector<GameOptionItem>& mapping, int version)
+bool save(const QString& path,
+          const QByteArray& contents,
+          const std::vector<GameOptionLine>& lines,
+          const std::map<int, QString>& changedValues,
+          int version)
 {
     QSaveFile out(path);
     if (!out.open(QIODevice::WriteOnly)) {
@@ -44,13 +49,16 @@ bool save(const QString& path, std::vector<GameOptionItem>& mapping, int version
         QString versionLine = QString("version:%1\n").arg(version);
         out.write(versionLine.toUtf8());
     }
-    auto iter = mapping.begin();
-    while (iter != mapping.end()) {
-        out.write(iter->key.toUtf8());
-        out.write(":");
-        out.write(iter->value.toUtf8());
+    for (int row = 0; row < int(lines.size()); row++) {
+        auto& line = lines[row];
+        auto changed = changedValues.find(row);
+        if (changed == changedValues.end()) {
+            out.write(contents.constData() + line.start, line.end - line.start);
+        } else {
+            out.write(contents.constData() + line.start, line.separator + 1 - line.start);
+            out.write(changed->second.toUtf8());
+        }
         out.write("\n");
-        iter++;
     }
     return out.commit();
 }
@@ -84,24 +92,43 @@ QVariant GameOptions::data(const QModelIndex& index, int role) const
     int row = index.row();
     int column = index.column();
 
-    if (row < 0 || row >= int(contents.size()))
+    if (row < 0 || row >= int(lines.size()))
         return QVariant();
 
+    auto& line = lines[row];
     switch (role) {
         case Qt::DisplayRole:
             if (column == 0) {
-                return contents[row].key;
+                return QString::fromUtf8(contents.constData() + line.start, line.separator - line.start);
             } else {
-                return contents[row].value;
+                auto changed = changedValues.find(row);
+                if (changed != changedValues.end()) {
+                    return changed->second;
+                }
+                return QString::fromUtf8(contents.constData() + line.separator + 1, line.end - line.separator - 1);
             }
         default:
             return QVariant();
     }
 }
 
+bool GameOptions::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!index.isValid() || role != Qt::EditRole || index.column() != 1)
+        return false;
+
+    int row = index.row();
+    if (row < 0 || row >= int(lines.size()))
+        return false;
+
+    changedValues[row] = value.toString();
+    emit dataChanged(index, index, { Qt::DisplayRole });
+    return true;
+}
+
 int GameOptions::rowCount(const QModelIndex&) const
 {
-    return static_cast<int>(contents.size());
+    return static_cast<int>(lines.size());
 }
 
 int GameOptions::columnCount(const QModelIndex&) const
@@ -117,12 +144,13 @@ bool GameOptions::isLoaded() const
 bool GameOptions::reload()
 {
     beginResetModel();
-    loaded = load(path, contents, version);
+    changedValues.clear();
+    loaded = load(path, contents, lines, version);
     endResetModel();
     return loaded;
 }
 
 bool GameOptions::save()
 {
-    return ::save(path, contents, version);
+    return ::save(path, contents, lines, changedValues, version);
 }
@@ -4,9 +4,11 @@
 #include <QString>
 #include <map>
 
-struct GameOptionItem {
-    QString key;
-    QString value;
+/* Where an option is in options.txt, it's only turned into strings when it's shown */
+struct GameOptionLine {
+    int start;
+    int separator;
+    int end;
 };
 
 class GameOptions : public QAbstractListModel {
@@ -19,13 +21,17 @@ class GameOptions : public QAbstractListModel {
     int columnCount(const QModelIndex& parent) const override;
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
 
     bool isLoaded() const;
     bool reload();
     bool save();
 
    private:
-    std::vector<GameOptionItem> contents;
+    QByteArray contents;
+    std::vector<GameOptionLine> lines;
+    // row -> new value, only these lines are written out differently
+    std::map<int, QString> changedValues;
     bool loaded = false;
     QString path;
     int version = 0;
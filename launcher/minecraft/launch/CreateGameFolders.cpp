@@ -1,5 +1,8 @@
 #include "CreateGameFolders.h"
+#include "Application.h"
 #include "FileSystem.h"
+#include "InstanceList.h"
+#include "InstanceOverlay.h"
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
 
@@ -16,6 +19,23 @@ void CreateGameFolders::executeTask()
         return;
     }
 
+    // overlays get the files they don't have of their own from the base instance
+    if (auto baseId = instance->overlayBaseId(); !baseId.isEmpty()) {
+        auto base = APPLICATION->instances()->getInstanceById(baseId);
+        if (!base) {
+            emit logLine(QString("Couldn't find the base instance %1 of this overlay").arg(baseId), MessageLevel::Error);
+            emitFailed(tr("Couldn't find the base instance of this overlay"));
+            return;
+        }
+        emit logLine(QString("Linking the files of %1 into the game folder").arg(base->name()), MessageLevel::Launcher);
+        InstanceOverlay overlay(base->gameRoot(), minecraftInstance->gameRoot(), InstanceOverlay::manifestPath(instance->instanceRoot()));
+        if (!overlay.materialize()) {
+            emit logLine(overlay.errorString(), MessageLevel::Error);
+            emitFailed(overlay.errorString());
+            return;
+        }
+    }
+
     // HACK: this is a workaround for MCL-3732 - 'server-resource-packs' folder is created.
     if (!FS::ensureFolderPathExists(FS::PathCombine(minecraftInstance->gameRoot(), "server-resource-packs"))) {
         emit logLine("Couldn't create the 'server-resource-packs' folder", MessageLevel::Error);
@@ -19,7 +19,10 @@
 
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
+#include <QCoreApplication>
+#include <QDebug>
 #include <QDir>
+#include <QFileInfo>
 #include "FileSystem.h"
 #include "MMCZip.h"
 
@@ -76,17 +79,50 @@ void ExtractNatives::executeTask()
         emitSucceeded();
         return;
     }
-    auto settings = minecraftInstance->settings();
 
+    // the directory is named after its contents, so if it's complete it has exactly what we need
     auto outputPath = minecraftInstance->getNativePath();
-    FS::ensureFolderPathExists(outputPath);
-    auto javaVersion = minecraftInstance->getJavaVersion();
-    bool jniHackEnabled = javaVersion.major() >= 8;
+    auto completeMarker = FS::PathCombine(outputPath, ".complete");
+    if (QFileInfo::exists(completeMarker)) {
+        emitSucceeded();
+        return;
+    }
+
+    // extract next to it and move it in place once done, so a failed or concurrent launch never sees half of it
+    auto workPath = outputPath + ".part-" + QString::number(QCoreApplication::applicationPid());
+    QDir(workPath).removeRecursively();
+    FS::ensureFolderPathExists(workPath);
+    bool jniHackEnabled = minecraftInstance->needsJnilibHack();
     for (const auto& source : toExtract) {
-        if (!unzipNatives(source, outputPath, jniHackEnabled)) {
+        if (!unzipNatives(source, workPath, jniHackEnabled)) {
+            QDir(workPath).removeRecursively();
             const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
             emit logLine(QString(reason).arg(source, outputPath), MessageLevel::Fatal);
             emitFailed(tr(reason).arg(source, outputPath));
+            return;
+        }
+    }
+    try {
+        FS::write(FS::PathCombine(workPath, ".complete"), {});
+    } catch (const FS::FileSystemException& e) {
+        // still usable for this launch, it just gets extracted again next time
+        qWarning() << "Couldn't mark natives in" << workPath << "as complete:" << e.cause();
+    }
+
+    if (!QDir().rename(workPath, outputPath)) {
+        if (QFileInfo::exists(completeMarker)) {
+            // someone else got there first, theirs is just as good
+            QDir(workPath).removeRecursively();
+        } else {
+            // left over from a launch that didn't finish extracting
+            QDir(outputPath).removeRecursively();
+            if (!QDir().rename(workPath, outputPath)) {
+                QDir(workPath).removeRecursively();
+                const char* reason = QT_TR_NOOP("Couldn't move extracted natives to destination '%1'");
+                emit logLine(QString(reason).arg(outputPath), MessageLevel::Fatal);
+                emitFailed(tr(reason).arg(outputPath));
+                return;
+            }
         }
     }
     emitSucceeded();
@@ -94,6 +130,7 @@ void ExtractNatives::executeTask()
 
 void ExtractNatives::finalize()
 {
+    // natives used to be extracted into the instance for every launch, clean up after older versions
     auto instance = m_parent->instance();
     QString target_dir = FS::PathCombine(instance->instanceRoot(), "natives/");
     QDir dir(target_dir);
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "GameLogChannel.h"
+
+#include <QRandomGenerator>
+#include <QTcpSocket>
+
+namespace {
+
+// a single peer shouldn't be able to make the launcher buffer without end
+constexpr qsizetype MAX_RECORD_SIZE = 1024 * 1024;
+
+MessageLevel::Enum levelFromName(const QByteArray& name)
+{
+    // log4j levels, upper case
+    if (name == "INFO")
+        return MessageLevel::Message;
+    if (name == "WARN")
+        return MessageLevel::Warning;
+    if (name == "ERROR")
+        return MessageLevel::Error;
+    if (name == "FATAL")
+        return MessageLevel::Fatal;
+    if (name == "DEBUG" || name == "TRACE")
+        return MessageLevel::Debug;
+    // NewLaunch uses the launcher's own names
+    return MessageLevel::getLevel(QString::fromLatin1(name));
+}
+
+QString unescape(const QByteArray& data)
+{
+    QByteArray out;
+    out.reserve(data.size());
+    for (qsizetype i = 0; i < data.size(); i++) {
+        if (data[i] == '\\' && i + 1 < data.size()) {
+            if (data[i + 1] == 'n') {
+                out += '\n';
+                i++;
+                continue;
+            }
+            if (data[i + 1] == 'r') {
+                i++;
+                continue;
+            }
+        }
+        out += data[i];
+    }
+    return QString::fromUtf8(out);
+}
+
+}  // namespace
+
+GameLogChannel::GameLogChannel(QObject* parent) : QObject(parent)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &GameLogChannel::onNewConnection);
+}
+
+bool GameLogChannel::listen()
+{
+    m_token = QByteArray::number(QRandomGenerator::system()->generate64(), 16);
+    return m_server.listen(QHostAddress::LocalHost);
+}
+
+QStringList GameLogChannel::javaArguments() const
+{
+    return { "-Dorg.prismlauncher.log.port=" + QString::number(m_server.serverPort()),
+             "-Dorg.prismlauncher.log.token=" + QString::fromLatin1(m_token) };
+}
+
+QByteArray GameLogChannel::log4jConfiguration()
+{
+    // %enc{...}{CRLF} and %d{UNIX_MILLIS} need at least log4j 2.8
+    return R"(<?xml version="1.0" encoding="UTF-8"?>
+<Configuration status="WARN" packages="">
+    <Appenders>
+        <Socket name="Launcher" host="127.0.0.1" port="${sys:org.prismlauncher.log.port}" protocol="TCP" immediateFlush="true">
+            <PatternLayout pattern="${sys:org.prismlauncher.log.token}&#9;%level&#9;%d{UNIX_MILLIS}&#9;%t&#9;%logger&#9;%enc{%msg{nolookups}%throwable}{CRLF}%n" alwaysWriteExceptions="false" />
+        </Socket>
+        <RollingRandomAccessFile name="File" fileName="logs/latest.log" filePattern="logs/%d{yyyy-MM-dd}-%i.log.gz">
+            <PatternLayout pattern="[%d{HH:mm:ss}] [%t/%level]: %msg{nolookups}%n" />
+            <Policies>
+                <TimeBasedTriggeringPolicy />
+                <OnStartupTriggeringPolicy />
+            </Policies>
+        </RollingRandomAccessFile>
+    </Appenders>
+    <Loggers>
+        <Root level="info">
+            <AppenderRef ref="Launcher" />
+            <AppenderRef ref="File" />
+        </Root>
+    </Loggers>
+</Configuration>
+)";
+}
+
+bool GameLogChannel::parseRecord(const QByteArray& line, const QByteArray& token, Record& record)
+{
+    auto fields = line.split('\t');
+    if (fields.size() < 6 || fields[0] != token)
+        return false;
+
+    record.level = levelFromName(fields[1]);
+    bool ok = false;
+    auto millis = fields[2].toLongLong(&ok);
+    record.time = ok ? QDateTime::fromMSecsSinceEpoch(millis) : QDateTime();
+    record.thread = QString::fromUtf8(fields[3]);
+    record.logger = QString::fromUtf8(fields[4]);
+    // the message may have tabs of its own
+    record.message = unescape(line.mid(fields[0].size() + fields[1].size() + fields[2].size() + fields[3].size() + fields[4].size() + 5));
+    return true;
+}
+
+QStringList GameLogChannel::format(const Record& record)
+{
+    auto lines = record.message.split('\n');
+    while (lines.size() > 1 && lines.last().isEmpty())
+        lines.removeLast();
+
+    // NewLaunch doesn't send a thread, its messages are shown as they are
+    if (!record.thread.isEmpty()) {
+        QString level;
+        switch (record.level) {
+            case MessageLevel::Debug:
+                level = "DEBUG";
+                break;
+            case MessageLevel::Warning:
+                level = "WARN";
+                break;
+            case MessageLevel::Error:
+                level = "ERROR";
+                break;
+            case MessageLevel::Fatal:
+                level = "FATAL";
+                break;
+            default:
+                level = "INFO";
+                break;
+        }
+        lines[0] = QString("[%1] [%2/%3]: %4").arg(record.time.toString("HH:mm:ss"), record.thread, level, lines[0]);
+    }
+    return lines;
+}
+
+void GameLogChannel::onNewConnection()
+{
+    while (auto socket = m_server.nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket] { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void GameLogChannel::onReadyRead(QTcpSocket* socket)
+{
+    auto& buffer = m_buffers[socket];
+    buffer += socket->readAll();
+
+    qsizetype start = 0;
+    for (qsizetype end = buffer.indexOf('\n'); end != -1; end = buffer.indexOf('\n', start)) {
+        auto line = buffer.mid(start, end - start);
+        start = end + 1;
+        if (line.endsWith('\r'))
+            line.chop(1);
+
+        Record record;
+        if (!parseRecord(line, m_token, record)) {
+            // whatever this is, it doesn't come from the game
+            m_buffers.remove(socket);
+            socket->abort();
+            return;
+        }
+        emit log(format(record), record.level);
+    }
+    buffer.remove(0, start);
+
+    if (buffer.size() > MAX_RECORD_SIZE) {
+        m_buffers.remove(socket);
+        socket->abort();
+    }
+}
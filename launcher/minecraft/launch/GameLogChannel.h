@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QTcpServer>
+
+#include "MessageLevel.h"
+
+class QTcpSocket;
+
+/** Receives the game's log records over a local socket, so their level doesn't have to be guessed from the text.
+ *
+ *  Both NewLaunch and the log4j configuration from log4jConfiguration() connect to it. A record is one line:
+ *  `token\tlevel\tmillis\tthread\tlogger\tmessage`, with the line breaks in the message escaped as `\n` and `\r`.
+ *  The token is only known to the game process, so that nothing else on the machine can write into the log.
+ */
+class GameLogChannel : public QObject {
+    Q_OBJECT
+   public:
+    struct Record {
+        MessageLevel::Enum level = MessageLevel::Unknown;
+        QDateTime time;
+        QString thread;
+        QString logger;
+        QString message;
+    };
+
+    explicit GameLogChannel(QObject* parent = nullptr);
+    virtual ~GameLogChannel() = default;
+
+    /** Starts listening on the loopback interface. */
+    bool listen();
+    bool isListening() const { return m_server.isListening(); }
+
+    /** The system properties that have the game connect to the channel. */
+    QStringList javaArguments() const;
+
+    /** A log4j 2 configuration that writes latest.log like the vanilla one does, and sends everything to the channel. */
+    static QByteArray log4jConfiguration();
+
+    /** Parses one record, checking its token. */
+    static bool parseRecord(const QByteArray& line, const QByteArray& token, Record& record);
+
+    /** How the record is shown in the log. */
+    static QStringList format(const Record& record);
+
+   signals:
+    void log(QStringList lines, MessageLevel::Enum level);
+
+   private slots:
+    void onNewConnection();
+    void onReadyRead(QTcpSocket* socket);
+
+   private:
+    QTcpServer m_server;
+    QByteArray m_token;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+};
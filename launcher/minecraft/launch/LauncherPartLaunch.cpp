@@ -35,12 +35,16 @@
 
 #include "LauncherPartLaunch.h"
 
+#include <QDir>
+#include <QFileInfo>
 #include <QRegularExpression>
 #include <QStandardPaths>
 
 #include "Application.h"
 #include "Commandline.h"
 #include "FileSystem.h"
+#include "StringUtils.h"
+#include "Version.h"
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
 
@@ -63,17 +67,54 @@ LauncherPartLaunch::LauncherPartLaunch(LaunchTask* parent) : LaunchStep(parent)
     }
 
     connect(&m_process, &LoggedProcess::log, this, &LauncherPartLaunch::logLines);
+    connect(&m_logChannel, &GameLogChannel::log, this, &LauncherPartLaunch::logLines);
     connect(&m_process, &LoggedProcess::stateChanged, this, &LauncherPartLaunch::on_state);
 }
 
 void LauncherPartLaunch::executeTask()
+{
+    m_executing = true;
+
+    auto minecraftInstance = std::dynamic_pointer_cast<MinecraftInstance>(m_parent->instance());
+    // the session may only have been filled in by now, so the script can't be made any earlier
+    m_launchScript = minecraftInstance->createLaunchScript(m_session, m_serverToJoin);
+
+    auto state = m_process.state();
+    if (state == LoggedProcess::Starting || state == LoggedProcess::Running) {
+        emit logLine(tr("Using the Java process that was started early.\n\n"), MessageLevel::Launcher);
+        if (state == LoggedProcess::Running)
+            sendLaunchScript();
+        return;
+    }
+
+    auto error = startProcess();
+    if (!error.isEmpty()) {
+        emit logLine(error, MessageLevel::Fatal);
+        emitFailed(error);
+    }
+}
+
+void LauncherPartLaunch::prespawn()
+{
+    if (m_executing || m_process.state() != LoggedProcess::NotRunning)
+        return;
+
+    // if it doesn't work now, it's tried (and reported) again when the game is launched
+    if (!startProcess().isEmpty())
+        return;
+
+    // nothing is going to use the process if the launch stops before getting here
+    connect(m_parent, &Task::finished, this, [this] {
+        if (!m_executing)
+            m_process.kill();
+    });
+}
+
+QString LauncherPartLaunch::startProcess()
 {
     QString jarPath = APPLICATION->getJarPath("NewLaunch.jar");
     if (jarPath.isEmpty()) {
-        const char* reason = QT_TR_NOOP("Launcher library could not be found. Please check your installation.");
-        emit logLine(tr(reason), MessageLevel::Fatal);
-        emitFailed(tr(reason));
-        return;
+        return tr("Launcher library could not be found. Please check your installation.");
     }
 
     auto instance = m_parent->instance();
@@ -83,14 +124,10 @@ void LauncherPartLaunch::executeTask()
     if (minecraftInstance->getLauncher() == "legacy" || minecraftInstance->shouldApplyOnlineFixes()) {
         legacyJarPath = APPLICATION->getJarPath("NewLaunchLegacy.jar");
         if (legacyJarPath.isEmpty()) {
-            const char* reason = QT_TR_NOOP("Legacy launcher library could not be found. Please check your installation.");
-            emit logLine(tr(reason), MessageLevel::Fatal);
-            emitFailed(tr(reason));
-            return;
+            return tr("Legacy launcher library could not be found. Please check your installation.");
         }
     }
 
-    m_launchScript = minecraftInstance->createLaunchScript(m_session, m_serverToJoin);
     QStringList args = minecraftInstance->javaArguments();
     QString allArgs = args.join(", ");
     emit logLine("Java Arguments:\n[" + m_parent->censorPrivateInfo(allArgs) + "]\n\n", MessageLevel::Launcher);
@@ -114,9 +151,18 @@ void LauncherPartLaunch::executeTask()
 #endif
     args << "-Djava.library.path=" + natPath;
 
+    if (instance->settings()->get("UseGameLogChannel").toBool()) {
+        args << logChannelArguments(classPath);
+    }
+
+    if (instance->settings()->get("UseClassDataSharing").toBool()) {
+        args << classDataSharingArguments(minecraftInstance.get(), classPath);
+    }
+
     args << "-cp";
 #ifdef Q_OS_WIN
     QStringList processed;
+    processed.reserve(classPath.size());
     for (auto& item : classPath) {
         processed << FS::getPathNameInLocal8bit(item);
     }
@@ -134,10 +180,7 @@ void LauncherPartLaunch::executeTask()
         auto wrapperCommand = wrapperArgs.takeFirst();
         auto realWrapperCommand = QStandardPaths::findExecutable(wrapperCommand);
         if (realWrapperCommand.isEmpty()) {
-            const char* reason = QT_TR_NOOP("The wrapper command \"%1\" couldn't be found.");
-            emit logLine(QString(reason).arg(wrapperCommand), MessageLevel::Fatal);
-            emitFailed(tr(reason).arg(wrapperCommand));
-            return;
+            return tr("The wrapper command \"%1\" couldn't be found.").arg(wrapperCommand);
         }
         emit logLine("Wrapper command is:\n" + wrapperCommandStr + "\n\n", MessageLevel::Launcher);
         args.prepend(javaPath);
@@ -154,10 +197,91 @@ void LauncherPartLaunch::executeTask()
         }
     }
 #endif
+    return {};
+}
+
+QStringList LauncherPartLaunch::classDataSharingArguments(MinecraftInstance* instance, const QStringList& classPath)
+{
+    auto archive = instance->classDataArchivePath(classPath);
+    if (archive.isEmpty()) {
+        emit logLine(tr("Class data sharing needs Java 13 or newer, the classes won't be kept.\n\n"), MessageLevel::Launcher);
+        return {};
+    }
+
+    auto exists = QFileInfo::exists(archive);
+    if (exists) {
+        emit logLine(tr("Reusing the class data archive (%1).\n\n").arg(StringUtils::humanReadableFileSize(QFileInfo(archive).size())),
+                     MessageLevel::Launcher);
+    } else {
+        emit logLine(tr("Recording a class data archive for the next launches.\n\n"), MessageLevel::Launcher);
+    }
+#ifdef Q_OS_WIN
+    archive = FS::getPathNameInLocal8bit(archive);
+#endif
+
+    // Java 19 makes the archive by itself when it's missing or doesn't fit anymore
+    if (instance->getJavaVersion().major() >= 19)
+        return { "-XX:+AutoCreateSharedArchive", "-XX:SharedArchiveFile=" + archive };
+    if (exists)
+        return { "-XX:SharedArchiveFile=" + archive };
+    return { "-XX:ArchiveClassesAtExit=" + archive };
+}
+
+QStringList LauncherPartLaunch::logChannelArguments(const QStringList& classPath)
+{
+    if (!m_logChannel.isListening() && !m_logChannel.listen()) {
+        emit logLine(tr("Couldn't open the log channel, the game's log levels will be guessed.\n\n"), MessageLevel::Warning);
+        return {};
+    }
+    auto args = m_logChannel.javaArguments();
+
+    // the game's own messages only go through the channel with a recent enough log4j
+    static const QRegularExpression log4jCore("^log4j-core-([0-9.]+)\\.jar$");
+    for (auto& entry : classPath) {
+        auto match = log4jCore.match(QFileInfo(entry).fileName());
+        if (!match.hasMatch())
+            continue;
+        if (Version(match.captured(1)) < Version("2.8"))
+            break;
+
+        auto config = QDir("cache").absoluteFilePath(FS::PathCombine("log4j", "prismlauncher-log4j2.xml"));
+        try {
+            auto contents = GameLogChannel::log4jConfiguration();
+            if (!QFileInfo::exists(config) || FS::read(config) != contents)
+                FS::write(config, contents);
+        } catch (const FS::FileSystemException& e) {
+            qWarning() << "Couldn't write the log4j configuration:" << e.cause();
+            break;
+        }
+#ifdef Q_OS_WIN
+        config = FS::getPathNameInLocal8bit(config);
+#endif
+        args << "-Dlog4j.configurationFile=" + config;
+        break;
+    }
+    return args;
 }
 
 void LauncherPartLaunch::on_state(LoggedProcess::State state)
 {
+    if (!m_executing) {
+        // the process was started early, and the game isn't launched yet
+        switch (state) {
+            case LoggedProcess::Running:
+                emit logLine(QString("Started Java early, process ID: %1\n\n").arg(m_process.processId()), MessageLevel::Launcher);
+                break;
+            case LoggedProcess::FailedToStart:
+            case LoggedProcess::Crashed:
+            case LoggedProcess::Finished:
+                emit logLine(tr("The Java process that was started early has stopped, it will be started again to launch the game."),
+                             MessageLevel::Warning);
+                break;
+            default:
+                break;
+        }
+        return;
+    }
+
     switch (state) {
         case LoggedProcess::FailedToStart: {
             //: Error message displayed if instace can't start
@@ -191,20 +315,25 @@ void LauncherPartLaunch::on_state(LoggedProcess::State state)
             break;
         }
         case LoggedProcess::Running:
-            emit logLine(QString("Minecraft process ID: %1\n\n").arg(m_process.processId()), MessageLevel::Launcher);
-            m_parent->setPid(m_process.processId());
-            m_parent->instance()->setLastLaunch();
-            // send the launch script to the launcher part
-            m_process.write(m_launchScript.toUtf8());
-
-            mayProceed = true;
-            emit readyForLaunch();
+            sendLaunchScript();
             break;
         default:
             break;
     }
 }
 
+void LauncherPartLaunch::sendLaunchScript()
+{
+    emit logLine(QString("Minecraft process ID: %1\n\n").arg(m_process.processId()), MessageLevel::Launcher);
+    m_parent->setPid(m_process.processId());
+    m_parent->instance()->setLastLaunch();
+    // send the launch script to the launcher part
+    m_process.write(m_launchScript.toUtf8());
+
+    mayProceed = true;
+    emit readyForLaunch();
+}
+
 void LauncherPartLaunch::setWorkingDirectory(const QString& wd)
 {
     m_process.setWorkingDirectory(wd);
@@ -19,8 +19,11 @@
 #include <launch/LaunchStep.h>
 #include <minecraft/auth/AuthSession.h>
 
+#include "GameLogChannel.h"
 #include "MinecraftServerTarget.h"
 
+class MinecraftInstance;
+
 class LauncherPartLaunch : public LaunchStep {
     Q_OBJECT
    public:
@@ -31,20 +34,36 @@ class LauncherPartLaunch : public LaunchStep {
     virtual bool abort();
     virtual void proceed();
     virtual bool canAbort() const { return true; }
+    bool startsGame() const override { return true; }
     void setWorkingDirectory(const QString& wd);
     void setAuthSession(AuthSessionPtr session) { m_session = session; }
 
     void setServerToJoin(MinecraftServerTargetPtr serverToJoin) { m_serverToJoin = std::move(serverToJoin); }
 
+    /** Starts Java ahead of time, so it's already up by the time this step runs and the game can start right away.
+     *
+     *  The process waits for the launch script, which is only sent once the step runs.
+     */
+    void prespawn();
+
    private slots:
     void on_state(LoggedProcess::State state);
 
+   private:
+    /** Starts the process. Returns why it couldn't be started, or an empty string. */
+    QString startProcess();
+    void sendLaunchScript();
+    QStringList logChannelArguments(const QStringList& classPath);
+    QStringList classDataSharingArguments(MinecraftInstance* instance, const QStringList& classPath);
+
    private:
     LoggedProcess m_process;
+    GameLogChannel m_logChannel;
     QString m_command;
     AuthSessionPtr m_session;
     QString m_launchScript;
     MinecraftServerTargetPtr m_serverToJoin;
 
     bool mayProceed = false;
+    bool m_executing = false;
 };
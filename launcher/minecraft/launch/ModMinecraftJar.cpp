@@ -34,56 +34,126 @@
  */
 
 #include "ModMinecraftJar.h"
+#include <QCryptographicHash>
+#include <QDebug>
+#include "Application.h"
 #include "FileSystem.h"
 #include "MMCZip.h"
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
+#include "modplatform/helpers/HashCache.h"
+
+namespace {
+// bump this when createModdedJar changes what it puts in the jar
+constexpr auto MODDED_JAR_VERSION = "1";
+
+QString fileHash(const QString& path)
+{
+    auto cache = APPLICATION->hashCache();
+    auto identity = Hashing::FileIdentity::of(path);
+    auto hash = cache ? cache->lookup(path, identity, "sha1") : QString();
+    if (hash.isEmpty()) {
+        QFile file(path);
+        QCryptographicHash content(QCryptographicHash::Sha1);
+        if (!file.open(QIODevice::ReadOnly) || !content.addData(&file))
+            return {};
+        hash = QString::fromLatin1(content.result().toHex());
+        if (cache)
+            cache->insert(path, identity, "sha1", hash);
+    }
+    return hash;
+}
+
+/* What the modded jar is built from: the vanilla jar and the jar mods, in order. Empty if that can't be told. */
+QByteArray moddedJarKey(const QString& sourceJarPath, const QList<Mod*>& jarMods)
+{
+    QCryptographicHash key(QCryptographicHash::Sha1);
+    key.addData(MODDED_JAR_VERSION);
+    auto sourceHash = fileHash(sourceJarPath);
+    if (sourceHash.isEmpty())
+        return {};
+    key.addData(sourceHash.toLatin1());
+    for (auto* mod : jarMods) {
+        key.addData(mod->enabled() ? "\n+" : "\n-");
+        if (!mod->enabled())
+            continue;
+        // folders would have to be hashed file by file, they are rare enough to just be rebuilt every time
+        if (mod->type() != ResourceType::ZIPFILE && mod->type() != ResourceType::SINGLEFILE)
+            return {};
+        auto hash = fileHash(mod->fileinfo().absoluteFilePath());
+        if (hash.isEmpty())
+            return {};
+        key.addData(hash.toLatin1());
+        if (mod->type() == ResourceType::SINGLEFILE)
+            key.addData(mod->fileinfo().fileName().toUtf8());
+    }
+    return key.result().toHex();
+}
+}  // namespace
 
 void ModMinecraftJar::executeTask()
 {
     auto m_inst = std::dynamic_pointer_cast<MinecraftInstance>(m_parent->instance());
 
     if (!m_inst->getJarMods().size()) {
+        // a jar left over from when there were jar mods
+        removeJar();
         emitSucceeded();
         return;
     }
-    // nuke obsolete stripped jar(s) if needed
     if (!FS::ensureFolderPathExists(m_inst->binRoot())) {
         emitFailed(tr("Couldn't create the bin folder for Minecraft.jar"));
+        return;
     }
 
+    // the modded jar is kept between launches, and only built again when what goes into it changes
     auto finalJarPath = QDir(m_inst->binRoot()).absoluteFilePath("minecraft.jar");
-    if (!removeJar()) {
-        emitFailed(tr("Couldn't remove stale jar file: %1").arg(finalJarPath));
-    }
-
-    // create temporary modded jar, if needed
     auto components = m_inst->getPackProfile();
     auto profile = components->getProfile();
     auto jarMods = m_inst->getJarMods();
-    if (jarMods.size()) {
-        auto mainJar = profile->getMainJar();
-        QStringList jars, temp1, temp2, temp3, temp4;
-        mainJar->getApplicableFiles(m_inst->runtimeContext(), jars, temp1, temp2, temp3, m_inst->getLocalLibraryPath());
-        auto sourceJarPath = jars[0];
-        if (!MMCZip::createModdedJar(sourceJarPath, finalJarPath, jarMods)) {
-            emitFailed(tr("Failed to create the custom Minecraft jar file."));
-            return;
+    auto mainJar = profile->getMainJar();
+    QStringList jars, temp1, temp2, temp3, temp4;
+    mainJar->getApplicableFiles(m_inst->runtimeContext(), jars, temp1, temp2, temp3, m_inst->getLocalLibraryPath());
+    auto sourceJarPath = jars[0];
+
+    auto key = moddedJarKey(sourceJarPath, jarMods);
+    if (!key.isEmpty() && QFileInfo::exists(finalJarPath) && FS::read(keyPath()) == key) {
+        emit logLine(tr("Using the modded Minecraft jar from the last launch"), MessageLevel::Launcher);
+        emitSucceeded();
+        return;
+    }
+
+    if (!removeJar()) {
+        emitFailed(tr("Couldn't remove stale jar file: %1").arg(finalJarPath));
+        return;
+    }
+    if (!MMCZip::createModdedJar(sourceJarPath, finalJarPath, jarMods)) {
+        emitFailed(tr("Failed to create the custom Minecraft jar file."));
+        return;
+    }
+    if (!key.isEmpty()) {
+        try {
+            FS::write(keyPath(), key);
+        } catch (const FS::FileSystemException& e) {
+            qWarning() << "Couldn't remember what the modded jar was built from:" << e.cause();
         }
     }
     emitSucceeded();
 }
 
-void ModMinecraftJar::finalize()
+QString ModMinecraftJar::keyPath() const
 {
-    removeJar();
+    auto m_inst = std::dynamic_pointer_cast<MinecraftInstance>(m_parent->instance());
+    return QDir(m_inst->binRoot()).absoluteFilePath("minecraft.jar.key");
 }
 
 bool ModMinecraftJar::removeJar()
 {
     auto m_inst = std::dynamic_pointer_cast<MinecraftInstance>(m_parent->instance());
     auto finalJarPath = QDir(m_inst->binRoot()).absoluteFilePath("minecraft.jar");
+    // the key goes first, so a jar that couldn't be removed is never taken for an up to date one
+    QFile::remove(keyPath());
     QFile finalJar(finalJarPath);
     if (finalJar.exists()) {
         if (!finalJar.remove()) {
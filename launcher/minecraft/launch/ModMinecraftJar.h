@@ -26,8 +26,8 @@ class ModMinecraftJar : public LaunchStep {
 
     virtual void executeTask() override;
     virtual bool canAbort() const override { return false; }
-    void finalize() override;
 
    private:
     bool removeJar();
+    QString keyPath() const;
 };
@@ -16,6 +16,7 @@
 #include <fstream>
 #include <string>
 
+#include <cpufeatures.h>
 #include <launch/LaunchTask.h>
 #include "PrintInstanceInfo.h"
 
@@ -127,6 +128,7 @@ void PrintInstanceInfo::executeTask()
     ::runPciconf(log);
     ::runGlxinfo(log);
 #endif
+    log << "CPU features: " + Sys::getCpuFeatures().names().join(' ');
 
     logLines(log, MessageLevel::Launcher);
     logLines(instance->verboseDescription(m_session, m_serverToJoin), MessageLevel::Launcher);
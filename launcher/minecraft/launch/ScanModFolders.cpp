@@ -44,21 +44,22 @@ void ScanModFolders::executeTask()
 {
     auto m_inst = std::dynamic_pointer_cast<MinecraftInstance>(m_parent->instance());
 
+    // Lists that are open somewhere are already watched, so there's nothing to scan if nothing changed since their last update
     auto loaders = m_inst->loaderModList();
     connect(loaders.get(), &ModFolderModel::updateFinished, this, &ScanModFolders::modsDone);
-    if (!loaders->update()) {
+    if (loaders->isUpToDate() || (!loaders->update() && !loaders->isUpdating())) {
         m_modsDone = true;
     }
 
     auto cores = m_inst->coreModList();
     connect(cores.get(), &ModFolderModel::updateFinished, this, &ScanModFolders::coreModsDone);
-    if (!cores->update()) {
+    if (cores->isUpToDate() || (!cores->update() && !cores->isUpdating())) {
         m_coreModsDone = true;
     }
 
     auto nils = m_inst->nilModList();
     connect(nils.get(), &ModFolderModel::updateFinished, this, &ScanModFolders::nilModsDone);
-    if (!nils->update()) {
+    if (nils->isUpToDate() || (!nils->update() && !nils->isUpdating())) {
         m_nilModsDone = true;
     }
     checkDone();
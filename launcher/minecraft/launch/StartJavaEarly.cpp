@@ -0,0 +1,13 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "StartJavaEarly.h"
+
+StartJavaEarly::StartJavaEarly(LaunchTask* parent, shared_qobject_ptr<LauncherPartLaunch> launch) : LaunchStep(parent), m_launch(launch) {}
+
+void StartJavaEarly::executeTask()
+{
+    m_launch->prespawn();
+    emitSucceeded();
+}
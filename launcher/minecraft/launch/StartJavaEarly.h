@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <launch/LaunchStep.h>
+
+#include "LauncherPartLaunch.h"
+
+/** Has the launch step start Java as soon as its arguments are known, while the rest of the game is still being
+ *  prepared. Doesn't wait for anything itself.
+ */
+class StartJavaEarly : public LaunchStep {
+    Q_OBJECT
+   public:
+    explicit StartJavaEarly(LaunchTask* parent, shared_qobject_ptr<LauncherPartLaunch> launch);
+    virtual ~StartJavaEarly() = default;
+
+    void executeTask() override;
+    bool canAbort() const override { return false; }
+
+   private:
+    shared_qobject_ptr<LauncherPartLaunch> m_launch;
+};
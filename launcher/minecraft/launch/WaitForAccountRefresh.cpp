@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "WaitForAccountRefresh.h"
+
+#include <launch/LaunchTask.h>
+#include "minecraft/MinecraftInstance.h"
+
+WaitForAccountRefresh::WaitForAccountRefresh(LaunchTask* parent, MinecraftAccountPtr account, AuthSessionPtr session)
+    : LaunchStep(parent), m_account(account), m_session(session)
+{}
+
+void WaitForAccountRefresh::executeTask()
+{
+    auto task = m_account->currentTask();
+    if (task && task->isRunning()) {
+        emit logLine(tr("Waiting for the account refresh to finish..."), MessageLevel::Launcher);
+        connect(task.get(), &Task::finished, this, &WaitForAccountRefresh::refreshFinished);
+        return;
+    }
+    refreshFinished();
+}
+
+void WaitForAccountRefresh::refreshFinished()
+{
+    if (!isRunning())
+        return;
+
+    if (m_account->accountState() != AccountState::Online || !m_account->ownsMinecraft() || !m_account->hasProfile()) {
+        auto reason = tr("Couldn't refresh the account, so the game can't be launched online. "
+                         "Check the account in the account manager, or launch the game in offline mode.");
+        emit logLine(reason, MessageLevel::Fatal);
+        emitFailed(reason);
+        return;
+    }
+
+    m_account->fillSession(m_session);
+    // the log was only censored for the old tokens until now
+    if (auto instance = std::dynamic_pointer_cast<MinecraftInstance>(m_parent->instance()))
+        m_parent->addCensorFilter(instance->createCensorFilterFromSession(m_session));
+    emitSucceeded();
+}
+
+bool WaitForAccountRefresh::abort()
+{
+    // the refresh itself goes on, the account still needs it
+    emitAborted();
+    return true;
+}
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <launch/LaunchStep.h>
+#include <minecraft/auth/MinecraftAccount.h>
+
+/** Waits for an account refresh that was started along with the launch, right before the game needs the session.
+ *
+ *  The launch is prepared with what the account had from its last refresh, and the session is filled in again with
+ *  the fresh tokens once the refresh is done. If the refresh fails, so does the launch.
+ */
+class WaitForAccountRefresh : public LaunchStep {
+    Q_OBJECT
+   public:
+    explicit WaitForAccountRefresh(LaunchTask* parent, MinecraftAccountPtr account, AuthSessionPtr session);
+    virtual ~WaitForAccountRefresh() = default;
+
+    void executeTask() override;
+    bool canAbort() const override { return true; }
+    bool abort() override;
+
+   private slots:
+    void refreshFinished();
+
+   private:
+    MinecraftAccountPtr m_account;
+    AuthSessionPtr m_session;
+};
@@ -32,6 +32,7 @@ class Metadata {
    public:
     using ModStruct = Packwiz::V1::Mod;
     using ModSide = Packwiz::V1::Side;
+    using Batch = Packwiz::IndexBatch;
 
     static auto create(QDir& index_dir, ModPlatform::IndexedPack& mod_pack, ModPlatform::IndexedVersion& mod_version) -> ModStruct
     {
@@ -58,6 +58,7 @@ Mod::Mod(const QDir& mods_dir, const Metadata::ModStruct& metadata) : Mod(mods_d
 {
     m_name = metadata.name;
     m_local_details.metadata = std::make_shared<Metadata::ModStruct>(std::move(metadata));
+    invalidateSortKeys();
 }
 
 void Mod::setStatus(ModStatus status)
@@ -70,11 +71,26 @@ void Mod::setMetadata(std::shared_ptr<Metadata::ModStruct>&& metadata)
         setStatus(ModStatus::Installed);
 
     m_local_details.metadata = metadata;
+    invalidateSortKeys();
 }
 
 void Mod::setDetails(const ModDetails& details)
 {
     m_local_details = details;
+    invalidateSortKeys();
+}
+
+void Mod::invalidateSortKeys()
+{
+    Resource::invalidateSortKeys();
+    m_sort_version.reset();
+}
+
+const Version& Mod::sortVersion() const
+{
+    if (!m_sort_version)
+        m_sort_version = Version(version());
+    return *m_sort_version;
 }
 
 std::pair<int, bool> Mod::compare(const Resource& other, SortType type) const
@@ -94,8 +110,8 @@ std::pair<int, bool> Mod::compare(const Resource& other, SortType type) const
             break;
         }
         case SortType::VERSION: {
-            auto this_ver = Version(version());
-            auto other_ver = Version(cast_other->version());
+            auto& this_ver = sortVersion();
+            auto& other_ver = cast_other->sortVersion();
             if (this_ver > other_ver)
                 return { 1, type == SortType::VERSION };
             if (this_ver < other_ver)
@@ -147,6 +163,7 @@ void Mod::destroyMetadata(QDir& index_dir)
         Metadata::remove(index_dir, n);
     }
     m_local_details.metadata = nullptr;
+    invalidateSortKeys();
 }
 
 auto Mod::details() const -> const ModDetails&
@@ -218,6 +235,7 @@ void Mod::finishResolvingWithDetails(ModDetails&& details)
         details.status = m_local_details.status;
 
     m_local_details = std::move(details);
+    invalidateSortKeys();
     if (metadata)
         setMetadata(std::move(metadata));
     if (!iconPath().isEmpty()) {
@@ -255,7 +273,7 @@ void Mod::setIcon(QImage new_image) const
     auto pixmap =
         QPixmap::fromImage(new_image.scaled({ 64, 64 }, Qt::AspectRatioMode::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
 
-    m_pack_image_cache_key.key = PixmapCache::insert(pixmap);
+    m_pack_image_cache_key.key = PixmapCache::insert(PixmapCache::Consumer::Mods, pixmap);
     m_pack_image_cache_key.was_ever_used = true;
     m_pack_image_cache_key.was_read_attempt = true;
 }
@@ -275,7 +293,6 @@ QPixmap Mod::icon(QSize size, Qt::AspectRatioMode mode) const
 
     if (m_pack_image_cache_key.was_ever_used) {
         qDebug() << "Mod" << name() << "Had it's icon evicted from the cache. reloading...";
-        PixmapCache::markCacheMissByEviciton();
     }
     // Image got evicted from the cache or an attempt to load it has not been made. load it and retry.
     m_pack_image_cache_key.was_read_attempt = true;
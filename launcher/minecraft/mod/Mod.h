@@ -41,12 +41,13 @@
 #include <QList>
 #include <QMutex>
 #include <QPixmap>
-#include <QPixmapCache>
 
 #include <optional>
 
+#include "MTPixmapCache.h"
 #include "ModDetails.h"
 #include "Resource.h"
+#include "Version.h"
 
 class Mod : public Resource {
     Q_OBJECT
@@ -99,13 +100,20 @@ class Mod : public Resource {
     void finishResolvingWithDetails(ModDetails&& details);
 
    protected:
+    void invalidateSortKeys() override;
+    /* version(), parsed for sorting by it. */
+    [[nodiscard]] const Version& sortVersion() const;
+
     ModDetails m_local_details;
 
     mutable QMutex m_data_lock;
 
     struct {
-        QPixmapCache::Key key;
+        PixmapCache::Key key;
         bool was_ever_used = false;
         bool was_read_attempt = false;
     } mutable m_pack_image_cache_key;
+
+   private:
+    mutable std::optional<Version> m_sort_version;
 };
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ModDetailsCache.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+namespace {
+constexpr quint32 DETAILS_CACHE_MAGIC = 0x504C4D44;  // "PLMD"
+// Bump this whenever the mod parsers change what they extract, so stale details get parsed again
+constexpr quint32 DETAILS_CACHE_VERSION = 1;
+}  // namespace
+
+static QDataStream& operator<<(QDataStream& out, const ModLicense& license)
+{
+    return out << license.name << license.id << license.url << license.description;
+}
+
+static QDataStream& operator>>(QDataStream& in, ModLicense& license)
+{
+    return in >> license.name >> license.id >> license.url >> license.description;
+}
+
+static QDataStream& operator<<(QDataStream& out, const ModDetails& details)
+{
+    out << details.mod_id << details.name << details.version << details.mcversion << details.homeurl << details.description
+        << details.authors << details.issue_tracker << details.icon_file;
+
+    out << static_cast<quint32>(details.licenses.size());
+    for (auto& license : details.licenses)
+        out << license;
+    return out;
+}
+
+static QDataStream& operator>>(QDataStream& in, ModDetails& details)
+{
+    in >> details.mod_id >> details.name >> details.version >> details.mcversion >> details.homeurl >> details.description >>
+        details.authors >> details.issue_tracker >> details.icon_file;
+
+    quint32 license_count;
+    in >> license_count;
+    details.licenses.clear();
+    for (quint32 i = 0; i < license_count && in.status() == QDataStream::Ok; i++) {
+        ModLicense license;
+        in >> license;
+        details.licenses.append(license);
+    }
+    return in;
+}
+
+ModDetailsCache::ModDetailsCache(QString cache_file) : m_cache_file(std::move(cache_file)) {}
+
+std::optional<ModDetails> ModDetailsCache::lookup(const QString& file_name, const Hashing::FileIdentity& identity)
+{
+    if (!identity.isValid())
+        return {};
+
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    auto it = m_entries.constFind(file_name);
+    if (it == m_entries.constEnd() || it->identity != identity)
+        return {};
+    return it->details;
+}
+
+void ModDetailsCache::insert(const QString& file_name, const Hashing::FileIdentity& identity, const ModDetails& details)
+{
+    if (!identity.isValid())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    auto& entry = m_entries[file_name];
+    entry.identity = identity;
+    entry.details = details;
+    // The status depends on the metadata, not on the file
+    entry.details.status = ModStatus::Unknown;
+    m_dirty = true;
+}
+
+void ModDetailsCache::retain(const QSet<QString>& file_names)
+{
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (file_names.contains(it.key())) {
+            it++;
+        } else {
+            it = m_entries.erase(it);
+            m_dirty = true;
+        }
+    }
+}
+
+void ModDetailsCache::ensureLoaded()
+{
+    if (m_loaded)
+        return;
+    m_loaded = true;
+
+    QFile file(m_cache_file);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic, version, count;
+    in >> magic >> version >> count;
+    if (in.status() != QDataStream::Ok || magic != DETAILS_CACHE_MAGIC || version != DETAILS_CACHE_VERSION)
+        return;
+
+    QHash<QString, Entry> entries;
+    for (quint32 i = 0; i < count; i++) {
+        QString file_name;
+        Entry entry;
+        in >> file_name >> entry.identity.size >> entry.identity.mtime >> entry.identity.inode >> entry.details;
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "Mod details cache is corrupted, parsing everything again:" << m_cache_file;
+            return;
+        }
+        entries.insert(file_name, entry);
+    }
+
+    m_entries = entries;
+}
+
+void ModDetailsCache::save()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_dirty)
+        return;
+
+    QDir().mkpath(QFileInfo(m_cache_file).absolutePath());
+
+    QSaveFile file(m_cache_file);
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << "Failed to save mod details cache:" << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+
+    out << DETAILS_CACHE_MAGIC << DETAILS_CACHE_VERSION << static_cast<quint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); it++) {
+        const auto& entry = it.value();
+        out << it.key() << entry.identity.size << entry.identity.mtime << entry.identity.inode << entry.details;
+    }
+
+    if (file.commit())
+        m_dirty = false;
+    else
+        qWarning() << "Failed to save mod details cache:" << file.errorString();
+}
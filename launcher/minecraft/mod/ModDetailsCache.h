@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+#include <optional>
+
+#include "minecraft/mod/ModDetails.h"
+#include "modplatform/helpers/HashCache.h"
+
+/** Persistent cache of the details parsed out of mod files, so unchanged jars don't have to be opened again.
+ *
+ *  Entries are keyed by file name, and only used while the file still has the identity it had when parsed.
+ *  Metadata and status are not cached, since they don't come from the file itself.
+ *  Thread-safe, since folder loading happens on worker threads.
+ */
+class ModDetailsCache {
+   public:
+    explicit ModDetailsCache(QString cache_file);
+
+    std::optional<ModDetails> lookup(const QString& file_name, const Hashing::FileIdentity& identity);
+    void insert(const QString& file_name, const Hashing::FileIdentity& identity, const ModDetails& details);
+
+    /* Drops the entries of files that aren't in the folder anymore. */
+    void retain(const QSet<QString>& file_names);
+
+    /* Writes the cache to disk, if it changed since the last save. */
+    void save();
+
+   private:
+    struct Entry {
+        Hashing::FileIdentity identity;
+        ModDetails details;
+    };
+
+    void ensureLoaded();
+
+    QString m_cache_file;
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    bool m_loaded = false;
+    bool m_dirty = false;
+};
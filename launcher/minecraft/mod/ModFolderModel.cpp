@@ -68,6 +68,15 @@ ModFolderModel::ModFolderModel(const QString& dir, BaseInstance* instance, bool
     m_column_resize_modes = { QHeaderView::Interactive, QHeaderView::Interactive, QHeaderView::Stretch,
                               QHeaderView::Interactive, QHeaderView::Interactive, QHeaderView::Interactive };
     m_columnsHideable = { false, true, false, true, true, true };
+
+    // Kept next to the metadata, so folders we aren't allowed to manage don't get extra files in them
+    if (m_is_indexed) {
+        m_details_cache = std::make_shared<ModDetailsCache>(indexDir().absoluteFilePath(".details.cache"));
+        connect(this, &ResourceFolderModel::parseFinished, this, [this] {
+            if (!hasPendingParseTasks())
+                m_details_cache->save();
+        });
+    }
 }
 
 QVariant ModFolderModel::data(const QModelIndex& index, int role) const
@@ -111,20 +120,20 @@ QVariant ModFolderModel::data(const QModelIndex& index, int role) const
 
         case Qt::ToolTipRole:
             if (column == NAME_COLUMN) {
-                if (at(row)->isSymLinkUnder(instDirPath())) {
+                if (at(row)->linkState(instDirPath()) == Resource::LinkState::SymLinked) {
                     return m_resources[row]->internal_id() +
                            tr("\nWarning: This resource is symbolically linked from elsewhere. Editing it will also change the original."
                               "\nCanonical Path: %1")
                                .arg(at(row)->fileinfo().canonicalFilePath());
                 }
-                if (at(row)->isMoreThanOneHardLink()) {
+                if (at(row)->linkState(instDirPath()) == Resource::LinkState::HardLinked) {
                     return m_resources[row]->internal_id() +
                            tr("\nWarning: This resource is hard linked elsewhere. Editing it will also change the original.");
                 }
             }
             return m_resources[row]->internal_id();
         case Qt::DecorationRole: {
-            if (column == NAME_COLUMN && (at(row)->isSymLinkUnder(instDirPath()) || at(row)->isMoreThanOneHardLink()))
+            if (column == NAME_COLUMN && at(row)->linkState(instDirPath()) != Resource::LinkState::None)
                 return APPLICATION->getThemedIcon("status-yellow");
             if (column == ImageColumn) {
                 return at(row)->icon({ 32, 32 }, Qt::AspectRatioMode::KeepAspectRatioByExpanding);
@@ -193,7 +202,7 @@ int ModFolderModel::columnCount(const QModelIndex& parent) const
 Task* ModFolderModel::createUpdateTask()
 {
     auto index_dir = indexDir();
-    auto task = new ModFolderLoadTask(dir(), index_dir, m_is_indexed, m_first_folder_load);
+    auto task = new ModFolderLoadTask(dir(), index_dir, m_is_indexed, m_first_folder_load, m_details_cache, m_last_snapshot);
     m_first_folder_load = false;
     return task;
 }
@@ -224,16 +233,20 @@ bool ModFolderModel::deleteMods(const QModelIndexList& indexes)
     if (indexes.isEmpty())
         return true;
 
+    QList<Resource::Ptr> deleted;
     for (auto i : indexes) {
         if (i.column() != 0) {
             continue;
         }
-        auto m = at(i.row());
-        auto index_dir = indexDir();
-        m->destroy(index_dir);
+        deleted.append(m_resources.at(i.row()));
     }
 
-    update();
+    runBatch(
+        [deleted, index_dir = indexDir()]() mutable {
+            for (auto& resource : deleted)
+                static_cast<Mod*>(resource.get())->destroy(index_dir);
+        },
+        [this, deleted] { removeDeleted(deleted); });
 
     return true;
 }
@@ -313,8 +326,14 @@ void ModFolderModel::onUpdateSucceeded()
     QSet<QString> current_set(m_resources_index.keys().toSet());
     QSet<QString> new_set(new_mods.keys().toSet());
 #endif
+    new_set.unite(update_results->unchanged);
 
     applyUpdates(current_set, new_set, new_mods);
+    m_last_snapshot = update_results->snapshot;
+
+    // Persist the removal of entries for mods that are gone, even if nothing needs parsing
+    if (m_details_cache && !hasPendingParseTasks())
+        m_details_cache->save();
 }
 
 void ModFolderModel::onParseSucceeded(int ticket, QString mod_id)
@@ -333,8 +352,11 @@ void ModFolderModel::onParseSucceeded(int ticket, QString mod_id)
     auto resource = find(mod_id);
 
     auto result = cast_task->result();
-    if (result && resource)
+    if (result && resource) {
+        if (m_details_cache && (resource->type() == ResourceType::ZIPFILE || resource->type() == ResourceType::LITEMOD))
+            m_details_cache->insert(resource->fileinfo().fileName(), result->identity, result->details);
         resource->finishResolvingWithDetails(std::move(result->details));
+    }
 
     emit dataChanged(index(row), index(row, columnCount(QModelIndex()) - 1));
 }
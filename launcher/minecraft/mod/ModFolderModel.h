@@ -102,4 +102,6 @@ class ModFolderModel : public ResourceFolderModel {
    protected:
     bool m_is_indexed;
     bool m_first_folder_load = true;
+    std::shared_ptr<ModDetailsCache> m_details_cache;
+    ModFolderLoadTask::SnapshotPtr m_last_snapshot;
 };
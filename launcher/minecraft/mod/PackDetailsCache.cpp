@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "PackDetailsCache.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include "FileSystem.h"
+
+namespace {
+constexpr quint32 DETAILS_CACHE_MAGIC = 0x504C5044;  // "PLPD"
+// Bump this whenever the pack parsers change what they extract, so stale details get parsed again
+constexpr quint32 DETAILS_CACHE_VERSION = 1;
+
+// The size icons are kept at in memory and on disk. Views draw them at most this big.
+constexpr int ICON_SIZE = 64;
+
+QString hashOf(const QByteArray& data)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+}
+}  // namespace
+
+static QDataStream& operator<<(QDataStream& out, const PackDetailsCache::Details& details)
+{
+    return out << static_cast<qint32>(details.pack_format) << details.description << details.has_image;
+}
+
+static QDataStream& operator>>(QDataStream& in, PackDetailsCache::Details& details)
+{
+    qint32 pack_format;
+    in >> pack_format >> details.description >> details.has_image;
+    details.pack_format = pack_format;
+    return in;
+}
+
+PackDetailsCache::PackDetailsCache(QString cache_file) : m_cache_file(std::move(cache_file)) {}
+
+QString PackDetailsCache::locationFor(const QDir& dir)
+{
+    return FS::PathCombine("cache", "details", hashOf(dir.absolutePath().toUtf8()) + ".cache");
+}
+
+std::optional<PackDetailsCache::Details> PackDetailsCache::lookup(const QString& file_name, const Hashing::FileIdentity& identity)
+{
+    if (!identity.isValid())
+        return {};
+
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    auto it = m_entries.constFind(file_name);
+    if (it == m_entries.constEnd() || it->identity != identity)
+        return {};
+    return it->details;
+}
+
+void PackDetailsCache::insert(const QString& file_name, const Hashing::FileIdentity& identity, const Details& details)
+{
+    if (!identity.isValid())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    m_entries.insert(file_name, { identity, details });
+    m_dirty = true;
+}
+
+void PackDetailsCache::retain(const QSet<QString>& file_names)
+{
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (file_names.contains(it.key())) {
+            it++;
+        } else {
+            it = m_entries.erase(it);
+            m_dirty = true;
+        }
+    }
+}
+
+void PackDetailsCache::ensureLoaded()
+{
+    if (m_loaded)
+        return;
+    m_loaded = true;
+
+    QFile file(m_cache_file);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic, version, count;
+    in >> magic >> version >> count;
+    if (in.status() != QDataStream::Ok || magic != DETAILS_CACHE_MAGIC || version != DETAILS_CACHE_VERSION)
+        return;
+
+    QHash<QString, Entry> entries;
+    for (quint32 i = 0; i < count; i++) {
+        QString file_name;
+        Entry entry;
+        in >> file_name >> entry.identity.size >> entry.identity.mtime >> entry.identity.inode >> entry.details;
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "Pack details cache is corrupted, parsing everything again:" << m_cache_file;
+            return;
+        }
+        entries.insert(file_name, entry);
+    }
+
+    m_entries = entries;
+}
+
+void PackDetailsCache::save()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_dirty)
+        return;
+
+    if (!FS::ensureFilePathExists(m_cache_file)) {
+        qWarning() << "Failed to create the folder of the pack details cache:" << m_cache_file;
+        return;
+    }
+
+    QSaveFile file(m_cache_file);
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << "Failed to save pack details cache:" << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+
+    out << DETAILS_CACHE_MAGIC << DETAILS_CACHE_VERSION << static_cast<quint32>(m_entries.size());
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); it++) {
+        const auto& entry = it.value();
+        out << it.key() << entry.identity.size << entry.identity.mtime << entry.identity.inode << entry.details;
+    }
+
+    if (file.commit())
+        m_dirty = false;
+    else
+        qWarning() << "Failed to save pack details cache:" << file.errorString();
+}
+
+QImage PackDetailsCache::decodeIcon(QByteArray& data)
+{
+    QBuffer buffer(&data);
+    QImageReader reader(&buffer);
+
+    auto full_size = reader.size();
+    if (full_size.isValid() && (full_size.width() > ICON_SIZE || full_size.height() > ICON_SIZE))
+        reader.setScaledSize(full_size.scaled(ICON_SIZE, ICON_SIZE, Qt::AspectRatioMode::KeepAspectRatioByExpanding));
+
+    return reader.read();
+}
+
+QString PackDetailsCache::thumbnailPath(const QFileInfo& file)
+{
+    if (!file.isFile())
+        return {};
+
+    auto key = file.absoluteFilePath().toUtf8() + '\n' + QByteArray::number(file.size()) + '\n' +
+               QByteArray::number(file.lastModified().toMSecsSinceEpoch());
+    return FS::PathCombine("cache", "thumbnails", "packs", hashOf(key) + ".png");
+}
+
+QImage PackDetailsCache::loadThumbnail(const QFileInfo& file)
+{
+    QImage thumbnail;
+    auto path = thumbnailPath(file);
+    if (!path.isEmpty())
+        thumbnail.load(path, "PNG");
+    return thumbnail;
+}
+
+void PackDetailsCache::saveThumbnail(const QFileInfo& file, const QImage& icon)
+{
+    auto path = thumbnailPath(file);
+    if (!path.isEmpty() && FS::ensureFilePathExists(path) && !icon.save(path, "PNG"))
+        qWarning() << "Failed to save the icon thumbnail of" << file.fileName() << "to" << path;
+}
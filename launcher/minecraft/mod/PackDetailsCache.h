@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+#include <optional>
+
+#include "modplatform/helpers/HashCache.h"
+
+/** Persistent cache of what the resource, texture and shader pack parsers found, so unchanged archives don't have to be
+ *  opened again on later visits.
+ *
+ *  Like ModDetailsCache, entries are keyed by file name and only used while the file still has the identity it had
+ *  when parsed. Only packs that parsed fine are kept, and icons live apart from it, as downscaled thumbnails.
+ *  Thread-safe, since the parse tasks use it from worker threads.
+ */
+class PackDetailsCache {
+   public:
+    struct Details {
+        int pack_format = 0;
+        QString description;
+        bool has_image = false;
+    };
+
+    explicit PackDetailsCache(QString cache_file);
+
+    /** Where the cache of the pack folder at 'dir' is kept. */
+    static QString locationFor(const QDir& dir);
+
+    std::optional<Details> lookup(const QString& file_name, const Hashing::FileIdentity& identity);
+    void insert(const QString& file_name, const Hashing::FileIdentity& identity, const Details& details);
+
+    /* Drops the entries of files that aren't in the folder anymore. */
+    void retain(const QSet<QString>& file_names);
+
+    /* Writes the cache to disk, if it changed since the last save. */
+    void save();
+
+    /** Decodes a pack icon straight to the size views draw it at, instead of holding the full-size image first. */
+    static QImage decodeIcon(QByteArray& data);
+
+    /** Where the downscaled icon of the pack archive is kept between runs. The path changes whenever the file does,
+     *  so stale thumbnails are simply never looked up again. Empty for folders, which can change without their
+     *  modification time doing so.
+     */
+    static QString thumbnailPath(const QFileInfo& file);
+
+    /** The thumbnail of the pack's icon, or a null image if there's none. */
+    static QImage loadThumbnail(const QFileInfo& file);
+    static void saveThumbnail(const QFileInfo& file, const QImage& icon);
+
+   private:
+    struct Entry {
+        Hashing::FileIdentity identity;
+        Details details;
+    };
+
+    void ensureLoaded();
+
+    QString m_cache_file;
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    bool m_loaded = false;
+    bool m_dirty = false;
+};
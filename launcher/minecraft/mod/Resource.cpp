@@ -1,5 +1,6 @@
 #include "Resource.h"
 
+#include <QFile>
 #include <QFileInfo>
 #include <QRegularExpression>
 
@@ -20,6 +21,9 @@ void Resource::setFile(QFileInfo file_info)
 
 void Resource::parseFile()
 {
+    invalidateSortKeys();
+    m_link_state.reset();
+
     QString file_name{ m_file_info.fileName() };
 
     m_type = ResourceType::UNKNOWN;
@@ -56,11 +60,26 @@ void Resource::parseFile()
 
 static void removeThePrefix(QString& string)
 {
-    QRegularExpression regex(QStringLiteral("^(?:the|teh) +"), QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression regex(QStringLiteral("^(?:the|teh) +"), QRegularExpression::CaseInsensitiveOption);
     string.remove(regex);
     string = string.trimmed();
 }
 
+void Resource::invalidateSortKeys()
+{
+    m_sort_name.reset();
+}
+
+const QString& Resource::sortName() const
+{
+    if (!m_sort_name) {
+        QString sort_name{ name() };
+        removeThePrefix(sort_name);
+        m_sort_name = sort_name;
+    }
+    return *m_sort_name;
+}
+
 std::pair<int, bool> Resource::compare(const Resource& other, SortType type) const
 {
     switch (type) {
@@ -72,13 +91,7 @@ std::pair<int, bool> Resource::compare(const Resource& other, SortType type) con
                 return { -1, type == SortType::ENABLED };
             break;
         case SortType::NAME: {
-            QString this_name{ name() };
-            QString other_name{ other.name() };
-
-            removeThePrefix(this_name);
-            removeThePrefix(other_name);
-
-            auto compare_result = QString::compare(this_name, other_name, Qt::CaseInsensitive);
+            auto compare_result = QString::compare(sortName(), other.sortName(), Qt::CaseInsensitive);
             if (compare_result != 0)
                 return { compare_result, type == SortType::NAME };
             break;
@@ -101,11 +114,23 @@ bool Resource::applyFilter(QRegularExpression filter) const
 
 bool Resource::enable(EnableAction action)
 {
-    if (m_type == ResourceType::UNKNOWN || m_type == ResourceType::FOLDER)
+    auto path = enabledPath(action);
+    if (path.isEmpty())
         return false;
 
+    if (!QFile::rename(m_file_info.absoluteFilePath(), path))
+        return false;
+
+    setEnabledPath(path);
+    return true;
+}
+
+QString Resource::enabledPath(EnableAction action) const
+{
+    if (m_type == ResourceType::UNKNOWN || m_type == ResourceType::FOLDER)
+        return {};
+
     QString path = m_file_info.absoluteFilePath();
-    QFile file(path);
 
     bool enable = true;
     switch (action) {
@@ -122,28 +147,24 @@ bool Resource::enable(EnableAction action)
     }
 
     if (m_enabled == enable)
-        return false;
+        return {};
 
     if (enable) {
         // m_enabled is false, but there's no '.disabled' suffix.
         // TODO: Report error?
         if (!path.endsWith(".disabled"))
-            return false;
+            return {};
         path.chop(9);
-
-        if (!file.rename(path))
-            return false;
     } else {
         path += ".disabled";
-
-        if (!file.rename(path))
-            return false;
     }
+    return path;
+}
 
+void Resource::setEnabledPath(const QString& path)
+{
     setFile(QFileInfo(path));
-
-    m_enabled = enable;
-    return true;
+    m_enabled = !path.endsWith(".disabled");
 }
 
 bool Resource::destroy(bool attemptTrash)
@@ -169,3 +190,17 @@ bool Resource::isMoreThanOneHardLink() const
 {
     return FS::hardLinkCount(m_file_info.absoluteFilePath()) > 1;
 }
+
+Resource::LinkState Resource::linkState(const QString& instPath) const
+{
+    if (!m_link_state || m_link_state_under != instPath) {
+        if (isSymLinkUnder(instPath))
+            m_link_state = LinkState::SymLinked;
+        else if (isMoreThanOneHardLink())
+            m_link_state = LinkState::HardLinked;
+        else
+            m_link_state = LinkState::None;
+        m_link_state_under = instPath;
+    }
+    return *m_link_state;
+}
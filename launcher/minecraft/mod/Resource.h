@@ -5,6 +5,8 @@
 #include <QObject>
 #include <QPointer>
 
+#include <optional>
+
 #include "QObjectPtr.h"
 
 enum class ResourceType {
@@ -69,6 +71,11 @@ class Resource : public QObject {
      */
     bool enable(EnableAction action);
 
+    /** Where the file has to be renamed to for 'action', or an empty string if that changes nothing. */
+    [[nodiscard]] QString enabledPath(EnableAction action) const;
+    /** Takes in that the file was renamed to 'path', as given by enabledPath(). */
+    void setEnabledPath(const QString& path);
+
     [[nodiscard]] auto shouldResolve() const -> bool { return !m_is_resolving && !m_is_resolved; }
     [[nodiscard]] auto isResolving() const -> bool { return m_is_resolving; }
     [[nodiscard]] auto isResolved() const -> bool { return m_is_resolved; }
@@ -96,7 +103,21 @@ class Resource : public QObject {
 
     [[nodiscard]] bool isMoreThanOneHardLink() const;
 
+    enum class LinkState { None, SymLinked, HardLinked };
+    /** Whether the file is symlinked from elsewhere (see isSymLinkUnder()) or hard linked, looked up once.
+     *  Models ask on every repaint, and both checks go to the disk.
+     */
+    [[nodiscard]] LinkState linkState(const QString& instPath) const;
+
    protected:
+    /** Drops what compare() keeps between calls, for when what it's worked out from changes.
+     *  Subclasses that keep their own sort keys extend this, and call it whenever their name can change.
+     */
+    virtual void invalidateSortKeys();
+
+    /* name() without a leading "the", which is what sorting by name goes by. */
+    [[nodiscard]] const QString& sortName() const;
+
     /* The file corresponding to this resource. */
     QFileInfo m_file_info;
     /* The cached date when this file was last changed. */
@@ -117,4 +138,9 @@ class Resource : public QObject {
     bool m_is_resolving = false;
     bool m_is_resolved = false;
     int m_resolution_ticket = 0;
+
+   private:
+    mutable std::optional<QString> m_sort_name;
+    mutable std::optional<LinkState> m_link_state;
+    mutable QString m_link_state_under;
 };
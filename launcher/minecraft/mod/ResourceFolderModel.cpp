@@ -3,13 +3,14 @@
 
 #include <QCoreApplication>
 #include <QDebug>
+#include <QFile>
 #include <QFileInfo>
 #include <QHeaderView>
 #include <QIcon>
 #include <QMenu>
 #include <QMimeData>
 #include <QStyle>
-#include <QThreadPool>
+#include <QThread>
 #include <QUrl>
 
 #include "Application.h"
@@ -19,6 +20,7 @@
 #include "minecraft/mod/tasks/BasicFolderLoadTask.h"
 
 #include "settings/Setting.h"
+#include "tasks/CpuExecutor.h"
 #include "tasks/Task.h"
 #include "ui/dialogs/CustomMessageBox.h"
 
@@ -32,17 +34,20 @@ ResourceFolderModel::ResourceFolderModel(QDir dir, BaseInstance* instance, QObje
     m_dir.setFilter(QDir::Readable | QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
     m_dir.setSorting(QDir::Name | QDir::IgnoreCase | QDir::LocaleAware);
 
-    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ResourceFolderModel::directoryChanged);
-    connect(&m_helper_thread_task, &ConcurrentTask::finished, this, [this] { m_helper_thread_task.clear(); });
+    connect(&m_watcher, &CoalescingFileSystemWatcher::pathsChanged, this, &ResourceFolderModel::directoriesChanged);
+
+    m_parse_pool.setMaxThreadCount(QThread::idealThreadCount());
 #ifndef LAUNCHER_TEST
     // in tests the application macro doesn't work
-    m_helper_thread_task.setMaxConcurrent(APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
+    m_parse_pool.setMaxThreadCount(qMax(1, APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()));
 #endif
 }
 
 ResourceFolderModel::~ResourceFolderModel()
 {
-    while (!QThreadPool::globalInstance()->waitForDone(100))
+    // Nothing will be around to receive the results anymore, so don't bother running what is still queued
+    m_parse_pool.clear();
+    while (!m_parse_pool.waitForDone(100))
         QCoreApplication::processEvents();
 }
 
@@ -52,6 +57,7 @@ bool ResourceFolderModel::startWatching(const QStringList& paths)
         return false;
 
     auto couldnt_be_watched = m_watcher.addPaths(paths);
+    m_watching_everything = couldnt_be_watched.isEmpty();
     for (auto path : paths) {
         if (couldnt_be_watched.contains(path))
             qDebug() << "Failed to start watching " << path;
@@ -71,6 +77,8 @@ bool ResourceFolderModel::stopWatching(const QStringList& paths)
         return false;
 
     auto couldnt_be_stopped = m_watcher.removePaths(paths);
+    m_watching_everything = false;
+    m_up_to_date = false;
     for (auto path : paths) {
         if (couldnt_be_stopped.contains(path))
             qDebug() << "Failed to stop watching " << path;
@@ -177,17 +185,20 @@ bool ResourceFolderModel::deleteResources(const QModelIndexList& indexes)
     if (indexes.isEmpty())
         return true;
 
+    QList<Resource::Ptr> deleted;
     for (auto i : indexes) {
         if (i.column() != 0) {
             continue;
         }
-
-        auto& resource = m_resources.at(i.row());
-
-        resource->destroy();
+        deleted.append(m_resources.at(i.row()));
     }
 
-    update();
+    runBatch(
+        [deleted] {
+            for (auto& resource : deleted)
+                resource->destroy();
+        },
+        [this, deleted] { removeDeleted(deleted); });
 
     return true;
 }
@@ -197,36 +208,127 @@ bool ResourceFolderModel::setResourceEnabled(const QModelIndexList& indexes, Ena
     if (indexes.isEmpty())
         return true;
 
+    struct Rename {
+        Resource::Ptr resource;
+        QString from;
+        QString to;
+        bool done = false;
+    };
+    auto renames = std::make_shared<std::vector<Rename>>();
+
     bool succeeded = true;
     for (auto const& idx : indexes) {
         if (!validateIndex(idx) || idx.column() != 0)
             continue;
 
-        int row = idx.row();
-
-        auto& resource = m_resources[row];
-
-        // Preserve the row, but change its ID
-        auto old_id = resource->internal_id();
-        if (!resource->enable(action)) {
+        auto& resource = m_resources[idx.row()];
+        auto to = resource->enabledPath(action);
+        if (to.isEmpty()) {
             succeeded = false;
             continue;
         }
+        renames->push_back({ resource, resource->fileinfo().absoluteFilePath(), to });
+    }
 
-        auto new_id = resource->internal_id();
-        if (m_resources_index.contains(new_id)) {
-            // FIXME: https://github.com/PolyMC/PolyMC/issues/550
-        }
+    // Preserve the rows, but change their IDs
+    auto apply = [this, renames] {
+        int first = -1;
+        int last = -1;
+        for (auto& rename : *renames) {
+            if (!rename.done)
+                continue;
+            auto old_id = rename.resource->internal_id();
+            auto row = m_resources_index.value(old_id, -1);
+            rename.resource->setEnabledPath(rename.to);
+            // it went away in the meantime
+            if (row < 0 || m_resources[row] != rename.resource)
+                continue;
 
-        m_resources_index.remove(old_id);
-        m_resources_index[new_id] = row;
+            auto new_id = rename.resource->internal_id();
+            if (m_resources_index.contains(new_id)) {
+                // FIXME: https://github.com/PolyMC/PolyMC/issues/550
+            }
 
-        emit dataChanged(index(row, 0), index(row, columnCount(QModelIndex()) - 1));
+            m_resources_index.remove(old_id);
+            m_resources_index[new_id] = row;
+            first = first < 0 ? row : std::min(first, row);
+            last = std::max(last, row);
+        }
+        if (first >= 0)
+            emit dataChanged(index(first, 0), index(last, columnCount(QModelIndex()) - 1));
+    };
+
+    if (renames->size() == 1) {
+        auto& rename = renames->front();
+        rename.done = QFile::rename(rename.from, rename.to);
+        apply();
+        return succeeded && rename.done;
     }
 
+    runBatch(
+        [renames] {
+            for (auto& rename : *renames) {
+                rename.done = QFile::rename(rename.from, rename.to);
+                if (!rename.done)
+                    qWarning() << "Failed to rename" << rename.from << "to" << rename.to;
+            }
+        },
+        apply);
+
     return succeeded;
 }
 
+void ResourceFolderModel::runBatch(std::function<void()> work, std::function<void()> done)
+{
+    m_running_batches++;
+    auto watcher = new QFutureWatcher<void>(this);
+    connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, done] {
+        watcher->deleteLater();
+        done();
+        if (--m_running_batches == 0 && m_changed_during_batch) {
+            m_changed_during_batch = false;
+            m_up_to_date = false;
+            update();
+        }
+    });
+    watcher->setFuture(CpuExecutor::run(CpuExecutor::Priority::Interactive, std::move(work)));
+}
+
+void ResourceFolderModel::removeDeleted(const QList<Resource::Ptr>& resources)
+{
+    QList<int> rows;
+    for (auto& resource : resources) {
+        auto row = m_resources_index.value(resource->internal_id(), -1);
+        if (row >= 0 && m_resources[row] == resource && !resource->fileinfo().exists())
+            rows.append(row);
+    }
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+
+    for (int i = 0; i < rows.size();) {
+        // rows[i] is the last row of a run going down to rows[j - 1]
+        int j = i + 1;
+        while (j < rows.size() && rows[j] == rows[j - 1] - 1)
+            j++;
+        int first = rows[j - 1];
+        int last = rows[i];
+        for (int row = first; row <= last; row++) {
+            if (m_resources[row]->isResolving())
+                abortParseTask(m_resources[row]->resolutionTicket());
+        }
+        beginRemoveRows(QModelIndex(), first, last);
+        m_resources.erase(m_resources.begin() + first, m_resources.begin() + last + 1);
+        endRemoveRows();
+        i = j;
+    }
+
+    if (!rows.isEmpty()) {
+        m_resources_index.clear();
+        int idx = 0;
+        for (auto const& resource : qAsConst(m_resources))
+            m_resources_index[resource->internal_id()] = idx++;
+    }
+}
+
 static QMutex s_update_task_mutex;
 bool ResourceFolderModel::update()
 {
@@ -242,6 +344,7 @@ bool ResourceFolderModel::update()
     m_current_update_task.reset(createUpdateTask());
     if (!m_current_update_task)
         return false;
+    m_up_to_date = false;
 
     connect(m_current_update_task.get(), &Task::succeeded, this, &ResourceFolderModel::onUpdateSucceeded,
             Qt::ConnectionType::QueuedConnection);
@@ -249,22 +352,28 @@ bool ResourceFolderModel::update()
     connect(
         m_current_update_task.get(), &Task::finished, this,
         [=] {
+            m_up_to_date = m_current_update_task->wasSuccessful();
             m_current_update_task.reset();
             if (m_scheduled_update) {
                 m_scheduled_update = false;
                 update();
             } else {
+                // Pick up resources whose parsing got cancelled while the page was closed
+                for (auto const& res : qAsConst(m_resources))
+                    resolveResource(res.get());
+
                 emit updateFinished();
             }
         },
         Qt::ConnectionType::QueuedConnection);
 
-    QThreadPool::globalInstance()->start(m_current_update_task.get());
+    // The folder listing is what gets the UI populated, so it goes ahead of any parse task
+    m_parse_pool.start(m_current_update_task.get(), ParsePriority::Update);
 
     return true;
 }
 
-void ResourceFolderModel::resolveResource(Resource* res)
+void ResourceFolderModel::resolveResource(Resource* res, bool prioritize)
 {
     if (!res->shouldResolve()) {
         return;
@@ -291,13 +400,69 @@ void ResourceFolderModel::resolveResource(Resource* res)
         },
         Qt::ConnectionType::QueuedConnection);
 
-    m_helper_thread_task.addTask(task);
+    m_parse_pool.start(task.get(), prioritize ? ParsePriority::Visible : ParsePriority::Background);
+}
 
-    if (!m_helper_thread_task.isRunning()) {
-        QThreadPool::globalInstance()->start(&m_helper_thread_task);
+void ResourceFolderModel::prioritizeResources(const QModelIndexList& indexes)
+{
+    for (auto const& index : indexes) {
+        if (!validateIndex(index))
+            continue;
+
+        auto res = m_resources.at(index.row()).get();
+        if (res->shouldResolve()) {
+            resolveResource(res, true);
+            continue;
+        }
+
+        if (!res->isResolving())
+            continue;
+
+        // Re-queue with a higher priority if it hasn't started yet
+        auto task = m_active_parse_tasks.value(res->resolutionTicket());
+        if (task && m_parse_pool.tryTake(task.get()))
+            m_parse_pool.start(task.get(), ParsePriority::Visible);
     }
 }
 
+void ResourceFolderModel::cancelPendingParseTasks()
+{
+    bool cancelled_any = false;
+
+    for (auto const& res : qAsConst(m_resources)) {
+        if (!res->isResolving())
+            continue;
+
+        auto ticket = res->resolutionTicket();
+        auto task = m_active_parse_tasks.value(ticket);
+        if (!task || !m_parse_pool.tryTake(task.get()))
+            continue;
+
+        // It never ran, so none of its signals will fire. Undo what resolveResource() did instead.
+        m_active_parse_tasks.remove(ticket);
+        res->setResolving(false, ticket);
+        cancelled_any = true;
+    }
+
+    if (cancelled_any)
+        emit parseFinished();
+}
+
+void ResourceFolderModel::abortParseTask(int ticket)
+{
+    auto task = m_active_parse_tasks.value(ticket);
+    if (!task)
+        return;
+
+    if (m_parse_pool.tryTake(task.get())) {
+        m_active_parse_tasks.remove(ticket);
+        emit parseFinished();
+        return;
+    }
+
+    task->abort();
+}
+
 void ResourceFolderModel::onUpdateSucceeded()
 {
     auto update_results = static_cast<BasicFolderLoadTask*>(m_current_update_task.get())->result();
@@ -338,8 +503,36 @@ bool ResourceFolderModel::hasPendingParseTasks() const
     return !m_active_parse_tasks.isEmpty();
 }
 
-void ResourceFolderModel::directoryChanged(QString path)
+void ResourceFolderModel::enablePackDetailsCache()
 {
+    m_pack_details_cache = std::make_shared<PackDetailsCache>(PackDetailsCache::locationFor(m_dir));
+    connect(this, &ResourceFolderModel::updateFinished, this, [this] {
+        QSet<QString> file_names;
+        for (auto const& res : qAsConst(m_resources))
+            file_names.insert(res->fileinfo().fileName());
+        m_pack_details_cache->retain(file_names);
+        if (!hasPendingParseTasks())
+            m_pack_details_cache->save();
+    });
+    connect(this, &ResourceFolderModel::parseFinished, this, [this] {
+        if (!hasPendingParseTasks())
+            m_pack_details_cache->save();
+    });
+}
+
+bool ResourceFolderModel::isUpToDate() const
+{
+    return m_is_watching && m_watching_everything && m_up_to_date && !isUpdating() && !m_watcher.hasPendingChanges();
+}
+
+void ResourceFolderModel::directoriesChanged([[maybe_unused]] const QSet<QString>& paths)
+{
+    if (m_running_batches > 0) {
+        m_changed_during_batch = true;
+        return;
+    }
+    m_up_to_date = false;
+    // The update task figures out what changed on its own, so one update covers the whole batch
     update();
 }
 
@@ -425,14 +618,14 @@ QVariant ResourceFolderModel::data(const QModelIndex& index, int role) const
             }
         case Qt::ToolTipRole:
             if (column == NAME_COLUMN) {
-                if (at(row).isSymLinkUnder(instDirPath())) {
+                if (at(row).linkState(instDirPath()) == Resource::LinkState::SymLinked) {
                     return m_resources[row]->internal_id() +
                            tr("\nWarning: This resource is symbolically linked from elsewhere. Editing it will also change the original."
                               "\nCanonical Path: %1")
                                .arg(at(row).fileinfo().canonicalFilePath());
                     ;
                 }
-                if (at(row).isMoreThanOneHardLink()) {
+                if (at(row).linkState(instDirPath()) == Resource::LinkState::HardLinked) {
                     return m_resources[row]->internal_id() +
                            tr("\nWarning: This resource is hard linked elsewhere. Editing it will also change the original.");
                 }
@@ -440,7 +633,7 @@ QVariant ResourceFolderModel::data(const QModelIndex& index, int role) const
 
             return m_resources[row]->internal_id();
         case Qt::DecorationRole: {
-            if (column == NAME_COLUMN && (at(row).isSymLinkUnder(instDirPath()) || at(row).isMoreThanOneHardLink()))
+            if (column == NAME_COLUMN && at(row).linkState(instDirPath()) != Resource::LinkState::None)
                 return APPLICATION->getThemedIcon("status-yellow");
 
             return {};
@@ -3,16 +3,18 @@
 #include <QAbstractListModel>
 #include <QAction>
 #include <QDir>
-#include <QFileSystemWatcher>
 #include <QHeaderView>
 #include <QMutex>
 #include <QSet>
 #include <QSortFilterProxyModel>
+#include <QThreadPool>
 #include <QTreeView>
 
 #include "Resource.h"
 
 #include "BaseInstance.h"
+#include "CoalescingFileSystemWatcher.h"
+#include "PackDetailsCache.h"
 
 #include "tasks/ConcurrentTask.h"
 #include "tasks/Task.h"
@@ -64,19 +66,44 @@ class ResourceFolderModel : public QAbstractListModel {
      *  Returns whether the removal was successful.
      */
     virtual bool uninstallResource(QString file_name);
+    /** Deletes the resources in 'indexes' in the background, and removes their rows once that's done. */
     virtual bool deleteResources(const QModelIndexList&);
 
     /** Applies the given 'action' to the resources in 'indexes'.
      *
-     *  Returns whether the action was successfully applied to all resources.
+     *  A single resource is renamed right away. More are renamed in the background, all their rows being updated once
+     *  that's done, so toggling many resources doesn't hold up the UI.
+     *
+     *  Returns whether the action applies to all resources.
      */
     virtual bool setResourceEnabled(const QModelIndexList& indexes, EnableAction action);
 
     /** Creates a new update task and start it. Returns false if no update was done, like when an update is already underway. */
     virtual bool update();
 
-    /** Creates a new parse task, if needed, for 'res' and start it.*/
-    virtual void resolveResource(Resource* res);
+    /** Whether the model is known to match what's on disk: it's being watched, its last update went through and nothing
+     *  changed since. Whoever needs the current state can then use the model as is, instead of updating it again.
+     */
+    [[nodiscard]] bool isUpToDate() const;
+
+    /** Whether an update is running or scheduled, updateFinished() will then be emitted once it's done. */
+    [[nodiscard]] bool isUpdating() const { return m_current_update_task != nullptr || m_scheduled_update; }
+
+    /** Creates a new parse task, if needed, for 'res' and start it.
+     *
+     *  Prioritized tasks are executed before any other queued parse task, so resources the user is looking at
+     *  get resolved first.
+     */
+    virtual void resolveResource(Resource* res, bool prioritize = false);
+
+    /** Moves the parse tasks of the resources in 'indexes' to the front of the queue, creating them if needed. */
+    void prioritizeResources(const QModelIndexList& indexes);
+
+    /** Drops all parse tasks that haven't started yet. Tasks already running are left to finish.
+     *
+     *  The affected resources are resolved again on the next update, or when they get prioritized.
+     */
+    void cancelPendingParseTasks();
 
     [[nodiscard]] qsizetype size() const { return m_resources.size(); }
     [[nodiscard]] bool empty() const { return size() == 0; }
@@ -172,8 +199,24 @@ class ResourceFolderModel : public QAbstractListModel {
     template <typename T>
     void applyUpdates(QSet<QString>& current_set, QSet<QString>& new_set, QMap<QString, T>& new_resources);
 
+    /** Runs 'work' on a worker thread, then 'done' back on this one.
+     *
+     *  What the watcher reports meanwhile waits for the batch to be done, so however many files it touches, the model is
+     *  updated once at most.
+     */
+    void runBatch(std::function<void()> work, std::function<void()> done);
+
+    /** Removes the rows of those of 'resources' whose files are gone, each run of adjacent rows at once. */
+    void removeDeleted(const QList<Resource::Ptr>& resources);
+
+    /** Sets up m_pack_details_cache for the pack folders, whose parse tasks fill it. It's pruned after every update,
+     *  and saved once all the parsing is done.
+     */
+    void enablePackDetailsCache();
+
    protected slots:
-    void directoryChanged(QString);
+    /** Called with the watched paths that changed since the last call. Changes are batched, so bulk writes only cause one update. */
+    void directoriesChanged(const QSet<QString>& paths);
 
     /** Called when the update task is successful.
      *
@@ -203,20 +246,37 @@ class ResourceFolderModel : public QAbstractListModel {
 
     QDir m_dir;
     BaseInstance* m_instance;
-    QFileSystemWatcher m_watcher;
+    CoalescingFileSystemWatcher m_watcher;
     bool m_is_watching = false;
+    // every path is watched, so any change on disk reaches us
+    bool m_watching_everything = false;
+    // the last update succeeded, and the watcher didn't report anything since it started
+    bool m_up_to_date = false;
 
     Task::Ptr m_current_update_task = nullptr;
     bool m_scheduled_update = false;
 
+    int m_running_batches = 0;
+    // the watcher reported something while a batch was running
+    bool m_changed_during_batch = false;
+
     QList<Resource::Ptr> m_resources;
 
     // Represents the relationship between a resource's internal ID and it's row position on the model.
     QMap<QString, int> m_resources_index;
 
-    ConcurrentTask m_helper_thread_task;
+    // Scheduling priorities for the tasks in m_parse_pool. Higher values run first.
+    enum ParsePriority { Background = 0, Visible = 1, Update = 2 };
+
+    /** Aborts the parse task with the given ticket, making sure it never runs if it's still queued. */
+    void abortParseTask(int ticket);
+
+    // Shared by the update and parse tasks, so that we never block the global pool, and can reorder / drop pending work.
+    QThreadPool m_parse_pool;
     QMap<int, Task::Ptr> m_active_parse_tasks;
     std::atomic<int> m_next_resolution_ticket = 0;
+
+    std::shared_ptr<PackDetailsCache> m_pack_details_cache;
 };
 
 /* A macro to define useful functions to handle Resource* -> T* more easily on derived classes */
@@ -264,7 +324,12 @@ void ResourceFolderModel::applyUpdates(QSet<QString>& current_set, QSet<QString>
             Q_ASSERT(row_it != m_resources_index.constEnd());
             auto row = row_it.value();
 
-            auto& new_resource = new_resources[kept];
+            // Incremental updates leave out whatever didn't change
+            auto new_it = new_resources.find(kept);
+            if (new_it == new_resources.end())
+                continue;
+
+            auto& new_resource = new_it.value();
             auto const& current_resource = m_resources.at(row);
 
             if (new_resource->dateTimeChanged() == current_resource->dateTimeChanged()) {
@@ -274,13 +339,8 @@ void ResourceFolderModel::applyUpdates(QSet<QString>& current_set, QSet<QString>
 
             // If the resource is resolving, but something about it changed, we don't want to
             // continue the resolving.
-            if (current_resource->isResolving()) {
-                auto ticket = current_resource->resolutionTicket();
-                if (m_active_parse_tasks.contains(ticket)) {
-                    auto task = (*m_active_parse_tasks.find(ticket)).get();
-                    task->abort();
-                }
-            }
+            if (current_resource->isResolving())
+                abortParseTask(current_resource->resolutionTicket());
 
             m_resources[row].reset(new_resource);
             resolveResource(m_resources.at(row).get());
@@ -304,13 +364,8 @@ void ResourceFolderModel::applyUpdates(QSet<QString>& current_set, QSet<QString>
 
             Q_ASSERT(removed_it != m_resources.end());
 
-            if ((*removed_it)->isResolving()) {
-                auto ticket = (*removed_it)->resolutionTicket();
-                if (m_active_parse_tasks.contains(ticket)) {
-                    auto task = (*m_active_parse_tasks.find(ticket)).get();
-                    task->abort();
-                }
-            }
+            if ((*removed_it)->isResolving())
+                abortParseTask((*removed_it)->resolutionTicket());
 
             beginRemoveRows(QModelIndex(), removed_index, removed_index);
             m_resources.erase(removed_it);
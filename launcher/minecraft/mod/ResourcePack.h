@@ -1,11 +1,11 @@
 #pragma once
 
+#include "MTPixmapCache.h"
 #include "Resource.h"
 
 #include <QImage>
 #include <QMutex>
 #include <QPixmap>
-#include <QPixmapCache>
 
 class Version;
 
@@ -65,7 +65,7 @@ class ResourcePack : public Resource {
      *  so as to tell whether a cache entry is inexistent or if it was just evicted from the cache.
      */
     struct {
-        QPixmapCache::Key key;
+        PixmapCache::Key key;
         bool was_ever_used = false;
     } mutable m_pack_image_cache_key;
 };
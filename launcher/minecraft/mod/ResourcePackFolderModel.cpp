@@ -55,6 +55,8 @@ ResourcePackFolderModel::ResourcePackFolderModel(const QString& dir, BaseInstanc
     m_column_resize_modes = { QHeaderView::Interactive, QHeaderView::Interactive, QHeaderView::Stretch, QHeaderView::Interactive,
                               QHeaderView::Interactive };
     m_columnsHideable = { false, true, false, true, true };
+
+    enablePackDetailsCache();
 }
 
 QVariant ResourcePackFolderModel::data(const QModelIndex& index, int role) const
@@ -90,7 +92,7 @@ QVariant ResourcePackFolderModel::data(const QModelIndex& index, int role) const
                     return {};
             }
         case Qt::DecorationRole: {
-            if (column == NameColumn && (at(row)->isSymLinkUnder(instDirPath()) || at(row)->isMoreThanOneHardLink()))
+            if (column == NameColumn && at(row)->linkState(instDirPath()) != Resource::LinkState::None)
                 return APPLICATION->getThemedIcon("status-yellow");
             if (column == ImageColumn) {
                 return at(row)->image({ 32, 32 }, Qt::AspectRatioMode::KeepAspectRatioByExpanding);
@@ -103,14 +105,14 @@ QVariant ResourcePackFolderModel::data(const QModelIndex& index, int role) const
                 return tr("The resource pack format ID, as well as the Minecraft versions it was designed for.");
             }
             if (column == NameColumn) {
-                if (at(row)->isSymLinkUnder(instDirPath())) {
+                if (at(row)->linkState(instDirPath()) == Resource::LinkState::SymLinked) {
                     return m_resources[row]->internal_id() +
                            tr("\nWarning: This resource is symbolically linked from elsewhere. Editing it will also change the original."
                               "\nCanonical Path: %1")
                                .arg(at(row)->fileinfo().canonicalFilePath());
                     ;
                 }
-                if (at(row)->isMoreThanOneHardLink()) {
+                if (at(row)->linkState(instDirPath()) == Resource::LinkState::HardLinked) {
                     return m_resources[row]->internal_id() +
                            tr("\nWarning: This resource is hard linked elsewhere. Editing it will also change the original.");
                 }
@@ -185,5 +187,5 @@ Task* ResourcePackFolderModel::createUpdateTask()
 
 Task* ResourcePackFolderModel::createParseTask(Resource& resource)
 {
-    return new LocalResourcePackParseTask(m_next_resolution_ticket, static_cast<ResourcePack&>(resource));
+    return new LocalResourcePackParseTask(m_next_resolution_ticket, static_cast<ResourcePack&>(resource), m_pack_details_cache);
 }
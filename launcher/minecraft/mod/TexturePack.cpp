@@ -47,7 +47,7 @@ void TexturePack::setImage(QImage new_image) const
     auto pixmap =
         QPixmap::fromImage(new_image.scaled({ 64, 64 }, Qt::AspectRatioMode::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
 
-    m_pack_image_cache_key.key = PixmapCache::insert(pixmap);
+    m_pack_image_cache_key.key = PixmapCache::insert(PixmapCache::Consumer::TexturePacks, pixmap);
     m_pack_image_cache_key.was_ever_used = true;
 }
 
@@ -65,7 +65,6 @@ QPixmap TexturePack::image(QSize size, Qt::AspectRatioMode mode) const
         return {};
     } else {
         qDebug() << "Texture Pack" << name() << "Had it's image evicted from the cache. reloading...";
-        PixmapCache::markCacheMissByEviciton();
     }
 
     // Imaged got evicted from the cache. Re-process it and retry.
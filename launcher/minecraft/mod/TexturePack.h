@@ -19,12 +19,12 @@
 
 #pragma once
 
+#include "MTPixmapCache.h"
 #include "Resource.h"
 
 #include <QImage>
 #include <QMutex>
 #include <QPixmap>
-#include <QPixmapCache>
 
 class Version;
 
@@ -63,7 +63,7 @@ class TexturePack : public Resource {
      *  so as to tell whether a cache entry is inexistent or if it was just evicted from the cache.
      */
     struct {
-        QPixmapCache::Key key;
+        PixmapCache::Key key;
         bool was_ever_used = false;
     } mutable m_pack_image_cache_key;
 };
@@ -49,6 +49,8 @@ TexturePackFolderModel::TexturePackFolderModel(const QString& dir, BaseInstance*
     m_column_sort_keys = { SortType::ENABLED, SortType::NAME, SortType::NAME, SortType::DATE };
     m_column_resize_modes = { QHeaderView::Interactive, QHeaderView::Interactive, QHeaderView::Stretch, QHeaderView::Interactive };
     m_columnsHideable = { false, true, false, true };
+
+    enablePackDetailsCache();
 }
 
 Task* TexturePackFolderModel::createUpdateTask()
@@ -58,7 +60,7 @@ Task* TexturePackFolderModel::createUpdateTask()
 
 Task* TexturePackFolderModel::createParseTask(Resource& resource)
 {
-    return new LocalTexturePackParseTask(m_next_resolution_ticket, static_cast<TexturePack&>(resource));
+    return new LocalTexturePackParseTask(m_next_resolution_ticket, static_cast<TexturePack&>(resource), m_pack_details_cache);
 }
 
 QVariant TexturePackFolderModel::data(const QModelIndex& index, int role) const
@@ -81,14 +83,14 @@ QVariant TexturePackFolderModel::data(const QModelIndex& index, int role) const
             }
         case Qt::ToolTipRole:
             if (column == NameColumn) {
-                if (at(row)->isSymLinkUnder(instDirPath())) {
+                if (at(row)->linkState(instDirPath()) == Resource::LinkState::SymLinked) {
                     return m_resources[row]->internal_id() +
                            tr("\nWarning: This resource is symbolically linked from elsewhere. Editing it will also change the original."
                               "\nCanonical Path: %1")
                                .arg(at(row)->fileinfo().canonicalFilePath());
                     ;
                 }
-                if (at(row)->isMoreThanOneHardLink()) {
+                if (at(row)->linkState(instDirPath()) == Resource::LinkState::HardLinked) {
                     return m_resources[row]->internal_id() +
                            tr("\nWarning: This resource is hard linked elsewhere. Editing it will also change the original.");
                 }
@@ -96,7 +98,7 @@ QVariant TexturePackFolderModel::data(const QModelIndex& index, int role) const
 
             return m_resources[row]->internal_id();
         case Qt::DecorationRole: {
-            if (column == NameColumn && (at(row)->isSymLinkUnder(instDirPath()) || at(row)->isMoreThanOneHardLink()))
+            if (column == NameColumn && at(row)->linkState(instDirPath()) != Resource::LinkState::None)
                 return APPLICATION->getThemedIcon("status-yellow");
             if (column == ImageColumn) {
                 return at(row)->image({ 32, 32 }, Qt::AspectRatioMode::KeepAspectRatioByExpanding);
@@ -18,6 +18,8 @@
 
 #include "GetModDependenciesTask.h"
 
+#include <QCache>
+#include <QDateTime>
 #include <QDebug>
 #include <algorithm>
 #include <memory>
@@ -44,6 +46,96 @@ static ModPlatform::ModLoaderTypes mcLoaders(BaseInstance* inst)
     return static_cast<MinecraftInstance*>(inst)->getPackProfile()->getSupportedModLoaders().value();
 }
 
+namespace {
+// Every project found on a level is looked up at once, so their project requests are sent together
+constexpr int LEVEL_CONCURRENCY = 100;
+// Dependency answers are kept for the next runs for this long, as picking mods often resolves the same tree several times
+constexpr qint64 RESPONSE_MAX_AGE_SECS = 30 * 60;
+
+struct CachedResponse {
+    QByteArray data;
+    qint64 fetched;
+};
+
+// Only used from the main thread, costs are in KiB
+QCache<QString, CachedResponse>& responseCache()
+{
+    static QCache<QString, CachedResponse> s_cache(8 * 1024);
+    return s_cache;
+}
+
+std::optional<QByteArray> cachedResponse(const QString& key)
+{
+    auto* entry = responseCache().object(key);
+    if (!entry)
+        return {};
+    if (entry->fetched + RESPONSE_MAX_AGE_SECS < QDateTime::currentSecsSinceEpoch()) {
+        responseCache().remove(key);
+        return {};
+    }
+    return entry->data;
+}
+
+void cacheResponse(const QString& key, const QByteArray& data)
+{
+    responseCache().insert(key, new CachedResponse{ data, QDateTime::currentSecsSinceEpoch() }, std::max(1, static_cast<int>(data.size() / 1024)));
+}
+
+// Hands a response from an earlier run to its handler, the way the finished request would have
+class CachedResponseTask : public Task {
+   public:
+    explicit CachedResponseTask(std::function<void()> deliver) : m_deliver(std::move(deliver)) {}
+
+   protected:
+    void executeTask() override
+    {
+        m_deliver();
+        emitSucceeded();
+    }
+
+   private:
+    std::function<void()> m_deliver;
+};
+
+QString projectKey(ModPlatform::ResourceProvider provider, const QVariant& addonId)
+{
+    return QString("%1:project:%2").arg(static_cast<int>(provider)).arg(addonId.toString());
+}
+
+QString versionKey(ModPlatform::ResourceProvider provider, const QVariant& version)
+{
+    return QString("%1:version:%2").arg(static_cast<int>(provider)).arg(version.toString());
+}
+
+// super lax name (but not fuzzy)
+// convert to lowercase
+// convert all speratores to whitespace
+// simplify sequence of internal whitespace to a single space
+// efectivly two names are equal when they only differ in separators and case
+QString laxName(QString filename, bool excludeDigits = false)
+{
+    // allowed character seperators
+    QList<QChar> allowedSeperators = { '-', '+', '.', '_' };
+    if (excludeDigits)
+        allowedSeperators.append({ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9' });
+
+    // copy in lowercase
+    auto name = filename.toLower();
+
+    // replace all potential allowed seperatores with whitespace
+    for (auto sep : allowedSeperators)
+        name = name.replace(sep, ' ');
+
+    // remove extraneous whitespace
+    return name.simplified();
+}
+
+bool laxCompare(const QString& fsfilename, const QString& metadataFilename)
+{
+    return laxName(fsfilename) == laxName(metadataFilename);
+}
+}  // namespace
+
 GetModDependenciesTask::GetModDependenciesTask(QObject* parent,
                                                BaseInstance* instance,
                                                ModFolderModel* folder,
@@ -62,6 +154,24 @@ GetModDependenciesTask::GetModDependenciesTask(QObject* parent,
         if (auto meta = mod->metadata(); meta)
             m_mods.append(meta);
     }
+
+    // the same checks are made for every dependency found, so they are looked up instead of searched for
+    for (auto& sel : m_selected) {
+        m_known_keys.insert(projectKey(sel->pack->provider, sel->pack->addonId));
+        m_known_keys.insert(versionKey(sel->pack->provider, sel->version.fileId));
+        if (!sel->version.fileName.isEmpty())
+            m_known_file_names.insert(laxName(sel->version.fileName));
+    }
+    for (auto& meta : m_mods) {
+        m_known_keys.insert(projectKey(meta->provider, meta->project_id));
+        m_known_keys.insert(versionKey(meta->provider, meta->file_id));
+    }
+    for (auto& name : m_mods_file_names) {
+        if (name.isEmpty())
+            continue;
+        m_known_file_names.insert(laxName(name));
+        m_mods_file_names_without_digits.insert(laxName(name, true));
+    }
     prepare();
 }
 
@@ -69,11 +179,28 @@ void GetModDependenciesTask::prepare()
 {
     for (auto sel : m_selected) {
         for (auto dep : getDependenciesForVersion(sel->version, sel->pack->provider)) {
-            addTask(prepareDependencyTask(dep, sel->pack->provider, 20));
+            addToNextLevel(prepareDependencyTask(dep, sel->pack->provider, 20));
         }
     }
 }
 
+void GetModDependenciesTask::addToNextLevel(Task::Ptr task)
+{
+    if (!task)
+        return;
+    if (!m_next_level) {
+        m_next_level = makeShared<ConcurrentTask>(this, tr("Get dependencies"), LEVEL_CONCURRENCY);
+        auto level = m_next_level.get();
+        // whatever is found while this level runs belongs to the one after it
+        connect(level, &Task::started, this, [this, level] {
+            if (m_next_level.get() == level)
+                m_next_level.reset();
+        });
+        addTask(m_next_level);
+    }
+    m_next_level->addTask(task);
+}
+
 ModPlatform::Dependency GetModDependenciesTask::getOverride(const ModPlatform::Dependency& dep,
                                                             const ModPlatform::ResourceProvider providerName)
 {
@@ -93,42 +220,22 @@ QList<ModPlatform::Dependency> GetModDependenciesTask::getDependenciesForVersion
                                                                                  const ModPlatform::ResourceProvider providerName)
 {
     QList<ModPlatform::Dependency> c_dependencies;
+    QSet<QString> c_keys;
     for (auto ver_dep : version.dependencies) {
         if (ver_dep.type != ModPlatform::DependencyType::REQUIRED)
             continue;
         ver_dep = getOverride(ver_dep, providerName);
         auto isOnlyVersion = providerName == ModPlatform::ResourceProvider::MODRINTH && ver_dep.addonId.toString().isEmpty();
-        if (auto dep = std::find_if(c_dependencies.begin(), c_dependencies.end(),
-                                    [&ver_dep, isOnlyVersion](const ModPlatform::Dependency& i) {
-                                        return isOnlyVersion ? i.version == ver_dep.version : i.addonId == ver_dep.addonId;
-                                    });
-            dep != c_dependencies.end())
-            continue;  // check the current dependency list
-
-        if (auto dep = std::find_if(m_selected.begin(), m_selected.end(),
-                                    [&ver_dep, providerName, isOnlyVersion](std::shared_ptr<PackDependency> i) {
-                                        return i->pack->provider == providerName && (isOnlyVersion ? i->version.version == ver_dep.version
-                                                                                                   : i->pack->addonId == ver_dep.addonId);
-                                    });
-            dep != m_selected.end())
-            continue;  // check the selected versions
-
-        if (auto dep = std::find_if(m_mods.begin(), m_mods.end(),
-                                    [&ver_dep, providerName, isOnlyVersion](std::shared_ptr<Metadata::ModStruct> i) {
-                                        return i->provider == providerName &&
-                                               (isOnlyVersion ? i->file_id == ver_dep.version : i->project_id == ver_dep.addonId);
-                                    });
-            dep != m_mods.end())
-            continue;  // check the existing mods
-
-        if (auto dep = std::find_if(m_pack_dependencies.begin(), m_pack_dependencies.end(),
-                                    [&ver_dep, providerName, isOnlyVersion](std::shared_ptr<PackDependency> i) {
-                                        return i->pack->provider == providerName && (isOnlyVersion ? i->version.version == ver_dep.addonId
-                                                                                                   : i->pack->addonId == ver_dep.addonId);
-                                    });
-            dep != m_pack_dependencies.end())  // check loaded dependencies
+        auto key = isOnlyVersion ? versionKey(providerName, ver_dep.version) : projectKey(providerName, ver_dep.addonId);
+
+        if (c_keys.contains(key))  // check the current dependency list
+            continue;
+        if (m_known_keys.contains(key))  // check the selected versions and the existing mods
+            continue;
+        if (m_dependency_keys.contains(key))  // check loaded dependencies
             continue;
 
+        c_keys.insert(key);
         c_dependencies.append(ver_dep);
     }
     return c_dependencies;
@@ -138,8 +245,7 @@ Task::Ptr GetModDependenciesTask::getProjectInfoTask(std::shared_ptr<PackDepende
 {
     auto provider = pDep->pack->provider == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
     auto responseInfo = std::make_shared<QByteArray>();
-    auto info = provider.api->getProject(pDep->pack->addonId.toString(), responseInfo);
-    QObject::connect(info.get(), &NetJob::succeeded, [this, responseInfo, provider, pDep] {
+    auto loadInfo = [this, responseInfo, provider, pDep] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*responseInfo, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
@@ -147,7 +253,7 @@ Task::Ptr GetModDependenciesTask::getProjectInfoTask(std::shared_ptr<PackDepende
             qWarning() << "Error while parsing JSON response for mod info at " << parse_error.offset
                        << " reason: " << parse_error.errorString();
             qDebug() << *responseInfo;
-            return;
+            return false;
         }
         try {
             auto obj = provider.name == ModPlatform::ResourceProvider::FLAME ? Json::requireObject(Json::requireObject(doc), "data")
@@ -157,7 +263,21 @@ Task::Ptr GetModDependenciesTask::getProjectInfoTask(std::shared_ptr<PackDepende
             removePack(pDep->pack->addonId);
             qDebug() << doc;
             qWarning() << "Error while reading mod info: " << e.cause();
+            return false;
         }
+        return true;
+    };
+
+    auto cacheKey = projectKey(provider.name, pDep->pack->addonId);
+    if (auto cached = cachedResponse(cacheKey); cached.has_value()) {
+        *responseInfo = *cached;
+        return makeShared<CachedResponseTask>(loadInfo);
+    }
+
+    auto info = provider.api->getProject(pDep->pack->addonId.toString(), responseInfo);
+    QObject::connect(info.get(), &NetJob::succeeded, [responseInfo, cacheKey, loadInfo] {
+        if (loadInfo())
+            cacheResponse(cacheKey, *responseInfo);
     });
     return info;
 }
@@ -173,9 +293,12 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
     pDep->pack->provider = providerName;
 
     m_pack_dependencies.append(pDep);
+    m_dependency_keys.insert(dep.addonId.toString().isEmpty() ? versionKey(providerName, dep.version)
+                                                              : projectKey(providerName, dep.addonId));
     auto provider = providerName == m_flame_provider.name ? m_flame_provider : m_modrinth_provider;
 
-    auto tasks = makeShared<SequentialTask>(
+    // the project and its version don't depend on each other, so both are looked up at once
+    auto tasks = makeShared<ConcurrentTask>(
         this, QString("DependencyInfo: %1").arg(dep.addonId.toString().isEmpty() ? dep.version : dep.addonId.toString()));
 
     if (!dep.addonId.toString().isEmpty()) {
@@ -203,7 +326,7 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
                                              [dep, provider](auto o) { return o.provider == provider.name && dep.addonId == o.quilt; });
                     if (over != overide.cend()) {
                         removePack(dep.addonId);
-                        addTask(prepareDependencyTask({ over->fabric, dep.type }, provider.name, level));
+                        addToNextLevel(prepareDependencyTask({ over->fabric, dep.type }, provider.name, level));
                         return;
                     }
                 }
@@ -229,12 +352,13 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
         }
         if (dep.addonId.toString().isEmpty() && !pDep->version.addonId.toString().isEmpty()) {
             pDep->pack->addonId = pDep->version.addonId;
+            m_dependency_keys.insert(projectKey(provider.name, pDep->pack->addonId));
             auto dep_ = getOverride({ pDep->version.addonId, pDep->dependency.type }, provider.name);
             if (dep_.addonId != pDep->version.addonId) {
                 removePack(pDep->version.addonId);
-                addTask(prepareDependencyTask(dep_, provider.name, level));
+                addToNextLevel(prepareDependencyTask(dep_, provider.name, level));
             } else {
-                addTask(getProjectInfoTask(pDep));
+                addToNextLevel(getProjectInfoTask(pDep));
             }
         }
         if (isLocalyInstalled(pDep)) {
@@ -242,27 +366,52 @@ Task::Ptr GetModDependenciesTask::prepareDependencyTask(const ModPlatform::Depen
             return;
         }
         for (auto dep_ : getDependenciesForVersion(pDep->version, provider.name)) {
-            addTask(prepareDependencyTask(dep_, provider.name, level - 1));
+            addToNextLevel(prepareDependencyTask(dep_, provider.name, level - 1));
         }
     };
 
-    auto version = provider.api->getDependencyVersion(std::move(args), std::move(callbacks));
-    tasks->addTask(version);
+    auto cacheKey = QString("%1:%2:%3:%4")
+                        .arg(dep.addonId.toString().isEmpty() ? versionKey(providerName, dep.version) : projectKey(providerName, dep.addonId),
+                             m_version.toString())
+                        .arg(static_cast<int>(m_loaderType))
+                        .arg(static_cast<int>(dep.type));
+    if (auto cached = cachedResponse(cacheKey); cached.has_value()) {
+        tasks->addTask(makeShared<CachedResponseTask>([on_succeed = callbacks.on_succeed, dep, data = *cached] {
+            auto doc = QJsonDocument::fromJson(data);
+            on_succeed(doc, dep);
+        }));
+        return tasks;
+    }
+    callbacks.on_succeed = [on_succeed = callbacks.on_succeed, cacheKey](auto& doc, auto& dependency) {
+        cacheResponse(cacheKey, doc.toJson(QJsonDocument::Compact));
+        on_succeed(doc, dependency);
+    };
+
+    if (auto version = provider.api->getDependencyVersion(std::move(args), std::move(callbacks)); version)
+        tasks->addTask(version);
     return tasks;
 }
 
 void GetModDependenciesTask::removePack(const QVariant& addonId)
 {
-    auto pred = [addonId](const std::shared_ptr<PackDependency>& v) { return v->pack->addonId == addonId; };
-#if QT_VERSION >= QT_VERSION_CHECK(6, 1, 0)
-    m_pack_dependencies.removeIf(pred);
-#else
-    for (auto it = m_pack_dependencies.begin(); it != m_pack_dependencies.end();)
-        if (pred(*it))
+    for (auto it = m_pack_dependencies.begin(); it != m_pack_dependencies.end();) {
+        if ((*it)->pack->addonId == addonId) {
+            forgetDependency(**it);
             it = m_pack_dependencies.erase(it);
-        else
+        } else {
             ++it;
-#endif
+        }
+    }
+}
+
+void GetModDependenciesTask::forgetDependency(const PackDependency& pDep)
+{
+    auto provider = pDep.pack->provider;
+    if (pDep.dependency.addonId.toString().isEmpty())
+        m_dependency_keys.remove(versionKey(provider, pDep.dependency.version));
+    else
+        m_dependency_keys.remove(projectKey(provider, pDep.dependency.addonId));
+    m_dependency_keys.remove(projectKey(provider, pDep.pack->addonId));
 }
 
 auto GetModDependenciesTask::getExtraInfo() -> QHash<QString, PackDependencyExtraInfo>
@@ -294,46 +443,11 @@ auto GetModDependenciesTask::getExtraInfo() -> QHash<QString, PackDependencyExtr
     return rby;
 }
 
-// super lax compare (but not fuzzy)
-// convert to lowercase
-// convert all speratores to whitespace
-// simplify sequence of internal whitespace to a single space
-// efectivly compare two strings ignoring all separators and case
-auto laxCompare = [](QString fsfilename, QString metadataFilename, bool excludeDigits = false) {
-    // allowed character seperators
-    QList<QChar> allowedSeperators = { '-', '+', '.', '_' };
-    if (excludeDigits)
-        allowedSeperators.append({ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9' });
-
-    // copy in lowercase
-    auto fsName = fsfilename.toLower();
-    auto metaName = metadataFilename.toLower();
-
-    // replace all potential allowed seperatores with whitespace
-    for (auto sep : allowedSeperators) {
-        fsName = fsName.replace(sep, ' ');
-        metaName = metaName.replace(sep, ' ');
-    }
-
-    // remove extraneous whitespace
-    fsName = fsName.simplified();
-    metaName = metaName.simplified();
-
-    return fsName.compare(metaName) == 0;
-};
-
 bool GetModDependenciesTask::isLocalyInstalled(std::shared_ptr<PackDependency> pDep)
 {
     return pDep->version.fileName.isEmpty() ||
 
-           std::find_if(m_selected.begin(), m_selected.end(),
-                        [pDep](std::shared_ptr<PackDependency> i) {
-                            return !i->version.fileName.isEmpty() && laxCompare(i->version.fileName, pDep->version.fileName);
-                        }) != m_selected.end() ||  // check the selected versions
-
-           std::find_if(m_mods_file_names.begin(), m_mods_file_names.end(),
-                        [pDep](QString i) { return !i.isEmpty() && laxCompare(i, pDep->version.fileName); }) !=
-               m_mods_file_names.end() ||  // check the existing mods
+           m_known_file_names.contains(laxName(pDep->version.fileName)) ||  // check the selected versions and the existing mods
 
            std::find_if(m_pack_dependencies.begin(), m_pack_dependencies.end(), [pDep](std::shared_ptr<PackDependency> i) {
                return pDep->pack->addonId != i->pack->addonId && !i->version.fileName.isEmpty() &&
@@ -343,7 +457,5 @@ bool GetModDependenciesTask::isLocalyInstalled(std::shared_ptr<PackDependency> p
 
 bool GetModDependenciesTask::maybeInstalled(std::shared_ptr<PackDependency> pDep)
 {
-    return std::find_if(m_mods_file_names.begin(), m_mods_file_names.end(), [pDep](QString i) {
-               return !i.isEmpty() && laxCompare(i, pDep->version.fileName, true);
-           }) != m_mods_file_names.end();  // check the existing mods
+    return m_mods_file_names_without_digits.contains(laxName(pDep->version.fileName, true));  // check the existing mods
 }
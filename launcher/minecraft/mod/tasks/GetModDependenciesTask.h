@@ -21,6 +21,7 @@
 #include <QDir>
 #include <QEventLoop>
 #include <QList>
+#include <QSet>
 #include <QVariant>
 #include <functional>
 #include <memory>
@@ -29,6 +30,7 @@
 #include "minecraft/mod/ModFolderModel.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/ResourceAPI.h"
+#include "tasks/ConcurrentTask.h"
 #include "tasks/SequentialTask.h"
 #include "tasks/Task.h"
 #include "ui/pages/modplatform/ModModel.h"
@@ -82,10 +84,23 @@ class GetModDependenciesTask : public SequentialTask {
     bool maybeInstalled(std::shared_ptr<PackDependency> pDep);
 
    private:
+    /* Queues a lookup for the next level of the dependency tree, which starts once the current one is done. */
+    void addToNextLevel(Task::Ptr task);
+    void forgetDependency(const PackDependency& pDep);
+
     QList<std::shared_ptr<PackDependency>> m_pack_dependencies;
     QList<std::shared_ptr<Metadata::ModStruct>> m_mods;
     QList<std::shared_ptr<PackDependency>> m_selected;
     QStringList m_mods_file_names;
+
+    // Projects and versions that are selected or installed already, and those looked up as dependencies
+    QSet<QString> m_known_keys;
+    QSet<QString> m_dependency_keys;
+    // The lax names of the selected and installed files, with and without their digits
+    QSet<QString> m_known_file_names;
+    QSet<QString> m_mods_file_names_without_digits;
+
+    ConcurrentTask::Ptr m_next_level;
     Provider m_flame_provider;
     Provider m_modrinth_provider;
 
@@ -23,9 +23,9 @@
 
 #include "FileSystem.h"
 #include "Json.h"
+#include "MMCZip.h"
 
 #include <quazip/quazip.h>
-#include <quazip/quazipdir.h>
 #include <quazip/quazipfile.h>
 
 #include <QCryptographicHash>
@@ -93,13 +93,14 @@ bool processZIP(DataPack& pack, ProcessingLevel level)
         return false;  // can't open zip file
 
     QuaZipFile file(&zip);
+    MMCZip::EntryIndex index(&zip);
 
     auto mcmeta_invalid = [&pack]() {
         qWarning() << "Data pack at" << pack.fileinfo().filePath() << "does not have a valid pack.mcmeta";
         return false;  // the mcmeta is not optional
     };
 
-    if (zip.setCurrentFile("pack.mcmeta")) {
+    if (index.setCurrentFile("pack.mcmeta")) {
         if (!file.open(QIODevice::ReadOnly)) {
             qCritical() << "Failed to open file in zip.";
             zip.close();
@@ -118,8 +119,7 @@ bool processZIP(DataPack& pack, ProcessingLevel level)
         return mcmeta_invalid();  // could not set pack.mcmeta as current file.
     }
 
-    QuaZipDir zipDir(&zip);
-    if (!zipDir.exists("/data")) {
+    if (!index.containsDir("/data")) {
         return false;  // data dir does not exists at zip root
     }
 
@@ -4,6 +4,10 @@
 #include <quazip/quazip.h>
 #include <quazip/quazipfile.h>
 #include <toml++/toml.h>
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QImageReader>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -12,6 +16,7 @@
 
 #include "FileSystem.h"
 #include "Json.h"
+#include "MMCZip.h"
 #include "minecraft/mod/ModDetails.h"
 #include "settings/INIFile.h"
 
@@ -103,12 +108,12 @@ ModDetails ReadMCModTOML(QByteArray contents)
     toml::table tomlData;
 #if TOML_EXCEPTIONS
     try {
-        tomlData = toml::parse(contents.toStdString());
+        tomlData = toml::parse(std::string_view(contents.constData(), contents.size()));
     } catch ([[maybe_unused]] const toml::parse_error& err) {
         return {};
     }
 #else
-    toml::parse_result result = toml::parse(contents.toStdString());
+    toml::parse_result result = toml::parse(std::string_view(contents.constData(), contents.size()));
     if (!result) {
         return {};
     }
@@ -199,11 +204,165 @@ ModDetails ReadMCModTOML(QByteArray contents)
     return details;
 }
 
+/* Minimal JSON scanning, used to skip over the parts of a descriptor we don't care about (entrypoints, mixins,
+ * dependencies, custom data...) without building a DOM for them.
+ * These only need to find where a value ends. Anything malformed is left for QJsonDocument to report.
+ */
+static const char* skipJsonWhitespace(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+        ++p;
+    return p;
+}
+
+// 'p' must point at the opening quote. Returns the position right after the closing quote, or nullptr.
+static const char* skipJsonString(const char* p, const char* end)
+{
+    for (++p; p < end; ++p) {
+        if (*p == '\\')
+            ++p;
+        else if (*p == '"')
+            return p + 1;
+    }
+    return nullptr;
+}
+
+static const char* skipJsonValue(const char* p, const char* end)
+{
+    if (p >= end)
+        return nullptr;
+
+    if (*p == '"')
+        return skipJsonString(p, end);
+
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            switch (*p) {
+                case '"':
+                    p = skipJsonString(p, end);
+                    if (!p)
+                        return nullptr;
+                    continue;
+                case '{':
+                case '[':
+                    ++depth;
+                    break;
+                case '}':
+                case ']':
+                    if (--depth == 0)
+                        return p + 1;
+                    break;
+                default:
+                    break;
+            }
+            ++p;
+        }
+        return nullptr;
+    }
+
+    // numbers, booleans and null
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+        ++p;
+    return p;
+}
+
+/** Copies the members of the object starting at 'p' that are listed in 'paths' to 'out', as a new JSON object.
+ *  A path like "a.b" keeps only the member "b" of the object "a".
+ *  Keys are compared as written in the document, which is fine for the plain ASCII keys descriptors use.
+ */
+static const char* selectJsonMembers(const char* p, const char* end, const QList<QByteArray>& paths, QByteArray& out)
+{
+    p = skipJsonWhitespace(p, end);
+    if (p >= end || *p != '{')
+        return nullptr;
+
+    out.append('{');
+    bool first = true;
+
+    p = skipJsonWhitespace(p + 1, end);
+    if (p < end && *p == '}') {
+        out.append('}');
+        return p + 1;
+    }
+
+    while (p < end) {
+        if (*p != '"')
+            return nullptr;
+        auto key_begin = p;
+        auto key_end = skipJsonString(p, end);
+        if (!key_end)
+            return nullptr;
+        QByteArray key = QByteArray::fromRawData(key_begin + 1, static_cast<int>(key_end - key_begin - 2));
+
+        p = skipJsonWhitespace(key_end, end);
+        if (p >= end || *p != ':')
+            return nullptr;
+        p = skipJsonWhitespace(p + 1, end);
+
+        bool wanted = false;
+        QList<QByteArray> children;
+        for (auto const& path : paths) {
+            if (path == key)
+                wanted = true;
+            else if (path.size() > key.size() && path.startsWith(key) && path.at(key.size()) == '.')
+                children.append(path.mid(key.size() + 1));
+        }
+
+        if (wanted || !children.isEmpty()) {
+            if (!first)
+                out.append(',');
+            first = false;
+            out.append(key_begin, static_cast<int>(key_end - key_begin));
+            out.append(':');
+        }
+
+        const char* value_end = nullptr;
+        if (wanted) {
+            value_end = skipJsonValue(p, end);
+            if (value_end)
+                out.append(p, static_cast<int>(value_end - p));
+        } else if (!children.isEmpty() && *p == '{') {
+            value_end = selectJsonMembers(p, end, children, out);
+        } else {
+            value_end = skipJsonValue(p, end);
+            if (value_end && !children.isEmpty())
+                out.append(p, static_cast<int>(value_end - p));
+        }
+        if (!value_end)
+            return nullptr;
+
+        p = skipJsonWhitespace(value_end, end);
+        if (p < end && *p == ',') {
+            p = skipJsonWhitespace(p + 1, end);
+            continue;
+        }
+        if (p < end && *p == '}') {
+            out.append('}');
+            return p + 1;
+        }
+        return nullptr;
+    }
+
+    return nullptr;
+}
+
+/** Parses only the given members of a JSON object. Falls back to parsing the whole document if it can't be scanned. */
+static QJsonDocument parseJsonMembers(const QByteArray& contents, const QList<QByteArray>& paths, QJsonParseError* error)
+{
+    QByteArray selected;
+    selected.reserve(contents.size());
+    if (!selectJsonMembers(contents.constData(), contents.constData() + contents.size(), paths, selected))
+        return QJsonDocument::fromJson(contents, error);
+    return QJsonDocument::fromJson(selected, error);
+}
+
 // https://fabricmc.net/wiki/documentation:fabric_mod_json
 ModDetails ReadFabricModInfo(QByteArray contents)
 {
     QJsonParseError jsonError;
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(contents, &jsonError);
+    QJsonDocument jsonDoc = parseJsonMembers(
+        contents, { "schemaVersion", "id", "version", "name", "description", "authors", "contact", "license", "icon" }, &jsonError);
     auto object = jsonDoc.object();
     auto schemaVersion = object.contains("schemaVersion") ? object.value("schemaVersion").toInt(0) : 0;
 
@@ -291,7 +450,8 @@ ModDetails ReadFabricModInfo(QByteArray contents)
 ModDetails ReadQuiltModInfo(QByteArray contents)
 {
     QJsonParseError jsonError;
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(contents, &jsonError);
+    QJsonDocument jsonDoc =
+        parseJsonMembers(contents, { "schema_version", "quilt_loader.id", "quilt_loader.version", "quilt_loader.metadata" }, &jsonError);
     auto object = Json::requireObject(jsonDoc, "quilt.mod.json");
     auto schemaVersion = Json::ensureInteger(object.value("schema_version"), 0, "Quilt schema_version");
 
@@ -459,6 +619,15 @@ bool process(Mod& mod, ProcessingLevel level)
     }
 }
 
+/** Reads the current zip entry in one go. Its uncompressed size is known upfront, so this avoids growing the buffer as we read. */
+static QByteArray readEntry(QuaZipFile& file)
+{
+    auto size = file.usize();
+    if (size <= 0)
+        return file.readAll();
+    return file.read(size);
+}
+
 bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
 {
     ModDetails details;
@@ -468,26 +637,27 @@ bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
         return false;
 
     QuaZipFile file(&zip);
+    MMCZip::EntryIndex index(&zip);
 
-    if (zip.setCurrentFile("META-INF/mods.toml") || zip.setCurrentFile("META-INF/neoforge.mods.toml")) {
+    if (index.setCurrentFile("META-INF/mods.toml") || index.setCurrentFile("META-INF/neoforge.mods.toml")) {
         if (!file.open(QIODevice::ReadOnly)) {
             zip.close();
             return false;
         }
 
-        details = ReadMCModTOML(file.readAll());
+        details = ReadMCModTOML(readEntry(file));
         file.close();
 
         // to replace ${file.jarVersion} with the actual version, as needed
         if (details.version == "${file.jarVersion}") {
-            if (zip.setCurrentFile("META-INF/MANIFEST.MF")) {
+            if (index.setCurrentFile("META-INF/MANIFEST.MF")) {
                 if (!file.open(QIODevice::ReadOnly)) {
                     zip.close();
                     return false;
                 }
 
                 // quick and dirty line-by-line parser
-                auto manifestLines = file.readAll().split('\n');
+                auto manifestLines = readEntry(file).split('\n');
                 QString manifestVersion = "";
                 for (auto& line : manifestLines) {
                     if (QString(line).startsWith("Implementation-Version: ")) {
@@ -512,60 +682,60 @@ bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
         mod.setDetails(details);
 
         return true;
-    } else if (zip.setCurrentFile("mcmod.info")) {
+    } else if (index.setCurrentFile("mcmod.info")) {
         if (!file.open(QIODevice::ReadOnly)) {
             zip.close();
             return false;
         }
 
-        details = ReadMCModInfo(file.readAll());
+        details = ReadMCModInfo(readEntry(file));
         file.close();
         zip.close();
 
         mod.setDetails(details);
         return true;
-    } else if (zip.setCurrentFile("quilt.mod.json")) {
+    } else if (index.setCurrentFile("quilt.mod.json")) {
         if (!file.open(QIODevice::ReadOnly)) {
             zip.close();
             return false;
         }
 
-        details = ReadQuiltModInfo(file.readAll());
+        details = ReadQuiltModInfo(readEntry(file));
         file.close();
         zip.close();
 
         mod.setDetails(details);
         return true;
-    } else if (zip.setCurrentFile("fabric.mod.json")) {
+    } else if (index.setCurrentFile("fabric.mod.json")) {
         if (!file.open(QIODevice::ReadOnly)) {
             zip.close();
             return false;
         }
 
-        details = ReadFabricModInfo(file.readAll());
+        details = ReadFabricModInfo(readEntry(file));
         file.close();
         zip.close();
 
         mod.setDetails(details);
         return true;
-    } else if (zip.setCurrentFile("forgeversion.properties")) {
+    } else if (index.setCurrentFile("forgeversion.properties")) {
         if (!file.open(QIODevice::ReadOnly)) {
             zip.close();
             return false;
         }
 
-        details = ReadForgeInfo(file.readAll());
+        details = ReadForgeInfo(readEntry(file));
         file.close();
         zip.close();
 
         mod.setDetails(details);
         return true;
-    } else if (zip.setCurrentFile("META-INF/nil/mappings.json")) {
+    } else if (index.setCurrentFile("META-INF/nil/mappings.json")) {
         // nilloader uses the filename of the metadata file for the modid, so we can't know the exact filename
         // thankfully, there is a good file to use as a canary so we don't look for nil meta all the time
 
         QString foundNilMeta;
-        for (auto& fname : zip.getFileNameList()) {
+        for (auto& fname : index.fileNames()) {
             // nilmods can shade nilloader to be able to run as a standalone agent - which includes nilloader's own meta file
             if (fname.endsWith(".nilmod.css") && fname != "nilloader.nilmod.css") {
                 foundNilMeta = fname;
@@ -573,13 +743,13 @@ bool processZIP(Mod& mod, [[maybe_unused]] ProcessingLevel level)
             }
         }
 
-        if (zip.setCurrentFile(foundNilMeta)) {
+        if (index.setCurrentFile(foundNilMeta)) {
             if (!file.open(QIODevice::ReadOnly)) {
                 zip.close();
                 return false;
             }
 
-            details = ReadNilModInfo(file.readAll(), foundNilMeta);
+            details = ReadNilModInfo(readEntry(file), foundNilMeta);
             file.close();
             zip.close();
 
@@ -629,7 +799,7 @@ bool processLitemod(Mod& mod, [[maybe_unused]] ProcessingLevel level)
             return false;
         }
 
-        details = ReadLiteModInfo(file.readAll());
+        details = ReadLiteModInfo(readEntry(file));
         file.close();
 
         mod.setDetails(details);
@@ -647,15 +817,45 @@ bool validate(QFileInfo file)
     return ModUtils::process(mod, ProcessingLevel::BasicInfoOnly) && mod.valid();
 }
 
+// The size icons are kept at in memory and on disk. Views draw them at most this big.
+static constexpr int s_icon_size = 64;
+
+/** Where the downscaled icon of 'mod' is stored, so we don't need to open the archive again on later runs.
+ *  The key changes whenever the file does, so stale thumbnails are simply never looked up again.
+ */
+static QString iconThumbnailPath(const Mod& mod)
+{
+    auto const& info = mod.fileinfo();
+    QCryptographicHash key(QCryptographicHash::Sha1);
+    key.addData(info.absoluteFilePath().toUtf8());
+    key.addData(QByteArray::number(info.size()));
+    key.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    key.addData(mod.iconPath().toUtf8());
+    return FS::PathCombine("cache", "thumbnails", "mods", QString::fromLatin1(key.result().toHex()) + ".png");
+}
+
 bool processIconPNG(const Mod& mod, QByteArray&& raw_data)
 {
-    auto img = QImage::fromData(raw_data);
-    if (!img.isNull()) {
-        mod.setIcon(img);
-    } else {
-        qWarning() << "Failed to parse mod logo:" << mod.iconPath() << "from" << mod.name();
+    QBuffer buffer(&raw_data);
+    QImageReader reader(&buffer);
+
+    // Decode straight to the size we keep, instead of holding the full-size image in memory first
+    auto full_size = reader.size();
+    if (full_size.isValid() && (full_size.width() > s_icon_size || full_size.height() > s_icon_size))
+        reader.setScaledSize(full_size.scaled(s_icon_size, s_icon_size, Qt::AspectRatioMode::KeepAspectRatioByExpanding));
+
+    auto img = reader.read();
+    if (img.isNull()) {
+        qWarning() << "Failed to parse mod logo:" << mod.iconPath() << "from" << mod.name() << ":" << reader.errorString();
         return false;
     }
+
+    mod.setIcon(img);
+
+    auto thumbnail_path = iconThumbnailPath(mod);
+    if (FS::ensureFilePathExists(thumbnail_path) && !img.save(thumbnail_path, "PNG"))
+        qWarning() << "Failed to save icon thumbnail for" << mod.name() << "to" << thumbnail_path;
+
     return true;
 }
 
@@ -666,6 +866,12 @@ bool loadIconFile(const Mod& mod)
         return false;
     }
 
+    QImage thumbnail;
+    if (thumbnail.load(iconThumbnailPath(mod), "PNG")) {
+        mod.setIcon(thumbnail);
+        return true;
+    }
+
     auto png_invalid = [&mod]() {
         qWarning() << "Mod at" << mod.fileinfo().filePath() << "does not have a valid icon";
         return false;
@@ -704,7 +910,7 @@ bool loadIconFile(const Mod& mod)
                     return png_invalid();
                 }
 
-                auto data = file.readAll();
+                auto data = readEntry(file);
 
                 bool icon_result = ModUtils::processIconPNG(mod, std::move(data));
 
@@ -740,6 +946,8 @@ bool LocalModParseTask::abort()
 
 void LocalModParseTask::executeTask()
 {
+    m_result->identity = Hashing::FileIdentity::of(m_modFile.absoluteFilePath());
+
     Mod mod{ m_modFile };
     ModUtils::process(mod, ModUtils::ProcessingLevel::Full);
 
@@ -5,11 +5,13 @@
 
 #include "minecraft/mod/Mod.h"
 #include "minecraft/mod/ModDetails.h"
+#include "modplatform/helpers/HashCache.h"
 
 #include "tasks/Task.h"
 
 namespace ModUtils {
 
+ModDetails ReadMCModTOML(QByteArray contents);
 ModDetails ReadFabricModInfo(QByteArray contents);
 ModDetails ReadQuiltModInfo(QByteArray contents);
 ModDetails ReadForgeInfo(QByteArray contents);
@@ -35,6 +37,8 @@ class LocalModParseTask : public Task {
    public:
     struct Result {
         ModDetails details;
+        /* What the file looked like right before it was parsed */
+        Hashing::FileIdentity identity;
     };
     using ResultPtr = std::shared_ptr<Result>;
     ResultPtr result() const { return m_result; }
@@ -20,9 +20,11 @@
 
 #include "FileSystem.h"
 #include "Json.h"
+#include "MMCZip.h"
+
+#include "minecraft/mod/PackDetailsCache.h"
 
 #include <quazip/quazip.h>
-#include <quazip/quazipdir.h>
 #include <quazip/quazipfile.h>
 
 #include <QCryptographicHash>
@@ -113,13 +115,14 @@ bool processZIP(ResourcePack& pack, ProcessingLevel level)
         return false;  // can't open zip file
 
     QuaZipFile file(&zip);
+    MMCZip::EntryIndex index(&zip);
 
     auto mcmeta_invalid = [&pack]() {
         qWarning() << "Resource pack at" << pack.fileinfo().filePath() << "does not have a valid pack.mcmeta";
         return false;  // the mcmeta is not optional
     };
 
-    if (zip.setCurrentFile("pack.mcmeta")) {
+    if (index.setCurrentFile("pack.mcmeta")) {
         if (!file.open(QIODevice::ReadOnly)) {
             qCritical() << "Failed to open file in zip.";
             zip.close();
@@ -138,8 +141,7 @@ bool processZIP(ResourcePack& pack, ProcessingLevel level)
         return mcmeta_invalid();  // could not set pack.mcmeta as current file.
     }
 
-    QuaZipDir zipDir(&zip);
-    if (!zipDir.exists("/assets")) {
+    if (!index.containsDir("/assets")) {
         return false;  // assets dir does not exists at zip root
     }
 
@@ -153,7 +155,7 @@ bool processZIP(ResourcePack& pack, ProcessingLevel level)
         return true;  // the png is optional
     };
 
-    if (zip.setCurrentFile("pack.png")) {
+    if (index.setCurrentFile("pack.png")) {
         if (!file.open(QIODevice::ReadOnly)) {
             qCritical() << "Failed to open file in zip.";
             zip.close();
@@ -196,9 +198,10 @@ bool processMCMeta(ResourcePack& pack, QByteArray&& raw_data)
 
 bool processPackPNG(const ResourcePack& pack, QByteArray&& raw_data)
 {
-    auto img = QImage::fromData(raw_data);
+    auto img = PackDetailsCache::decodeIcon(raw_data);
     if (!img.isNull()) {
         pack.setImage(img);
+        PackDetailsCache::saveThumbnail(pack.fileinfo(), img);
     } else {
         qWarning() << "Failed to parse pack.png.";
         return false;
@@ -213,6 +216,12 @@ bool processPackPNG(const ResourcePack& pack)
         return false;
     };
 
+    auto thumbnail = PackDetailsCache::loadThumbnail(pack.fileinfo());
+    if (!thumbnail.isNull()) {
+        pack.setImage(thumbnail);
+        return true;
+    }
+
     switch (pack.type()) {
         case ResourceType::FOLDER: {
             QFileInfo image_file_info(FS::PathCombine(pack.fileinfo().filePath(), "pack.png"));
@@ -274,8 +283,8 @@ bool validate(QFileInfo file)
 
 }  // namespace ResourcePackUtils
 
-LocalResourcePackParseTask::LocalResourcePackParseTask(int token, ResourcePack& rp)
-    : Task(nullptr, false), m_token(token), m_resource_pack(rp)
+LocalResourcePackParseTask::LocalResourcePackParseTask(int token, ResourcePack& rp, std::shared_ptr<PackDetailsCache> details_cache)
+    : Task(nullptr, false), m_token(token), m_resource_pack(rp), m_details_cache(std::move(details_cache))
 {}
 
 bool LocalResourcePackParseTask::abort()
@@ -286,9 +295,25 @@ bool LocalResourcePackParseTask::abort()
 
 void LocalResourcePackParseTask::executeTask()
 {
-    if (!ResourcePackUtils::process(m_resource_pack)) {
-        emitFailed("this is not a resource pack");
-        return;
+    auto const& file = m_resource_pack.fileinfo();
+    Hashing::FileIdentity identity;
+    if (m_details_cache && m_resource_pack.type() == ResourceType::ZIPFILE)
+        identity = Hashing::FileIdentity::of(file.absoluteFilePath());
+
+    if (auto details = m_details_cache ? m_details_cache->lookup(file.fileName(), identity) : std::nullopt) {
+        m_resource_pack.setPackFormat(details->pack_format);
+        m_resource_pack.setDescription(details->description);
+        if (details->has_image)
+            ResourcePackUtils::processPackPNG(m_resource_pack);
+    } else {
+        if (!ResourcePackUtils::process(m_resource_pack)) {
+            emitFailed("this is not a resource pack");
+            return;
+        }
+        if (m_details_cache)
+            m_details_cache->insert(file.fileName(), identity,
+                                    { m_resource_pack.packFormat(), m_resource_pack.description(),
+                                      QFileInfo::exists(PackDetailsCache::thumbnailPath(file)) });
     }
 
     if (m_aborted)
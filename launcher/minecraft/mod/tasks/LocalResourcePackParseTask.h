@@ -23,8 +23,12 @@
 
 #include "minecraft/mod/ResourcePack.h"
 
+#include <memory>
+
 #include "tasks/Task.h"
 
+class PackDetailsCache;
+
 namespace ResourcePackUtils {
 
 enum class ProcessingLevel { Full, BasicInfoOnly };
@@ -47,7 +51,7 @@ bool validate(QFileInfo file);
 class LocalResourcePackParseTask : public Task {
     Q_OBJECT
    public:
-    LocalResourcePackParseTask(int token, ResourcePack& rp);
+    LocalResourcePackParseTask(int token, ResourcePack& rp, std::shared_ptr<PackDetailsCache> details_cache = nullptr);
 
     [[nodiscard]] bool canAbort() const override { return true; }
     bool abort() override;
@@ -60,6 +64,7 @@ class LocalResourcePackParseTask : public Task {
     int m_token;
 
     ResourcePack& m_resource_pack;
+    std::shared_ptr<PackDetailsCache> m_details_cache;
 
     bool m_aborted = false;
 };
@@ -22,9 +22,11 @@
 #include "LocalShaderPackParseTask.h"
 
 #include "FileSystem.h"
+#include "MMCZip.h"
+
+#include "minecraft/mod/PackDetailsCache.h"
 
 #include <quazip/quazip.h>
-#include <quazip/quazipdir.h>
 #include <quazip/quazipfile.h>
 
 namespace ShaderPackUtils {
@@ -67,10 +69,8 @@ bool processZIP(ShaderPack& pack, ProcessingLevel level)
     if (!zip.open(QuaZip::mdUnzip))
         return false;  // can't open zip file
 
-    QuaZipFile file(&zip);
-
-    QuaZipDir zipDir(&zip);
-    if (!zipDir.exists("/shaders")) {
+    MMCZip::EntryIndex index(&zip);
+    if (!index.containsDir("/shaders")) {
         return false;  // assets dir does not exists at zip root
     }
     pack.setPackFormat(ShaderPackFormat::VALID);
@@ -93,7 +93,9 @@ bool validate(QFileInfo file)
 
 }  // namespace ShaderPackUtils
 
-LocalShaderPackParseTask::LocalShaderPackParseTask(int token, ShaderPack& sp) : Task(nullptr, false), m_token(token), m_shader_pack(sp) {}
+LocalShaderPackParseTask::LocalShaderPackParseTask(int token, ShaderPack& sp, std::shared_ptr<PackDetailsCache> details_cache)
+    : Task(nullptr, false), m_token(token), m_shader_pack(sp), m_details_cache(std::move(details_cache))
+{}
 
 bool LocalShaderPackParseTask::abort()
 {
@@ -103,9 +105,21 @@ bool LocalShaderPackParseTask::abort()
 
 void LocalShaderPackParseTask::executeTask()
 {
-    if (!ShaderPackUtils::process(m_shader_pack)) {
-        emitFailed("this is not a shader pack");
-        return;
+    auto const& file = m_shader_pack.fileinfo();
+    Hashing::FileIdentity identity;
+    if (m_details_cache && m_shader_pack.type() == ResourceType::ZIPFILE)
+        identity = Hashing::FileIdentity::of(file.absoluteFilePath());
+
+    // only valid packs are cached, and there's nothing else to know about them
+    if (m_details_cache && m_details_cache->lookup(file.fileName(), identity)) {
+        m_shader_pack.setPackFormat(ShaderPackFormat::VALID);
+    } else {
+        if (!ShaderPackUtils::process(m_shader_pack)) {
+            emitFailed("this is not a shader pack");
+            return;
+        }
+        if (m_details_cache)
+            m_details_cache->insert(file.fileName(), identity, {});
     }
 
     if (m_aborted)
@@ -26,8 +26,12 @@
 
 #include "minecraft/mod/ShaderPack.h"
 
+#include <memory>
+
 #include "tasks/Task.h"
 
+class PackDetailsCache;
+
 namespace ShaderPackUtils {
 
 enum class ProcessingLevel { Full, BasicInfoOnly };
@@ -44,7 +48,7 @@ bool validate(QFileInfo file);
 class LocalShaderPackParseTask : public Task {
     Q_OBJECT
    public:
-    LocalShaderPackParseTask(int token, ShaderPack& sp);
+    LocalShaderPackParseTask(int token, ShaderPack& sp, std::shared_ptr<PackDetailsCache> details_cache = nullptr);
 
     [[nodiscard]] bool canAbort() const override { return true; }
     bool abort() override;
@@ -57,6 +61,7 @@ class LocalShaderPackParseTask : public Task {
     int m_token;
 
     ShaderPack& m_shader_pack;
+    std::shared_ptr<PackDetailsCache> m_details_cache;
 
     bool m_aborted = false;
 };
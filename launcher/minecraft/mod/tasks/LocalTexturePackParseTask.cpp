@@ -20,6 +20,9 @@
 #include "LocalTexturePackParseTask.h"
 
 #include "FileSystem.h"
+#include "MMCZip.h"
+
+#include "minecraft/mod/PackDetailsCache.h"
 
 #include <quazip/quazip.h>
 #include <quazip/quazipfile.h>
@@ -96,8 +99,9 @@ bool processZIP(TexturePack& pack, ProcessingLevel level)
         return false;
 
     QuaZipFile file(&zip);
+    MMCZip::EntryIndex index(&zip);
 
-    if (zip.setCurrentFile("pack.txt")) {
+    if (index.setCurrentFile("pack.txt")) {
         if (!file.open(QIODevice::ReadOnly)) {
             qCritical() << "Failed to open file in zip.";
             zip.close();
@@ -119,7 +123,7 @@ bool processZIP(TexturePack& pack, ProcessingLevel level)
         return true;
     }
 
-    if (zip.setCurrentFile("pack.png")) {
+    if (index.setCurrentFile("pack.png")) {
         if (!file.open(QIODevice::ReadOnly)) {
             qCritical() << "Failed to open file in zip.";
             zip.close();
@@ -150,9 +154,10 @@ bool processPackTXT(TexturePack& pack, QByteArray&& raw_data)
 
 bool processPackPNG(const TexturePack& pack, QByteArray&& raw_data)
 {
-    auto img = QImage::fromData(raw_data);
+    auto img = PackDetailsCache::decodeIcon(raw_data);
     if (!img.isNull()) {
         pack.setImage(img);
+        PackDetailsCache::saveThumbnail(pack.fileinfo(), img);
     } else {
         qWarning() << "Failed to parse pack.png.";
         return false;
@@ -167,6 +172,12 @@ bool processPackPNG(const TexturePack& pack)
         return false;
     };
 
+    auto thumbnail = PackDetailsCache::loadThumbnail(pack.fileinfo());
+    if (!thumbnail.isNull()) {
+        pack.setImage(thumbnail);
+        return true;
+    }
+
     switch (pack.type()) {
         case ResourceType::FOLDER: {
             QFileInfo image_file_info(FS::PathCombine(pack.fileinfo().filePath(), "pack.png"));
@@ -230,7 +241,8 @@ bool validate(QFileInfo file)
 
 }  // namespace TexturePackUtils
 
-LocalTexturePackParseTask::LocalTexturePackParseTask(int token, TexturePack& rp) : Task(nullptr, false), m_token(token), m_texture_pack(rp)
+LocalTexturePackParseTask::LocalTexturePackParseTask(int token, TexturePack& rp, std::shared_ptr<PackDetailsCache> details_cache)
+    : Task(nullptr, false), m_token(token), m_texture_pack(rp), m_details_cache(std::move(details_cache))
 {}
 
 bool LocalTexturePackParseTask::abort()
@@ -241,9 +253,23 @@ bool LocalTexturePackParseTask::abort()
 
 void LocalTexturePackParseTask::executeTask()
 {
-    if (!TexturePackUtils::process(m_texture_pack)) {
-        emitFailed("this is not a texture pack");
-        return;
+    auto const& file = m_texture_pack.fileinfo();
+    Hashing::FileIdentity identity;
+    if (m_details_cache && m_texture_pack.type() == ResourceType::ZIPFILE)
+        identity = Hashing::FileIdentity::of(file.absoluteFilePath());
+
+    if (auto details = m_details_cache ? m_details_cache->lookup(file.fileName(), identity) : std::nullopt) {
+        m_texture_pack.setDescription(details->description);
+        if (details->has_image)
+            TexturePackUtils::processPackPNG(m_texture_pack);
+    } else {
+        if (!TexturePackUtils::process(m_texture_pack)) {
+            emitFailed("this is not a texture pack");
+            return;
+        }
+        if (m_details_cache)
+            m_details_cache->insert(file.fileName(), identity,
+                                    { 0, m_texture_pack.description(), QFileInfo::exists(PackDetailsCache::thumbnailPath(file)) });
     }
 
     if (m_aborted)
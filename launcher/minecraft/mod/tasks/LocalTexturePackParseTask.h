@@ -24,8 +24,12 @@
 
 #include "minecraft/mod/TexturePack.h"
 
+#include <memory>
+
 #include "tasks/Task.h"
 
+class PackDetailsCache;
+
 namespace TexturePackUtils {
 
 enum class ProcessingLevel { Full, BasicInfoOnly };
@@ -48,7 +52,7 @@ bool validate(QFileInfo file);
 class LocalTexturePackParseTask : public Task {
     Q_OBJECT
    public:
-    LocalTexturePackParseTask(int token, TexturePack& rp);
+    LocalTexturePackParseTask(int token, TexturePack& rp, std::shared_ptr<PackDetailsCache> details_cache = nullptr);
 
     [[nodiscard]] bool canAbort() const override { return true; }
     bool abort() override;
@@ -61,6 +65,7 @@ class LocalTexturePackParseTask : public Task {
     int m_token;
 
     TexturePack& m_texture_pack;
+    std::shared_ptr<PackDetailsCache> m_details_cache;
 
     bool m_aborted = false;
 };
@@ -39,30 +39,129 @@
 #include "minecraft/mod/MetadataHandler.h"
 
 #include <QThread>
+#include <QtConcurrentMap>
 
-ModFolderLoadTask::ModFolderLoadTask(QDir mods_dir, QDir index_dir, bool is_indexed, bool clean_orphan)
+ModFolderLoadTask::ModFolderLoadTask(QDir mods_dir,
+                                     QDir index_dir,
+                                     bool is_indexed,
+                                     bool clean_orphan,
+                                     std::shared_ptr<ModDetailsCache> details_cache,
+                                     SnapshotPtr previous)
     : Task(nullptr, false)
     , m_mods_dir(mods_dir)
     , m_index_dir(index_dir)
     , m_is_indexed(is_indexed)
     , m_clean_orphan(clean_orphan)
+    , m_details_cache(std::move(details_cache))
+    , m_previous(std::move(previous))
     , m_result(new Result())
     , m_thread_to_spawn_into(thread())
 {}
 
+static ModFolderLoadTask::FileStamp stampOf(const QFileInfo& entry)
+{
+    return { entry.size(), entry.lastModified() };
+}
+
 void ModFolderLoadTask::executeTask()
 {
     if (thread() != m_thread_to_spawn_into)
         connect(this, &Task::finished, this->thread(), &QThread::quit);
 
+    auto snapshot = std::make_shared<Snapshot>();
+
+    m_mods_dir.refresh();
+    auto entries = m_mods_dir.entryInfoList();
+    for (auto const& entry : entries)
+        snapshot->mod_files.insert(entry.fileName(), stampOf(entry));
+
+    if (m_is_indexed) {
+        m_index_dir.refresh();
+        for (auto const& entry : m_index_dir.entryInfoList(QDir::Files))
+            snapshot->index_files.insert(entry.fileName(), stampOf(entry));
+    }
+
+    if (canLoadIncrementally(*snapshot)) {
+        loadChanged(entries, *snapshot);
+        snapshot->managed = m_previous->managed;
+    } else {
+        loadAll(entries);
+        for (auto const& mod : m_result->mods)
+            if (mod->metadata() || mod->status() == ModStatus::NotInstalled)
+                snapshot->managed.insert(mod->internal_id());
+    }
+
+    if (m_details_cache)
+        getFromDetailsCache();
+
+    for (auto mod : m_result->mods)
+        mod->moveToThread(m_thread_to_spawn_into);
+
+    m_result->snapshot = std::move(snapshot);
+
+    if (m_aborted)
+        emit finished();
+    else
+        emitSucceeded();
+}
+
+bool ModFolderLoadTask::canLoadIncrementally(const Snapshot& current) const
+{
+    // Orphan cleanup needs to look at every metadata file
+    if (!m_previous || m_clean_orphan)
+        return false;
+
+    // Pairing mods with their metadata can move things around in ways a simple diff can't follow, so any
+    // change to the index, or to a file tied to some metadata, makes us go through everything again.
+    if (current.index_files != m_previous->index_files)
+        return false;
+
+    auto is_managed = [this](const QString& file_name) {
+        if (m_previous->managed.contains(file_name) || m_previous->managed.contains(file_name + ".disabled"))
+            return true;
+        return file_name.endsWith(".disabled") && m_previous->managed.contains(file_name.chopped(9));
+    };
+
+    for (auto it = current.mod_files.constBegin(); it != current.mod_files.constEnd(); ++it) {
+        auto previous = m_previous->mod_files.constFind(it.key());
+        if ((previous == m_previous->mod_files.constEnd() || previous.value() != it.value()) && is_managed(it.key()))
+            return false;
+    }
+    for (auto it = m_previous->mod_files.constBegin(); it != m_previous->mod_files.constEnd(); ++it) {
+        if (!current.mod_files.contains(it.key()) && is_managed(it.key()))
+            return false;
+    }
+
+    return true;
+}
+
+void ModFolderLoadTask::loadChanged(const QFileInfoList& entries, const Snapshot& current)
+{
+    for (auto const& entry : entries) {
+        auto file_name = entry.fileName();
+
+        auto previous = m_previous->mod_files.constFind(file_name);
+        if (previous != m_previous->mod_files.constEnd() && previous.value() == current.mod_files.value(file_name)) {
+            m_result->unchanged.insert(file_name);
+            continue;
+        }
+
+        // canLoadIncrementally() made sure none of these have metadata
+        Mod::Ptr mod(new Mod(entry));
+        mod->setStatus(ModStatus::NoMetadata);
+        m_result->mods.insert(mod->internal_id(), mod);
+    }
+}
+
+void ModFolderLoadTask::loadAll(const QFileInfoList& entries)
+{
     if (m_is_indexed) {
         // Read metadata first
         getFromMetadata();
     }
 
     // Read JAR files that don't have metadata
-    m_mods_dir.refresh();
-    for (auto entry : m_mods_dir.entryInfoList()) {
+    for (auto entry : entries) {
         Mod* mod(new Mod(entry));
 
         if (mod->enabled()) {
@@ -105,22 +204,23 @@ void ModFolderLoadTask::executeTask()
             }
         }
     }
-
-    for (auto mod : m_result->mods)
-        mod->moveToThread(m_thread_to_spawn_into);
-
-    if (m_aborted)
-        emit finished();
-    else
-        emitSucceeded();
 }
 
 void ModFolderLoadTask::getFromMetadata()
 {
     m_index_dir.refresh();
-    for (auto entry : m_index_dir.entryList(QDir::Files)) {
-        auto metadata = Metadata::get(m_index_dir, entry);
+    auto entries = m_index_dir.entryList(QDir::Files);
+
+    // Reading and parsing the index files is independent for each of them, so spread it over the pool.
+    // The results come back in the same order as 'entries', which keeps the merge below deterministic.
+    auto index_path = m_index_dir.absolutePath();
+    auto metadatas = QtConcurrent::blockingMapped<QList<Metadata::ModStruct>>(entries, [index_path](const QString& entry) {
+        // QDir caches listings internally, so every worker needs its own
+        QDir index_dir(index_path);
+        return Metadata::get(index_dir, entry);
+    });
 
+    for (auto& metadata : metadatas) {
         if (!metadata.isValid()) {
             continue;
         }
@@ -130,3 +230,29 @@ void ModFolderLoadTask::getFromMetadata()
         m_result->mods[mod->internal_id()].reset(std::move(mod));
     }
 }
+
+void ModFolderLoadTask::getFromDetailsCache()
+{
+    QSet<QString> file_names;
+    for (auto mod : m_result->mods) {
+        if (mod->status() == ModStatus::NotInstalled)
+            continue;
+
+        auto file_name = mod->fileinfo().fileName();
+        file_names.insert(file_name);
+
+        // Folders can change without their own modification time changing, so always parse them
+        if (mod->type() != ResourceType::ZIPFILE && mod->type() != ResourceType::LITEMOD)
+            continue;
+
+        // Resolved mods are skipped by the model, so no parse task gets queued for these
+        auto details = m_details_cache->lookup(file_name, Hashing::FileIdentity::of(mod->fileinfo().absoluteFilePath()));
+        if (details)
+            mod->finishResolvingWithDetails(std::move(*details));
+    }
+
+    // Mods skipped by an incremental load keep whatever details the model already has for them
+    file_names.unite(m_result->unchanged);
+
+    m_details_cache->retain(file_names);
+}
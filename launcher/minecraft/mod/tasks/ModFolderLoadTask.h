@@ -36,25 +36,55 @@
 
 #pragma once
 
+#include <QDateTime>
 #include <QDir>
+#include <QHash>
 #include <QMap>
 #include <QObject>
 #include <QRunnable>
+#include <QSet>
 #include <memory>
 #include "minecraft/mod/Mod.h"
+#include "minecraft/mod/ModDetailsCache.h"
 #include "tasks/Task.h"
 
 class ModFolderLoadTask : public Task {
     Q_OBJECT
    public:
+    /** What a file looked like the last time we listed it. */
+    struct FileStamp {
+        qint64 size = -1;
+        QDateTime modified;
+
+        bool operator==(const FileStamp& other) const { return size == other.size && modified == other.modified; }
+        bool operator!=(const FileStamp& other) const { return !(*this == other); }
+    };
+
+    /** The state of the folders after a load, used by the next load to only look at what changed. */
+    struct Snapshot {
+        QHash<QString, FileStamp> mod_files;
+        QHash<QString, FileStamp> index_files;
+        // Internal IDs of mods that are tied to some metadata file
+        QSet<QString> managed;
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
     struct Result {
         QMap<QString, Mod::Ptr> mods;
+        // Internal IDs of mods that didn't change since the previous snapshot, and thus aren't in 'mods'
+        QSet<QString> unchanged;
+        SnapshotPtr snapshot;
     };
     using ResultPtr = std::shared_ptr<Result>;
     ResultPtr result() const { return m_result; }
 
    public:
-    ModFolderLoadTask(QDir mods_dir, QDir index_dir, bool is_indexed, bool clean_orphan = false);
+    ModFolderLoadTask(QDir mods_dir,
+                      QDir index_dir,
+                      bool is_indexed,
+                      bool clean_orphan = false,
+                      std::shared_ptr<ModDetailsCache> details_cache = nullptr,
+                      SnapshotPtr previous = nullptr);
 
     [[nodiscard]] bool canAbort() const override { return true; }
     bool abort() override
@@ -67,11 +97,18 @@ class ModFolderLoadTask : public Task {
 
    private:
     void getFromMetadata();
+    void getFromDetailsCache();
+
+    void loadAll(const QFileInfoList& entries);
+    void loadChanged(const QFileInfoList& entries, const Snapshot& current);
+    [[nodiscard]] bool canLoadIncrementally(const Snapshot& current) const;
 
    private:
     QDir m_mods_dir, m_index_dir;
     bool m_is_indexed;
     bool m_clean_orphan;
+    std::shared_ptr<ModDetailsCache> m_details_cache;
+    SnapshotPtr m_previous;
     ResultPtr m_result;
 
     std::atomic<bool> m_aborted = false;
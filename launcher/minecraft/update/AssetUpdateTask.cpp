@@ -8,6 +8,7 @@
 #include "Application.h"
 
 #include "net/ApiDownload.h"
+#include "tasks/SharedWork.h"
 
 AssetUpdateTask::AssetUpdateTask(MinecraftInstance* inst)
 {
@@ -22,6 +23,11 @@ void AssetUpdateTask::executeTask()
     auto components = m_inst->getPackProfile();
     auto profile = components->getProfile();
     auto assets = profile->getMinecraftAssets();
+    // instances launched together mostly share their assets, checking them once is enough
+    if (auto owner = SharedWork::claim("assets/" + assets->id + "/" + assets->sha1, this)) {
+        follow(owner);
+        return;
+    }
     QUrl indexUrl = assets->url;
     QString localPath = assets->id + ".json";
     auto job = makeShared<NetJob>(tr("Asset index for %1").arg(m_inst->name()), APPLICATION->network());
@@ -48,6 +54,28 @@ void AssetUpdateTask::executeTask()
     downloadJob->start();
 }
 
+void AssetUpdateTask::follow(Task* owner)
+{
+    setStatus(tr("Waiting for another instance's assets..."));
+    m_owner = owner;
+    connect(owner, &Task::succeeded, this, [this] {
+        m_owner.clear();
+        if (isRunning())
+            emitSucceeded();
+    });
+    connect(owner, &Task::failed, this, [this](QString reason) {
+        m_owner.clear();
+        if (isRunning())
+            emitFailed(reason);
+    });
+    // the other launch was cancelled, this one still needs the assets
+    connect(owner, &Task::aborted, this, [this] {
+        m_owner.clear();
+        if (isRunning())
+            executeTask();
+    });
+}
+
 bool AssetUpdateTask::canAbort() const
 {
     return true;
@@ -69,6 +97,7 @@ void AssetUpdateTask::assetIndexFinished()
         auto entry = metacache->resolveEntry("asset_indexes", assets->id + ".json");
         metacache->evictEntry(entry);
         emitFailed(tr("Failed to read the assets index!"));
+        return;
     }
 
     auto job = index.getDownloadJob();
@@ -99,7 +128,11 @@ void AssetUpdateTask::assetsFailed(QString reason)
 
 bool AssetUpdateTask::abort()
 {
-    if (downloadJob) {
+    if (m_owner) {
+        disconnect(m_owner, nullptr, this, nullptr);
+        m_owner.clear();
+        emitAborted();
+    } else if (downloadJob) {
         return downloadJob->abort();
     } else {
         qWarning() << "Prematurely aborted AssetUpdateTask";
@@ -1,4 +1,5 @@
 #pragma once
+#include <QPointer>
 #include "net/NetJob.h"
 #include "tasks/Task.h"
 class MinecraftInstance;
@@ -21,7 +22,12 @@ class AssetUpdateTask : public Task {
    public slots:
     bool abort() override;
 
+   private:
+    void follow(Task* owner);
+
    private:
     MinecraftInstance* m_inst;
     NetJob::Ptr downloadJob;
+    // the task updating the same assets for another instance, if this one waits for it
+    QPointer<Task> m_owner;
 };
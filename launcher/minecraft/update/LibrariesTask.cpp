@@ -1,13 +1,19 @@
 #include "LibrariesTask.h"
 
+#include <QCryptographicHash>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
 
 #include "Application.h"
+#include "tasks/SharedWork.h"
 
 LibrariesTask::LibrariesTask(MinecraftInstance* inst)
 {
     m_inst = inst;
+    connect(&m_checkWatcher, &QFutureWatcher<QHash<QString, QFileInfo>>::finished, this, &LibrariesTask::filesChecked);
 }
 
 void LibrariesTask::executeTask()
@@ -20,38 +26,111 @@ void LibrariesTask::executeTask()
     auto components = inst->getPackProfile();
     auto profile = components->getProfile();
 
-    NetJob::Ptr job{ new NetJob(tr("Libraries for instance %1").arg(inst->name()), APPLICATION->network()) };
-    downloadJob.reset(job);
+    m_libArtifactPool.clear();
+    m_libArtifactPool.append(profile->getLibraries());
+    m_libArtifactPool.append(profile->getNativeLibraries());
+    m_libArtifactPool.append(profile->getMavenFiles());
+    for (auto agent : profile->getAgents()) {
+        m_libArtifactPool.append(agent->library());
+    }
+    m_libArtifactPool.append(profile->getMainJar());
+    m_jarModPool = profile->getJarMods();
 
     auto metacache = APPLICATION->metacache();
-
-    auto processArtifactPool = [&](const QList<LibraryPtr>& pool, QStringList& errors, const QString& localPath) {
+    QStringList files;
+    auto collectFiles = [&](const QList<LibraryPtr>& pool, const QString& localPath) {
         for (auto lib : pool) {
             if (!lib) {
                 emitFailed(tr("Null jar is specified in the metadata, aborting."));
                 return false;
             }
-            auto dls = lib->getDownloads(inst->runtimeContext(), metacache.get(), errors, localPath);
+            files.append(lib->getDownloadFiles(inst->runtimeContext(), metacache.get(), localPath));
+        }
+        return true;
+    };
+    if (!collectFiles(m_libArtifactPool, inst->getLocalLibraryPath()) || !collectFiles(m_jarModPool, inst->jarModsDir())) {
+        return;
+    }
+
+    // instances of the same pack launched together would all check (and download) the very same files
+    QStringList sortedFiles = files;
+    sortedFiles.sort();
+    auto key = "libraries/" + QString::fromLatin1(QCryptographicHash::hash(sortedFiles.join('\n').toUtf8(), QCryptographicHash::Sha1).toHex());
+    if (auto owner = SharedWork::claim(key, this)) {
+        follow(owner);
+        return;
+    }
+
+    // look at all the files on the worker pool, the libraries folder may well be on a slow disk
+    m_checkWatcher.setFuture(QtConcurrent::run([files] {
+        auto checked = QtConcurrent::blockingMapped<QList<QFileInfo>>(files, [](const QString& path) {
+            QFileInfo info(path);
+            // fill in everything the metacache looks at, while we are still on the worker
+            info.exists();
+            info.isFile();
+            info.isReadable();
+            info.lastModified();
+            return info;
+        });
+        QHash<QString, QFileInfo> out;
+        out.reserve(checked.size());
+        for (auto& info : checked) {
+            out.insert(info.filePath(), info);
+        }
+        return out;
+    }));
+}
+
+void LibrariesTask::follow(Task* owner)
+{
+    setStatus(tr("Waiting for another instance's libraries..."));
+    m_owner = owner;
+    connect(owner, &Task::succeeded, this, [this] {
+        m_owner.clear();
+        if (isRunning())
+            emitSucceeded();
+    });
+    connect(owner, &Task::failed, this, [this](QString reason) {
+        m_owner.clear();
+        if (isRunning())
+            emitFailed(reason);
+    });
+    // the other launch was cancelled, this one still needs the files
+    connect(owner, &Task::aborted, this, [this] {
+        m_owner.clear();
+        if (isRunning())
+            executeTask();
+    });
+}
+
+void LibrariesTask::filesChecked()
+{
+    // We were aborted while the files were being checked
+    if (!isRunning())
+        return;
+
+    MinecraftInstance* inst = (MinecraftInstance*)m_inst;
+    auto knownFiles = m_checkWatcher.result();
+
+    NetJob::Ptr job{ new NetJob(tr("Libraries for instance %1").arg(inst->name()), APPLICATION->network()) };
+    downloadJob.reset(job);
+
+    auto metacache = APPLICATION->metacache();
+
+    auto processArtifactPool = [&](const QList<LibraryPtr>& pool, QStringList& errors, const QString& localPath) {
+        for (auto lib : pool) {
+            auto dls = lib->getDownloads(inst->runtimeContext(), metacache.get(), errors, localPath, knownFiles);
             for (auto dl : dls) {
                 downloadJob->addNetAction(dl);
             }
         }
-        return true;
     };
 
     QStringList failedLocalLibraries;
-    QList<LibraryPtr> libArtifactPool;
-    libArtifactPool.append(profile->getLibraries());
-    libArtifactPool.append(profile->getNativeLibraries());
-    libArtifactPool.append(profile->getMavenFiles());
-    for (auto agent : profile->getAgents()) {
-        libArtifactPool.append(agent->library());
-    }
-    libArtifactPool.append(profile->getMainJar());
-    processArtifactPool(libArtifactPool, failedLocalLibraries, inst->getLocalLibraryPath());
+    processArtifactPool(m_libArtifactPool, failedLocalLibraries, inst->getLocalLibraryPath());
 
     QStringList failedLocalJarMods;
-    processArtifactPool(profile->getJarMods(), failedLocalJarMods, inst->jarModsDir());
+    processArtifactPool(m_jarModPool, failedLocalJarMods, inst->jarModsDir());
 
     if (!failedLocalJarMods.empty() || !failedLocalLibraries.empty()) {
         downloadJob.reset();
@@ -83,8 +162,15 @@ void LibrariesTask::jarlibFailed(QString reason)
 
 bool LibrariesTask::abort()
 {
-    if (downloadJob) {
+    if (m_owner) {
+        disconnect(m_owner, nullptr, this, nullptr);
+        m_owner.clear();
+        emitAborted();
+    } else if (downloadJob) {
         return downloadJob->abort();
+    } else if (m_checkWatcher.isRunning()) {
+        // the check can't be interrupted, its result is ignored once it's done
+        emitAborted();
     } else {
         qWarning() << "Prematurely aborted LibrariesTask";
     }
@@ -1,4 +1,9 @@
 #pragma once
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QPointer>
+#include "minecraft/Library.h"
 #include "net/NetJob.h"
 #include "tasks/Task.h"
 class MinecraftInstance;
@@ -14,12 +19,22 @@ class LibrariesTask : public Task {
     bool canAbort() const override;
 
    private slots:
+    void filesChecked();
     void jarlibFailed(QString reason);
 
    public slots:
     bool abort() override;
 
+   private:
+    void follow(Task* owner);
+
    private:
     MinecraftInstance* m_inst;
     NetJob::Ptr downloadJob;
+    // the task checking the very same files for another instance, if this one waits for it
+    QPointer<Task> m_owner;
+
+    QList<LibraryPtr> m_libArtifactPool;
+    QList<LibraryPtr> m_jarModPool;
+    QFutureWatcher<QHash<QString, QFileInfo>> m_checkWatcher;
 };
@@ -20,57 +20,80 @@ static ModPlatform::ProviderCapabilities ProviderCaps;
 static ModrinthAPI modrinth_api;
 static FlameAPI flame_api;
 
+namespace {
+// Hashes per request, so the first answers come in while the rest is still being hashed
+constexpr int REQUEST_BATCH_SIZE = 100;
+}  // namespace
+
 EnsureMetadataTask::EnsureMetadataTask(Mod* mod, QDir dir, ModPlatform::ResourceProvider prov)
-    : Task(nullptr), m_index_dir(dir), m_provider(prov), m_hashing_task(nullptr), m_current_task(nullptr)
+    : Task(nullptr), m_index_dir(dir), m_provider(prov)
 {
-    auto hash_task = createNewHash(mod);
-    if (!hash_task)
-        return;
-    connect(hash_task.get(), &Hashing::Hasher::resultsReady, [this, mod](QString hash) { m_mods.insert(hash, mod); });
-    connect(hash_task.get(), &Task::failed, [this, mod] { emitFail(mod, "", RemoveFromList::No); });
-    hash_task->start();
+    m_lookups.append({ prov, {}, {} });
+    m_hashing_task.reset(new ConcurrentTask(this, "MakeHashesTask", 1));
+    connect(m_hashing_task.get(), &Task::finished, this, [this] {
+        m_hashing_done = true;
+        if (!isRunning())
+            return;
+        for (int i = 0; i < m_lookups.size(); i++)
+            sendQueued(i, true);
+        checkDone();
+    });
+
+    if (mod)
+        m_all_mods.append(mod);
+    addHashTasks(mod);
+
+    // Hashing happens in the background, so start it right away and wait for it in executeTask if needed
+    m_hashing_task->start();
 }
 
 EnsureMetadataTask::EnsureMetadataTask(QList<Mod*>& mods, QDir dir, ModPlatform::ResourceProvider prov)
-    : Task(nullptr), m_index_dir(dir), m_provider(prov), m_current_task(nullptr)
+    : EnsureMetadataTask(mods, dir, prov, prov)
+{}
+
+EnsureMetadataTask::EnsureMetadataTask(QList<Mod*>& mods,
+                                       QDir dir,
+                                       ModPlatform::ResourceProvider preferred,
+                                       ModPlatform::ResourceProvider fallback)
+    : Task(nullptr), m_all_mods(mods), m_index_dir(dir), m_provider(preferred)
 {
-    m_hashing_task.reset(new ConcurrentTask(this, "MakeHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()));
-    for (auto* mod : mods) {
-        auto hash_task = createNewHash(mod);
-        if (!hash_task)
-            continue;
-        connect(hash_task.get(), &Hashing::Hasher::resultsReady, [this, mod](QString hash) { m_mods.insert(hash, mod); });
-        connect(hash_task.get(), &Task::failed, [this, mod] { emitFail(mod, "", RemoveFromList::No); });
-        m_hashing_task->addTask(hash_task);
-    }
-}
+    m_lookups.append({ preferred, {}, {} });
+    if (fallback != preferred)
+        m_lookups.append({ fallback, {}, {} });
 
-Hashing::Hasher::Ptr EnsureMetadataTask::createNewHash(Mod* mod)
-{
-    if (!mod || !mod->valid() || mod->type() == ResourceType::FOLDER)
-        return nullptr;
+    m_hashing_task.reset(new ConcurrentTask(this, "MakeHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()));
+    connect(m_hashing_task.get(), &Task::finished, this, [this] {
+        m_hashing_done = true;
+        if (!isRunning())
+            return;
+        for (int i = 0; i < m_lookups.size(); i++)
+            sendQueued(i, true);
+        checkDone();
+    });
 
-    return Hashing::createHasher(mod->fileinfo().absoluteFilePath(), m_provider);
+    for (auto* mod : mods)
+        addHashTasks(mod);
 }
 
-QString EnsureMetadataTask::getExistingHash(Mod* mod)
+void EnsureMetadataTask::addHashTasks(Mod* mod)
 {
-    // Check for already computed hashes
-    // (linear on the number of mods vs. linear on the size of the mod's JAR)
-    auto it = m_mods.keyValueBegin();
-    while (it != m_mods.keyValueEnd()) {
-        if ((*it).second == mod)
-            break;
-        it++;
-    }
-
-    // We already have the hash computed
-    if (it != m_mods.keyValueEnd()) {
-        return (*it).first;
-    }
+    if (!mod || !mod->valid() || mod->type() == ResourceType::FOLDER)
+        return;
 
-    // No existing hash
-    return {};
+    // each provider wants its own kind of hash, all of them come from a single read of the file
+    QList<ModPlatform::ResourceProvider> providers;
+    for (auto& lookup : m_lookups)
+        providers.append(lookup.provider);
+    auto hash_task = makeShared<Hashing::MultiHasher>(mod->fileinfo().absoluteFilePath(), providers);
+    connect(hash_task.get(), &Hashing::MultiHasher::resultsReady, this, [this, mod](QHash<QString, QString> hashes) {
+        for (int i = 0; i < m_lookups.size(); i++)
+            onHashed(i, mod, hashes.value(Hashing::MultiHasher::hashTypeOf(m_lookups[i].provider)));
+    });
+    connect(hash_task.get(), &Task::failed, this, [this, mod] {
+        for (int i = 0; i < m_lookups.size(); i++)
+            setOutcome(i, mod, {});
+    });
+    m_hashing_task->addTask(hash_task);
 }
 
 bool EnsureMetadataTask::abort()
@@ -78,8 +101,12 @@ bool EnsureMetadataTask::abort()
     // Prevent sending signals to a dead object
     disconnect(this, 0, 0, 0);
 
-    if (m_current_task)
-        return m_current_task->abort();
+    if (isRunning())
+        emitAborted();
+    if (m_hashing_task)
+        m_hashing_task->abort();
+    for (auto& request : QList<Task::Ptr>(m_requests))
+        request->abort();
     return true;
 }
 
@@ -87,7 +114,7 @@ void EnsureMetadataTask::executeTask()
 {
     setStatus(tr("Checking if mods have metadata..."));
 
-    for (auto* mod : m_mods) {
+    for (auto* mod : m_all_mods) {
         if (!mod->valid()) {
             qDebug() << "Mod" << mod->name() << "is invalid!";
             emitFail(mod);
@@ -107,124 +134,183 @@ void EnsureMetadataTask::executeTask()
         }
     }
 
-    Task::Ptr version_task;
-
-    switch (m_provider) {
-        case (ModPlatform::ResourceProvider::MODRINTH):
-            version_task = modrinthVersionsTask();
-            break;
-        case (ModPlatform::ResourceProvider::FLAME):
-            version_task = flameVersionsTask();
-            break;
+    auto pending = m_all_mods.size() - m_decided.size();
+    if (pending > 1)
+        setStatus(tr("Requesting metadata information from %1...").arg(ProviderCaps.readableName(m_provider)));
+    else if (pending == 1)
+        for (auto* mod : m_all_mods)
+            if (!m_decided.contains(mod))
+                setStatus(tr("Requesting metadata information from %1 for '%2'...").arg(ProviderCaps.readableName(m_provider), mod->name()));
+
+    // The lookups are sent as the hashes come in, instead of waiting for all of them
+    if (!m_hashing_done) {
+        if (!m_hashing_task->isRunning())
+            m_hashing_task->start();
+        else
+            for (int i = 0; i < m_lookups.size(); i++)
+                sendQueued(i, false);
+        return;
     }
 
-    auto invalidade_leftover = [this] {
-        for (auto mod = m_mods.constBegin(); mod != m_mods.constEnd(); mod++)
-            emitFail(mod.value(), mod.key(), RemoveFromList::No);
-        m_mods.clear();
+    for (int i = 0; i < m_lookups.size(); i++)
+        sendQueued(i, true);
+    checkDone();
+}
 
-        emitSucceeded();
-    };
+void EnsureMetadataTask::onHashed(int lookup, Mod* mod, QString hash)
+{
+    m_lookups[lookup].mods.insert(hash, mod);
+    m_lookups[lookup].queued.append(hash);
+    sendQueued(lookup, false);
+}
 
-    connect(version_task.get(), &Task::finished, this, [this, invalidade_leftover] {
-        Task::Ptr project_task;
+void EnsureMetadataTask::sendQueued(int lookup, bool partial)
+{
+    if (!isRunning())
+        return;
+
+    auto& queued = m_lookups[lookup].queued;
+    while (queued.size() >= REQUEST_BATCH_SIZE || (partial && !queued.isEmpty())) {
+        QStringList hashes;
+        for (auto& hash : queued.mid(0, REQUEST_BATCH_SIZE)) {
+            // settled already, by a preferred provider or before the task started
+            if (!m_decided.contains(m_lookups[lookup].mods.value(hash)))
+                hashes.append(hash);
+        }
+        queued = queued.mid(REQUEST_BATCH_SIZE);
+        if (hashes.isEmpty())
+            continue;
 
-        switch (m_provider) {
+        switch (m_lookups[lookup].provider) {
             case (ModPlatform::ResourceProvider::MODRINTH):
-                project_task = modrinthProjectsTask();
+                runRequest(modrinthVersionsTask(lookup, hashes));
                 break;
             case (ModPlatform::ResourceProvider::FLAME):
-                project_task = flameProjectsTask();
+                runRequest(flameVersionsTask(lookup, hashes));
                 break;
         }
+    }
+}
 
-        if (!project_task) {
-            invalidade_leftover();
-            return;
+void EnsureMetadataTask::runRequest(Task::Ptr request)
+{
+    // Prevents unfortunate timings when aborting the task
+    if (!request)
+        return;
+
+    m_requests.append(request);
+    auto raw = request.get();
+    connect(raw, &Task::finished, this, [this, raw] { requestFinished(raw); });
+    request->start();
+}
+
+void EnsureMetadataTask::requestFinished(Task* request)
+{
+    for (auto it = m_requests.begin(); it != m_requests.end(); ++it) {
+        if (it->get() == request) {
+            m_requests.erase(it);
+            break;
         }
+    }
+    checkDone();
+}
 
-        connect(project_task.get(), &Task::finished, this, [=] {
-            invalidade_leftover();
-            project_task->deleteLater();
-            if (m_current_task)
-                m_current_task.reset();
-        });
-        connect(project_task.get(), &Task::failed, this, &EnsureMetadataTask::emitFailed);
+void EnsureMetadataTask::setOutcome(int lookup, Mod* mod, std::optional<Found> found)
+{
+    if (!isRunning() || !mod || m_decided.contains(mod))
+        return;
+    // the first answer of a provider is the one that counts
+    auto& outcomes = m_outcomes[mod];
+    if (outcomes.contains(lookup))
+        return;
+    outcomes.insert(lookup, std::move(found));
+    decide(mod);
+}
 
-        m_current_task = project_task;
-        project_task->start();
-    });
+void EnsureMetadataTask::decide(Mod* mod)
+{
+    auto& outcomes = m_outcomes[mod];
+    for (int i = 0; i < m_lookups.size(); i++) {
+        auto outcome = outcomes.constFind(i);
+        // a more preferred provider hasn't answered yet
+        if (outcome == outcomes.constEnd())
+            return;
+        if (!outcome->has_value())
+            continue;
 
-    connect(version_task.get(), &Task::finished, [=] {
-        version_task->deleteLater();
-        if (m_current_task)
-            m_current_task.reset();
-    });
+        auto found = outcome->value();
+        m_outcomes.remove(mod);
+        switch (m_lookups[i].provider) {
+            case (ModPlatform::ResourceProvider::MODRINTH):
+                setStatus(tr("Parsing API response from Modrinth for '%1'...").arg(mod->name()));
+                modrinthCallback(found.pack, found.version, mod);
+                break;
+            case (ModPlatform::ResourceProvider::FLAME):
+                setStatus(tr("Parsing API response from CurseForge for '%1'...").arg(mod->name()));
+                flameCallback(found.pack, found.version, mod);
+                break;
+        }
+        return;
+    }
 
-    if (m_mods.size() > 1)
-        setStatus(tr("Requesting metadata information from %1...").arg(ProviderCaps.readableName(m_provider)));
-    else if (!m_mods.empty())
-        setStatus(tr("Requesting metadata information from %1 for '%2'...")
-                      .arg(ProviderCaps.readableName(m_provider), m_mods.begin().value()->name()));
+    m_outcomes.remove(mod);
+    emitFail(mod);
+}
+
+void EnsureMetadataTask::checkDone()
+{
+    if (!isRunning() || !m_hashing_done || !m_requests.isEmpty())
+        return;
+
+    for (auto* mod : m_all_mods)
+        if (!m_decided.contains(mod))
+            emitFail(mod);
 
-    m_current_task = version_task;
-    version_task->start();
+    emitSucceeded();
 }
 
-void EnsureMetadataTask::emitReady(Mod* m, QString key, RemoveFromList remove)
+void EnsureMetadataTask::emitReady(Mod* m)
 {
     if (!m) {
         qCritical() << "Tried to mark a null mod as ready.";
-        if (!key.isEmpty())
-            m_mods.remove(key);
-
         return;
     }
+    if (m_decided.contains(m))
+        return;
+    m_decided.insert(m);
 
     qDebug() << QString("Generated metadata for %1").arg(m->name());
     emit metadataReady(m);
-
-    if (remove == RemoveFromList::Yes) {
-        if (key.isEmpty())
-            key = getExistingHash(m);
-        m_mods.remove(key);
-    }
 }
 
-void EnsureMetadataTask::emitFail(Mod* m, QString key, RemoveFromList remove)
+void EnsureMetadataTask::emitFail(Mod* m)
 {
     if (!m) {
         qCritical() << "Tried to mark a null mod as failed.";
-        if (!key.isEmpty())
-            m_mods.remove(key);
-
         return;
     }
+    if (m_decided.contains(m))
+        return;
+    m_decided.insert(m);
 
     qDebug() << QString("Failed to generate metadata for %1").arg(m->name());
     emit metadataFailed(m);
-
-    if (remove == RemoveFromList::Yes) {
-        if (key.isEmpty())
-            key = getExistingHash(m);
-        m_mods.remove(key);
-    }
 }
 
 // Modrinth
 
-Task::Ptr EnsureMetadataTask::modrinthVersionsTask()
+Task::Ptr EnsureMetadataTask::modrinthVersionsTask(int lookup, QStringList hashes)
 {
     auto hash_type = ProviderCaps.hashType(ModPlatform::ResourceProvider::MODRINTH).first();
 
     auto response = std::make_shared<QByteArray>();
-    auto ver_task = modrinth_api.currentVersions(m_mods.keys(), hash_type, response);
+    auto ver_task = modrinth_api.currentVersions(hashes, hash_type, response);
 
     // Prevents unfortunate timings when aborting the task
     if (!ver_task)
         return Task::Ptr{ nullptr };
 
-    connect(ver_task.get(), &Task::succeeded, this, [this, response] {
+    connect(ver_task.get(), &Task::succeeded, this, [this, lookup, hashes, response] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
@@ -232,75 +318,72 @@ Task::Ptr EnsureMetadataTask::modrinthVersionsTask()
                        << " reason: " << parse_error.errorString();
             qWarning() << *response;
 
-            failed(parse_error.errorString());
+            for (auto& hash : hashes)
+                setOutcome(lookup, m_lookups[lookup].mods.value(hash), {});
             return;
         }
 
-        try {
-            auto entries = Json::requireObject(doc);
-            for (auto& hash : m_mods.keys()) {
-                auto mod = m_mods.find(hash).value();
-                try {
-                    auto entry = Json::requireObject(entries, hash);
+        QHash<QString, ModPlatform::IndexedVersion> versions;
+        auto entries = doc.object();
+        for (auto& hash : hashes) {
+            auto mod = m_lookups[lookup].mods.value(hash);
+            try {
+                auto entry = Json::requireObject(entries, hash);
 
-                    setStatus(tr("Parsing API response from Modrinth for '%1'...").arg(mod->name()));
-                    qDebug() << "Getting version for" << mod->name() << "from Modrinth";
+                qDebug() << "Getting version for" << mod->name() << "from Modrinth";
 
-                    m_temp_versions.insert(hash, Modrinth::loadIndexedPackVersion(entry));
-                } catch (Json::JsonException& e) {
-                    qDebug() << e.cause();
-                    qDebug() << entries;
+                versions.insert(hash, Modrinth::loadIndexedPackVersion(entry));
+            } catch (Json::JsonException& e) {
+                qDebug() << e.cause();
 
-                    emitFail(mod);
-                }
+                setOutcome(lookup, mod, {});
             }
-        } catch (Json::JsonException& e) {
-            qDebug() << e.cause();
-            qDebug() << doc;
         }
+
+        if (!versions.isEmpty())
+            runRequest(modrinthProjectsTask(lookup, versions));
+    });
+    connect(ver_task.get(), &Task::failed, this, [this, lookup, hashes] {
+        for (auto& hash : hashes)
+            setOutcome(lookup, m_lookups[lookup].mods.value(hash), {});
     });
 
     return ver_task;
 }
 
-Task::Ptr EnsureMetadataTask::modrinthProjectsTask()
+Task::Ptr EnsureMetadataTask::modrinthProjectsTask(int lookup, QHash<QString, ModPlatform::IndexedVersion> versions)
 {
-    QHash<QString, QString> addonIds;
-    for (auto const& data : m_temp_versions)
-        addonIds.insert(data.addonId.toString(), data.hash);
+    QHash<QString, QStringList> addonIds;
+    for (auto it = versions.constBegin(); it != versions.constEnd(); ++it)
+        addonIds[it.value().addonId.toString()].append(it.key());
 
     auto response = std::make_shared<QByteArray>();
-    Task::Ptr proj_task;
-
-    if (addonIds.isEmpty()) {
-        qWarning() << "No addonId found!";
-    } else if (addonIds.size() == 1) {
-        proj_task = modrinth_api.getProject(*addonIds.keyBegin(), response);
-    } else {
-        proj_task = modrinth_api.getProjects(addonIds.keys(), response);
-    }
+    auto proj_task = modrinth_api.getProjects(addonIds.keys(), response);
 
     // Prevents unfortunate timings when aborting the task
     if (!proj_task)
         return Task::Ptr{ nullptr };
 
-    connect(proj_task.get(), &Task::succeeded, this, [this, response, addonIds] {
+    auto give_up = [this, lookup, versions] {
+        for (auto& hash : versions.keys())
+            setOutcome(lookup, m_lookups[lookup].mods.value(hash), {});
+    };
+
+    connect(proj_task.get(), &Task::succeeded, this, [this, lookup, response, addonIds, versions, give_up] {
         QJsonParseError parse_error{};
         auto doc = QJsonDocument::fromJson(*response, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
             qWarning() << "Error while parsing JSON response from Modrinth projects task at " << parse_error.offset
                        << " reason: " << parse_error.errorString();
             qWarning() << *response;
+            give_up();
             return;
         }
 
         QJsonArray entries;
 
         try {
-            if (addonIds.size() == 1)
-                entries = { doc.object() };
-            else
-                entries = Json::requireArray(doc);
+            entries = Json::requireArray(doc);
         } catch (Json::JsonException& e) {
             qDebug() << e.cause();
             qDebug() << doc;
@@ -321,45 +404,42 @@ Task::Ptr EnsureMetadataTask::modrinthProjectsTask()
                 continue;
             }
 
-            auto hash = addonIds.find(pack.addonId.toString()).value();
-
-            auto mod_iter = m_mods.find(hash);
-            if (mod_iter == m_mods.end()) {
+            auto hashes = addonIds.value(pack.addonId.toString());
+            if (hashes.isEmpty()) {
                 qWarning() << "Invalid project id from the API response.";
                 continue;
             }
 
-            auto* mod = mod_iter.value();
-
-            try {
-                setStatus(tr("Parsing API response from Modrinth for '%1'...").arg(mod->name()));
-
-                modrinthCallback(pack, m_temp_versions.find(hash).value(), mod);
-            } catch (Json::JsonException& e) {
-                qDebug() << e.cause();
-                qDebug() << entries;
-
-                emitFail(mod);
-            }
+            for (auto& hash : hashes)
+                setOutcome(lookup, m_lookups[lookup].mods.value(hash), Found{ pack, versions.value(hash) });
         }
+
+        // whatever wasn't in the response isn't known
+        give_up();
     });
+    connect(proj_task.get(), &Task::failed, this, give_up);
 
     return proj_task;
 }
 
 // Flame
-Task::Ptr EnsureMetadataTask::flameVersionsTask()
+Task::Ptr EnsureMetadataTask::flameVersionsTask(int lookup, QStringList hashes)
 {
     auto response = std::make_shared<QByteArray>();
 
     QList<uint> fingerprints;
-    for (auto& murmur : m_mods.keys()) {
+    for (auto& murmur : hashes) {
         fingerprints.push_back(murmur.toUInt());
     }
 
     auto ver_task = flame_api.matchFingerprints(fingerprints, response);
 
-    connect(ver_task.get(), &Task::succeeded, this, [this, response] {
+    auto give_up = [this, lookup, hashes] {
+        for (auto& hash : hashes)
+            setOutcome(lookup, m_lookups[lookup].mods.value(hash), {});
+    };
+
+    connect(ver_task.get(), &Task::succeeded, this, [this, lookup, response, give_up] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
@@ -367,123 +447,111 @@ Task::Ptr EnsureMetadataTask::flameVersionsTask()
                        << " reason: " << parse_error.errorString();
             qWarning() << *response;
 
-            failed(parse_error.errorString());
+            give_up();
             return;
         }
 
+        QHash<QString, ModPlatform::IndexedVersion> versions;
         try {
             auto doc_obj = Json::requireObject(doc);
             auto data_obj = Json::requireObject(doc_obj, "data");
             auto data_arr = Json::requireArray(data_obj, "exactMatches");
 
-            if (data_arr.isEmpty()) {
+            if (data_arr.isEmpty())
                 qWarning() << "No matches found for fingerprint search!";
 
-                return;
-            }
-
             for (auto match : data_arr) {
                 auto match_obj = Json::ensureObject(match, {});
                 auto file_obj = Json::ensureObject(match_obj, "file", {});
 
                 if (match_obj.isEmpty() || file_obj.isEmpty()) {
                     qWarning() << "Fingerprint match is empty!";
-
-                    return;
+                    continue;
                 }
 
                 auto fingerprint = QString::number(Json::ensureVariant(file_obj, "fileFingerprint").toUInt());
-                auto mod = m_mods.find(fingerprint);
-                if (mod == m_mods.end()) {
+                auto mod = m_lookups[lookup].mods.find(fingerprint);
+                if (mod == m_lookups[lookup].mods.end()) {
                     qWarning() << "Invalid fingerprint from the API response.";
                     continue;
                 }
 
-                setStatus(tr("Parsing API response from CurseForge for '%1'...").arg((*mod)->name()));
-
-                m_temp_versions.insert(fingerprint, FlameMod::loadIndexedPackVersion(file_obj));
+                auto version = FlameMod::loadIndexedPackVersion(file_obj);
+                if (!version.addonId.toString().isEmpty())
+                    versions.insert(fingerprint, version);
             }
 
         } catch (Json::JsonException& e) {
             qDebug() << e.cause();
             qDebug() << doc;
         }
+
+        if (!versions.isEmpty())
+            runRequest(flameProjectsTask(lookup, versions));
+        // those without a match aren't known
+        give_up();
     });
+    connect(ver_task.get(), &Task::failed, this, give_up);
 
     return ver_task;
 }
 
-Task::Ptr EnsureMetadataTask::flameProjectsTask()
+Task::Ptr EnsureMetadataTask::flameProjectsTask(int lookup, QHash<QString, ModPlatform::IndexedVersion> versions)
 {
-    QHash<QString, QString> addonIds;
-    for (auto const& hash : m_mods.keys()) {
-        if (m_temp_versions.contains(hash)) {
-            auto data = m_temp_versions.find(hash).value();
-
-            auto id_str = data.addonId.toString();
-            if (!id_str.isEmpty())
-                addonIds.insert(data.addonId.toString(), hash);
-        }
-    }
+    QHash<QString, QStringList> addonIds;
+    for (auto it = versions.constBegin(); it != versions.constEnd(); ++it)
+        addonIds[it.value().addonId.toString()].append(it.key());
 
     auto response = std::make_shared<QByteArray>();
-    Task::Ptr proj_task;
-
-    if (addonIds.isEmpty()) {
-        qWarning() << "No addonId found!";
-    } else if (addonIds.size() == 1) {
-        proj_task = flame_api.getProject(*addonIds.keyBegin(), response);
-    } else {
-        proj_task = flame_api.getProjects(addonIds.keys(), response);
-    }
+    auto proj_task = flame_api.getProjects(addonIds.keys(), response);
 
     // Prevents unfortunate timings when aborting the task
     if (!proj_task)
         return Task::Ptr{ nullptr };
 
-    connect(proj_task.get(), &Task::succeeded, this, [this, response, addonIds] {
+    auto give_up = [this, lookup, versions] {
+        for (auto& hash : versions.keys())
+            setOutcome(lookup, m_lookups[lookup].mods.value(hash), {});
+    };
+
+    connect(proj_task.get(), &Task::succeeded, this, [this, lookup, response, addonIds, versions, give_up] {
         QJsonParseError parse_error{};
         auto doc = QJsonDocument::fromJson(*response, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
             qWarning() << "Error while parsing JSON response from Modrinth projects task at " << parse_error.offset
                        << " reason: " << parse_error.errorString();
             qWarning() << *response;
+            give_up();
             return;
         }
 
         try {
-            QJsonArray entries;
-            if (addonIds.size() == 1)
-                entries = { Json::requireObject(Json::requireObject(doc), "data") };
-            else
-                entries = Json::requireArray(Json::requireObject(doc), "data");
+            auto entries = Json::requireArray(Json::requireObject(doc), "data");
 
             for (auto entry : entries) {
                 auto entry_obj = Json::requireObject(entry);
 
                 auto id = QString::number(Json::requireInteger(entry_obj, "id"));
-                auto hash = addonIds.find(id).value();
-                auto mod = m_mods.find(hash).value();
-
                 try {
-                    setStatus(tr("Parsing API response from CurseForge for '%1'...").arg(mod->name()));
-
                     ModPlatform::IndexedPack pack;
                     FlameMod::loadIndexedPack(pack, entry_obj);
 
-                    flameCallback(pack, m_temp_versions.find(hash).value(), mod);
+                    for (auto& hash : addonIds.value(id))
+                        setOutcome(lookup, m_lookups[lookup].mods.value(hash), Found{ pack, versions.value(hash) });
                 } catch (Json::JsonException& e) {
                     qDebug() << e.cause();
                     qDebug() << entries;
-
-                    emitFail(mod);
                 }
             }
         } catch (Json::JsonException& e) {
             qDebug() << e.cause();
             qDebug() << doc;
         }
+
+        // whatever wasn't in the response isn't known
+        give_up();
     });
+    connect(proj_task.get(), &Task::failed, this, give_up);
 
     return proj_task;
 }
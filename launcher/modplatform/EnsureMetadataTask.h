@@ -7,6 +7,8 @@
 
 #include "tasks/ConcurrentTask.h"
 
+#include <optional>
+
 class Mod;
 class QDir;
 
@@ -16,6 +18,8 @@ class EnsureMetadataTask : public Task {
    public:
     EnsureMetadataTask(Mod*, QDir, ModPlatform::ResourceProvider = ModPlatform::ResourceProvider::MODRINTH);
     EnsureMetadataTask(QList<Mod*>&, QDir, ModPlatform::ResourceProvider = ModPlatform::ResourceProvider::MODRINTH);
+    /* Looks the mods up on both providers at once, and only uses the fallback for mods the preferred one doesn't know. */
+    EnsureMetadataTask(QList<Mod*>&, QDir, ModPlatform::ResourceProvider preferred, ModPlatform::ResourceProvider fallback);
 
     ~EnsureMetadataTask() = default;
 
@@ -27,21 +31,42 @@ class EnsureMetadataTask : public Task {
     void executeTask() override;
 
    private:
+    /* What a provider found for a mod. */
+    struct Found {
+        ModPlatform::IndexedPack pack;
+        ModPlatform::IndexedVersion version;
+    };
+
+    /* The mods looked up on one provider, with the hashes of the type it wants. */
+    struct Lookup {
+        ModPlatform::ResourceProvider provider;
+        QHash<QString, Mod*> mods;
+        // hashed, but not asked about yet
+        QStringList queued;
+    };
+
+    void addHashTasks(Mod*);
+    void onHashed(int lookup, Mod*, QString hash);
+    void sendQueued(int lookup, bool partial);
+
     // FIXME: Move to their own namespace
-    auto modrinthVersionsTask() -> Task::Ptr;
-    auto modrinthProjectsTask() -> Task::Ptr;
+    auto modrinthVersionsTask(int lookup, QStringList hashes) -> Task::Ptr;
+    auto modrinthProjectsTask(int lookup, QHash<QString, ModPlatform::IndexedVersion> versions) -> Task::Ptr;
 
-    auto flameVersionsTask() -> Task::Ptr;
-    auto flameProjectsTask() -> Task::Ptr;
+    auto flameVersionsTask(int lookup, QStringList hashes) -> Task::Ptr;
+    auto flameProjectsTask(int lookup, QHash<QString, ModPlatform::IndexedVersion> versions) -> Task::Ptr;
 
-    // Helpers
-    enum class RemoveFromList { Yes, No };
-    void emitReady(Mod*, QString key = {}, RemoveFromList = RemoveFromList::Yes);
-    void emitFail(Mod*, QString key = {}, RemoveFromList = RemoveFromList::Yes);
+    void runRequest(Task::Ptr);
+    void requestFinished(Task*);
 
-    // Hashes and stuff
-    auto createNewHash(Mod*) -> Hashing::Hasher::Ptr;
-    auto getExistingHash(Mod*) -> QString;
+    // Merges the providers' answers by preference, once they are in
+    void setOutcome(int lookup, Mod*, std::optional<Found>);
+    void decide(Mod*);
+    void checkDone();
+
+    // Helpers
+    void emitReady(Mod*);
+    void emitFail(Mod*);
 
    private slots:
     void modrinthCallback(ModPlatform::IndexedPack& pack, ModPlatform::IndexedVersion& ver, Mod*);
@@ -52,11 +77,15 @@ class EnsureMetadataTask : public Task {
     void metadataFailed(Mod*);
 
    private:
-    QHash<QString, Mod*> m_mods;
+    QList<Mod*> m_all_mods;
     QDir m_index_dir;
     ModPlatform::ResourceProvider m_provider;
 
-    QHash<QString, ModPlatform::IndexedVersion> m_temp_versions;
+    QList<Lookup> m_lookups;
+    QHash<Mod*, QHash<int, std::optional<Found>>> m_outcomes;
+    QSet<Mod*> m_decided;
+
     ConcurrentTask::Ptr m_hashing_task;
-    Task::Ptr m_current_task;
+    bool m_hashing_done = false;
+    QList<Task::Ptr> m_requests;
 };
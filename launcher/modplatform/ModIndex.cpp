@@ -22,6 +22,10 @@
 #include <QDebug>
 #include <QIODevice>
 
+#include <limits>
+
+#include <MurmurHash2.h>
+
 namespace ModPlatform {
 
 static const QMap<QString, IndexedVersionType::VersionType> s_indexed_version_type_names = {
@@ -90,18 +94,20 @@ auto ProviderCapabilities::hashType(ResourceProvider p) -> QStringList
     return {};
 }
 
-auto ProviderCapabilities::hash(ResourceProvider p, QIODevice* device, QString type) -> QString
+auto ProviderCapabilities::hashAlgorithm(ResourceProvider p, QString type) -> QCryptographicHash::Algorithm
 {
-    QCryptographicHash::Algorithm algo = QCryptographicHash::Sha1;
     switch (p) {
-        case ResourceProvider::MODRINTH: {
-            algo = (type == "sha1") ? QCryptographicHash::Sha1 : QCryptographicHash::Sha512;
-            break;
-        }
+        case ResourceProvider::MODRINTH:
+            return (type == "sha1") ? QCryptographicHash::Sha1 : QCryptographicHash::Sha512;
         case ResourceProvider::FLAME:
-            algo = (type == "sha1") ? QCryptographicHash::Sha1 : QCryptographicHash::Md5;
-            break;
+            return (type == "sha1") ? QCryptographicHash::Sha1 : QCryptographicHash::Md5;
     }
+    return QCryptographicHash::Sha1;
+}
+
+auto ProviderCapabilities::hash(ResourceProvider p, QIODevice* device, QString type) -> QString
+{
+    auto algo = hashAlgorithm(p, type);
 
     QCryptographicHash hash(algo);
     if (!hash.addData(device))
@@ -111,6 +117,98 @@ auto ProviderCapabilities::hash(ResourceProvider p, QIODevice* device, QString t
     return { hash.result().toHex() };
 }
 
+auto ProviderCapabilities::hash(ResourceProvider p, const QByteArray& data, QString type) -> QString
+{
+    return { QCryptographicHash::hash(data, hashAlgorithm(p, type)).toHex() };
+}
+
+namespace {
+
+// a multiple of the page size, so reads from files stay aligned
+constexpr qint64 HASH_BLOCK_SIZE = 1024 * 1024;
+
+std::optional<QCryptographicHash::Algorithm> algorithmOf(const QString& type)
+{
+    if (type == "md5")
+        return QCryptographicHash::Md5;
+    if (type == "sha1")
+        return QCryptographicHash::Sha1;
+    if (type == "sha256")
+        return QCryptographicHash::Sha256;
+    if (type == "sha512")
+        return QCryptographicHash::Sha512;
+    return std::nullopt;
+}
+
+QList<QPair<QString, std::shared_ptr<QCryptographicHash>>> digestsOf(const QStringList& types)
+{
+    QList<QPair<QString, std::shared_ptr<QCryptographicHash>>> digests;
+    for (auto& type : types) {
+        if (auto algorithm = algorithmOf(type))
+            digests.append(qMakePair(type, std::make_shared<QCryptographicHash>(*algorithm)));
+    }
+    return digests;
+}
+
+}  // namespace
+
+auto ProviderCapabilities::hashAll(QIODevice* device, const QStringList& types) -> QHash<QString, QString>
+{
+    auto digests = digestsOf(types);
+    bool murmur2 = types.contains("murmur2");
+
+    // murmur2 needs the length of the filtered data before it can start, so that part is kept until the end
+    QByteArray filtered;
+    if (murmur2 && !device->isSequential())
+        filtered.reserve(static_cast<int>(qMin<qint64>(device->size() - device->pos(), std::numeric_limits<int>::max())));
+
+    QByteArray block(static_cast<int>(HASH_BLOCK_SIZE), Qt::Uninitialized);
+    while (true) {
+        auto read = device->read(block.data(), HASH_BLOCK_SIZE);
+        if (read < 0) {
+            qCritical() << "Failed to read file to create hashes:" << device->errorString();
+            return {};
+        }
+        if (read == 0 && (device->atEnd() || !device->waitForReadyRead(-1)))
+            break;
+
+        auto chunk = QByteArray::fromRawData(block.constData(), static_cast<int>(read));
+        for (auto& digest : digests)
+            digest.second->addData(chunk);
+        if (murmur2) {
+            auto offset = filtered.size();
+            filtered.resize(offset + static_cast<int>(read));
+            auto kept = MurmurFilterWhitespace(block.constData(), static_cast<std::size_t>(read), filtered.data() + offset);
+            filtered.resize(offset + static_cast<int>(kept));
+        }
+    }
+
+    QHash<QString, QString> hashes;
+    for (auto& digest : digests)
+        hashes.insert(digest.first, QString::fromLatin1(digest.second->result().toHex()));
+    if (murmur2)
+        hashes.insert("murmur2", QString::number(MurmurHash2(filtered.constData(), static_cast<std::size_t>(filtered.size()))));
+    return hashes;
+}
+
+auto ProviderCapabilities::hashAll(const QByteArray& data, const QStringList& types) -> QHash<QString, QString>
+{
+    QHash<QString, QString> hashes;
+    // every digest goes over the data block by block at the same time, so each block is read from memory once
+    auto digests = digestsOf(types);
+    for (qint64 offset = 0; offset < data.size(); offset += HASH_BLOCK_SIZE) {
+        auto length = qMin<qint64>(HASH_BLOCK_SIZE, data.size() - offset);
+        auto chunk = QByteArray::fromRawData(data.constData() + offset, static_cast<int>(length));
+        for (auto& digest : digests)
+            digest.second->addData(chunk);
+    }
+    for (auto& digest : digests)
+        hashes.insert(digest.first, QString::fromLatin1(digest.second->result().toHex()));
+    if (types.contains("murmur2"))
+        hashes.insert("murmur2", QString::number(CurseForgeMurmurHash2(data.constData(), static_cast<std::size_t>(data.size()))));
+    return hashes;
+}
+
 QString getMetaURL(ResourceProvider provider, QVariant projectID)
 {
     return ((provider == ModPlatform::ResourceProvider::FLAME) ? "https://www.curseforge.com/projects/" : "https://modrinth.com/mod/") +
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <QCryptographicHash>
+#include <QHash>
 #include <QList>
 #include <QMetaType>
 #include <QString>
@@ -27,6 +29,8 @@
 #include <memory>
 #include <optional>
 
+#include "Version.h"
+
 class QIODevice;
 
 namespace ModPlatform {
@@ -46,6 +50,17 @@ class ProviderCapabilities {
     auto readableName(ResourceProvider) -> QString;
     auto hashType(ResourceProvider) -> QStringList;
     auto hash(ResourceProvider, QIODevice*, QString type = "") -> QString;
+    auto hash(ResourceProvider, const QByteArray&, QString type = "") -> QString;
+    auto hashAlgorithm(ResourceProvider, QString type) -> QCryptographicHash::Algorithm;
+
+    /** Computes every hash in 'types' while reading the rest of 'device' only once, in big blocks.
+     *
+     *  Types are named by what they are rather than by provider: "md5", "sha1", "sha256", "sha512",
+     *  and "murmur2" for the whitespace-filtered CurseForge fingerprint. Unknown types are left out.
+     *  Returns nothing at all if the device couldn't be read.
+     */
+    auto hashAll(QIODevice*, const QStringList& types) -> QHash<QString, QString>;
+    auto hashAll(const QByteArray&, const QStringList& types) -> QHash<QString, QString>;
 };
 
 struct ModpackAuthor {
@@ -112,6 +127,20 @@ struct IndexedVersion {
 
     // For internal use, not provided by APIs
     bool is_currently_selected = false;
+
+    /// mcVersion parsed for comparisons on first use, so only call it once mcVersion is filled in
+    const QVector<Version>& comparableMcVersions() const
+    {
+        if (!comparable_mc_versions) {
+            QVector<Version> parsed;
+            parsed.reserve(mcVersion.size());
+            for (auto const& mc_version : mcVersion)
+                parsed.append(Version(mc_version));
+            comparable_mc_versions = std::move(parsed);
+        }
+        return *comparable_mc_versions;
+    }
+    mutable std::optional<QVector<Version>> comparable_mc_versions;
 };
 
 struct ExtraPackData {
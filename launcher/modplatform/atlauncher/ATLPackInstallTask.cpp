@@ -38,6 +38,7 @@
 
 #include <QtConcurrent>
 #include <algorithm>
+#include <functional>
 
 #include <quazip/quazip.h>
 
@@ -158,11 +159,7 @@ void PackInstallTask::onDownloadSucceeded()
         deleteExistingFiles();
     }
 
-    if (m_version.noConfigs) {
-        downloadMods();
-    } else {
-        installConfigs();
-    }
+    downloadMods();
 }
 
 void PackInstallTask::onDownloadFailed(QString reason)
@@ -628,8 +625,6 @@ bool PackInstallTask::createPackComponent(QString instanceRoot, std::shared_ptr<
 void PackInstallTask::installConfigs()
 {
     qDebug() << "PackInstallTask::installConfigs: " << QThread::currentThreadId();
-    setStatus(tr("Downloading configs..."));
-    jobPtr.reset(new NetJob(tr("Config download"), APPLICATION->network()));
 
     auto path = QString("Configs/%1/%2.zip").arg(m_pack_safe_name).arg(m_version_name);
     auto url = QString(BuildConfig.ATL_DOWNLOAD_SERVER_URL + "packs/%1/versions/%2/Configs.zip").arg(m_pack_safe_name).arg(m_version_name);
@@ -641,43 +636,26 @@ void PackInstallTask::installConfigs()
         auto rawSha1 = QByteArray::fromHex(m_version.configs.sha1.toLatin1());
         dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, rawSha1));
     }
-    jobPtr->addNetAction(dl);
     archivePath = entry->getFullPath();
 
-    connect(jobPtr.get(), &NetJob::succeeded, this, [&]() {
-        abortable = false;
-        jobPtr.reset();
-        extractConfigs();
-    });
-    connect(jobPtr.get(), &NetJob::failed, [&](QString reason) {
-        abortable = false;
-        jobPtr.reset();
-        emitFailed(reason);
-    });
-    connect(jobPtr.get(), &NetJob::progress, [&](qint64 current, qint64 total) {
-        abortable = true;
-        setProgress(current, total);
-    });
-    connect(jobPtr.get(), &NetJob::stepProgress, this, &PackInstallTask::propagateStepProgress);
-    connect(jobPtr.get(), &NetJob::aborted, [&] {
-        abortable = false;
-        jobPtr.reset();
-        emitAborted();
-    });
-
-    jobPtr->start();
+    // the configs are downloaded alongside the mods, and extracted as soon as they are here
+    connect(dl.get(), &Task::succeeded, this, &PackInstallTask::extractConfigs);
+    jobPtr->addNetAction(dl);
 }
 
 void PackInstallTask::extractConfigs()
 {
     qDebug() << "PackInstallTask::extractConfigs: " << QThread::currentThreadId();
-    setStatus(tr("Extracting configs..."));
+    if (!isRunning())
+        return;
 
     QDir extractDir(m_stagingPath);
 
     QuaZip packZip(archivePath);
     if (!packZip.open(QuaZip::mdUnzip)) {
         emitFailed(tr("Failed to open pack configs %1!").arg(archivePath));
+        if (jobPtr)
+            jobPtr->abort();
         return;
     }
 
@@ -688,7 +666,10 @@ void PackInstallTask::extractConfigs()
     m_extractFuture =
         QtConcurrent::run(QThreadPool::globalInstance(), MMCZip::extractDir, archivePath, extractDir.absolutePath() + "/minecraft");
 #endif
-    connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, [&]() { downloadMods(); });
+    connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, [&]() {
+        m_configsExtracted = true;
+        startModExtraction();
+    });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, [&]() { emitAborted(); });
     m_extractFutureWatcher.setFuture(m_extractFuture);
 }
@@ -721,6 +702,11 @@ void PackInstallTask::downloadMods()
     jarmods.clear();
     jobPtr.reset(new NetJob(tr("Mod download"), APPLICATION->network()));
 
+    m_configsExtracted = m_version.noConfigs;
+    m_modsDownloaded = false;
+    if (!m_version.noConfigs)
+        installConfigs();
+
     QList<VersionMod> blocked_mods;
     for (const auto& mod : m_version.mods) {
         // skip non-client mods
@@ -902,14 +888,22 @@ void PackInstallTask::onModsDownloaded()
     qDebug() << "PackInstallTask::onModsDownloaded: " << QThread::currentThreadId();
     jobPtr.reset();
 
+    m_modsDownloaded = true;
+    startModExtraction();
+}
+
+void PackInstallTask::startModExtraction()
+{
+    // the mods go on top of the configs, so both have to be in place first
+    if (!m_modsDownloaded || !m_configsExtracted || !isRunning())
+        return;
+
     if (!modsToExtract.empty() || !modsToDecomp.empty() || !modsToCopy.empty()) {
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        m_modExtractFuture =
-            QtConcurrent::run(QThreadPool::globalInstance(), &PackInstallTask::extractMods, this, modsToExtract, modsToDecomp, modsToCopy);
-#else
-        m_modExtractFuture =
-            QtConcurrent::run(QThreadPool::globalInstance(), this, &PackInstallTask::extractMods, modsToExtract, modsToDecomp, modsToCopy);
-#endif
+        setStatus(tr("Extracting mods..."));
+        m_modExtractFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this, toExtract = modsToExtract, toDecomp = modsToDecomp,
+                                                                               toCopy = modsToCopy] {
+            return extractMods(toExtract, toDecomp, toCopy);
+        });
         connect(&m_modExtractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &PackInstallTask::onModsExtracted);
         connect(&m_modExtractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, &PackInstallTask::emitAborted);
         m_modExtractFutureWatcher.setFuture(m_modExtractFuture);
@@ -934,7 +928,10 @@ bool PackInstallTask::extractMods(const QMap<QString, VersionMod>& toExtract,
 {
     qDebug() << "PackInstallTask::extractMods: " << QThread::currentThreadId();
 
-    setStatus(tr("Extracting mods..."));
+    const QDir extractDir(m_stagingPath);
+
+    // every archive is unpacked on its own, so they can all be extracted at once
+    QList<std::function<bool()>> extractions;
     for (auto iter = toExtract.begin(); iter != toExtract.end(); iter++) {
         auto& modPath = iter.key();
         auto& mod = iter.value();
@@ -948,7 +945,6 @@ bool PackInstallTask::extractMods(const QMap<QString, VersionMod>& toExtract,
             extractToDir = FS::PathCombine("resourcepacks", "extracted");
         }
 
-        QDir extractDir(m_stagingPath);
         auto extractToPath = FS::PathCombine(extractDir.absolutePath(), "minecraft", extractToDir);
 
         QString folderToExtract = "";
@@ -957,11 +953,10 @@ bool PackInstallTask::extractMods(const QMap<QString, VersionMod>& toExtract,
             folderToExtract.remove(QRegularExpression("^/"));
         }
 
-        qDebug() << "Extracting " + mod.file + " to " + extractToDir;
-        if (!MMCZip::extractDir(modPath, folderToExtract, extractToPath)) {
-            // assume error
-            return false;
-        }
+        extractions.append([modPath, mod, folderToExtract, extractToDir, extractToPath] {
+            qDebug() << "Extracting " + mod.file + " to " + extractToDir;
+            return MMCZip::extractDir(modPath, folderToExtract, extractToPath).has_value();
+        });
     }
 
     for (auto iter = toDecomp.begin(); iter != toDecomp.end(); iter++) {
@@ -969,37 +964,50 @@ bool PackInstallTask::extractMods(const QMap<QString, VersionMod>& toExtract,
         auto& mod = iter.value();
         auto extractToDir = getDirForModType(mod.decompType, mod.decompType_raw);
 
-        QDir extractDir(m_stagingPath);
         auto extractToPath = FS::PathCombine(extractDir.absolutePath(), "minecraft", extractToDir, mod.decompFile);
 
-        qDebug() << "Extracting " + mod.decompFile + " to " + extractToDir;
-        if (!MMCZip::extractFile(modPath, mod.decompFile, extractToPath)) {
-            qWarning() << "Failed to extract" << mod.decompFile;
-            return false;
-        }
+        extractions.append([modPath, mod, extractToDir, extractToPath] {
+            qDebug() << "Extracting " + mod.decompFile + " to " + extractToDir;
+            if (!MMCZip::extractFile(modPath, mod.decompFile, extractToPath)) {
+                qWarning() << "Failed to extract" << mod.decompFile;
+                return false;
+            }
+            return true;
+        });
     }
 
+    auto run = [](const std::function<bool()>& step) { return step(); };
+    auto extracted = QtConcurrent::blockingMapped<QList<bool>>(extractions, run);
+    if (extracted.contains(false))
+        return false;
+
+    // copies come last, so the mods win over whatever the extracted archives held
+    QList<std::function<bool()>> copies;
     for (auto iter = toCopy.begin(); iter != toCopy.end(); iter++) {
-        auto& from = iter.key();
-        auto& to = iter.value();
-
-        // If the file already exists, assume the mod is the correct copy - and remove
-        // the copy from the Configs.zip
-        QFileInfo fileInfo(to);
-        if (fileInfo.exists()) {
-            if (!QFile::remove(to)) {
-                qWarning() << "Failed to delete" << to;
-                return false;
+        auto from = iter.key();
+        auto to = iter.value();
+
+        copies.append([from, to] {
+            // If the file already exists, assume the mod is the correct copy - and remove
+            // the copy from the Configs.zip
+            QFileInfo fileInfo(to);
+            if (fileInfo.exists()) {
+                if (!QFile::remove(to)) {
+                    qWarning() << "Failed to delete" << to;
+                    return false;
+                }
             }
-        }
 
-        FS::copy fileCopyOperation(from, to);
-        if (!fileCopyOperation()) {
-            qWarning() << "Failed to copy" << from << "to" << to;
-            return false;
-        }
+            FS::copy fileCopyOperation(from, to);
+            if (!fileCopyOperation()) {
+                qWarning() << "Failed to copy" << from << "to" << to;
+                return false;
+            }
+            return true;
+        });
     }
-    return true;
+    auto copied = QtConcurrent::blockingMapped<QList<bool>>(copies, run);
+    return !copied.contains(false);
 }
 
 void PackInstallTask::install()
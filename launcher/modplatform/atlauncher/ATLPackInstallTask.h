@@ -114,6 +114,7 @@ class PackInstallTask : public InstanceTask {
     void installConfigs();
     void extractConfigs();
     void downloadMods();
+    void startModExtraction();
     bool extractMods(const QMap<QString, VersionMod>& toExtract,
                      const QMap<QString, VersionMod>& toDecomp,
                      const QMap<QString, QString>& toCopy);
@@ -133,6 +134,9 @@ class PackInstallTask : public InstanceTask {
     QString m_version_name;
     PackVersion m_version;
 
+    bool m_modsDownloaded = false;
+    bool m_configsExtracted = false;
+
     QMap<QString, VersionMod> modsToExtract;
     QMap<QString, VersionMod> modsToDecomp;
     QMap<QString, QString> modsToCopy;
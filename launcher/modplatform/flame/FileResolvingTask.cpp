@@ -25,6 +25,7 @@ bool Flame::FileResolvingTask::abort()
 void Flame::FileResolvingTask::executeTask()
 {
     if (m_toProcess.files.isEmpty()) {  // no file to resolve so leave it empty and emit success immediately
+        emit downloadableFilesResolved();
         emitSucceeded();
         return;
     }
@@ -110,6 +111,11 @@ void Flame::FileResolvingTask::netJobFinished()
             }
         }
     }
+    emit downloadableFilesResolved();
+    // Listeners may have given up on us already
+    if (!isRunning())
+        return;
+
     auto step_progress = std::make_shared<TaskStepProgress>();
     connect(m_checkJob.get(), &NetJob::finished, this, [this, step_progress]() {
         step_progress->state = TaskStepState::Succeeded;
@@ -16,6 +16,12 @@ class FileResolvingTask : public Task {
 
     const Flame::Manifest& getResults() const { return m_toProcess; }
 
+   signals:
+    /** Emitted once every file CurseForge lets us download directly has its name and URL set in getResults().
+     *  The blocked ones are still being looked up at this point, and may get a URL later.
+     */
+    void downloadableFilesResolved();
+
    protected:
     virtual void executeTask() override;
 
@@ -12,6 +12,37 @@
 #include "net/NetJob.h"
 #include "net/Upload.h"
 
+#include "modplatform/helpers/ProjectInfoBatcher.h"
+
+#include <QCoreApplication>
+
+namespace {
+constexpr int PROJECT_BATCH_SIZE = 100;
+
+// Single projects are looked up as a part of a bulk request, and answered with their own object of the bulk response
+ProjectInfoBatcher* projectBatcher()
+{
+    static auto* s_batcher = new ProjectInfoBatcher(
+        [](QStringList addonIds, std::shared_ptr<QByteArray> response) {
+            static const FlameAPI api;
+            return api.getProjects(addonIds, response);
+        },
+        [](const QByteArray& response) {
+            QHash<QString, QByteArray> projects;
+            for (auto project : QJsonDocument::fromJson(response).object().value("data").toArray()) {
+                auto obj = project.toObject();
+                // the same shape as the single project endpoint gives
+                QJsonObject single;
+                single["data"] = obj;
+                projects.insert(QString::number(obj["id"].toInt()), QJsonDocument(single).toJson(QJsonDocument::Compact));
+            }
+            return projects;
+        },
+        PROJECT_BATCH_SIZE, QCoreApplication::instance());
+    return s_batcher;
+}
+}  // namespace
+
 Task::Ptr FlameAPI::matchFingerprints(const QList<uint>& fingerprints, std::shared_ptr<QByteArray> response)
 {
     auto netJob = makeShared<NetJob>(QString("Flame::MatchFingerprints"), APPLICATION->network());
@@ -175,6 +206,11 @@ Task::Ptr FlameAPI::getProjects(QStringList addonIds, std::shared_ptr<QByteArray
     return netJob;
 }
 
+Task::Ptr FlameAPI::getProject(QString addonId, std::shared_ptr<QByteArray> response) const
+{
+    return projectBatcher()->getProject(addonId, response);
+}
+
 Task::Ptr FlameAPI::getFiles(const QStringList& fileIds, std::shared_ptr<QByteArray> response) const
 {
     auto netJob = makeShared<NetJob>(QString("Flame::GetFiles"), APPLICATION->network());
@@ -2,7 +2,6 @@
 #include "FlameAPI.h"
 #include "FlameModIndex.h"
 
-#include <MurmurHash2.h>
 #include <memory>
 
 #include "Json.h"
@@ -16,6 +15,47 @@
 
 static FlameAPI api;
 
+// https://docs.curseforge.com/?http#tocS_ModLoaderType
+static ModPlatform::ModLoaderTypes loaderFromFlame(int mod_loader)
+{
+    switch (mod_loader) {
+        case 1:
+            return ModPlatform::Forge;
+        case 2:
+            return ModPlatform::Cauldron;
+        case 3:
+            return ModPlatform::LiteLoader;
+        case 4:
+            return ModPlatform::Fabric;
+        case 5:
+            return ModPlatform::Quilt;
+        case 6:
+            return ModPlatform::NeoForge;
+    }
+    return {};
+}
+
+static bool parseData(const QByteArray& response, QJsonArray& data)
+{
+    QJsonParseError parse_error{};
+    QJsonDocument doc = QJsonDocument::fromJson(response, &parse_error);
+    if (parse_error.error != QJsonParseError::NoError) {
+        qWarning() << "Error while parsing JSON response from FlameCheckUpdate at " << parse_error.offset
+                   << " reason: " << parse_error.errorString();
+        qWarning() << response;
+        return false;
+    }
+
+    try {
+        data = Json::requireArray(Json::requireObject(doc), "data");
+    } catch (Json::JsonException& e) {
+        qWarning() << e.cause();
+        qDebug() << doc;
+        return false;
+    }
+    return true;
+}
+
 bool FlameCheckUpdate::abort()
 {
     m_was_aborted = true;
@@ -24,124 +64,166 @@ bool FlameCheckUpdate::abort()
     return true;
 }
 
-ModPlatform::IndexedPack FlameCheckUpdate::getProjectInfo(ModPlatform::IndexedVersion& ver_info)
+bool FlameCheckUpdate::isCompatible(const ModPlatform::IndexedVersion& ver) const
+{
+    return !m_loaders.has_value() || !ver.loaders || m_loaders.value() & ver.loaders;
+}
+
+/* Check for update:
+ * - Get all projects at once, which list their latest files for each game version and mod loader
+ * - Get all the candidate files at once, and pick the latest compatible one for each mod
+ * - Compare hash of the latest version with the current hash
+ * - If equal, no updates, else, there's updates, so add to the list
+ * */
+void FlameCheckUpdate::executeTask()
 {
-    ModPlatform::IndexedPack pack;
+    setStatus(tr("Preparing mods for CurseForge..."));
+    setProgress(0, 3);
+
+    QStringList project_ids;
+    for (auto* mod : m_mods) {
+        if (!mod->enabled()) {
+            emit checkFailed(mod, tr("Disabled mods won't be updated, to prevent mod duplication issues!"));
+            continue;
+        }
+
+        m_checked_mods.append(mod);
+        auto project_id = mod->metadata()->project_id.toString();
+        if (!project_ids.contains(project_id))
+            project_ids.append(project_id);
+    }
 
-    QEventLoop loop;
+    if (m_checked_mods.isEmpty()) {
+        emitSucceeded();
+        return;
+    }
 
-    auto get_project_job = new NetJob("Flame::GetProjectJob", APPLICATION->network());
+    setStatus(tr("Getting API response from CurseForge..."));
 
-    auto response = std::make_shared<QByteArray>();
-    auto url = QString("https://api.curseforge.com/v1/mods/%1").arg(ver_info.addonId.toString());
-    auto dl = Net::ApiDownload::makeByteArray(url, response);
-    get_project_job->addNetAction(dl);
+    m_response = std::make_shared<QByteArray>();
+    m_net_job = api.getProjects(project_ids, m_response);
 
-    QObject::connect(get_project_job, &NetJob::succeeded, [response, &pack]() {
-        QJsonParseError parse_error{};
-        QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-        if (parse_error.error != QJsonParseError::NoError) {
-            qWarning() << "Error while parsing JSON response from FlameCheckUpdate at " << parse_error.offset
-                       << " reason: " << parse_error.errorString();
-            qWarning() << *response;
+    connect(m_net_job.get(), &Task::succeeded, this, [this] {
+        if (m_was_aborted)
+            return;
+
+        QJsonArray data;
+        if (!parseData(*m_response, data)) {
+            emitFailed(tr("Failed to parse the API response from CurseForge"));
             return;
         }
 
-        try {
-            auto doc_obj = Json::requireObject(doc);
-            auto data_obj = Json::requireObject(doc_obj, "data");
-            FlameMod::loadIndexedPack(pack, data_obj);
-        } catch (Json::JsonException& e) {
-            qWarning() << e.cause();
-            qDebug() << doc;
+        QString game_version;
+        if (!m_game_versions.empty())
+            game_version = m_game_versions.front().toString();
+
+        for (auto project : data) {
+            auto project_obj = project.toObject();
+            try {
+                ModPlatform::IndexedPack pack;
+                FlameMod::loadIndexedPack(pack, project_obj);
+                auto project_id = pack.addonId.toString();
+                m_projects.insert(project_id, pack);
+
+                // Same filters the per-project files listing used, without asking for each project separately
+                QStringList candidates;
+                for (auto index : Json::ensureArray(project_obj, "latestFilesIndexes")) {
+                    auto index_obj = index.toObject();
+                    if (!game_version.isEmpty() && Json::ensureString(index_obj, "gameVersion") != game_version)
+                        continue;
+
+                    auto loader = loaderFromFlame(Json::ensureInteger(index_obj, "modLoader", 0));
+                    if (m_loaders.has_value() && loader && !(m_loaders.value() & loader))
+                        continue;
+
+                    auto file_id = QString::number(Json::requireInteger(index_obj, "fileId"));
+                    if (!candidates.contains(file_id))
+                        candidates.append(file_id);
+                }
+                m_candidate_files.insert(project_id, candidates);
+            } catch (Json::JsonException& e) {
+                qWarning() << "Failed to parse CurseForge project:" << e.cause();
+            }
         }
-    });
 
-    connect(get_project_job, &NetJob::failed, this, &FlameCheckUpdate::emitFailed);
-    QObject::connect(get_project_job, &NetJob::finished, [&loop, get_project_job] {
-        get_project_job->deleteLater();
-        loop.quit();
+        getFiles();
     });
+    connect(m_net_job.get(), &Task::failed, this, &FlameCheckUpdate::emitFailed);
+    connect(m_net_job.get(), &Task::aborted, this, &FlameCheckUpdate::emitAborted);
 
-    get_project_job->start();
-    loop.exec();
-
-    return pack;
+    m_net_job->start();
 }
 
-ModPlatform::IndexedVersion FlameCheckUpdate::getFileInfo(int addonId, int fileId)
+void FlameCheckUpdate::getFiles()
 {
-    ModPlatform::IndexedVersion ver;
+    setStatus(tr("Getting file information from CurseForge..."));
+    setProgress(1, 3);
+
+    QStringList file_ids;
+    for (auto& candidates : m_candidate_files) {
+        for (auto& file_id : candidates) {
+            if (!file_ids.contains(file_id))
+                file_ids.append(file_id);
+        }
+    }
+    // We need the current files too, for the version of mods that don't tell us theirs
+    for (auto* mod : m_checked_mods) {
+        auto file_id = mod->metadata()->file_id.toString();
+        if (mod->version().isEmpty() && !file_ids.contains(file_id))
+            file_ids.append(file_id);
+    }
 
-    QEventLoop loop;
+    if (file_ids.isEmpty()) {
+        checkVersions();
+        return;
+    }
 
-    auto get_file_info_job = new NetJob("Flame::GetFileInfoJob", APPLICATION->network());
+    m_response = std::make_shared<QByteArray>();
+    m_net_job = api.getFiles(file_ids, m_response);
 
-    auto response = std::make_shared<QByteArray>();
-    auto url = QString("https://api.curseforge.com/v1/mods/%1/files/%2").arg(QString::number(addonId), QString::number(fileId));
-    auto dl = Net::ApiDownload::makeByteArray(url, response);
-    get_file_info_job->addNetAction(dl);
+    connect(m_net_job.get(), &Task::succeeded, this, [this] {
+        if (m_was_aborted)
+            return;
 
-    QObject::connect(get_file_info_job, &NetJob::succeeded, [response, &ver]() {
-        QJsonParseError parse_error{};
-        QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-        if (parse_error.error != QJsonParseError::NoError) {
-            qWarning() << "Error while parsing JSON response from FlameCheckUpdate at " << parse_error.offset
-                       << " reason: " << parse_error.errorString();
-            qWarning() << *response;
+        QJsonArray data;
+        if (!parseData(*m_response, data)) {
+            emitFailed(tr("Failed to parse the API response from CurseForge"));
             return;
         }
 
-        try {
-            auto doc_obj = Json::requireObject(doc);
-            auto data_obj = Json::requireObject(doc_obj, "data");
-            ver = FlameMod::loadIndexedPackVersion(data_obj);
-        } catch (Json::JsonException& e) {
-            qWarning() << e.cause();
-            qDebug() << doc;
+        for (auto file : data) {
+            auto file_obj = file.toObject();
+            try {
+                auto ver = FlameMod::loadIndexedPackVersion(file_obj);
+                if (ver.fileId.isValid())
+                    m_files.insert(ver.fileId.toString(), ver);
+            } catch (Json::JsonException& e) {
+                qWarning() << "Failed to parse CurseForge file:" << e.cause();
+            }
         }
-    });
-    connect(get_file_info_job, &NetJob::failed, this, &FlameCheckUpdate::emitFailed);
-    QObject::connect(get_file_info_job, &NetJob::finished, [&loop, get_file_info_job] {
-        get_file_info_job->deleteLater();
-        loop.quit();
-    });
 
-    get_file_info_job->start();
-    loop.exec();
+        checkVersions();
+    });
+    connect(m_net_job.get(), &Task::failed, this, &FlameCheckUpdate::emitFailed);
+    connect(m_net_job.get(), &Task::aborted, this, &FlameCheckUpdate::emitAborted);
 
-    return ver;
+    m_net_job->start();
 }
 
-/* Check for update:
- * - Get latest version available
- * - Compare hash of the latest version with the current hash
- * - If equal, no updates, else, there's updates, so add to the list
- * */
-void FlameCheckUpdate::executeTask()
+void FlameCheckUpdate::checkVersions()
 {
-    setStatus(tr("Preparing mods for CurseForge..."));
-
-    int i = 0;
-    for (auto* mod : m_mods) {
-        if (!mod->enabled()) {
-            emit checkFailed(mod, tr("Disabled mods won't be updated, to prevent mod duplication issues!"));
-            continue;
-        }
-
-        setStatus(tr("Getting API response from CurseForge for '%1'...").arg(mod->name()));
-        setProgress(i++, m_mods.size());
+    setStatus(tr("Parsing the API response from CurseForge..."));
 
-        auto latest_ver = api.getLatestVersion({ { mod->metadata()->project_id.toString() }, m_game_versions, m_loaders });
+    for (auto* mod : m_checked_mods) {
+        auto project_id = mod->metadata()->project_id.toString();
 
-        // Check if we were aborted while getting the latest version
-        if (m_was_aborted) {
-            aborted();
-            return;
+        ModPlatform::IndexedVersion latest_ver;
+        for (auto& file_id : m_candidate_files.value(project_id)) {
+            auto file = m_files.find(file_id);
+            if (file != m_files.end() && file->date > latest_ver.date && isCompatible(*file))
+                latest_ver = *file;
         }
 
-        setStatus(tr("Parsing the API response from CurseForge for '%1'...").arg(mod->name()));
-
         if (!latest_ver.addonId.isValid()) {
             emit checkFailed(mod, tr("No valid version found for this mod. It's probably unavailable for the current game "
                                      "version / mod loader."));
@@ -149,8 +231,7 @@ void FlameCheckUpdate::executeTask()
         }
 
         if (latest_ver.downloadUrl.isEmpty() && latest_ver.fileId != mod->metadata()->file_id) {
-            auto pack = getProjectInfo(latest_ver);
-            auto recover_url = QString("%1/download/%2").arg(pack.websiteUrl, latest_ver.fileId.toString());
+            auto recover_url = QString("%1/download/%2").arg(m_projects.value(project_id).websiteUrl, latest_ver.fileId.toString());
             emit checkFailed(mod, tr("Mod has a new update available, but is not downloadable using CurseForge."), recover_url);
 
             continue;
@@ -168,18 +249,55 @@ void FlameCheckUpdate::executeTask()
         pack->provider = ModPlatform::ResourceProvider::FLAME;
         if (!latest_ver.hash.isEmpty() && (mod->metadata()->hash != latest_ver.hash || mod->status() == ModStatus::NotInstalled)) {
             auto old_version = mod->version();
-            if (old_version.isEmpty() && mod->status() != ModStatus::NotInstalled) {
-                auto current_ver = getFileInfo(latest_ver.addonId.toInt(), mod->metadata()->file_id.toInt());
-                old_version = current_ver.version;
-            }
+            if (old_version.isEmpty() && mod->status() != ModStatus::NotInstalled)
+                old_version = m_files.value(mod->metadata()->file_id.toString()).version;
 
             auto download_task = makeShared<ResourceDownloadTask>(pack, latest_ver, m_mods_folder);
+            // The changelog is filled in once all of them are fetched
             m_updatable.emplace_back(pack->name, mod->metadata()->hash, old_version, latest_ver.version, latest_ver.version_type,
-                                     api.getModFileChangelog(latest_ver.addonId.toInt(), latest_ver.fileId.toInt()),
-                                     ModPlatform::ResourceProvider::FLAME, download_task);
+                                     QString(), ModPlatform::ResourceProvider::FLAME, download_task);
         }
         m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, latest_ver));
     }
 
-    emitSucceeded();
+    getChangelogs();
+}
+
+void FlameCheckUpdate::getChangelogs()
+{
+    if (m_updatable.empty()) {
+        emitSucceeded();
+        return;
+    }
+
+    setStatus(tr("Getting changelogs from CurseForge..."));
+    setProgress(2, 3);
+
+    auto job = makeShared<NetJob>("Flame::FileChangelogs", APPLICATION->network());
+    auto responses = std::make_shared<QList<std::shared_ptr<QByteArray>>>();
+    for (auto& updatable : m_updatable) {
+        auto& version = updatable.download->getVersion();
+        auto response = std::make_shared<QByteArray>();
+        responses->append(response);
+        job->addNetAction(Net::ApiDownload::makeByteArray(
+            QString("https://api.curseforge.com/v1/mods/%1/files/%2/changelog").arg(version.addonId.toString(), version.fileId.toString()),
+            response));
+    }
+
+    // A missing changelog isn't worth failing the whole check for, so use whatever we got
+    connect(job.get(), &Task::finished, this, [this, responses] {
+        if (m_was_aborted)
+            return;
+
+        for (std::size_t i = 0; i < m_updatable.size(); i++) {
+            auto doc = QJsonDocument::fromJson(*responses->at(static_cast<int>(i)));
+            m_updatable[i].changelog = Json::ensureString(doc.object(), "data");
+        }
+
+        emitSucceeded();
+    });
+    connect(job.get(), &Task::aborted, this, &FlameCheckUpdate::emitAborted);
+
+    m_net_job = job;
+    job->start();
 }
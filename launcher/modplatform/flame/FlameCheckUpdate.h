@@ -22,10 +22,21 @@ class FlameCheckUpdate : public CheckUpdateTask {
     void executeTask() override;
 
    private:
-    ModPlatform::IndexedPack getProjectInfo(ModPlatform::IndexedVersion& ver_info);
-    ModPlatform::IndexedVersion getFileInfo(int addonId, int fileId);
+    void getFiles();
+    void checkVersions();
+    void getChangelogs();
 
-    NetJob* m_net_job = nullptr;
+    auto isCompatible(const ModPlatform::IndexedVersion& ver) const -> bool;
+
+    Task::Ptr m_net_job = nullptr;
+    std::shared_ptr<QByteArray> m_response;
+
+    QList<Mod*> m_checked_mods;
+    // Indexed by project ID
+    QHash<QString, ModPlatform::IndexedPack> m_projects;
+    QHash<QString, QStringList> m_candidate_files;
+    // Indexed by file ID
+    QHash<QString, ModPlatform::IndexedVersion> m_files;
 
     bool m_was_aborted = false;
 };
@@ -74,8 +74,8 @@ bool FlameCreationTask::abort()
     m_abort = true;
     if (m_process_update_file_info_job)
         m_process_update_file_info_job->abort();
-    if (m_files_job)
-        m_files_job->abort();
+    for (auto& job : m_files_jobs)
+        job->abort();
     if (m_mod_id_resolver)
         m_mod_id_resolver->abort();
 
@@ -435,13 +435,17 @@ bool FlameCreationTask::createInstance()
 
     instance.setName(name());
 
+    // Files CurseForge serves directly start downloading as soon as they're resolved. Blocked files keep getting
+    // looked up (and maybe handled by the user) in the meantime, and are downloaded later if an alternative shows up.
+    m_resolving_files = true;
     m_mod_id_resolver.reset(new Flame::FileResolvingTask(APPLICATION->network(), m_pack));
+    connect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::downloadableFilesResolved, this, [this, &loop] { startDownloads(loop); });
     connect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::succeeded, this, [this, &loop] { idResolverSucceeded(loop); });
-    connect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::failed, [&](QString reason) {
-        m_mod_id_resolver.reset();
+    connect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::failed, this, [this, &loop](QString reason) {
         setError(tr("Unable to resolve mod IDs:\n") + reason);
         loop.quit();
     });
+    connect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::aborted, &loop, &QEventLoop::quit);
     connect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::progress, this, &FlameCreationTask::setProgress);
     connect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::status, this, &FlameCreationTask::setStatus);
     connect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::stepProgress, this, &FlameCreationTask::propagateStepProgress);
@@ -450,6 +454,21 @@ bool FlameCreationTask::createInstance()
 
     loop.exec();
 
+    // If we bailed out early, make sure nothing keeps running (and calling back into the now gone event loop)
+    if (m_mod_id_resolver) {
+        disconnect(m_mod_id_resolver.get(), nullptr, this, nullptr);
+        disconnect(m_mod_id_resolver.get(), nullptr, &loop, nullptr);
+        if (m_mod_id_resolver->isRunning())
+            m_mod_id_resolver->abort();
+        m_mod_id_resolver.reset();
+    }
+    for (auto& job : m_files_jobs) {
+        disconnect(job.get(), nullptr, this, nullptr);
+        if (job->isRunning())
+            job->abort();
+    }
+    m_files_jobs.clear();
+
     bool did_succeed = getError().isEmpty();
 
     // Update information of the already installed instance, if any.
@@ -463,8 +482,47 @@ bool FlameCreationTask::createInstance()
     return did_succeed;
 }
 
+void FlameCreationTask::startDownloads(QEventLoop& loop)
+{
+    QStringList optionalFiles;
+    for (auto& result : m_mod_id_resolver->getResults().files) {
+        if (!result.required) {
+            optionalFiles << FS::PathCombine(result.targetFolder, result.fileName);
+        }
+    }
+
+    if (!optionalFiles.empty()) {
+        OptionalModDialog optionalModDialog(m_parent, optionalFiles);
+        if (optionalModDialog.exec() == QDialog::Rejected) {
+            emitAborted();
+            loop.quit();
+            return;
+        }
+
+        m_selected_optional_mods = optionalModDialog.getResult();
+    }
+
+    // The resolver is still busy with the blocked files, don't let it fight with the downloads over the progress bar
+    disconnect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::progress, this, nullptr);
+    disconnect(m_mod_id_resolver.get(), &Flame::FileResolvingTask::details, this, nullptr);
+
+    setStatus(tr("Downloading mods..."));
+    m_downloads_started = true;
+    downloadResolvedFiles(loop);
+
+    // The resolver may have finished while the user was picking optional mods
+    if (m_resolver_succeeded_early)
+        idResolverSucceeded(loop);
+}
+
 void FlameCreationTask::idResolverSucceeded(QEventLoop& loop)
 {
+    // We need to know which optional mods to enable before downloading anything else
+    if (!m_downloads_started) {
+        m_resolver_succeeded_early = true;
+        return;
+    }
+
     auto results = m_mod_id_resolver->getResults();
 
     // first check for blocked mods
@@ -480,6 +538,7 @@ void FlameCreationTask::idResolverSucceeded(QEventLoop& loop)
             blocked_mod.name = result.fileName;
             blocked_mod.websiteUrl = result.websiteUrl;
             blocked_mod.hash = result.hash;
+            blocked_mod.size = result.size;
             blocked_mod.matched = false;
             blocked_mod.localPath = "";
             blocked_mod.targetFolder = result.targetFolder;
@@ -492,6 +551,7 @@ void FlameCreationTask::idResolverSucceeded(QEventLoop& loop)
     if (anyBlocked) {
         qWarning() << "Blocked mods found, displaying mod list";
 
+        // The other downloads keep going while the user deals with this
         BlockedModsDialog message_dialog(m_parent, tr("Blocked mods found"),
                                          tr("The following files are not available for download in third party launchers.<br/>"
                                             "You will need to manually download them and add them to the instance."),
@@ -499,51 +559,42 @@ void FlameCreationTask::idResolverSucceeded(QEventLoop& loop)
 
         message_dialog.setModal(true);
 
-        if (message_dialog.exec()) {
-            qDebug() << "Post dialog blocked mods list: " << blocked_mods;
-            copyBlockedMods(blocked_mods);
-            setupDownloadJob(loop);
-        } else {
-            m_mod_id_resolver.reset();
+        if (!message_dialog.exec()) {
             setError("Canceled");
             loop.quit();
+            return;
         }
-    } else {
-        setupDownloadJob(loop);
+
+        // Something else may have failed while the dialog was open
+        if (!getError().isEmpty())
+            return;
+
+        qDebug() << "Post dialog blocked mods list: " << blocked_mods;
+        copyBlockedMods(blocked_mods);
     }
+
+    // Pick up the files that were blocked on CurseForge, but for which we found an alternative
+    downloadResolvedFiles(loop);
+
+    m_resolving_files = false;
+    checkDownloadsFinished(loop);
 }
 
-void FlameCreationTask::setupDownloadJob(QEventLoop& loop)
+void FlameCreationTask::downloadResolvedFiles(QEventLoop& loop)
 {
-    m_files_job.reset(new NetJob(tr("Mod Download Flame"), APPLICATION->network()));
-    auto results = m_mod_id_resolver->getResults().files;
+    auto job = makeShared<NetJob>(tr("Mod Download Flame"), APPLICATION->network());
 
-    QStringList optionalFiles;
-    for (auto& result : results) {
-        if (!result.required) {
-            optionalFiles << FS::PathCombine(result.targetFolder, result.fileName);
-        }
-    }
-
-    QStringList selectedOptionalMods;
-    if (!optionalFiles.empty()) {
-        OptionalModDialog optionalModDialog(m_parent, optionalFiles);
-        if (optionalModDialog.exec() == QDialog::Rejected) {
-            emitAborted();
-            loop.quit();
-            return;
-        }
+    for (const auto& result : m_mod_id_resolver->getResults().files) {
+        if (m_handled_files.contains(result.fileId))
+            continue;
 
-        selectedOptionalMods = optionalModDialog.getResult();
-    }
-    for (const auto& result : results) {
         auto fileName = result.fileName;
 #ifdef Q_OS_WIN
         fileName = FS::RemoveInvalidPathChars(fileName);
 #endif
         auto relpath = FS::PathCombine(result.targetFolder, fileName);
 
-        if (!result.required && !selectedOptionalMods.contains(relpath)) {
+        if (!result.required && !m_selected_optional_mods.contains(relpath)) {
             relpath += ".disabled";
         }
 
@@ -558,11 +609,14 @@ void FlameCreationTask::setupDownloadJob(QEventLoop& loop)
             /* fallthrough */
             case Flame::File::Type::SingleFile:
             case Flame::File::Type::Mod: {
-                if (!result.url.isEmpty()) {
-                    qDebug() << "Will download" << result.url << "to" << path;
-                    auto dl = Net::ApiDownload::makeFile(result.url, path);
-                    m_files_job->addNetAction(dl);
-                }
+                // Blocked files may still get an URL later on
+                if (result.url.isEmpty())
+                    continue;
+
+                qDebug() << "Will download" << result.url << "to" << path;
+                auto dl = Net::ApiDownload::makeFile(result.url, path);
+                dl->setPriority(Net::NetRequest::Priority::Bulk);
+                job->addNetAction(dl);
                 break;
             }
             case Flame::File::Type::Modpack:
@@ -574,26 +628,45 @@ void FlameCreationTask::setupDownloadJob(QEventLoop& loop)
                 logWarning(tr("Unrecognized/unhandled PackageType for: %1").arg(relpath));
                 break;
         }
+
+        m_handled_files.insert(result.fileId);
     }
 
-    m_mod_id_resolver.reset();
-    connect(m_files_job.get(), &NetJob::succeeded, this, [&]() {
-        m_files_job.reset();
-        validateZIPResources();
-    });
-    connect(m_files_job.get(), &NetJob::failed, [&](QString reason) {
-        m_files_job.reset();
+    if (job->size() == 0)
+        return;
+
+    connect(job.get(), &NetJob::failed, this, [this, &loop](QString reason) {
         setError(reason);
+        loop.quit();
     });
-    connect(m_files_job.get(), &NetJob::progress, this, [this](qint64 current, qint64 total) {
+    connect(job.get(), &NetJob::progress, this, [this](qint64 current, qint64 total) {
         setDetails(tr("%1 out of %2 complete").arg(current).arg(total));
         setProgress(current, total);
     });
-    connect(m_files_job.get(), &NetJob::stepProgress, this, &FlameCreationTask::propagateStepProgress);
-    connect(m_files_job.get(), &NetJob::finished, &loop, &QEventLoop::quit);
+    connect(job.get(), &NetJob::stepProgress, this, &FlameCreationTask::propagateStepProgress);
+    connect(job.get(), &NetJob::finished, this, [this, &loop, job = job.get()] {
+        for (auto it = m_files_jobs.begin(); it != m_files_jobs.end(); ++it) {
+            if (it->get() == job) {
+                m_files_jobs.erase(it);
+                break;
+            }
+        }
+        checkDownloadsFinished(loop);
+    });
 
-    setStatus(tr("Downloading mods..."));
-    m_files_job->start();
+    m_files_jobs.append(job);
+    job->start();
+}
+
+void FlameCreationTask::checkDownloadsFinished(QEventLoop& loop)
+{
+    if (m_resolving_files || !m_files_jobs.isEmpty())
+        return;
+
+    if (getError().isEmpty() && !m_abort)
+        validateZIPResources();
+
+    loop.quit();
 }
 
 /// @brief copy the matched blocked mods to the instance staging area
@@ -37,6 +37,7 @@
 
 #include "InstanceCreationTask.h"
 
+#include <QSet>
 #include <optional>
 
 #include "minecraft/MinecraftInstance.h"
@@ -72,7 +73,9 @@ class FlameCreationTask final : public InstanceCreationTask {
 
    private slots:
     void idResolverSucceeded(QEventLoop&);
-    void setupDownloadJob(QEventLoop&);
+    void startDownloads(QEventLoop&);
+    void downloadResolvedFiles(QEventLoop&);
+    void checkDownloadsFinished(QEventLoop&);
     void copyBlockedMods(QList<BlockedMod> const& blocked_mods);
     void validateZIPResources();
     QString getVersionForLoader(QString uid, QString loaderType, QString version, QString mcVersion);
@@ -85,7 +88,13 @@ class FlameCreationTask final : public InstanceCreationTask {
 
     // Handle to allow aborting
     Task::Ptr m_process_update_file_info_job = nullptr;
-    NetJob::Ptr m_files_job = nullptr;
+    QList<NetJob::Ptr> m_files_jobs;
+
+    bool m_resolving_files = false;
+    bool m_downloads_started = false;
+    bool m_resolver_succeeded_early = false;
+    QSet<int> m_handled_files;
+    QStringList m_selected_optional_mods;
 
     QString m_managed_id, m_managed_version_id;
 
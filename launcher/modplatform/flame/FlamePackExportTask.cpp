@@ -57,6 +57,7 @@ FlamePackExportTask::FlamePackExportTask(const QString& name,
     , gameRoot(instance->gameRoot())
     , output(output)
     , filter(filter)
+    , exportCache(QDir("cache/exports").absoluteFilePath("flame.json"))
 {}
 
 void FlamePackExportTask::executeTask()
@@ -68,12 +69,18 @@ void FlamePackExportTask::executeTask()
 
 bool FlamePackExportTask::abort()
 {
-    if (task) {
+    if (!isRunning())
+        return false;
+
+    // nothing is built once the lookups are gone, and the list is copied since an aborted request removes itself from it
+    hashingDone = false;
+    const auto sent = requests;
+    for (const auto& request : sent)
+        request->abort();
+    if (task)
         task->abort();
-        emitAborted();
-        return true;
-    }
-    return false;
+    emitAborted();
+    return true;
 }
 
 void FlamePackExportTask::collectFiles()
@@ -89,6 +96,9 @@ void FlamePackExportTask::collectFiles()
 
     pendingHashes.clear();
     resolvedFiles.clear();
+    resolvedFingerprints.clear();
+    requestedProjects.clear();
+    requests.clear();
 
     if (mcInstance != nullptr) {
         mcInstance->loaderModList()->update();
@@ -102,7 +112,10 @@ void FlamePackExportTask::collectHashes()
     setAbortable(true);
     setStatus(tr("Finding file hashes..."));
     setProgress(1, 5);
-    auto allMods = mcInstance->loaderModList()->allMods();
+    hashingDone = false;
+    QList<Mod*> allMods;
+    if (mcInstance)
+        allMods = mcInstance->loaderModList()->allMods();
     ConcurrentTask::Ptr hashingTask(
         new ConcurrentTask(this, "MakeHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()));
     task.reset(hashingTask);
@@ -119,7 +132,7 @@ void FlamePackExportTask::collectHashes()
             auto hashTask = Hashing::createFlameHasher(file.absoluteFilePath());
             connect(hashTask.get(), &Hashing::Hasher::resultsReady, [this, relative, file](QString hash) {
                 if (m_state == Task::State::Running) {
-                    pendingHashes.insert(hash, { relative, file.absoluteFilePath(), relative.endsWith(".zip") });
+                    fileHashed(hash, { relative, file.absoluteFilePath(), relative.endsWith(".zip") });
                 }
             });
             connect(hashTask.get(), &Task::failed, this, &FlamePackExportTask::emitFailed);
@@ -143,7 +156,7 @@ void FlamePackExportTask::collectHashes()
             auto hashTask = Hashing::createFlameHasher(mod->fileinfo().absoluteFilePath());
             connect(hashTask.get(), &Hashing::Hasher::resultsReady, [this, mod](QString hash) {
                 if (m_state == Task::State::Running) {
-                    pendingHashes.insert(hash, { mod->name(), mod->fileinfo().absoluteFilePath(), mod->enabled(), true });
+                    fileHashed(hash, { mod->name(), mod->fileinfo().absoluteFilePath(), mod->enabled(), true });
                 }
             });
             connect(hashTask.get(), &Task::failed, this, &FlamePackExportTask::emitFailed);
@@ -156,7 +169,7 @@ void FlamePackExportTask::collectHashes()
         stepProgress(*progressStep);
     });
 
-    connect(hashingTask.get(), &Task::succeeded, this, &FlamePackExportTask::makeApiRequest);
+    connect(hashingTask.get(), &Task::succeeded, this, &FlamePackExportTask::hashingFinished);
     connect(hashingTask.get(), &Task::failed, this, [this, progressStep](QString reason) {
         progressStep->state = TaskStepState::Failed;
         stepProgress(*progressStep);
@@ -175,25 +188,60 @@ void FlamePackExportTask::collectHashes()
     hashingTask->start();
 }
 
-void FlamePackExportTask::makeApiRequest()
+void FlamePackExportTask::fileHashed(const QString& hash, const HashInfo& info)
 {
-    if (pendingHashes.isEmpty()) {
-        buildZip();
+    // files resolved by an earlier export resolve to the same project and file now
+    if (auto cached = exportCache.lookup(hash); !cached.isEmpty()) {
+        resolvedFiles.insert(info.path, { cached["modId"].toInt(), cached["fileId"].toInt(), info.enabled, info.isMod,
+                                          cached["name"].toString(), cached["slug"].toString(), cached["authors"].toString() });
+        return;
+    }
+
+    // The lookups are sent in batches while the rest is still being hashed
+    pendingHashes.insert(hash, info);
+    if (pendingHashes.size() >= API_BATCH_SIZE)
+        makeApiRequest();
+}
+
+void FlamePackExportTask::hashingFinished()
+{
+    if (m_state != Task::State::Running)
         return;
+
+    hashingDone = true;
+    if (!pendingHashes.isEmpty())
+        makeApiRequest();
+
+    // files resolved from their metadata may still be missing their project info
+    QStringList addonIds;
+    for (const auto& resolved : resolvedFiles) {
+        if (resolved.slug.isEmpty())
+            addonIds << QString::number(resolved.addonId);
     }
+    getProjectsInfo(addonIds);
+
+    if (requests.isEmpty())
+        buildZip();
+}
 
+void FlamePackExportTask::makeApiRequest()
+{
     setStatus(tr("Finding versions for hashes..."));
     setProgress(2, 5);
+    const auto batch = pendingHashes;
+    pendingHashes.clear();
+
     auto response = std::make_shared<QByteArray>();
 
     QList<uint> fingerprints;
-    for (auto& murmur : pendingHashes.keys()) {
+    for (auto& murmur : batch.keys()) {
         fingerprints.push_back(murmur.toUInt());
     }
 
-    task.reset(api.matchFingerprints(fingerprints, response));
+    Task::Ptr request = api.matchFingerprints(fingerprints, response);
+    auto sent = request.get();
 
-    connect(task.get(), &Task::succeeded, this, [this, response] {
+    connect(request.get(), &Task::succeeded, this, [this, response, batch] {
         QJsonParseError parseError{};
         QJsonDocument doc = QJsonDocument::fromJson(*response, &parseError);
         if (parseError.error != QJsonParseError::NoError) {
@@ -205,6 +253,7 @@ void FlamePackExportTask::makeApiRequest()
             return;
         }
 
+        QStringList addonIds;
         try {
             auto docObj = Json::requireObject(doc);
             auto dataObj = Json::requireObject(docObj, "data");
@@ -212,9 +261,6 @@ void FlamePackExportTask::makeApiRequest()
 
             if (dataArr.isEmpty()) {
                 qWarning() << "No matches found for fingerprint search!";
-
-                getProjectsInfo();
-                return;
             }
             for (auto match : dataArr) {
                 auto matchObj = Json::ensureObject(match, {});
@@ -222,56 +268,57 @@ void FlamePackExportTask::makeApiRequest()
 
                 if (matchObj.isEmpty() || fileObj.isEmpty()) {
                     qWarning() << "Fingerprint match is empty!";
-
-                    return;
+                    continue;
                 }
 
                 auto fingerprint = QString::number(Json::ensureVariant(fileObj, "fileFingerprint").toUInt());
-                auto mod = pendingHashes.find(fingerprint);
-                if (mod == pendingHashes.end()) {
+                auto mod = batch.find(fingerprint);
+                if (mod == batch.end()) {
                     qWarning() << "Invalid fingerprint from the API response.";
                     continue;
                 }
 
                 setStatus(tr("Parsing API response from CurseForge for '%1'...").arg(mod->name));
-                if (Json::ensureBoolean(fileObj, "isAvailable", false, "isAvailable"))
-                    resolvedFiles.insert(mod->path, { Json::requireInteger(fileObj, "modId"), Json::requireInteger(fileObj, "id"),
-                                                      mod->enabled, mod->isMod });
+                if (Json::ensureBoolean(fileObj, "isAvailable", false, "isAvailable")) {
+                    auto addonId = Json::requireInteger(fileObj, "modId");
+                    resolvedFiles.insert(mod->path, { addonId, Json::requireInteger(fileObj, "id"), mod->enabled, mod->isMod });
+                    resolvedFingerprints.insert(mod->path, fingerprint);
+                    addonIds << QString::number(addonId);
+                }
             }
 
         } catch (Json::JsonException& e) {
             qDebug() << e.cause();
             qDebug() << doc;
         }
-        pendingHashes.clear();
-        getProjectsInfo();
+        getProjectsInfo(addonIds);
     });
-    connect(task.get(), &NetJob::failed, this, &FlamePackExportTask::getProjectsInfo);
-    task->start();
+    connect(request.get(), &Task::finished, this, [this, sent] { requestFinished(sent); });
+    startRequest(request);
 }
 
-void FlamePackExportTask::getProjectsInfo()
+void FlamePackExportTask::getProjectsInfo(QStringList addonIds)
 {
-    setStatus(tr("Finding project info from CurseForge..."));
-    setProgress(3, 5);
-    QStringList addonIds;
-    for (const auto& resolved : resolvedFiles) {
-        if (resolved.slug.isEmpty()) {
-            addonIds << QString::number(resolved.addonId);
-        }
-    }
+    // several batches may resolve files of the same project
+    addonIds.removeDuplicates();
+    addonIds.erase(std::remove_if(addonIds.begin(), addonIds.end(), [this](const QString& id) { return requestedProjects.contains(id); }),
+                   addonIds.end());
+    for (const auto& id : addonIds)
+        requestedProjects.insert(id);
 
     auto response = std::make_shared<QByteArray>();
     Task::Ptr projTask;
 
     if (addonIds.isEmpty()) {
-        buildZip();
         return;
     } else if (addonIds.size() == 1) {
         projTask = api.getProject(*addonIds.begin(), response);
     } else {
         projTask = api.getProjects(addonIds, response);
     }
+    setStatus(tr("Finding project info from CurseForge..."));
+    setProgress(3, 5);
+    auto sent = projTask.get();
 
     connect(projTask.get(), &Task::succeeded, this, [this, response, addonIds] {
         QJsonParseError parseError{};
@@ -322,11 +369,26 @@ void FlamePackExportTask::getProjectsInfo()
             qDebug() << e.cause();
             qDebug() << doc;
         }
-        buildZip();
     });
     connect(projTask.get(), &Task::failed, this, &FlamePackExportTask::emitFailed);
-    task.reset(projTask);
-    task->start();
+    connect(projTask.get(), &Task::finished, this, [this, sent] { requestFinished(sent); });
+    startRequest(projTask);
+}
+
+void FlamePackExportTask::startRequest(Task::Ptr request)
+{
+    requests << request;
+    request->start();
+}
+
+void FlamePackExportTask::requestFinished(Task* request)
+{
+    requests.erase(std::remove_if(requests.begin(), requests.end(), [request](const Task::Ptr& other) { return other.get() == request; }),
+                   requests.end());
+
+    // the zip is built once everything was hashed and every lookup came back
+    if (m_state == Task::State::Running && hashingDone && requests.isEmpty() && pendingHashes.isEmpty())
+        buildZip();
 }
 
 void FlamePackExportTask::buildZip()
@@ -334,6 +396,18 @@ void FlamePackExportTask::buildZip()
     setStatus(tr("Adding files..."));
     setProgress(4, 5);
 
+    // only remember files we know everything about, the others are asked about again next time
+    for (auto it = resolvedFingerprints.constBegin(); it != resolvedFingerprints.constEnd(); it++) {
+        auto resolved = resolvedFiles.value(it.key());
+        if (!resolved.slug.isEmpty())
+            exportCache.insert(it.value(), { { "modId", resolved.addonId },
+                                             { "fileId", resolved.version },
+                                             { "name", resolved.name },
+                                             { "slug", resolved.slug },
+                                             { "authors", resolved.authors } });
+    }
+    exportCache.save();
+
     auto zipTask = makeShared<MMCZip::ExportToZipTask>(output, gameRoot, files, "overrides/", true, false);
     zipTask->addExtraFile("manifest.json", generateIndex());
     zipTask->addExtraFile("modlist.html", generateHTML());
@@ -342,6 +416,8 @@ void FlamePackExportTask::buildZip()
     std::transform(resolvedFiles.keyBegin(), resolvedFiles.keyEnd(), std::back_insert_iterator(exclude),
                    [this](QString file) { return gameRoot.relativeFilePath(file); });
     zipTask->setExcludeFiles(exclude);
+    if (mcInstance)
+        zipTask->setPreviousArchive(mcInstance->settings()->get("ExportLastArchive").toString());
 
     auto progressStep = std::make_shared<TaskStepProgress>();
     connect(zipTask.get(), &Task::finished, this, [this, progressStep] {
@@ -349,7 +425,11 @@ void FlamePackExportTask::buildZip()
         stepProgress(*progressStep);
     });
 
-    connect(zipTask.get(), &Task::succeeded, this, &FlamePackExportTask::emitSucceeded);
+    connect(zipTask.get(), &Task::succeeded, this, [this] {
+        if (mcInstance)
+            mcInstance->settings()->set("ExportLastArchive", output);
+        emitSucceeded();
+    });
     connect(zipTask.get(), &Task::aborted, this, &FlamePackExportTask::emitAborted);
     connect(zipTask.get(), &Task::failed, this, [this, progressStep](QString reason) {
         progressStep->state = TaskStepState::Failed;
@@ -23,6 +23,7 @@
 #include "MMCZip.h"
 #include "minecraft/MinecraftInstance.h"
 #include "modplatform/flame/FlameAPI.h"
+#include "modplatform/helpers/ExportCache.h"
 #include "tasks/Task.h"
 
 class FlamePackExportTask : public Task {
@@ -42,6 +43,8 @@ class FlamePackExportTask : public Task {
    private:
     static const QString TEMPLATE;
     static const QStringList FILE_EXTENSIONS;
+    // how many fingerprints are matched with one request
+    static constexpr int API_BATCH_SIZE = 100;
 
     // inputs
     const QString name, version, author;
@@ -70,16 +73,27 @@ class FlamePackExportTask : public Task {
     };
 
     FlameAPI api;
+    ExportCache exportCache;
 
     QFileInfoList files;
+    bool hashingDone = false;
+    // hashes that weren't sent in a lookup yet
     QMap<QString, HashInfo> pendingHashes{};
     QMap<QString, ResolvedFile> resolvedFiles{};
+    // fingerprints of the resolved files the API was asked about
+    QHash<QString, QString> resolvedFingerprints;
+    QSet<QString> requestedProjects;
+    QList<Task::Ptr> requests;
     Task::Ptr task;
 
     void collectFiles();
     void collectHashes();
+    void fileHashed(const QString& hash, const HashInfo& info);
+    void hashingFinished();
     void makeApiRequest();
-    void getProjectsInfo();
+    void getProjectsInfo(QStringList addonIds);
+    void startRequest(Task::Ptr request);
+    void requestFinished(Task* request);
     void buildZip();
 
     QByteArray generateIndex();
@@ -2,6 +2,8 @@
 #include <QFileInfo>
 #include <QUrl>
 
+#include <algorithm>
+
 #include "Json.h"
 
 void Flame::loadIndexedPack(Flame::IndexedPack& pack, QJsonObject& obj)
@@ -74,7 +76,7 @@ void Flame::loadIndexedInfo(IndexedPack& pack, QJsonObject& obj)
     pack.extraInfoLoaded = true;
 }
 
-void Flame::loadIndexedPackVersions(Flame::IndexedPack& pack, QJsonArray& arr)
+static QVector<Flame::IndexedVersion> loadVersions(const Flame::IndexedPack& pack, QJsonArray& arr)
 {
     QVector<Flame::IndexedVersion> unsortedVersions;
     for (auto versionIter : arr) {
@@ -115,8 +117,30 @@ void Flame::loadIndexedPackVersions(Flame::IndexedPack& pack, QJsonArray& arr)
         }
     }
 
-    auto orderSortPredicate = [](const IndexedVersion& a, const IndexedVersion& b) -> bool { return a.fileId > b.fileId; };
+    auto orderSortPredicate = [](const Flame::IndexedVersion& a, const Flame::IndexedVersion& b) -> bool { return a.fileId > b.fileId; };
     std::sort(unsortedVersions.begin(), unsortedVersions.end(), orderSortPredicate);
-    pack.versions = unsortedVersions;
+    return unsortedVersions;
+}
+
+void Flame::loadIndexedPackVersions(Flame::IndexedPack& pack, QJsonArray& arr)
+{
+    pack.versions = loadVersions(pack, arr);
+    pack.versionsFetched = arr.size();
+    pack.versionsTotal = arr.size();
+    pack.versionsLoaded = true;
+}
+
+void Flame::loadIndexedPackVersionsPage(Flame::IndexedPack& pack, QJsonArray& arr, const QJsonObject& pagination)
+{
+    // pages come newest first, so each one goes after the ones before; a file can move to the next page when one is added meanwhile
+    for (auto& version : loadVersions(pack, arr)) {
+        auto known = std::find_if(pack.versions.begin(), pack.versions.end(),
+                                  [&version](const IndexedVersion& other) { return other.fileId == version.fileId; });
+        if (known == pack.versions.end()) {
+            pack.versions.append(version);
+        }
+    }
+    pack.versionsFetched = Json::ensureInteger(pagination, "index", pack.versionsFetched) + arr.size();
+    pack.versionsTotal = Json::ensureInteger(pagination, "totalCount", pack.versionsFetched);
     pack.versionsLoaded = true;
 }
@@ -38,8 +38,13 @@ struct IndexedPack {
     QString logoUrl;
 
     bool versionsLoaded = false;
+    // how many of the pack's files were asked for so far, and how many it has; versions only holds the downloadable ones
+    int versionsFetched = 0;
+    int versionsTotal = 0;
     QVector<IndexedVersion> versions;
 
+    bool hasMoreVersions() const { return !versionsLoaded || versionsFetched < versionsTotal; }
+
     bool extraInfoLoaded = false;
     ModpackExtra extra;
 };
@@ -47,6 +52,8 @@ struct IndexedPack {
 void loadIndexedPack(IndexedPack& m, QJsonObject& obj);
 void loadIndexedInfo(IndexedPack&, QJsonObject&);
 void loadIndexedPackVersions(IndexedPack& m, QJsonArray& arr);
+/* Adds a page of the pack's files to the ones loaded before, pagination being what came with it. */
+void loadIndexedPackVersionsPage(IndexedPack& m, QJsonArray& arr, const QJsonObject& pagination);
 }  // namespace Flame
 
 Q_DECLARE_METATYPE(Flame::IndexedPack)
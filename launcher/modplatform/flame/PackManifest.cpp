@@ -78,6 +78,8 @@ bool Flame::File::parseFromObject(const QJsonObject& obj, bool throw_on_blocked)
 
     targetFolder = "mods";
 
+    size = static_cast<qint64>(obj.value("fileLength").toDouble(-1));
+
     // get the hash
     hash = QString();
     auto hashes = Json::ensureArray(obj, "hashes");
@@ -48,6 +48,8 @@ struct File {
 
     int projectId = 0;
     int fileId = 0;
+    // the expected size in bytes, or -1 if it isn't known
+    qint64 size = -1;
     // NOTE: the opposite to 'optional'
     bool required = true;
     QString hash;
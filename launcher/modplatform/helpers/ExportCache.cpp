@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ExportCache.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+namespace {
+constexpr int EXPORT_CACHE_VERSION = 1;
+
+// Entries we haven't used for this long are dropped on load
+constexpr qint64 EXPIRY_SECS = 180 * 24 * 60 * 60;
+}  // namespace
+
+ExportCache::ExportCache(QString file) : m_file(std::move(file))
+{
+    QFile in(m_file);
+    if (!in.open(QFile::ReadOnly))
+        return;
+
+    auto root = QJsonDocument::fromJson(in.readAll()).object();
+    if (root.value("version").toInt() != EXPORT_CACHE_VERSION) {
+        qWarning() << "Ignoring export cache with unknown format:" << m_file;
+        return;
+    }
+
+    auto expiry = QDateTime::currentSecsSinceEpoch() - EXPIRY_SECS;
+    const auto entries = root.value("entries").toObject();
+    for (auto it = entries.constBegin(); it != entries.constEnd(); it++) {
+        auto entry = it.value().toObject();
+        if (static_cast<qint64>(entry.value("lastUsed").toDouble()) < expiry) {
+            m_dirty = true;
+            continue;
+        }
+        m_entries.insert(it.key(), entry);
+    }
+}
+
+QJsonObject ExportCache::lookup(const QString& hash)
+{
+    auto it = m_entries.find(hash);
+    if (it == m_entries.end())
+        return {};
+
+    auto entry = it->toObject();
+    entry["lastUsed"] = QDateTime::currentSecsSinceEpoch();
+    *it = entry;
+    m_dirty = true;
+    return entry;
+}
+
+void ExportCache::insert(const QString& hash, QJsonObject resolved)
+{
+    if (hash.isEmpty())
+        return;
+    resolved["lastUsed"] = QDateTime::currentSecsSinceEpoch();
+    m_entries.insert(hash, resolved);
+    m_dirty = true;
+}
+
+void ExportCache::save()
+{
+    if (!m_dirty)
+        return;
+
+    QDir().mkpath(QFileInfo(m_file).absolutePath());
+
+    QSaveFile out(m_file);
+    if (!out.open(QFile::WriteOnly)) {
+        qWarning() << "Failed to save export cache:" << out.errorString();
+        return;
+    }
+
+    QJsonObject root;
+    root["version"] = EXPORT_CACHE_VERSION;
+    root["entries"] = m_entries;
+    out.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!out.commit()) {
+        qWarning() << "Failed to save export cache:" << out.errorString();
+        return;
+    }
+    m_dirty = false;
+}
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+/** What a platform resolved the file hashes of earlier pack exports to, so exporting again doesn't ask about files it already knows.
+ *
+ *  A published file keeps its hash, so entries stay valid; they are only dropped once unused for a while.
+ *  Hashes the platform didn't know aren't kept, since the file may have been published since.
+ *  Export tasks use this from the main thread only.
+ */
+class ExportCache {
+   public:
+    explicit ExportCache(QString file);
+
+    /* What the hash was resolved to, or an empty object if it wasn't. */
+    QJsonObject lookup(const QString& hash);
+    void insert(const QString& hash, QJsonObject resolved);
+
+    void save();
+
+   private:
+    QString m_file;
+    QJsonObject m_entries;
+    bool m_dirty = false;
+};
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "HashCache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#if defined(Q_OS_UNIX)
+#include <sys/stat.h>
+#endif
+
+namespace Hashing {
+
+namespace {
+constexpr quint32 HASH_CACHE_MAGIC = 0x504C4843;  // "PLHC"
+constexpr quint32 HASH_CACHE_VERSION = 1;
+
+// Entries of files we haven't looked at for this long are dropped on load
+constexpr qint64 EXPIRY_SECS = 60 * 24 * 60 * 60;
+}  // namespace
+
+FileIdentity FileIdentity::of(const QString& path)
+{
+    FileIdentity identity;
+#if defined(Q_OS_UNIX)
+    struct stat info;
+    if (::stat(QFile::encodeName(path).constData(), &info) != 0 || !S_ISREG(info.st_mode))
+        return identity;
+
+    identity.size = info.st_size;
+    identity.inode = info.st_ino;
+#if defined(Q_OS_MACOS)
+    identity.mtime = info.st_mtimespec.tv_sec * 1000000000LL + info.st_mtimespec.tv_nsec;
+#else
+    identity.mtime = info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+#endif
+#else
+    QFileInfo file_info(path);
+    if (!file_info.isFile())
+        return identity;
+
+    identity.size = file_info.size();
+    identity.mtime = file_info.lastModified().toMSecsSinceEpoch();
+#endif
+    return identity;
+}
+
+HashCache::HashCache(QString index_file) : m_index_file(std::move(index_file))
+{
+    m_save_timer.setSingleShot(true);
+    m_save_timer.setTimerType(Qt::VeryCoarseTimer);
+    connect(&m_save_timer, &QTimer::timeout, this, &HashCache::saveNow);
+
+    load();
+}
+
+HashCache::~HashCache()
+{
+    m_save_timer.stop();
+    saveNow();
+}
+
+QString HashCache::lookup(const QString& path, const FileIdentity& identity, const QString& type)
+{
+    if (!identity.isValid())
+        return {};
+
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_entries.find(QFileInfo(path).absoluteFilePath());
+    if (it == m_entries.end() || it->identity != identity)
+        return {};
+
+    auto hash = it->hashes.value(type);
+    if (!hash.isEmpty())
+        it->last_used = QDateTime::currentSecsSinceEpoch();
+    return hash;
+}
+
+void HashCache::insert(const QString& path, const FileIdentity& identity, const QString& type, const QString& hash)
+{
+    insert(path, identity, QHash<QString, QString>{ { type, hash } });
+}
+
+void HashCache::insert(const QString& path, const FileIdentity& identity, const QHash<QString, QString>& hashes)
+{
+    // The file changed while we were hashing it, so what we have doesn't describe either version
+    if (!identity.isValid() || FileIdentity::of(path) != identity)
+        return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        auto& entry = m_entries[QFileInfo(path).absoluteFilePath()];
+        if (entry.identity != identity) {
+            entry.identity = identity;
+            entry.hashes.clear();
+        }
+        for (auto it = hashes.constBegin(); it != hashes.constEnd(); it++) {
+            if (!it.value().isEmpty())
+                entry.hashes.insert(it.key(), it.value());
+        }
+        entry.last_used = QDateTime::currentSecsSinceEpoch();
+    }
+
+    markDirty();
+}
+
+void HashCache::markDirty()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_dirty = true;
+    }
+    // We may be on a hashing thread, and the timer lives on ours
+    QMetaObject::invokeMethod(this, "saveEventually", Qt::QueuedConnection);
+}
+
+void HashCache::saveEventually()
+{
+    // reset the save timer
+    m_save_timer.stop();
+    m_save_timer.start(30000);
+}
+
+void HashCache::load()
+{
+    QFile file(m_index_file);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic, version, count;
+    in >> magic >> version >> count;
+    if (in.status() != QDataStream::Ok || magic != HASH_CACHE_MAGIC || version != HASH_CACHE_VERSION) {
+        qWarning() << "Ignoring hash cache with unknown format:" << m_index_file;
+        return;
+    }
+
+    auto expiry = QDateTime::currentSecsSinceEpoch() - EXPIRY_SECS;
+
+    QHash<QString, Entry> entries;
+    for (quint32 i = 0; i < count; i++) {
+        QString path;
+        Entry entry;
+        in >> path >> entry.identity.size >> entry.identity.mtime >> entry.identity.inode >> entry.last_used >> entry.hashes;
+        if (in.status() != QDataStream::Ok) {
+            qWarning() << "Hash cache is corrupted, starting over:" << m_index_file;
+            return;
+        }
+        if (entry.last_used < expiry)
+            continue;
+        entries.insert(path, entry);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_entries = entries;
+}
+
+void HashCache::saveNow()
+{
+    QHash<QString, Entry> entries;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirty)
+            return;
+        entries = m_entries;
+        m_dirty = false;
+    }
+
+    QDir().mkpath(QFileInfo(m_index_file).absolutePath());
+
+    QSaveFile file(m_index_file);
+    if (!file.open(QFile::WriteOnly)) {
+        qWarning() << "Failed to save hash cache:" << file.errorString();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+
+    out << HASH_CACHE_MAGIC << HASH_CACHE_VERSION << static_cast<quint32>(entries.size());
+    for (auto it = entries.constBegin(); it != entries.constEnd(); it++) {
+        const auto& entry = it.value();
+        out << it.key() << entry.identity.size << entry.identity.mtime << entry.identity.inode << entry.last_used << entry.hashes;
+    }
+
+    if (!file.commit())
+        qWarning() << "Failed to save hash cache:" << file.errorString();
+}
+
+}  // namespace Hashing
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+namespace Hashing {
+
+/** What we know about a file on disk to tell whether its contents may have changed. */
+struct FileIdentity {
+    qint64 size = -1;
+    qint64 mtime = 0;
+    quint64 inode = 0;
+
+    bool isValid() const { return size >= 0; }
+    bool operator==(const FileIdentity& other) const { return size == other.size && mtime == other.mtime && inode == other.inode; }
+    bool operator!=(const FileIdentity& other) const { return !(*this == other); }
+
+    /* Returns an invalid identity if the path isn't a regular file. */
+    static FileIdentity of(const QString& path);
+};
+
+/** Persistent cache of file hashes, so unchanged files don't have to be read again to be hashed.
+ *
+ *  Entries are keyed by absolute path, and are only used while the file still has the identity it had when hashed.
+ *  All lookups and inserts are thread-safe, since hashing happens on worker threads.
+ */
+class HashCache : public QObject {
+    Q_OBJECT
+   public:
+    explicit HashCache(QString index_file);
+    ~HashCache() override;
+
+    /* The cached hash of the given type, or an empty string if there's none for a file with that identity. */
+    QString lookup(const QString& path, const FileIdentity& identity, const QString& type);
+
+    /* Records hashes of a file, which had the given identity when it was read to compute them. */
+    void insert(const QString& path, const FileIdentity& identity, const QString& type, const QString& hash);
+    void insert(const QString& path, const FileIdentity& identity, const QHash<QString, QString>& hashes);
+
+   public slots:
+    void saveEventually();
+    void saveNow();
+
+   private:
+    struct Entry {
+        FileIdentity identity;
+        QHash<QString, QString> hashes;
+        qint64 last_used = 0;
+    };
+
+    void load();
+    void markDirty();
+
+    QString m_index_file;
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    bool m_dirty = false;
+    QTimer m_save_timer;
+};
+
+}  // namespace Hashing
@@ -2,12 +2,15 @@
 
 #include <QDebug>
 #include <QFile>
-
-#include "FileSystem.h"
-#include "StringUtils.h"
+#include <QThread>
 
 #include <MurmurHash2.h>
 
+#include "Application.h"
+#include "modplatform/helpers/HashCache.h"
+#include "net/MultiChecksumValidator.h"
+#include "tasks/CpuExecutor.h"
+
 namespace Hashing {
 
 static ModPlatform::ProviderCapabilities ProviderCaps;
@@ -48,51 +51,110 @@ Hasher::Ptr createBlockedModHasher(QString file_path, ModPlatform::ResourceProvi
     return hasher;
 }
 
-void ModrinthHasher::executeTask()
+// Calls func with the whole contents of the file, memory-mapping it when possible.
+// Returns false if the file couldn't be opened or read.
+static bool withFileContents(const QString& path, const std::function<void(const QByteArray&)>& func)
 {
-    QFile file(m_path);
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly)) {
+        qCritical() << "Failed to open file for hashing:" << path << file.errorString();
+        return false;
+    }
 
-    try {
-        file.open(QFile::ReadOnly);
-    } catch (FS::FileSystemException& e) {
-        qCritical() << QString("Failed to open JAR file in %1").arg(m_path);
-        qCritical() << QString("Reason: ") << e.cause();
+    auto size = file.size();
+    if (size > 0) {
+        if (auto* mapped = file.map(0, size)) {
+            // Wraps the mapping without copying it; it stays valid until the unmap below
+            func(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), size));
+            file.unmap(mapped);
+            return true;
+        }
+    }
 
-        emitFailed("Failed to open file for hashing.");
-        return;
+    // Not mappable (empty file, special file or an unsupported filesystem), so fall back to a plain read
+    auto contents = file.readAll();
+    if (file.error() != QFileDevice::NoError) {
+        qCritical() << "Failed to read file for hashing:" << path << file.errorString();
+        return false;
     }
+    func(contents);
+    return true;
+}
 
-    auto hash_type = ProviderCaps.hashType(ModPlatform::ResourceProvider::MODRINTH).first();
-    m_hash = ProviderCaps.hash(ModPlatform::ResourceProvider::MODRINTH, &file, hash_type);
+static QString providerHash(const QString& path, ModPlatform::ResourceProvider provider, const QString& type)
+{
+    QString hash;
+    withFileContents(path, [&](const QByteArray& data) { hash = ProviderCaps.hash(provider, data, type); });
+    return hash;
+}
 
-    file.close();
+Hasher::Hasher(QString file_path) : m_path(std::move(file_path))
+{
+    connect(&m_watcher, &QFutureWatcher<QString>::finished, this, &Hasher::hashJobFinished);
+}
 
-    if (m_hash.isEmpty()) {
-        emitFailed("Empty hash!");
-    } else {
-        emitSucceeded();
-        emit resultsReady(m_hash);
-    }
+bool Hasher::abort()
+{
+    if (isRunning())
+        emitAborted();
+    return true;
 }
 
-void FlameHasher::executeTask()
+void Hasher::runHashJob(QString hash_type, std::function<QString()> job)
 {
-    // CF-specific
-    auto should_filter_out = [](char c) { return (c == 9 || c == 10 || c == 13 || c == 32); };
+    auto cache = APPLICATION->hashCache();
+    // bulk work, so that hashing a big mods folder can't starve more urgent work of threads
+    m_watcher.setFuture(CpuExecutor::run(CpuExecutor::Priority::Bulk, [cache, path = m_path, hash_type, job = std::move(job)] {
+        // Take the identity before reading, so a change while hashing makes the result uncacheable instead of stale
+        auto identity = FileIdentity::of(path);
+        if (cache) {
+            auto cached = cache->lookup(path, identity, hash_type);
+            if (!cached.isEmpty())
+                return cached;
+        }
+
+        auto hash = job();
+        if (cache && !hash.isEmpty())
+            cache->insert(path, identity, hash_type, hash);
+        return hash;
+    }));
+}
 
-    std::ifstream file_stream(StringUtils::toStdString(m_path).c_str(), std::ifstream::binary);
-    // TODO: This is very heavy work, but apparently QtConcurrent can't use move semantics, so we can't boop this to another thread.
-    // How do we make this non-blocking then?
-    m_hash = QString::number(MurmurHash2(std::move(file_stream), 4 * MiB, should_filter_out));
+void Hasher::hashJobFinished()
+{
+    // We were aborted while the job was still running
+    if (!isRunning())
+        return;
+
+    m_hash = m_watcher.result();
 
     if (m_hash.isEmpty()) {
         emitFailed("Empty hash!");
     } else {
-        emitSucceeded();
+        // Report the result first, so that whoever waits on our parent task has it by the time we finish
         emit resultsReady(m_hash);
+        emitSucceeded();
     }
 }
 
+void ModrinthHasher::executeTask()
+{
+    auto hash_type = ProviderCaps.hashType(ModPlatform::ResourceProvider::MODRINTH).first();
+    runHashJob(hash_type, [path = m_path, hash_type] { return providerHash(path, ModPlatform::ResourceProvider::MODRINTH, hash_type); });
+}
+
+void FlameHasher::executeTask()
+{
+    runHashJob("murmur2", [path = m_path] {
+        QString hash;
+        withFileContents(path, [&](const QByteArray& data) {
+            // Skips the CF-specific whitespace with the vectorized filter
+            hash = QString::number(CurseForgeMurmurHash2(data.constData(), static_cast<std::size_t>(data.size())));
+        });
+        return hash;
+    });
+}
+
 BlockedModHasher::BlockedModHasher(QString file_path, ModPlatform::ResourceProvider provider) : Hasher(file_path), provider(provider)
 {
     setObjectName(QString("BlockedModHasher: %1").arg(file_path));
@@ -101,28 +163,9 @@ BlockedModHasher::BlockedModHasher(QString file_path, ModPlatform::ResourceProvi
 
 void BlockedModHasher::executeTask()
 {
-    QFile file(m_path);
-
-    try {
-        file.open(QFile::ReadOnly);
-    } catch (FS::FileSystemException& e) {
-        qCritical() << QString("Failed to open JAR file in %1").arg(m_path);
-        qCritical() << QString("Reason: ") << e.cause();
-
-        emitFailed("Failed to open file for hashing.");
-        return;
-    }
-
-    m_hash = ProviderCaps.hash(provider, &file, hash_type);
-
-    file.close();
-
-    if (m_hash.isEmpty()) {
-        emitFailed("Empty hash!");
-    } else {
-        emitSucceeded();
-        emit resultsReady(m_hash);
-    }
+    // Cache under the digest we actually compute, since several hash types of a provider may share it
+    auto digest = Net::MultiChecksumValidator::nameOf(ProviderCaps.hashAlgorithm(provider, hash_type));
+    runHashJob(digest, [path = m_path, provider = provider, hash_type = hash_type] { return providerHash(path, provider, hash_type); });
 }
 
 QStringList BlockedModHasher::getHashTypes()
@@ -141,4 +184,85 @@ bool BlockedModHasher::useHashType(QString type)
     return false;
 }
 
+MultiHasher::MultiHasher(QString file_path, QList<ModPlatform::ResourceProvider> providers) : m_path(std::move(file_path))
+{
+    setObjectName(QString("MultiHasher: %1").arg(m_path));
+    for (auto provider : providers) {
+        auto type = hashTypeOf(provider);
+        if (!m_types.contains(type))
+            m_types.append(type);
+    }
+    connect(&m_watcher, &QFutureWatcher<QHash<QString, QString>>::finished, this, &MultiHasher::hashJobFinished);
+}
+
+QString MultiHasher::hashTypeOf(ModPlatform::ResourceProvider provider)
+{
+    // CurseForge identifies files by their fingerprint, see FlameHasher
+    if (provider == ModPlatform::ResourceProvider::FLAME)
+        return "murmur2";
+    return ProviderCaps.hashType(provider).first();
+}
+
+bool MultiHasher::abort()
+{
+    if (isRunning())
+        emitAborted();
+    return true;
+}
+
+void MultiHasher::executeTask()
+{
+    auto cache = APPLICATION->hashCache();
+    m_watcher.setFuture(CpuExecutor::run(CpuExecutor::Priority::Bulk, [cache, path = m_path, types = m_types] {
+        auto identity = FileIdentity::of(path);
+        QHash<QString, QString> hashes;
+        QStringList missing;
+        for (auto& type : types) {
+            auto cached = cache ? cache->lookup(path, identity, type) : QString();
+            if (cached.isEmpty())
+                missing.append(type);
+            else
+                hashes.insert(type, cached);
+        }
+        if (missing.isEmpty())
+            return hashes;
+
+        QFile file(path);
+        if (!file.open(QFile::ReadOnly)) {
+            qCritical() << "Failed to open file for hashing:" << path << file.errorString();
+            return QHash<QString, QString>();
+        }
+        QHash<QString, QString> computed;
+        auto size = file.size();
+        if (auto* mapped = size > 0 ? file.map(0, size) : nullptr) {
+            computed = ProviderCaps.hashAll(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), size), missing);
+            file.unmap(mapped);
+        } else {
+            computed = ProviderCaps.hashAll(&file, missing);
+        }
+        if (computed.isEmpty())
+            return QHash<QString, QString>();
+
+        if (cache)
+            cache->insert(path, identity, computed);
+        for (auto it = computed.cbegin(); it != computed.cend(); ++it)
+            hashes.insert(it.key(), it.value());
+        return hashes;
+    }));
+}
+
+void MultiHasher::hashJobFinished()
+{
+    if (!isRunning())
+        return;
+
+    m_hashes = m_watcher.result();
+    if (m_hashes.isEmpty()) {
+        emitFailed("Empty hash!");
+    } else {
+        emit resultsReady(m_hashes);
+        emitSucceeded();
+    }
+}
+
 }  // namespace Hashing
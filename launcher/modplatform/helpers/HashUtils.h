@@ -1,7 +1,11 @@
 #pragma once
 
+#include <QFutureWatcher>
+#include <QHash>
 #include <QString>
 
+#include <functional>
+
 #include "modplatform/ModIndex.h"
 #include "tasks/Task.h"
 
@@ -12,10 +16,10 @@ class Hasher : public Task {
    public:
     using Ptr = shared_qobject_ptr<Hasher>;
 
-    Hasher(QString file_path) : m_path(std::move(file_path)) {}
+    Hasher(QString file_path);
 
-    /* We can't really abort this task, but we can say we aborted and finish our thing quickly :) */
-    bool abort() override { return true; }
+    /* We can't really stop the worker, but we can say we aborted and drop its result when it arrives :) */
+    bool abort() override;
 
     void executeTask() override = 0;
 
@@ -25,9 +29,21 @@ class Hasher : public Task {
    signals:
     void resultsReady(QString hash);
 
+   protected:
+    /* Runs the job on the hashing thread pool and reports its result once it is done, unless the hash cache
+     * already has a hash of that type for the file as it is now.
+     * The job must not touch this object, since it runs on another thread. An empty result means failure. */
+    void runHashJob(QString hash_type, std::function<QString()> job);
+
+   private slots:
+    void hashJobFinished();
+
    protected:
     QString m_hash;
     QString m_path;
+
+   private:
+    QFutureWatcher<QString> m_watcher;
 };
 
 class FlameHasher : public Hasher {
@@ -58,6 +74,38 @@ class BlockedModHasher : public Hasher {
     QString hash_type;
 };
 
+/** Computes the hashes several providers want of the same file, reading it only once. */
+class MultiHasher : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<MultiHasher>;
+
+    MultiHasher(QString file_path, QList<ModPlatform::ResourceProvider> providers);
+
+    /* The hash type each provider identifies files by, the same one its own Hasher computes. */
+    static QString hashTypeOf(ModPlatform::ResourceProvider provider);
+
+    bool abort() override;
+
+    void executeTask() override;
+
+    /* By hash type, see hashTypeOf(). */
+    QHash<QString, QString> getResults() const { return m_hashes; }
+    QString getPath() const { return m_path; };
+
+   signals:
+    void resultsReady(QHash<QString, QString> hashes);
+
+   private slots:
+    void hashJobFinished();
+
+   private:
+    QString m_path;
+    QStringList m_types;
+    QHash<QString, QString> m_hashes;
+    QFutureWatcher<QHash<QString, QString>> m_watcher;
+};
+
 Hasher::Ptr createHasher(QString file_path, ModPlatform::ResourceProvider provider);
 Hasher::Ptr createFlameHasher(QString file_path);
 Hasher::Ptr createModrinthHasher(QString file_path);
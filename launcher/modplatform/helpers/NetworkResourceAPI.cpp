@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-only
 
 #include "NetworkResourceAPI.h"
+#include <QDir>
 #include <memory>
 
 #include "Application.h"
@@ -12,6 +13,70 @@
 
 #include "net/ApiDownload.h"
 
+#include "modplatform/helpers/SearchResponseCache.h"
+
+namespace {
+SearchResponseCache& searchCache()
+{
+    static SearchResponseCache s_cache(QDir("cache/search").absolutePath());
+    return s_cache;
+}
+
+// Hands a cached search response to the callbacks, the way a finished NetJob would
+class CachedSearchTask : public Task {
+   public:
+    CachedSearchTask(QByteArray response, ResourceAPI::SearchCallbacks callbacks) : m_response(std::move(response))
+    {
+        setAbortable(true);
+        QObject::connect(this, &Task::succeeded, [this, callbacks] {
+            auto doc = QJsonDocument::fromJson(m_response);
+            callbacks.on_succeed(doc);
+        });
+        QObject::connect(this, &Task::aborted, [callbacks] { callbacks.on_abort(); });
+    }
+
+   protected:
+    void executeTask() override
+    {
+        // still answer later, like the network would, so callers don't get their results before start() returns
+        QMetaObject::invokeMethod(
+            this,
+            [this] {
+                if (isRunning())
+                    emitSucceeded();
+            },
+            Qt::QueuedConnection);
+    }
+
+   private:
+    QByteArray m_response;
+};
+
+// Fetches a search again for the next time it is made, without anybody waiting on it
+void refreshSearch(const QString& search_url, const QString& debug_name)
+{
+    if (!searchCache().beginRefresh(search_url))
+        return;
+
+    auto response = std::make_shared<QByteArray>();
+    auto netJob = makeShared<NetJob>(QString("%1::RefreshSearch").arg(debug_name), APPLICATION->network());
+    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(search_url), response));
+
+    QObject::connect(netJob.get(), &NetJob::succeeded, [search_url, response] {
+        QJsonParseError parse_error{};
+        QJsonDocument::fromJson(*response, &parse_error);
+        if (parse_error.error == QJsonParseError::NoError)
+            searchCache().insert(search_url, *response);
+    });
+    // the job holds on to itself until it is done, and is deleted later
+    QObject::connect(netJob.get(), &NetJob::finished, [search_url, netJob]() mutable {
+        searchCache().endRefresh(search_url);
+        netJob.reset();
+    });
+    netJob->start();
+}
+}  // namespace
+
 Task::Ptr NetworkResourceAPI::searchProjects(SearchArgs&& args, SearchCallbacks&& callbacks) const
 {
     auto search_url_optional = getSearchURL(args);
@@ -22,12 +87,21 @@ Task::Ptr NetworkResourceAPI::searchProjects(SearchArgs&& args, SearchCallbacks&
 
     auto search_url = search_url_optional.value();
 
+    // Searches made before are answered right away, and stale answers are refreshed for the next time
+    if (auto cached = searchCache().lookup(search_url); cached.has_value()) {
+        if (cached->stale)
+            refreshSearch(search_url, debugName());
+        return makeShared<CachedSearchTask>(cached->data, callbacks);
+    }
+
     auto response = std::make_shared<QByteArray>();
     auto netJob = makeShared<NetJob>(QString("%1::Search").arg(debugName()), APPLICATION->network());
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(search_url), response));
+    auto download = Net::ApiDownload::makeByteArray(QUrl(search_url), response);
+    download->setPriority(Net::NetRequest::Priority::Interactive);
+    netJob->addNetAction(download);
 
-    QObject::connect(netJob.get(), &NetJob::succeeded, [this, response, callbacks] {
+    QObject::connect(netJob.get(), &NetJob::succeeded, [this, response, callbacks, search_url] {
         QJsonParseError parse_error{};
         QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
         if (parse_error.error != QJsonParseError::NoError) {
@@ -40,6 +114,7 @@ Task::Ptr NetworkResourceAPI::searchProjects(SearchArgs&& args, SearchCallbacks&
             return;
         }
 
+        searchCache().insert(search_url, *response);
         callbacks.on_succeed(doc);
     });
 
@@ -88,7 +163,9 @@ Task::Ptr NetworkResourceAPI::getProjectVersions(VersionSearchArgs&& args, Versi
     auto netJob = makeShared<NetJob>(QString("%1::Versions").arg(args.pack.name), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(versions_url, response));
+    auto download = Net::ApiDownload::makeByteArray(versions_url, response);
+    download->setPriority(Net::NetRequest::Priority::Interactive);
+    netJob->addNetAction(download);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [response, callbacks, args] {
         QJsonParseError parse_error{};
@@ -123,7 +200,9 @@ Task::Ptr NetworkResourceAPI::getProject(QString addonId, std::shared_ptr<QByteA
 
     auto netJob = makeShared<NetJob>(QString("%1::GetProject").arg(addonId), APPLICATION->network());
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(project_url), response));
+    auto download = Net::ApiDownload::makeByteArray(QUrl(project_url), response);
+    download->setPriority(Net::NetRequest::Priority::Interactive);
+    netJob->addNetAction(download);
 
     return netJob;
 }
@@ -139,7 +218,9 @@ Task::Ptr NetworkResourceAPI::getDependencyVersion(DependencySearchArgs&& args,
     auto netJob = makeShared<NetJob>(QString("%1::Dependency").arg(args.dependency.addonId.toString()), APPLICATION->network());
     auto response = std::make_shared<QByteArray>();
 
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(versions_url, response));
+    auto download = Net::ApiDownload::makeByteArray(versions_url, response);
+    download->setPriority(Net::NetRequest::Priority::Interactive);
+    netJob->addNetAction(download);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [=] {
         QJsonParseError parse_error{};
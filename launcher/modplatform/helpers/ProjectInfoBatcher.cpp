@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ProjectInfoBatcher.h"
+
+#include <QDebug>
+#include <QSet>
+
+// Waits on the batch it was put in, and hands over its part of the response
+class BatchedProjectTask : public Task {
+   public:
+    BatchedProjectTask(ProjectInfoBatcher* batcher, QString addonId, std::shared_ptr<QByteArray> response)
+        : m_batcher(batcher), m_addon_id(std::move(addonId)), m_response(std::move(response))
+    {
+        setAbortable(true);
+    }
+
+    const QString& addonId() const { return m_addon_id; }
+
+    void resolve(const QByteArray& data)
+    {
+        if (!isRunning())
+            return;
+        *m_response = data;
+        emitSucceeded();
+    }
+    void reject(const QString& reason)
+    {
+        if (isRunning())
+            emitFailed(reason);
+    }
+
+   protected:
+    void executeTask() override
+    {
+        if (!m_batcher) {
+            emitFailed(QObject::tr("The project request was cancelled"));
+            return;
+        }
+        setStatus(QObject::tr("Getting project info for %1").arg(m_addon_id));
+        m_batcher->enqueue(this);
+    }
+
+   private:
+    QPointer<ProjectInfoBatcher> m_batcher;
+    QString m_addon_id;
+    std::shared_ptr<QByteArray> m_response;
+};
+
+ProjectInfoBatcher::ProjectInfoBatcher(FetchFunction fetch, SplitFunction split, int max_batch_size, QObject* parent)
+    : QObject(parent), m_fetch(std::move(fetch)), m_split(std::move(split)), m_max_batch_size(max_batch_size)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(COALESCE_MS);
+    connect(&m_timer, &QTimer::timeout, this, &ProjectInfoBatcher::flush);
+}
+
+Task::Ptr ProjectInfoBatcher::getProject(const QString& addonId, std::shared_ptr<QByteArray> response)
+{
+    return makeShared<BatchedProjectTask>(this, addonId, std::move(response));
+}
+
+void ProjectInfoBatcher::enqueue(BatchedProjectTask* task)
+{
+    m_pending.append(task);
+    if (!m_timer.isActive())
+        m_timer.start();
+}
+
+void ProjectInfoBatcher::flush()
+{
+    QList<QPointer<BatchedProjectTask>> batch;
+    QSet<QString> ids;
+    for (auto& task : m_pending) {
+        // aborted or gone in the meantime
+        if (!task || !task->isRunning())
+            continue;
+        if (!ids.contains(task->addonId())) {
+            if (ids.size() == m_max_batch_size) {
+                sendBatch(std::move(batch));
+                batch.clear();
+                ids.clear();
+            }
+            ids.insert(task->addonId());
+        }
+        batch.append(task);
+    }
+    m_pending.clear();
+    if (!batch.isEmpty())
+        sendBatch(std::move(batch));
+}
+
+void ProjectInfoBatcher::sendBatch(QList<QPointer<BatchedProjectTask>> batch)
+{
+    QStringList ids;
+    for (auto& task : batch)
+        if (!ids.contains(task->addonId()))
+            ids.append(task->addonId());
+
+    auto response = std::make_shared<QByteArray>();
+    auto job = m_fetch(ids, response);
+    if (!job) {
+        for (auto& task : batch)
+            if (task)
+                task->reject(tr("Failed to create the project request"));
+        return;
+    }
+
+    connect(job.get(), &Task::succeeded, this, [this, batch, response] {
+        auto projects = m_split(*response);
+        for (auto& task : batch) {
+            if (!task)
+                continue;
+            if (auto project = projects.constFind(task->addonId()); project != projects.constEnd())
+                task->resolve(project.value());
+            else
+                task->reject(tr("Project %1 was not found").arg(task->addonId()));
+        }
+    });
+    connect(job.get(), &Task::failed, this, [batch](const QString& reason) {
+        for (auto& task : batch)
+            if (task)
+                task->reject(reason);
+    });
+    connect(job.get(), &Task::aborted, this, [batch] {
+        for (auto& task : batch)
+            if (task)
+                task->reject(tr("The project request was aborted"));
+    });
+    auto raw = job.get();
+    connect(raw, &Task::finished, this, [this, raw] {
+        for (auto it = m_running.begin(); it != m_running.end(); ++it) {
+            if (it->get() == raw) {
+                m_running.erase(it);
+                break;
+            }
+        }
+    });
+
+    m_running.append(job);
+    qDebug() << "Getting info for" << ids.size() << "projects in one request";
+    job->start();
+}
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+
+#include <functional>
+#include <memory>
+
+#include "tasks/Task.h"
+
+class BatchedProjectTask;
+
+/** Merges the project requests made within a short window into requests to the platform's bulk endpoint.
+ *
+ *  Every request still gets its own task, and its response is the one the single project endpoint would have
+ *  given, so callers don't have to know about the batching.
+ */
+class ProjectInfoBatcher : public QObject {
+    Q_OBJECT
+   public:
+    /* Makes the bulk request for the given projects, not started yet. */
+    using FetchFunction = std::function<Task::Ptr(QStringList, std::shared_ptr<QByteArray>)>;
+    /* Splits a bulk response into single project responses, by every ID they may have been asked for with. */
+    using SplitFunction = std::function<QHash<QString, QByteArray>(const QByteArray&)>;
+
+    ProjectInfoBatcher(FetchFunction fetch, SplitFunction split, int max_batch_size, QObject* parent = nullptr);
+
+    Task::Ptr getProject(const QString& addonId, std::shared_ptr<QByteArray> response);
+
+    /* How long requests are gathered before the first of them is sent. */
+    static constexpr int COALESCE_MS = 50;
+
+   private:
+    friend class BatchedProjectTask;
+    void enqueue(BatchedProjectTask* task);
+    void flush();
+    void sendBatch(QList<QPointer<BatchedProjectTask>> batch);
+
+    FetchFunction m_fetch;
+    SplitFunction m_split;
+    int m_max_batch_size;
+
+    QTimer m_timer;
+    QList<QPointer<BatchedProjectTask>> m_pending;
+    QList<Task::Ptr> m_running;
+};
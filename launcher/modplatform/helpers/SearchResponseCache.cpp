@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "SearchResponseCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace {
+// Responses younger than this are served without being fetched again
+constexpr qint64 FRESH_SECS = 5 * 60;
+// Responses older than this aren't served at all
+constexpr qint64 EXPIRY_SECS = 24 * 60 * 60;
+// How much of the responses is kept in memory, in KiB
+constexpr int MEMORY_LIMIT_KIB = 32 * 1024;
+}  // namespace
+
+SearchResponseCache::SearchResponseCache(QString directory) : m_directory(std::move(directory)), m_entries(MEMORY_LIMIT_KIB)
+{
+    // expired responses are never served again, so they don't need to take up space either
+    auto expiry = QDateTime::currentDateTime().addSecs(-EXPIRY_SECS);
+    for (auto& file : QDir(m_directory).entryInfoList({ "*.json" }, QDir::Files)) {
+        if (file.lastModified() < expiry)
+            QFile::remove(file.absoluteFilePath());
+    }
+}
+
+QString SearchResponseCache::pathOf(const QString& url) const
+{
+    auto name = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QDir(m_directory).absoluteFilePath(name + ".json");
+}
+
+auto SearchResponseCache::lookup(const QString& url) -> std::optional<Response>
+{
+    auto now = QDateTime::currentSecsSinceEpoch();
+
+    auto entry = m_entries.object(url);
+    if (!entry) {
+        QFile file(pathOf(url));
+        if (!file.open(QFile::ReadOnly))
+            return {};
+        auto fetched = QFileInfo(file).lastModified().toSecsSinceEpoch();
+        if (now - fetched > EXPIRY_SECS)
+            return {};
+
+        entry = new Entry{ file.readAll(), fetched };
+        if (!m_entries.insert(url, entry, std::max(1, static_cast<int>(entry->data.size() / 1024)))) {
+            // too big to be kept in memory, which QCache took care of deleting already
+            file.seek(0);
+            return Response{ file.readAll(), now - fetched > FRESH_SECS };
+        }
+    }
+
+    if (now - entry->fetched > EXPIRY_SECS)
+        return {};
+    return Response{ entry->data, now - entry->fetched > FRESH_SECS };
+}
+
+bool SearchResponseCache::beginRefresh(const QString& url)
+{
+    if (m_refreshing.contains(url))
+        return false;
+    m_refreshing.insert(url);
+    return true;
+}
+
+void SearchResponseCache::insert(const QString& url, const QByteArray& data)
+{
+    auto entry = new Entry{ data, QDateTime::currentSecsSinceEpoch() };
+    m_entries.insert(url, entry, std::max(1, static_cast<int>(data.size() / 1024)));
+
+    QDir().mkpath(m_directory);
+    QSaveFile file(pathOf(url));
+    if (!file.open(QFile::WriteOnly) || file.write(data) != data.size() || !file.commit())
+        qWarning() << "Failed to save search response:" << file.errorString();
+}
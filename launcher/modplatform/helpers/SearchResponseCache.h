@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QSet>
+#include <QString>
+
+#include <optional>
+
+/** Responses to resource searches, in memory and on disk, so going back to a search shows its results right away.
+ *
+ *  Searches are keyed by their request URL, which holds every search argument in a fixed order.
+ *  Stale responses are still served, but should be fetched again for the next time.
+ *  Only used from the main thread.
+ */
+class SearchResponseCache {
+   public:
+    struct Response {
+        QByteArray data;
+        bool stale = false;
+    };
+
+    explicit SearchResponseCache(QString directory);
+
+    std::optional<Response> lookup(const QString& url);
+    void insert(const QString& url, const QByteArray& data);
+
+    /* Whether a refresh of the response should be started now, so each is only fetched again once at a time. */
+    bool beginRefresh(const QString& url);
+    void endRefresh(const QString& url) { m_refreshing.remove(url); }
+
+   private:
+    struct Entry {
+        QByteArray data;
+        qint64 fetched = 0;
+    };
+
+    QString pathOf(const QString& url) const;
+
+    QString m_directory;
+    QCache<QString, Entry> m_entries;
+    QSet<QString> m_refreshing;
+};
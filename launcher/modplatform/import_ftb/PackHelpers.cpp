@@ -18,7 +18,10 @@
 
 #include "modplatform/import_ftb/PackHelpers.h"
 
-#include <QIcon>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QString>
 #include <QVariant>
 
@@ -27,12 +30,28 @@
 
 namespace FTBImportAPP {
 
-Modpack parseDirectory(QString path)
+namespace {
+
+struct CachedModpack {
+    QDateTime instanceModified;
+    QDateTime versionModified;
+    Modpack modpack;
+};
+
+struct Cache {
+    QMutex mutex;
+    QHash<QString, CachedModpack> modpacks;
+};
+
+Cache& cache()
+{
+    static Cache s_cache;
+    return s_cache;
+}
+
+Modpack parseFiles(const QString& path, const QFileInfo& instanceFile, const QFileInfo& versionsFile)
 {
     Modpack modpack{ path };
-    auto instanceFile = QFileInfo(FS::PathCombine(path, "instance.json"));
-    if (!instanceFile.exists() || !instanceFile.isFile())
-        return {};
     try {
         auto doc = Json::requireDocument(instanceFile.absoluteFilePath(), "FTB_APP instance JSON file");
         const auto root = doc.object();
@@ -48,9 +67,6 @@ Modpack parseDirectory(QString path)
         qDebug() << "Couldn't load ftb instance json: " << e.cause();
         return {};
     }
-    auto versionsFile = QFileInfo(FS::PathCombine(path, "version.json"));
-    if (!versionsFile.exists() || !versionsFile.isFile())
-        return {};
     try {
         auto doc = Json::requireDocument(versionsFile.absoluteFilePath(), "FTB_APP version JSON file");
         const auto root = doc.object();
@@ -84,8 +100,35 @@ Modpack parseDirectory(QString path)
     }
     auto iconFile = QFileInfo(FS::PathCombine(path, "folder.jpg"));
     if (iconFile.exists() && iconFile.isFile()) {
-        modpack.icon = QIcon(iconFile.absoluteFilePath());
+        modpack.iconPath = iconFile.absoluteFilePath();
+    }
+    return modpack;
+}
+
+}  // namespace
+
+Modpack parseDirectory(QString path)
+{
+    auto instanceFile = QFileInfo(FS::PathCombine(path, "instance.json"));
+    if (!instanceFile.exists() || !instanceFile.isFile())
+        return {};
+    auto versionsFile = QFileInfo(FS::PathCombine(path, "version.json"));
+    if (!versionsFile.exists() || !versionsFile.isFile())
+        return {};
+
+    auto& c = cache();
+    {
+        QMutexLocker locker(&c.mutex);
+        auto it = c.modpacks.constFind(path);
+        if (it != c.modpacks.cend() && it->instanceModified == instanceFile.lastModified() &&
+            it->versionModified == versionsFile.lastModified())
+            return it->modpack;
     }
+
+    // broken instances are remembered too, so they aren't read (and complained about) again every time
+    auto modpack = parseFiles(path, instanceFile, versionsFile);
+    QMutexLocker locker(&c.mutex);
+    c.modpacks.insert(path, { instanceFile.lastModified(), versionsFile.lastModified(), modpack });
     return modpack;
 }
 
@@ -17,7 +17,6 @@
  */
 #pragma once
 
-#include <QIcon>
 #include <QList>
 #include <QMetaType>
 #include <QString>
@@ -43,11 +42,13 @@ struct Modpack {
     std::optional<ModPlatform::ModLoaderType> loaderType;
     QString loaderVersion;
 
-    QIcon icon;
+    // loaded when it's shown
+    QString iconPath;
 };
 
 using ModpackList = QList<Modpack>;
 
+/** Reads the FTB App instance in that folder, remembering it until its json files change. Thread-safe. */
 Modpack parseDirectory(QString path);
 
 }  // namespace FTBImportAPP
@@ -34,11 +34,13 @@ void PackInstallTask::executeTask()
 {
     setStatus(tr("Copying files..."));
     setAbortable(false);
-    progress(1, 2);
 
     m_copyFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this] {
+        // FTB App instances are usually on the same drive, where cloning them is nearly free
         FS::copy folderCopy(m_pack.path, FS::PathCombine(m_stagingPath, "minecraft"));
-        folderCopy.followSymlinks(true);
+        folderCopy.followSymlinks(true).cloneWhenPossible(true);
+        connect(&folderCopy, &FS::copy::copyProgress, this,
+                [this](qsizetype done, qsizetype total, const QString&) { setProgress(done, total); });
         return folderCopy();
     });
     connect(&m_copyFutureWatcher, &QFutureWatcher<bool>::finished, this, &PackInstallTask::copySettings);
@@ -49,7 +51,6 @@ void PackInstallTask::executeTask()
 void PackInstallTask::copySettings()
 {
     setStatus(tr("Copying settings..."));
-    progress(2, 2);
     QString instanceConfigPath = FS::PathCombine(m_stagingPath, "instance.cfg");
     auto instanceSettings = std::make_shared<INISettingsObject>(instanceConfigPath);
     instanceSettings->suspendSave();
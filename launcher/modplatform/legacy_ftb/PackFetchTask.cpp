@@ -36,14 +36,34 @@
 #include "PackFetchTask.h"
 #include "PrivatePackManager.h"
 
-#include <QDomDocument>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QXmlStreamReader>
 #include "Application.h"
 #include "BuildConfig.h"
 
 #include "net/ApiDownload.h"
+#include "tasks/CpuExecutor.h"
 
 namespace LegacyFTB {
 
+namespace {
+struct ParsedLists {
+    bool publicOk = false;
+    bool thirdPartyOk = false;
+    ModpackList publicPacks;
+    ModpackList thirdPartyPacks;
+};
+
+QByteArray readList(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    return file.readAll();
+}
+}  // namespace
+
 void PackFetchTask::fetch()
 {
     publicPacks.clear();
@@ -53,11 +73,13 @@ void PackFetchTask::fetch()
 
     QUrl publicPacksUrl = QUrl(BuildConfig.LEGACY_FTB_CDN_BASE_URL + "static/modpacks.xml");
     qDebug() << "Downloading public version info from" << publicPacksUrl.toString();
-    jobPtr->addNetAction(Net::ApiDownload::makeByteArray(publicPacksUrl, publicModpacksXmlFileData));
+    publicModpacksXmlEntry = APPLICATION->metacache()->resolveEntry("FTBPacks", "modpacks.xml");
+    jobPtr->addNetAction(Net::ApiDownload::makeCached(publicPacksUrl, publicModpacksXmlEntry));
 
     QUrl thirdPartyUrl = QUrl(BuildConfig.LEGACY_FTB_CDN_BASE_URL + "static/thirdparty.xml");
     qDebug() << "Downloading thirdparty version info from" << thirdPartyUrl.toString();
-    jobPtr->addNetAction(Net::Download::makeByteArray(thirdPartyUrl, thirdPartyModpacksXmlFileData));
+    thirdPartyModpacksXmlEntry = APPLICATION->metacache()->resolveEntry("FTBPacks", "thirdparty.xml");
+    jobPtr->addNetAction(Net::Download::makeCached(thirdPartyUrl, thirdPartyModpacksXmlEntry));
 
     QObject::connect(jobPtr.get(), &NetJob::succeeded, this, &PackFetchTask::fileDownloadFinished);
     QObject::connect(jobPtr.get(), &NetJob::failed, this, &PackFetchTask::fileDownloadFailed);
@@ -70,128 +92,155 @@ void PackFetchTask::fetchPrivate(const QStringList& toFetch)
 {
     QString privatePackBaseUrl = BuildConfig.LEGACY_FTB_CDN_BASE_URL + "static/%1.xml";
 
+    // one job for all of them, each pack is parsed as soon as it's there
+    NetJob* job = new NetJob("Fetching private packs", m_network);
+    auto packCodes = std::make_shared<QHash<Net::NetRequest*, QString>>();
     for (auto& packCode : toFetch) {
         auto data = std::make_shared<QByteArray>();
-        NetJob* job = new NetJob("Fetching private pack", m_network);
-        job->addNetAction(Net::ApiDownload::makeByteArray(privatePackBaseUrl.arg(packCode), data));
-
-        QObject::connect(job, &NetJob::succeeded, this, [this, job, data, packCode] {
-            ModpackList packs;
-            parseAndAddPacks(*data, PackType::Private, packs);
-            foreach (Modpack currentPack, packs) {
-                currentPack.packCode = packCode;
-                emit privateFileDownloadFinished(currentPack);
-            }
-
-            job->deleteLater();
-
-            data->clear();
-        });
-
-        QObject::connect(job, &NetJob::failed, this, [this, job, packCode, data](QString reason) {
-            emit privateFileDownloadFailed(reason, packCode);
-            job->deleteLater();
-
-            data->clear();
+        auto download = Net::ApiDownload::makeByteArray(privatePackBaseUrl.arg(packCode), data);
+        packCodes->insert(download.get(), packCode);
+
+        QObject::connect(download.get(), &Task::succeeded, this, [this, data, packCode] {
+            auto watcher = new QFutureWatcher<ModpackList>(this);
+            QObject::connect(watcher, &QFutureWatcher<ModpackList>::finished, this, [this, watcher, packCode] {
+                for (auto currentPack : watcher->result()) {
+                    currentPack.packCode = packCode;
+                    emit privateFileDownloadFinished(currentPack);
+                }
+                watcher->deleteLater();
+            });
+            watcher->setFuture(CpuExecutor::run(CpuExecutor::Priority::Interactive, [xml = std::move(*data)] {
+                ModpackList packs;
+                parseAndAddPacks(xml, PackType::Private, packs);
+                return packs;
+            }));
         });
 
-        QObject::connect(job, &NetJob::aborted, this, [this, job, data] {
-            emit aborted();
-            job->deleteLater();
+        job->addNetAction(download);
+    }
 
-            data->clear();
-        });
+    // the downloads are retried a few times, only the ones that still failed in the end are reported
+    QObject::connect(job, &NetJob::failed, this, [this, job, packCodes](QString reason) {
+        for (auto action : job->getFailedActions()) {
+            emit privateFileDownloadFailed(reason, packCodes->value(action));
+        }
+    });
+    QObject::connect(job, &NetJob::aborted, this, [this] { emit aborted(); });
+    QObject::connect(job, &NetJob::finished, job, &QObject::deleteLater);
 
-        job->start();
-    }
+    job->start();
 }
 
 void PackFetchTask::fileDownloadFinished()
 {
     jobPtr.reset();
+    parseLists(false);
+}
 
-    QStringList failedLists;
+void PackFetchTask::parseLists(bool fromCache)
+{
+    auto watcher = new QFutureWatcher<ParsedLists>(this);
+    QObject::connect(watcher, &QFutureWatcher<ParsedLists>::finished, this, [this, watcher, fromCache] {
+        auto lists = watcher->result();
+        watcher->deleteLater();
 
-    if (!parseAndAddPacks(*publicModpacksXmlFileData, PackType::Public, publicPacks)) {
-        failedLists.append(tr("Public Packs"));
-    }
+        publicPacks = lists.publicPacks;
+        thirdPartyPacks = lists.thirdPartyPacks;
 
-    if (!parseAndAddPacks(*thirdPartyModpacksXmlFileData, PackType::ThirdParty, thirdPartyPacks)) {
-        failedLists.append(tr("Third Party Packs"));
-    }
+        QStringList failedLists;
+        if (!lists.publicOk) {
+            failedLists.append(tr("Public Packs"));
+        }
+        if (!lists.thirdPartyOk) {
+            failedLists.append(tr("Third Party Packs"));
+        }
 
-    if (failedLists.size() > 0) {
-        emit failed(tr("Failed to download some pack lists: %1").arg(failedLists.join("\n- ")));
-    } else {
-        emit finished(publicPacks, thirdPartyPacks);
-    }
+        if (failedLists.size() > 0) {
+            emit failed(tr("Failed to download some pack lists: %1").arg(failedLists.join("\n- ")));
+        } else {
+            if (fromCache)
+                qWarning() << "Using the FTB pack lists from the last time they were downloaded";
+            emit finished(publicPacks, thirdPartyPacks);
+        }
+    });
+
+    watcher->setFuture(CpuExecutor::run(CpuExecutor::Priority::Interactive, [publicPath = publicModpacksXmlEntry->getFullPath(),
+                                                                              thirdPartyPath = thirdPartyModpacksXmlEntry->getFullPath()] {
+        ParsedLists lists;
+        lists.publicOk = parseAndAddPacks(readList(publicPath), PackType::Public, lists.publicPacks);
+        lists.thirdPartyOk = parseAndAddPacks(readList(thirdPartyPath), PackType::ThirdParty, lists.thirdPartyPacks);
+        return lists;
+    }));
 }
 
-bool PackFetchTask::parseAndAddPacks(QByteArray& data, PackType packType, ModpackList& list)
+bool PackFetchTask::parseAndAddPacks(const QByteArray& data, PackType packType, ModpackList& list)
 {
-    QDomDocument doc;
-
-    QString errorMsg = "Unknown error.";
-    int errorLine = -1;
-    int errorCol = -1;
-
-    if (!doc.setContent(data, false, &errorMsg, &errorLine, &errorCol)) {
-        auto fullErrMsg = QString("Failed to fetch modpack data: %1 %2:%3!").arg(errorMsg).arg(errorLine).arg(errorCol);
-        qWarning() << fullErrMsg;
-        data.clear();
-        return false;
-    }
-
-    QDomNodeList nodes = doc.elementsByTagName("modpack");
-    for (int i = 0; i < nodes.length(); i++) {
-        QDomElement element = nodes.at(i).toElement();
-
-        Modpack modpack;
-        modpack.name = element.attribute("name");
-        modpack.currentVersion = element.attribute("version");
-        modpack.mcVersion = element.attribute("mcVersion");
-        modpack.description = element.attribute("description");
-        modpack.mods = element.attribute("mods");
-        modpack.logo = element.attribute("logo");
-        modpack.oldVersions = element.attribute("oldVersions").split(";");
-        modpack.broken = false;
-        modpack.bugged = false;
-
-        // remove empty if the xml is bugged
-        for (QString curr : modpack.oldVersions) {
-            if (curr.isNull() || curr.isEmpty()) {
-                modpack.oldVersions.removeAll(curr);
-                modpack.bugged = true;
-                qWarning() << "Removed some empty versions from" << modpack.name;
+    QXmlStreamReader xml(data);
+    ModpackList packs;
+    while (!xml.atEnd()) {
+        if (xml.readNext() == QXmlStreamReader::StartElement && xml.name() == QLatin1String("modpack")) {
+            auto attributes = xml.attributes();
+            auto attribute = [&attributes](const char* name) { return attributes.value(QLatin1String(name)).toString(); };
+
+            Modpack modpack;
+            modpack.name = attribute("name");
+            modpack.currentVersion = attribute("version");
+            modpack.mcVersion = attribute("mcVersion");
+            modpack.description = attribute("description");
+            modpack.mods = attribute("mods");
+            modpack.logo = attribute("logo");
+            modpack.oldVersions = attribute("oldVersions").split(";");
+            modpack.broken = false;
+            modpack.bugged = false;
+
+            // remove empty if the xml is bugged
+            for (QString curr : modpack.oldVersions) {
+                if (curr.isNull() || curr.isEmpty()) {
+                    modpack.oldVersions.removeAll(curr);
+                    modpack.bugged = true;
+                    qWarning() << "Removed some empty versions from" << modpack.name;
+                }
             }
-        }
 
-        if (modpack.oldVersions.size() < 1) {
-            if (!modpack.currentVersion.isNull() && !modpack.currentVersion.isEmpty()) {
-                modpack.oldVersions.append(modpack.currentVersion);
-                qWarning() << "Added current version to oldVersions because oldVersions was empty! (" + modpack.name + ")";
-            } else {
-                modpack.broken = true;
-                qWarning() << "Broken pack:" << modpack.name << " => No valid version!";
+            if (modpack.oldVersions.size() < 1) {
+                if (!modpack.currentVersion.isNull() && !modpack.currentVersion.isEmpty()) {
+                    modpack.oldVersions.append(modpack.currentVersion);
+                    qWarning() << "Added current version to oldVersions because oldVersions was empty! (" + modpack.name + ")";
+                } else {
+                    modpack.broken = true;
+                    qWarning() << "Broken pack:" << modpack.name << " => No valid version!";
+                }
             }
-        }
 
-        modpack.author = element.attribute("author");
+            modpack.author = attribute("author");
 
-        modpack.dir = element.attribute("dir");
-        modpack.file = element.attribute("url");
+            modpack.dir = attribute("dir");
+            modpack.file = attribute("url");
 
-        modpack.type = packType;
+            modpack.type = packType;
+
+            packs.append(modpack);
+        }
+    }
 
-        list.append(modpack);
+    if (xml.hasError()) {
+        qWarning() << QString("Failed to fetch modpack data: %1 %2:%3!").arg(xml.errorString()).arg(xml.lineNumber()).arg(xml.columnNumber());
+        return false;
     }
 
+    list.append(packs);
     return true;
 }
 
 void PackFetchTask::fileDownloadFailed(QString reason)
 {
     qWarning() << "Fetching FTBPacks failed:" << reason;
+    jobPtr.reset();
+    // the lists hardly ever change, the ones from last time are better than none
+    if (QFile::exists(publicModpacksXmlEntry->getFullPath()) && QFile::exists(thirdPartyModpacksXmlEntry->getFullPath())) {
+        parseLists(true);
+        return;
+    }
     emit failed(reason);
 }
 
@@ -5,6 +5,7 @@
 #include <QTemporaryDir>
 #include <memory>
 #include "PackHelpers.h"
+#include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 
 namespace LegacyFTB {
@@ -23,10 +24,13 @@ class PackFetchTask : public QObject {
     shared_qobject_ptr<QNetworkAccessManager> m_network;
     NetJob::Ptr jobPtr;
 
-    std::shared_ptr<QByteArray> publicModpacksXmlFileData = std::make_shared<QByteArray>();
-    std::shared_ptr<QByteArray> thirdPartyModpacksXmlFileData = std::make_shared<QByteArray>();
+    // the lists are kept in the metacache, and only downloaded again when they changed
+    MetaEntryPtr publicModpacksXmlEntry;
+    MetaEntryPtr thirdPartyModpacksXmlEntry;
 
-    bool parseAndAddPacks(QByteArray& data, PackType packType, ModpackList& list);
+    /// thread-safe, the lists are parsed on a worker
+    static bool parseAndAddPacks(const QByteArray& data, PackType packType, ModpackList& list);
+    void parseLists(bool fromCache);
     ModpackList publicPacks;
     ModpackList thirdPartyPacks;
 
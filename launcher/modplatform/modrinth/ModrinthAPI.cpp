@@ -11,6 +11,38 @@
 #include "net/NetJob.h"
 #include "net/Upload.h"
 
+#include "modplatform/helpers/ProjectInfoBatcher.h"
+
+#include <QCoreApplication>
+
+namespace {
+// Project IDs are 8 characters, so this keeps the bulk request URL well short of any length limit
+constexpr int PROJECT_BATCH_SIZE = 100;
+
+// Single projects are looked up as a part of a bulk request, and answered with their own object of the bulk response
+ProjectInfoBatcher* projectBatcher()
+{
+    static auto* s_batcher = new ProjectInfoBatcher(
+        [](QStringList addonIds, std::shared_ptr<QByteArray> response) {
+            static const ModrinthAPI api;
+            return api.getProjects(addonIds, response);
+        },
+        [](const QByteArray& response) {
+            QHash<QString, QByteArray> projects;
+            for (auto project : QJsonDocument::fromJson(response).array()) {
+                auto obj = project.toObject();
+                auto data = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+                // dependencies may be asked for by slug
+                projects.insert(obj["id"].toString(), data);
+                projects.insert(obj["slug"].toString(), data);
+            }
+            return projects;
+        },
+        PROJECT_BATCH_SIZE, QCoreApplication::instance());
+    return s_batcher;
+}
+}  // namespace
+
 Task::Ptr ModrinthAPI::currentVersion(QString hash, QString hash_format, std::shared_ptr<QByteArray> response)
 {
     auto netJob = makeShared<NetJob>(QString("Modrinth::GetCurrentVersion"), APPLICATION->network());
@@ -111,6 +143,11 @@ Task::Ptr ModrinthAPI::getProjects(QStringList addonIds, std::shared_ptr<QByteAr
     return netJob;
 }
 
+Task::Ptr ModrinthAPI::getProject(QString addonId, std::shared_ptr<QByteArray> response) const
+{
+    return projectBatcher()->getProject(addonId, response);
+}
+
 QList<ResourceAPI::SortingMethod> ModrinthAPI::getSortingMethods() const
 {
     // https://docs.modrinth.com/api-spec/#tag/projects/operation/searchProjects
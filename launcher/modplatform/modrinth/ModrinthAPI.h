@@ -29,6 +29,7 @@ class ModrinthAPI : public NetworkResourceAPI {
                         std::shared_ptr<QByteArray> response) -> Task::Ptr;
 
     Task::Ptr getProjects(QStringList addonIds, std::shared_ptr<QByteArray> response) const override;
+    Task::Ptr getProject(QString addonId, std::shared_ptr<QByteArray> response) const override;
 
    public:
     [[nodiscard]] auto getSortingMethods() const -> QList<ResourceAPI::SortingMethod> override;
@@ -10,15 +10,26 @@
 
 #include "tasks/ConcurrentTask.h"
 
+#include <QtConcurrentRun>
+
 #include "minecraft/mod/ModFolderModel.h"
 
 static ModrinthAPI api;
 static ModPlatform::ProviderCapabilities ProviderCaps;
 
+namespace {
+// Hashes per update request, so huge packs are checked with a few requests at once instead of one big one
+constexpr int UPDATE_BATCH_SIZE = 250;
+}  // namespace
+
 bool ModrinthCheckUpdate::abort()
 {
+    if (m_hashing_task)
+        m_hashing_task->abort();
     if (m_net_job)
-        return m_net_job->abort();
+        m_net_job->abort();
+    if (isRunning())
+        emitAborted();
     return true;
 }
 
@@ -32,13 +43,23 @@ void ModrinthCheckUpdate::executeTask()
     setStatus(tr("Preparing mods for Modrinth..."));
     setProgress(0, 3);
 
-    QHash<QString, Mod*> mappings;
+    m_hash_type = ProviderCaps.hashType(ModPlatform::ResourceProvider::MODRINTH).first();
+
+    // Sometimes a version may have multiple files, one with "forge" and one with "fabric",
+    // so we may want to filter it
+    if (m_loaders.has_value()) {
+        static auto flags = { ModPlatform::ModLoaderType::NeoForge, ModPlatform::ModLoaderType::Forge, ModPlatform::ModLoaderType::Fabric,
+                              ModPlatform::ModLoaderType::Quilt };
+        for (auto flag : flags) {
+            if (m_loaders.value().testFlag(flag)) {
+                m_loader_filter = ModPlatform::getModLoaderString(flag);
+                break;
+            }
+        }
+    }
 
     // Create all hashes
-    QStringList hashes;
-    auto best_hash_type = ProviderCaps.hashType(ModPlatform::ResourceProvider::MODRINTH).first();
-
-    ConcurrentTask hashing_task(this, "MakeModrinthHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
+    m_hashing_task = makeShared<ConcurrentTask>(this, "MakeModrinthHashesTask", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt());
     for (auto* mod : m_mods) {
         if (!mod->enabled()) {
             emit checkFailed(mod, tr("Disabled mods won't be updated, to prevent mod duplication issues!"));
@@ -50,132 +71,159 @@ void ModrinthCheckUpdate::executeTask()
         // Sadly the API can only handle one hash type per call, se we
         // need to generate a new hash if the current one is innadequate
         // (though it will rarely happen, if at all)
-        if (mod->metadata()->hash_format != best_hash_type) {
+        if (mod->metadata()->hash_format != m_hash_type) {
+            // the hashers look in the hash cache first, so unchanged files aren't read again
             auto hash_task = Hashing::createModrinthHasher(mod->fileinfo().absoluteFilePath());
-            connect(hash_task.get(), &Hashing::Hasher::resultsReady, [&hashes, &mappings, mod](QString hash) {
-                hashes.append(hash);
-                mappings.insert(hash, mod);
-            });
-            connect(hash_task.get(), &Task::failed, [this] { failed("Failed to generate hash"); });
-            hashing_task.addTask(hash_task);
+            connect(hash_task.get(), &Hashing::Hasher::resultsReady, this, [this, mod](QString hash) { m_mappings.insert(hash, mod); });
+            connect(hash_task.get(), &Task::failed, this, [this] { emitFailed("Failed to generate hash"); });
+            m_hashing_task->addTask(hash_task);
         } else {
-            hashes.append(hash);
-            mappings.insert(hash, mod);
+            m_mappings.insert(hash, mod);
         }
     }
 
-    QEventLoop loop;
-    connect(&hashing_task, &Task::finished, [&loop] { loop.quit(); });
-    hashing_task.start();
-    loop.exec();
+    connect(m_hashing_task.get(), &Task::finished, this, &ModrinthCheckUpdate::getUpdateInfo);
+    m_hashing_task->start();
+}
 
-    auto response = std::make_shared<QByteArray>();
-    auto job = api.latestVersions(hashes, best_hash_type, m_game_versions, m_loaders, response);
+void ModrinthCheckUpdate::getUpdateInfo()
+{
+    m_hashing_task.reset();
+    if (!isRunning())
+        return;
 
-    connect(job.get(), &Task::succeeded, this, [this, response, mappings, best_hash_type, job] {
-        QJsonParseError parse_error{};
-        QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-        if (parse_error.error != QJsonParseError::NoError) {
-            qWarning() << "Error while parsing JSON response from ModrinthCheckUpdate at " << parse_error.offset
-                       << " reason: " << parse_error.errorString();
-            qWarning() << *response;
+    auto hashes = m_mappings.keys();
+    m_pending_parts = (hashes.size() + UPDATE_BATCH_SIZE - 1) / UPDATE_BATCH_SIZE;
+    if (m_pending_parts == 0) {
+        emitSucceeded();
+        return;
+    }
 
-            emitFailed(parse_error.errorString());
-            return;
-        }
+    // all parts are sent at once, so the check takes about as long as the slowest of them
+    m_net_job = makeShared<ConcurrentTask>(this, "Modrinth::CheckUpdate", m_pending_parts);
+    for (int i = 0; i < hashes.size(); i += UPDATE_BATCH_SIZE) {
+        auto part = hashes.mid(i, UPDATE_BATCH_SIZE);
+        auto response = std::make_shared<QByteArray>();
+        auto job = api.latestVersions(part, m_hash_type, m_game_versions, m_loaders, response);
+
+        connect(job.get(), &Task::succeeded, this, [this, response, part] {
+            setStatus(tr("Parsing the API response from Modrinth..."));
+            setProgress(2, 3);
+
+            // Reading hundreds of versions takes a while, so it isn't done on the GUI thread
+            auto watcher = new QFutureWatcher<ParsedVersions>(this);
+            connect(watcher, &QFutureWatcher<ParsedVersions>::finished, this, [this, watcher] {
+                watcher->deleteLater();
+                checkVersions(watcher->result());
+            });
+            watcher->setFuture(QtConcurrent::run([response, part, hash_type = m_hash_type, loader_filter = m_loader_filter] {
+                ParsedVersions parsed;
+                QJsonParseError parse_error{};
+                QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
+                if (parse_error.error != QJsonParseError::NoError) {
+                    qWarning() << "Error while parsing JSON response from ModrinthCheckUpdate at " << parse_error.offset
+                               << " reason: " << parse_error.errorString();
+                    qWarning() << *response;
+                    parsed.error = parse_error.errorString();
+                    return parsed;
+                }
 
-        setStatus(tr("Parsing the API response from Modrinth..."));
-        setProgress(2, 3);
+                try {
+                    for (auto& hash : part) {
+                        auto project_obj = doc[hash].toObject();
+                        if (project_obj.isEmpty())
+                            parsed.missing.append(hash);
+                        else
+                            parsed.versions.insert(hash, Modrinth::loadIndexedPackVersion(project_obj, hash_type, loader_filter));
+                    }
+                } catch (Json::JsonException& e) {
+                    parsed.error = e.cause() + " : " + e.what();
+                }
+                return parsed;
+            }));
+        });
+        connect(job.get(), &Task::failed, this, &ModrinthCheckUpdate::emitFailed);
 
-        try {
-            for (auto hash : mappings.keys()) {
-                auto project_obj = doc[hash].toObject();
+        m_net_job->addTask(job);
+    }
 
-                // If the returned project is empty, but we have Modrinth metadata,
-                // it means this specific version is not available
-                if (project_obj.isEmpty()) {
-                    qDebug() << "Mod " << mappings.find(hash).value()->name() << " got an empty response.";
-                    qDebug() << "Hash: " << hash;
+    setStatus(tr("Waiting for the API response from Modrinth..."));
+    setProgress(1, 3);
 
-                    emit checkFailed(
-                        mappings.find(hash).value(),
-                        tr("No valid version found for this mod. It's probably unavailable for the current game version / mod loader."));
+    m_net_job->start();
+}
 
-                    continue;
-                }
+void ModrinthCheckUpdate::checkVersions(const ParsedVersions& parsed)
+{
+    if (!isRunning())
+        return;
+    if (!parsed.error.isEmpty()) {
+        emitFailed(parsed.error);
+        return;
+    }
 
-                // Sometimes a version may have multiple files, one with "forge" and one with "fabric",
-                // so we may want to filter it
-                QString loader_filter;
-                if (m_loaders.has_value()) {
-                    static auto flags = { ModPlatform::ModLoaderType::NeoForge, ModPlatform::ModLoaderType::Forge,
-                                          ModPlatform::ModLoaderType::Fabric, ModPlatform::ModLoaderType::Quilt };
-                    for (auto flag : flags) {
-                        if (m_loaders.value().testFlag(flag)) {
-                            loader_filter = ModPlatform::getModLoaderString(flag);
-                            break;
-                        }
-                    }
-                }
+    for (auto& hash : parsed.missing) {
+        // If the returned project is empty, but we have Modrinth metadata,
+        // it means this specific version is not available
+        qDebug() << "Mod " << m_mappings.value(hash)->name() << " got an empty response.";
+        qDebug() << "Hash: " << hash;
 
-                // Currently, we rely on a couple heuristics to determine whether an update is actually available or not:
-                // - The file needs to be preferred: It is either the primary file, or the one found via (explicit) usage of the
-                // loader_filter
-                // - The version reported by the JAR is different from the version reported by the indexed version (it's usually the case)
-                // Such is the pain of having arbitrary files for a given version .-.
+        emit checkFailed(m_mappings.value(hash),
+                         tr("No valid version found for this mod. It's probably unavailable for the current game version / mod loader."));
+    }
 
-                auto project_ver = Modrinth::loadIndexedPackVersion(project_obj, best_hash_type, loader_filter);
-                if (project_ver.downloadUrl.isEmpty()) {
-                    qCritical() << "Modrinth mod without download url!";
-                    qCritical() << project_ver.fileName;
+    for (auto it = parsed.versions.constBegin(); it != parsed.versions.constEnd(); ++it) {
+        auto& hash = it.key();
+        auto& project_ver = it.value();
 
-                    emit checkFailed(mappings.find(hash).value(), tr("Mod has an empty download URL"));
+        // Currently, we rely on a couple heuristics to determine whether an update is actually available or not:
+        // - The file needs to be preferred: It is either the primary file, or the one found via (explicit) usage of the
+        // loader_filter
+        // - The version reported by the JAR is different from the version reported by the indexed version (it's usually the case)
+        // Such is the pain of having arbitrary files for a given version .-.
 
-                    continue;
-                }
+        if (project_ver.downloadUrl.isEmpty()) {
+            qCritical() << "Modrinth mod without download url!";
+            qCritical() << project_ver.fileName;
 
-                auto mod_iter = mappings.find(hash);
-                if (mod_iter == mappings.end()) {
-                    qCritical() << "Failed to remap mod from Modrinth!";
-                    continue;
-                }
-                auto mod = *mod_iter;
-
-                auto key = project_ver.hash;
-
-                // Fake pack with the necessary info to pass to the download task :)
-                auto pack = std::make_shared<ModPlatform::IndexedPack>();
-                pack->name = mod->name();
-                pack->slug = mod->metadata()->slug;
-                pack->addonId = mod->metadata()->project_id;
-                pack->websiteUrl = mod->homeurl();
-                for (auto& author : mod->authors())
-                    pack->authors.append({ author });
-                pack->description = mod->description();
-                pack->provider = ModPlatform::ResourceProvider::MODRINTH;
-                if ((key != hash && project_ver.is_preferred) || (mod->status() == ModStatus::NotInstalled)) {
-                    if (mod->version() == project_ver.version_number)
-                        continue;
-
-                    auto download_task = makeShared<ResourceDownloadTask>(pack, project_ver, m_mods_folder);
-
-                    m_updatable.emplace_back(pack->name, hash, mod->version(), project_ver.version_number, project_ver.version_type,
-                                             project_ver.changelog, ModPlatform::ResourceProvider::MODRINTH, download_task);
-                }
-                m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, project_ver));
-            }
-        } catch (Json::JsonException& e) {
-            emitFailed(e.cause() + " : " + e.what());
-            return;
-        }
-        emitSucceeded();
-    });
+            emit checkFailed(m_mappings.value(hash), tr("Mod has an empty download URL"));
 
-    connect(job.get(), &Task::failed, this, &ModrinthCheckUpdate::emitFailed);
+            continue;
+        }
 
-    setStatus(tr("Waiting for the API response from Modrinth..."));
-    setProgress(1, 3);
+        auto mod_iter = m_mappings.find(hash);
+        if (mod_iter == m_mappings.end()) {
+            qCritical() << "Failed to remap mod from Modrinth!";
+            continue;
+        }
+        auto mod = *mod_iter;
+
+        auto key = project_ver.hash;
+
+        // Fake pack with the necessary info to pass to the download task :)
+        auto pack = std::make_shared<ModPlatform::IndexedPack>();
+        pack->name = mod->name();
+        pack->slug = mod->metadata()->slug;
+        pack->addonId = mod->metadata()->project_id;
+        pack->websiteUrl = mod->homeurl();
+        for (auto& author : mod->authors())
+            pack->authors.append({ author });
+        pack->description = mod->description();
+        pack->provider = ModPlatform::ResourceProvider::MODRINTH;
+        if ((key != hash && project_ver.is_preferred) || (mod->status() == ModStatus::NotInstalled)) {
+            if (mod->version() == project_ver.version_number)
+                continue;
+
+            auto download_task = makeShared<ResourceDownloadTask>(pack, project_ver, m_mods_folder);
+
+            m_updatable.emplace_back(pack->name, hash, mod->version(), project_ver.version_number, project_ver.version_type,
+                                     project_ver.changelog, ModPlatform::ResourceProvider::MODRINTH, download_task);
+        }
+        m_deps.append(std::make_shared<GetModDependenciesTask::PackDependency>(pack, project_ver));
+    }
 
-    m_net_job = qSharedPointerObjectCast<NetJob, Task>(job);
-    job->start();
+    if (--m_pending_parts == 0) {
+        m_net_job.reset();
+        emitSucceeded();
+    }
 }
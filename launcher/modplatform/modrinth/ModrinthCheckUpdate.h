@@ -1,8 +1,11 @@
 #pragma once
 
+#include <QFutureWatcher>
+
 #include "Application.h"
 #include "modplatform/CheckUpdateTask.h"
 #include "net/NetJob.h"
+#include "tasks/ConcurrentTask.h"
 
 class ModrinthCheckUpdate : public CheckUpdateTask {
     Q_OBJECT
@@ -21,6 +24,23 @@ class ModrinthCheckUpdate : public CheckUpdateTask {
    protected slots:
     void executeTask() override;
 
+   private slots:
+    void getUpdateInfo();
+
    private:
-    NetJob::Ptr m_net_job = nullptr;
+    /* The latest versions found in one part of the update response, read off the GUI thread. */
+    struct ParsedVersions {
+        QHash<QString, ModPlatform::IndexedVersion> versions;
+        QStringList missing;
+        QString error;
+    };
+
+    void checkVersions(const ParsedVersions& parsed);
+
+    ConcurrentTask::Ptr m_hashing_task;
+    ConcurrentTask::Ptr m_net_job;
+    QHash<QString, Mod*> m_mappings;
+    QString m_hash_type;
+    QString m_loader_filter;
+    int m_pending_parts = 0;
 };
@@ -21,6 +21,8 @@
 
 #include <QAbstractButton>
 #include <QFileInfo>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 #include <vector>
 
 bool ModrinthCreationTask::abort()
@@ -189,57 +191,13 @@ bool ModrinthCreationTask::createInstance()
         }
     }
 
-    // Do client overrides
-    auto client_override_path = FS::PathCombine(m_stagingPath, "client-overrides");
-    if (QFile::exists(client_override_path)) {
-        // Create a list of overrides in "client-overrides.txt" inside mrpack/
-        Override::createOverrides("client-overrides", parent_folder, client_override_path);
-
-        // Apply the overrides
-        if (!FS::overrideFolder(mcPath, client_override_path)) {
-            setError(tr("Could not rename the client overrides folder:\n") + "client overrides");
-            return false;
-        }
-    }
-
-    QString configPath = FS::PathCombine(m_stagingPath, "instance.cfg");
-    auto instanceSettings = std::make_shared<INISettingsObject>(configPath);
-    MinecraftInstance instance(m_globalSettings, instanceSettings, m_stagingPath);
-
-    auto components = instance.getPackProfile();
-    components->buildingFromScratch();
-    components->setComponentVersion("net.minecraft", m_minecraft_version, true);
-
-    if (!m_fabric_version.isEmpty())
-        components->setComponentVersion("net.fabricmc.fabric-loader", m_fabric_version);
-    if (!m_quilt_version.isEmpty())
-        components->setComponentVersion("org.quiltmc.quilt-loader", m_quilt_version);
-    if (!m_forge_version.isEmpty())
-        components->setComponentVersion("net.minecraftforge", m_forge_version);
-    if (!m_neoForge_version.isEmpty())
-        components->setComponentVersion("net.neoforged", m_neoForge_version);
-
-    if (m_instIcon != "default") {
-        instance.setIconKey(m_instIcon);
-    } else if (!m_managed_id.isEmpty()) {
-        instance.setIconKey("modrinth");
-    }
-
-    // Don't add managed info to packs without an ID (most likely imported from ZIP)
-    if (!m_managed_id.isEmpty())
-        instance.setManagedPack("modrinth", m_managed_id, m_managed_name, m_managed_version_id, version());
-    else
-        instance.setManagedPack("modrinth", "", name(), "", "");
-
-    instance.setName(name());
-    instance.saveNow();
-
     m_files_job.reset(new NetJob(tr("Mod Download Modrinth"), APPLICATION->network()));
 
     auto root_modpack_path = FS::PathCombine(m_stagingPath, m_root_path);
     auto root_modpack_url = QUrl::fromLocalFile(root_modpack_path);
 
-    for (auto file : m_files) {
+    QStringList downloaded_files;
+    for (auto& file : m_files) {
         auto fileName = file.path;
 #ifdef Q_OS_WIN
         fileName = FS::RemoveInvalidPathChars(fileName);
@@ -251,10 +209,12 @@ bool ModrinthCreationTask::createInstance()
                          .arg(fileName));
             return false;
         }
+        downloaded_files.append(fileName);
 
         qDebug() << "Will try to download" << file.downloads.front() << "to" << file_path;
         auto dl = Net::ApiDownload::makeFile(file.downloads.dequeue(), file_path);
         dl->addValidator(new Net::ChecksumValidator(file.hashAlgorithm, file.hash));
+        dl->setPriority(Net::NetRequest::Priority::Bulk);
         m_files_job->addNetAction(dl);
 
         if (!file.downloads.empty()) {
@@ -264,6 +224,7 @@ bool ModrinthCreationTask::createInstance()
             connect(dl.get(), &Task::failed, [this, &file, file_path, param] {
                 auto ndl = Net::ApiDownload::makeFile(file.downloads.dequeue(), file_path);
                 ndl->addValidator(new Net::ChecksumValidator(file.hashAlgorithm, file.hash));
+                ndl->setPriority(Net::NetRequest::Priority::Bulk);
                 m_files_job->addNetAction(ndl);
                 if (auto shared = param.lock())
                     shared->succeeded();
@@ -272,13 +233,26 @@ bool ModrinthCreationTask::createInstance()
     }
 
     bool ended_well = false;
+    bool downloads_finished = false;
+    bool client_overrides_finished = true;
+
+    // Client overrides get merged into the same folder the downloads go to, and can be quite big.
+    // Do that on a worker thread while the downloads run, instead of making the network wait for the disk.
+    QFutureWatcher<bool> client_overrides;
+    auto quit_when_done = [&] {
+        if (downloads_finished && client_overrides_finished)
+            loop.quit();
+    };
 
     connect(m_files_job.get(), &NetJob::succeeded, this, [&]() { ended_well = true; });
     connect(m_files_job.get(), &NetJob::failed, [&](const QString& reason) {
         ended_well = false;
         setError(reason);
     });
-    connect(m_files_job.get(), &NetJob::finished, &loop, &QEventLoop::quit);
+    connect(m_files_job.get(), &NetJob::finished, &loop, [&] {
+        downloads_finished = true;
+        quit_when_done();
+    });
     connect(m_files_job.get(), &NetJob::progress, [&](qint64 current, qint64 total) {
         setDetails(tr("%1 out of %2 complete").arg(current).arg(total));
         setProgress(current, total);
@@ -288,7 +262,71 @@ bool ModrinthCreationTask::createInstance()
     setStatus(tr("Downloading mods..."));
     m_files_job->start();
 
-    loop.exec();
+    // Do client overrides
+    auto client_override_path = FS::PathCombine(m_stagingPath, "client-overrides");
+    if (QFile::exists(client_override_path)) {
+        client_overrides_finished = false;
+        connect(&client_overrides, &QFutureWatcher<bool>::finished, &loop, [&] {
+            client_overrides_finished = true;
+            if (!client_overrides.result()) {
+                setError(tr("Could not rename the client overrides folder:\n") + "client overrides");
+                m_files_job->abort();
+            }
+            quit_when_done();
+        });
+        client_overrides.setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [=] {
+            // Create a list of overrides in "client-overrides.txt" inside mrpack/
+            Override::createOverrides("client-overrides", parent_folder, client_override_path);
+
+            // Downloaded files used to be written after the overrides were applied, so make sure they still win
+            for (auto const& file : downloaded_files) {
+                auto overridden = FS::PathCombine(client_override_path, file);
+                if (QFileInfo(overridden).isFile())
+                    QFile::remove(overridden);
+            }
+
+            // Apply the overrides
+            return FS::overrideFolder(mcPath, client_override_path);
+        }));
+    }
+
+    QString configPath = FS::PathCombine(m_stagingPath, "instance.cfg");
+    auto instanceSettings = std::make_shared<INISettingsObject>(configPath);
+    MinecraftInstance instance(m_globalSettings, instanceSettings, m_stagingPath);
+
+    auto components = instance.getPackProfile();
+    components->buildingFromScratch();
+    components->setComponentVersion("net.minecraft", m_minecraft_version, true);
+
+    if (!m_fabric_version.isEmpty())
+        components->setComponentVersion("net.fabricmc.fabric-loader", m_fabric_version);
+    if (!m_quilt_version.isEmpty())
+        components->setComponentVersion("org.quiltmc.quilt-loader", m_quilt_version);
+    if (!m_forge_version.isEmpty())
+        components->setComponentVersion("net.minecraftforge", m_forge_version);
+    if (!m_neoForge_version.isEmpty())
+        components->setComponentVersion("net.neoforged", m_neoForge_version);
+
+    if (m_instIcon != "default") {
+        instance.setIconKey(m_instIcon);
+    } else if (!m_managed_id.isEmpty()) {
+        instance.setIconKey("modrinth");
+    }
+
+    // Don't add managed info to packs without an ID (most likely imported from ZIP)
+    if (!m_managed_id.isEmpty())
+        instance.setManagedPack("modrinth", m_managed_id, m_managed_name, m_managed_version_id, version());
+    else
+        instance.setManagedPack("modrinth", "", name(), "", "");
+
+    instance.setName(name());
+    instance.saveNow();
+
+    // Everything may have finished while we were setting up the instance
+    if (!downloads_finished || !client_overrides_finished)
+        loop.exec();
+
+    ended_well = ended_well && getError().isEmpty();
 
     // Update information of the already installed instance, if any.
     if (m_instance && ended_well) {
@@ -21,12 +21,15 @@
 #include <QCryptographicHash>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
+#include "Application.h"
 #include "Json.h"
 #include "MMCZip.h"
 #include "minecraft/PackProfile.h"
 #include "minecraft/mod/MetadataHandler.h"
 #include "minecraft/mod/ModFolderModel.h"
+#include "modplatform/helpers/HashCache.h"
 
 const QStringList ModrinthPackExportTask::PREFIXES({ "mods/", "coremods/", "resourcepacks/", "texturepacks/", "shaderpacks/" });
 const QStringList ModrinthPackExportTask::FILE_EXTENSIONS({ "jar", "litemod", "zip" });
@@ -47,7 +50,11 @@ ModrinthPackExportTask::ModrinthPackExportTask(const QString& name,
     , gameRoot(instance->gameRoot())
     , output(output)
     , filter(filter)
-{}
+    , exportCache(QDir("cache/exports").absoluteFilePath("modrinth.json"))
+{
+    connect(&hashWatcher, &QFutureWatcher<FileHashes>::resultReadyAt, this, &ModrinthPackExportTask::fileHashed);
+    connect(&hashWatcher, &QFutureWatcher<FileHashes>::finished, this, &ModrinthPackExportTask::hashingFinished);
+}
 
 void ModrinthPackExportTask::executeTask()
 {
@@ -58,12 +65,17 @@ void ModrinthPackExportTask::executeTask()
 
 bool ModrinthPackExportTask::abort()
 {
-    if (task) {
+    if (!isRunning())
+        return false;
+
+    hashWatcher.cancel();
+    for (const auto& request : requests)
+        request->abort();
+    requests.clear();
+    if (task)
         task->abort();
-        emitAborted();
-        return true;
-    }
-    return false;
+    emitAborted();
+    return true;
 }
 
 void ModrinthPackExportTask::collectFiles()
@@ -79,6 +91,7 @@ void ModrinthPackExportTask::collectFiles()
 
     pendingHashes.clear();
     resolvedFiles.clear();
+    requests.clear();
 
     if (mcInstance) {
         mcInstance->loaderModList()->update();
@@ -89,10 +102,11 @@ void ModrinthPackExportTask::collectFiles()
 
 void ModrinthPackExportTask::collectHashes()
 {
+    setAbortable(true);
     setStatus(tr("Finding file hashes..."));
-    for (const QFileInfo& file : files) {
-        QCoreApplication::processEvents();
 
+    QStringList paths;
+    for (const QFileInfo& file : files) {
         const QString relative = gameRoot.relativeFilePath(file.absoluteFilePath());
         // require sensible file types
         if (!std::any_of(PREFIXES.begin(), PREFIXES.end(), [&relative](const QString& prefix) { return relative.startsWith(prefix); }))
@@ -101,76 +115,140 @@ void ModrinthPackExportTask::collectHashes()
                 return relative.endsWith('.' + extension) || relative.endsWith('.' + extension + ".disabled");
             }))
             continue;
+        paths << file.absoluteFilePath();
+    }
 
-        QCryptographicHash sha512(QCryptographicHash::Algorithm::Sha512);
+    modsByPath.clear();
+    if (mcInstance) {
+        for (Mod* mod : mcInstance->loaderModList()->allMods())
+            modsByPath.insert(mod->fileinfo().absoluteFilePath(), mod);
+    }
 
-        QFile openFile(file.absoluteFilePath());
-        if (!openFile.open(QFile::ReadOnly)) {
-            qWarning() << "Could not open" << file << "for hashing";
-            continue;
-        }
+    hashingDone = false;
+    if (paths.isEmpty()) {
+        hashingFinished();
+        return;
+    }
 
-        const QByteArray data = openFile.readAll();
-        if (openFile.error() != QFileDevice::NoError) {
-            qWarning() << "Could not read" << file;
-            continue;
-        }
-        sha512.addData(data);
-
-        auto allMods = mcInstance->loaderModList()->allMods();
-        if (auto modIter = std::find_if(allMods.begin(), allMods.end(), [&file](Mod* mod) { return mod->fileinfo() == file; });
-            modIter != allMods.end()) {
-            const Mod* mod = *modIter;
-            if (mod->metadata() != nullptr) {
-                QUrl& url = mod->metadata()->url;
-                // ensure the url is permitted on modrinth.com
-                if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
-                    qDebug() << "Resolving" << relative << "from index";
-
-                    QCryptographicHash sha1(QCryptographicHash::Algorithm::Sha1);
-                    sha1.addData(data);
-
-                    ResolvedFile resolvedFile{ sha1.result().toHex(), sha512.result().toHex(), url.toEncoded(), openFile.size(),
-                                               mod->metadata()->side };
-                    resolvedFiles[relative] = resolvedFile;
-
-                    // nice! we've managed to resolve based on local metadata!
-                    // no need to enqueue it
-                    continue;
-                }
-            }
+    // The files are hashed on all cores, and their lookups are sent in batches while the rest is still being hashed
+    setProgress(0, paths.size());
+    hashWatcher.setFuture(QtConcurrent::mapped(paths, &ModrinthPackExportTask::hashFile));
+}
+
+auto ModrinthPackExportTask::hashFile(const QString& path) -> FileHashes
+{
+    FileHashes hashes{ path, {}, {} };
+
+    // unchanged files were hashed before, so only read the ones we don't know yet
+    auto hashCache = APPLICATION->hashCache();
+    const auto identity = Hashing::FileIdentity::of(path);
+    if (hashCache) {
+        hashes.sha512 = hashCache->lookup(path, identity, "sha512");
+        hashes.sha1 = hashCache->lookup(path, identity, "sha1");
+        if (!hashes.sha512.isEmpty() && !hashes.sha1.isEmpty())
+            return hashes;
+    }
+
+    QFile openFile(path);
+    if (!openFile.open(QFile::ReadOnly))
+        return {};
+
+    const QByteArray data = openFile.readAll();
+    if (openFile.error() != QFileDevice::NoError)
+        return {};
+
+    hashes.sha512 = QCryptographicHash::hash(data, QCryptographicHash::Algorithm::Sha512).toHex();
+    hashes.sha1 = QCryptographicHash::hash(data, QCryptographicHash::Algorithm::Sha1).toHex();
+    if (hashCache)
+        hashCache->insert(path, identity, { { "sha512", hashes.sha512 }, { "sha1", hashes.sha1 } });
+    return hashes;
+}
+
+void ModrinthPackExportTask::fileHashed(int index)
+{
+    if (!isRunning())
+        return;
+
+    const FileHashes hashes = hashWatcher.resultAt(index);
+    setProgress(m_progress + 1, m_progressTotal);
+    if (hashes.sha512.isEmpty()) {
+        qWarning() << "Could not read" << hashes.path << "for hashing";
+        return;
+    }
+
+    const QString relative = gameRoot.relativeFilePath(hashes.path);
+    if (const Mod* mod = modsByPath.value(hashes.path); mod && mod->metadata() != nullptr) {
+        QUrl& url = mod->metadata()->url;
+        // ensure the url is permitted on modrinth.com
+        if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
+            qDebug() << "Resolving" << relative << "from index";
+
+            ResolvedFile resolvedFile{ hashes.sha1, hashes.sha512, url.toEncoded(), QFileInfo(hashes.path).size(),
+                                       mod->metadata()->side };
+            resolvedFiles[relative] = resolvedFile;
+
+            // nice! we've managed to resolve based on local metadata!
+            // no need to enqueue it
+            return;
         }
+    }
 
-        qDebug() << "Enqueueing" << relative << "for Modrinth query";
-        pendingHashes[relative] = sha512.result().toHex();
+    // files resolved by an earlier export resolve to the same version now
+    if (auto cached = exportCache.lookup(hashes.sha512); !cached.isEmpty()) {
+        qDebug() << "Resolving" << relative << "from an earlier export";
+        resolvedFiles[relative] = ResolvedFile{ cached["sha1"].toString(), hashes.sha512, cached["url"].toString(),
+                                                static_cast<qint64>(cached["size"].toDouble()) };
+        return;
     }
 
-    setAbortable(true);
-    makeApiRequest();
+    qDebug() << "Enqueueing" << relative << "for Modrinth query";
+    pendingHashes[relative] = hashes.sha512;
+    if (pendingHashes.size() >= API_BATCH_SIZE)
+        makeApiRequest();
 }
 
-void ModrinthPackExportTask::makeApiRequest()
+void ModrinthPackExportTask::hashingFinished()
 {
-    if (pendingHashes.isEmpty())
+    if (!isRunning() || hashWatcher.isCanceled())
+        return;
+
+    hashingDone = true;
+    if (!pendingHashes.isEmpty())
+        makeApiRequest();
+    else if (requests.isEmpty())
         buildZip();
-    else {
-        setStatus(tr("Finding versions for hashes..."));
-        auto response = std::make_shared<QByteArray>();
-        task = api.currentVersions(pendingHashes.values(), "sha512", response);
-        connect(task.get(), &NetJob::succeeded, [this, response]() { parseApiResponse(response); });
-        connect(task.get(), &NetJob::failed, this, &ModrinthPackExportTask::emitFailed);
-        task->start();
-    }
 }
 
-void ModrinthPackExportTask::parseApiResponse(const std::shared_ptr<QByteArray> response)
+void ModrinthPackExportTask::makeApiRequest()
 {
-    task = nullptr;
+    setStatus(tr("Finding versions for hashes..."));
+    const auto batch = pendingHashes;
+    pendingHashes.clear();
+
+    auto response = std::make_shared<QByteArray>();
+    Task::Ptr request = api.currentVersions(batch.values(), "sha512", response);
+    requests << request;
+    connect(request.get(), &NetJob::succeeded, this, [this, batch, response, sent = request.get()]() {
+        requests.erase(std::remove_if(requests.begin(), requests.end(), [sent](const Task::Ptr& other) { return other.get() == sent; }),
+                       requests.end());
+        parseApiResponse(batch, response);
+    });
+    connect(request.get(), &NetJob::failed, this, [this](QString reason) {
+        if (isRunning())
+            emitFailed(reason);
+    });
+    request->start();
+}
+
+void ModrinthPackExportTask::parseApiResponse(const QMap<QString, QString>& batch, const std::shared_ptr<QByteArray> response)
+{
+    if (!isRunning())
+        return;
 
     try {
         const QJsonDocument doc = Json::requireDocument(*response);
 
-        QMapIterator<QString, QString> iterator(pendingHashes);
+        QMapIterator<QString, QString> iterator(batch);
         while (iterator.hasNext()) {
             iterator.next();
 
@@ -183,27 +261,33 @@ void ModrinthPackExportTask::parseApiResponse(const std::shared_ptr<QByteArray>
                                              [&iterator](const QJsonValue& file) { return file["hashes"]["sha512"] == iterator.value(); });
                 fileIter != files_array.end()) {
                 // map the file to the url
-                resolvedFiles[iterator.key()] =
-                    ResolvedFile{ fileIter->toObject()["hashes"].toObject()["sha1"].toString(), iterator.value(),
-                                  fileIter->toObject()["url"].toString(), fileIter->toObject()["size"].toInt() };
+                const ResolvedFile resolvedFile{ fileIter->toObject()["hashes"].toObject()["sha1"].toString(), iterator.value(),
+                                                 fileIter->toObject()["url"].toString(), fileIter->toObject()["size"].toInt() };
+                resolvedFiles[iterator.key()] = resolvedFile;
+                exportCache.insert(resolvedFile.sha512,
+                                   { { "sha1", resolvedFile.sha1 }, { "url", resolvedFile.url }, { "size", resolvedFile.size } });
             }
         }
     } catch (const Json::JsonException& e) {
         emitFailed(tr("Failed to parse versions response: %1").arg(e.what()));
         return;
     }
-    pendingHashes.clear();
-    buildZip();
+
+    if (hashingDone && requests.isEmpty())
+        buildZip();
 }
 
 void ModrinthPackExportTask::buildZip()
 {
     setStatus(tr("Adding files..."));
+    exportCache.save();
 
     auto zipTask = makeShared<MMCZip::ExportToZipTask>(output, gameRoot, files, "overrides/", true, true);
     zipTask->addExtraFile("modrinth.index.json", generateIndex());
 
     zipTask->setExcludeFiles(resolvedFiles.keys());
+    if (mcInstance)
+        zipTask->setPreviousArchive(mcInstance->settings()->get("ExportLastArchive").toString());
 
     auto progressStep = std::make_shared<TaskStepProgress>();
     connect(zipTask.get(), &Task::finished, this, [this, progressStep] {
@@ -211,7 +295,11 @@ void ModrinthPackExportTask::buildZip()
         stepProgress(*progressStep);
     });
 
-    connect(zipTask.get(), &Task::succeeded, this, &ModrinthPackExportTask::emitSucceeded);
+    connect(zipTask.get(), &Task::succeeded, this, [this] {
+        if (mcInstance)
+            mcInstance->settings()->set("ExportLastArchive", output);
+        emitSucceeded();
+    });
     connect(zipTask.get(), &Task::aborted, this, &ModrinthPackExportTask::emitAborted);
     connect(zipTask.get(), &Task::failed, this, [this, progressStep](QString reason) {
         progressStep->state = TaskStepState::Failed;
@@ -23,6 +23,7 @@
 #include "BaseInstance.h"
 #include "MMCZip.h"
 #include "minecraft/MinecraftInstance.h"
+#include "modplatform/helpers/ExportCache.h"
 #include "modplatform/modrinth/ModrinthAPI.h"
 #include "tasks/Task.h"
 
@@ -46,9 +47,15 @@ class ModrinthPackExportTask : public Task {
         qint64 size;
         Metadata::ModSide side;
     };
+    struct FileHashes {
+        QString path;
+        QString sha1, sha512;
+    };
 
     static const QStringList PREFIXES;
     static const QStringList FILE_EXTENSIONS;
+    // how many hashes are looked up with one request
+    static constexpr int API_BATCH_SIZE = 100;
 
     // inputs
     const QString name, version, summary;
@@ -60,15 +67,24 @@ class ModrinthPackExportTask : public Task {
     const MMCZip::FilterFunction filter;
 
     ModrinthAPI api;
+    ExportCache exportCache;
     QFileInfoList files;
+    QHash<QString, const Mod*> modsByPath;
+    QFutureWatcher<FileHashes> hashWatcher;
+    bool hashingDone = false;
+    // hashes that weren't sent in a lookup yet
     QMap<QString, QString> pendingHashes;
     QMap<QString, ResolvedFile> resolvedFiles;
+    QList<Task::Ptr> requests;
     Task::Ptr task;
 
     void collectFiles();
     void collectHashes();
+    static FileHashes hashFile(const QString& path);
+    void fileHashed(int index);
+    void hashingFinished();
     void makeApiRequest();
-    void parseApiResponse(std::shared_ptr<QByteArray> response);
+    void parseApiResponse(const QMap<QString, QString>& batch, std::shared_ptr<QByteArray> response);
     void buildZip();
 
     QByteArray generateIndex();
@@ -18,9 +18,14 @@
 
 #include "Packwiz.h"
 
+#include <QDateTime>
 #include <QDebug>
 #include <QDir>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QObject>
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -34,6 +39,182 @@
 
 namespace Packwiz {
 
+namespace {
+// the files of an index directory by their case folded names, kept while the directory isn't modified. Loading the
+// metadata of a whole mod folder looks up a name that isn't there for every mod without any.
+struct IndexCatalog {
+    QDateTime modified;
+    QHash<QString, QString> names;
+};
+
+QMutex s_catalogs_lock;
+QHash<QString, IndexCatalog> s_catalogs;
+}  // namespace
+
+static auto findIndexNameIgnoringCase(const QDir& index_dir, const QString& fname) -> QString
+{
+    auto path = index_dir.absolutePath();
+    auto modified = QFileInfo(path).lastModified();
+
+    QMutexLocker locker(&s_catalogs_lock);
+    auto& catalog = s_catalogs[path];
+    if (!modified.isValid() || catalog.modified != modified) {
+        catalog.modified = modified;
+        catalog.names.clear();
+        for (auto& file_name : index_dir.entryList(QDir::Filter::Files)) {
+            auto key = file_name.toCaseFolded();
+            // the first one listed wins, like it did when looking through the listing
+            if (!catalog.names.contains(key))
+                catalog.names.insert(key, file_name);
+        }
+    }
+    return catalog.names.value(fname.toCaseFolded());
+}
+
+// keeps the catalog current after changing the directory ourselves, instead of listing it again
+static void noteIndexFile(const QDir& index_dir, const QString& fname, bool exists)
+{
+    auto path = index_dir.absolutePath();
+
+    QMutexLocker locker(&s_catalogs_lock);
+    auto catalog = s_catalogs.find(path);
+    if (catalog == s_catalogs.end())
+        return;
+    if (exists)
+        catalog->names.insert(fname.toCaseFolded(), fname);
+    else
+        catalog->names.remove(fname.toCaseFolded());
+    catalog->modified = QFileInfo(path).lastModified();
+}
+
+namespace {
+// what an open batch will do with a file of the index
+struct PendingFile {
+    bool removed = false;
+    QByteArray contents;
+};
+
+// the open batches, by the index directory, and what they hold by file name
+QMutex s_batches_lock;
+QHash<QString, QHash<QString, PendingFile>> s_batches;
+}  // namespace
+
+// holds back the change if there's a batch open on the directory, returns false if there's none
+static auto queueIndexFile(const QDir& index_dir, const QString& fname, PendingFile file) -> bool
+{
+    QMutexLocker locker(&s_batches_lock);
+    auto batch = s_batches.find(index_dir.absolutePath());
+    if (batch == s_batches.end())
+        return false;
+    batch->insert(fname, std::move(file));
+    return true;
+}
+
+static auto pendingIndexFile(const QDir& index_dir, const QString& fname) -> std::optional<PendingFile>
+{
+    QMutexLocker locker(&s_batches_lock);
+    auto batch = s_batches.constFind(index_dir.absolutePath());
+    if (batch == s_batches.cend())
+        return {};
+    auto file = batch->constFind(fname);
+    if (file == batch->cend())
+        return {};
+    return *file;
+}
+
+// the files of the index, as they will be once the open batch is committed
+static auto indexFileNames(const QDir& index_dir) -> QStringList
+{
+    auto names = index_dir.entryList(QDir::Filter::Files);
+
+    QMutexLocker locker(&s_batches_lock);
+    auto batch = s_batches.constFind(index_dir.absolutePath());
+    if (batch == s_batches.cend())
+        return names;
+    for (auto it = batch->cbegin(); it != batch->cend(); ++it) {
+        if (it->removed)
+            names.removeAll(it.key());
+        else if (!names.contains(it.key()))
+            names.append(it.key());
+    }
+    return names;
+}
+
+IndexBatch::IndexBatch(const QDir& index_dir) : m_path(index_dir.absolutePath())
+{
+    QMutexLocker locker(&s_batches_lock);
+    if (!s_batches.contains(m_path)) {
+        s_batches.insert(m_path, {});
+        m_owner = true;
+    }
+}
+
+IndexBatch::~IndexBatch()
+{
+    commit();
+}
+
+auto IndexBatch::commit() -> bool
+{
+    if (!m_owner)
+        return true;
+    m_owner = false;
+
+    // readers wait until it's all on disk, instead of finding neither the pending nor the written files
+    QMutexLocker locker(&s_batches_lock);
+    auto files = s_batches.take(m_path);
+    if (files.isEmpty())
+        return true;
+
+    QDir index_dir(m_path);
+    if (!FS::ensureFolderPathExists(m_path)) {
+        qCritical() << "Could not create the metadata folder" << m_path;
+        return false;
+    }
+
+    // everything is written next to where it goes first, so failing half way leaves the index as it was
+    QStringList staged;
+    for (auto it = files.cbegin(); it != files.cend(); ++it) {
+        if (it->removed)
+            continue;
+        QFile file(index_dir.absoluteFilePath(it.key() + ".tmp"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(it->contents) != it->contents.size()) {
+            qCritical() << "Could not write metadata file" << file.fileName() << ":" << file.errorString();
+            file.close();
+            file.remove();
+            for (auto& name : staged)
+                QFile::remove(index_dir.absoluteFilePath(name + ".tmp"));
+            return false;
+        }
+        file.close();
+        staged.append(it.key());
+    }
+
+    bool ok = true;
+    for (auto it = files.cbegin(); it != files.cend(); ++it) {
+        if (!it->removed)
+            continue;
+        auto path = index_dir.absoluteFilePath(it.key());
+        if (QFile::exists(path) && !QFile::remove(path)) {
+            qWarning() << "Failed to remove metadata file" << path;
+            ok = false;
+            continue;
+        }
+        noteIndexFile(index_dir, it.key(), false);
+    }
+    for (auto& name : staged) {
+        auto path = index_dir.absoluteFilePath(name);
+        QFile::remove(path);
+        if (!QFile::rename(path + ".tmp", path)) {
+            qCritical() << "Could not move metadata file into place:" << path;
+            ok = false;
+            continue;
+        }
+        noteIndexFile(index_dir, name, true);
+    }
+    return ok;
+}
+
 auto getRealIndexName(QDir& index_dir, QString normalized_fname, bool should_find_match) -> QString
 {
     QFile index_file(index_dir.absoluteFilePath(normalized_fname));
@@ -41,12 +222,9 @@ auto getRealIndexName(QDir& index_dir, QString normalized_fname, bool should_fin
     QString real_fname = normalized_fname;
     if (!index_file.exists()) {
         // Tries to get similar entries
-        for (auto& file_name : index_dir.entryList(QDir::Filter::Files)) {
-            if (!QString::compare(normalized_fname, file_name, Qt::CaseInsensitive)) {
-                real_fname = file_name;
-                break;
-            }
-        }
+        auto similar = findIndexNameIgnoringCase(index_dir, normalized_fname);
+        if (!similar.isEmpty())
+            real_fname = similar;
 
         if (should_find_match && !QString::compare(normalized_fname, real_fname, Qt::CaseSensitive)) {
             qCritical() << "Could not find a match for a valid metadata file!";
@@ -137,25 +315,7 @@ void V1::updateModIndex(QDir& index_dir, Mod& mod)
         return;
     }
 
-    // Ensure the corresponding mod's info exists, and create it if not
-
     auto normalized_fname = indexFileName(mod.slug);
-    auto real_fname = getRealIndexName(index_dir, normalized_fname);
-
-    QFile index_file(index_dir.absoluteFilePath(real_fname));
-
-    if (real_fname != normalized_fname)
-        index_file.rename(normalized_fname);
-
-    // There's already data on there!
-    // TODO: We should do more stuff here, as the user is likely trying to
-    // override a file. In this case, check versions and ask the user what
-    // they want to do!
-    if (index_file.exists()) {
-        index_file.remove();
-    } else {
-        FS::ensureFilePathExists(index_file.fileName());
-    }
 
     toml::table update;
     switch (mod.provider) {
@@ -181,13 +341,8 @@ void V1::updateModIndex(QDir& index_dir, Mod& mod)
             break;
     }
 
-    if (!index_file.open(QIODevice::ReadWrite)) {
-        qCritical() << QString("Could not open file %1!").arg(normalized_fname);
-        return;
-    }
-
     // Put TOML data into the file
-    QTextStream in_stream(&index_file);
+    QByteArray contents;
     {
         auto tbl = toml::table{ { "name", mod.name.toStdString() },
                                 { "filename", mod.filename.toStdString() },
@@ -202,11 +357,46 @@ void V1::updateModIndex(QDir& index_dir, Mod& mod)
                                 { "update", toml::table{ { ProviderCaps.name(mod.provider), update } } } };
         std::stringstream ss;
         ss << tbl;
-        in_stream << QString::fromStdString(ss.str());
+        contents = QByteArray::fromStdString(ss.str());
+    }
+
+    // Ensure the corresponding mod's info exists, and create it if not
+
+    auto real_fname = getRealIndexName(index_dir, normalized_fname);
+
+    // an open batch writes it along with the others
+    if (queueIndexFile(index_dir, normalized_fname, { false, contents })) {
+        if (real_fname != normalized_fname)
+            queueIndexFile(index_dir, real_fname, { true, {} });
+        return;
+    }
+
+    QFile index_file(index_dir.absoluteFilePath(real_fname));
+
+    if (real_fname != normalized_fname)
+        index_file.rename(index_dir.absoluteFilePath(normalized_fname));
+
+    // There's already data on there!
+    // TODO: We should do more stuff here, as the user is likely trying to
+    // override a file. In this case, check versions and ask the user what
+    // they want to do!
+    if (index_file.exists()) {
+        index_file.remove();
+    } else {
+        FS::ensureFilePathExists(index_file.fileName());
     }
 
-    index_file.flush();
+    if (!index_file.open(QIODevice::ReadWrite)) {
+        qCritical() << QString("Could not open file %1!").arg(normalized_fname);
+        return;
+    }
+
+    index_file.write(contents);
     index_file.close();
+
+    if (real_fname != normalized_fname)
+        noteIndexFile(index_dir, real_fname, false);
+    noteIndexFile(index_dir, QFileInfo(index_file.fileName()).fileName(), true);
 }
 
 void V1::deleteModIndex(QDir& index_dir, QString& mod_slug)
@@ -216,6 +406,12 @@ void V1::deleteModIndex(QDir& index_dir, QString& mod_slug)
     if (real_fname.isEmpty())
         return;
 
+    if (queueIndexFile(index_dir, normalized_fname, { true, {} })) {
+        if (real_fname != normalized_fname)
+            queueIndexFile(index_dir, real_fname, { true, {} });
+        return;
+    }
+
     QFile index_file(index_dir.absoluteFilePath(real_fname));
 
     if (!index_file.exists()) {
@@ -225,12 +421,14 @@ void V1::deleteModIndex(QDir& index_dir, QString& mod_slug)
 
     if (!index_file.remove()) {
         qWarning() << QString("Failed to remove metadata for mod %1!").arg(mod_slug);
+        return;
     }
+    noteIndexFile(index_dir, real_fname, false);
 }
 
 void V1::deleteModIndex(QDir& index_dir, QVariant& mod_id)
 {
-    for (auto& file_name : index_dir.entryList(QDir::Filter::Files)) {
+    for (auto& file_name : indexFileNames(index_dir)) {
         auto mod = getIndexForMod(index_dir, file_name);
 
         if (mod.mod_id() == mod_id) {
@@ -245,21 +443,36 @@ auto V1::getIndexForMod(QDir& index_dir, QString slug) -> Mod
     Mod mod;
 
     auto normalized_fname = indexFileName(slug);
-    auto real_fname = getRealIndexName(index_dir, normalized_fname, true);
-    if (real_fname.isEmpty())
+
+    // what an open batch is going to write is read from there
+    auto pending = pendingIndexFile(index_dir, normalized_fname);
+    if (pending && pending->removed)
         return {};
+    QString real_fname = normalized_fname;
+    if (!pending) {
+        real_fname = getRealIndexName(index_dir, normalized_fname, true);
+        if (real_fname.isEmpty())
+            return {};
+        if (auto pending_real = pendingIndexFile(index_dir, real_fname); pending_real && pending_real->removed)
+            return {};
+    }
+    auto parse = [&] {
+        if (pending)
+            return toml::parse(pending->contents.toStdString());
+        return toml::parse_file(StringUtils::toStdString(index_dir.absoluteFilePath(real_fname)));
+    };
 
     toml::table table;
 #if TOML_EXCEPTIONS
     try {
-        table = toml::parse_file(StringUtils::toStdString(index_dir.absoluteFilePath(real_fname)));
+        table = parse();
     } catch (const toml::parse_error& err) {
         qWarning() << QString("Could not open file %1!").arg(normalized_fname);
         qWarning() << "Reason: " << QString(err.what());
         return {};
     }
 #else
-    toml::parse_result result = toml::parse_file(StringUtils::toStdString(index_dir.absoluteFilePath(real_fname)));
+    toml::parse_result result = parse();
     if (!result) {
         qWarning() << QString("Could not open file %1!").arg(normalized_fname);
         qWarning() << "Reason: " << result.error().description();
@@ -320,7 +533,7 @@ auto V1::getIndexForMod(QDir& index_dir, QString slug) -> Mod
 
 auto V1::getIndexForMod(QDir& index_dir, QVariant& mod_id) -> Mod
 {
-    for (auto& file_name : index_dir.entryList(QDir::Filter::Files)) {
+    for (auto& file_name : indexFileNames(index_dir)) {
         auto mod = getIndexForMod(index_dir, file_name);
 
         if (mod.mod_id() == mod_id)
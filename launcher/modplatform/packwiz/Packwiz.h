@@ -33,6 +33,29 @@ namespace Packwiz {
 
 auto getRealIndexName(QDir& index_dir, QString normalized_index_name, bool should_match = false) -> QString;
 
+/* Holds back the metadata writes and removals in an index directory while it's open, and puts them all on disk at
+ * once when it's committed or goes away. Reading the index in the meantime sees what's pending.
+ * For installing and updating many mods, so the folder isn't changed, and rescanned, once per mod.
+ * Opening another batch on a directory that already has one joins that one.
+ * */
+class IndexBatch {
+   public:
+    explicit IndexBatch(const QDir& index_dir);
+    ~IndexBatch();
+
+    IndexBatch(const IndexBatch&) = delete;
+    IndexBatch& operator=(const IndexBatch&) = delete;
+
+    /* Writes what's pending and ends the batch. Returns false if any of it couldn't be written.
+     * Nothing is moved into place when writing out the files fails.
+     * */
+    auto commit() -> bool;
+
+   private:
+    QString m_path;
+    bool m_owner = false;
+};
+
 class V1 {
    public:
     enum class Side { ClientSide = 1 << 0, ServerSide = 1 << 1, UniversalSide = ClientSide | ServerSide };
@@ -38,12 +38,14 @@
 #include <FileSystem.h>
 #include <Json.h>
 #include <MMCZip.h>
+#include <QDirIterator>
 #include <QtConcurrentRun>
 
 #include "SolderPackManifest.h"
 #include "TechnicPackProcessor.h"
 #include "net/ApiDownload.h"
 #include "net/ChecksumValidator.h"
+#include "tasks/CpuExecutor.h"
 
 Technic::SolderPackInstallTask::SolderPackInstallTask(shared_qobject_ptr<QNetworkAccessManager> network,
                                                       const QUrl& solderUrl,
@@ -107,6 +109,9 @@ void Technic::SolderPackInstallTask::fileListSucceeded()
         m_minecraftVersion = build.minecraft;
 
     m_filesNetJob.reset(new NetJob(tr("Downloading modpack"), m_network));
+    m_downloaded = false;
+    m_extractionFailed = false;
+    m_pendingExtractions = 0;
 
     int i = 0;
     for (const auto& mod : build.mods) {
@@ -117,6 +122,8 @@ void Technic::SolderPackInstallTask::fileListSucceeded()
             auto rawMd5 = QByteArray::fromHex(mod.md5.toLatin1());
             dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Md5, rawMd5));
         }
+        // every zip is unpacked as soon as it is here, while the rest are still downloading
+        connect(dl.get(), &Task::succeeded, this, [this, i] { extractMod(i); });
         m_filesNetJob->addNetAction(dl);
 
         i++;
@@ -132,24 +139,67 @@ void Technic::SolderPackInstallTask::fileListSucceeded()
     m_filesNetJob->start();
 }
 
+void Technic::SolderPackInstallTask::extractMod(int index)
+{
+    auto path = FS::PathCombine(m_outputDir.path(), QString("%1").arg(index));
+    auto extractDir = FS::PathCombine(m_stagingPath, ".solder", QString("%1").arg(index));
+
+    m_pendingExtractions++;
+    auto watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher] {
+        watcher->deleteLater();
+        m_pendingExtractions--;
+        if (!watcher->result())
+            m_extractionFailed = true;
+        mergeExtractedMods();
+    });
+    // bulk work, so a pack with hundreds of zips can't get in the way of more urgent work
+    watcher->setFuture(CpuExecutor::run(CpuExecutor::Priority::Bulk, [path, extractDir] {
+        FS::ensureFolderPathExists(extractDir);
+        return MMCZip::extractDir(path, extractDir).has_value();
+    }));
+}
+
 void Technic::SolderPackInstallTask::downloadSucceeded()
 {
     m_abortable = false;
 
     setStatus(tr("Extracting modpack"));
     m_filesNetJob.reset();
+    m_downloaded = true;
+    mergeExtractedMods();
+}
+
+void Technic::SolderPackInstallTask::mergeExtractedMods()
+{
+    if (!m_downloaded || m_pendingExtractions > 0 || !isRunning())
+        return;
+
+    if (m_extractionFailed) {
+        emitFailed(tr("Failed to extract modpack"));
+        return;
+    }
+
     m_extractFuture = QtConcurrent::run([this]() {
-        int i = 0;
+        QString scratchDir = FS::PathCombine(m_stagingPath, ".solder");
         QString extractDir = FS::PathCombine(m_stagingPath, "minecraft");
         FS::ensureFolderPathExists(extractDir);
 
-        while (m_modCount > i) {
-            auto path = FS::PathCombine(m_outputDir.path(), QString("%1").arg(i));
-            if (!MMCZip::extractDir(path, extractDir)) {
-                return false;
+        // the zips were unpacked side by side, so lay them over each other in order, like a serial extraction would have
+        for (int i = 0; i < m_modCount; i++) {
+            QDir modDir(FS::PathCombine(scratchDir, QString("%1").arg(i)));
+            QDirIterator it(modDir.path(), QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                auto source = it.next();
+                auto target = FS::PathCombine(extractDir, modDir.relativeFilePath(source));
+                if (it.fileInfo().isDir()) {
+                    FS::ensureFolderPathExists(target);
+                } else if (!FS::move(source, target)) {
+                    return false;
+                }
             }
-            i++;
         }
+        FS::deletePath(scratchDir);
         return true;
     });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &Technic::SolderPackInstallTask::extractFinished);
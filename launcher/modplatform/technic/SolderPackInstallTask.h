@@ -68,6 +68,10 @@ class SolderPackInstallTask : public InstanceTask {
     void extractFinished();
     void extractAborted();
 
+   private:
+    void extractMod(int index);
+    void mergeExtractedMods();
+
    private:
     bool m_abortable = false;
 
@@ -81,6 +85,9 @@ class SolderPackInstallTask : public InstanceTask {
     std::shared_ptr<QByteArray> m_response = std::make_shared<QByteArray>();
     QTemporaryDir m_outputDir;
     int m_modCount;
+    bool m_downloaded = false;
+    bool m_extractionFailed = false;
+    int m_pendingExtractions = 0;
     QFuture<bool> m_extractFuture;
     QFutureWatcher<bool> m_extractFutureWatcher;
 };
@@ -19,7 +19,8 @@
 
 #include "net/ApiDownload.h"
 #include "ByteArraySink.h"
-#include "ChecksumValidator.h"
+#include "MultiChecksumValidator.h"
+#include "ContentStoreSink.h"
 #include "MetaCacheSink.h"
 
 namespace Net {
@@ -30,8 +31,10 @@ auto ApiDownload::makeCached(QUrl url, MetaEntryPtr entry, Options options) -> D
     dl->m_url = url;
     dl->setObjectName(QString("CACHE:") + url.toString());
     dl->m_options = options;
-    auto md5Node = new ChecksumValidator(QCryptographicHash::Md5);
-    auto cachedNode = new MetaCacheSink(entry, md5Node, options.testFlag(Option::MakeEternal));
+    // compute the digests the mod platforms may ask about later on, so nobody has to read the file again for them.
+    // murmur2 would need to buffer the whole file, and every platform accepts one of the others anyway.
+    auto checksums = new MultiChecksumValidator({ QCryptographicHash::Md5, QCryptographicHash::Sha1, QCryptographicHash::Sha512 });
+    auto cachedNode = new MetaCacheSink(entry, checksums, options.testFlag(Option::MakeEternal));
     dl->m_sink.reset(cachedNode);
     return dl;
 }
@@ -56,6 +59,45 @@ auto ApiDownload::makeFile(QUrl url, QString path, Options options) -> Download:
     return dl;
 }
 
+auto ApiDownload::makeJsonArray(QUrl url, JsonArraySink::Callback callback, Options options) -> Download::Ptr
+{
+    auto dl = makeShared<ApiDownload>();
+    dl->m_url = url;
+    dl->setObjectName(QString("JSON:") + url.toString());
+    dl->m_options = options;
+    dl->m_sink.reset(new JsonArraySink(std::move(callback)));
+    return dl;
+}
+
+auto ApiDownload::makeStored(QUrl url, QString path, QString hash_type, QString hash, Options options) -> Download::Ptr
+{
+    QCryptographicHash::Algorithm algorithm;
+    if (hash.isEmpty() || !ContentStore::algorithmFor(hash_type, algorithm))
+        return makeFile(url, path, options);
+
+    auto dl = makeShared<ApiDownload>();
+    dl->m_url = url;
+    dl->setObjectName(QString("STORED:") + url.toString());
+    dl->m_options = options;
+    dl->m_sink.reset(new ContentStoreSink(path, algorithm, hash));
+    return dl;
+}
+
+auto ApiDownload::makeRange(QUrl url,
+                            QString path,
+                            qint64 first,
+                            qint64 last,
+                            std::shared_ptr<RangeSink::Received> received,
+                            Options options) -> Download::Ptr
+{
+    auto dl = makeShared<ApiDownload>();
+    dl->m_url = url;
+    dl->setObjectName(QString("RANGE:") + url.toString());
+    dl->m_options = options;
+    dl->m_sink.reset(new RangeSink(path, first, last, std::move(received)));
+    return dl;
+}
+
 void ApiDownload::init()
 {
     qDebug() << "Setting up api download";
@@ -21,6 +21,8 @@
 
 #include "ApiHeaderProxy.h"
 #include "Download.h"
+#include "JsonArraySink.h"
+#include "RangeSink.h"
 
 namespace Net {
 
@@ -31,6 +33,17 @@ class ApiDownload : public Download {
     static auto makeCached(QUrl url, MetaEntryPtr entry, Options options = Option::NoOptions) -> Download::Ptr;
     static auto makeByteArray(QUrl url, std::shared_ptr<QByteArray> output, Options options = Option::NoOptions) -> Download::Ptr;
     static auto makeFile(QUrl url, QString path, Options options = Option::NoOptions) -> Download::Ptr;
+    /* For responses that are a JSON array of objects, handing them to callback as they arrive. */
+    static auto makeJsonArray(QUrl url, JsonArraySink::Callback callback, Options options = Option::NoOptions) -> Download::Ptr;
+    /* Like makeFile, but shares the file through the content store when its hash is known. */
+    static auto makeStored(QUrl url, QString path, QString hash_type, QString hash, Options options = Option::NoOptions) -> Download::Ptr;
+    /* Bytes first to last of the file at url, or its last -first bytes, written into path at the same offset. See RangeSink. */
+    static auto makeRange(QUrl url,
+                          QString path,
+                          qint64 first,
+                          qint64 last,
+                          std::shared_ptr<RangeSink::Received> received,
+                          Options options = Option::NoOptions) -> Download::Ptr;
 
     void init() override;
 };
@@ -28,6 +28,8 @@ Upload::Ptr ApiUpload::makeByteArray(QUrl url, std::shared_ptr<QByteArray> outpu
     up->m_url = std::move(url);
     up->m_sink.reset(new ByteArraySink(output));
     up->m_post_data = std::move(m_post_data);
+    // the lists of hashes and ids sent to the mod platforms get big, and compress well
+    up->setCompressBody(true);
     return up;
 }
 
@@ -61,6 +61,16 @@ class ByteArraySink : public Sink {
         return Task::State::Failed;
     };
 
+    auto headersReceived(QNetworkReply& reply) -> Task::State override
+    {
+        // most responses say how big they are, so the buffer can be allocated once instead of growing with every chunk
+        bool ok = false;
+        auto length = reply.header(QNetworkRequest::ContentLengthHeader).toLongLong(&ok);
+        if (m_output && ok && length > m_output->capacity() && length <= MAX_PREALLOCATION)
+            m_output->reserve(static_cast<int>(length));
+        return Task::State::Running;
+    }
+
     auto write(QByteArray& data) -> Task::State override
     {
         if (m_output)
@@ -88,6 +98,9 @@ class ByteArraySink : public Sink {
     auto hasLocalData() -> bool override { return false; }
 
    private:
+    // the length comes from the server, so don't take its word for anything huge
+    static constexpr qint64 MAX_PREALLOCATION = 64 * 1024 * 1024;
+
     std::shared_ptr<QByteArray> m_output;
 };
 }  // namespace Net
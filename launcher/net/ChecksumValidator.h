@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include "CryptoHash.h"
+#include "Metrics.h"
 #include "Validator.h"
 
 #include <QCryptographicHash>
@@ -44,7 +46,7 @@ namespace Net {
 class ChecksumValidator : public Validator {
    public:
     ChecksumValidator(QCryptographicHash::Algorithm algorithm, QByteArray expected = QByteArray())
-        : m_checksum(algorithm), m_expected(expected){};
+        : m_algorithm(algorithm), m_checksum(algorithm), m_expected(expected){};
     virtual ~ChecksumValidator() = default;
 
    public:
@@ -64,8 +66,13 @@ class ChecksumValidator : public Validator {
 
     auto validate(QNetworkReply&) -> bool override
     {
-        if (m_expected.size() && m_expected != hash()) {
+        if (!m_expected.size())
+            return true;
+
+        Metrics::count("net.checksum.checked");
+        if (m_expected != hash()) {
             qWarning() << "Checksum mismatch, download is bad.";
+            Metrics::count("net.checksum.mismatches");
             return false;
         }
         return true;
@@ -75,8 +82,18 @@ class ChecksumValidator : public Validator {
 
     void setExpected(QByteArray expected) { m_expected = expected; }
 
+    auto expectedHash(QCryptographicHash::Algorithm& algorithm, QByteArray& hash) const -> bool override
+    {
+        if (m_expected.isEmpty())
+            return false;
+        algorithm = m_algorithm;
+        hash = m_expected;
+        return true;
+    }
+
    private:
-    QCryptographicHash m_checksum;
+    QCryptographicHash::Algorithm m_algorithm;
+    CryptoHash m_checksum;
     QByteArray m_expected;
 };
 }  // namespace Net
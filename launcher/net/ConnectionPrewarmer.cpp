@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ConnectionPrewarmer.h"
+
+#include <QStringList>
+#include <QUrl>
+
+#include "BuildConfig.h"
+#include "net/Logging.h"
+
+namespace Net {
+
+namespace {
+
+// a host used in every session scores close to 4, one used once is no longer connected to three sessions later
+constexpr double SCORE_DECAY = 0.75;
+constexpr double PREWARM_SCORE = 0.5;
+
+}  // namespace
+
+ConnectionPrewarmer::ConnectionPrewarmer(SettingsObjectPtr settings) : m_settings(std::move(settings))
+{
+    // only API hosts, downloads from CDNs are too spread out to guess
+    for (auto& url : { BuildConfig.META_URL, BuildConfig.MODRINTH_PROD_URL, BuildConfig.FLAME_BASE_URL })
+        m_known.insert(QUrl(url).host());
+    m_known.insert("piston-meta.mojang.com");
+    m_known.insert("login.live.com");
+    m_known.insert("user.auth.xboxlive.com");
+    m_known.insert("xsts.auth.xboxlive.com");
+    m_known.insert("api.minecraftservices.com");
+
+    for (auto& line : m_settings->get("PrewarmHosts").toString().split('\n')) {
+        auto parts = line.split(' ');
+        bool valid = false;
+        auto score = parts.size() == 2 ? parts[1].toDouble(&valid) : 0;
+        if (valid && m_known.contains(parts[0]))
+            m_scores.insert(parts[0], score);
+    }
+}
+
+void ConnectionPrewarmer::prewarm(QNetworkAccessManager* network)
+{
+    for (auto it = m_scores.begin(); it != m_scores.end(); ++it) {
+        if (it.value() < PREWARM_SCORE)
+            continue;
+        qCDebug(taskNetLogC) << "Connecting to" << it.key() << "ahead of time";
+        network->connectToHostEncrypted(it.key());
+    }
+}
+
+void ConnectionPrewarmer::hostUsed(const QString& host)
+{
+    if (m_known.contains(host))
+        m_used.insert(host);
+}
+
+void ConnectionPrewarmer::save()
+{
+    QStringList lines;
+    for (auto& host : m_known) {
+        auto score = m_scores.value(host) * SCORE_DECAY + (m_used.contains(host) ? 1 : 0);
+        if (score >= PREWARM_SCORE)
+            lines << host + ' ' + QString::number(score);
+    }
+    m_settings->set("PrewarmHosts", lines.join('\n'));
+}
+
+}  // namespace Net
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QSet>
+#include <QString>
+
+#include "settings/SettingsObject.h"
+
+namespace Net {
+
+/** Opens connections to the API hosts the user is likely to need before anything asks for them.
+ *
+ *  The first request to a host pays for the DNS lookup and the TLS handshake, right when the user opens a page or
+ *  clicks Launch. The hosts that were used in recent sessions are connected to once the launcher has started, so
+ *  that request goes over a connection that is already open.
+ *
+ *  How often each known host was used is kept in a setting, with older sessions counting for less.
+ */
+class ConnectionPrewarmer {
+   public:
+    explicit ConnectionPrewarmer(SettingsObjectPtr settings);
+
+    /* Connects to the hosts that were used in recent sessions. */
+    void prewarm(QNetworkAccessManager* network);
+
+    /* A request to 'host' got an answer, this session uses it. */
+    void hostUsed(const QString& host);
+
+    /* Remembers which hosts this session used, for the next one. */
+    void save();
+
+   private:
+    SettingsObjectPtr m_settings;
+    QSet<QString> m_known;
+    QHash<QString, double> m_scores;
+    QSet<QString> m_used;
+};
+
+}  // namespace Net
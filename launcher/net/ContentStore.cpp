@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ContentStore.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include "CryptoHash.h"
+#include "FileSystem.h"
+#include "net/Logging.h"
+
+namespace Net {
+
+bool ContentStore::algorithmFor(const QString& hash_type, QCryptographicHash::Algorithm& algorithm)
+{
+    auto type = hash_type.toLower();
+    if (type == "sha1") {
+        algorithm = QCryptographicHash::Sha1;
+        return true;
+    }
+    if (type == "sha256") {
+        algorithm = QCryptographicHash::Sha256;
+        return true;
+    }
+    if (type == "sha512") {
+        algorithm = QCryptographicHash::Sha512;
+        return true;
+    }
+    // md5 and murmur2 are too weak to address content by
+    return false;
+}
+
+static QString algorithmDirectory(QCryptographicHash::Algorithm algorithm)
+{
+    switch (algorithm) {
+        case QCryptographicHash::Sha1:
+            return "sha1";
+        case QCryptographicHash::Sha256:
+            return "sha256";
+        case QCryptographicHash::Sha512:
+            return "sha512";
+        default:
+            return "other";
+    }
+}
+
+auto ContentStore::blobPath(QCryptographicHash::Algorithm algorithm, const QString& hash) const -> QString
+{
+    auto normalized = hash.toLower();
+    return FS::PathCombine(m_root, algorithmDirectory(algorithm), normalized.left(2), normalized);
+}
+
+bool ContentStore::contains(QCryptographicHash::Algorithm algorithm, const QString& hash) const
+{
+    if (hash.isEmpty())
+        return false;
+    QFileInfo info(blobPath(algorithm, hash));
+    return info.isFile() && info.size() > 0;
+}
+
+bool ContentStore::materialize(QCryptographicHash::Algorithm algorithm, const QString& hash, const QString& destination) const
+{
+    if (!contains(algorithm, hash))
+        return false;
+
+    auto blob = blobPath(algorithm, hash);
+
+    // hard links share the data with every instance using it, so make sure nobody modified it in place
+    QFile file(blob);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    CryptoHash checksum(algorithm);
+    checksum.addData(&file);
+    file.close();
+    if (checksum.result().toHex() != hash.toLower().toLatin1()) {
+        qCWarning(taskNetLogC) << "Dropping corrupted blob from the content store:" << blob;
+        QFile::remove(blob);
+        return false;
+    }
+
+    if (!FS::shareFile(blob, destination)) {
+        qCWarning(taskNetLogC) << "Failed to materialize" << blob << "at" << destination;
+        return false;
+    }
+
+    qCDebug(taskNetLogC) << "Materialized" << destination << "from the content store";
+    return true;
+}
+
+bool ContentStore::ingest(const QString& path, QCryptographicHash::Algorithm algorithm, const QString& hash) const
+{
+    if (hash.isEmpty() || contains(algorithm, hash))
+        return true;
+
+    auto blob = blobPath(algorithm, hash);
+    if (!FS::shareFile(path, blob)) {
+        qCWarning(taskNetLogC) << "Failed to add" << path << "to the content store";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace Net
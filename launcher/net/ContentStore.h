@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QCryptographicHash>
+#include <QString>
+
+namespace Net {
+
+/** A content-addressed store for downloaded files.
+ *
+ *  Files are kept under <root>/<algorithm>/<first two hash characters>/<hash>, so the same
+ *  file downloaded for many instances is only stored once. Instances get their copy through
+ *  a reflink or a hard link when the filesystem allows it.
+ */
+class ContentStore {
+   public:
+    explicit ContentStore(QString root) : m_root(std::move(root)) {}
+
+    /** Maps a hash type as reported by the mod platforms ("sha1", "sha512", ...) to an algorithm.
+     *  Returns false if the store doesn't handle that hash type.
+     */
+    static bool algorithmFor(const QString& hash_type, QCryptographicHash::Algorithm& algorithm);
+
+    auto blobPath(QCryptographicHash::Algorithm algorithm, const QString& hash) const -> QString;
+    bool contains(QCryptographicHash::Algorithm algorithm, const QString& hash) const;
+
+    /** Makes the stored blob available at `destination`.
+     *  The blob is verified first, and dropped from the store if it doesn't match its hash anymore.
+     */
+    bool materialize(QCryptographicHash::Algorithm algorithm, const QString& hash, const QString& destination) const;
+
+    /** Adds the file at `path`, whose contents are known to hash to `hash`, to the store. */
+    bool ingest(const QString& path, QCryptographicHash::Algorithm algorithm, const QString& hash) const;
+
+   private:
+    QString m_root;
+};
+
+}  // namespace Net
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ContentStoreSink.h"
+
+#include "Application.h"
+
+#include "modplatform/helpers/HashCache.h"
+#include "net/Logging.h"
+
+namespace Net {
+
+// these are resources from the mod platforms, so compute everything they may identify them by in the same pass
+static QList<QCryptographicHash::Algorithm> digestsFor(QCryptographicHash::Algorithm store_algorithm)
+{
+    QList<QCryptographicHash::Algorithm> algorithms = { QCryptographicHash::Md5, QCryptographicHash::Sha1, QCryptographicHash::Sha512 };
+    if (!algorithms.contains(store_algorithm))
+        algorithms.append(store_algorithm);
+    return algorithms;
+}
+
+namespace {
+/* Enforces the platforms' hash on data from untrusted sources. Coming from the platforms themselves, a mismatch only
+ * means the file isn't stored. */
+class UntrustedSourceValidator : public Validator {
+   public:
+    UntrustedSourceValidator(const bool& untrusted, QCryptographicHash::Algorithm algorithm, QByteArray expected)
+        : m_untrusted(untrusted), m_algorithm(algorithm), m_checksum(algorithm), m_expected(std::move(expected))
+    {}
+
+    auto init(QNetworkRequest&) -> bool override
+    {
+        m_checksum.reset();
+        return true;
+    }
+
+    auto write(QByteArray& data) -> bool override
+    {
+        if (m_untrusted)
+            m_checksum.addData(data);
+        return true;
+    }
+
+    auto abort() -> bool override { return true; }
+
+    auto validate(QNetworkReply&) -> bool override
+    {
+        if (!m_untrusted || m_checksum.result() == m_expected)
+            return true;
+        qCWarning(taskNetLogC) << "Checksum mismatch, download from an untrusted source is bad.";
+        return false;
+    }
+
+    auto expectedHash(QCryptographicHash::Algorithm& algorithm, QByteArray& hash) const -> bool override
+    {
+        if (m_expected.isEmpty())
+            return false;
+        algorithm = m_algorithm;
+        hash = m_expected;
+        return true;
+    }
+
+   private:
+    const bool& m_untrusted;
+    QCryptographicHash::Algorithm m_algorithm;
+    QCryptographicHash m_checksum;
+    QByteArray m_expected;
+};
+}  // namespace
+
+ContentStoreSink::ContentStoreSink(QString filename, QCryptographicHash::Algorithm algorithm, QString hash)
+    : FileSink(filename)
+    , m_algorithm(algorithm)
+    , m_hash(hash.toLower())
+    , m_checksums(new MultiChecksumValidator(digestsFor(algorithm), true))
+{
+    addValidator(m_checksums);
+    addValidator(new UntrustedSourceValidator(m_untrusted_source, algorithm, QByteArray::fromHex(m_hash.toLatin1())));
+}
+
+Task::State ContentStoreSink::initCache(QNetworkRequest&)
+{
+    if (APPLICATION->contentStore()->materialize(m_algorithm, m_hash, m_filename)) {
+        // materialize checked the blob's hash, so there's no need to hash the file again later
+        APPLICATION->hashCache()->insert(m_filename, Hashing::FileIdentity::of(m_filename), MultiChecksumValidator::nameOf(m_algorithm),
+                                         m_hash);
+        return Task::State::Succeeded;
+    }
+
+    return Task::State::Running;
+}
+
+Task::State ContentStoreSink::finalizeCache(QNetworkReply&)
+{
+    if (!wroteAnyData)
+        return Task::State::Succeeded;
+
+    // we hashed it on the way in, so save the mod update checks from reading it again
+    APPLICATION->hashCache()->insert(m_filename, Hashing::FileIdentity::of(m_filename), m_checksums->hashes());
+
+    if (m_checksums->hash(MultiChecksumValidator::nameOf(m_algorithm)) != m_hash) {
+        // the download itself is fine as far as we know, but we can't store it under a hash it doesn't have
+        qCWarning(taskNetLogC) << "Not storing" << m_filename << "in the content store: its hash doesn't match the expected one";
+        return Task::State::Succeeded;
+    }
+
+    APPLICATION->contentStore()->ingest(m_filename, m_algorithm, m_hash);
+    return Task::State::Succeeded;
+}
+
+}  // namespace Net
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "MultiChecksumValidator.h"
+#include "ContentStore.h"
+#include "FileSink.h"
+
+namespace Net {
+
+/** A file sink backed by the content store.
+ *
+ *  If a blob with the expected hash is already stored, the file is linked from it and nothing is downloaded.
+ *  Otherwise the file is downloaded as usual and added to the store, provided it matches the expected hash.
+ */
+class ContentStoreSink : public FileSink {
+   public:
+    ContentStoreSink(QString filename, QCryptographicHash::Algorithm algorithm, QString hash);
+    virtual ~ContentStoreSink() = default;
+
+    /* All digests of the downloaded file, by hash type. Empty if nothing was downloaded. */
+    auto hashes() const -> QHash<QString, QString> { return m_checksums->hashes(); }
+
+   protected:
+    auto initCache(QNetworkRequest& request) -> Task::State override;
+    auto finalizeCache(QNetworkReply& reply) -> Task::State override;
+
+   private:
+    QCryptographicHash::Algorithm m_algorithm;
+    QString m_hash;
+    MultiChecksumValidator* m_checksums;
+};
+}  // namespace Net
@@ -44,7 +44,8 @@
 #include <memory>
 
 #include "ByteArraySink.h"
-#include "ChecksumValidator.h"
+#include "MultiChecksumValidator.h"
+#include "ContentStoreSink.h"
 #include "MetaCacheSink.h"
 
 namespace Net {
@@ -56,8 +57,10 @@ auto Download::makeCached(QUrl url, MetaEntryPtr entry, Options options) -> Down
     dl->m_url = url;
     dl->setObjectName(QString("CACHE:") + url.toString());
     dl->m_options = options;
-    auto md5Node = new ChecksumValidator(QCryptographicHash::Md5);
-    auto cachedNode = new MetaCacheSink(entry, md5Node, options.testFlag(Option::MakeEternal));
+    // compute the digests the mod platforms may ask about later on, so nobody has to read the file again for them.
+    // murmur2 would need to buffer the whole file, and every platform accepts one of the others anyway.
+    auto checksums = new MultiChecksumValidator({ QCryptographicHash::Md5, QCryptographicHash::Sha1, QCryptographicHash::Sha512 });
+    auto cachedNode = new MetaCacheSink(entry, checksums, options.testFlag(Option::MakeEternal));
     dl->m_sink.reset(cachedNode);
     return dl;
 }
@@ -83,6 +86,22 @@ auto Download::makeFile(QUrl url, QString path, Options options) -> Download::Pt
     return dl;
 }
 
+#if defined(LAUNCHER_APPLICATION)
+auto Download::makeStored(QUrl url, QString path, QString hash_type, QString hash, Options options) -> Download::Ptr
+{
+    QCryptographicHash::Algorithm algorithm;
+    if (hash.isEmpty() || !ContentStore::algorithmFor(hash_type, algorithm))
+        return makeFile(url, path, options);
+
+    auto dl = makeShared<Download>();
+    dl->m_url = url;
+    dl->setObjectName(QString("STORED:") + url.toString());
+    dl->m_options = options;
+    dl->m_sink.reset(new ContentStoreSink(path, algorithm, hash));
+    return dl;
+}
+#endif
+
 QNetworkReply* Download::getReply(QNetworkRequest& request)
 {
     return m_network->get(request);
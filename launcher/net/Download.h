@@ -56,6 +56,10 @@ class Download : public NetRequest {
 
     static auto makeByteArray(QUrl url, std::shared_ptr<QByteArray> output, Options options = Option::NoOptions) -> Download::Ptr;
     static auto makeFile(QUrl url, QString path, Options options = Option::NoOptions) -> Download::Ptr;
+#if defined(LAUNCHER_APPLICATION)
+    /* Like makeFile, but shares the file through the content store when its hash is known. */
+    static auto makeStored(QUrl url, QString path, QString hash_type, QString hash, Options options = Option::NoOptions) -> Download::Ptr;
+#endif
 
    protected:
     virtual QNetworkReply* getReply(QNetworkRequest&) override;
@@ -35,6 +35,8 @@
 
 #include "FileSink.h"
 
+#include <QFileInfo>
+
 #include "FileSystem.h"
 
 #include "net/Logging.h"
@@ -55,23 +57,86 @@ Task::State FileSink::init(QNetworkRequest& request)
     }
 
     wroteAnyData = false;
-    m_output_file.reset(new QSaveFile(m_filename));
-    if (!m_output_file->open(QIODevice::WriteOnly)) {
-        qCCritical(taskNetLogC) << "Could not open " + m_filename + " for writing";
+    m_resume_from = 0;
+
+    QFileInfo partial(partialPath());
+    if (partial.exists() && partial.size() > 0 && !m_partial_validator.isEmpty()) {
+        m_resume_from = partial.size();
+        request.setRawHeader("Range", QString("bytes=%1-").arg(m_resume_from).toLatin1());
+        request.setRawHeader("If-Range", m_partial_validator);
+        // any cache validators refer to the complete file we had before, not to the partial one
+        request.setRawHeader("If-None-Match", QByteArray());
+        request.setRawHeader("If-Modified-Since", QByteArray());
+    } else {
+        discardPartial();
+    }
+
+    m_request = request;
+    m_output_file.reset(new QFile(partialPath()));
+    if (!m_output_file->open(m_resume_from > 0 ? QIODevice::WriteOnly | QIODevice::Append : QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCCritical(taskNetLogC) << "Could not open " + partialPath() + " for writing";
         return Task::State::Failed;
     }
 
-    if (initAllValidators(request))
+    if (!initAllValidators(request))
+        return Task::State::Failed;
+
+    if (m_resume_from > 0) {
+        // the validators need to see the whole file, including what we already have
+        QFile existing(partialPath());
+        if (!existing.open(QIODevice::ReadOnly)) {
+            qCCritical(taskNetLogC) << "Could not read back " + partialPath();
+            return Task::State::Failed;
+        }
+        while (!existing.atEnd()) {
+            auto chunk = existing.read(1024 * 1024);
+            if (!writeAllValidators(chunk))
+                return Task::State::Failed;
+        }
+        qCDebug(taskNetLogC) << "Resuming download of" << m_filename << "at byte" << m_resume_from;
+    }
+
+    return Task::State::Running;
+}
+
+Task::State FileSink::headersReceived(QNetworkReply& reply)
+{
+    auto status_code = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    // redirects carry no content of ours
+    if (status_code >= 300 && status_code < 400)
         return Task::State::Running;
-    return Task::State::Failed;
+
+    if (status_code == 416) {
+        // the range we asked for doesn't exist anymore, start from scratch next time
+        m_partial_validator.clear();
+        return Task::State::Running;
+    }
+
+    // only strong validators are allowed in If-Range
+    auto etag = reply.rawHeader("ETag");
+    if (!etag.isEmpty() && !etag.startsWith("W/"))
+        m_partial_validator = etag;
+    else
+        m_partial_validator = reply.rawHeader("Last-Modified");
+
+    if (m_resume_from > 0 && status_code != 206) {
+        // the server sends us the whole file instead (e.g. because it changed), drop what we have
+        qCDebug(taskNetLogC) << "Server ignored range request for" << m_filename << ", restarting download";
+        m_resume_from = 0;
+        if (!m_output_file->resize(0) || !initAllValidators(m_request))
+            return Task::State::Failed;
+    }
+
+    return Task::State::Running;
 }
 
 Task::State FileSink::write(QByteArray& data)
 {
     if (!writeAllValidators(data) || m_output_file->write(data) != data.size()) {
         qCCritical(taskNetLogC) << "Failed writing into " + m_filename;
-        m_output_file->cancelWriting();
         m_output_file.reset();
+        discardPartial();
         wroteAnyData = false;
         return Task::State::Failed;
     }
@@ -82,7 +147,19 @@ Task::State FileSink::write(QByteArray& data)
 
 Task::State FileSink::abort()
 {
-    m_output_file->cancelWriting();
+    if (m_output_file) {
+        m_output_file->close();
+        m_output_file.reset();
+    }
+
+    // keep what we got so far if we'll be able to resume from it
+    QFileInfo partial(partialPath());
+    if (!m_partial_validator.isEmpty() && partial.exists() && partial.size() > 0) {
+        qCDebug(taskNetLogC) << "Keeping" << partial.size() << "bytes of" << m_filename << "to resume from";
+    } else {
+        discardPartial();
+    }
+
     failAllValidators();
     return Task::State::Failed;
 }
@@ -95,31 +172,55 @@ Task::State FileSink::finalize(QNetworkReply& reply)
     int statusCode = statusCodeV.toInt(&validStatus);
     if (validStatus) {
         // this leaves out 304 Not Modified
-        gotFile = statusCode == 200 || statusCode == 203;
+        gotFile = statusCode == 200 || statusCode == 203 || statusCode == 206;
     }
 
+    if (m_output_file)
+        m_output_file->close();
+    m_output_file.reset();
+
     // if we wrote any data to the save file, we try to commit the data to the real file.
     // if it actually got a proper file, we write it even if it was empty
     if (gotFile || wroteAnyData) {
         // ask validators for data consistency
         // we only do this for actual downloads, not 'your data is still the same' cache hits
-        if (!finalizeAllValidators(reply))
+        if (!finalizeAllValidators(reply)) {
+            discardPartial();
             return Task::State::Failed;
+        }
 
         // nothing went wrong...
-        if (!m_output_file->commit()) {
+        if (QFile::exists(m_filename) && !QFile::remove(m_filename)) {
+            qCCritical(taskNetLogC) << "Failed to replace " << m_filename;
+            discardPartial();
+            return Task::State::Failed;
+        }
+        if (!QFile::rename(partialPath(), m_filename)) {
             qCCritical(taskNetLogC) << "Failed to commit changes to " << m_filename;
-            m_output_file->cancelWriting();
+            discardPartial();
             return Task::State::Failed;
         }
     }
 
     // then get rid of the save file
-    m_output_file.reset();
+    discardPartial();
 
     return finalizeCache(reply);
 }
 
+auto FileSink::partialPath() const -> QString
+{
+    return m_filename + ".part";
+}
+
+void FileSink::discardPartial()
+{
+    m_partial_validator.clear();
+    m_resume_from = 0;
+    if (QFile::exists(partialPath()))
+        QFile::remove(partialPath());
+}
+
 Task::State FileSink::initCache(QNetworkRequest&)
 {
     return Task::State::Running;
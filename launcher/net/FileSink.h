@@ -35,7 +35,8 @@
 
 #pragma once
 
-#include <QSaveFile>
+#include <QFile>
+#include <QNetworkRequest>
 
 #include "Sink.h"
 
@@ -50,6 +51,7 @@ class FileSink : public Sink {
     auto write(QByteArray& data) -> Task::State override;
     auto abort() -> Task::State override;
     auto finalize(QNetworkReply& reply) -> Task::State override;
+    auto headersReceived(QNetworkReply& reply) -> Task::State override;
 
     auto hasLocalData() -> bool override;
 
@@ -57,9 +59,23 @@ class FileSink : public Sink {
     virtual auto initCache(QNetworkRequest&) -> Task::State;
     virtual auto finalizeCache(QNetworkReply& reply) -> Task::State;
 
+   private:
+    auto partialPath() const -> QString;
+    void discardPartial();
+
    protected:
     QString m_filename;
     bool wroteAnyData = false;
-    std::unique_ptr<QSaveFile> m_output_file;
+
+   private:
+    /* Data is downloaded into <filename>.part, and only moved in place once it's complete.
+     * If a download fails midway, the partial file is kept around, and the next attempt asks
+     * the server for the remaining bytes only (see RFC 9110, section 14).
+     */
+    std::unique_ptr<QFile> m_output_file;
+    QNetworkRequest m_request;
+    qint64 m_resume_from = 0;
+    /* ETag (or Last-Modified date) of the response the partial file comes from, used as the If-Range condition */
+    QByteArray m_partial_validator;
 };
 }  // namespace Net
@@ -36,16 +36,40 @@
 #include "HttpMetaCache.h"
 #include "FileSystem.h"
 #include "Json.h"
+#include "Metrics.h"
 
 #include <QCryptographicHash>
 #include <QDateTime>
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 
 #include <QDebug>
 
 #include "net/Logging.h"
 
+namespace {
+/*
+ * The binary index consists of a snapshot, followed by an append-only journal:
+ *
+ *   header:  magic, format version, journal offset, base count,
+ *            then per base: name, block offset, entry count
+ *   blocks:  the entries of each base, contiguous, so a base can be read on its own
+ *   journal: a sequence of (op, base, path[, entry]) records, appended as entries change
+ *
+ * Once the journal grows past the size of the snapshot, the whole file is rewritten.
+ */
+constexpr quint32 BINARY_INDEX_MAGIC = 0x504C4D43;  // "PLMC"
+constexpr quint32 BINARY_INDEX_VERSION = 2;
+constexpr auto BINARY_INDEX_STREAM_VERSION = QDataStream::Qt_5_12;
+
+constexpr quint8 JOURNAL_PUT = 1;
+constexpr quint8 JOURNAL_REMOVE = 2;
+
+// never bother compacting a journal shorter than this
+constexpr int MIN_JOURNAL_COMPACTION_SIZE = 4096;
+}  // namespace
+
 auto MetaEntry::getFullPath() -> QString
 {
     // FIXME: make local?
@@ -69,20 +93,25 @@ HttpMetaCache::~HttpMetaCache()
 auto HttpMetaCache::getEntry(QString base, QString resource_path) -> MetaEntryPtr
 {
     // no base. no base path. can't store
-    if (!m_entries.contains(base)) {
+    auto map = ensureLoaded(base);
+    if (!map) {
         // TODO: log problem
         return {};
     }
 
-    EntryMap& map = m_entries[base];
-    if (map.entry_list.contains(resource_path)) {
-        return map.entry_list[resource_path];
+    if (map->entry_list.contains(resource_path)) {
+        return map->entry_list[resource_path];
     }
 
     return {};
 }
 
 auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString expected_etag) -> MetaEntryPtr
+{
+    return resolveEntry(std::move(base), std::move(resource_path), QFileInfo(), std::move(expected_etag));
+}
+
+auto HttpMetaCache::resolveEntry(QString base, QString resource_path, const QFileInfo& file_info, QString expected_etag) -> MetaEntryPtr
 {
 #ifdef Q_OS_WIN
     resource_path = FS::RemoveInvalidPathChars(resource_path);
@@ -90,23 +119,28 @@ auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString ex
     auto entry = getEntry(base, resource_path);
     // it's not present? generate a default stale entry
     if (!entry) {
+        Metrics::count("httpmetacache.resolve.unknown");
         return staleEntry(base, resource_path);
     }
 
     auto& selected_base = m_entries[base];
     QString real_path = FS::PathCombine(selected_base.base_path, resource_path);
-    QFileInfo finfo(real_path);
+    QFileInfo finfo = file_info.filePath() == real_path ? file_info : QFileInfo(real_path);
 
     // is the file really there? if not -> stale
     if (!finfo.isFile() || !finfo.isReadable()) {
         // if the file doesn't exist, we disown the entry
         selected_base.entry_list.remove(resource_path);
+        recordRemove(base, resource_path);
+        Metrics::count("httpmetacache.resolve.file_missing");
         return staleEntry(base, resource_path);
     }
 
     if (!expected_etag.isEmpty() && expected_etag != entry->m_etag) {
         // if the etag doesn't match expected, we disown the entry
         selected_base.entry_list.remove(resource_path);
+        recordRemove(base, resource_path);
+        Metrics::count("httpmetacache.resolve.etag_mismatch");
         return staleEntry(base, resource_path);
     }
 
@@ -118,11 +152,14 @@ auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString ex
         QString md5sum = QCryptographicHash::hash(input.readAll(), QCryptographicHash::Md5).toHex().constData();
         if (entry->m_md5sum != md5sum) {
             selected_base.entry_list.remove(resource_path);
+            recordRemove(base, resource_path);
+            Metrics::count("httpmetacache.resolve.file_changed");
             return staleEntry(base, resource_path);
         }
 
         // md5sums matched... keep entry and save the new state to file
         entry->m_local_changed_timestamp = file_last_changed;
+        recordPut(entry);
         SaveEventually();
     }
 
@@ -132,17 +169,21 @@ auto HttpMetaCache::resolveEntry(QString base, QString resource_path, QString ex
         qCWarning(taskNetLogC) << "[HttpMetaCache]"
                                << "Removing cache entry because of old age!";
         selected_base.entry_list.remove(resource_path);
+        recordRemove(base, resource_path);
+        Metrics::count("httpmetacache.resolve.expired");
         return staleEntry(base, resource_path);
     }
 
     // entry passed all the checks we cared about.
+    Metrics::count("httpmetacache.resolve.valid");
     entry->m_basePath = getBasePath(base);
     return entry;
 }
 
 auto HttpMetaCache::updateEntry(MetaEntryPtr stale_entry) -> bool
 {
-    if (!m_entries.contains(stale_entry->m_baseId)) {
+    auto map = ensureLoaded(stale_entry->m_baseId);
+    if (!map) {
         qCCritical(taskHttpMetaCacheLogC) << "Cannot add entry with unknown base: " << stale_entry->m_baseId.toLocal8Bit();
         return false;
     }
@@ -152,7 +193,8 @@ auto HttpMetaCache::updateEntry(MetaEntryPtr stale_entry) -> bool
         return false;
     }
 
-    m_entries[stale_entry->m_baseId].entry_list[stale_entry->m_relativePath] = stale_entry;
+    map->entry_list[stale_entry->m_relativePath] = stale_entry;
+    recordPut(stale_entry);
     SaveEventually();
 
     return true;
@@ -164,6 +206,7 @@ auto HttpMetaCache::evictEntry(MetaEntryPtr entry) -> bool
         return false;
 
     entry->m_stale = true;
+    recordRemove(entry->m_baseId, entry->m_relativePath);
     SaveEventually();
     return true;
 }
@@ -171,15 +214,34 @@ auto HttpMetaCache::evictEntry(MetaEntryPtr entry) -> bool
 void HttpMetaCache::evictAll()
 {
     for (QString& base : m_entries.keys()) {
-        EntryMap& map = m_entries[base];
+        EntryMap* map = ensureLoaded(base);
         qCDebug(taskHttpMetaCacheLogC) << "Evicting base" << base;
-        for (MetaEntryPtr entry : map.entry_list) {
+        for (MetaEntryPtr entry : map->entry_list) {
             if (!evictEntry(entry))
                 qCWarning(taskHttpMetaCacheLogC) << "Unexpected missing cache entry" << entry->m_basePath;
         }
     }
 }
 
+auto HttpMetaCache::removeEntry(QString base, QString resource_path) -> bool
+{
+    auto map = ensureLoaded(base);
+    if (!map || !map->entry_list.remove(resource_path))
+        return false;
+
+    recordRemove(base, resource_path);
+    SaveEventually();
+    return true;
+}
+
+auto HttpMetaCache::getEntries(QString base) -> QList<MetaEntryPtr>
+{
+    auto map = ensureLoaded(base);
+    if (!map)
+        return {};
+    return map->entry_list.values();
+}
+
 auto HttpMetaCache::staleEntry(QString base, QString resource_path) -> MetaEntryPtr
 {
     auto foo = new MetaEntry();
@@ -212,11 +274,155 @@ auto HttpMetaCache::getBasePath(QString base) -> QString
     return {};
 }
 
+auto HttpMetaCache::ensureLoaded(const QString& base) -> EntryMap*
+{
+    auto it = m_entries.find(base);
+    if (it == m_entries.end())
+        return nullptr;
+
+    auto& map = it.value();
+    if (map.loaded)
+        return &map;
+    map.loaded = true;
+
+    QFile index(binaryIndexPath());
+    if (map.block_count > 0 && index.open(QIODevice::ReadOnly) && index.seek(map.block_offset)) {
+        QDataStream stream(&index);
+        stream.setVersion(BINARY_INDEX_STREAM_VERSION);
+        for (quint32 i = 0; i < map.block_count; i++) {
+            auto entry = readEntry(stream, base);
+            if (stream.status() != QDataStream::Ok) {
+                qCWarning(taskHttpMetaCacheLogC) << "Truncated metacache block for base" << base;
+                m_needs_snapshot = true;
+                break;
+            }
+            map.entry_list[entry->m_relativePath] = entry;
+        }
+    }
+
+    // apply what changed since the snapshot was taken
+    for (auto& record : map.replay) {
+        if (record.entry)
+            map.entry_list[record.path] = record.entry;
+        else
+            map.entry_list.remove(record.path);
+    }
+    map.replay.clear();
+
+    qCDebug(taskHttpMetaCacheLogC) << "Loaded" << map.entry_list.size() << "metacache entries for base" << base;
+    return &map;
+}
+
+void HttpMetaCache::loadAll()
+{
+    for (auto& base : m_entries.keys())
+        ensureLoaded(base);
+}
+
+auto HttpMetaCache::binaryIndexPath() const -> QString
+{
+    return m_index_file + ".bin";
+}
+
 void HttpMetaCache::Load()
 {
     if (m_index_file.isNull())
         return;
 
+    if (loadBinary())
+        return;
+
+    // no usable binary index, fall back to the old JSON one (if any) and convert it on the next save
+    loadLegacyJson();
+    m_needs_snapshot = true;
+}
+
+auto HttpMetaCache::loadBinary() -> bool
+{
+    QFile index(binaryIndexPath());
+    if (!index.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&index);
+    stream.setVersion(BINARY_INDEX_STREAM_VERSION);
+
+    quint32 magic = 0, version = 0, base_count = 0;
+    qint64 journal_offset = 0;
+    stream >> magic >> version >> journal_offset >> base_count;
+    if (stream.status() != QDataStream::Ok || magic != BINARY_INDEX_MAGIC || version != BINARY_INDEX_VERSION) {
+        qCWarning(taskHttpMetaCacheLogC) << "Ignoring metacache index with unknown format";
+        return false;
+    }
+
+    struct BaseBlock {
+        QString base;
+        qint64 offset = 0;
+        quint32 count = 0;
+    };
+    QList<BaseBlock> blocks;
+    for (quint32 i = 0; i < base_count; i++) {
+        BaseBlock block;
+        stream >> block.base >> block.offset >> block.count;
+        if (stream.status() != QDataStream::Ok) {
+            qCWarning(taskHttpMetaCacheLogC) << "Ignoring corrupt metacache index";
+            return false;
+        }
+        blocks.append(block);
+    }
+
+    if (!index.seek(journal_offset)) {
+        qCWarning(taskHttpMetaCacheLogC) << "Ignoring corrupt metacache index";
+        return false;
+    }
+
+    for (auto& block : blocks) {
+        auto it = m_entries.find(block.base);
+        if (it == m_entries.end())
+            continue;
+        it->loaded = false;
+        it->block_offset = block.offset;
+        it->block_count = block.count;
+    }
+
+    // the journal is small compared to the snapshot, read it right away and keep the records around until their base is needed
+    m_needs_snapshot = false;
+    m_journal_on_disk = 0;
+    while (!stream.atEnd()) {
+        quint8 op = 0;
+        JournalRecord record;
+        stream >> op >> record.base >> record.path;
+        if (op == JOURNAL_PUT)
+            record.entry = readEntry(stream, record.base);
+
+        // a torn write at the end of the journal only loses the last change
+        if (stream.status() != QDataStream::Ok || (op != JOURNAL_PUT && op != JOURNAL_REMOVE)) {
+            qCWarning(taskHttpMetaCacheLogC) << "Discarding truncated metacache journal tail";
+            m_needs_snapshot = true;
+            break;
+        }
+
+        m_journal_on_disk++;
+        auto it = m_entries.find(record.base);
+        if (it == m_entries.end())
+            continue;
+        if (it->loaded) {
+            // base wasn't part of the snapshot, nothing to defer
+            if (record.entry)
+                it->entry_list[record.path] = record.entry;
+            else
+                it->entry_list.remove(record.path);
+        } else {
+            it->replay.append(record);
+        }
+    }
+
+    qCDebug(taskHttpMetaCacheLogC) << "Opened binary metacache index with" << base_count << "bases and" << m_journal_on_disk
+                                   << "journal records";
+    return true;
+}
+
+void HttpMetaCache::loadLegacyJson()
+{
     QFile index(m_index_file);
     if (!index.open(QIODevice::ReadOnly))
         return;
@@ -276,6 +482,36 @@ void HttpMetaCache::Load()
     }
 }
 
+void HttpMetaCache::writeEntry(QDataStream& stream, const MetaEntry& entry)
+{
+    stream << entry.m_relativePath << entry.m_md5sum << entry.m_etag << entry.m_local_changed_timestamp << entry.m_remote_changed_timestamp
+           << entry.m_is_eternal << entry.m_current_age << entry.m_max_age << entry.m_hashes;
+}
+
+auto HttpMetaCache::readEntry(QDataStream& stream, const QString& base) -> MetaEntryPtr
+{
+    auto foo = new MetaEntry();
+    foo->m_baseId = base;
+    foo->m_basePath = getBasePath(base);
+    stream >> foo->m_relativePath >> foo->m_md5sum >> foo->m_etag >> foo->m_local_changed_timestamp >> foo->m_remote_changed_timestamp >>
+        foo->m_is_eternal >> foo->m_current_age >> foo->m_max_age >> foo->m_hashes;
+
+    // presumed innocent until closer examination
+    foo->m_stale = false;
+
+    return MetaEntryPtr(foo);
+}
+
+void HttpMetaCache::recordPut(MetaEntryPtr entry)
+{
+    m_journal.append(JournalRecord{ entry->m_baseId, entry->m_relativePath, entry });
+}
+
+void HttpMetaCache::recordRemove(const QString& base, const QString& resource_path)
+{
+    m_journal.append(JournalRecord{ base, resource_path, nullptr });
+}
+
 void HttpMetaCache::SaveEventually()
 {
     // reset the save timer
@@ -288,41 +524,129 @@ void HttpMetaCache::SaveNow()
     if (m_index_file.isNull())
         return;
 
-    qCDebug(taskHttpMetaCacheLogC) << "Saving metacache with" << m_entries.size() << "entries";
+    if (m_journal.isEmpty() && !m_needs_snapshot)
+        return;
+
+    qint64 snapshot_size = 0;
+    for (auto& map : m_entries)
+        snapshot_size += map.loaded ? map.entry_list.size() : map.block_count;
 
-    QJsonObject toplevel;
-    Json::writeString(toplevel, "version", "1");
+    // compact once the journal outweighs the snapshot it amends
+    auto journal_size = m_journal_on_disk + m_journal.size();
+    if (m_needs_snapshot || journal_size > qMax<qint64>(MIN_JOURNAL_COMPACTION_SIZE, snapshot_size)) {
+        qCDebug(taskHttpMetaCacheLogC) << "Compacting metacache with" << snapshot_size << "entries and" << journal_size << "journal records";
+        if (writeSnapshot())
+            return;
+    }
+
+    qCDebug(taskHttpMetaCacheLogC) << "Appending" << m_journal.size() << "records to the metacache journal";
+    appendJournal();
+}
+
+auto HttpMetaCache::appendJournal() -> bool
+{
+    QFile index(binaryIndexPath());
+    if (!index.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(taskHttpMetaCacheLogC) << "Error appending to cache journal:" << index.errorString();
+        return false;
+    }
 
-    QJsonArray entriesArr;
-    for (auto group : m_entries) {
-        for (auto entry : group.entry_list) {
+    QByteArray buffer;
+    QDataStream stream(&buffer, QIODevice::WriteOnly);
+    stream.setVersion(BINARY_INDEX_STREAM_VERSION);
+    for (auto& record : m_journal) {
+        // do not save stale entries. they are dead.
+        if (record.entry && !record.entry->m_stale) {
+            stream << JOURNAL_PUT << record.base << record.path;
+            writeEntry(stream, *record.entry);
+        } else {
+            stream << JOURNAL_REMOVE << record.base << record.path;
+        }
+    }
+
+    if (index.write(buffer) != buffer.size()) {
+        qCWarning(taskHttpMetaCacheLogC) << "Error appending to cache journal:" << index.errorString();
+        m_needs_snapshot = true;
+        return false;
+    }
+
+    m_journal_on_disk += m_journal.size();
+    m_journal.clear();
+    return true;
+}
+
+auto HttpMetaCache::writeSnapshot() -> bool
+{
+    loadAll();
+
+    // serialize the blocks first, so we know where each of them ends up
+    QList<QPair<QString, QByteArray>> blocks;
+    QList<quint32> counts;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        QByteArray block;
+        QDataStream stream(&block, QIODevice::WriteOnly);
+        stream.setVersion(BINARY_INDEX_STREAM_VERSION);
+        quint32 count = 0;
+        for (auto& entry : it->entry_list) {
             // do not save stale entries. they are dead.
             if (entry->m_stale) {
                 continue;
             }
+            writeEntry(stream, *entry);
+            count++;
+        }
+        blocks.append(qMakePair(it.key(), block));
+        counts.append(count);
+    }
 
-            QJsonObject entryObj;
-            Json::writeString(entryObj, "base", entry->m_baseId);
-            Json::writeString(entryObj, "path", entry->m_relativePath);
-            Json::writeString(entryObj, "md5sum", entry->m_md5sum);
-            Json::writeString(entryObj, "etag", entry->m_etag);
-            entryObj.insert("last_changed_timestamp", QJsonValue(double(entry->m_local_changed_timestamp)));
-            if (!entry->m_remote_changed_timestamp.isEmpty())
-                entryObj.insert("remote_changed_timestamp", QJsonValue(entry->m_remote_changed_timestamp));
-            if (entry->isEternal()) {
-                entryObj.insert("eternal", true);
-            } else {
-                entryObj.insert("current_age", QJsonValue(double(entry->m_current_age)));
-                entryObj.insert("max_age", QJsonValue(double(entry->m_max_age)));
-            }
-            entriesArr.append(entryObj);
+    auto writeHeader = [&](QDataStream& stream, qint64 first_block_offset) {
+        qint64 offset = first_block_offset;
+        for (auto& block : blocks)
+            offset += block.second.size();
+        stream << BINARY_INDEX_MAGIC << BINARY_INDEX_VERSION << offset << quint32(blocks.size());
+
+        offset = first_block_offset;
+        for (int i = 0; i < blocks.size(); i++) {
+            stream << blocks[i].first << offset << counts[i];
+            offset += blocks[i].second.size();
         }
+    };
+
+    // all header fields are fixed size, so a dry run tells us how large it will be
+    QByteArray header;
+    {
+        QDataStream dry(&header, QIODevice::WriteOnly);
+        dry.setVersion(BINARY_INDEX_STREAM_VERSION);
+        writeHeader(dry, 0);
+    }
+    auto header_size = header.size();
+    header.clear();
+    {
+        QDataStream stream(&header, QIODevice::WriteOnly);
+        stream.setVersion(BINARY_INDEX_STREAM_VERSION);
+        writeHeader(stream, header_size);
     }
-    toplevel.insert("entries", entriesArr);
 
-    try {
-        Json::write(toplevel, m_index_file);
-    } catch (const Exception& e) {
-        qCWarning(taskHttpMetaCacheLogC) << "Error writing cache:" << e.what();
+    QSaveFile index(binaryIndexPath());
+    if (!index.open(QIODevice::WriteOnly)) {
+        qCWarning(taskHttpMetaCacheLogC) << "Error writing cache:" << index.errorString();
+        return false;
+    }
+    index.write(header);
+    for (auto& block : blocks)
+        index.write(block.second);
+    if (!index.commit()) {
+        qCWarning(taskHttpMetaCacheLogC) << "Error writing cache:" << index.errorString();
+        return false;
     }
+
+    m_journal.clear();
+    m_journal_on_disk = 0;
+    m_needs_snapshot = false;
+
+    // the legacy JSON index has been superseded
+    if (QFile::exists(m_index_file))
+        QFile::remove(m_index_file);
+
+    return true;
 }
@@ -35,8 +35,12 @@
 
 #pragma once
 
+#include <QDataStream>
+#include <QFileInfo>
+#include <QHash>
 #include <QMap>
 #include <QString>
+#include <QStringList>
 #include <QTimer>
 #include <memory>
 
@@ -53,6 +57,7 @@ class MetaEntry {
     void setStale(bool stale) { m_stale = stale; }
 
     auto getFullPath() -> QString;
+    auto getRelativePath() -> QString { return m_relativePath; }
 
     auto getRemoteChangedTimestamp() -> QString { return m_remote_changed_timestamp; }
     void setRemoteChangedTimestamp(QString remote_changed_timestamp) { m_remote_changed_timestamp = remote_changed_timestamp; }
@@ -64,6 +69,10 @@ class MetaEntry {
     auto getMD5Sum() -> QString { return m_md5sum; }
     void setMD5Sum(QString md5sum) { m_md5sum = md5sum; }
 
+    /* Digests computed while downloading, by hash type (see Net::MultiChecksumValidator) */
+    auto getHash(const QString& type) -> QString { return m_hashes.value(type); }
+    void setHashes(QHash<QString, QString> hashes) { m_hashes = hashes; }
+
     /* Whether the entry expires after some time (false) or not (true). */
     void makeEternal(bool eternal) { m_is_eternal = eternal; }
     [[nodiscard]] bool isEternal() const { return m_is_eternal; }
@@ -81,6 +90,7 @@ class MetaEntry {
     QString m_basePath;
     QString m_relativePath;
     QString m_md5sum;
+    QHash<QString, QString> m_hashes;
     QString m_etag;
 
     qint64 m_local_changed_timestamp = 0;
@@ -107,6 +117,8 @@ class HttpMetaCache : public QObject {
 
     // get the entry from cache and verify that it isn't stale (within reason)
     auto resolveEntry(QString base, QString resource_path, QString expected_etag = QString()) -> MetaEntryPtr;
+    // same, reusing what is already known about the file instead of looking at it again (if it is the right file)
+    auto resolveEntry(QString base, QString resource_path, const QFileInfo& file_info, QString expected_etag = QString()) -> MetaEntryPtr;
 
     // add a previously resolved stale entry
     auto updateEntry(MetaEntryPtr stale_entry) -> bool;
@@ -114,6 +126,10 @@ class HttpMetaCache : public QObject {
     // evict selected entry from cache
     auto evictEntry(MetaEntryPtr entry) -> bool;
     void evictAll();
+    // forget the entry for a file that was deleted
+    auto removeEntry(QString base, QString resource_path) -> bool;
+    // all entries of the base, stale or not
+    auto getEntries(QString base) -> QList<MetaEntryPtr>;
 
     void addBase(QString base, QString base_root);
 
@@ -122,6 +138,7 @@ class HttpMetaCache : public QObject {
     void Load();
 
     auto getBasePath(QString base) -> QString;
+    auto getBases() const -> QStringList { return m_entries.keys(); }
 
    public slots:
     void SaveNow();
@@ -130,12 +147,48 @@ class HttpMetaCache : public QObject {
     // create a new stale entry, given the parameters
     auto staleEntry(QString base, QString resource_path) -> MetaEntryPtr;
 
+    /* A single change to the index, as it is appended to the on-disk journal. */
+    struct JournalRecord {
+        QString base;
+        QString path;
+        MetaEntryPtr entry;  // null when the record removes the entry
+    };
+
     struct EntryMap {
         QString base_path;
         QMap<QString, MetaEntryPtr> entry_list;
+
+        // Bases are read from the binary index only when they are first accessed
+        bool loaded = true;
+        qint64 block_offset = 0;
+        quint32 block_count = 0;
+        QList<JournalRecord> replay;
     };
 
+    // make sure the entries of the given base are in memory; returns nullptr for unknown bases
+    auto ensureLoaded(const QString& base) -> EntryMap*;
+    void loadAll();
+
+    auto binaryIndexPath() const -> QString;
+    auto loadBinary() -> bool;
+    void loadLegacyJson();
+    auto appendJournal() -> bool;
+    auto writeSnapshot() -> bool;
+
+    void recordPut(MetaEntryPtr entry);
+    void recordRemove(const QString& base, const QString& resource_path);
+
+    static void writeEntry(QDataStream& stream, const MetaEntry& entry);
+    auto readEntry(QDataStream& stream, const QString& base) -> MetaEntryPtr;
+
     QMap<QString, EntryMap> m_entries;
     QString m_index_file;
     QTimer saveBatchingTimer;
+
+    // changes which have not been appended to the journal yet
+    QList<JournalRecord> m_journal;
+    // number of journal records in the index file, past the last snapshot
+    int m_journal_on_disk = 0;
+    // the index file is missing, outdated or in the legacy format and must be rewritten from scratch
+    bool m_needs_snapshot = true;
 };
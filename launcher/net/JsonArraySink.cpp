@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "JsonArraySink.h"
+
+#include <QDebug>
+#include <QJsonDocument>
+
+namespace Net {
+
+void JsonArraySink::reset()
+{
+    m_pending.clear();
+    m_scanned = 0;
+    m_elementStart = 0;
+    m_depth = 0;
+    m_inString = false;
+    m_escape = false;
+    m_complete = false;
+}
+
+auto JsonArraySink::init(QNetworkRequest& request) -> Task::State
+{
+    reset();
+    if (initAllValidators(request))
+        return Task::State::Running;
+    return Task::State::Failed;
+}
+
+auto JsonArraySink::write(QByteArray& data) -> Task::State
+{
+    if (!writeAllValidators(data))
+        return Task::State::Failed;
+
+    QList<QJsonObject> elements;
+    bool ok = feed(data, elements);
+    if (!elements.isEmpty())
+        m_callback(elements);
+    if (!ok) {
+        qWarning() << "Response is not a JSON array of objects";
+        return Task::State::Failed;
+    }
+    return Task::State::Running;
+}
+
+auto JsonArraySink::abort() -> Task::State
+{
+    reset();
+    failAllValidators();
+    return Task::State::Failed;
+}
+
+auto JsonArraySink::finalize(QNetworkReply& reply) -> Task::State
+{
+    if (!m_complete) {
+        qWarning() << "Response ended before its JSON array did";
+        return Task::State::Failed;
+    }
+    if (finalizeAllValidators(reply))
+        return Task::State::Succeeded;
+    return Task::State::Failed;
+}
+
+bool JsonArraySink::feed(const QByteArray& data, QList<QJsonObject>& elements)
+{
+    m_pending.append(data);
+    // everything before this can be dropped once this chunk is looked through
+    int consumed = 0;
+    for (; m_scanned < m_pending.size(); m_scanned++) {
+        char c = m_pending.at(m_scanned);
+        if (m_depth >= 2) {
+            if (m_inString) {
+                if (m_escape)
+                    m_escape = false;
+                else if (c == '\\')
+                    m_escape = true;
+                else if (c == '"')
+                    m_inString = false;
+            } else if (c == '"') {
+                m_inString = true;
+            } else if (c == '{' || c == '[') {
+                m_depth++;
+            } else if ((c == '}' || c == ']') && --m_depth == 1) {
+                QJsonParseError error;
+                auto doc = QJsonDocument::fromJson(m_pending.mid(m_elementStart, m_scanned + 1 - m_elementStart), &error);
+                if (error.error != QJsonParseError::NoError || !doc.isObject())
+                    return false;
+                elements.append(doc.object());
+                consumed = m_scanned + 1;
+            }
+            continue;
+        }
+
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            consumed = m_scanned + 1;
+        } else if (m_complete) {
+            // there's more after the array
+            return false;
+        } else if (m_depth == 0) {
+            if (c != '[')
+                return false;
+            m_depth = 1;
+            consumed = m_scanned + 1;
+        } else if (c == ',') {
+            consumed = m_scanned + 1;
+        } else if (c == ']') {
+            m_depth = 0;
+            m_complete = true;
+            consumed = m_scanned + 1;
+        } else if (c == '{') {
+            m_depth = 2;
+            m_elementStart = m_scanned;
+        } else {
+            return false;
+        }
+    }
+
+    m_pending.remove(0, consumed);
+    m_scanned -= consumed;
+    m_elementStart -= consumed;
+    return true;
+}
+
+}  // namespace Net
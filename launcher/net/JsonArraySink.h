@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+
+#include <functional>
+
+#include "Sink.h"
+
+namespace Net {
+
+/** Sink for responses that are one big JSON array of objects, like the pack lists of some platforms.
+ *
+ *  Each object is handed over as soon as all of it has arrived, instead of once the whole response has, so lists can be
+ *  shown while the rest of them is still downloading. Anything but an array of objects fails the download.
+ */
+class JsonArraySink : public Sink {
+   public:
+    /* Gets the objects that came in with one chunk of the response, in order. */
+    using Callback = std::function<void(const QList<QJsonObject>&)>;
+
+    JsonArraySink(Callback callback) : m_callback(std::move(callback)) {}
+    virtual ~JsonArraySink() = default;
+
+   public:
+    auto init(QNetworkRequest& request) -> Task::State override;
+    auto write(QByteArray& data) -> Task::State override;
+    auto abort() -> Task::State override;
+    auto finalize(QNetworkReply& reply) -> Task::State override;
+
+    auto hasLocalData() -> bool override { return false; }
+
+    /* Goes on with the array, adding the objects completed by data to elements. False if it isn't an array of objects. */
+    bool feed(const QByteArray& data, QList<QJsonObject>& elements);
+    /* Whether the whole array has been read. */
+    bool isComplete() const { return m_complete; }
+
+   private:
+    void reset();
+
+    Callback m_callback;
+
+    // what's left of the response after the last complete object
+    QByteArray m_pending;
+    // how far into m_pending has been looked at, and where the object being read starts in it
+    int m_scanned = 0;
+    int m_elementStart = 0;
+    // 0 before the array, 1 between its objects, deeper within them
+    int m_depth = 0;
+    bool m_inString = false;
+    bool m_escape = false;
+    bool m_complete = false;
+};
+}  // namespace Net
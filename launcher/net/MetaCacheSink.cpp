@@ -38,6 +38,7 @@
 #include <QFileInfo>
 #include <QRegularExpression>
 #include "Application.h"
+#include "Metrics.h"
 
 #include "net/Logging.h"
 
@@ -48,15 +49,16 @@ namespace Net {
  */
 #define MAX_TIME_TO_EXPIRE 1 * 7 * 24 * 60 * 60
 
-MetaCacheSink::MetaCacheSink(MetaEntryPtr entry, ChecksumValidator* md5sum, bool is_eternal)
-    : Net::FileSink(entry->getFullPath()), m_entry(entry), m_md5Node(md5sum), m_is_eternal(is_eternal)
+MetaCacheSink::MetaCacheSink(MetaEntryPtr entry, MultiChecksumValidator* checksums, bool is_eternal)
+    : Net::FileSink(entry->getFullPath()), m_entry(entry), m_checksums(checksums), m_is_eternal(is_eternal)
 {
-    addValidator(md5sum);
+    addValidator(checksums);
 }
 
 Task::State MetaCacheSink::initCache(QNetworkRequest& request)
 {
     if (!m_entry->isStale()) {
+        Metrics::count("metacache.fresh_hits");
         return Task::State::Succeeded;
     }
 
@@ -69,6 +71,9 @@ Task::State MetaCacheSink::initCache(QNetworkRequest& request)
         if (m_entry->getETag().size()) {
             request.setRawHeader(QString("If-None-Match").toLatin1(), m_entry->getETag().toLatin1());
         }
+        Metrics::count("metacache.revalidations");
+    } else {
+        Metrics::count("metacache.misses");
     }
 
     return Task::State::Running;
@@ -79,7 +84,14 @@ Task::State MetaCacheSink::finalizeCache(QNetworkReply& reply)
     QFileInfo output_file_info(m_filename);
 
     if (wroteAnyData) {
-        m_entry->setMD5Sum(m_md5Node->hash().toHex().constData());
+        m_entry->setMD5Sum(m_checksums->hash("md5"));
+        m_entry->setHashes(m_checksums->hashes());
+        Metrics::count("metacache.downloaded");
+        Metrics::count("metacache.downloaded_bytes", output_file_info.size());
+    } else if (reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304) {
+        // what the cache is here for: the server told us our copy is still good
+        Metrics::count("metacache.not_modified");
+        Metrics::count("metacache.saved_bytes", output_file_info.size());
     }
 
     m_entry->setETag(reply.rawHeader("ETag").constData());
@@ -35,14 +35,14 @@
 
 #pragma once
 
-#include "ChecksumValidator.h"
+#include "MultiChecksumValidator.h"
 #include "FileSink.h"
 #include "net/HttpMetaCache.h"
 
 namespace Net {
 class MetaCacheSink : public FileSink {
    public:
-    MetaCacheSink(MetaEntryPtr entry, ChecksumValidator* md5sum, bool is_eternal = false);
+    MetaCacheSink(MetaEntryPtr entry, MultiChecksumValidator* checksums, bool is_eternal = false);
     virtual ~MetaCacheSink() = default;
 
     auto hasLocalData() -> bool override;
@@ -53,7 +53,7 @@ class MetaCacheSink : public FileSink {
 
    private:
     MetaEntryPtr m_entry;
-    ChecksumValidator* m_md5Node;
+    MultiChecksumValidator* m_checksums;
     bool m_is_eternal;
 };
 }  // namespace Net
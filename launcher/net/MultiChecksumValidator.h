@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "CryptoHash.h"
+#include "Validator.h"
+
+#include <MurmurHash2.h>
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QHash>
+#include <QList>
+#include <memory>
+
+namespace Net {
+
+/** Computes several digests of the downloaded data in a single pass.
+ *
+ *  This covers every hash type the mod platforms ask for (see ModPlatform::ProviderCapabilities::hashType),
+ *  named the same way: "md5", "sha1", "sha256", "sha512" and "murmur2" (CurseForge fingerprint).
+ *  Optionally, one of them can be required to match an expected value.
+ */
+class MultiChecksumValidator : public Validator {
+   public:
+    /* murmur2 needs the length of the whitespace-filtered data up front, so we have to buffer it. Don't do that for huge files. */
+    static constexpr qsizetype MAX_MURMUR2_BUFFER = 64 * 1024 * 1024;
+
+    MultiChecksumValidator(QList<QCryptographicHash::Algorithm> algorithms, bool murmur2 = false) : m_murmur2(murmur2)
+    {
+        for (auto algorithm : algorithms)
+            m_digests.append(qMakePair(nameOf(algorithm), std::make_shared<CryptoHash>(algorithm)));
+    }
+    virtual ~MultiChecksumValidator() = default;
+
+    static auto nameOf(QCryptographicHash::Algorithm algorithm) -> QString
+    {
+        switch (algorithm) {
+            case QCryptographicHash::Md5:
+                return "md5";
+            case QCryptographicHash::Sha1:
+                return "sha1";
+            case QCryptographicHash::Sha256:
+                return "sha256";
+            case QCryptographicHash::Sha512:
+                return "sha512";
+            default:
+                return "unknown";
+        }
+    }
+
+   public:
+    auto init(QNetworkRequest&) -> bool override
+    {
+        for (auto& digest : m_digests)
+            digest.second->reset();
+        m_filtered.clear();
+        m_murmur2_overflow = false;
+        m_results.clear();
+        return true;
+    }
+
+    auto write(QByteArray& data) -> bool override
+    {
+        for (auto& digest : m_digests)
+            digest.second->addData(data);
+
+        if (m_murmur2 && !m_murmur2_overflow) {
+            if (m_filtered.size() + data.size() > MAX_MURMUR2_BUFFER) {
+                m_murmur2_overflow = true;
+                m_filtered.clear();
+                m_filtered.squeeze();
+            } else {
+                // CurseForge ignores whitespace when fingerprinting
+                auto offset = m_filtered.size();
+                m_filtered.resize(offset + data.size());
+                auto kept = MurmurFilterWhitespace(data.constData(), data.size(), m_filtered.data() + offset);
+                m_filtered.resize(offset + static_cast<int>(kept));
+            }
+        }
+        return true;
+    }
+
+    auto abort() -> bool override { return true; }
+
+    auto validate(QNetworkReply&) -> bool override
+    {
+        m_results.clear();
+        for (auto& digest : m_digests)
+            m_results.insert(digest.first, QString::fromLatin1(digest.second->result().toHex()));
+        if (m_murmur2 && !m_murmur2_overflow) {
+            m_results.insert("murmur2", QString::number(MurmurHash2(m_filtered.constData(), m_filtered.size())));
+            m_filtered.clear();
+            m_filtered.squeeze();
+        }
+
+        if (!m_expected_type.isEmpty() && m_results.value(m_expected_type) != m_expected) {
+            qWarning() << "Checksum mismatch, download is bad.";
+            return false;
+        }
+        return true;
+    }
+
+    /* Only valid after a successful validation. */
+    auto hash(const QString& type) const -> QString { return m_results.value(type); }
+    auto hashes() const -> QHash<QString, QString> { return m_results; }
+
+    void setExpected(QString type, QString expected)
+    {
+        m_expected_type = type;
+        m_expected = expected.toLower();
+    }
+
+   private:
+    QList<QPair<QString, std::shared_ptr<CryptoHash>>> m_digests;
+    bool m_murmur2;
+    bool m_murmur2_overflow = false;
+    QByteArray m_filtered;
+
+    QHash<QString, QString> m_results;
+    QString m_expected_type;
+    QString m_expected;
+};
+}  // namespace Net
@@ -36,6 +36,13 @@
  */
 
 #include "NetJob.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+#include "Metrics.h"
+#include "net/Logging.h"
 #include "net/NetRequest.h"
 #include "tasks/ConcurrentTask.h"
 #if defined(LAUNCHER_APPLICATION)
@@ -48,6 +55,32 @@ NetJob::NetJob(QString job_name, shared_qobject_ptr<QNetworkAccessManager> netwo
 #if defined(LAUNCHER_APPLICATION)
     setMaxConcurrent(APPLICATION->settings()->get("NumberOfConcurrentDownloads").toInt());
 #endif
+    // jobs can hold thousands of downloads, there's no need to keep the finished ones around
+    setKeepSucceededTasks(false);
+}
+
+struct NetJob::SharedPool {
+    QMutex mutex;
+    QHash<QString, HostState> hosts;
+    // requests running across all the jobs
+    int running = 0;
+    // jobs that still have requests queued, and may be able to start them once a slot frees up
+    QSet<NetJob*> waiting;
+};
+
+auto NetJob::sharedPool() -> SharedPool&
+{
+    static SharedPool s_pool;
+    return s_pool;
+}
+
+NetJob::~NetJob()
+{
+    auto& pool = sharedPool();
+    QMutexLocker locker(&pool.mutex);
+    pool.waiting.remove(this);
+    for (auto const& request : m_active)
+        releaseRequest(request);
 }
 
 auto NetJob::addNetAction(Net::NetRequest::Ptr action) -> bool
@@ -68,14 +101,138 @@ void NetJob::executeNextSubTask()
             auto task = m_failed.take(*m_failed.keyBegin());
             m_done.remove(task.get());
             m_queue.enqueue(task);
+            Metrics::count("net.retries");
+        }
+    }
+
+    if (!isRunning() || m_queue.isEmpty()) {
+        ConcurrentTask::executeNextSubTask();
+        return;
+    }
+
+    // start as many requests as the global and per-host limits allow, counting the other jobs' requests too
+    QList<Task::Ptr> to_start;
+    {
+        auto& pool = sharedPool();
+        QMutexLocker locker(&pool.mutex);
+        while (m_doing.count() + to_start.size() < m_total_max_size && pool.running < m_total_max_size) {
+            auto next = takeNextSchedulable();
+            if (!next)
+                break;
+
+            auto host = hostOf(next);
+            hostState(host).running++;
+            pool.running++;
+
+            ActiveRequest request{ host, {} };
+            request.timer.start();
+            m_active.insert(next.get(), request);
+
+            to_start.append(next);
+        }
+
+        if (m_queue.isEmpty())
+            pool.waiting.remove(this);
+        else
+            pool.waiting.insert(this);
+    }
+
+    for (auto const& next : to_start)
+        startSubTask(next);
+}
+
+void NetJob::subTaskFinished(Task::Ptr task, TaskStepState state)
+{
+    if (m_active.contains(task.get())) {
+        QMutexLocker locker(&sharedPool().mutex);
+        auto request = m_active.take(task.get());
+        adjustHostLimit(hostState(request.host), task, request, state);
+        releaseRequest(request);
+    }
+
+    ConcurrentTask::subTaskFinished(task, state);
+}
+
+void NetJob::releaseRequest(const ActiveRequest& request)
+{
+    auto& pool = sharedPool();
+    hostState(request.host).running--;
+    pool.running--;
+
+    for (auto job : pool.waiting) {
+        if (job != this)
+            QMetaObject::invokeMethod(job, &NetJob::executeNextSubTask, Qt::QueuedConnection);
+    }
+}
+
+auto NetJob::hostOf(const Task::Ptr& task) -> QString
+{
+    auto request = dynamic_cast<Net::NetRequest*>(task.get());
+    if (!request)
+        return {};
+    return request->url().host().toLower();
+}
+
+auto NetJob::hostState(const QString& host) -> HostState&
+{
+    auto& hosts = sharedPool().hosts;
+    auto it = hosts.find(host);
+    if (it == hosts.end()) {
+        HostState state;
+        // start at half of the global limit, and let the host prove it can take more
+        state.limit = qMax(1, m_total_max_size / 2);
+        it = hosts.insert(host, state);
+    }
+    return it.value();
+}
+
+auto NetJob::takeNextSchedulable() -> Task::Ptr
+{
+    for (auto i = 0; i < m_queue.size(); i++) {
+        auto& state = hostState(hostOf(m_queue.at(i)));
+        if (state.running < state.limit)
+            return m_queue.takeAt(i);
+    }
+    return nullptr;
+}
+
+void NetJob::adjustHostLimit(HostState& state, const Task::Ptr& task, const ActiveRequest& request, TaskStepState result)
+{
+    if (result == TaskStepState::Failed) {
+        auto net_request = dynamic_cast<Net::NetRequest*>(task.get());
+        auto status_code = net_request ? net_request->replyStatusCode() : -1;
+        if (status_code == 429 || status_code == 503) {
+            state.limit = qMax(1, state.limit / 2);
+            state.completed_in_round = 0;
+            state.last_aggregate_throughput = 0.;
+            qCDebug(taskNetLogC) << "Host" << request.host << "asked us to back off (HTTP" << status_code << "), limiting it to"
+                                 << state.limit << "concurrent requests";
         }
+        return;
+    }
+
+    auto elapsed_ms = qMax<qint64>(1, request.timer.elapsed());
+    auto sample = static_cast<double>(qMax<qint64>(0, task->getProgress())) * 1000. / elapsed_ms;
+    state.request_throughput = state.request_throughput > 0. ? 0.7 * state.request_throughput + 0.3 * sample : sample;
+
+    // only re-evaluate once per "round", i.e. after as many completions as there are slots
+    if (++state.completed_in_round < state.limit)
+        return;
+    state.completed_in_round = 0;
+
+    auto aggregate = state.request_throughput * state.limit;
+    if (aggregate >= state.last_aggregate_throughput * 1.05) {
+        if (state.limit < m_total_max_size)
+            state.limit++;
+    } else if (aggregate < state.last_aggregate_throughput * 0.8 && state.limit > 1) {
+        state.limit--;
     }
-    ConcurrentTask::executeNextSubTask();
+    state.last_aggregate_throughput = aggregate;
 }
 
 auto NetJob::size() const -> int
 {
-    return m_queue.size() + m_doing.size() + m_done.size();
+    return m_queue.size() + m_doing.size() + doneCount();
 }
 
 auto NetJob::canAbort() const -> bool
@@ -136,9 +293,9 @@ auto NetJob::getFailedFiles() -> QList<QString>
 
 void NetJob::updateState()
 {
-    emit progress(m_done.count(), totalSize());
+    emit progress(doneCount(), totalSize());
     setStatus(tr("Executing %1 task(s) (%2 out of %3 are done)")
-                  .arg(QString::number(m_doing.count()), QString::number(m_done.count()), QString::number(totalSize())));
+                  .arg(QString::number(m_doing.count()), QString::number(doneCount()), QString::number(totalSize())));
 }
 
 void NetJob::emitFailed(QString reason)
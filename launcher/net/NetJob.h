@@ -38,6 +38,8 @@
 
 #include <QtNetwork>
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QObject>
 #include "net/NetRequest.h"
 #include "tasks/ConcurrentTask.h"
@@ -53,7 +55,7 @@ class NetJob : public ConcurrentTask {
     using Ptr = shared_qobject_ptr<NetJob>;
 
     explicit NetJob(QString job_name, shared_qobject_ptr<QNetworkAccessManager> network);
-    ~NetJob() override = default;
+    ~NetJob() override;
 
     auto size() const -> int;
 
@@ -70,12 +72,53 @@ class NetJob : public ConcurrentTask {
 
    protected slots:
     void executeNextSubTask() override;
+    void subTaskFinished(Task::Ptr, TaskStepState) override;
 
    protected:
     void updateState() override;
 
+   private:
+    /** Scheduling state of a single remote host.
+     *
+     *  Each host gets its own concurrency limit, which is adjusted with an additive-increase /
+     *  multiplicative-decrease policy: the limit grows while adding connections still improves the
+     *  aggregate throughput we observe from that host, shrinks again when it stops paying off, and
+     *  is halved when the host tells us to back off (HTTP 429 / 503).
+     */
+    struct HostState {
+        int running = 0;
+        int limit = 1;
+        int completed_in_round = 0;
+        double request_throughput = 0.;  // EWMA of per-request throughput, in bytes per second
+        double last_aggregate_throughput = 0.;
+    };
+
+    struct ActiveRequest {
+        QString host;
+        QElapsedTimer timer;
+    };
+
+    /** What all the jobs share: the host states, and how many requests run across all of them.
+     *  Jobs that run side by side (e.g. libraries and assets) are scheduled as one pool.
+     */
+    struct SharedPool;
+    static auto sharedPool() -> SharedPool&;
+
+    static auto hostOf(const Task::Ptr& task) -> QString;
+
+    // NOTE: the functions below must be called with the shared pool's mutex held
+
+    // Takes the first queued request whose host still has a free slot, or nullptr if there is none.
+    auto takeNextSchedulable() -> Task::Ptr;
+    auto hostState(const QString& host) -> HostState&;
+    void adjustHostLimit(HostState& state, const Task::Ptr& task, const ActiveRequest& request, TaskStepState result);
+    // Gives the request's slots back, and lets the jobs waiting for one know.
+    void releaseRequest(const ActiveRequest& request);
+
    private:
     shared_qobject_ptr<QNetworkAccessManager> m_network;
 
+    QHash<Task*, ActiveRequest> m_active;
+
     int m_try = 1;
 };
@@ -40,20 +40,166 @@
 
 #include <QDateTime>
 #include <QFileInfo>
+#include <QMutex>
 #include <QNetworkReply>
+#include <QSet>
 #include <QUrl>
+#include <algorithm>
 #include <memory>
 
 #if defined(LAUNCHER_APPLICATION)
 #include "Application.h"
+#include "net/ConnectionPrewarmer.h"
+#include "net/PeerCache.h"
 #endif
 #include "BuildConfig.h"
 
 #include "MMCTime.h"
+#include "Metrics.h"
 #include "StringUtils.h"
+#include "Tracing.h"
+#include "tasks/CpuExecutor.h"
 
 namespace Net {
 
+namespace {
+/** Hosts which failed to talk HTTP/2 to us during this session.
+ *  Requests to them go over HTTP/1.1 until the launcher is restarted.
+ */
+QSet<QString> s_http1_only_hosts;
+QMutex s_http1_only_hosts_mutex;
+
+bool http2Enabled()
+{
+#if defined(LAUNCHER_APPLICATION)
+    return APPLICATION->settings()->get("UseHttp2").toBool();
+#else
+    return false;
+#endif
+}
+
+bool hostAllowsHttp2(const QString& host)
+{
+    QMutexLocker locker(&s_http1_only_hosts_mutex);
+    return !s_http1_only_hosts.contains(host);
+}
+
+void markHostHttp1Only(const QString& host)
+{
+    QMutexLocker locker(&s_http1_only_hosts_mutex);
+    s_http1_only_hosts.insert(host);
+}
+
+// Errors that hint at a broken HTTP/2 implementation (on either side, or in some middlebox), rather than at the resource itself
+bool isTransportFailure(QNetworkReply::NetworkError error)
+{
+    switch (error) {
+        case QNetworkReply::ProtocolFailure:
+        case QNetworkReply::ProtocolUnknownError:
+        case QNetworkReply::RemoteHostClosedError:
+        case QNetworkReply::UnknownNetworkError:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// peers are on the local network, one that takes this long to send anything isn't worth waiting for
+constexpr int PEER_TRANSFER_TIMEOUT_MS = 5000;
+
+/** How long hosts recently took to answer, in milliseconds.
+ *  A request to a mirror is sent once a host is slower than it was for all but a few of these.
+ */
+QHash<QString, QList<qint64>> s_response_times;
+QMutex s_response_times_mutex;
+
+constexpr int MAX_RESPONSE_TIME_SAMPLES = 64;
+constexpr int MIN_RESPONSE_TIME_SAMPLES = 8;
+constexpr int HEDGE_PERCENTILE = 95;
+constexpr qint64 DEFAULT_HEDGE_DELAY_MS = 2000;
+constexpr qint64 MIN_HEDGE_DELAY_MS = 250;
+constexpr qint64 MAX_HEDGE_DELAY_MS = 10000;
+
+void recordResponseTime(const QString& host, qint64 ms)
+{
+    QMutexLocker locker(&s_response_times_mutex);
+    auto& samples = s_response_times[host];
+    samples.append(ms);
+    if (samples.size() > MAX_RESPONSE_TIME_SAMPLES)
+        samples.removeFirst();
+}
+
+qint64 hedgeDelay(const QString& host)
+{
+    QMutexLocker locker(&s_response_times_mutex);
+    auto samples = s_response_times.value(host);
+    if (samples.size() < MIN_RESPONSE_TIME_SAMPLES)
+        return DEFAULT_HEDGE_DELAY_MS;
+    std::sort(samples.begin(), samples.end());
+    auto percentile = samples[qMin<int>(samples.size() - 1, samples.size() * HEDGE_PERCENTILE / 100)];
+    return qBound(MIN_HEDGE_DELAY_MS, percentile, MAX_HEDGE_DELAY_MS);
+}
+
+/** The bandwidth all bulk transfers share, as a token bucket, and the interactive requests they wait for.
+ *  An interactive request only makes them wait for so long, so a slow one doesn't stall an install.
+ */
+QMutex s_bulk_mutex;
+double s_bulk_tokens = 0;
+QElapsedTimer s_bulk_refilled;
+int s_interactive_requests = 0;
+
+constexpr int INTERACTIVE_PRECEDENCE_MS = 2000;
+constexpr double BULK_BURST_SECS = 0.25;
+constexpr int BULK_RETRY_MS = 50;
+// what Qt buffers of a bulk transfer before it stops reading from the socket, and the sender has to slow down
+constexpr qint64 BULK_READ_BUFFER_SIZE = 256 * 1024;
+
+// in bytes per second, 0 if there is no limit
+qint64 bulkRate()
+{
+#if defined(LAUNCHER_APPLICATION)
+    auto settings = APPLICATION->settings();
+    QList<qint64> limits{ settings->get("BulkDownloadLimit").toLongLong() };
+    if (CpuExecutor::gameRunning())
+        limits.append(settings->get("BulkDownloadLimitWhileGaming").toLongLong());
+    qint64 rate = 0;
+    for (auto limit : limits) {
+        if (limit > 0 && (rate == 0 || limit * 1024 < rate))
+            rate = limit * 1024;
+    }
+    return rate;
+#else
+    return 0;
+#endif
+}
+
+/* How many of the 'wanted' bytes a bulk transfer may read right now. */
+qint64 takeBulkBandwidth(qint64 wanted)
+{
+    QMutexLocker locker(&s_bulk_mutex);
+    if (s_interactive_requests > 0)
+        return 0;
+    auto rate = bulkRate();
+    if (rate <= 0)
+        return wanted;
+
+    auto burst = rate * BULK_BURST_SECS;
+    if (!s_bulk_refilled.isValid()) {
+        s_bulk_refilled.start();
+        s_bulk_tokens = burst;
+    }
+    s_bulk_tokens = qMin(burst, s_bulk_tokens + rate * s_bulk_refilled.restart() / 1000.0);
+    auto granted = qMin(wanted, static_cast<qint64>(s_bulk_tokens));
+    s_bulk_tokens -= granted;
+    return granted;
+}
+}  // namespace
+
+NetRequest::~NetRequest()
+{
+    releasePrecedence();
+}
+
 void NetRequest::addValidator(Validator* v)
 {
     m_sink->addValidator(v);
@@ -63,6 +209,16 @@ void NetRequest::executeTask()
 {
     init();
 
+    if (!m_request_timer.isValid())
+        m_request_timer.start();
+    connect(this, &Task::finished, this, &NetRequest::reportFinished, Qt::UniqueConnection);
+
+    if (Tracing::isEnabled()) {
+        m_trace_start = Tracing::now();
+        m_trace_encrypted = -1;
+        m_trace_first_byte = -1;
+    }
+
     setStatus(tr("Requesting %1").arg(StringUtils::truncateUrlHumanFriendly(m_url, 80)));
 
     if (getState() == Task::State::AbortedByUser) {
@@ -94,6 +250,8 @@ void NetRequest::executeTask()
             return;
     }
 
+    choosePeer(request);
+
 #if defined(LAUNCHER_APPLICATION)
     auto user_agent = APPLICATION->getUserAgent();
 #else
@@ -106,16 +264,60 @@ void NetRequest::executeTask()
     }
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
-    request.setTransferTimeout();
+    request.setTransferTimeout(m_peer_attempt ? PEER_TRANSFER_TIMEOUT_MS : QNetworkRequest::DefaultTransferTimeoutConstant);
 #endif
 
+    // HTTP/2 lets many small requests to the same host share a single multiplexed connection
+    m_http2_attempted = http2Enabled() && m_url.scheme() == "https" && hostAllowsHttp2(m_url.host());
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, m_http2_attempted);
+
+    switch (m_priority) {
+        case Priority::Interactive:
+            request.setPriority(QNetworkRequest::HighPriority);
+            if (!m_holds_precedence) {
+                m_holds_precedence = true;
+                QMutexLocker locker(&s_bulk_mutex);
+                s_interactive_requests++;
+            }
+            QTimer::singleShot(INTERACTIVE_PRECEDENCE_MS, this, &NetRequest::releasePrecedence);
+            break;
+        case Priority::Bulk:
+            request.setPriority(QNetworkRequest::LowPriority);
+            m_throttle_timer.setSingleShot(true);
+            connect(&m_throttle_timer, &QTimer::timeout, this, &NetRequest::downloadReadyRead, Qt::UniqueConnection);
+            break;
+        case Priority::Normal:
+            break;
+    }
+
     m_last_progress_time = m_clock.now();
     m_last_progress_bytes = 0;
 
+    dropHedge();
+    m_headers_seen = false;
+    m_attempt_timer.start();
+
     auto rep = getReply(request);
     if (rep == nullptr)  // it failed
         return;
     m_reply.reset(rep);
+    if (m_priority == Priority::Bulk)
+        rep->setReadBufferSize(BULK_READ_BUFFER_SIZE);
+    connectReply(rep);
+
+    // race the mirrors against a source that is slow to answer, as long as what they send can be checked
+    QCryptographicHash::Algorithm algorithm;
+    QByteArray hash;
+    if (!m_mirrors.isEmpty() && !m_peer_attempt && m_sink->expectedHash(algorithm, hash)) {
+        m_hedge_request = request;
+        m_hedge_timer.setSingleShot(true);
+        connect(&m_hedge_timer, &QTimer::timeout, this, &NetRequest::startHedge, Qt::UniqueConnection);
+        m_hedge_timer.start(static_cast<int>(hedgeDelay(m_url.host())));
+    }
+}
+
+void NetRequest::connectReply(QNetworkReply* rep)
+{
     connect(rep, &QNetworkReply::uploadProgress, this, &NetRequest::onProgress);
     connect(rep, &QNetworkReply::downloadProgress, this, &NetRequest::onProgress);
     connect(rep, &QNetworkReply::finished, this, &NetRequest::downloadFinished);
@@ -126,6 +328,9 @@ void NetRequest::executeTask()
 #endif
     connect(rep, &QNetworkReply::sslErrors, this, &NetRequest::sslErrors);
     connect(rep, &QNetworkReply::readyRead, this, &NetRequest::downloadReadyRead);
+    connect(rep, &QNetworkReply::metaDataChanged, this, &NetRequest::downloadHeadersReceived);
+    if (Tracing::isEnabled())
+        connect(rep, &QNetworkReply::encrypted, this, [this] { m_trace_encrypted = Tracing::now(); });
 }
 
 void NetRequest::onProgress(qint64 bytesReceived, qint64 bytesTotal)
@@ -160,6 +365,7 @@ void NetRequest::onProgress(qint64 bytesReceived, qint64 bytesTotal)
 
 void NetRequest::downloadError(QNetworkReply::NetworkError error)
 {
+    m_throttle_timer.stop();
     if (error == QNetworkReply::OperationCanceledError) {
         qCCritical(logCat) << getUid().toString() << "Aborted " << m_url.toString();
         m_state = State::Failed;
@@ -238,19 +444,184 @@ auto NetRequest::handleRedirect() -> bool
 
     m_url = QUrl(redirect.toString());
     qCDebug(logCat) << getUid().toString() << "Following redirect to " << m_url.toString();
+    Metrics::count("net.redirects");
+    executeTask();
+
+    return true;
+}
+
+auto NetRequest::handleHttp2Fallback() -> bool
+{
+    if (!m_http2_attempted || m_state != State::Failed || !isTransportFailure(m_reply->error()))
+        return false;
+
+    qCWarning(logCat) << getUid().toString() << "Request over HTTP/2 failed with" << m_reply->error() << "; falling back to HTTP/1.1 for"
+                      << m_url.host();
+    markHostHttp1Only(m_url.host());
+    m_sink->abort();
+    Metrics::count("net.http2_fallbacks");
+    executeTask();
+
+    return true;
+}
+
+void NetRequest::choosePeer(QNetworkRequest& request)
+{
+#if defined(LAUNCHER_APPLICATION)
+    if (!m_peers_chosen) {
+        m_peers_chosen = true;
+        auto peers = APPLICATION->peerCache();
+        QCryptographicHash::Algorithm algorithm;
+        QByteArray hash;
+        // only whole files are asked for, and only ones whose hash is checked
+        if (peers && !m_sink->hasLocalData() && !request.hasRawHeader("Range") && m_sink->expectedHash(algorithm, hash)) {
+            m_origin_url = m_url;
+            m_peer_urls = peers->urlsFor(algorithm, hash);
+        }
+    }
+
+    if (!m_peer_urls.isEmpty()) {
+        m_peer_attempt = true;
+        m_url = m_peer_urls.takeFirst();
+    } else if (m_peer_attempt) {
+        // this also drops redirects peers send, they have nothing to redirect to
+        m_peer_attempt = false;
+        m_url = m_origin_url;
+    }
+    m_sink->setUntrustedSource(m_peer_attempt);
+    request.setUrl(m_url);
+#else
+    Q_UNUSED(request)
+#endif
+}
+
+auto NetRequest::handlePeerFallback() -> bool
+{
+#if defined(LAUNCHER_APPLICATION)
+    if (!m_peer_attempt)
+        return false;
+
+    // not having the file is fine, not answering isn't
+    auto error = m_reply->error();
+    if (error != QNetworkReply::NoError && error != QNetworkReply::ContentNotFoundError) {
+        if (auto peers = APPLICATION->peerCache())
+            peers->peerFailed(m_url);
+    }
+    qCDebug(logCat) << getUid().toString() << "Peer" << m_url.host() << "did not provide the file, trying the next source";
+    Metrics::count("net.peer_cache.misses");
+    m_sink->abort();
     executeTask();
 
     return true;
+#else
+    return false;
+#endif
+}
+
+void NetRequest::startHedge()
+{
+    if (m_headers_seen || m_hedge || m_mirrors.isEmpty() || !isRunning())
+        return;
+
+    auto mirror = m_mirrors.takeFirst();
+    qCDebug(logCat) << getUid().toString() << m_url.host() << "is slow to answer, asking" << mirror.toString() << "as well";
+    Metrics::count("net.hedged_requests");
+    m_hedge_request.setUrl(mirror);
+    m_hedge_request.setAttribute(QNetworkRequest::Http2AllowedAttribute,
+                                 http2Enabled() && mirror.scheme() == "https" && hostAllowsHttp2(mirror.host()));
+
+    auto rep = getReply(m_hedge_request);
+    if (rep == nullptr)
+        return;
+    m_hedge.reset(rep);
+    if (m_priority == Priority::Bulk)
+        rep->setReadBufferSize(BULK_READ_BUFFER_SIZE);
+    connect(rep, &QNetworkReply::metaDataChanged, this, &NetRequest::hedgeHeadersReceived);
+    // one that fails before it answers is simply forgotten
+    connect(rep, &QNetworkReply::finished, this, &NetRequest::dropHedge);
+}
+
+void NetRequest::hedgeHeadersReceived()
+{
+    if (!m_hedge)
+        return;
+    auto status = m_hedge->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (m_headers_seen || status < 200 || status >= 300) {
+        dropHedge();
+        return;
+    }
+
+    qCDebug(logCat) << getUid().toString() << "Mirror" << m_hedge->url().host() << "answered before" << m_url.host();
+    Metrics::count("net.hedged_requests.won");
+    recordResponseTime(m_hedge->url().host(), m_attempt_timer.elapsed());
+
+    // nothing was written into the sink yet, so it can just as well take the mirror's data
+    disconnect(m_reply.get(), nullptr, this, nullptr);
+    m_reply->abort();
+    auto rep = m_hedge.take();
+    disconnect(rep, nullptr, this, nullptr);
+    m_reply.reset(rep);
+    m_url = rep->url();
+    m_http2_attempted = m_hedge_request.attribute(QNetworkRequest::Http2AllowedAttribute).toBool();
+    m_sink->setUntrustedSource(true);
+    connectReply(rep);
+
+    downloadHeadersReceived();
+    if (rep->bytesAvailable() > 0)
+        downloadReadyRead();
+    if (rep->isFinished())
+        downloadFinished();
+}
+
+void NetRequest::releasePrecedence()
+{
+    if (!m_holds_precedence)
+        return;
+    m_holds_precedence = false;
+    QMutexLocker locker(&s_bulk_mutex);
+    s_interactive_requests--;
+}
+
+void NetRequest::dropHedge()
+{
+    m_hedge_timer.stop();
+    if (!m_hedge)
+        return;
+    disconnect(m_hedge.get(), nullptr, this, nullptr);
+    m_hedge->abort();
+    m_hedge.reset();
 }
 
 void NetRequest::downloadFinished()
 {
+    dropHedge();
+    releasePrecedence();
+    m_throttle_timer.stop();
+
     // handle HTTP redirection first
     if (handleRedirect()) {
         qCDebug(logCat) << getUid().toString() << "Request redirected:" << m_url.toString();
         return;
     }
 
+    // then retry over HTTP/1.1 if HTTP/2 broke down
+    if (handleHttp2Fallback()) {
+        return;
+    }
+
+    // a peer that doesn't have the file leaves it to the next one, or the actual source
+    if (m_state == State::Failed && handlePeerFallback()) {
+        return;
+    }
+
+    if (m_state == State::Failed && handleFallback()) {
+        return;
+    }
+
+    if (m_http2_attempted) {
+        qCDebug(logCat) << getUid().toString() << "HTTP/2 used:" << m_reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+    }
+
     // if the download failed before this point ...
     if (m_state == State::Succeeded)  // pretend to succeed so we continue processing :)
     {
@@ -289,6 +660,10 @@ void NetRequest::downloadFinished()
 
     // otherwise, finalize the whole graph
     m_state = m_sink->finalize(*m_reply.get());
+    // including one that sent something else
+    if (m_state != State::Succeeded && handlePeerFallback()) {
+        return;
+    }
     if (m_state != State::Succeeded) {
         qCDebug(logCat) << getUid().toString() << "Request failed to finalize:" << m_url.toString();
         m_sink->abort();
@@ -297,6 +672,8 @@ void NetRequest::downloadFinished()
         return;
     }
 
+    if (m_peer_attempt)
+        Metrics::count("net.peer_cache.hits");
     qCDebug(logCat) << getUid().toString() << "Request succeeded:" << m_url.toString();
     emit succeeded();
     emit finished();
@@ -305,7 +682,14 @@ void NetRequest::downloadFinished()
 void NetRequest::downloadReadyRead()
 {
     if (m_state == State::Running) {
-        auto data = m_reply->readAll();
+        // bulk transfers read what they are allowed to, the rest waits in the reply's buffer
+        auto available = m_reply->bytesAvailable();
+        auto allowed = m_priority == Priority::Bulk ? takeBulkBandwidth(available) : available;
+        if (allowed < available && !m_throttle_timer.isActive())
+            m_throttle_timer.start(BULK_RETRY_MS);
+        if (allowed <= 0)
+            return;
+        auto data = m_reply->read(allowed);
         m_state = m_sink->write(data);
         if (m_state == State::Failed) {
             qCCritical(logCat) << getUid().toString() << "Failed to process response chunk";
@@ -316,9 +700,88 @@ void NetRequest::downloadReadyRead()
     }
 }
 
+void NetRequest::downloadHeadersReceived()
+{
+    if (m_trace_first_byte < 0 && Tracing::isEnabled())
+        m_trace_first_byte = Tracing::now();
+
+    // whoever answers first gets the request, a slow answer is still an answer
+    if (!m_headers_seen) {
+        m_headers_seen = true;
+        dropHedge();
+        recordResponseTime(m_url.host(), m_attempt_timer.elapsed());
+#if defined(LAUNCHER_APPLICATION)
+        if (auto prewarmer = APPLICATION->connectionPrewarmer())
+            prewarmer->hostUsed(m_url.host());
+#endif
+    }
+
+    if (m_state != State::Running)
+        return;
+
+    m_state = m_sink->headersReceived(*m_reply);
+    if (m_state == State::Failed) {
+        qCCritical(logCat) << getUid().toString() << "Failed to process response headers";
+    }
+}
+
+void NetRequest::reportFinished()
+{
+    QString result;
+    switch (m_state) {
+        case State::Succeeded:
+            result = "succeeded";
+            break;
+        case State::AbortedByUser:
+            result = "aborted";
+            break;
+        default:
+            result = "failed";
+            break;
+    }
+
+    auto elapsed_ms = m_request_timer.isValid() ? m_request_timer.elapsed() : 0;
+    m_request_timer.invalidate();
+
+    Metrics::count("net.requests." + result);
+    if (!m_reply) {
+        // answered by the sink without going to the network, e.g. a fresh cache entry
+        Metrics::count("net.requests.served_locally");
+    } else {
+        auto host = "net.host." + m_url.host().toLower();
+        Metrics::count(host + ".requests");
+        if (m_state != State::Succeeded)
+            Metrics::count(host + ".failures");
+        Metrics::count(host + ".bytes", getProgress());
+        Metrics::observe(host + ".duration_ms", elapsed_ms);
+        if (m_state == State::Succeeded && elapsed_ms > 0 && getProgress() > 0)
+            Metrics::observe(host + ".throughput_kib_per_s", getProgress() / 1024. * 1000. / elapsed_ms);
+    }
+
+    if (!Tracing::isEnabled())
+        return;
+
+    // Qt doesn't tell us about name resolution or connecting, so the time to the first byte includes them
+    QJsonObject args{ { "url", m_url.toString() }, { "result", result }, { "status", replyStatusCode() }, { "bytes", getProgress() } };
+    if (m_reply)
+        args["http2"] = m_reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+    if (m_trace_start >= 0) {
+        if (m_trace_encrypted >= 0)
+            args["tls_done_ms"] = (m_trace_encrypted - m_trace_start) / 1000.;
+        if (m_trace_first_byte >= 0)
+            args["ttfb_ms"] = (m_trace_first_byte - m_trace_start) / 1000.;
+        Tracing::complete("net", m_url.host() + m_url.path(), m_trace_start, Tracing::now() - m_trace_start, args);
+    }
+
+    // requests report their outcome by themselves, so this is what closes their task span
+    Tracing::end("task", traceName(), getUid().toString(QUuid::WithoutBraces), { { "result", result } });
+}
+
 auto NetRequest::abort() -> bool
 {
     m_state = State::AbortedByUser;
+    dropHedge();
+    m_throttle_timer.stop();
     if (m_reply) {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)  // QNetworkReply::errorOccurred added in 5.15
         disconnect(m_reply.get(), &QNetworkReply::errorOccurred, nullptr, nullptr);
@@ -335,6 +798,11 @@ int NetRequest::replyStatusCode() const
     return m_reply ? m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() : -1;
 }
 
+QByteArray NetRequest::replyHeader(const QByteArray& name) const
+{
+    return m_reply ? m_reply->rawHeader(name) : QByteArray();
+}
+
 QNetworkReply::NetworkError NetRequest::error() const
 {
     return m_reply ? m_reply->error() : QNetworkReply::NoError;
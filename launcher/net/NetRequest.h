@@ -39,7 +39,9 @@
 #pragma once
 
 #include <qloggingcategory.h>
+#include <QElapsedTimer>
 #include <QNetworkReply>
+#include <QTimer>
 #include <QUrl>
 #include <chrono>
 
@@ -61,26 +63,45 @@ class NetRequest : public Task {
     using Ptr = shared_qobject_ptr<class NetRequest>;
     enum class Option { NoOptions = 0, AcceptLocalFiles = 1, MakeEternal = 2 };
     Q_DECLARE_FLAGS(Options, Option)
+    /** How a request competes with the others for the network.
+     *  Interactive ones are what the user waits on, bulk transfers are rate limited and give way to them.
+     */
+    enum class Priority { Interactive, Normal, Bulk };
 
    public:
-    ~NetRequest() override = default;
+    ~NetRequest() override;
     void addValidator(Validator* v);
     auto abort() -> bool override;
     auto canAbort() const -> bool override { return true; }
 
     void setNetwork(shared_qobject_ptr<QNetworkAccessManager> network) { m_network = network; }
+    /// other places to get the same data from, asked as well when the URL is slower than usual to answer
+    void setMirrors(QList<QUrl> mirrors) { m_mirrors = std::move(mirrors); }
+    void setPriority(Priority priority) { m_priority = priority; }
     void addHeaderProxy(Net::HeaderProxy* proxy) { m_headerProxies.push_back(std::shared_ptr<Net::HeaderProxy>(proxy)); }
 
     virtual void init() {}
 
     QUrl url() const;
     int replyStatusCode() const;
+    QByteArray replyHeader(const QByteArray& name) const;
     QNetworkReply::NetworkError error() const;
     QString errorString() const;
 
    private:
     auto handleRedirect() -> bool;
+    auto handleHttp2Fallback() -> bool;
+    /// picks where the next attempt goes to: a peer that may have the file, or the actual source
+    void choosePeer(QNetworkRequest& request);
+    auto handlePeerFallback() -> bool;
+    void connectReply(QNetworkReply* reply);
+    void startHedge();
+    void hedgeHeadersReceived();
+    void dropHedge();
+    void releasePrecedence();
     virtual QNetworkReply* getReply(QNetworkRequest&) = 0;
+    /// lets a subclass retry a failed request in a different way, returns true if it did
+    virtual auto handleFallback() -> bool { return false; }
 
    protected slots:
     void onProgress(qint64 bytesReceived, qint64 bytesTotal);
@@ -88,8 +109,13 @@ class NetRequest : public Task {
     void sslErrors(const QList<QSslError>& errors);
     void downloadFinished();
     void downloadReadyRead();
+    void downloadHeadersReceived();
     void executeTask() override;
 
+   private slots:
+    // reports the finished request to the metrics, and the trace if there is one
+    void reportFinished();
+
    protected:
     std::unique_ptr<Sink> m_sink;
     Options m_options;
@@ -108,6 +134,37 @@ class NetRequest : public Task {
 
     /// source URL
     QUrl m_url;
+
+    /// peers to ask for the file before its actual source, and that source
+    QList<QUrl> m_peer_urls;
+    QUrl m_origin_url;
+    bool m_peers_chosen = false;
+    bool m_peer_attempt = false;
+
+    /// mirrors not raced against the URL yet, and the request to the one that is
+    QList<QUrl> m_mirrors;
+    QNetworkRequest m_hedge_request;
+    unique_qobject_ptr<QNetworkReply> m_hedge;
+    QTimer m_hedge_timer;
+    QElapsedTimer m_attempt_timer;
+    bool m_headers_seen = false;
+
+    Priority m_priority = Priority::Normal;
+    /// an interactive request makes bulk transfers wait while it holds this
+    bool m_holds_precedence = false;
+    /// reads what a bulk transfer was not allowed to read yet
+    QTimer m_throttle_timer;
+
+    /// whether the current attempt allowed Qt to negotiate HTTP/2
+    bool m_http2_attempted = false;
+
+    /// when the current attempt started, finished its TLS handshake and got its response headers, as given by Tracing::now()
+    qint64 m_trace_start = -1;
+    qint64 m_trace_encrypted = -1;
+    qint64 m_trace_first_byte = -1;
+
+    /// since the first attempt, so redirects and retries over HTTP/1.1 count towards the request
+    QElapsedTimer m_request_timer;
     std::vector<std::shared_ptr<Net::HeaderProxy>> m_headerProxies;
 };
 }  // namespace Net
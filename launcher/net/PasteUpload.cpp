@@ -47,12 +47,15 @@
 #include <QJsonObject>
 #include <QUrlQuery>
 
+#include <cstring>
+
 #include "net/Logging.h"
+#include "tasks/CpuExecutor.h"
 
-std::array<PasteUpload::PasteTypeInfo, 4> PasteUpload::PasteTypes = { { { "0x0.st", "https://0x0.st", "" },
-                                                                        { "hastebin", "https://hst.sh", "/documents" },
-                                                                        { "paste.gg", "https://paste.gg", "/api/v1/pastes" },
-                                                                        { "mclo.gs", "https://api.mclo.gs", "/1/log" } } };
+std::array<PasteUpload::PasteTypeInfo, 4> PasteUpload::PasteTypes = { { { "0x0.st", "https://0x0.st", "", 512 * 1024 * 1024 },
+                                                                        { "hastebin", "https://hst.sh", "/documents", 0 },
+                                                                        { "paste.gg", "https://paste.gg", "/api/v1/pastes", 0 },
+                                                                        { "mclo.gs", "https://api.mclo.gs", "/1/log", 10 * 1024 * 1024 } } };
 
 PasteUpload::PasteUpload(QWidget* window, QString text, QString baseUrl, PasteType pasteType)
     : m_window(window), m_baseUrl(baseUrl), m_pasteType(pasteType), m_text(text.toUtf8())
@@ -69,7 +72,65 @@ PasteUpload::PasteUpload(QWidget* window, QString text, QString baseUrl, PasteTy
 
 PasteUpload::~PasteUpload() {}
 
+QByteArray PasteUpload::prepareLog(const QByteArray& log, qint64 maxSize)
+{
+    QByteArray out;
+    out.reserve(log.size());
+
+    int runStart = 0;
+    int runLength = 0;
+    int repeats = 0;
+    auto endRun = [&] {
+        out.append(log.constData() + runStart, runLength);
+        if (repeats > 0)
+            out.append(QString("[repeated %1 more times]\n").arg(repeats).toUtf8());
+    };
+    for (int start = 0; start < log.size();) {
+        int end = log.indexOf('\n', start);
+        end = end == -1 ? log.size() : end + 1;
+        int length = end - start;
+        if (start > 0 && length == runLength && memcmp(log.constData() + start, log.constData() + runStart, length) == 0) {
+            repeats++;
+        } else {
+            endRun();
+            runStart = start;
+            runLength = length;
+            repeats = 0;
+        }
+        start = end;
+    }
+    endRun();
+
+    if (maxSize <= 0 || out.size() <= maxSize)
+        return out;
+
+    // leave room for saying what was cut
+    const int budget = static_cast<int>(maxSize) - 100;
+    const int headSize = budget / 4;
+    const int tailSize = budget - headSize;
+    int headEnd = out.lastIndexOf('\n', headSize - 1) + 1;
+    int tailStart = out.indexOf('\n', out.size() - tailSize);
+    tailStart = tailStart == -1 ? out.size() : tailStart + 1;
+
+    auto cut = QString("\n[%1 bytes were cut out to fit the paste service's size limit]\n\n").arg(tailStart - headEnd).toUtf8();
+    return out.left(headEnd) + cut + out.mid(tailStart);
+}
+
 void PasteUpload::executeTask()
+{
+    // huge logs take a moment to go through
+    setStatus(tr("Preparing the log"));
+    auto watcher = new QFutureWatcher<QByteArray>(this);
+    connect(watcher, &QFutureWatcher<QByteArray>::finished, this, [this, watcher] {
+        m_text = watcher->result();
+        watcher->deleteLater();
+        upload();
+    });
+    watcher->setFuture(CpuExecutor::run(CpuExecutor::Priority::Interactive,
+                                        [text = m_text, maxSize = PasteTypes.at(m_pasteType).maxSize] { return prepareLog(text, maxSize); }));
+}
+
+void PasteUpload::upload()
 {
     QNetworkRequest request{ QUrl(m_uploadUrl) };
     QNetworkReply* rep{};
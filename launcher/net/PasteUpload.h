@@ -63,6 +63,8 @@ class PasteUpload : public Task {
         const QString name;
         const QString defaultBase;
         const QString endpointPath;
+        // the biggest paste the service takes, in bytes. 0 if it's not known
+        const qint64 maxSize;
     };
 
     static std::array<PasteTypeInfo, 4> PasteTypes;
@@ -72,10 +74,16 @@ class PasteUpload : public Task {
 
     QString pasteLink() { return m_pasteLink; }
 
+    /** Collapses runs of the same line into one, and cuts lines out of the middle of logs bigger than maxSize.
+     *  The start says what was running, and the end usually says what went wrong, so both are kept. */
+    static QByteArray prepareLog(const QByteArray& log, qint64 maxSize);
+
    protected:
     virtual void executeTask();
 
    private:
+    void upload();
+
     QWidget* m_window;
     QString m_pasteLink;
     QString m_baseUrl;
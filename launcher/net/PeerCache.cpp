@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "PeerCache.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTcpSocket>
+
+#include <algorithm>
+#include <memory>
+
+#include "Application.h"
+#include "FileSystem.h"
+#include "net/ContentStore.h"
+#include "net/HttpMetaCache.h"
+#include "net/Logging.h"
+#include "net/MultiChecksumValidator.h"
+
+namespace Net {
+
+namespace {
+
+const QByteArray ANNOUNCE_MAGIC = "PrismLauncherPeerCache/1";
+constexpr quint16 ANNOUNCE_PORT = 49531;
+constexpr int ANNOUNCE_INTERVAL_MS = 30 * 1000;
+// peers that missed this many announcements are gone
+constexpr qint64 PEER_EXPIRY_MS = 3 * ANNOUNCE_INTERVAL_MS;
+
+// every peer that doesn't have a file costs a round trip before the real source is asked
+constexpr int MAX_PEER_ATTEMPTS = 2;
+
+constexpr int MAX_UPLOADS = 16;
+constexpr int MAX_REQUEST_SIZE = 4096;
+constexpr int REQUEST_TIMEOUT_MS = 10 * 1000;
+constexpr qint64 CHUNK_SIZE = 256 * 1024;
+constexpr qint64 SEND_BUFFER_SIZE = 1024 * 1024;
+
+constexpr qint64 LIBRARY_INDEX_AGE_MS = 60 * 1000;
+
+void respond(QTcpSocket* socket, const QByteArray& status)
+{
+    socket->write("HTTP/1.1 " + status + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+    socket->disconnectFromHost();
+}
+
+}  // namespace
+
+PeerCache::PeerCache(QObject* parent) : QObject(parent), m_id(QUuid::createUuid())
+{
+    m_announceTimer.setInterval(ANNOUNCE_INTERVAL_MS);
+    m_announceTimer.setTimerType(Qt::VeryCoarseTimer);
+    connect(&m_announceTimer, &QTimer::timeout, this, [this] { announce(QHostAddress::Broadcast); });
+    connect(&m_announcements, &QUdpSocket::readyRead, this, &PeerCache::readAnnouncements);
+    connect(&m_server, &QTcpServer::newConnection, this, [this] {
+        while (auto socket = m_server.nextPendingConnection())
+            serve(socket);
+    });
+}
+
+bool PeerCache::start()
+{
+    if (!m_server.listen(QHostAddress::AnyIPv4)) {
+        qCWarning(taskNetLogC) << "Could not serve downloads to peers:" << m_server.errorString();
+        return false;
+    }
+    if (!m_announcements.bind(QHostAddress::AnyIPv4, ANNOUNCE_PORT, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint)) {
+        qCWarning(taskNetLogC) << "Could not listen for peers:" << m_announcements.errorString();
+        m_server.close();
+        return false;
+    }
+
+    m_announceTimer.start();
+    announce(QHostAddress::Broadcast);
+    qCDebug(taskNetLogC) << "Sharing downloads with peers on port" << m_server.serverPort();
+    return true;
+}
+
+QList<QUrl> PeerCache::urlsFor(QCryptographicHash::Algorithm algorithm, const QByteArray& hash) const
+{
+    auto now = QDateTime::currentMSecsSinceEpoch();
+    QList<QPair<size_t, const Peer*>> candidates;
+    for (auto it = m_peers.begin(); it != m_peers.end(); ++it) {
+        if (now - it->lastSeen > PEER_EXPIRY_MS)
+            continue;
+        // rendezvous hashing: every launcher asks the same peers first for the same file, and different ones for different files
+        candidates.append({ qHash(it.key().toRfc4122() + hash), &it.value() });
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    QList<QUrl> urls;
+    auto path = QString("/blob/%1/%2").arg(MultiChecksumValidator::nameOf(algorithm), QString::fromLatin1(hash.toHex()));
+    for (int i = 0; i < candidates.size() && i < MAX_PEER_ATTEMPTS; i++) {
+        QUrl url;
+        url.setScheme("http");
+        url.setHost(candidates[i].second->address.toString());
+        url.setPort(candidates[i].second->port);
+        url.setPath(path);
+        urls.append(url);
+    }
+    return urls;
+}
+
+void PeerCache::peerFailed(const QUrl& url)
+{
+    for (auto it = m_peers.begin(); it != m_peers.end();) {
+        if (it->address == QHostAddress(url.host()) && it->port == url.port()) {
+            qCDebug(taskNetLogC) << "Forgetting unreachable peer" << url.host() << url.port();
+            it = m_peers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PeerCache::announce(const QHostAddress& to)
+{
+    auto datagram = ANNOUNCE_MAGIC + ' ' + m_id.toByteArray(QUuid::WithoutBraces) + ' ' + QByteArray::number(m_server.serverPort());
+    m_announcements.writeDatagram(datagram, to, ANNOUNCE_PORT);
+}
+
+void PeerCache::readAnnouncements()
+{
+    while (m_announcements.hasPendingDatagrams()) {
+        QByteArray datagram;
+        datagram.resize(static_cast<int>(qMax<qint64>(m_announcements.pendingDatagramSize(), 0)));
+        QHostAddress sender;
+        m_announcements.readDatagram(datagram.data(), datagram.size(), &sender);
+
+        auto parts = datagram.split(' ');
+        if (parts.size() != 3 || parts[0] != ANNOUNCE_MAGIC)
+            continue;
+        auto id = QUuid::fromString(QLatin1String(parts[1]));
+        bool valid = false;
+        auto port = parts[2].toUShort(&valid);
+        if (id.isNull() || id == m_id || !valid || port == 0)
+            continue;
+
+        bool known = m_peers.contains(id);
+        m_peers[id] = { sender, port, QDateTime::currentMSecsSinceEpoch() };
+        // a launcher that just started shouldn't have to wait for our next announcement to know about us
+        if (!known) {
+            qCDebug(taskNetLogC) << "Found peer" << sender.toString() << port;
+            announce(sender);
+        }
+    }
+}
+
+void PeerCache::serve(QTcpSocket* socket)
+{
+    connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    if (m_uploads >= MAX_UPLOADS) {
+        respond(socket, "503 Service Unavailable");
+        return;
+    }
+    m_uploads++;
+    connect(socket, &QObject::destroyed, this, [this] { m_uploads--; });
+
+    struct Upload {
+        QByteArray request;
+        bool answered = false;
+        QFile file;
+    };
+    auto upload = std::make_shared<Upload>();
+
+    // don't let clients that never get to the point hold an upload slot
+    QTimer::singleShot(REQUEST_TIMEOUT_MS, socket, [socket, upload] {
+        if (!upload->answered) {
+            socket->abort();
+            socket->deleteLater();
+        }
+    });
+
+    auto sendMore = [socket, upload] {
+        while (socket->bytesToWrite() < SEND_BUFFER_SIZE && !upload->file.atEnd()) {
+            auto chunk = upload->file.read(CHUNK_SIZE);
+            if (chunk.isEmpty()) {
+                qCWarning(taskNetLogC) << "Could not read" << upload->file.fileName() << "for a peer";
+                socket->abort();
+                socket->deleteLater();
+                return;
+            }
+            socket->write(chunk);
+        }
+        // waits for what is left to be written
+        if (upload->file.atEnd())
+            socket->disconnectFromHost();
+    };
+
+    connect(socket, &QTcpSocket::readyRead, socket, [this, socket, upload, sendMore] {
+        if (upload->answered) {
+            socket->readAll();
+            return;
+        }
+        upload->request.append(socket->readAll());
+        if (!upload->request.contains("\r\n\r\n")) {
+            if (upload->request.size() > MAX_REQUEST_SIZE) {
+                upload->answered = true;
+                respond(socket, "400 Bad Request");
+            }
+            return;
+        }
+        upload->answered = true;
+
+        auto line = upload->request.left(upload->request.indexOf("\r\n")).split(' ');
+        QString path;
+        if (line.size() == 3 && line[0] == "GET")
+            path = localFile(QString::fromLatin1(line[1]));
+        upload->file.setFileName(path);
+        if (path.isEmpty() || !upload->file.open(QIODevice::ReadOnly)) {
+            respond(socket, "404 Not Found");
+            return;
+        }
+
+        socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: " +
+                      QByteArray::number(upload->file.size()) + "\r\nConnection: close\r\n\r\n");
+        connect(socket, &QTcpSocket::bytesWritten, socket, sendMore);
+        sendMore();
+    });
+}
+
+QString PeerCache::localFile(const QString& path)
+{
+    static const QRegularExpression pattern("^/blob/(sha1|sha256|sha512)/([0-9a-f]{40,128})$");
+    auto match = pattern.match(path);
+    if (!match.hasMatch())
+        return {};
+    auto type = match.captured(1);
+    auto hash = match.captured(2);
+
+    QCryptographicHash::Algorithm algorithm;
+    auto store = APPLICATION->contentStore();
+    if (store && ContentStore::algorithmFor(type, algorithm) && store->contains(algorithm, hash))
+        return store->blobPath(algorithm, hash);
+
+    // asset objects and libraries are only known by their SHA-1
+    if (type != "sha1")
+        return {};
+
+    auto metacache = APPLICATION->metacache();
+    auto object = FS::PathCombine(metacache->getBasePath("asset_objects"), hash.left(2), hash);
+    if (QFileInfo(object).isFile())
+        return object;
+
+    auto now = QDateTime::currentMSecsSinceEpoch();
+    if (now - m_librariesIndexed > LIBRARY_INDEX_AGE_MS) {
+        m_libraries.clear();
+        for (auto& entry : metacache->getEntries("libraries")) {
+            auto sha1 = entry->getHash("sha1");
+            if (!sha1.isEmpty())
+                m_libraries.insert(sha1.toLower(), entry->getFullPath());
+        }
+        m_librariesIndexed = now;
+    }
+    auto library = m_libraries.value(hash);
+    return !library.isEmpty() && QFileInfo(library).isFile() ? library : QString();
+}
+
+}  // namespace Net
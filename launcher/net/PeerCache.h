@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QCryptographicHash>
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QTcpServer>
+#include <QTimer>
+#include <QUdpSocket>
+#include <QUrl>
+#include <QUuid>
+
+class QTcpSocket;
+
+namespace Net {
+
+/** Shares downloads with other launchers on the same network.
+ *
+ *  Launchers that have it enabled announce themselves with a UDP broadcast, and serve the files they have by their
+ *  digest over HTTP: content store blobs, asset objects and libraries. A download whose digest is checked asks a
+ *  couple of them before going to its actual source, so whatever one machine downloaded the others get from it.
+ *
+ *  Nothing a peer sends is used unless it has the expected digest.
+ */
+class PeerCache : public QObject {
+    Q_OBJECT
+   public:
+    explicit PeerCache(QObject* parent = nullptr);
+
+    /* Starts announcing and serving, returns false if neither socket could be set up. */
+    bool start();
+
+    /* Where peers may have the data with this raw digest, from the one most likely to have it. */
+    QList<QUrl> urlsFor(QCryptographicHash::Algorithm algorithm, const QByteArray& hash) const;
+
+    /* Forgets the peer behind 'url' until it announces itself again, it could not be reached. */
+    void peerFailed(const QUrl& url);
+
+   private:
+    struct Peer {
+        QHostAddress address;
+        quint16 port = 0;
+        qint64 lastSeen = 0;
+    };
+
+    void announce(const QHostAddress& to);
+    void readAnnouncements();
+    void serve(QTcpSocket* socket);
+    /* The file to serve for a request path, if we have it. */
+    QString localFile(const QString& path);
+
+   private:
+    QUuid m_id;
+    QUdpSocket m_announcements;
+    QTcpServer m_server;
+    QTimer m_announceTimer;
+    QHash<QUuid, Peer> m_peers;
+    int m_uploads = 0;
+
+    // libraries by their SHA-1, as the metacache knows them
+    QHash<QString, QString> m_libraries;
+    qint64 m_librariesIndexed = 0;
+};
+
+}  // namespace Net
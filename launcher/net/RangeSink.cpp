@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "RangeSink.h"
+
+#include <QRegularExpression>
+
+#include "FileSystem.h"
+#include "net/Logging.h"
+
+namespace Net {
+
+Task::State RangeSink::init(QNetworkRequest& request)
+{
+    if (!FS::ensureFilePathExists(m_path)) {
+        qCCritical(taskNetLogC) << "Could not create folder for " + m_path;
+        return Task::State::Failed;
+    }
+
+    auto range = m_first < 0 ? QString("bytes=%1").arg(m_first) : QString("bytes=%1-%2").arg(m_first).arg(m_last);
+    request.setRawHeader("Range", range.toLatin1());
+    // the range has to be of the file itself, not of a compressed version of it
+    request.setRawHeader("Accept-Encoding", "identity");
+
+    *m_received = {};
+    // the other ranges are written by other sinks, so the file is neither truncated nor appended to
+    m_file.reset(new QFile(m_path));
+    if (!m_file->open(QIODevice::ReadWrite)) {
+        qCCritical(taskNetLogC) << "Could not open " + m_path + " for writing";
+        return Task::State::Failed;
+    }
+
+    if (initAllValidators(request))
+        return Task::State::Running;
+    return Task::State::Failed;
+}
+
+Task::State RangeSink::headersReceived(QNetworkReply& reply)
+{
+    auto status_code = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    // redirects carry no content of ours
+    if (status_code >= 300 && status_code < 400)
+        return Task::State::Running;
+
+    if (status_code == 206) {
+        static const QRegularExpression contentRange(QStringLiteral("^bytes (\\d+)-(\\d+)/(\\d+|\\*)$"));
+        auto match = contentRange.match(QString::fromLatin1(reply.rawHeader("Content-Range")).trimmed());
+        if (!match.hasMatch()) {
+            qCCritical(taskNetLogC) << "Unusable Content-Range for" << m_path << reply.rawHeader("Content-Range");
+            return Task::State::Failed;
+        }
+        m_received->start = match.captured(1).toLongLong();
+        m_received->total = match.captured(3) == "*" ? -1 : match.captured(3).toLongLong();
+    } else if (status_code == 200) {
+        m_received->whole = true;
+        bool ok = false;
+        auto length = reply.header(QNetworkRequest::ContentLengthHeader).toLongLong(&ok);
+        m_received->total = ok ? length : -1;
+    } else {
+        return Task::State::Running;
+    }
+
+    m_received->length = 0;
+    if (!m_file->seek(m_received->start)) {
+        qCCritical(taskNetLogC) << "Could not seek in " + m_path;
+        return Task::State::Failed;
+    }
+    return Task::State::Running;
+}
+
+Task::State RangeSink::write(QByteArray& data)
+{
+    if (!writeAllValidators(data) || m_file->write(data) != data.size()) {
+        qCCritical(taskNetLogC) << "Failed writing into " + m_path;
+        m_file.reset();
+        return Task::State::Failed;
+    }
+    m_received->length += data.size();
+    return Task::State::Running;
+}
+
+Task::State RangeSink::abort()
+{
+    m_file.reset();
+    failAllValidators();
+    return Task::State::Failed;
+}
+
+Task::State RangeSink::finalize(QNetworkReply& reply)
+{
+    if (!m_file || !m_file->flush()) {
+        qCCritical(taskNetLogC) << "Failed writing into " + m_path;
+        m_file.reset();
+        return Task::State::Failed;
+    }
+    m_file.reset();
+
+    if (finalizeAllValidators(reply))
+        return Task::State::Succeeded;
+    return Task::State::Failed;
+}
+
+}  // namespace Net
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QFile>
+
+#include <memory>
+
+#include "Sink.h"
+
+namespace Net {
+
+/** Sink for a byte range of a remote file, written into a local file at the same offset.
+ *
+ *  Several of them fill in one file from parallel requests, leaving holes where nothing was asked for. A server that
+ *  doesn't do ranges sends the whole file instead, which is then written from its start, and Received says so.
+ */
+class RangeSink : public Sink {
+   public:
+    /* What the server sent. */
+    struct Received {
+        qint64 start = 0;
+        qint64 length = 0;
+        // the size of the whole file, -1 if the server didn't say
+        qint64 total = -1;
+        // the server ignored the range and sent all of it
+        bool whole = false;
+    };
+
+    /* Bytes first to last of the file, or the last -first bytes of it when first is negative. */
+    RangeSink(QString path, qint64 first, qint64 last, std::shared_ptr<Received> received)
+        : m_path(std::move(path)), m_first(first), m_last(last), m_received(std::move(received))
+    {}
+    virtual ~RangeSink() = default;
+
+   public:
+    auto init(QNetworkRequest& request) -> Task::State override;
+    auto headersReceived(QNetworkReply& reply) -> Task::State override;
+    auto write(QByteArray& data) -> Task::State override;
+    auto abort() -> Task::State override;
+    auto finalize(QNetworkReply& reply) -> Task::State override;
+
+    auto hasLocalData() -> bool override { return false; }
+
+   private:
+    QString m_path;
+    qint64 m_first;
+    qint64 m_last;
+    std::shared_ptr<Received> m_received;
+    std::unique_ptr<QFile> m_file;
+};
+}  // namespace Net
@@ -50,6 +50,9 @@ class Sink {
     virtual auto abort() -> Task::State = 0;
     virtual auto finalize(QNetworkReply& reply) -> Task::State = 0;
 
+    /* Called once the response headers (of every response, including redirects) are known, before any data is written. */
+    virtual auto headersReceived(QNetworkReply&) -> Task::State { return Task::State::Running; }
+
     virtual auto hasLocalData() -> bool = 0;
 
     void addValidator(Validator* validator)
@@ -59,6 +62,19 @@ class Sink {
         }
     }
 
+    /* The digest the data is checked against, raw, if anything checks one. Data that is checked can come from anywhere. */
+    virtual auto expectedHash(QCryptographicHash::Algorithm& algorithm, QByteArray& hash) const -> bool
+    {
+        for (auto& validator : validators) {
+            if (validator->expectedHash(algorithm, hash))
+                return true;
+        }
+        return false;
+    }
+
+    /* Whether the data comes from somewhere that isn't trusted with anything but data matching the expected hash. */
+    void setUntrustedSource(bool untrusted) { m_untrusted_source = untrusted; }
+
    protected:
     bool initAllValidators(QNetworkRequest& request)
     {
@@ -95,5 +111,6 @@ class Sink {
 
    protected:
     std::vector<std::shared_ptr<Validator>> validators;
+    bool m_untrusted_source = false;
 };
 }  // namespace Net
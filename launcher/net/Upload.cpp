@@ -38,19 +38,69 @@
 
 #include "Upload.h"
 
+#include <QMutex>
+#include <QSet>
 #include <memory>
 #include <utility>
 #include "ByteArraySink.h"
+#include "GZip.h"
+#include "net/Logging.h"
 
 namespace Net {
 
+namespace {
+/** Hosts which refused a compressed body during this session.
+ *  Requests to them are sent uncompressed until the launcher is restarted.
+ */
+QSet<QString> s_uncompressed_hosts;
+QMutex s_uncompressed_hosts_mutex;
+
+// smaller bodies hardly get any faster to send, and aren't worth the risk of a retry
+constexpr int MIN_COMPRESSED_BODY_SIZE = 4 * 1024;
+
+bool hostTakesCompressedBodies(const QString& host)
+{
+    QMutexLocker locker(&s_uncompressed_hosts_mutex);
+    return !s_uncompressed_hosts.contains(host);
+}
+}  // namespace
+
 QNetworkReply* Upload::getReply(QNetworkRequest& request)
 {
     if (!request.hasRawHeader("Content-Type"))
         request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    m_body_compressed = false;
+    if (m_compress_body && m_post_data.size() >= MIN_COMPRESSED_BODY_SIZE && hostTakesCompressedBodies(m_url.host())) {
+        if (m_compressed_post_data.isEmpty() && !GZip::zip(m_post_data, m_compressed_post_data))
+            m_compressed_post_data.clear();
+        if (!m_compressed_post_data.isEmpty() && m_compressed_post_data.size() < m_post_data.size()) {
+            m_body_compressed = true;
+            request.setRawHeader("Content-Encoding", "gzip");
+            return m_network->post(request, m_compressed_post_data);
+        }
+    }
     return m_network->post(request, m_post_data);
 }
 
+auto Upload::handleFallback() -> bool
+{
+    // 415 is what RFC 7694 says to answer with, but some servers just fail to parse the body
+    auto status = replyStatusCode();
+    if (!m_body_compressed || (status != 415 && status != 400))
+        return false;
+
+    qCWarning(logCat) << getUid().toString() << m_url.host() << "refused a compressed body with HTTP" << status
+                      << "; sending it uncompressed from now on";
+    {
+        QMutexLocker locker(&s_uncompressed_hosts_mutex);
+        s_uncompressed_hosts.insert(m_url.host());
+    }
+    m_sink->abort();
+    executeTask();
+    return true;
+}
+
 Upload::Ptr Upload::makeByteArray(QUrl url, std::shared_ptr<QByteArray> output, QByteArray m_post_data)
 {
     auto up = makeShared<Upload>();
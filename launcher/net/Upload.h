@@ -49,9 +49,18 @@ class Upload : public NetRequest {
 
     static Upload::Ptr makeByteArray(QUrl url, std::shared_ptr<QByteArray> output, QByteArray m_post_data);
 
+    /// sends large bodies gzip compressed, falling back to sending them as they are to hosts that don't take that
+    void setCompressBody(bool compress) { m_compress_body = compress; }
+
    protected:
     virtual QNetworkReply* getReply(QNetworkRequest&) override;
+    auto handleFallback() -> bool override;
     QByteArray m_post_data;
+
+   private:
+    bool m_compress_body = false;
+    bool m_body_compressed = false;
+    QByteArray m_compressed_post_data;
 };
 
 }  // namespace Net
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <QCryptographicHash>
 #include <QNetworkReply>
 
 namespace Net {
@@ -47,5 +48,8 @@ class Validator {
     virtual bool write(QByteArray& data) = 0;
     virtual bool abort() = 0;
     virtual bool validate(QNetworkReply& reply) = 0;
+
+    /* The digest the data is checked against, if this validator checks one. */
+    virtual bool expectedHash(QCryptographicHash::Algorithm&, QByteArray&) const { return false; }
 };
 }  // namespace Net
@@ -36,19 +36,23 @@
 #include "NewsChecker.h"
 
 #include <QByteArray>
-#include <QDomDocument>
+#include <QFile>
+#include <QXmlStreamReader>
 
 #include <QDebug>
 
+#include "Application.h"
+#include "tasks/CpuExecutor.h"
+
 NewsChecker::NewsChecker(shared_qobject_ptr<QNetworkAccessManager> network, const QString& feedUrl)
 {
     m_network = network;
     m_feedUrl = feedUrl;
+    connect(&m_parseWatcher, &QFutureWatcher<Feed>::finished, this, &NewsChecker::feedParsed);
 }
 
 void NewsChecker::reloadNews()
 {
-    // Start a netjob to download the RSS feed and call rssDownloadFinished() when it's done.
     if (isLoadingNews()) {
         qDebug() << "Ignored request to reload news. Currently reloading already.";
         return;
@@ -56,54 +60,114 @@ void NewsChecker::reloadNews()
 
     qDebug() << "Reloading news.";
 
-    NetJob::Ptr job{ new NetJob("News RSS Feed", m_network) };
-    job->addNetAction(Net::Download::makeByteArray(m_feedUrl, newsData));
+    m_cacheEntry = APPLICATION->metacache()->resolveEntry("general", "news/feed.xml");
+    // the cached copy is for showing something right away, whether it is still current is always asked
+    m_cacheEntry->setStale(true);
+
+    if (m_newsEntries.isEmpty() && QFile::exists(m_cacheEntry->getFullPath())) {
+        parseFeedFile(true);
+    } else {
+        refreshFeed();
+    }
+}
+
+void NewsChecker::parseFeedFile(bool fromCache)
+{
+    m_parsingCache = fromCache;
+    m_parseWatcher.setFuture(CpuExecutor::run(CpuExecutor::Priority::Interactive, [path = m_cacheEntry->getFullPath()] {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return Feed{ {}, tr("Failed to read the news feed: %1").arg(file.errorString()) };
+        }
+        return parseFeed(file.readAll());
+    }));
+}
+
+void NewsChecker::refreshFeed()
+{
+    m_cachedChecksum = QFile::exists(m_cacheEntry->getFullPath()) ? m_cacheEntry->getMD5Sum() : QString();
+
+    auto job = makeShared<NetJob>("News RSS Feed", m_network);
+    job->addNetAction(Net::Download::makeCached(m_feedUrl, m_cacheEntry));
     QObject::connect(job.get(), &NetJob::succeeded, this, &NewsChecker::rssDownloadFinished);
     QObject::connect(job.get(), &NetJob::failed, this, &NewsChecker::rssDownloadFailed);
-    m_newsNetJob.reset(job);
+    m_newsNetJob = job;
     job->start();
 }
 
-void NewsChecker::rssDownloadFinished()
+NewsChecker::Feed NewsChecker::parseFeed(const QByteArray& data)
 {
-    // Parse the XML file and process the RSS feed entries.
-    qDebug() << "Finished loading RSS feed.";
-
-    m_newsNetJob.reset();
-    QDomDocument doc;
-    {
-        // Stuff to store error info in.
-        QString errorMsg = "Unknown error.";
-        int errorLine = -1;
-        int errorCol = -1;
-
-        // Parse the XML.
-        if (!doc.setContent(*newsData, false, &errorMsg, &errorLine, &errorCol)) {
-            QString fullErrorMsg = QString("Error parsing RSS feed XML. %1 at %2:%3.").arg(errorMsg).arg(errorLine).arg(errorCol);
-            fail(fullErrorMsg);
-            newsData->clear();
-            return;
+    Feed feed;
+    QXmlStreamReader xml(data);
+    while (!xml.atEnd()) {
+        if (xml.readNext() != QXmlStreamReader::StartElement || xml.name() != QLatin1String("entry")) {
+            continue;
+        }
+        ParsedEntry entry{ tr("Untitled"), tr("No content."), QString() };
+        while (xml.readNextStartElement()) {
+            if (xml.name() == QLatin1String("title")) {
+                entry.title = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+            } else if (xml.name() == QLatin1String("content")) {
+                entry.content = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+            } else if (xml.name() == QLatin1String("id")) {
+                entry.link = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+            } else {
+                xml.skipCurrentElement();
+            }
         }
-        newsData->clear();
+        feed.entries.append(entry);
     }
+    if (xml.hasError()) {
+        feed.error =
+            QString("Error parsing RSS feed XML. %1 at %2:%3.").arg(xml.errorString()).arg(xml.lineNumber()).arg(xml.columnNumber());
+    }
+    return feed;
+}
 
-    // If the parsing succeeded, read it.
-    QDomNodeList items = doc.elementsByTagName("entry");
-    m_newsEntries.clear();
-    for (int i = 0; i < items.length(); i++) {
-        QDomElement element = items.at(i).toElement();
-        NewsEntryPtr entry;
-        entry.reset(new NewsEntry());
-        QString errorMsg = "An unknown error occurred.";
-        if (NewsEntry::fromXmlElement(element, entry.get(), &errorMsg)) {
-            qDebug() << "Loaded news entry" << entry->title;
-            m_newsEntries.append(entry);
+void NewsChecker::feedParsed()
+{
+    auto feed = m_parseWatcher.result();
+    bool fromCache = m_parsingCache;
+    m_parsingCache = false;
+
+    if (!feed.error.isEmpty()) {
+        if (fromCache) {
+            // a broken cached copy is just downloaded again
+            qWarning() << "Failed to read the cached news feed:" << feed.error;
+            refreshFeed();
         } else {
-            qWarning() << "Failed to load news entry at index" << i << ":" << errorMsg;
+            fail(feed.error);
         }
+        return;
+    }
+
+    m_newsEntries.clear();
+    for (const auto& parsed : feed.entries) {
+        qDebug() << "Loaded news entry" << parsed.title;
+        m_newsEntries.append(std::make_shared<NewsEntry>(parsed.title, parsed.content, parsed.link));
+    }
+
+    if (fromCache) {
+        qDebug() << "Showing cached news, refreshing the feed.";
+        emit newsLoaded();
+        refreshFeed();
+    } else {
+        succeed();
+    }
+}
+
+void NewsChecker::rssDownloadFinished()
+{
+    qDebug() << "Finished loading RSS feed.";
+
+    m_newsNetJob.reset();
+    if (!m_newsEntries.isEmpty() && !m_cachedChecksum.isEmpty() && m_cacheEntry->getMD5Sum() == m_cachedChecksum) {
+        qDebug() << "News feed did not change.";
+        succeed();
+        return;
     }
 
-    succeed();
+    parseFeedFile(false);
 }
 
 void NewsChecker::rssDownloadFailed(QString reason)
@@ -119,7 +183,7 @@ QList<NewsEntryPtr> NewsChecker::getNewsEntries() const
 
 bool NewsChecker::isLoadingNews() const
 {
-    return m_newsNetJob.get() != nullptr;
+    return m_newsNetJob.get() != nullptr || m_parseWatcher.isRunning();
 }
 
 QString NewsChecker::getLastLoadErrorMsg() const
@@ -15,10 +15,12 @@
 
 #pragma once
 
+#include <QFutureWatcher>
 #include <QList>
 #include <QObject>
 #include <QString>
 
+#include <net/HttpMetaCache.h>
 #include <net/NetJob.h>
 
 #include "NewsEntry.h"
@@ -52,6 +54,7 @@ class NewsChecker : public QObject {
 
     /*!
      * Reloads the news from the website's RSS feed.
+     * The copy in the cache, if there is one, is shown first, then the feed is asked for again only if it changed.
      * If the news is already loading, this does nothing.
      */
     void Q_SLOT reloadNews();
@@ -67,7 +70,24 @@ class NewsChecker : public QObject {
      */
     void newsLoadingFailed(QString errorMsg);
 
+   protected:
+    struct ParsedEntry {
+        QString title;
+        QString content;
+        QString link;
+    };
+    struct Feed {
+        QList<ParsedEntry> entries;
+        QString error;
+    };
+
+    static Feed parseFeed(const QByteArray& data);
+    /// Parses the feed in the cache on a worker, feedParsed() picks it up.
+    void parseFeedFile(bool fromCache);
+    void refreshFeed();
+
    protected slots:
+    void feedParsed();
     void rssDownloadFinished();
     void rssDownloadFailed(QString reason);
 
@@ -84,7 +104,16 @@ class NewsChecker : public QObject {
     //! True if news has been loaded.
     bool m_loadedNews;
 
-    std::shared_ptr<QByteArray> newsData = std::make_shared<QByteArray>();
+    //! Where the feed is kept between runs.
+    MetaEntryPtr m_cacheEntry;
+
+    //! The checksum of the cached feed when the refresh started, to tell whether it changed.
+    QString m_cachedChecksum;
+
+    QFutureWatcher<Feed> m_parseWatcher;
+
+    //! True while the feed being parsed is the one from before the refresh.
+    bool m_parsingCache = false;
 
     /*!
      * Gets the error message that was given last time the news was loaded.
@@ -15,7 +15,6 @@
 
 #pragma once
 
-#include <QDomElement>
 #include <QObject>
 #include <QString>
 #include <memory>
@@ -35,12 +34,6 @@ class NewsEntry : public QObject {
      */
     NewsEntry(const QString& title, const QString& content, const QString& link, QObject* parent = 0);
 
-    /*!
-     * Attempts to load information from the given XML element into the given news entry pointer.
-     * If this fails, the function will return false and store an error message in the errorMsg pointer.
-     */
-    static bool fromXmlElement(const QDomElement& element, NewsEntry* entry, QString* errorMsg = 0);
-
     //! The post title.
     QString title;
 
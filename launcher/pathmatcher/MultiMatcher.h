@@ -1,7 +1,17 @@
+#pragma once
+
 #include <SeparatorPrefixTree.h>
+#include <QMap>
 #include <QRegularExpression>
+#include <QSet>
 #include "IPathMatcher.h"
+#include "RegexpMatcher.h"
+#include "SimplePrefixMatcher.h"
 
+/* Matches what any of its matchers match.
+ *
+ * Every path copied or exported goes through here, so the matchers are merged as they're added: regexps into one per
+ * kind, and prefixes into a set. Matchers shouldn't be changed after they're added. */
 class MultiMatcher : public IPathMatcher {
    public:
     virtual ~MultiMatcher(){};
@@ -9,12 +19,21 @@ class MultiMatcher : public IPathMatcher {
     MultiMatcher& add(Ptr add)
     {
         m_matchers.append(add);
+        compile();
         return *this;
     }
 
     virtual bool matches(const QString& string) const override
     {
-        for (auto iter : m_matchers) {
+        if (m_exact.contains(string)) {
+            return true;
+        }
+        for (auto& prefix : m_prefixes) {
+            if (string.startsWith(prefix)) {
+                return true;
+            }
+        }
+        for (auto& iter : m_compiled) {
             if (iter->matches(string)) {
                 return true;
             }
@@ -23,4 +42,54 @@ class MultiMatcher : public IPathMatcher {
     }
 
     QList<Ptr> m_matchers;
+
+   private:
+    void compile()
+    {
+        m_exact.clear();
+        m_prefixes.clear();
+        m_compiled.clear();
+
+        // by whether they only look at file names, and their options
+        QMap<QPair<bool, int>, QList<std::shared_ptr<RegexpMatcher>>> regexps;
+        for (auto& matcher : m_matchers) {
+            if (auto prefix = std::dynamic_pointer_cast<SimplePrefixMatcher>(matcher)) {
+                if (prefix->m_isPrefix) {
+                    m_prefixes.append(prefix->m_prefix);
+                } else {
+                    m_exact.insert(prefix->m_prefix);
+                }
+            } else if (auto regexp = std::dynamic_pointer_cast<RegexpMatcher>(matcher); regexp && regexp->isMergeable()) {
+                regexps[{ regexp->m_onlyFilenamePart, int(regexp->m_regexp.patternOptions()) }].append(regexp);
+            } else {
+                m_compiled.append(matcher);
+            }
+        }
+
+        for (auto it = regexps.cbegin(); it != regexps.cend(); ++it) {
+            if (it->size() == 1) {
+                m_compiled.append(it->first());
+                continue;
+            }
+            QStringList alternatives;
+            for (auto& regexp : *it) {
+                alternatives.append("(?:" + regexp->m_regexp.pattern() + ")");
+            }
+            auto merged = std::make_shared<RegexpMatcher>(alternatives.join('|'));
+            merged->m_regexp.setPatternOptions(QRegularExpression::PatternOptions(it.key().second));
+            merged->m_onlyFilenamePart = it.key().first;
+            if (merged->m_regexp.isValid()) {
+                merged->m_regexp.optimize();
+                m_compiled.append(merged);
+            } else {
+                for (auto& regexp : *it) {
+                    m_compiled.append(regexp);
+                }
+            }
+        }
+    }
+
+    QSet<QString> m_exact;
+    QStringList m_prefixes;
+    QList<Ptr> m_compiled;
 };
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <QRegularExpression>
 #include "IPathMatcher.h"
 
@@ -25,12 +27,25 @@ class RegexpMatcher : public IPathMatcher {
         if (m_onlyFilenamePart) {
             auto slash = string.lastIndexOf('/');
             if (slash != -1) {
-                auto part = string.mid(slash + 1);
-                return m_regexp.match(part).hasMatch();
+                // look at the file name where it is, instead of copying it out
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+                return m_regexp.matchView(QStringView(string).mid(slash + 1)).hasMatch();
+#elif QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+                return m_regexp.match(QStringView(string).mid(slash + 1)).hasMatch();
+#else
+                return m_regexp.match(string.midRef(slash + 1)).hasMatch();
+#endif
             }
         }
         return m_regexp.match(string).hasMatch();
     }
+
+    /* Whether the pattern still means the same as one alternative of a bigger one, which back references wouldn't */
+    bool isMergeable() const
+    {
+        static const QRegularExpression s_backReference(R"(\\[1-9gk]|\(\?P=)");
+        return m_regexp.isValid() && !m_regexp.pattern().contains(s_backReference);
+    }
     QRegularExpression m_regexp;
     bool m_onlyFilenamePart = false;
 };
@@ -2,6 +2,8 @@
 //
 // SPDX-License-Identifier: GPL-3.0-only
 
+#pragma once
+
 #include <QRegularExpression>
 #include "IPathMatcher.h"
 
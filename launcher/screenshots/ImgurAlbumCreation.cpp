@@ -63,7 +63,10 @@ QNetworkReply* ImgurAlbumCreation::getReply(QNetworkRequest& request)
     for (auto shot : m_screenshots) {
         hashes.append(shot->m_imgurDeleteHash);
     }
-    const QByteArray data = "deletehashes=" + hashes.join(',').toUtf8() + "&title=Minecraft%20Screenshots&privacy=hidden";
+    QByteArray data = "title=Minecraft%20Screenshots&privacy=hidden";
+    if (!hashes.isEmpty()) {
+        data = "deletehashes=" + hashes.join(',').toUtf8() + "&" + data;
+    }
     return m_network->post(request, data);
 };
 
@@ -64,7 +64,8 @@ class ImgurAlbumCreation : public Net::NetRequest {
         QByteArray m_output;
     };
 
-    static NetRequest::Ptr make(std::shared_ptr<Result> output, QList<ScreenShot::Ptr> screenshots);
+    /* With no screenshots, the album is created empty, for uploads to be added to as they finish. */
+    static NetRequest::Ptr make(std::shared_ptr<Result> output, QList<ScreenShot::Ptr> screenshots = {});
     QNetworkReply* getReply(QNetworkRequest& request) override;
 
     void init() override;
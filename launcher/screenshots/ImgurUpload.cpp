@@ -37,16 +37,48 @@
 #include "ImgurUpload.h"
 #include "BuildConfig.h"
 #include "net/StaticHeaderProxy.h"
+#include "tasks/CpuExecutor.h"
 
 #include <QDebug>
+#include <QDir>
 #include <QFile>
 #include <QHttpMultiPart>
 #include <QHttpPart>
+#include <QImageReader>
+#include <QImageWriter>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QNetworkRequest>
 #include <QUrl>
 
+namespace {
+// imgur turns bigger PNGs into JPEGs on its end anyway, after all of the file was sent
+constexpr qint64 SHRINK_ABOVE = 5 * 1024 * 1024;
+// what 4K screenshots are scaled down to fit in
+constexpr int SHRUNK_SIZE = 2560;
+
+bool shrink(const QString& path, QIODevice* into)
+{
+    QImageReader reader(path);
+    auto size = reader.size();
+    if (size.isValid() && (size.width() > SHRUNK_SIZE || size.height() > SHRUNK_SIZE)) {
+        reader.setScaledSize(size.scaled(SHRUNK_SIZE, SHRUNK_SIZE, Qt::KeepAspectRatio));
+    }
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Could not read screenshot to shrink it:" << reader.errorString();
+        return false;
+    }
+    QImageWriter writer(into, "jpg");
+    writer.setQuality(90);
+    if (!writer.write(image)) {
+        qWarning() << "Could not shrink screenshot:" << writer.errorString();
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
 void ImgurUpload::init()
 {
     qDebug() << "Setting up imgur upload";
@@ -56,9 +88,37 @@ void ImgurUpload::init()
     addHeaderProxy(api_headers);
 }
 
+void ImgurUpload::executeTask()
+{
+    if (!m_shrink || m_shrinkTried || m_fileInfo.size() <= SHRINK_ABOVE) {
+        NetRequest::executeTask();
+        return;
+    }
+    m_shrinkTried = true;
+
+    // the screenshot is shrunk on a worker right before it goes up, while the others are being sent
+    setStatus(tr("Shrinking %1").arg(m_fileInfo.fileName()));
+    m_shrunk.reset(new QTemporaryFile(QDir::tempPath() + "/screenshot-XXXXXX.jpg"));
+    if (!m_shrunk->open()) {
+        m_shrunk.reset();
+        NetRequest::executeTask();
+        return;
+    }
+    connect(&m_shrinking, &QFutureWatcher<bool>::finished, this, [this] {
+        if (!m_shrinking.result()) {
+            m_shrunk.reset();
+        } else {
+            m_shrunk->close();
+        }
+        NetRequest::executeTask();
+    });
+    m_shrinking.setFuture(CpuExecutor::run(CpuExecutor::Priority::Bulk,
+                                           [path = m_fileInfo.absoluteFilePath(), into = m_shrunk.get()] { return shrink(path, into); }));
+}
+
 QNetworkReply* ImgurUpload::getReply(QNetworkRequest& request)
 {
-    auto file = new QFile(m_fileInfo.absoluteFilePath(), this);
+    auto file = new QFile(m_shrunk ? m_shrunk->fileName() : m_fileInfo.absoluteFilePath(), this);
 
     if (!file->open(QFile::ReadOnly)) {
         emitFailed();
@@ -69,7 +129,7 @@ QNetworkReply* ImgurUpload::getReply(QNetworkRequest& request)
     file->setParent(multipart);
     QHttpPart filePart;
     filePart.setBodyDevice(file);
-    filePart.setHeader(QNetworkRequest::ContentTypeHeader, "image/png");
+    filePart.setHeader(QNetworkRequest::ContentTypeHeader, m_shrunk ? "image/jpeg" : "image/png");
     filePart.setHeader(QNetworkRequest::ContentDispositionHeader, "form-data; name=\"image\"");
     multipart->append(filePart);
     QHttpPart typePart;
@@ -80,6 +140,13 @@ QNetworkReply* ImgurUpload::getReply(QNetworkRequest& request)
     namePart.setHeader(QNetworkRequest::ContentDispositionHeader, "form-data; name=\"name\"");
     namePart.setBody(m_fileInfo.baseName().toUtf8());
     multipart->append(namePart);
+    if (m_album && !m_album->deleteHash.isEmpty()) {
+        // anonymous albums are added to with their delete hash
+        QHttpPart albumPart;
+        albumPart.setHeader(QNetworkRequest::ContentDispositionHeader, "form-data; name=\"album\"");
+        albumPart.setBody(m_album->deleteHash.toUtf8());
+        multipart->append(albumPart);
+    }
 
     return m_network->post(request, multipart);
 };
@@ -121,10 +188,13 @@ auto ImgurUpload::Sink::finalize(QNetworkReply&) -> Task::State
     return Task::State::Succeeded;
 }
 
-Net::NetRequest::Ptr ImgurUpload::make(ScreenShot::Ptr m_shot)
+Net::NetRequest::Ptr ImgurUpload::make(ScreenShot::Ptr m_shot, bool shrink, std::shared_ptr<const ImgurAlbumCreation::Result> album)
 {
     auto up = makeShared<ImgurUpload>(m_shot->m_file);
+    up->m_shrink = shrink;
+    up->m_album = std::move(album);
     up->m_url = std::move(BuildConfig.IMGUR_BASE_URL + "upload.json");
     up->m_sink.reset(new Sink(m_shot));
+    up->setPriority(Net::NetRequest::Priority::Bulk);
     return up;
 }
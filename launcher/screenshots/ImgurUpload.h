@@ -36,6 +36,12 @@
 #pragma once
 
 #include <QFileInfo>
+#include <QFutureWatcher>
+#include <QTemporaryFile>
+
+#include <memory>
+
+#include "ImgurAlbumCreation.h"
 #include "Screenshot.h"
 #include "net/NetRequest.h"
 
@@ -60,11 +66,25 @@ class ImgurUpload : public Net::NetRequest {
     ImgurUpload(QFileInfo info) : m_fileInfo(info) {}
     virtual ~ImgurUpload() = default;
 
-    static NetRequest::Ptr make(ScreenShot::Ptr m_shot);
+    /* With shrink, screenshots too big for imgur to keep as they are get scaled down and sent as JPEG instead.
+     * With an album, the screenshot goes right into it, once the album was created. */
+    static NetRequest::Ptr make(ScreenShot::Ptr m_shot,
+                                bool shrink = false,
+                                std::shared_ptr<const ImgurAlbumCreation::Result> album = nullptr);
 
     void init() override;
 
+   protected:
+    void executeTask() override;
+
    private:
     virtual QNetworkReply* getReply(QNetworkRequest&) override;
     const QFileInfo m_fileInfo;
+
+    bool m_shrink = false;
+    bool m_shrinkTried = false;
+    std::shared_ptr<const ImgurAlbumCreation::Result> m_album;
+    // the shrunk screenshot, while it's being made and uploaded
+    std::unique_ptr<QTemporaryFile> m_shrunk;
+    QFutureWatcher<bool> m_shrinking;
 };
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ThumbnailCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QImageReader>
+#include <QPainter>
+#include <QSaveFile>
+
+#include "FileSystem.h"
+
+namespace {
+const QString stampKey = QStringLiteral("Source-Stamp");
+}
+
+ThumbnailCache::ThumbnailCache(QString cacheDir) : m_cacheDir(std::move(cacheDir)) {}
+
+QString ThumbnailCache::sourceStamp(const QFileInfo& file)
+{
+    return QString("%1:%2").arg(file.lastModified().toMSecsSinceEpoch()).arg(file.size());
+}
+
+QString ThumbnailCache::entryPath(const QFileInfo& file) const
+{
+    // one entry per screenshot, a new version of the file replaces the old thumbnail
+    auto hash = QCryptographicHash::hash(file.absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return FS::PathCombine(m_cacheDir, QString::fromLatin1(hash) + ".png");
+}
+
+QImage ThumbnailCache::load(const QFileInfo& file) const
+{
+    QImageReader reader(entryPath(file), "png");
+    if (!reader.canRead()) {
+        return {};
+    }
+    // the text chunks are written before the image data, so stale entries are rejected without decoding them
+    if (reader.text(stampKey) != sourceStamp(file)) {
+        return {};
+    }
+    return reader.read();
+}
+
+void ThumbnailCache::store(const QFileInfo& file, const QImage& thumbnail) const
+{
+    if (!QDir().mkpath(m_cacheDir)) {
+        return;
+    }
+    QImage entry = thumbnail;
+    entry.setText(stampKey, sourceStamp(file));
+
+    QSaveFile output(entryPath(file));
+    if (!output.open(QIODevice::WriteOnly) || !entry.save(&output, "png")) {
+        qWarning() << "Could not write screenshot thumbnail" << output.fileName() << output.errorString();
+        output.cancelWriting();
+        return;
+    }
+    output.commit();
+}
+
+QImage ThumbnailCache::generate(const QString& path, int edge)
+{
+    QImageReader reader(path);
+    const QSize original = reader.size();
+    if (!original.isValid()) {
+        return {};
+    }
+    const QSize fitted = original.scaled(edge, edge, Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+
+    QImage small;
+    if (reader.supportsOption(QImageIOHandler::ScaledSize)) {
+        // the handler decodes straight to the smaller size, without ever holding the full image
+        reader.setScaledSize(fitted);
+        small = reader.read();
+    } else {
+        // QImageReader would scale the full image smoothly in one go, halving it cheaply first is much faster
+        QImage image = reader.read();
+        if (image.isNull()) {
+            return {};
+        }
+        if (image.width() > fitted.width() * 2 || image.height() > fitted.height() * 2) {
+            image = image.scaled(fitted * 2, Qt::KeepAspectRatio);
+        }
+        small = image.scaled(fitted, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    if (small.isNull()) {
+        return {};
+    }
+
+    QImage square(QSize(edge, edge), QImage::Format_ARGB32_Premultiplied);
+    square.fill(Qt::transparent);
+    QPainter painter(&square);
+    painter.drawImage(QPoint((edge - small.width()) / 2, (edge - small.height()) / 2), small);
+    painter.end();
+    return square;
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *  Copyright (C) 2024 Prism Launcher Contributors
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFileInfo>
+#include <QImage>
+#include <QString>
+
+/**
+ * Thumbnails of screenshots, persisted to disk so opening a folder doesn't decode every full size image again.
+ *
+ * Each thumbnail is stored next to the modification time and size of the file it was made from, so edited
+ * screenshots are thumbnailed again on their next lookup. Safe to use from any thread.
+ */
+class ThumbnailCache {
+   public:
+    explicit ThumbnailCache(QString cacheDir);
+
+    /// the cached thumbnail of the file, or a null image if there is none or it's out of date
+    QImage load(const QFileInfo& file) const;
+    void store(const QFileInfo& file, const QImage& thumbnail) const;
+
+    /// decode the image to fit a square of the given edge, centered on a transparent background
+    static QImage generate(const QString& path, int edge);
+
+   private:
+    QString entryPath(const QFileInfo& file) const;
+    static QString sourceStamp(const QFileInfo& file);
+
+    QString m_cacheDir;
+};
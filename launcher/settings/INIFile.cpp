@@ -37,12 +37,16 @@
 #include "settings/INIFile.h"
 #include <FileSystem.h>
 
+#include <QDataStream>
 #include <QDebug>
 #include <QFile>
+#include <QPoint>
+#include <QRect>
 #include <QSaveFile>
+#include <QSize>
 #include <QStringList>
+#include <QStringView>
 #include <QTemporaryFile>
-#include <QTextStream>
 
 #include <QSettings>
 
@@ -52,6 +56,10 @@ bool INIFile::saveFile(QString fileName)
 {
     if (!contains("ConfigVersion"))
         insert("ConfigVersion", "1.2");
+    if (fileName == m_syncedPath && *this == m_synced && QFile::exists(fileName))
+        return true;
+
+    // QSettings writes to a temporary file and renames it over the old one, so a failed save never leaves half a file
     QSettings _settings_obj{ fileName, QSettings::Format::IniFormat };
     _settings_obj.setFallbacksEnabled(false);
     _settings_obj.clear();
@@ -71,33 +79,34 @@ bool INIFile::saveFile(QString fileName)
         return false;
     }
 
+    m_synced = *this;
+    m_syncedPath = fileName;
     return true;
 }
 
-QString unescape(QString orig)
+QString unescape(const QString& orig)
 {
     QString out;
-    QChar prev = QChar::Null;
-    for (auto c : orig) {
-        if (prev == '\\') {
-            if (c == 'n')
-                out += '\n';
-            else if (c == 't')
-                out += '\t';
-            else if (c == '#')
-                out += '#';
-            else
-                out += c;
-            prev = QChar::Null;
-        } else {
-            if (c == '\\') {
-                prev = c;
-                continue;
-            }
-            out += c;
-            prev = QChar::Null;
-        }
+    out.reserve(orig.size());
+    const QChar* data = orig.constData();
+    const qsizetype size = orig.size();
+    qsizetype runStart = 0;
+    for (qsizetype i = 0; i < size; i++) {
+        if (data[i] != '\\')
+            continue;
+        out.append(data + runStart, i - runStart);
+        runStart = ++i + 1;
+        if (i == size)
+            break;
+        if (data[i] == 'n')
+            out += '\n';
+        else if (data[i] == 't')
+            out += '\t';
+        else
+            out += data[i];
     }
+    if (runStart < size)
+        out.append(data + runStart, size - runStart);
     return out;
 }
 
@@ -114,14 +123,9 @@ QString unquote(QString str)
     return str;
 }
 
-bool parseOldFileFormat(QIODevice& device, QSettings::SettingsMap& map)
+bool parseOldFileFormat(const QString& text, QSettings::SettingsMap& map)
 {
-    QTextStream in(device.readAll());
-#if QT_VERSION <= QT_VERSION_CHECK(6, 0, 0)
-    in.setCodec("UTF-8");
-#endif
-
-    QStringList lines = in.readAll().split('\n');
+    QStringList lines = text.split('\n');
     for (int i = 0; i < lines.count(); i++) {
         QString& lineRaw = lines[i];
         // Ignore comments.
@@ -150,41 +154,453 @@ bool parseOldFileFormat(QIODevice& device, QSettings::SettingsMap& map)
     return true;
 }
 
-bool INIFile::loadFile(QString fileName)
+/*
+ * A reader for the files QSettings writes in IniFormat, following qsettings.cpp so that both produce the same values.
+ * It works on the whole decoded file at once and copies runs of plain text instead of single characters.
+ */
+namespace {
+
+bool isIniSpace(QChar c)
 {
-    QSettings _settings_obj{ fileName, QSettings::Format::IniFormat };
-    _settings_obj.setFallbacksEnabled(false);
+    const auto u = c.unicode();
+    return u == ' ' || (u >= '\t' && u <= '\r');
+}
 
-    if (auto status = _settings_obj.status(); status != QSettings::Status::NoError) {
-        if (status == QSettings::Status::AccessError)
+int digitValue(QChar c, int base)
+{
+    const auto u = c.unicode();
+    if (u >= '0' && u <= '7')
+        return u - '0';
+    if (base == 8)
+        return -1;
+    if (u >= '8' && u <= '9')
+        return u - '0';
+    if (u >= 'a' && u <= 'f')
+        return u - 'a' + 10;
+    if (u >= 'A' && u <= 'F')
+        return u - 'A' + 10;
+    return -1;
+}
+
+// finds the next logical line; quoted values may span several physical ones
+bool readIniLine(const QChar* data, qsizetype dataLen, qsizetype& dataPos, qsizetype& lineStart, qsizetype& lineLen, qsizetype& equalsPos)
+{
+    bool inQuotes = false;
+    equalsPos = -1;
+
+    lineStart = dataPos;
+    while (lineStart < dataLen && isIniSpace(data[lineStart]))
+        ++lineStart;
+
+    qsizetype i = lineStart;
+    while (i < dataLen) {
+        const auto ch = data[i++].unicode();
+        if (ch == '=') {
+            if (!inQuotes && equalsPos == -1)
+                equalsPos = i - 1;
+        } else if (ch == '\n' || ch == '\r') {
+            if (i == lineStart + 1) {
+                ++lineStart;
+            } else if (!inQuotes) {
+                --i;
+                break;
+            }
+        } else if (ch == '\\') {
+            if (i < dataLen) {
+                const auto escaped = data[i++].unicode();
+                if (i < dataLen) {
+                    const auto next = data[i].unicode();
+                    if ((escaped == '\n' && next == '\r') || (escaped == '\r' && next == '\n'))
+                        ++i;
+                }
+            }
+        } else if (ch == '"') {
+            inQuotes = !inQuotes;
+        } else if (ch == ';') {
+            if (i == lineStart + 1) {
+                while (i < dataLen && data[i] != '\n' && data[i] != '\r')
+                    ++i;
+                while (i < dataLen && isIniSpace(data[i]))
+                    ++i;
+                lineStart = i;
+            } else if (!inQuotes) {
+                --i;
+                break;
+            }
+        }
+    }
+
+    dataPos = i;
+    lineLen = i - lineStart;
+    return lineLen > 0;
+}
+
+QStringView trimmedView(const QChar* data, qsizetype size)
+{
+    while (size > 0 && isIniSpace(data[0])) {
+        ++data;
+        --size;
+    }
+    while (size > 0 && isIniSpace(data[size - 1]))
+        --size;
+    return QStringView(data, size);
+}
+
+// '\' separates groups and %XX / %UXXXX encode everything outside [A-Za-z0-9_.-]
+void unescapeIniKey(QStringView key, QString& result)
+{
+    const qsizetype size = key.size();
+    result.reserve(result.size() + size);
+    qsizetype i = 0;
+    while (i < size) {
+        const QChar ch = key[i];
+        if (ch == '\\') {
+            result += '/';
+            ++i;
+            continue;
+        }
+        if (ch != '%' || i == size - 1) {
+            result += ch;
+            ++i;
+            continue;
+        }
+
+        int numDigits = 2;
+        qsizetype firstDigitPos = i + 1;
+        if (key[i + 1] == 'U') {
+            ++firstDigitPos;
+            numDigits = 4;
+        }
+        if (firstDigitPos + numDigits > size) {
+            result += '%';
+            ++i;
+            continue;
+        }
+        ushort value = 0;
+        bool ok = true;
+        for (qsizetype d = firstDigitPos; ok && d < firstDigitPos + numDigits; ++d) {
+            const int digit = digitValue(key[d], 16);
+            ok = digit != -1;
+            value = value * 16 + digit;
+        }
+        if (!ok) {
+            result += '%';
+            ++i;
+            continue;
+        }
+        result += QChar(value);
+        i = firstDigitPos + numDigits;
+    }
+}
+
+// QSettings drops empty groups, so "a//b/" and "a/b" are the same key
+QString normalizedKey(QString key)
+{
+    if (!key.contains('/'))
+        return key;
+    QString result;
+    result.reserve(key.size());
+    for (qsizetype i = 0; i < key.size(); ++i) {
+        if (key[i] == '/' && (result.isEmpty() || result.endsWith('/')))
+            continue;
+        result += key[i];
+    }
+    if (result.endsWith('/'))
+        result.chop(1);
+    return result;
+}
+
+void chopTrailingSpaces(QString& str, qsizetype limit)
+{
+    qsizetype n = str.size();
+    while (n > limit && (str[n - 1] == ' ' || str[n - 1] == '\t'))
+        --n;
+    str.truncate(n);
+}
+
+// returns whether the value is a comma separated list, which is then in stringListResult
+bool unescapeIniValue(const QChar* str, qsizetype size, QString& stringResult, QStringList& stringListResult)
+{
+    bool isStringList = false;
+    bool inQuotedString = false;
+    bool currentValueIsQuoted = false;
+    // a value stopping halfway through an escape keeps its trailing spaces
+    bool chop = true;
+    qsizetype chopLimit = 0;
+    qsizetype i = 0;
+
+    const auto skipSpaces = [&] {
+        while (i < size && (str[i] == ' ' || str[i] == '\t'))
+            ++i;
+        chopLimit = stringResult.size();
+    };
+
+    skipSpaces();
+    while (i < size) {
+        const QChar ch = str[i];
+        if (ch == '\\') {
+            if (++i >= size) {
+                chop = false;
+                break;
+            }
+            const auto escaped = str[i++].unicode();
+            switch (escaped) {
+                case 'a':
+                    stringResult += '\a';
+                    break;
+                case 'b':
+                    stringResult += '\b';
+                    break;
+                case 'f':
+                    stringResult += '\f';
+                    break;
+                case 'n':
+                    stringResult += '\n';
+                    break;
+                case 'r':
+                    stringResult += '\r';
+                    break;
+                case 't':
+                    stringResult += '\t';
+                    break;
+                case 'v':
+                    stringResult += '\v';
+                    break;
+                case '"':
+                case '?':
+                case '\'':
+                case '\\':
+                    stringResult += QChar(escaped);
+                    break;
+                case '\n':
+                case '\r':
+                    // line continuation
+                    if (i < size && (str[i] == '\n' || str[i] == '\r') && str[i] != QChar(escaped))
+                        ++i;
+                    break;
+                default: {
+                    const int base = escaped == 'x' ? 16 : 8;
+                    if (base == 8 && digitValue(QChar(escaped), 8) == -1)
+                        break;  // unknown escapes are dropped
+                    if (base == 16 && (i >= size || digitValue(str[i], 16) == -1)) {
+                        chop = i < size;
+                        break;
+                    }
+                    char16_t value = base == 8 ? escaped - '0' : 0;
+                    for (int digit; i < size && (digit = digitValue(str[i], base)) != -1; ++i)
+                        value = value * base + digit;
+                    stringResult += QChar(value);
+                }
+            }
+            if (!chop)
+                break;
+            chopLimit = stringResult.size();
+        } else if (ch == '"') {
+            ++i;
+            currentValueIsQuoted = true;
+            inQuotedString = !inQuotedString;
+            if (!inQuotedString)
+                skipSpaces();
+        } else if (ch == ',' && !inQuotedString) {
+            if (!currentValueIsQuoted)
+                chopTrailingSpaces(stringResult, chopLimit);
+            if (!isStringList) {
+                isStringList = true;
+                stringListResult.clear();
+            }
+            stringListResult.append(stringResult);
+            stringResult.clear();
+            currentValueIsQuoted = false;
+            ++i;
+            skipSpaces();
+        } else {
+            qsizetype j = i + 1;
+            while (j < size && str[j] != '\\' && str[j] != '"' && str[j] != ',')
+                ++j;
+            stringResult.append(str + i, j - i);
+            i = j;
+        }
+    }
+    if (chop && !currentValueIsQuoted)
+        chopTrailingSpaces(stringResult, chopLimit);
+
+    if (isStringList)
+        stringListResult.append(stringResult);
+    return isStringList;
+}
+
+QStringList iniArgs(const QString& s, qsizetype openParen)
+{
+    return s.mid(openParen + 1, s.size() - openParen - 2).split(' ');
+}
+
+QVariant iniStringToVariant(const QString& s)
+{
+    if (s.startsWith('@')) {
+        if (s.endsWith(')')) {
+            if (s.startsWith(QLatin1String("@ByteArray("))) {
+                return QVariant(s.mid(11, s.size() - 12).toLatin1());
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            } else if (s.startsWith(QLatin1String("@String("))) {
+                return QVariant(s.mid(8, s.size() - 9));
+#endif
+            } else if (s.startsWith(QLatin1String("@Variant(")) || s.startsWith(QLatin1String("@DateTime("))) {
+                const bool isDateTime = s.at(1) == 'D';
+                const QByteArray bytes = s.mid(isDateTime ? 10 : 9).toLatin1();
+                QDataStream stream(bytes);
+                stream.setVersion(isDateTime ? QDataStream::Qt_5_6 : QDataStream::Qt_4_0);
+                QVariant result;
+                stream >> result;
+                return result;
+            } else if (s.startsWith(QLatin1String("@Rect("))) {
+                if (auto args = iniArgs(s, 5); args.size() == 4)
+                    return QVariant(QRect(args[0].toInt(), args[1].toInt(), args[2].toInt(), args[3].toInt()));
+            } else if (s.startsWith(QLatin1String("@Size("))) {
+                if (auto args = iniArgs(s, 5); args.size() == 2)
+                    return QVariant(QSize(args[0].toInt(), args[1].toInt()));
+            } else if (s.startsWith(QLatin1String("@Point("))) {
+                if (auto args = iniArgs(s, 6); args.size() == 2)
+                    return QVariant(QPoint(args[0].toInt(), args[1].toInt()));
+            } else if (s == QLatin1String("@Invalid()")) {
+                return QVariant();
+            }
+        }
+        if (s.startsWith(QLatin1String("@@")))
+            return QVariant(s.mid(1));
+    }
+    return QVariant(s);
+}
+
+QVariant iniStringListToVariant(const QStringList& list)
+{
+    QStringList strings = list;
+    for (auto& str : strings) {
+        if (!str.startsWith('@'))
+            continue;
+        if (str.size() < 2 || str.at(1) != '@') {
+            QVariantList variantList;
+            variantList.reserve(list.size());
+            for (const auto& item : list)
+                variantList.append(iniStringToVariant(item));
+            return variantList;
+        }
+        str.remove(0, 1);
+    }
+    return strings;
+}
+
+// returns false on malformed lines, like QSettings' FormatError; everything readable is still in map
+bool parseIniFormat(const QString& text, QMap<QString, QVariant>& map)
+{
+    const QChar* data = text.constData();
+    const qsizetype dataLen = text.size();
+    bool ok = true;
+
+    QString section;
+    QString value;
+    QStringList listValue;
+    qsizetype dataPos = 0, lineStart, lineLen, equalsPos;
+    while (readIniLine(data, dataLen, dataPos, lineStart, lineLen, equalsPos)) {
+        const QChar* line = data + lineStart;
+        if (line[0] == '[') {
+            qsizetype end = 1;
+            while (end < lineLen && line[end] != ']')
+                ++end;
+            if (end == lineLen)
+                ok = false;
+            const auto name = trimmedView(line + 1, end - 1);
+            section.clear();
+            if (name.compare(QStringView(u"general"), Qt::CaseInsensitive) != 0) {
+                if (name.compare(QStringView(u"%general"), Qt::CaseInsensitive) == 0)
+                    section = name.mid(1).toString();
+                else
+                    unescapeIniKey(name, section);
+                section += '/';
+            }
+            continue;
+        }
+        if (equalsPos == -1) {
+            if (line[0] != ';')
+                ok = false;
+            continue;
+        }
+
+        equalsPos -= lineStart;
+        QString key = section;
+        unescapeIniKey(trimmedView(line, equalsPos), key);
+
+        value.clear();
+        const bool isList = unescapeIniValue(line + equalsPos + 1, lineLen - equalsPos - 1, value, listValue);
+        map.insert(normalizedKey(std::move(key)), isList ? iniStringListToVariant(listValue) : iniStringToVariant(value));
+    }
+    return ok;
+}
+
+}  // namespace
+
+bool INIFile::loadFile(QString fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (file.exists())
             qCritical() << "An access error occurred (e.g. trying to write to a read-only file).";
-        if (status == QSettings::Status::FormatError)
-            qCritical() << "A format error occurred (e.g. loading a malformed INI file).";
         return false;
     }
-    if (!_settings_obj.value("ConfigVersion").isValid()) {
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly))
-            return false;
+
+    // instance configs are all read on startup, so they are decoded straight out of a mapping of the file
+    QByteArray contents;
+    const char* data = nullptr;
+    qsizetype size = file.size();
+    if (size > 0) {
+        if (auto mapped = file.map(0, size)) {
+            data = reinterpret_cast<const char*>(mapped);
+        } else {
+            contents = file.readAll();
+            data = contents.constData();
+            size = contents.size();
+        }
+    }
+    const bool hasBom = size >= 3 && data[0] == '\xef' && data[1] == '\xbb' && data[2] == '\xbf';
+    if (hasBom) {
+        data += 3;
+        size -= 3;
+    }
+    const QString utf8Text = QString::fromUtf8(data, size);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    const QString& iniText = utf8Text;
+#else
+    // without a codec Qt 5 reads INI files as Latin-1 and writes everything else as escapes
+    const QString iniText = hasBom ? utf8Text : QString::fromLatin1(data, size);
+#endif
+
+    QMap<QString, QVariant> parsed;
+    if (!parseIniFormat(iniText, parsed)) {
+        qCritical() << "A format error occurred (e.g. loading a malformed INI file).";
+        return false;
+    }
+    if (!parsed.value("ConfigVersion").isValid()) {
         QSettings::SettingsMap map;
-        parseOldFileFormat(file, map);
-        file.close();
+        parseOldFileFormat(utf8Text, map);
         for (auto&& key : map.keys())
             insert(key, map.value(key));
         insert("ConfigVersion", "1.2");
-    } else if (_settings_obj.value("ConfigVersion").toString() == "1.1") {
-        for (auto&& key : _settings_obj.allKeys()) {
-            if (auto valueStr = _settings_obj.value(key).toString();
+    } else if (parsed.value("ConfigVersion").toString() == "1.1") {
+        for (auto iter = parsed.cbegin(); iter != parsed.cend(); iter++) {
+            if (auto valueStr = iter.value().toString();
                 (valueStr.contains(QChar(';')) || valueStr.contains(QChar('=')) || valueStr.contains(QChar(','))) &&
                 valueStr.endsWith("\"") && valueStr.startsWith("\"")) {
-                insert(key, unquote(valueStr));
+                insert(iter.key(), unquote(valueStr));
             } else
-                insert(key, _settings_obj.value(key));
+                insert(iter.key(), iter.value());
         }
         insert("ConfigVersion", "1.2");
-    } else
-        for (auto&& key : _settings_obj.allKeys())
-            insert(key, _settings_obj.value(key));
+    } else {
+        for (auto iter = parsed.cbegin(); iter != parsed.cend(); iter++)
+            insert(iter.key(), iter.value());
+        // converted files are still in the old format on disk, so only this one is known to match
+        m_synced = *this;
+        m_syncedPath = fileName;
+    }
     return true;
 }
 
@@ -50,8 +50,14 @@ class INIFile : public QMap<QString, QVariant> {
 
     bool loadFile(QString fileName);
     bool loadFile(QByteArray data);
+    /// writes the file, unless it already holds exactly these contents from the last load or save
     bool saveFile(QString fileName);
 
     QVariant get(QString key, QVariant def) const;
     void set(QString key, QVariant val);
+
+   private:
+    // what the file at m_syncedPath holds, as far as we know
+    QMap<QString, QVariant> m_synced;
+    QString m_syncedPath;
 };
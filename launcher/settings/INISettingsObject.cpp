@@ -16,8 +16,16 @@
 #include "INISettingsObject.h"
 #include "Setting.h"
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+
+namespace {
+// how long changes are collected before they are written in write-behind mode
+constexpr int WRITE_BEHIND_DELAY_MS = 250;
+}  // namespace
 
 INISettingsObject::INISettingsObject(QStringList paths, QObject* parent) : SettingsObject(parent)
 {
@@ -44,6 +52,44 @@ INISettingsObject::INISettingsObject(QString path, QObject* parent) : SettingsOb
     m_ini.loadFile(path);
 }
 
+INISettingsObject::INISettingsObject(QString path, INIFile contents, QObject* parent)
+    : SettingsObject(parent), m_ini(std::move(contents)), m_filePath(std::move(path))
+{}
+
+INISettingsObject::~INISettingsObject()
+{
+    saveNow();
+}
+
+void INISettingsObject::setWriteBehind(bool enabled)
+{
+    if (m_writeBehind == enabled)
+        return;
+    m_writeBehind = enabled;
+    if (!enabled) {
+        saveNow();
+        return;
+    }
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(WRITE_BEHIND_DELAY_MS);
+    connect(&m_saveTimer, &QTimer::timeout, this, &INISettingsObject::saveNow, Qt::UniqueConnection);
+    if (auto app = QCoreApplication::instance())
+        connect(app, &QCoreApplication::aboutToQuit, this, &INISettingsObject::saveNow, Qt::UniqueConnection);
+}
+
+void INISettingsObject::saveNow()
+{
+    if (!m_saveTimer.isActive())
+        return;
+    m_saveTimer.stop();
+    // the folder is gone when an instance got deleted or moved while a write was pending, don't bring it back
+    if (!QFileInfo(QFileInfo(m_filePath).absolutePath()).isDir()) {
+        qDebug() << "Dropping pending settings write to" << m_filePath << "as its folder no longer exists";
+        return;
+    }
+    m_ini.saveFile(m_filePath);
+}
+
 void INISettingsObject::setFilePath(const QString& filePath)
 {
     m_filePath = filePath;
@@ -51,6 +97,7 @@ void INISettingsObject::setFilePath(const QString& filePath)
 
 bool INISettingsObject::reload()
 {
+    saveNow();
     return m_ini.loadFile(m_filePath) && SettingsObject::reload();
 }
 
@@ -63,7 +110,8 @@ void INISettingsObject::resumeSave()
 {
     m_suspendSave = false;
     if (m_doSave) {
-        m_ini.saveFile(m_filePath);
+        m_doSave = false;
+        doSave();
     }
 }
 
@@ -90,6 +138,8 @@ void INISettingsObject::doSave()
 {
     if (m_suspendSave) {
         m_doSave = true;
+    } else if (m_writeBehind) {
+        m_saveTimer.start();
     } else {
         m_ini.saveFile(m_filePath);
     }
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <QObject>
+#include <QTimer>
 
 #include "settings/INIFile.h"
 
@@ -32,6 +33,11 @@ class INISettingsObject : public SettingsObject {
 
     explicit INISettingsObject(QString path, QObject* parent = nullptr);
 
+    /** For when the INI file at 'path' has already been read, possibly on another thread. */
+    INISettingsObject(QString path, INIFile contents, QObject* parent = nullptr);
+
+    ~INISettingsObject() override;
+
     /*!
      * \brief Gets the path to the INI file.
      * \return The path to the INI file.
@@ -48,6 +54,13 @@ class INISettingsObject : public SettingsObject {
 
     void suspendSave() override;
     void resumeSave() override;
+    void saveNow() override;
+
+    /*!
+     * \brief Collects the changes made within a short window into a single write, instead of writing the file for each one.
+     * Pending changes are written when the object goes away or the application quits.
+     */
+    void setWriteBehind(bool enabled);
 
    protected slots:
     virtual void changeSetting(const Setting& setting, QVariant value) override;
@@ -60,4 +73,6 @@ class INISettingsObject : public SettingsObject {
    protected:
     INIFile m_ini;
     QString m_filePath;
+    QTimer m_saveTimer;
+    bool m_writeBehind = false;
 };
@@ -141,6 +141,8 @@ class SettingsObject : public QObject {
 
     virtual void suspendSave() = 0;
     virtual void resumeSave() = 0;
+    /// write out changes that are still waiting to be saved
+    virtual void saveNow() {}
    signals:
     /*!
      * \brief Signal emitted when one of this SettingsObject object's settings changes.
@@ -42,6 +42,10 @@ ConcurrentTask::ConcurrentTask(QObject* parent, QString task_name, int max_concu
     : Task(parent), m_name(task_name), m_total_max_size(max_concurrent)
 {
     setObjectName(task_name);
+
+    m_progress_timer.setSingleShot(true);
+    m_progress_timer.setInterval(PROGRESS_TICK_MS);
+    connect(&m_progress_timer, &QTimer::timeout, this, &ConcurrentTask::flushProgress);
 }
 
 ConcurrentTask::~ConcurrentTask()
@@ -107,6 +111,10 @@ void ConcurrentTask::clear()
 
     m_progress = 0;
     m_stepProgress = 0;
+    m_released_count = 0;
+
+    m_progress_timer.stop();
+    m_dirty_progress.clear();
 }
 
 void ConcurrentTask::executeNextSubTask()
@@ -156,8 +164,13 @@ void ConcurrentTask::startSubTask(Task::Ptr next)
 
 void ConcurrentTask::subTaskFinished(Task::Ptr task, TaskStepState state)
 {
-    m_done.insert(task.get(), task);
-    (state == TaskStepState::Succeeded ? m_succeeded : m_failed).insert(task.get(), task);
+    bool release = !m_keep_succeeded && state == TaskStepState::Succeeded;
+    if (release) {
+        m_released_count++;
+    } else {
+        m_done.insert(task.get(), task);
+        (state == TaskStepState::Succeeded ? m_succeeded : m_failed).insert(task.get(), task);
+    }
 
     m_doing.remove(task.get());
 
@@ -166,9 +179,14 @@ void ConcurrentTask::subTaskFinished(Task::Ptr task, TaskStepState state)
 
     disconnect(task.get(), 0, this, 0);
 
+    m_dirty_progress.remove(task->getUid());
     emit stepProgress(*task_progress);
     updateState();
     updateStepProgress(*task_progress, Operation::REMOVED);
+
+    if (release)
+        m_task_progress.remove(task->getUid());
+
     QMetaObject::invokeMethod(this, &ConcurrentTask::executeNextSubTask, Qt::QueuedConnection);
 }
 
@@ -214,13 +232,10 @@ void ConcurrentTask::subTaskProgress(Task::Ptr task, qint64 current, qint64 tota
 
     task_progress->update(current, total);
 
-    emit stepProgress(*task_progress);
+    // the totals are kept up to date right away, only the reporting waits for the next tick
     updateStepProgress(*task_progress, Operation::CHANGED);
-    updateState();
-
-    if (totalSize() == 1) {
-        setProgress(task_progress->current, task_progress->total);
-    }
+    m_last_progress_uid = task->getUid();
+    scheduleProgress(task->getUid());
 }
 
 void ConcurrentTask::subTaskStepProgress(Task::Ptr task, TaskStepProgress const& task_progress)
@@ -244,8 +259,36 @@ void ConcurrentTask::subTaskStepProgress(Task::Ptr task, TaskStepProgress const&
         tp->details = task_progress.details;
 
         op = Operation::CHANGED;
-        emit stepProgress(*tp.get());
         updateStepProgress(*tp.get(), op);
+        scheduleProgress(task_progress.uid);
+    }
+}
+
+void ConcurrentTask::scheduleProgress(const QUuid& uid)
+{
+    m_dirty_progress.insert(uid);
+    if (!m_progress_timer.isActive())
+        m_progress_timer.start();
+}
+
+void ConcurrentTask::flushProgress()
+{
+    auto dirty = m_dirty_progress;
+    m_dirty_progress.clear();
+
+    if (!isRunning())
+        return;
+
+    for (auto const& uid : dirty) {
+        if (auto task_progress = m_task_progress.value(uid))
+            emit stepProgress(*task_progress);
+    }
+
+    updateState();
+
+    if (totalSize() == 1) {
+        if (auto task_progress = m_task_progress.value(m_last_progress_uid))
+            setProgress(task_progress->current, task_progress->total);
     }
 }
 
@@ -272,9 +315,9 @@ void ConcurrentTask::updateStepProgress(TaskStepProgress const& changed_progress
 void ConcurrentTask::updateState()
 {
     if (totalSize() > 1) {
-        setProgress(m_done.count(), totalSize());
+        setProgress(doneCount(), totalSize());
         setStatus(tr("Executing %1 task(s) (%2 out of %3 are done)")
-                      .arg(QString::number(m_doing.count()), QString::number(m_done.count()), QString::number(totalSize())));
+                      .arg(QString::number(m_doing.count()), QString::number(doneCount()), QString::number(totalSize())));
     } else {
         setProgress(m_stepProgress, m_stepTotalProgress);
         QString status = tr("Please wait...");
@@ -282,7 +325,7 @@ void ConcurrentTask::updateState()
             status = tr("Waiting for a task to start...");
         } else if (m_doing.size() > 0) {
             status = tr("Executing 1 task:");
-        } else if (m_done.size() > 0) {
+        } else if (doneCount() > 0) {
             status = tr("Task finished.");
         }
         setStatus(status);
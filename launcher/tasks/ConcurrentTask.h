@@ -38,6 +38,7 @@
 #include <QHash>
 #include <QQueue>
 #include <QSet>
+#include <QTimer>
 #include <QUuid>
 #include <memory>
 
@@ -54,6 +55,12 @@ class ConcurrentTask : public Task {
     // safe to call before starting the task
     void setMaxConcurrent(int max_concurrent) { m_total_max_size = max_concurrent; }
 
+    /** Whether succeeded subtasks are kept around until the whole task is done (the default).
+     *  When disabled, they are only counted and released as soon as they finish, and only the
+     *  failed ones are kept. Safe to call before starting the task.
+     */
+    void setKeepSucceededTasks(bool keep) { m_keep_succeeded = keep; }
+
     bool canAbort() const override { return true; }
 
     inline auto isMultiStep() const -> bool override { return totalSize() > 1; }
@@ -76,15 +83,20 @@ class ConcurrentTask : public Task {
 
     void subTaskSucceeded(Task::Ptr);
     virtual void subTaskFailed(Task::Ptr, const QString& msg);
-    void subTaskFinished(Task::Ptr, TaskStepState);
+    virtual void subTaskFinished(Task::Ptr, TaskStepState);
     void subTaskStatus(Task::Ptr task, const QString& msg);
     void subTaskDetails(Task::Ptr task, const QString& msg);
     void subTaskProgress(Task::Ptr task, qint64 current, qint64 total);
     void subTaskStepProgress(Task::Ptr task, TaskStepProgress const& task_step_progress);
 
+    /** Emits the progress changes gathered since the last tick. */
+    void flushProgress();
+
    protected:
     // NOTE: This is not thread-safe.
-    [[nodiscard]] unsigned int totalSize() const { return static_cast<unsigned int>(m_queue.size() + m_doing.size() + m_done.size()); }
+    [[nodiscard]] unsigned int totalSize() const { return static_cast<unsigned int>(m_queue.size() + m_doing.size() + doneCount()); }
+    // NOTE: This is not thread-safe.
+    [[nodiscard]] int doneCount() const { return m_done.size() + m_released_count; }
 
     enum class Operation { ADDED, REMOVED, CHANGED };
     void updateStepProgress(TaskStepProgress const& changed_progress, Operation);
@@ -93,6 +105,9 @@ class ConcurrentTask : public Task {
 
     void startSubTask(Task::Ptr task);
 
+    /** Marks the step as changed, to be reported on the next progress tick. */
+    void scheduleProgress(const QUuid& uid);
+
    protected:
     QString m_name;
     QString m_step_status;
@@ -108,6 +123,16 @@ class ConcurrentTask : public Task {
 
     int m_total_max_size;
 
+    bool m_keep_succeeded = true;
+    // succeeded subtasks that were released instead of being kept in m_done / m_succeeded
+    int m_released_count = 0;
+
     qint64 m_stepProgress = 0;
     qint64 m_stepTotalProgress = 100;
+
+    // subtasks can report progress many thousands of times a second, so it's only passed on at a fixed rate
+    static constexpr int PROGRESS_TICK_MS = 1000 / 30;
+    QTimer m_progress_timer;
+    QSet<QUuid> m_dirty_progress;
+    QUuid m_last_progress_uid;
 };
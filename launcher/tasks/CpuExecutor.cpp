@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "CpuExecutor.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQueue>
+#include <QThread>
+#include <QThreadPool>
+
+#include <array>
+#include <atomic>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace CpuExecutor {
+
+namespace {
+
+std::atomic<int> s_running_games{ 0 };
+
+void setThreadYielding(bool yielding)
+{
+#if defined(Q_OS_WIN)
+    // also lowers the thread's I/O and memory priority
+    SetThreadPriority(GetCurrentThread(), yielding ? THREAD_MODE_BACKGROUND_BEGIN : THREAD_MODE_BACKGROUND_END);
+#elif defined(Q_OS_LINUX)
+    // the idle class only gets the disk when nobody else is using it, "none" goes back to deriving it from the CPU priority
+    constexpr int IOPRIO_WHO_PROCESS = 1;
+    constexpr int IOPRIO_CLASS_IDLE = 3;
+    constexpr int IOPRIO_CLASS_SHIFT = 13;
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, yielding ? IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT : 0);
+#else
+    if (auto thread = QThread::currentThread())
+        thread->setPriority(yielding ? QThread::LowestPriority : QThread::NormalPriority);
+#endif
+}
+
+class Scheduler {
+   public:
+    Scheduler()
+    {
+        // at least two, so there's always a worker left for interactive work
+        m_pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount()));
+    }
+
+    int maxThreadCount() const { return m_pool.maxThreadCount(); }
+
+    void post(Priority priority, std::function<void()> job)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_queues[static_cast<int>(priority)].enqueue(std::move(job));
+        dispatch();
+    }
+
+    void gameStopped()
+    {
+        QMutexLocker locker(&m_mutex);
+        dispatch();
+    }
+
+   private:
+    class Worker : public QRunnable {
+       public:
+        Worker(Scheduler* scheduler, std::function<void()> job, bool low_priority)
+            : m_scheduler(scheduler), m_job(std::move(job)), m_low_priority(low_priority)
+        {}
+
+        void run() override
+        {
+            if (m_low_priority) {
+                YieldToGame yield;
+                m_job();
+            } else {
+                m_job();
+            }
+            m_job = {};
+            m_scheduler->finished(m_low_priority);
+        }
+
+       private:
+        Scheduler* m_scheduler;
+        std::function<void()> m_job;
+        bool m_low_priority;
+    };
+
+    // NOTE: m_mutex must be held
+    void dispatch()
+    {
+        while (m_running < maxThreadCount()) {
+            auto& interactive = m_queues[static_cast<int>(Priority::Interactive)];
+            if (!interactive.isEmpty()) {
+                start(interactive.dequeue(), false);
+                continue;
+            }
+
+            if (m_running_low_priority >= (gameRunning() ? 1 : maxThreadCount() - 1))
+                return;
+
+            auto& background = m_queues[static_cast<int>(Priority::Background)];
+            auto& bulk = m_queues[static_cast<int>(Priority::Bulk)];
+            if (!background.isEmpty()) {
+                start(background.dequeue(), true);
+            } else if (!bulk.isEmpty()) {
+                start(bulk.dequeue(), true);
+            } else {
+                return;
+            }
+        }
+    }
+
+    // NOTE: m_mutex must be held
+    void start(std::function<void()> job, bool low_priority)
+    {
+        m_running++;
+        if (low_priority)
+            m_running_low_priority++;
+        m_pool.start(new Worker(this, std::move(job), low_priority));
+    }
+
+    void finished(bool low_priority)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_running--;
+        if (low_priority)
+            m_running_low_priority--;
+        dispatch();
+    }
+
+   private:
+    QThreadPool m_pool;
+
+    QMutex m_mutex;
+    std::array<QQueue<std::function<void()>>, 3> m_queues;
+    int m_running = 0;
+    int m_running_low_priority = 0;
+};
+
+Scheduler* scheduler()
+{
+    static Scheduler s_scheduler;
+    return &s_scheduler;
+}
+
+}  // namespace
+
+void post(Priority priority, std::function<void()> job)
+{
+    scheduler()->post(priority, std::move(job));
+}
+
+void start(QRunnable* runnable, Priority priority)
+{
+    post(priority, [runnable] {
+        runnable->run();
+        if (runnable->autoDelete())
+            delete runnable;
+    });
+}
+
+int maxThreadCount()
+{
+    return scheduler()->maxThreadCount();
+}
+
+void setGameRunning(bool running)
+{
+    if (running) {
+        s_running_games++;
+    } else if (--s_running_games == 0) {
+        // the other workers can take background work again
+        scheduler()->gameStopped();
+    }
+}
+
+bool gameRunning()
+{
+    return s_running_games > 0;
+}
+
+YieldToGame::YieldToGame() : m_yielding(gameRunning())
+{
+    if (m_yielding)
+        setThreadYielding(true);
+}
+
+YieldToGame::~YieldToGame()
+{
+    if (m_yielding)
+        setThreadYielding(false);
+}
+
+}  // namespace CpuExecutor
+
+CpuTask::CpuTask(Work work, CpuExecutor::Priority priority, QObject* parent)
+    : Task(parent), m_work(std::move(work)), m_priority(priority)
+{
+    connect(&m_watcher, &QFutureWatcher<QString>::finished, this, [this] {
+        auto error = m_watcher.result();
+        if (error.isEmpty())
+            emitSucceeded();
+        else
+            emitFailed(error);
+    });
+}
+
+void CpuTask::executeTask()
+{
+    m_watcher.setFuture(CpuExecutor::run(m_priority, m_work));
+}
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QFuture>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QRunnable>
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+#include "tasks/Task.h"
+
+/** The launcher-wide executor for CPU-bound work.
+ *
+ *  Work is queued by priority: interactive work (what the user is looking at right now) always goes
+ *  first, then background work, then bulk work (hashing, extracting big archives...). One worker is
+ *  kept free of background and bulk work, so interactive work never has to wait for a long job to end.
+ *
+ *  All the functions here are thread-safe.
+ */
+namespace CpuExecutor {
+
+enum class Priority { Interactive, Background, Bulk };
+
+/** Queues job to run on a worker thread. */
+void post(Priority priority, std::function<void()> job);
+
+/** Queues the runnable to run on a worker thread, deleting it afterwards if it's set to auto-delete. */
+void start(QRunnable* runnable, Priority priority);
+
+/** How many workers there are in total, including the one kept for interactive work. */
+int maxThreadCount();
+
+/** Called as games start and stop. While any is running, background and bulk work is limited to one worker, which
+ *  runs at a lower CPU and I/O priority, so it doesn't make the game stutter. */
+void setGameRunning(bool running);
+
+/** If a game is running right now. */
+bool gameRunning();
+
+/** Lowers the current thread's CPU and I/O priority while it lives, if a game is running when it's created.
+ *
+ *  For heavy work on threads of its own, outside the executor. On Linux only the I/O priority is lowered, as an
+ *  unprivileged thread can't raise its CPU priority back afterwards.
+ */
+class YieldToGame {
+   public:
+    YieldToGame();
+    ~YieldToGame();
+
+    YieldToGame(const YieldToGame&) = delete;
+    YieldToGame& operator=(const YieldToGame&) = delete;
+
+   private:
+    bool m_yielding;
+};
+
+/** Queues func to run on a worker thread, and returns a future for its result. */
+template <typename F>
+auto run(Priority priority, F func) -> QFuture<std::invoke_result_t<F>>
+{
+    using Result = std::invoke_result_t<F>;
+
+    auto promise = std::make_shared<QFutureInterface<Result>>();
+    promise->reportStarted();
+    post(priority, [promise, func = std::move(func)]() mutable {
+        if constexpr (std::is_void_v<Result>) {
+            func();
+        } else {
+            promise->reportResult(func());
+        }
+        promise->reportFinished();
+    });
+    return promise->future();
+}
+
+}  // namespace CpuExecutor
+
+/** A Task that runs a CPU-bound function on the CpuExecutor.
+ *
+ *  The function returns an error message, or an empty string on success, and the task finishes
+ *  accordingly back on the thread it was started on.
+ */
+class CpuTask : public Task {
+    Q_OBJECT
+   public:
+    using Ptr = shared_qobject_ptr<CpuTask>;
+    using Work = std::function<QString()>;
+
+    explicit CpuTask(Work work, CpuExecutor::Priority priority = CpuExecutor::Priority::Background, QObject* parent = nullptr);
+
+   protected:
+    void executeTask() override;
+
+   private:
+    Work m_work;
+    CpuExecutor::Priority m_priority;
+    QFutureWatcher<QString> m_watcher;
+};
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "DependencyTask.h"
+
+#include <QDebug>
+
+DependencyTask::DependencyTask(QObject* parent, QString task_name, int max_concurrent) : ConcurrentTask(parent, task_name, max_concurrent)
+{
+    // finished subtasks are what tells the waiting ones they can start
+    setKeepSucceededTasks(true);
+}
+
+void DependencyTask::addTask(Task::Ptr task, QList<Task::Ptr> dependencies)
+{
+    if (!dependencies.isEmpty())
+        m_dependencies.insert(task.get(), dependencies);
+    ConcurrentTask::addTask(task);
+}
+
+bool DependencyTask::isReady(const Task::Ptr& task) const
+{
+    for (auto const& dependency : m_dependencies.value(task.get())) {
+        if (!m_succeeded.contains(dependency.get()) && !dependency->wasSuccessful())
+            return false;
+    }
+    return true;
+}
+
+void DependencyTask::executeNextSubTask()
+{
+    if (!isRunning() || m_queue.isEmpty()) {
+        ConcurrentTask::executeNextSubTask();
+        return;
+    }
+
+    // one subtask finishing can unblock several others, so start everything that's ready
+    for (auto i = 0; i < m_queue.size() && m_doing.count() < m_total_max_size;) {
+        if (isReady(m_queue.at(i))) {
+            startSubTask(m_queue.takeAt(i));
+        } else {
+            i++;
+        }
+    }
+
+    if (m_doing.isEmpty() && !m_queue.isEmpty()) {
+        // nothing runs and nothing can start, a dependency is missing or there's a cycle
+        qWarning() << "DependencyTask:" << m_queue.size() << "subtask(s) are waiting on dependencies that will never succeed";
+        emitFailed(tr("Some steps depend on steps that could not be done"));
+    }
+}
+
+void DependencyTask::subTaskFailed(Task::Ptr task, const QString& msg)
+{
+    emitFailed(msg);
+    qWarning() << msg;
+
+    // the steps still running can't make up for it anymore
+    for (auto const& running : m_doing.values()) {
+        if (running != task && running->canAbort())
+            running->abort();
+    }
+
+    ConcurrentTask::subTaskFailed(task, msg);
+}
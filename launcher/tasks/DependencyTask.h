@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+
+#include "ConcurrentTask.h"
+
+/** A concurrent task whose subtasks can depend on each other.
+ *
+ *  Each subtask starts as soon as all the subtasks it depends on have succeeded, so independent
+ *  steps run side by side and the whole task takes as long as its longest chain of dependencies.
+ *  Like SequentialTask, the first failure fails the whole task.
+ */
+class DependencyTask : public ConcurrentTask {
+    Q_OBJECT
+   public:
+    explicit DependencyTask(QObject* parent = nullptr, QString task_name = "", int max_concurrent = 6);
+    ~DependencyTask() override = default;
+
+    /** Adds a subtask that only starts once all of dependencies have succeeded.
+     *  Dependencies that were not added to this task only need to have succeeded on their own.
+     */
+    void addTask(Task::Ptr task, QList<Task::Ptr> dependencies = {});
+
+   protected slots:
+    void executeNextSubTask() override;
+    void subTaskFailed(Task::Ptr, const QString& msg) override;
+
+   private:
+    bool isReady(const Task::Ptr& task) const;
+
+   private:
+    QHash<Task*, QList<Task::Ptr>> m_dependencies;
+};
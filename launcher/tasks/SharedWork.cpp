@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "SharedWork.h"
+
+#include <QHash>
+#include <QPointer>
+
+#include "tasks/Task.h"
+
+namespace SharedWork {
+
+namespace {
+QHash<QString, QPointer<Task>> s_claims;
+}  // namespace
+
+Task* claim(const QString& key, Task* task)
+{
+    if (auto owner = s_claims.value(key); owner && owner->isRunning())
+        return owner;
+
+    s_claims.insert(key, task);
+    auto release = [key, task] {
+        if (s_claims.value(key) == task)
+            s_claims.remove(key);
+    };
+    // connected before any follower is, so the key is free by the time they hear of it
+    QObject::connect(task, &Task::succeeded, task, release);
+    QObject::connect(task, &Task::failed, task, release);
+    QObject::connect(task, &Task::aborted, task, release);
+    return nullptr;
+}
+
+}  // namespace SharedWork
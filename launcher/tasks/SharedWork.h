@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QString>
+
+class Task;
+
+/** Lets tasks that would do the same work at the same time share it.
+ *
+ *  The first task to claim a key does the work, and the ones that claim it while that task runs follow how it goes
+ *  instead. The key is released as soon as its task succeeds, fails or is aborted, before any follower hears of it, so
+ *  a follower can claim it again right away when it has to do the work itself after all.
+ *
+ *  Only for the main thread.
+ */
+namespace SharedWork {
+
+/** Claims key for task. Returns the task already doing that work, or nullptr if task is the one doing it now. */
+Task* claim(const QString& key, Task* task);
+
+}  // namespace SharedWork
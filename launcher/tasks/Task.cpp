@@ -38,6 +38,9 @@
 
 #include <QDebug>
 
+#include "SamplingProfiler.h"
+#include "Tracing.h"
+
 Q_LOGGING_CATEGORY(taskLogC, "launcher.task")
 
 Task::Task(QObject* parent, bool show_debug) : QObject(parent), m_show_debug(show_debug)
@@ -103,6 +106,10 @@ void Task::start()
     }
     // NOTE: only fall through to here in end states
     m_state = State::Running;
+    if (Tracing::isEnabled())
+        Tracing::begin("task", traceName(), m_uid.toString(QUuid::WithoutBraces));
+    if (SamplingProfiler::isEnabled())
+        SamplingProfiler::taskStarted(this, traceName());
     emit started();
     executeTask();
 }
@@ -116,6 +123,9 @@ void Task::emitFailed(QString reason)
     }
     m_state = State::Failed;
     m_failReason = reason;
+    if (Tracing::isEnabled())
+        Tracing::end("task", traceName(), m_uid.toString(QUuid::WithoutBraces), { { "result", "failed" }, { "reason", reason } });
+    SamplingProfiler::taskFinished(this);
     qCCritical(taskLogC) << "Task" << describe() << "failed: " << reason;
     emit failed(reason);
     emit finished();
@@ -130,6 +140,9 @@ void Task::emitAborted()
     }
     m_state = State::AbortedByUser;
     m_failReason = "Aborted.";
+    if (Tracing::isEnabled())
+        Tracing::end("task", traceName(), m_uid.toString(QUuid::WithoutBraces), { { "result", "aborted" } });
+    SamplingProfiler::taskFinished(this);
     if (m_show_debug)
         qCDebug(taskLogC) << "Task" << describe() << "aborted.";
     emit aborted();
@@ -144,6 +157,9 @@ void Task::emitSucceeded()
         return;
     }
     m_state = State::Succeeded;
+    if (Tracing::isEnabled())
+        Tracing::end("task", traceName(), m_uid.toString(QUuid::WithoutBraces), { { "result", "succeeded" } });
+    SamplingProfiler::taskFinished(this);
     if (m_show_debug)
         qCDebug(taskLogC) << "Task" << describe() << "succeeded";
     emit succeeded();
@@ -155,6 +171,14 @@ void Task::propagateStepProgress(TaskStepProgress const& task_progress)
     emit stepProgress(task_progress);
 }
 
+QString Task::traceName()
+{
+    auto name = objectName();
+    if (name.isEmpty())
+        return metaObject()->className();
+    return QString("%1 (%2)").arg(metaObject()->className(), name);
+}
+
 QString Task::describe()
 {
     QString outStr;
@@ -124,6 +124,9 @@ class Task : public QObject, public QRunnable {
    protected:
     void logWarning(const QString& line);
 
+    /** How the task is called in traces. */
+    QString traceName();
+
    private:
     QString describe();
 
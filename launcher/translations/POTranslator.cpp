@@ -132,10 +132,17 @@ class ParserArray : public QByteArray {
 void POTranslatorPrivate::reload()
 {
     QFile file(filename);
-    if (!file.open(QFile::OpenMode::enum_type::ReadOnly | QFile::OpenMode::enum_type::Text)) {
+    if (!file.open(QFile::OpenMode::enum_type::ReadOnly)) {
         qDebug() << "Failed to open PO file:" << filename;
         return;
     }
+    // go through the file in place, instead of reading it in one line at a time
+    QByteArray contents;
+    if (auto mapped = file.map(0, file.size())) {
+        contents = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), static_cast<int>(file.size()));
+    } else {
+        contents = file.readAll();
+    }
 
     QByteArray context;
     QByteArray disambiguation;
@@ -167,11 +174,13 @@ void POTranslatorPrivate::reload()
         fuzzy = nextFuzzy;
         nextFuzzy = false;
     };
-    while (!file.atEnd()) {
-        ParserArray line = file.readLine();
-        if (line.endsWith('\n')) {
-            line.resize(line.size() - 1);
+    for (int lineStart = 0; lineStart < contents.size();) {
+        auto lineEnd = contents.indexOf('\n', lineStart);
+        if (lineEnd < 0) {
+            lineEnd = contents.size();
         }
+        ParserArray line = contents.mid(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
         if (line.endsWith('\r')) {
             line.resize(line.size() - 1);
         }
@@ -277,10 +286,21 @@ POTranslator::~POTranslator()
 
 QString POTranslator::translate(const char* context, const char* sourceText, const char* disambiguation, [[maybe_unused]] int n) const
 {
+    // this runs for every tr() call, so keep reusing the same buffer for the keys
+    thread_local QByteArray key = [] {
+        QByteArray buffer;
+        buffer.reserve(256);
+        return buffer;
+    }();
+    key.truncate(0);
+    key.append(context).append('|').append(sourceText);
+
     if (disambiguation) {
-        auto disambiguationKey = QByteArray(context) + "|" + QByteArray(sourceText) + "@" + QByteArray(disambiguation);
-        auto iter = d->mapping_disambiguatrion.find(disambiguationKey);
-        if (iter != d->mapping_disambiguatrion.end()) {
+        auto& disambiguationKey = key;
+        auto keySize = key.size();
+        disambiguationKey.append('@').append(disambiguation);
+        auto iter = d->mapping_disambiguatrion.constFind(disambiguationKey);
+        if (iter != d->mapping_disambiguatrion.cend()) {
             auto& entry = *iter;
             if (entry.text.isEmpty()) {
                 qDebug() << "Translation entry has no content:" << disambiguationKey;
@@ -290,10 +310,10 @@ QString POTranslator::translate(const char* context, const char* sourceText, con
             }
             return entry.text;
         }
+        key.truncate(keySize);
     }
-    auto key = QByteArray(context) + "|" + QByteArray(sourceText);
-    auto iter = d->mapping.find(key);
-    if (iter != d->mapping.end()) {
+    auto iter = d->mapping.constFind(key);
+    if (iter != d->mapping.cend()) {
         auto& entry = *iter;
         if (entry.text.isEmpty()) {
             qDebug() << "Translation entry has no content:" << key;
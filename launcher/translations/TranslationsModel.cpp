@@ -39,6 +39,7 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
+#include <QFutureWatcher>
 #include <QLibraryInfo>
 #include <QLocale>
 #include <QTranslator>
@@ -49,6 +50,7 @@
 #include "Json.h"
 #include "net/ChecksumValidator.h"
 #include "net/NetJob.h"
+#include "tasks/CpuExecutor.h"
 
 #include "POTranslator.h"
 
@@ -172,6 +174,10 @@ struct TranslationsModel::Private {
     const QString m_system_language = m_system_locale.split('_').front();
 
     bool no_language_set = false;
+
+    // whether all the local files have been looked through, only the selected language is needed before that
+    bool m_loaded = false;
+    QFutureWatcher<QMap<QString, Language>> m_scan;
 };
 
 TranslationsModel::TranslationsModel(QString path, QObject* parent) : QAbstractListModel(parent)
@@ -179,7 +185,13 @@ TranslationsModel::TranslationsModel(QString path, QObject* parent) : QAbstractL
     d.reset(new Private);
     d->m_dir.setPath(path);
     FS::ensureFolderPathExists(path);
-    reloadLocalFiles();
+
+    // reading the index and listing the files can wait, start up with just the selected language
+    connect(&d->m_scan, &QFutureWatcher<QMap<QString, Language>>::finished, this, [this] {
+        if (!d->m_loaded)
+            applyLocalFiles(d->m_scan.result());
+    });
+    d->m_scan.setFuture(CpuExecutor::run(CpuExecutor::Priority::Background, [dir = d->m_dir] { return scanLocalFiles(dir); }));
 
     d->watcher = new QFileSystemWatcher(this);
     connect(d->watcher, &QFileSystemWatcher::directoryChanged, this, &TranslationsModel::translationDirChanged);
@@ -263,14 +275,13 @@ void readIndex(const QString& path, QMap<QString, Language>& languages)
         qCritical() << "Translations Download Failed: index file could not be parsed as json";
     }
 }
-}  // namespace
 
-void TranslationsModel::reloadLocalFiles()
+QMap<QString, Language> scanLocalFiles(const QDir& dir)
 {
     QMap<QString, Language> languages = { { defaultLangCode, Language(defaultLangCode) } };
 
-    readIndex(d->m_dir.absoluteFilePath("index_v2.json"), languages);
-    auto entries = d->m_dir.entryInfoList({ "mmc_*.qm", "*.po" }, QDir::Files | QDir::NoDotAndDotDot);
+    readIndex(dir.absoluteFilePath("index_v2.json"), languages);
+    auto entries = dir.entryInfoList({ "mmc_*.qm", "*.po" }, QDir::Files | QDir::NoDotAndDotDot);
     for (auto& entry : entries) {
         auto completeSuffix = entry.completeSuffix();
         QString langCode;
@@ -299,6 +310,34 @@ void TranslationsModel::reloadLocalFiles()
             }
         }
     }
+    return languages;
+}
+
+// what selecting a language needs to know about it, from its own files only
+std::optional<Language> findLocalLanguage(const QDir& dir, const QString& key)
+{
+    Language language(key);
+    if (key == defaultLangCode)
+        return language;
+    if (dir.exists(key + ".po")) {
+        language.localFileType = FileType::PO;
+    } else if (dir.exists("mmc_" + key + ".qm")) {
+        language.localFileType = FileType::QM;
+    } else {
+        return std::nullopt;
+    }
+    return language;
+}
+}  // namespace
+
+void TranslationsModel::reloadLocalFiles()
+{
+    applyLocalFiles(scanLocalFiles(d->m_dir));
+}
+
+void TranslationsModel::applyLocalFiles(QMap<QString, Language> languages)
+{
+    d->m_loaded = true;
 
     // changed and removed languages
     for (auto iter = d->m_languages.begin(); iter != d->m_languages.end();) {
@@ -329,7 +368,12 @@ void TranslationsModel::reloadLocalFiles()
     for (auto& language : languages) {
         d->m_languages.append(language);
     }
-    std::sort(d->m_languages.begin(), d->m_languages.end(), [this](const Language& a, const Language& b) {
+    // looking up native names takes a while, don't do it for every comparison
+    QHash<QString, QString> names;
+    for (auto& language : d->m_languages) {
+        names.insert(language.key, language.languageName().toLower());
+    }
+    std::sort(d->m_languages.begin(), d->m_languages.end(), [this, &names](const Language& a, const Language& b) {
         if (a.key != b.key) {
             if (a.key == d->m_system_locale || a.key == d->m_system_language) {
                 return true;
@@ -338,7 +382,7 @@ void TranslationsModel::reloadLocalFiles()
                 return false;
             }
         }
-        return a.languageName().toLower() < b.languageName().toLower();
+        return names.value(a.key) < names.value(b.key);
     });
     endInsertRows();
 }
@@ -419,6 +463,9 @@ int TranslationsModel::columnCount([[maybe_unused]] const QModelIndex& parent) c
 
 QVector<Language>::Iterator TranslationsModel::findLanguage(const QString& key)
 {
+    if (!d->m_loaded) {
+        reloadLocalFiles();
+    }
     return std::find_if(d->m_languages.begin(), d->m_languages.end(), [&](Language& lang) { return lang.key == key; });
 }
 
@@ -439,7 +486,14 @@ void TranslationsModel::setUseSystemLocale(bool useSystemLocale)
 bool TranslationsModel::selectLanguage(QString key)
 {
     QString& langCode = key;
-    auto langPtr = findLanguageAsOptional(key);
+    std::optional<Language> langPtr;
+    // at startup, the language's own files are enough to go on
+    if (!d->m_loaded && !key.isEmpty()) {
+        langPtr = findLocalLanguage(d->m_dir, key);
+    }
+    if (!langPtr.has_value()) {
+        langPtr = findLanguageAsOptional(key);
+    }
 
     if (langCode.isEmpty()) {
         d->no_language_set = true;
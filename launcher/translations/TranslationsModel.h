@@ -16,6 +16,7 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QMap>
 #include <memory>
 #include <optional>
 
@@ -44,6 +45,7 @@ class TranslationsModel : public QAbstractListModel {
     QVector<Language>::Iterator findLanguage(const QString& key);
     std::optional<Language> findLanguageAsOptional(const QString& key);
     void reloadLocalFiles();
+    void applyLocalFiles(QMap<QString, Language> languages);
     void downloadTranslation(QString key);
     void downloadNext();
 
@@ -67,6 +67,7 @@
 #include <QProgressDialog>
 #include <QShortcut>
 #include <QStatusBar>
+#include <QTimer>
 #include <QToolBar>
 #include <QToolButton>
 #include <QWidget>
@@ -109,6 +110,7 @@
 #include "ui/themes/ThemeManager.h"
 #include "ui/widgets/LabeledToolButton.h"
 
+#include "minecraft/InstanceRepairTask.h"
 #include "minecraft/PackProfile.h"
 #include "minecraft/VersionFile.h"
 #include "minecraft/WorldList.h"
@@ -124,6 +126,7 @@
 
 #include "KonamiCode.h"
 
+#include "CacheCleanupTask.h"
 #include "InstanceCopyTask.h"
 
 #include "Json.h"
@@ -381,10 +384,12 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
     // TODO: refresh accounts here?
     // auto accounts = APPLICATION->accounts();
 
-    // load the news
+    // load the news, once the window had a chance to show up
     {
-        m_newsChecker->reloadNews();
-        updateNewsLabel();
+        QTimer::singleShot(0, this, [this] {
+            m_newsChecker->reloadNews();
+            updateNewsLabel();
+        });
     }
 
     if (APPLICATION->updaterEnabled()) {
@@ -871,6 +876,24 @@ void MainWindow::on_actionCopyInstance_triggered()
     runModalTask(task.get());
 }
 
+void MainWindow::on_actionRepairInstance_triggered()
+{
+    auto inst = std::dynamic_pointer_cast<MinecraftInstance>(m_selectedInstance);
+    if (!inst)
+        return;
+    if (inst->isRunning()) {
+        CustomMessageBox::selectable(this, tr("Instance is running"), tr("Close the game before repairing the instance."), QMessageBox::Warning)
+            ->show();
+        return;
+    }
+
+    auto task = makeShared<InstanceRepairTask>(inst);
+    connect(task.get(), &Task::succeeded, this, [this, repair = task.get()] {
+        CustomMessageBox::selectable(this, tr("Instance verified"), repair->summary(), QMessageBox::Information)->show();
+    });
+    runModalTask(task.get());
+}
+
 void MainWindow::finalizeInstance(InstancePtr inst)
 {
     view->updateGeometries();
@@ -1303,6 +1326,16 @@ void MainWindow::on_actionClearMetadata_triggered()
     APPLICATION->metacache()->SaveNow();
 }
 
+void MainWindow::on_actionCleanUpCache_triggered()
+{
+    auto budget = APPLICATION->settings()->get("CacheSizeLimit").toLongLong() * 1024 * 1024;
+    auto task = makeShared<CacheCleanupTask>(budget);
+    connect(task.get(), &Task::succeeded, this, [this, cleanup = task.get()] {
+        CustomMessageBox::selectable(this, tr("Cache cleaned up"), cleanup->summary(), QMessageBox::Information)->show();
+    });
+    runModalTask(task.get());
+}
+
 #ifdef Q_OS_MAC
 void MainWindow::on_actionAddToPATH_triggered()
 {
@@ -1391,10 +1424,15 @@ void MainWindow::on_actionDeleteInstance_triggered()
             return;
     }
 
+    // the instance is gone from the list as soon as it's being deleted
+    auto name = m_selectedInstance->name();
     if (APPLICATION->instances()->trashInstance(id)) {
         ui->actionUndoTrashInstance->setEnabled(APPLICATION->instances()->trashedSomething());
-    } else {
-        APPLICATION->instances()->deleteInstance(id);
+    } else if (auto task = APPLICATION->instances()->deleteInstance(id)) {
+        connect(task.get(), &Task::progress, this, [this, name](qint64 current, qint64 total) {
+            statusBar()->showMessage(tr("Deleting %1... %2%").arg(name).arg(total > 0 ? current * 100 / total : 0));
+        });
+        connect(task.get(), &Task::finished, statusBar(), &QStatusBar::clearMessage);
     }
     APPLICATION->settings()->set("SelectedInstance", QString());
     selectionBad();
@@ -1786,6 +1824,7 @@ void MainWindow::setInstanceActionsEnabled(bool enabled)
     ui->actionExportInstance->setEnabled(enabled);
     ui->actionDeleteInstance->setEnabled(enabled);
     ui->actionCopyInstance->setEnabled(enabled);
+    ui->actionRepairInstance->setEnabled(enabled);
     ui->actionCreateInstanceShortcut->setEnabled(enabled);
 }
 
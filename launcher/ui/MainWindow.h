@@ -105,6 +105,8 @@ class MainWindow : public QMainWindow {
 
     void on_actionCopyInstance_triggered();
 
+    void on_actionRepairInstance_triggered();
+
     void on_actionChangeInstGroup_triggered();
 
     void on_actionChangeInstIcon_triggered();
@@ -134,6 +136,8 @@ class MainWindow : public QMainWindow {
 
     void on_actionClearMetadata_triggered();
 
+    void on_actionCleanUpCache_triggered();
+
 #ifdef Q_OS_MAC
     void on_actionAddToPATH_triggered();
 #endif
@@ -39,9 +39,31 @@
 #include <QFileInfo>
 #include <QMimeData>
 #include <QPushButton>
+#include <QSet>
 #include <QStandardPaths>
 #include <QTimer>
 
+// super lax name (but not fuzzy)
+// convert to lowercase
+// convert all speratores to whitespace
+// simplify sequence of internal whitespace to a single space
+// efectivly two names are equal when they only differ in separators and case
+static QString laxName(QString filename)
+{
+    // allowed character seperators
+    QList<QChar> allowedSeperators = { '-', '+', '.', '_' };
+
+    // copy in lowercase
+    auto name = filename.toLower();
+
+    // replace all potential allowed seperatores with whitespace
+    for (auto sep : allowedSeperators)
+        name = name.replace(sep, ' ');
+
+    // remove extraneous whitespace
+    return name.simplified();
+}
+
 BlockedModsDialog::BlockedModsDialog(QWidget* parent, const QString& title, const QString& text, QList<BlockedMod>& mods, QString hash_type)
     : QDialog(parent), ui(new Ui::BlockedModsDialog), m_mods(mods), m_hash_type(hash_type)
 {
@@ -61,6 +83,9 @@ BlockedModsDialog::BlockedModsDialog(QWidget* parent, const QString& title, cons
 
     qDebug() << "[Blocked Mods Dialog] Mods List: " << mods;
 
+    for (auto& mod : m_mods)
+        m_lax_names.append(laxName(mod.name));
+
     // defer setup of file system watchers until after the dialog is shown
     // this allows OS (namely macOS) permission prompts to show after the relevant dialog appears
     QTimer::singleShot(0, this, [this] {
@@ -237,6 +262,7 @@ void BlockedModsDialog::scanPaths()
 void BlockedModsDialog::scanPath(QString path, bool start_task)
 {
     QDir scan_dir(path);
+    QSet<QString> seen;
     QDirIterator scan_it(path, QDir::Filter::Files | QDir::Filter::Hidden, QDirIterator::NoIteratorFlags);
     while (scan_it.hasNext()) {
         QString file = scan_it.next();
@@ -244,10 +270,25 @@ void BlockedModsDialog::scanPath(QString path, bool start_task)
         if (!checkValidPath(file)) {
             continue;
         }
+        seen.insert(file);
+
+        // a change to one file shouldn't make us hash the whole folder again
+        auto identity = Hashing::FileIdentity::of(file);
+        if (auto scanned = m_scanned_files.constFind(file); scanned != m_scanned_files.constEnd() && *scanned == identity)
+            continue;
+        m_scanned_files.insert(file, identity);
 
         addHashTask(file);
     }
 
+    // forget the files that are gone, so they are looked at again if they come back
+    for (auto it = m_scanned_files.begin(); it != m_scanned_files.end();) {
+        if (!seen.contains(it.key()) && QFileInfo(it.key()).absolutePath() == scan_dir.absolutePath())
+            it = m_scanned_files.erase(it);
+        else
+            ++it;
+    }
+
     if (start_task) {
         runHashTask();
     }
@@ -318,48 +359,31 @@ bool BlockedModsDialog::checkValidPath(QString path)
         return metadataFilename.compare(fsFilename, Qt::CaseInsensitive) == 0;
     };
 
-    // super lax compare (but not fuzzy)
-    // convert to lowercase
-    // convert all speratores to whitespace
-    // simplify sequence of internal whitespace to a single space
-    // efectivly compare two strings ignoring all separators and case
-    auto laxCompare = [](QString fsfilename, QString metadataFilename) {
-        // allowed character seperators
-        QList<QChar> allowedSeperators = { '-', '+', '.', '_' };
-
-        // copy in lowercase
-        auto fsName = fsfilename.toLower();
-        auto metaName = metadataFilename.toLower();
-
-        // replace all potential allowed seperatores with whitespace
-        for (auto sep : allowedSeperators) {
-            fsName = fsName.replace(sep, ' ');
-            metaName = metaName.replace(sep, ' ');
-        }
-
-        // remove extraneous whitespace
-        fsName = fsName.simplified();
-        metaName = metaName.simplified();
+    const QString lax_filename = laxName(filename);
 
-        return fsName.compare(metaName) == 0;
-    };
+    for (int i = 0; i < m_mods.size(); i++) {
+        auto& mod = m_mods[i];
+        auto exact = compare(filename, mod.name);
+        if (!exact && lax_filename != m_lax_names[i])
+            continue;
 
-    for (auto& mod : m_mods) {
-        if (compare(filename, mod.name)) {
-            // if the mod is not yet matched and doesn't have a hash then
-            // just match it with the file that has the exact same name
-            if (!mod.matched && mod.hash.isEmpty()) {
-                mod.matched = true;
-                mod.localPath = path;
-                return false;
-            }
-            qDebug() << "[Blocked Mods Dialog] Name match found:" << mod.name << "| From path:" << path;
-            return true;
+        // if the mod is not yet matched and doesn't have a hash then
+        // just match it with the file that has the exact same name
+        if (exact && !mod.matched && mod.hash.isEmpty()) {
+            mod.matched = true;
+            mod.localPath = path;
+            return false;
         }
-        if (laxCompare(filename, mod.name)) {
-            qDebug() << "[Blocked Mods Dialog] Lax name match found:" << mod.name << "| From path:" << path;
-            return true;
+        // a file of another size can't be the one we're looking for, so it isn't worth hashing
+        if (mod.size >= 0 && file.size() != mod.size) {
+            qDebug() << "[Blocked Mods Dialog] Name match with the wrong size:" << mod.name << "| From path:" << path;
+            continue;
         }
+        if (exact)
+            qDebug() << "[Blocked Mods Dialog] Name match found:" << mod.name << "| From path:" << path;
+        else
+            qDebug() << "[Blocked Mods Dialog] Lax name match found:" << mod.name << "| From path:" << path;
+        return true;
     }
 
     return false;
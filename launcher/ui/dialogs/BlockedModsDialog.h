@@ -31,6 +31,7 @@
 
 #include <QFileSystemWatcher>
 
+#include "modplatform/helpers/HashCache.h"
 #include "tasks/ConcurrentTask.h"
 
 class QPushButton;
@@ -42,6 +43,8 @@ struct BlockedMod {
     bool matched;
     QString localPath;
     QString targetFolder;
+    // the expected size in bytes, or -1 if it isn't known
+    qint64 size = -1;
 };
 
 QT_BEGIN_NAMESPACE
@@ -71,6 +74,10 @@ class BlockedModsDialog : public QDialog {
     QFileSystemWatcher m_watcher;
     shared_qobject_ptr<ConcurrentTask> m_hashing_task;
     QSet<QString> m_pending_hash_paths;
+    // the candidate files seen so far, so only new and changed ones are hashed again
+    QHash<QString, Hashing::FileIdentity> m_scanned_files;
+    // the lax names of m_mods, in the same order
+    QStringList m_lax_names;
     bool m_rehash_pending;
     QPushButton* m_openMissingButton;
     QString m_hash_type;
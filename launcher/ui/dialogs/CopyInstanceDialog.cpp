@@ -176,19 +176,28 @@ void CopyInstanceDialog::updateSelectAllCheckbox()
 
 void CopyInstanceDialog::updateUseCloneCheckbox()
 {
-    ui->useCloneCheckbox->setEnabled(m_cloneSupported && !ui->symbolicLinksCheckbox->isChecked() && !ui->hardLinksCheckbox->isChecked());
+    ui->useCloneCheckbox->setEnabled(m_cloneSupported && !ui->symbolicLinksCheckbox->isChecked() && !ui->hardLinksCheckbox->isChecked() &&
+                                     !ui->useOverlayCheckbox->isChecked());
     ui->useCloneCheckbox->setChecked(m_cloneSupported && m_selectedOptions.isUseCloneEnabled() && !ui->symbolicLinksCheckbox->isChecked() &&
-                                     !ui->hardLinksCheckbox->isChecked());
+                                     !ui->hardLinksCheckbox->isChecked() && !ui->useOverlayCheckbox->isChecked());
 }
 
 void CopyInstanceDialog::updateLinkOptions()
 {
-    ui->symbolicLinksCheckbox->setEnabled(m_linkSupported && !ui->hardLinksCheckbox->isChecked() && !ui->useCloneCheckbox->isChecked());
-    ui->hardLinksCheckbox->setEnabled(m_linkSupported && !ui->symbolicLinksCheckbox->isChecked() && !ui->useCloneCheckbox->isChecked());
+    bool overlay = ui->useOverlayCheckbox->isChecked();
+    ui->symbolicLinksCheckbox->setEnabled(m_linkSupported && !ui->hardLinksCheckbox->isChecked() && !ui->useCloneCheckbox->isChecked() &&
+                                          !overlay);
+    ui->hardLinksCheckbox->setEnabled(m_linkSupported && !ui->symbolicLinksCheckbox->isChecked() && !ui->useCloneCheckbox->isChecked() &&
+                                      !overlay);
 
     ui->symbolicLinksCheckbox->setChecked(m_linkSupported && m_selectedOptions.isUseSymLinksEnabled() &&
-                                          !ui->useCloneCheckbox->isChecked());
-    ui->hardLinksCheckbox->setChecked(m_linkSupported && m_selectedOptions.isUseHardLinksEnabled() && !ui->useCloneCheckbox->isChecked());
+                                          !ui->useCloneCheckbox->isChecked() && !overlay);
+    ui->hardLinksCheckbox->setChecked(m_linkSupported && m_selectedOptions.isUseHardLinksEnabled() && !ui->useCloneCheckbox->isChecked() &&
+                                      !overlay);
+
+    ui->useOverlayCheckbox->setEnabled(!ui->symbolicLinksCheckbox->isChecked() && !ui->hardLinksCheckbox->isChecked() &&
+                                       !ui->useCloneCheckbox->isChecked());
+    ui->useOverlayCheckbox->setChecked(m_selectedOptions.isUseOverlayEnabled() && ui->useOverlayCheckbox->isEnabled());
 
     bool linksInUse = (ui->symbolicLinksCheckbox->isChecked() || ui->hardLinksCheckbox->isChecked());
     ui->recursiveLinkCheckbox->setEnabled(m_linkSupported && linksInUse && !ui->hardLinksCheckbox->isChecked());
@@ -308,3 +317,10 @@ void CopyInstanceDialog::on_useCloneCheckbox_stateChanged(int state)
     updateUseCloneCheckbox();
     updateLinkOptions();
 }
+
+void CopyInstanceDialog::on_useOverlayCheckbox_stateChanged(int state)
+{
+    m_selectedOptions.enableUseOverlay(state == Qt::Checked);
+    updateUseCloneCheckbox();
+    updateLinkOptions();
+}
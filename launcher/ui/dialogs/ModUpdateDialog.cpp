@@ -19,6 +19,10 @@
 #include "modplatform/flame/FlameCheckUpdate.h"
 #include "modplatform/modrinth/ModrinthCheckUpdate.h"
 
+#include "net/ApiDownload.h"
+#include "net/ContentStore.h"
+
+#include <QTemporaryDir>
 #include <QTextBrowser>
 #include <QTreeWidgetItem>
 
@@ -45,8 +49,6 @@ ModUpdateDialog::ModUpdateDialog(QWidget* parent,
     , m_parent(parent)
     , m_mod_model(mods)
     , m_candidates(search_for)
-    , m_second_try_metadata(
-          new ConcurrentTask(nullptr, "Second Metadata Search", APPLICATION->settings()->get("NumberOfConcurrentTasks").toInt()))
     , m_instance(instance)
     , m_include_deps(includeDeps)
 {
@@ -89,7 +91,8 @@ void ModUpdateDialog::checkCandidates()
     auto versions = mcVersions(m_instance);
     auto loaders = mcLoaders(m_instance);
 
-    SequentialTask check_task(m_parent, tr("Checking for updates"));
+    // the providers don't depend on each other
+    ConcurrentTask check_task(m_parent, tr("Checking for updates"));
 
     if (!m_modrinth_to_update.empty()) {
         m_modrinth_check_task.reset(new ModrinthCheckUpdate(m_modrinth_to_update, versions, loaders, m_mod_model));
@@ -256,6 +259,59 @@ void ModUpdateDialog::checkCandidates()
 
     if (m_aborted || m_no_updates)
         QMetaObject::invokeMethod(this, "reject", Qt::QueuedConnection);
+    else
+        prefetchUpdates();
+}
+
+void ModUpdateDialog::prefetchUpdates()
+{
+    m_prefetch_dir.reset(new QTemporaryDir);
+    if (!m_prefetch_dir->isValid())
+        return;
+
+    m_prefetch_job.reset(new NetJob(tr("Mod update prefetch"), APPLICATION->network()));
+    int i = 0;
+    for (auto& task : m_tasks) {
+        auto& version = task->getVersion();
+        QCryptographicHash::Algorithm algorithm;
+        // only what ends up in the store is of any use later
+        if (version.downloadUrl.isEmpty() || version.hash.isEmpty() || !Net::ContentStore::algorithmFor(version.hash_type, algorithm) ||
+            APPLICATION->contentStore()->contains(algorithm, version.hash.toLower()))
+            continue;
+        auto path = m_prefetch_dir->filePath(QString::number(i++));
+        m_prefetch_job->addNetAction(Net::ApiDownload::makeStored(version.downloadUrl, path, version.hash_type, version.hash));
+    }
+    if (m_prefetch_job->size() == 0) {
+        m_prefetch_job.reset();
+        return;
+    }
+
+    // the store keeps its own copies, the downloaded files aren't needed anymore
+    connect(m_prefetch_job.get(), &Task::finished, this, [this] {
+        m_prefetch_job.reset();
+        m_prefetch_dir.reset();
+    });
+    m_prefetch_job->start();
+}
+
+void ModUpdateDialog::done(int result)
+{
+    // whatever isn't there yet is downloaded by the updates themselves
+    if (m_prefetch_job)
+        m_prefetch_job->abort();
+    ReviewMessageBox::done(result);
+}
+
+ModPlatform::ResourceProvider next(ModPlatform::ResourceProvider p)
+{
+    switch (p) {
+        case ModPlatform::ResourceProvider::MODRINTH:
+            return ModPlatform::ResourceProvider::FLAME;
+        case ModPlatform::ResourceProvider::FLAME:
+            return ModPlatform::ResourceProvider::MODRINTH;
+    }
+
+    return ModPlatform::ResourceProvider::FLAME;
 }
 
 // Part 1: Ensure we have a valid metadata
@@ -263,7 +319,7 @@ auto ModUpdateDialog::ensureMetadata() -> bool
 {
     auto index_dir = indexDir();
 
-    SequentialTask seq(m_parent, tr("Looking for metadata"));
+    ConcurrentTask metadata_tasks(m_parent, tr("Looking for metadata"));
 
     // A better use of data structures here could remove the need for this QHash
     QHash<QString, bool> should_try_others;
@@ -328,42 +384,32 @@ auto ModUpdateDialog::ensureMetadata() -> bool
             addToTmp(candidate, response.chosen);
     }
 
-    if (!modrinth_tmp.empty()) {
-        auto modrinth_task = makeShared<EnsureMetadataTask>(modrinth_tmp, index_dir, ModPlatform::ResourceProvider::MODRINTH);
-        connect(modrinth_task.get(), &EnsureMetadataTask::metadataReady, [this](Mod* candidate) { onMetadataEnsured(candidate); });
-        connect(modrinth_task.get(), &EnsureMetadataTask::metadataFailed, [this, &should_try_others](Mod* candidate) {
-            onMetadataFailed(candidate, should_try_others.find(candidate->internal_id()).value(), ModPlatform::ResourceProvider::MODRINTH);
-        });
-        connect(modrinth_task.get(), &EnsureMetadataTask::failed,
-                [this](QString reason) { CustomMessageBox::selectable(this, tr("Error"), reason, QMessageBox::Critical)->exec(); });
-
-        if (modrinth_task->getHashingTask())
-            seq.addTask(modrinth_task->getHashingTask());
-
-        seq.addTask(modrinth_task);
-    }
-
-    if (!flame_tmp.empty()) {
-        auto flame_task = makeShared<EnsureMetadataTask>(flame_tmp, index_dir, ModPlatform::ResourceProvider::FLAME);
-        connect(flame_task.get(), &EnsureMetadataTask::metadataReady, [this](Mod* candidate) { onMetadataEnsured(candidate); });
-        connect(flame_task.get(), &EnsureMetadataTask::metadataFailed, [this, &should_try_others](Mod* candidate) {
-            onMetadataFailed(candidate, should_try_others.find(candidate->internal_id()).value(), ModPlatform::ResourceProvider::FLAME);
-        });
-        connect(flame_task.get(), &EnsureMetadataTask::failed,
+    // Both providers are asked at once, and those that may try the other provider are also looked up there right away
+    auto addMetadataTask = [&](QList<Mod*> mods, ModPlatform::ResourceProvider provider, bool try_others) {
+        if (mods.empty())
+            return;
+        auto task = makeShared<EnsureMetadataTask>(mods, index_dir, provider, try_others ? next(provider) : provider);
+        connect(task.get(), &EnsureMetadataTask::metadataReady, [this](Mod* candidate) { onMetadataEnsured(candidate); });
+        connect(task.get(), &EnsureMetadataTask::metadataFailed, [this](Mod* candidate) { onMetadataFailed(candidate); });
+        connect(task.get(), &EnsureMetadataTask::failed,
                 [this](QString reason) { CustomMessageBox::selectable(this, tr("Error"), reason, QMessageBox::Critical)->exec(); });
+        metadata_tasks.addTask(task);
+    };
 
-        if (flame_task->getHashingTask())
-            seq.addTask(flame_task->getHashingTask());
-
-        seq.addTask(flame_task);
+    for (auto provider : { ModPlatform::ResourceProvider::MODRINTH, ModPlatform::ResourceProvider::FLAME }) {
+        auto& tmp = provider == ModPlatform::ResourceProvider::MODRINTH ? modrinth_tmp : flame_tmp;
+        QList<Mod*> with_others;
+        QList<Mod*> alone;
+        for (auto* mod : tmp)
+            (should_try_others.value(mod->internal_id()) ? with_others : alone).append(mod);
+        addMetadataTask(with_others, provider, true);
+        addMetadataTask(alone, provider, false);
     }
 
-    seq.addTask(m_second_try_metadata);
-
     ProgressDialog checking_dialog(m_parent);
     checking_dialog.setSkipButton(true, tr("Abort"));
     checking_dialog.setWindowTitle(tr("Generating metadata..."));
-    auto ret_metadata = checking_dialog.execWithTask(&seq);
+    auto ret_metadata = checking_dialog.execWithTask(&metadata_tasks);
 
     return (ret_metadata != QDialog::DialogCode::Rejected);
 }
@@ -384,35 +430,11 @@ void ModUpdateDialog::onMetadataEnsured(Mod* mod)
     }
 }
 
-ModPlatform::ResourceProvider next(ModPlatform::ResourceProvider p)
+void ModUpdateDialog::onMetadataFailed(Mod* mod)
 {
-    switch (p) {
-        case ModPlatform::ResourceProvider::MODRINTH:
-            return ModPlatform::ResourceProvider::FLAME;
-        case ModPlatform::ResourceProvider::FLAME:
-            return ModPlatform::ResourceProvider::MODRINTH;
-    }
-
-    return ModPlatform::ResourceProvider::FLAME;
-}
-
-void ModUpdateDialog::onMetadataFailed(Mod* mod, bool try_others, ModPlatform::ResourceProvider first_choice)
-{
-    if (try_others) {
-        auto index_dir = indexDir();
+    QString reason{ tr("Couldn't find a valid version on the selected mod provider(s)") };
 
-        auto task = makeShared<EnsureMetadataTask>(mod, index_dir, next(first_choice));
-        connect(task.get(), &EnsureMetadataTask::metadataReady, [this](Mod* candidate) { onMetadataEnsured(candidate); });
-        connect(task.get(), &EnsureMetadataTask::metadataFailed, [this](Mod* candidate) { onMetadataFailed(candidate, false); });
-        connect(task.get(), &EnsureMetadataTask::failed,
-                [this](QString reason) { CustomMessageBox::selectable(this, tr("Error"), reason, QMessageBox::Critical)->exec(); });
-
-        m_second_try_metadata->addTask(task);
-    } else {
-        QString reason{ tr("Couldn't find a valid version on the selected mod provider(s)") };
-
-        m_failed_metadata.append({ mod, reason });
-    }
+    m_failed_metadata.append({ mod, reason });
 }
 
 void ModUpdateDialog::appendMod(CheckUpdateTask::UpdatableMod const& info, QStringList requiredBy)
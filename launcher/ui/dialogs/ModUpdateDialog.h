@@ -7,11 +7,15 @@
 #include "minecraft/mod/ModFolderModel.h"
 
 #include "modplatform/CheckUpdateTask.h"
+#include "net/NetJob.h"
+
+#include <memory>
 
 class Mod;
 class ModrinthCheckUpdate;
 class FlameCheckUpdate;
 class ConcurrentTask;
+class QTemporaryDir;
 
 class ModUpdateDialog final : public ReviewMessageBox {
     Q_OBJECT
@@ -33,14 +37,17 @@ class ModUpdateDialog final : public ReviewMessageBox {
     auto noUpdates() const -> bool { return m_no_updates; };
     auto aborted() const -> bool { return m_aborted; };
 
+   public slots:
+    void done(int result) override;
+
    private:
     auto ensureMetadata() -> bool;
+    /// downloads the updates into the content store while they are being reviewed, so installing them is quick
+    void prefetchUpdates();
 
    private slots:
     void onMetadataEnsured(Mod*);
-    void onMetadataFailed(Mod*,
-                          bool try_others = false,
-                          ModPlatform::ResourceProvider first_choice = ModPlatform::ResourceProvider::MODRINTH);
+    void onMetadataFailed(Mod*);
 
    private:
     QWidget* m_parent;
@@ -54,11 +61,12 @@ class ModUpdateDialog final : public ReviewMessageBox {
     QList<Mod*> m_modrinth_to_update;
     QList<Mod*> m_flame_to_update;
 
-    ConcurrentTask::Ptr m_second_try_metadata;
     QList<std::tuple<Mod*, QString>> m_failed_metadata;
     QList<std::tuple<Mod*, QString, QUrl>> m_failed_check_update;
 
     QHash<QString, ResourceDownloadTask::Ptr> m_tasks;
+    NetJob::Ptr m_prefetch_job;
+    std::unique_ptr<QTemporaryDir> m_prefetch_dir;
     BaseInstance* m_instance;
 
     bool m_no_updates = false;
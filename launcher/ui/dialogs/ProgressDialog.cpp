@@ -59,6 +59,12 @@ std::tuple<int, int> map_int_zero_max(T current, T range_max, T range_min)
     return { mapped_current, int_max };
 }
 
+namespace {
+constexpr int MAX_VISIBLE_STEPS = 8;
+// step progress is shown at most this often, however fast it comes in
+constexpr int STEP_REFRESH_MS = 100;
+}  // namespace
+
 ProgressDialog::ProgressDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ProgressDialog)
 {
     ui->setupUi(this);
@@ -68,6 +74,10 @@ ProgressDialog::ProgressDialog(QWidget* parent) : QDialog(parent), ui(new Ui::Pr
     changeProgress(0, 100);
     updateSize(true);
     setSkipButton(false);
+
+    m_step_refresh.setSingleShot(true);
+    m_step_refresh.setInterval(STEP_REFRESH_MS);
+    connect(&m_step_refresh, &QTimer::timeout, this, &ProgressDialog::refreshSteps);
 }
 
 void ProgressDialog::setSkipButton(bool present, QString label)
@@ -219,13 +229,6 @@ void ProgressDialog::changeStatus([[maybe_unused]] const QString& status)
     updateSize();
 }
 
-void ProgressDialog::addTaskProgress(TaskStepProgress const& progress)
-{
-    SubTaskProgressBar* task_bar = new SubTaskProgressBar(this);
-    taskProgress.insert(progress.uid, task_bar);
-    ui->taskProgressLayout->addWidget(task_bar);
-}
-
 void ProgressDialog::changeStepProgress(TaskStepProgress const& task_progress)
 {
     m_is_multi_step = true;
@@ -234,23 +237,57 @@ void ProgressDialog::changeStepProgress(TaskStepProgress const& task_progress)
         updateSize();
     }
 
-    if (!taskProgress.contains(task_progress.uid))
-        addTaskProgress(task_progress);
-    auto task_bar = taskProgress.value(task_progress.uid);
-
-    auto const [mapped_current, mapped_total] = map_int_zero_max<qint64>(task_progress.current, task_progress.total, 0);
-    if (task_progress.total <= 0) {
-        task_bar->setRange(0, 0);
+    // only the latest state of each step is kept until the next refresh
+    if (task_progress.isDone()) {
+        if (m_active_steps.remove(task_progress.uid))
+            m_step_order.removeOne(task_progress.uid);
     } else {
-        task_bar->setRange(0, mapped_total);
+        if (!m_active_steps.contains(task_progress.uid))
+            m_step_order.append(task_progress.uid);
+        m_active_steps.insert(task_progress.uid, task_progress);
     }
 
-    task_bar->setValue(mapped_current);
-    task_bar->setStatus(task_progress.status);
-    task_bar->setDetails(task_progress.details);
+    if (!m_step_refresh.isActive())
+        m_step_refresh.start();
+}
 
-    if (task_progress.isDone()) {
-        task_bar->setVisible(false);
+void ProgressDialog::refreshSteps()
+{
+    // running steps go first, those only waiting fill up what is left
+    QList<const TaskStepProgress*> shown;
+    for (auto running : { true, false }) {
+        for (auto& uid : m_step_order) {
+            auto& step = m_active_steps[uid];
+            if ((step.state == TaskStepState::Running) == running && shown.size() < MAX_VISIBLE_STEPS)
+                shown.append(&step);
+        }
+    }
+
+    while (m_step_bars.size() < shown.size()) {
+        auto task_bar = new SubTaskProgressBar(this);
+        ui->taskProgressLayout->addWidget(task_bar);
+        m_step_bars.append(task_bar);
+    }
+
+    for (int i = 0; i < m_step_bars.size(); i++) {
+        auto task_bar = m_step_bars[i];
+        if (i >= shown.size()) {
+            task_bar->setVisible(false);
+            continue;
+        }
+        auto& task_progress = *shown[i];
+
+        auto const [mapped_current, mapped_total] = map_int_zero_max<qint64>(task_progress.current, task_progress.total, 0);
+        if (task_progress.total <= 0) {
+            task_bar->setRange(0, 0);
+        } else {
+            task_bar->setRange(0, mapped_total);
+        }
+
+        task_bar->setValue(mapped_current);
+        task_bar->setStatus(task_progress.status);
+        task_bar->setDetails(task_progress.details);
+        task_bar->setVisible(true);
     }
 }
 
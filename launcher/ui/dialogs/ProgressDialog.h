@@ -37,6 +37,8 @@
 
 #include <QDialog>
 #include <QHash>
+#include <QList>
+#include <QTimer>
 #include <QUuid>
 #include <memory>
 
@@ -87,7 +89,8 @@ class ProgressDialog : public QDialog {
 
    private:
     bool handleImmediateResult(QDialog::DialogCode& result);
-    void addTaskProgress(TaskStepProgress const& progress);
+    /// shows the latest progress of the first few unfinished steps, in the bars there are
+    void refreshSteps();
 
    private:
     Ui::ProgressDialog* ui;
@@ -95,5 +98,10 @@ class ProgressDialog : public QDialog {
     Task* m_task;
 
     bool m_is_multi_step = false;
-    QHash<QUuid, SubTaskProgressBar*> taskProgress;
+    /// the steps that aren't done, and the order they came in
+    QHash<QUuid, TaskStepProgress> m_active_steps;
+    QList<QUuid> m_step_order;
+    /// no more bars than can be looked at are made, however many steps there are
+    QList<SubTaskProgressBar*> m_step_bars;
+    QTimer m_step_refresh;
 };
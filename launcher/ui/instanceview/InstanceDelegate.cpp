@@ -37,6 +37,7 @@
 #include <QApplication>
 #include <QDebug>
 #include <QPainter>
+#include <QPixmapCache>
 #include <QTextLayout>
 #include <QTextOption>
 #include <QtMath>
@@ -68,7 +69,32 @@ static void viewItemTextLayout(QTextLayout& textLayout, int lineWidth, qreal& he
     textLayout.endLayout();
 }
 
-ListViewDelegate::ListViewDelegate(QObject* parent) : QStyledItemDelegate(parent) {}
+ListViewDelegate::ListViewDelegate(QObject* parent) : QStyledItemDelegate(parent)
+{
+    // enough for every item of a large instance list
+    m_textLayouts.setMaxCost(2048);
+}
+
+const ListViewDelegate::CachedTextLayout& ListViewDelegate::textLayout(const QStyleOptionViewItem& option, int lineWidth) const
+{
+    const QString key = QString("%1:%2:%3:%4").arg(lineWidth).arg(int(option.direction)).arg(option.font.key(), option.text);
+    if (auto cached = m_textLayouts.object(key)) {
+        return *cached;
+    }
+
+    auto cached = new CachedTextLayout;
+    QTextOption textOption;
+    textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    textOption.setTextDirection(option.direction);
+    textOption.setAlignment(QStyle::visualAlignment(option.direction, option.displayAlignment));
+    cached->layout.setTextOption(textOption);
+    cached->layout.setFont(option.font);
+    cached->layout.setText(option.text);
+    qreal widthUsed = 0;
+    viewItemTextLayout(cached->layout, lineWidth, cached->height, widthUsed);
+    m_textLayouts.insert(key, cached);
+    return *cached;
+}
 
 void drawSelectionRect(QPainter* painter, const QStyleOptionViewItem& option, const QRect& rect)
 {
@@ -159,21 +185,35 @@ void drawBadges(QPainter* painter, const QStyleOptionViewItem& option, BaseInsta
     painter->translate(-option.rect.topLeft());
 }
 
-static QSize viewItemTextSize(const QStyleOptionViewItem* option)
+// same as QIcon::paint, but keeps the scaled pixmap around so repaints don't rescale the icon
+static void paintIcon(QPainter* painter, const QIcon& icon, const QRect& rect, QIcon::Mode mode, QIcon::State state)
 {
-    QStyle* style = option->widget ? option->widget->style() : QApplication::style();
-    QTextOption textOption;
-    textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
-    QTextLayout textLayout;
-    textLayout.setTextOption(textOption);
-    textLayout.setFont(option->font);
-    textLayout.setText(option->text);
-    const int textMargin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, option, option->widget) + 1;
-    QRect bounds(0, 0, 100 - 2 * textMargin, 600);
-    qreal height = 0, widthUsed = 0;
-    viewItemTextLayout(textLayout, bounds.width(), height, widthUsed);
-    const QSize size(qCeil(widthUsed), qCeil(height));
-    return QSize(size.width() + 2 * textMargin, size.height());
+    if (icon.isNull()) {
+        return;
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    const qreal dpr = painter->device()->devicePixelRatioF();
+#else
+    const qreal dpr = qApp->devicePixelRatio();
+#endif
+    const QString key = QString("InstanceIcon:%1:%2x%3:%4:%5:%6")
+                            .arg(icon.cacheKey())
+                            .arg(rect.width())
+                            .arg(rect.height())
+                            .arg(int(mode))
+                            .arg(int(state))
+                            .arg(dpr);
+    QPixmap pixmap;
+    if (!QPixmapCache::find(key, &pixmap)) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        pixmap = icon.pixmap(rect.size(), dpr, mode, state);
+#else
+        pixmap = icon.pixmap(rect.size(), mode, state);
+#endif
+        QPixmapCache::insert(key, pixmap);
+    }
+    const QSize size = pixmap.size() / pixmap.devicePixelRatio();
+    painter->drawPixmap(QStyle::alignedRect(Qt::LeftToRight, Qt::AlignCenter, size, rect), pixmap);
 }
 
 void ListViewDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
@@ -273,7 +313,7 @@ void ListViewDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opti
     // draw the icon
     {
         iconbox.setHeight(iconSize);
-        opt.icon.paint(painter, iconbox, Qt::AlignCenter, mode, state);
+        paintIcon(painter, opt.icon, iconbox, mode, state);
     }
     // set the text colors
     QPalette::ColorGroup cg = opt.state & QStyle::State_Enabled ? QPalette::Normal : QPalette::Disabled;
@@ -286,24 +326,14 @@ void ListViewDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opti
     }
 
     // draw the text
-    QTextOption textOption;
-    textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
-    textOption.setTextDirection(opt.direction);
-    textOption.setAlignment(QStyle::visualAlignment(opt.direction, opt.displayAlignment));
-    QTextLayout textLayout;
-    textLayout.setTextOption(textOption);
-    textLayout.setFont(opt.font);
-    textLayout.setText(opt.text);
-
-    qreal width, height;
-    viewItemTextLayout(textLayout, textRect.width(), height, width);
+    const auto& text = textLayout(opt, textRect.width());
 
-    const int lineCount = textLayout.lineCount();
+    const int lineCount = text.layout.lineCount();
 
-    const QRect layoutRect = QStyle::alignedRect(opt.direction, opt.displayAlignment, QSize(textRect.width(), int(height)), textRect);
+    const QRect layoutRect = QStyle::alignedRect(opt.direction, opt.displayAlignment, QSize(textRect.width(), int(text.height)), textRect);
     const QPointF position = layoutRect.topLeft();
     for (int i = 0; i < lineCount; ++i) {
-        const QTextLine line = textLayout.lineAt(i);
+        const QTextLine line = text.layout.lineAt(i);
         line.draw(painter, position);
     }
 
@@ -331,8 +361,7 @@ QSize ListViewDelegate::sizeHint(const QStyleOptionViewItem& option, const QMode
     QStyle* style = opt.widget ? opt.widget->style() : QApplication::style();
     const int textMargin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, &option, opt.widget) + 1;
     int height = 48 + textMargin * 2 + 5;  // TODO: turn constants into variables
-    QSize szz = viewItemTextSize(&opt);
-    height += szz.height();
+    height += qCeil(textLayout(opt, 100 - 2 * textMargin).height);
     // FIXME: maybe the icon items could scale and keep proportions?
     QSize sz(100, height);
     return sz;
@@ -17,6 +17,7 @@
 
 #include <QCache>
 #include <QStyledItemDelegate>
+#include <QTextLayout>
 
 class ListViewDelegate : public QStyledItemDelegate {
     Q_OBJECT
@@ -35,4 +36,15 @@ class ListViewDelegate : public QStyledItemDelegate {
 
    private slots:
     void editingDone();
+
+   private:
+    struct CachedTextLayout {
+        QTextLayout layout;
+        qreal height = 0;
+    };
+
+    /// the item text laid out at the given width. Cached on text, font and width, so repaints and size hints reuse the same layout
+    const CachedTextLayout& textLayout(const QStyleOptionViewItem& option, int lineWidth) const;
+
+    mutable QCache<QString, CachedTextLayout> m_textLayouts;
 };
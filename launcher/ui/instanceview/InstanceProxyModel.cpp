@@ -22,12 +22,68 @@
 
 #include <QDebug>
 
+#include "settings/Setting.h"
+
 InstanceProxyModel::InstanceProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
     m_naturalSort.setNumericMode(true);
     m_naturalSort.setCaseSensitivity(Qt::CaseSensitivity::CaseInsensitive);
     // FIXME: use loaded translation as source of locale instead, hook this up to translation changes
     m_naturalSort.setLocale(QLocale::system());
+    // icon files are loaded in the background, instances show the fallback icon until theirs is ready
+    connect(APPLICATION->icons().get(), &IconList::iconUpdated, this, &InstanceProxyModel::iconUpdated);
+
+    m_sortByLastLaunch = APPLICATION->settings()->get("InstSortMode").toString() == "LastLaunch";
+    connect(APPLICATION->settings().get(), &SettingsObject::SettingChanged, this, [this](const Setting& setting, QVariant value) {
+        if (setting.id() == "InstSortMode")
+            m_sortByLastLaunch = value.toString() == "LastLaunch";
+    });
+}
+
+void InstanceProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
+{
+    if (auto oldModel = this->sourceModel())
+        disconnect(oldModel, nullptr, this, nullptr);
+    m_sortKeys.clear();
+
+    // connected before the base class connects its own, so the changed rows are sorted in with fresh keys
+    if (sourceModel) {
+        connect(sourceModel, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+            dropSortKeys(topLeft.parent(), topLeft.row(), bottomRight.row());
+        });
+        connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &InstanceProxyModel::dropSortKeys);
+        connect(sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, [this] { m_sortKeys.clear(); });
+        connect(sourceModel, &QAbstractItemModel::layoutAboutToBeChanged, this, [this] { m_sortKeys.clear(); });
+    }
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+void InstanceProxyModel::dropSortKeys(const QModelIndex& parent, int first, int last)
+{
+    for (int row = first; row <= last; ++row) {
+        m_sortKeys.remove(sourceModel()->index(row, 0, parent).internalPointer());
+    }
+}
+
+InstanceProxyModel::SortKey InstanceProxyModel::sortKey(const QModelIndex& index) const
+{
+    auto key = m_sortKeys.constFind(index.internalPointer());
+    if (key == m_sortKeys.cend()) {
+        auto instance = static_cast<BaseInstance*>(index.internalPointer());
+        key = m_sortKeys.insert(index.internalPointer(), { index.data(InstanceViewRoles::GroupRole).toString(),
+                                                           m_naturalSort.sortKey(instance->name()), instance->lastLaunch() });
+    }
+    return *key;
+}
+
+void InstanceProxyModel::iconUpdated(const QString& key)
+{
+    for (int row = 0; row < rowCount(); ++row) {
+        const QModelIndex idx = index(row, 0);
+        if (key.isEmpty() || QSortFilterProxyModel::data(idx, Qt::DecorationRole).toString() == key) {
+            emit dataChanged(idx, idx, { Qt::DecorationRole });
+        }
+    }
 }
 
 QVariant InstanceProxyModel::data(const QModelIndex& index, int role) const
@@ -41,8 +97,8 @@ QVariant InstanceProxyModel::data(const QModelIndex& index, int role) const
 
 bool InstanceProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    const QString leftCategory = left.data(InstanceViewRoles::GroupRole).toString();
-    const QString rightCategory = right.data(InstanceViewRoles::GroupRole).toString();
+    const QString leftCategory = sortKey(left).group;
+    const QString rightCategory = sortKey(right).group;
     if (leftCategory == rightCategory) {
         return subSortLessThan(left, right);
     } else {
@@ -57,12 +113,11 @@ bool InstanceProxyModel::lessThan(const QModelIndex& left, const QModelIndex& ri
 
 bool InstanceProxyModel::subSortLessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    BaseInstance* pdataLeft = static_cast<BaseInstance*>(left.internalPointer());
-    BaseInstance* pdataRight = static_cast<BaseInstance*>(right.internalPointer());
-    QString sortMode = APPLICATION->settings()->get("InstSortMode").toString();
-    if (sortMode == "LastLaunch") {
-        return pdataLeft->lastLaunch() > pdataRight->lastLaunch();
+    const auto leftKey = sortKey(left);
+    const auto rightKey = sortKey(right);
+    if (m_sortByLastLaunch) {
+        return leftKey.lastLaunch > rightKey.lastLaunch;
     } else {
-        return m_naturalSort.compare(pdataLeft->name(), pdataRight->name()) < 0;
+        return leftKey.name.compare(rightKey.name) < 0;
     }
 }
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <QCollator>
+#include <QHash>
 #include <QSortFilterProxyModel>
 
 class InstanceProxyModel : public QSortFilterProxyModel {
@@ -24,11 +25,28 @@ class InstanceProxyModel : public QSortFilterProxyModel {
    public:
     InstanceProxyModel(QObject* parent = 0);
 
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
+
+   protected slots:
+    void iconUpdated(const QString& key);
+
    protected:
     QVariant data(const QModelIndex& index, int role) const override;
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
     bool subSortLessThan(const QModelIndex& left, const QModelIndex& right) const;
 
    private:
+    // what instances are sorted by, so comparing them doesn't need to go through their settings every time
+    struct SortKey {
+        QString group;
+        QCollatorSortKey name;
+        qint64 lastLaunch;
+    };
+    SortKey sortKey(const QModelIndex& index) const;
+    void dropSortKeys(const QModelIndex& parent, int first, int last);
+
     QCollator m_naturalSort;
+    bool m_sortByLastLaunch = false;
+    // by instance, dropped before the source model's changes get sorted in
+    mutable QHash<const void*, SortKey> m_sortKeys;
 };
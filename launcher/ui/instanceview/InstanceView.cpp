@@ -37,9 +37,9 @@
 
 #include <QAccessible>
 #include <QApplication>
-#include <QCache>
 #include <QDrag>
 #include <QFont>
+#include <QImageReader>
 #include <QListView>
 #include <QMimeData>
 #include <QMouseEvent>
@@ -53,6 +53,7 @@
 
 #include <Application.h>
 #include <InstanceList.h>
+#include "tasks/CpuExecutor.h"
 
 template <typename T>
 bool listsIntersect(const QList<T>& l1, const QList<T> t2)
@@ -71,6 +72,16 @@ InstanceView::InstanceView(QWidget* parent) : QAbstractItemView(parent)
     setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     setAcceptDrops(true);
     setAutoScroll(true);
+    connect(&m_catLoader, &QFutureWatcher<DecodedCat>::finished, this, [this] {
+        auto cat = m_catLoader.result();
+        if (m_catVisible && cat.path == m_catPath) {
+            m_catPixmap = QPixmap::fromImage(cat.image);
+            // nothing is drawn for cats that can't be read, and they aren't tried again until the next pick
+            m_catFullSize = cat.image.isNull() ? QSize(0, 0) : cat.fullSize;
+        }
+        // also picks up what changed in the meantime
+        viewport()->update();
+    });
     setPaintCat(APPLICATION->settings()->get("TheCat").toBool());
 }
 
@@ -87,10 +98,28 @@ void InstanceView::setModel(QAbstractItemModel* model)
     connect(model, &QAbstractItemModel::rowsRemoved, this, &InstanceView::rowsRemoved);
 }
 
-void InstanceView::dataChanged([[maybe_unused]] const QModelIndex& topLeft,
-                               [[maybe_unused]] const QModelIndex& bottomRight,
-                               [[maybe_unused]] const QVector<int>& roles)
+void InstanceView::dataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
 {
+    // icons and progress don't change the size of an item, a repaint is enough
+    static const QVector<int> paintOnlyRoles = { Qt::DecorationRole, Qt::ToolTipRole, InstanceViewRoles::ProgressValueRole,
+                                                 InstanceViewRoles::ProgressMaximumRole };
+    bool needsLayout = roles.isEmpty();
+    for (int role : roles) {
+        if (!paintOnlyRoles.contains(role)) {
+            needsLayout = true;
+            break;
+        }
+    }
+    if (!needsLayout) {
+        viewport()->update();
+        return;
+    }
+
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        const QModelIndex index = model()->index(row, 0, topLeft.parent());
+        m_itemSizes.remove(index);
+        m_dirtyGroups.insert(index.data(InstanceViewRoles::GroupRole).toString());
+    }
     scheduleDelayedItemsLayout();
 }
 void InstanceView::rowsInserted([[maybe_unused]] const QModelIndex& parent, [[maybe_unused]] int start, [[maybe_unused]] int end)
@@ -105,6 +134,8 @@ void InstanceView::rowsAboutToBeRemoved([[maybe_unused]] const QModelIndex& pare
 
 void InstanceView::modelReset()
 {
+    m_itemSizes.clear();
+    m_relayoutAllGroups = true;
     scheduleDelayedItemsLayout();
 }
 
@@ -174,33 +205,72 @@ void InstanceView::updateGeometries()
 {
     geometryCache.clear();
 
-    QMap<LocaleString, VisualGroup*> cats;
-
+    // sort the items into their groups in one pass over the model
+    QMap<LocaleString, QList<QModelIndex>> groupItems;
     for (int i = 0; i < model()->rowCount(); ++i) {
-        const QString groupName = model()->index(i, 0).data(InstanceViewRoles::GroupRole).toString();
-        if (!cats.contains(groupName)) {
-            VisualGroup* old = this->category(groupName);
-            if (old) {
-                auto cat = new VisualGroup(old);
-                cats.insert(groupName, cat);
-                cat->update();
-            } else {
-                auto cat = new VisualGroup(groupName, this);
-                if (fVisibility) {
-                    cat->collapsed = fVisibility(groupName);
-                }
-                cats.insert(groupName, cat);
-                cat->update();
+        const QModelIndex index = model()->index(i, 0);
+        groupItems[index.data(InstanceViewRoles::GroupRole).toString()].append(index);
+    }
+
+    // keep the existing groups and only flow the ones that changed
+    QList<VisualGroup*> groups;
+    for (auto it = groupItems.constBegin(); it != groupItems.constEnd(); ++it) {
+        const QString& groupName = it.key();
+        VisualGroup* cat = category(groupName);
+        if (cat) {
+            m_groups.removeOne(cat);
+        } else {
+            cat = new VisualGroup(groupName, this);
+            if (fVisibility) {
+                cat->collapsed = fVisibility(groupName);
             }
         }
+        if (m_relayoutAllGroups || m_dirtyGroups.contains(groupName) || !cat->isLaidOut(it.value())) {
+            cat->update(it.value());
+        }
+        groups.append(cat);
     }
+    m_dirtyGroups.clear();
+    m_relayoutAllGroups = false;
 
+    // whatever is left over has no items anymore
+    if (m_groups.contains(m_pressedCategory)) {
+        m_pressedCategory = nullptr;
+    }
     qDeleteAll(m_groups);
-    m_groups = cats.values();
+    m_groups = groups;
+
+    // forget the sizes of removed items
+    for (auto it = m_itemSizes.begin(); it != m_itemSizes.end();) {
+        if (it.key().isValid()) {
+            ++it;
+        } else {
+            it = m_itemSizes.erase(it);
+        }
+    }
+
     updateScrollbar();
     viewport()->update();
 }
 
+QSize InstanceView::itemSize(const QModelIndex& index) const
+{
+    auto size = m_itemSizes.constFind(index);
+    if (size != m_itemSizes.constEnd()) {
+        return *size;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QStyleOptionViewItem option;
+    initViewItemOption(&option);
+#else
+    QStyleOptionViewItem option = viewOptions();
+#endif
+    const QSize hint = itemDelegate()->sizeHint(option, index);
+    m_itemSizes.insert(index, hint);
+    return hint;
+}
+
 bool InstanceView::isIndexHidden(const QModelIndex& index) const
 {
     VisualGroup* cat = category(index);
@@ -445,10 +515,57 @@ void InstanceView::mouseDoubleClickEvent(QMouseEvent* event)
 void InstanceView::setPaintCat(bool visible)
 {
     m_catVisible = visible;
-    if (visible)
-        m_catPixmap.load(APPLICATION->themeManager()->getCatPack());
-    else
+    // the pack may have changed, pick the cat again
+    m_catDate = {};
+    if (visible) {
+        updateCat();
+    } else {
         m_catPixmap = QPixmap();
+        m_catPath.clear();
+    }
+}
+
+// the image fitted into bounds, without making it larger
+static QSize fitCat(const QSize& size, const QSize& bounds)
+{
+    if (size.width() <= bounds.width() && size.height() <= bounds.height())
+        return size;
+    return size.scaled(bounds, Qt::KeepAspectRatio);
+}
+
+void InstanceView::updateCat()
+{
+    auto today = QDate::currentDate();
+    if (m_catDate != today) {
+        m_catDate = today;
+        auto path = APPLICATION->themeManager()->getCatPack();
+        if (path != m_catPath) {
+            m_catPath = path;
+            m_catPixmap = QPixmap();
+            m_catFullSize = {};
+        }
+    }
+
+    auto bounds = viewport()->size();
+    if (bounds.isEmpty() || (m_catFullSize.isValid() && m_catFullSize.isEmpty()))
+        return;
+    // until the first decode, the size of the image isn't known
+    auto size = m_catFullSize.isValid() ? fitCat(m_catFullSize, bounds) : bounds;
+    if (!m_catPixmap.isNull() && m_catPixmap.size() == size)
+        return;
+    // the next paint asks again once this one is done
+    if (m_catLoader.isRunning()) {
+        return;
+    }
+
+    m_catLoader.setFuture(CpuExecutor::run(CpuExecutor::Priority::Interactive, [path = m_catPath, bounds] {
+        QImageReader reader(path);
+        auto fullSize = reader.size();
+        if (fullSize.isValid())
+            reader.setScaledSize(fitCat(fullSize, bounds));
+        auto image = reader.read();
+        return DecodedCat{ path, image, fullSize.isValid() ? fullSize : image.size() };
+    }));
 }
 
 void InstanceView::paintEvent([[maybe_unused]] QPaintEvent* event)
@@ -458,17 +575,14 @@ void InstanceView::paintEvent([[maybe_unused]] QPaintEvent* event)
     QPainter painter(this->viewport());
 
     if (m_catVisible) {
+        updateCat();
+    }
+    if (m_catVisible && !m_catPixmap.isNull()) {
         painter.setOpacity(APPLICATION->settings()->get("CatOpacity").toFloat() / 100);
-        int widWidth = this->viewport()->width();
-        int widHeight = this->viewport()->height();
-        if (m_catPixmap.width() < widWidth)
-            widWidth = m_catPixmap.width();
-        if (m_catPixmap.height() < widHeight)
-            widHeight = m_catPixmap.height();
-        auto pixmap = m_catPixmap.scaled(widWidth, widHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        QRect rectOfPixmap = pixmap.rect();
+        // while the view is being resized, the last decode is drawn until the next one is done
+        QRect rectOfPixmap(QPoint(), fitCat(m_catPixmap.size(), this->viewport()->size()));
         rectOfPixmap.moveBottomRight(this->viewport()->rect().bottomRight());
-        painter.drawPixmap(rectOfPixmap.topLeft(), pixmap);
+        painter.drawPixmap(rectOfPixmap, m_catPixmap);
         painter.setOpacity(1.0);
     }
 
@@ -539,24 +653,38 @@ void InstanceView::paintEvent([[maybe_unused]] QPaintEvent* event)
         option.rect = backup;
     }
 
-    for (int i = 0; i < model()->rowCount(); ++i) {
-        const QModelIndex index = model()->index(i, 0);
-        if (isIndexHidden(index)) {
+    // only paint the rows that intersect the exposed area
+    const QRect exposed = event->rect();
+    for (auto group : m_groups) {
+        if (group->collapsed) {
             continue;
         }
-        Qt::ItemFlags flags = index.flags();
-        option.rect = visualRect(index);
-        option.features |= QStyleOptionViewItem::WrapText;
-        if (flags & Qt::ItemIsSelectable && selectionModel()->isSelected(index)) {
-            option.state |= selectionModel()->isSelected(index) ? QStyle::State_Selected : QStyle::State_None;
-        } else {
-            option.state &= ~QStyle::State_Selected;
+        const int rowsTop = group->verticalPosition() + group->headerHeight() + 5 - verticalOffset();
+        if (rowsTop > exposed.bottom() || rowsTop + group->contentHeight() < exposed.top()) {
+            continue;
         }
-        option.state |= (index == currentIndex()) ? QStyle::State_HasFocus : QStyle::State_None;
-        if (!(flags & Qt::ItemIsEnabled)) {
-            option.state &= ~QStyle::State_Enabled;
+        for (auto& row : group->rows) {
+            const int rowTop = rowsTop + row.top;
+            if (rowTop > exposed.bottom() || rowTop + row.height < exposed.top()) {
+                continue;
+            }
+            for (auto& index : row.items) {
+                QStyleOptionViewItem itemOption = option;
+                Qt::ItemFlags flags = index.flags();
+                itemOption.rect = visualRect(index);
+                itemOption.features |= QStyleOptionViewItem::WrapText;
+                if (flags & Qt::ItemIsSelectable && selectionModel()->isSelected(index)) {
+                    itemOption.state |= QStyle::State_Selected;
+                } else {
+                    itemOption.state &= ~QStyle::State_Selected;
+                }
+                itemOption.state |= (index == currentIndex()) ? QStyle::State_HasFocus : QStyle::State_None;
+                if (!(flags & Qt::ItemIsEnabled)) {
+                    itemOption.state &= ~QStyle::State_Enabled;
+                }
+                itemDelegate()->paint(&painter, itemOption, index);
+            }
         }
-        itemDelegate()->paint(&painter, option, index);
     }
 
     /*
@@ -591,6 +719,16 @@ void InstanceView::paintEvent([[maybe_unused]] QPaintEvent* event)
 #endif
 }
 
+void InstanceView::changeEvent(QEvent* event)
+{
+    // item sizes depend on the font and style
+    if (event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange) {
+        m_itemSizes.clear();
+        m_relayoutAllGroups = true;
+    }
+    QAbstractItemView::changeEvent(event);
+}
+
 void InstanceView::resizeEvent([[maybe_unused]] QResizeEvent* event)
 {
     int newItemsPerRow = calculateItemsPerRow();
@@ -723,8 +861,9 @@ QRect InstanceView::geometryRect(const QModelIndex& index) const
     }
 
     int row = index.row();
-    if (geometryCache.contains(row)) {
-        return *geometryCache[row];
+    auto cached = geometryCache.constFind(row);
+    if (cached != geometryCache.constEnd()) {
+        return *cached;
     }
 
     const VisualGroup* cat = category(index);
@@ -732,18 +871,11 @@ QRect InstanceView::geometryRect(const QModelIndex& index) const
     int x = pos.first;
     // int y = pos.second;
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    QStyleOptionViewItem option;
-    initViewItemOption(&option);
-#else
-    QStyleOptionViewItem option = viewOptions();
-#endif
-
     QRect out;
     out.setTop(cat->verticalPosition() + cat->headerHeight() + 5 + cat->rowTopOf(index));
     out.setLeft(m_spacing + x * (itemWidth() + m_spacing));
-    out.setSize(itemDelegate()->sizeHint(option, index));
-    geometryCache.insert(row, new QRect(out));
+    out.setSize(itemSize(index));
+    geometryCache.insert(row, out);
     return out;
 }
 
@@ -35,10 +35,14 @@
 
 #pragma once
 
-#include <QCache>
+#include <QDate>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QImage>
 #include <QLineEdit>
 #include <QListView>
 #include <QScrollBar>
+#include <QSet>
 #include <functional>
 #include "VisualGroup.h"
 
@@ -111,6 +115,7 @@ class InstanceView : public QAbstractItemView {
     void startDrag(Qt::DropActions supportedActions) override;
 
     void updateScrollbar();
+    void changeEvent(QEvent* event) override;
 
    private:
     friend struct VisualGroup;
@@ -127,15 +132,31 @@ class InstanceView : public QAbstractItemView {
     int m_itemWidth = 100;
     int m_currentItemsPerRow = -1;
     int m_currentCursorColumn = -1;
-    mutable QCache<int, QRect> geometryCache;
+    mutable QHash<int, QRect> geometryCache;
+    // delegate size hints, kept until the item's data changes
+    mutable QHash<QPersistentModelIndex, QSize> m_itemSizes;
+    // groups whose items need to be measured and flowed again on the next layout
+    QSet<QString> m_dirtyGroups;
+    bool m_relayoutAllGroups = true;
     bool m_catVisible = false;
+    // the cat, decoded on a worker at the size it's drawn at
+    struct DecodedCat {
+        QString path;
+        QImage image;
+        QSize fullSize;
+    };
     QPixmap m_catPixmap;
+    QString m_catPath;
+    // the day the cat was picked on, some packs have a different one depending on the date
+    QDate m_catDate;
+    QSize m_catFullSize;
+    QFutureWatcher<DecodedCat> m_catLoader;
 
     // point where the currently active mouse action started in geometry coordinates
     QPoint m_pressedPosition;
     QPersistentModelIndex m_pressedIndex;
     bool m_pressedAlreadySelected;
-    VisualGroup* m_pressedCategory;
+    VisualGroup* m_pressedCategory = nullptr;
     QItemSelectionModel::SelectionFlag m_ctrlDragSelectionFlag;
     QPoint m_lastDragPosition;
 
@@ -144,9 +165,12 @@ class InstanceView : public QAbstractItemView {
     VisualGroup* categoryAt(const QPoint& pos, VisualGroup::HitResults& result) const;
 
     int itemsPerRow() const { return m_currentItemsPerRow; };
+    QSize itemSize(const QModelIndex& index) const;
     int contentWidth() const;
 
    private: /* methods */
+    /// starts decoding the cat again if the pack, the day or the size it should be drawn at changed
+    void updateCat();
     int itemWidth() const;
     int calculateItemsPerRow() const;
     int verticalScrollToValue(const QModelIndex& index, const QRect& rect, QListView::ScrollHint hint) const;
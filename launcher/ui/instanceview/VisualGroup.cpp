@@ -49,19 +49,21 @@ VisualGroup::VisualGroup(QString text, InstanceView* view) : view(view), text(st
 
 VisualGroup::VisualGroup(const VisualGroup* other) : view(other->view), text(other->text), collapsed(other->collapsed) {}
 
-void VisualGroup::update()
+void VisualGroup::update(const QList<QModelIndex>& items)
 {
-    auto temp_items = items();
     auto itemsPerRow = view->itemsPerRow();
+    m_layoutItemsPerRow = itemsPerRow;
 
-    int numRows = qMax(1, qCeil((qreal)temp_items.size() / (qreal)itemsPerRow));
+    int numRows = qMax(1, qCeil((qreal)items.size() / (qreal)itemsPerRow));
     rows = QVector<VisualRow>(numRows);
+    m_positions.clear();
+    m_positions.reserve(items.size());
 
     int maxRowHeight = 0;
     int positionInRow = 0;
     int currentRow = 0;
     int offsetFromTop = 0;
-    for (auto item : temp_items) {
+    for (auto item : items) {
         if (positionInRow == itemsPerRow) {
             rows[currentRow].height = maxRowHeight;
             rows[currentRow].top = offsetFromTop;
@@ -70,17 +72,11 @@ void VisualGroup::update()
             positionInRow = 0;
             maxRowHeight = 0;
         }
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        QStyleOptionViewItem viewItemOption;
-        view->initViewItemOption(&viewItemOption);
-#else
-        QStyleOptionViewItem viewItemOption = view->viewOptions();
-#endif
-
-        auto itemHeight = view->itemDelegate()->sizeHint(viewItemOption, item).height();
+        auto itemHeight = view->itemSize(item).height();
         if (itemHeight > maxRowHeight) {
             maxRowHeight = itemHeight;
         }
+        m_positions.insert(item.row(), qMakePair(positionInRow, currentRow));
         rows[currentRow].items.append(item);
         positionInRow++;
     }
@@ -88,8 +84,29 @@ void VisualGroup::update()
     rows[currentRow].top = offsetFromTop;
 }
 
+bool VisualGroup::isLaidOut(const QList<QModelIndex>& items) const
+{
+    if (m_layoutItemsPerRow != view->itemsPerRow()) {
+        return false;
+    }
+    int i = 0;
+    for (auto& row : rows) {
+        for (auto& item : row.items) {
+            if (i >= items.size() || items[i] != item) {
+                return false;
+            }
+            i++;
+        }
+    }
+    return i == items.size();
+}
+
 QPair<int, int> VisualGroup::positionOf(const QModelIndex& index) const
 {
+    auto position = m_positions.constFind(index.row());
+    if (position != m_positions.constEnd() && rows[position->second].items[position->first] == index) {
+        return *position;
+    }
     int y = 0;
     for (auto& row : rows) {
         for (auto x = 0; x < row.items.size(); x++) {
@@ -256,11 +273,8 @@ int VisualGroup::verticalPosition() const
 QList<QModelIndex> VisualGroup::items() const
 {
     QList<QModelIndex> indices;
-    for (int i = 0; i < view->model()->rowCount(); ++i) {
-        const QModelIndex index = view->model()->index(i, 0);
-        if (index.data(InstanceViewRoles::GroupRole).toString() == text) {
-            indices.append(index);
-        }
+    for (auto& row : rows) {
+        indices.append(row.items);
     }
     return indices;
 }
@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <QHash>
 #include <QRect>
 #include <QString>
 #include <QStyleOption>
@@ -64,10 +65,17 @@ struct VisualGroup {
     QVector<VisualRow> rows;
     int firstItemIndex = 0;
     int m_verticalPosition = 0;
+    /// items per row the rows were flowed with
+    int m_layoutItemsPerRow = -1;
+    /// model row -> x/y position inside the group
+    QHash<int, QPair<int, int>> m_positions;
 
     /* logic */
-    /// update the internal list of items and flow them into the rows.
-    void update();
+    /// flow the given items into the rows, using the item sizes cached by the view.
+    void update(const QList<QModelIndex>& items);
+
+    /// whether the rows already hold exactly these items, flowed for the current items per row
+    bool isLaidOut(const QList<QModelIndex>& items) const;
 
     /// draw the header at y-position.
     void drawHeader(QPainter* painter, const QStyleOptionViewItem& option) const;
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "DiagnosticsPage.h"
+
+#include <QFileDialog>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QJsonDocument>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+#include "FileSystem.h"
+#include "Metrics.h"
+#include "ui/dialogs/CustomMessageBox.h"
+
+DiagnosticsPage::DiagnosticsPage(QWidget* parent) : QWidget(parent)
+{
+    setObjectName(QStringLiteral("diagnosticsPage"));
+
+    m_metrics = new QPlainTextEdit(this);
+    m_metrics->setReadOnly(true);
+    m_metrics->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    m_refreshButton = new QPushButton(this);
+    m_saveButton = new QPushButton(this);
+    connect(m_refreshButton, &QPushButton::clicked, this, &DiagnosticsPage::refresh);
+    connect(m_saveButton, &QPushButton::clicked, this, &DiagnosticsPage::save);
+
+    auto buttons = new QHBoxLayout;
+    buttons->addStretch();
+    buttons->addWidget(m_refreshButton);
+    buttons->addWidget(m_saveButton);
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_metrics);
+    layout->addLayout(buttons);
+
+    retranslate();
+}
+
+void DiagnosticsPage::retranslate()
+{
+    m_refreshButton->setText(tr("&Refresh"));
+    m_saveButton->setText(tr("&Save as JSON..."));
+}
+
+void DiagnosticsPage::refresh()
+{
+    m_metrics->setPlainText(QString::fromUtf8(QJsonDocument(Metrics::snapshot()).toJson(QJsonDocument::Indented)));
+}
+
+void DiagnosticsPage::save()
+{
+    auto path = QFileDialog::getSaveFileName(this, tr("Save metrics"), "metrics.json", tr("JSON files (*.json)"));
+    if (path.isEmpty())
+        return;
+
+    try {
+        FS::write(path, QJsonDocument(Metrics::snapshot()).toJson(QJsonDocument::Indented));
+    } catch (const FS::FileSystemException& e) {
+        CustomMessageBox::selectable(this, tr("Error"), tr("Failed to save the metrics:\n%1").arg(e.cause()), QMessageBox::Warning)->exec();
+    }
+}
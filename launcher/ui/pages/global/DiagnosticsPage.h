@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <Application.h>
+#include <QWidget>
+#include "ui/pages/BasePage.h"
+
+class QPlainTextEdit;
+class QPushButton;
+
+/** Shows the launcher's metrics (see Metrics.h), e.g. how well the download cache does and how fast each host is. */
+class DiagnosticsPage : public QWidget, public BasePage {
+    Q_OBJECT
+
+   public:
+    explicit DiagnosticsPage(QWidget* parent = 0);
+    ~DiagnosticsPage() override = default;
+
+    QString displayName() const override { return tr("Diagnostics"); }
+    QIcon icon() const override { return APPLICATION->getThemedIcon("log"); }
+    QString id() const override { return "diagnostics"; }
+    void openedImpl() override { refresh(); }
+
+    void retranslate() override;
+
+   private slots:
+    void refresh();
+    void save();
+
+   private:
+    QPlainTextEdit* m_metrics;
+    QPushButton* m_refreshButton;
+    QPushButton* m_saveButton;
+};
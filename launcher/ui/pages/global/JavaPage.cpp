@@ -58,6 +58,12 @@ JavaPage::JavaPage(QWidget* parent) : QWidget(parent), ui(new Ui::JavaPage)
     ui->setupUi(this);
     ui->tabWidget->tabBar()->hide();
 
+    // the automatic profile picks the memory allocation itself
+    connect(ui->autoTuneJvmCheck, &QAbstractButton::toggled, this, [this](bool checked) {
+        ui->minMemSpinBox->setEnabled(!checked);
+        ui->maxMemSpinBox->setEnabled(!checked);
+    });
+
     loadSettings();
     updateThresholds();
 }
@@ -88,6 +94,7 @@ void JavaPage::applySettings()
         s->set("MaxMemAlloc", min);
     }
     s->set("PermGen", ui->permGenSpinBox->value());
+    s->set("AutoTuneJvm", ui->autoTuneJvmCheck->isChecked());
 
     // Java Settings
     s->set("JavaPath", ui->javaPathTextBox->text());
@@ -110,6 +117,7 @@ void JavaPage::loadSettings()
         ui->maxMemSpinBox->setValue(min);
     }
     ui->permGenSpinBox->setValue(s->get("PermGen").toInt());
+    ui->autoTuneJvmCheck->setChecked(s->get("AutoTuneJvm").toBool());
 
     // Java Settings
     ui->javaPathTextBox->setText(s->get("JavaPath").toString());
@@ -120,6 +120,10 @@ void MinecraftPage::applySettings()
     // Miscellaneous
     s->set("CloseAfterLaunch", ui->closeAfterLaunchCheck->isChecked());
     s->set("QuitAfterGameStop", ui->quitAfterGameStopCheck->isChecked());
+    s->set("PrespawnJava", ui->prespawnJavaCheck->isChecked());
+    s->set("PrepareLaunchInBackground", ui->prepareLaunchCheck->isChecked());
+    s->set("UseClassDataSharing", ui->useClassDataSharingCheck->isChecked());
+    s->set("UseGameLogChannel", ui->useGameLogChannelCheck->isChecked());
 
     // Legacy settings
     s->set("OnlineFixes", ui->onlineFixes->isChecked());
@@ -175,6 +179,10 @@ void MinecraftPage::loadSettings()
 
     ui->closeAfterLaunchCheck->setChecked(s->get("CloseAfterLaunch").toBool());
     ui->quitAfterGameStopCheck->setChecked(s->get("QuitAfterGameStop").toBool());
+    ui->prespawnJavaCheck->setChecked(s->get("PrespawnJava").toBool());
+    ui->prepareLaunchCheck->setChecked(s->get("PrepareLaunchInBackground").toBool());
+    ui->useClassDataSharingCheck->setChecked(s->get("UseClassDataSharing").toBool());
+    ui->useGameLogChannelCheck->setChecked(s->get("UseGameLogChannel").toBool());
 
     ui->onlineFixes->setChecked(s->get("OnlineFixes").toBool());
 }
@@ -45,6 +45,7 @@
 #include <QHeaderView>
 #include <QKeyEvent>
 #include <QMenu>
+#include <QScrollBar>
 #include <algorithm>
 
 ExternalResourcesPage::ExternalResourcesPage(BaseInstance* instance, std::shared_ptr<ResourceFolderModel> model, QWidget* parent)
@@ -92,6 +93,11 @@ ExternalResourcesPage::ExternalResourcesPage(BaseInstance* instance, std::shared
 
     connect(ui->filterEdit, &QLineEdit::textChanged, this, &ExternalResourcesPage::filterTextChanged);
 
+    // Whatever is on screen gets parsed before the rest of the folder
+    connect(ui->treeView->verticalScrollBar(), &QScrollBar::valueChanged, this, &ExternalResourcesPage::prioritizeVisibleRows);
+    connect(m_filterModel, &QSortFilterProxyModel::layoutChanged, this, &ExternalResourcesPage::prioritizeVisibleRows);
+    connect(model.get(), &ResourceFolderModel::updateFinished, this, &ExternalResourcesPage::prioritizeVisibleRows);
+
     auto viewHeader = ui->treeView->header();
     viewHeader->setContextMenuPolicy(Qt::CustomContextMenu);
 
@@ -143,10 +149,25 @@ void ExternalResourcesPage::openedImpl()
 void ExternalResourcesPage::closedImpl()
 {
     m_model->stopWatching();
+    m_model->cancelPendingParseTasks();
 
     m_wide_bar_setting->set(ui->actionsToolbar->getVisibilityState());
 }
 
+void ExternalResourcesPage::prioritizeVisibleRows()
+{
+    auto viewport_height = ui->treeView->viewport()->height();
+
+    QModelIndexList visible;
+    for (auto index = ui->treeView->indexAt(QPoint(0, 0)); index.isValid(); index = ui->treeView->indexBelow(index)) {
+        if (ui->treeView->visualRect(index).top() > viewport_height)
+            break;
+        visible.append(m_filterModel->mapToSource(index));
+    }
+
+    m_model->prioritizeResources(visible);
+}
+
 void ExternalResourcesPage::retranslate()
 {
     ui->retranslateUi(this);
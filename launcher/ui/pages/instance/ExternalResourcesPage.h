@@ -63,6 +63,9 @@ class ExternalResourcesPage : public QMainWindow, public BasePage {
     void ShowContextMenu(const QPoint& pos);
     void ShowHeaderContextMenu(const QPoint& pos);
 
+    /** Asks the model to parse the rows currently shown in the view before any others. */
+    void prioritizeVisibleRows();
+
    protected:
     BaseInstance* m_instance = nullptr;
 
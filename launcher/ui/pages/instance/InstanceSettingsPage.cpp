@@ -50,9 +50,11 @@
 #include "Application.h"
 #include "BuildConfig.h"
 #include "JavaCommon.h"
+#include "minecraft/MinecraftInstance.h"
 #include "minecraft/auth/AccountList.h"
 
 #include "FileSystem.h"
+#include "StringUtils.h"
 #include "java/JavaInstallList.h"
 #include "java/JavaUtils.h"
 
@@ -71,6 +73,12 @@ InstanceSettingsPage::InstanceSettingsPage(BaseInstance* inst, QWidget* parent)
     connect(ui->useNativeGLFWCheck, &QAbstractButton::toggled, this, &InstanceSettingsPage::onUseNativeGLFWChanged);
     connect(ui->useNativeOpenALCheck, &QAbstractButton::toggled, this, &InstanceSettingsPage::onUseNativeOpenALChanged);
 
+    // the automatic profile picks the memory allocation itself
+    connect(ui->autoTuneJvmCheck, &QAbstractButton::toggled, this, [this](bool checked) {
+        ui->minMemSpinBox->setEnabled(!checked);
+        ui->maxMemSpinBox->setEnabled(!checked);
+    });
+
     loadSettings();
 
     updateThresholds();
@@ -115,9 +123,15 @@ void InstanceSettingsPage::applySettings()
     if (miscellaneous) {
         m_settings->set("CloseAfterLaunch", ui->closeAfterLaunchCheck->isChecked());
         m_settings->set("QuitAfterGameStop", ui->quitAfterGameStopCheck->isChecked());
+        m_settings->set("PrespawnJava", ui->prespawnJavaCheck->isChecked());
+        m_settings->set("UseClassDataSharing", ui->useClassDataSharingCheck->isChecked());
+        m_settings->set("UseGameLogChannel", ui->useGameLogChannelCheck->isChecked());
     } else {
         m_settings->reset("CloseAfterLaunch");
         m_settings->reset("QuitAfterGameStop");
+        m_settings->reset("PrespawnJava");
+        m_settings->reset("UseClassDataSharing");
+        m_settings->reset("UseGameLogChannel");
     }
 
     // Console
@@ -160,10 +174,12 @@ void InstanceSettingsPage::applySettings()
             m_settings->set("MaxMemAlloc", min);
         }
         m_settings->set("PermGen", ui->permGenSpinBox->value());
+        m_settings->set("AutoTuneJvm", ui->autoTuneJvmCheck->isChecked());
     } else {
         m_settings->reset("MinMemAlloc");
         m_settings->reset("MaxMemAlloc");
         m_settings->reset("PermGen");
+        m_settings->reset("AutoTuneJvm");
     }
 
     // Java Install Settings
@@ -286,6 +302,13 @@ void InstanceSettingsPage::loadSettings()
     ui->miscellaneousSettingsBox->setChecked(m_settings->get("OverrideMiscellaneous").toBool());
     ui->closeAfterLaunchCheck->setChecked(m_settings->get("CloseAfterLaunch").toBool());
     ui->quitAfterGameStopCheck->setChecked(m_settings->get("QuitAfterGameStop").toBool());
+    ui->prespawnJavaCheck->setChecked(m_settings->get("PrespawnJava").toBool());
+    ui->useClassDataSharingCheck->setChecked(m_settings->get("UseClassDataSharing").toBool());
+    ui->useGameLogChannelCheck->setChecked(m_settings->get("UseGameLogChannel").toBool());
+    if (auto instance = dynamic_cast<MinecraftInstance*>(m_instance)) {
+        if (auto size = instance->classDataArchivesSize())
+            ui->useClassDataSharingCheck->setText(tr("Reuse loaded classes between launches (%1 kept)").arg(StringUtils::humanReadableFileSize(size)));
+    }
 
     // Console
     ui->consoleSettingsBox->setChecked(m_settings->get("OverrideConsole").toBool());
@@ -311,6 +334,7 @@ void InstanceSettingsPage::loadSettings()
         ui->maxMemSpinBox->setValue(min);
     }
     ui->permGenSpinBox->setValue(m_settings->get("PermGen").toInt());
+    ui->autoTuneJvmCheck->setChecked(m_settings->get("AutoTuneJvm").toBool());
     bool permGenVisible = m_settings->get("PermGenVisible").toBool();
     ui->permGenSpinBox->setVisible(permGenVisible);
     ui->labelPermGen->setVisible(permGenVisible);
@@ -40,15 +40,18 @@
 
 #include "Application.h"
 
+#include <QGuiApplication>
 #include <QIdentityProxyModel>
 #include <QScrollBar>
 #include <QShortcut>
 
 #include "launch/LaunchTask.h"
+#include "launch/LaunchTimings.h"
 #include "settings/Setting.h"
 
 #include "ui/ColorCache.h"
 #include "ui/GuiUtil.h"
+#include "ui/dialogs/CustomMessageBox.h"
 
 #include <BuildConfig.h>
 
@@ -162,6 +165,7 @@ LogPage::LogPage(InstancePtr instance, QWidget* parent) : QWidget(parent), ui(ne
         }
         connect(m_instance.get(), &BaseInstance::launchTaskChanged, this, &LogPage::onInstanceLaunchTaskChanged);
     }
+    connect(qApp, &QGuiApplication::applicationStateChanged, this, &LogPage::updateModelActivity);
 
     auto findShortcut = new QShortcut(QKeySequence(QKeySequence::Find), this);
     connect(findShortcut, SIGNAL(activated()), SLOT(findActivated()));
@@ -174,9 +178,35 @@ LogPage::LogPage(InstancePtr instance, QWidget* parent) : QWidget(parent), ui(ne
 
 LogPage::~LogPage()
 {
+    if (m_model)
+        m_model->holdLines(true);
     delete ui;
 }
 
+void LogPage::showEvent(QShowEvent* event)
+{
+    m_shown = true;
+    updateModelActivity();
+    QWidget::showEvent(event);
+}
+
+void LogPage::hideEvent(QHideEvent* event)
+{
+    m_shown = false;
+    updateModelActivity();
+    QWidget::hideEvent(event);
+}
+
+void LogPage::updateModelActivity()
+{
+    if (!m_model)
+        return;
+    // a hidden log only needs to be caught up once it's shown again, and one behind a game window that has focus only
+    // now and then, so the launcher stays out of the game's way
+    m_model->holdLines(!m_shown);
+    m_model->setFlushInterval(QGuiApplication::applicationState() == Qt::ApplicationActive ? 16 : 1000);
+}
+
 void LogPage::modelStateToUI()
 {
     if (m_model->wrapLines()) {
@@ -204,9 +234,12 @@ void LogPage::UIToModelState()
 
 void LogPage::setInstanceLaunchTaskChanged(shared_qobject_ptr<LaunchTask> proc, bool initial)
 {
+    if (m_model)
+        m_model->holdLines(true);
     m_process = proc;
     if (m_process) {
         m_model = proc->getLogModel();
+        updateModelActivity();
         m_proxy->setSourceModel(m_model.get());
         if (initial) {
             modelStateToUI();
@@ -268,6 +301,21 @@ void LogPage::on_btnClear_clicked()
     m_container->refreshContainer();
 }
 
+void LogPage::on_btnTimings_clicked()
+{
+    auto history = LaunchTimings::loadHistory(m_instance->instanceRoot());
+    QString text;
+    if (history.isEmpty()) {
+        text = tr("This instance has no launch timings yet.");
+    } else {
+        QStringList launches;
+        for (auto& timings : history)
+            launches << QString("%1\n%2").arg(QLocale().toString(timings.started, QLocale::ShortFormat), timings.summary());
+        text = launches.join("\n\n");
+    }
+    CustomMessageBox::selectable(this, tr("Launch Timings"), text, QMessageBox::Information)->exec();
+}
+
 void LogPage::on_btnBottom_clicked()
 {
     ui->text->scrollToBottom();
@@ -66,6 +66,7 @@ class LogPage : public QWidget, public BasePage {
     void on_btnPaste_clicked();
     void on_btnCopy_clicked();
     void on_btnClear_clicked();
+    void on_btnTimings_clicked();
     void on_btnBottom_clicked();
 
     void on_trackLogCheckbox_clicked(bool checked);
@@ -78,7 +79,12 @@ class LogPage : public QWidget, public BasePage {
 
     void onInstanceLaunchTaskChanged(shared_qobject_ptr<LaunchTask> proc);
 
+   protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
    private:
+    void updateModelActivity();
     void modelStateToUI();
     void UIToModelState();
     void setInstanceLaunchTaskChanged(shared_qobject_ptr<LaunchTask> proc, bool initial);
@@ -90,4 +96,6 @@ class LogPage : public QWidget, public BasePage {
 
     LogFormatProxyModel* m_proxy;
     shared_qobject_ptr<LogModel> m_model;
+    // also false while the window is minimized, when the page is still "visible"
+    bool m_shown = false;
 };
@@ -58,6 +58,7 @@
 
 #include "minecraft/PackProfile.h"
 #include "minecraft/VersionFilterData.h"
+#include "minecraft/mod/MetadataHandler.h"
 #include "minecraft/mod/Mod.h"
 #include "minecraft/mod/ModFolderModel.h"
 
@@ -217,9 +218,12 @@ void ModFolderPage::installMods()
             tasks->addTask(task);
         }
 
+        // the metadata of all of them goes on disk together, once they're done
+        Metadata::Batch metadata_batch(m_model->indexDir());
         ProgressDialog loadDialog(this);
         loadDialog.setSkipButton(true, tr("Abort"));
         loadDialog.execWithTask(tasks);
+        metadata_batch.commit();
 
         m_model->update();
     }
@@ -300,9 +304,12 @@ void ModFolderPage::updateMods(bool includeDeps)
             tasks->addTask(task);
         }
 
+        // the metadata of all of them goes on disk together, once they're done
+        Metadata::Batch metadata_batch(m_model->indexDir());
         ProgressDialog loadDialog(this);
         loadDialog.setSkipButton(true, tr("Abort"));
         loadDialog.execWithTask(tasks);
+        metadata_batch.commit();
 
         m_model->update();
     }
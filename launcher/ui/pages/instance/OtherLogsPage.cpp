@@ -42,15 +42,21 @@
 #include "ui/GuiUtil.h"
 
 #include <FileSystem.h>
-#include <GZip.h>
 #include <QShortcut>
+#include "LogFileModel.h"
 #include "RecursiveFileSystemWatcher.h"
 
 OtherLogsPage::OtherLogsPage(QString path, IPathMatcher::Ptr fileFilter, QWidget* parent)
     : QWidget(parent), ui(new Ui::OtherLogsPage), m_path(path), m_fileFilter(fileFilter), m_watcher(new RecursiveFileSystemWatcher(this))
+    , m_model(new LogFileModel(this))
 {
     ui->setupUi(this);
     ui->tabWidget->tabBar()->hide();
+    ui->text->setModel(m_model);
+
+    connect(m_model, &LogFileModel::loadFailed, this, [this] {
+        m_model->showMessage(tr("The file (%1) is not readable.").arg(FS::PathCombine(m_path, m_currentFile)));
+    });
 
     m_watcher->setMatcher(fileFilter);
     m_watcher->setRootDir(QDir::current().absoluteFilePath(m_path));
@@ -116,7 +122,7 @@ void OtherLogsPage::on_selectLogBox_currentIndexChanged(const int index)
 
     if (file.isEmpty() || !QFile::exists(FS::PathCombine(m_path, file))) {
         m_currentFile = QString();
-        ui->text->clear();
+        m_model->clear();
         setControlsEnabled(false);
     } else {
         m_currentFile = file;
@@ -131,60 +137,32 @@ void OtherLogsPage::on_btnReload_clicked()
         setControlsEnabled(false);
         return;
     }
-    QFile file(FS::PathCombine(m_path, m_currentFile));
-    if (!file.open(QFile::ReadOnly)) {
+    QString path = FS::PathCombine(m_path, m_currentFile);
+    QString fontFamily = APPLICATION->settings()->get("ConsoleFont").toString();
+    bool conversionOk = false;
+    int fontSize = APPLICATION->settings()->get("ConsoleFontSize").toInt(&conversionOk);
+    if (!conversionOk) {
+        fontSize = 11;
+    }
+    ui->text->setFont(QFont(fontFamily, fontSize));
+
+    m_lastMatch = -1;
+    if (!m_model->load(path)) {
         setControlsEnabled(false);
         ui->btnReload->setEnabled(true);  // allow reload
+        QMessageBox::critical(this, tr("Error"), tr("Unable to open %1 for reading.").arg(m_currentFile));
         m_currentFile = QString();
-        QMessageBox::critical(this, tr("Error"), tr("Unable to open %1 for reading: %2").arg(m_currentFile, file.errorString()));
-    } else {
-        auto setPlainText = [&](const QString& text) {
-            QString fontFamily = APPLICATION->settings()->get("ConsoleFont").toString();
-            bool conversionOk = false;
-            int fontSize = APPLICATION->settings()->get("ConsoleFontSize").toInt(&conversionOk);
-            if (!conversionOk) {
-                fontSize = 11;
-            }
-            QTextDocument* doc = ui->text->document();
-            doc->setDefaultFont(QFont(fontFamily, fontSize));
-            ui->text->setPlainText(text);
-        };
-        auto showTooBig = [&]() {
-            setPlainText(tr("The file (%1) is too big. You may want to open it in a viewer optimized "
-                            "for large files.")
-                             .arg(file.fileName()));
-        };
-        if (file.size() > (1024ll * 1024ll * 12ll)) {
-            showTooBig();
-            return;
-        }
-        QString content;
-        if (file.fileName().endsWith(".gz")) {
-            QByteArray temp;
-            if (!GZip::unzip(file.readAll(), temp)) {
-                setPlainText(tr("The file (%1) is not readable.").arg(file.fileName()));
-                return;
-            }
-            content = QString::fromUtf8(temp);
-        } else {
-            content = QString::fromUtf8(file.readAll());
-        }
-        if (content.size() >= 50000000ll) {
-            showTooBig();
-            return;
-        }
-        setPlainText(content);
     }
 }
 
 void OtherLogsPage::on_btnPaste_clicked()
 {
-    GuiUtil::uploadPaste(m_currentFile, ui->text->toPlainText(), this);
+    GuiUtil::uploadPaste(m_currentFile, m_model->text(), this);
 }
 
 void OtherLogsPage::on_btnCopy_clicked()
 {
-    GuiUtil::setClipboardText(ui->text->toPlainText());
+    GuiUtil::setClipboardText(m_model->text());
 }
 
 void OtherLogsPage::on_btnDelete_clicked()
@@ -273,27 +251,50 @@ void OtherLogsPage::setControlsEnabled(const bool enabled)
     ui->btnClean->setEnabled(enabled);
 }
 
-// FIXME: HACK, use LogView instead?
-static void findNext(QPlainTextEdit* _this, const QString& what, bool reverse)
+void OtherLogsPage::findNext(bool reverse)
 {
-    _this->find(what, reverse ? QTextDocument::FindFlag::FindBackward : QTextDocument::FindFlag(0));
+    auto what = ui->searchBar->text().toUtf8();
+    if (what.isEmpty()) {
+        return;
+    }
+    // go on from the last match while it's still in the selected line, or from that line
+    auto current = ui->text->currentIndex();
+    auto from = current.isValid() ? m_model->rowStart(current.row()) : 0;
+    if (current.isValid() && m_lastMatch >= from && m_model->rowAt(m_lastMatch) == current.row()) {
+        from = reverse ? m_lastMatch : m_lastMatch + 1;
+    } else if (reverse && !current.isValid()) {
+        from = m_model->indexedSize();
+    }
+
+    auto found = m_model->find(what, from, reverse);
+    if (found < 0) {
+        // wrap around, like the text edit did
+        found = m_model->find(what, reverse ? m_model->indexedSize() : 0, reverse);
+    }
+    if (found < 0) {
+        return;
+    }
+    m_lastMatch = found;
+    auto index = m_model->index(m_model->rowAt(found));
+    ui->text->setCurrentIndex(index);
+    ui->text->scrollTo(index);
 }
 
 void OtherLogsPage::on_findButton_clicked()
 {
     auto modifiers = QApplication::keyboardModifiers();
     bool reverse = modifiers & Qt::ShiftModifier;
-    findNext(ui->text, ui->searchBar->text(), reverse);
+    findNext(reverse);
 }
 
 void OtherLogsPage::findNextActivated()
 {
-    findNext(ui->text, ui->searchBar->text(), false);
+    findNext(false);
 }
 
 void OtherLogsPage::findPreviousActivated()
 {
-    findNext(ui->text, ui->searchBar->text(), true);
+    findNext(true);
 }
 
 void OtherLogsPage::findActivated()
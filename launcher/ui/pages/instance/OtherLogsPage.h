@@ -45,6 +45,7 @@ namespace Ui {
 class OtherLogsPage;
 }
 
+class LogFileModel;
 class RecursiveFileSystemWatcher;
 
 class OtherLogsPage : public QWidget, public BasePage {
@@ -79,6 +80,7 @@ class OtherLogsPage : public QWidget, public BasePage {
 
    private:
     void setControlsEnabled(bool enabled);
+    void findNext(bool reverse);
 
    private:
     Ui::OtherLogsPage* ui;
@@ -86,4 +88,7 @@ class OtherLogsPage : public QWidget, public BasePage {
     QString m_currentFile;
     IPathMatcher::Ptr m_fileFilter;
     RecursiveFileSystemWatcher* m_watcher;
+    LogFileModel* m_model;
+    // where the last match was found in the file, searches go on from there
+    qint64 m_lastMatch = -1;
 };
@@ -39,6 +39,8 @@
 #include "BuildConfig.h"
 #include "ui_ScreenshotsPage.h"
 
+#include <QCache>
+#include <QCheckBox>
 #include <QClipboard>
 #include <QEvent>
 #include <QFileIconProvider>
@@ -49,80 +51,107 @@
 #include <QMenu>
 #include <QModelIndex>
 #include <QMutableListIterator>
+#include <QMutex>
 #include <QPainter>
 #include <QRegularExpression>
 #include <QSet>
 #include <QStyledItemDelegate>
 
+#include <algorithm>
+#include <deque>
+
 #include <Application.h>
 
 #include "ui/dialogs/CustomMessageBox.h"
 #include "ui/dialogs/ProgressDialog.h"
 
+#include "MTPixmapCache.h"
 #include "net/NetJob.h"
 #include "screenshots/ImgurAlbumCreation.h"
 #include "screenshots/ImgurUpload.h"
+#include "screenshots/ThumbnailCache.h"
+#include "tasks/CpuExecutor.h"
 #include "tasks/SequentialTask.h"
 
 #include <DesktopServices.h>
 #include <FileSystem.h>
-#include "RWStorage.h"
 
-using SharedIconCache = RWStorage<QString, QIcon>;
-using SharedIconCachePtr = std::shared_ptr<SharedIconCache>;
+namespace {
+/// edge of the square thumbnails, in pixels
+constexpr int thumbnailEdge = 256;
+/// how many thumbnails may wait for a worker, older requests are for rows that have long scrolled away
+constexpr int maxPendingThumbnails = 64;
+/// how many workers may make thumbnails at once
+constexpr int maxThumbnailWorkers = 4;
+}  // namespace
+
+/// Thumbnails waiting for a worker, shared between the model and the workers.
+struct ThumbnailQueue {
+    QMutex mutex;
+    /// most recently requested first, which are the rows that were just painted
+    std::deque<QString> pending;
+    int workers = 0;
+    bool cancelled = false;
+};
+using ThumbnailQueuePtr = std::shared_ptr<ThumbnailQueue>;
 
 class ThumbnailingResult : public QObject {
     Q_OBJECT
    public slots:
-    inline void emitResultsReady(const QString& path) { emit resultsReady(path); }
+    inline void emitResultsReady(const QString& path, const QImage& thumbnail) { emit resultsReady(path, thumbnail); }
     inline void emitResultsFailed(const QString& path) { emit resultsFailed(path); }
    signals:
-    void resultsReady(const QString& path);
+    void resultsReady(const QString& path, const QImage& thumbnail);
     void resultsFailed(const QString& path);
 };
 
 class ThumbnailRunnable : public QRunnable {
    public:
-    ThumbnailRunnable(QString path, SharedIconCachePtr cache)
-    {
-        m_path = path;
-        m_cache = cache;
-    }
-    void run()
+    ThumbnailRunnable(ThumbnailQueuePtr queue, std::shared_ptr<ThumbnailCache> cache, ThumbnailingResult* resultEmitter)
+        : m_queue(std::move(queue)), m_cache(std::move(cache)), m_resultEmitter(resultEmitter)
+    {}
+    void run() override
     {
-        QFileInfo info(m_path);
-        if (info.isDir())
-            return;
-        if ((info.suffix().compare("png", Qt::CaseInsensitive) != 0))
-            return;
-        if (!m_cache->stale(m_path))
-            return;
-        QImage image(m_path);
-        if (image.isNull()) {
-            m_resultEmitter.emitResultsFailed(m_path);
-            qDebug() << "Error loading screenshot: " + m_path + ". Perhaps too large?";
-            return;
+        for (;;) {
+            QString path;
+            {
+                QMutexLocker locker(&m_queue->mutex);
+                if (m_queue->cancelled || m_queue->pending.empty()) {
+                    m_queue->workers--;
+                    return;
+                }
+                path = m_queue->pending.front();
+                m_queue->pending.pop_front();
+            }
+
+            QFileInfo info(path);
+            QImage thumbnail = m_cache->load(info);
+            if (thumbnail.isNull()) {
+                thumbnail = ThumbnailCache::generate(path, thumbnailEdge);
+                if (!thumbnail.isNull()) {
+                    m_cache->store(info, thumbnail);
+                }
+            }
+
+            // the model stops listening once it cancels the queue, so only report while it's still there
+            QMutexLocker locker(&m_queue->mutex);
+            if (m_queue->cancelled) {
+                m_queue->workers--;
+                return;
+            }
+            if (thumbnail.isNull()) {
+                qDebug() << "Error loading screenshot: " + path + ". Perhaps too large?";
+                m_resultEmitter->emitResultsFailed(path);
+            } else {
+                m_resultEmitter->emitResultsReady(path, thumbnail);
+            }
         }
-        QImage small;
-        if (image.width() > image.height())
-            small = image.scaledToWidth(512).scaledToWidth(256, Qt::SmoothTransformation);
-        else
-            small = image.scaledToHeight(512).scaledToHeight(256, Qt::SmoothTransformation);
-        QPoint offset((256 - small.width()) / 2, (256 - small.height()) / 2);
-        QImage square(QSize(256, 256), QImage::Format_ARGB32);
-        square.fill(Qt::transparent);
-
-        QPainter painter(&square);
-        painter.drawImage(offset, small);
-        painter.end();
-
-        QIcon icon(QPixmap::fromImage(square));
-        m_cache->add(m_path, icon);
-        m_resultEmitter.emitResultsReady(m_path);
     }
-    QString m_path;
-    SharedIconCachePtr m_cache;
-    ThumbnailingResult m_resultEmitter;
+
+   private:
+    ThumbnailQueuePtr m_queue;
+    std::shared_ptr<ThumbnailCache> m_cache;
+    ThumbnailingResult* m_resultEmitter;
 };
 
 // this is about as elegant and well written as a bag of bricks with scribbles done by insane
@@ -132,16 +161,22 @@ class FilterModel : public QIdentityProxyModel {
    public:
     explicit FilterModel(QObject* parent = 0) : QIdentityProxyModel(parent)
     {
-        m_thumbnailingPool.setMaxThreadCount(4);
-        m_thumbnailCache = std::make_shared<SharedIconCache>();
-        m_thumbnailCache->add("placeholder", APPLICATION->getThemedIcon("screenshot-placeholder"));
+        // the thumbnails are kept as icons here, but within the budget the pixmap cache has for them, in KiB
+        m_thumbnails.setMaxCost(int(PixmapCache::budget(PixmapCache::Consumer::Screenshots) / 1024));
+        m_queue = std::make_shared<ThumbnailQueue>();
+        m_diskCache = std::make_shared<ThumbnailCache>(QDir("cache/screenshots").absolutePath());
+        m_placeholder = APPLICATION->getThemedIcon("screenshot-placeholder");
+        connect(&m_resultEmitter, &ThumbnailingResult::resultsReady, this, &FilterModel::thumbnailReady);
+        connect(&m_resultEmitter, &ThumbnailingResult::resultsFailed, this, &FilterModel::thumbnailFailed);
         connect(&watcher, SIGNAL(fileChanged(QString)), SLOT(fileChanged(QString)));
     }
     virtual ~FilterModel()
     {
-        m_thumbnailingPool.clear();
-        if (!m_thumbnailingPool.waitForDone(500))
-            qDebug() << "Thumbnail pool took longer than 500ms to finish";
+        // workers only report back while holding the lock and while the queue isn't cancelled,
+        // so once this is done none of them touches the model anymore
+        QMutexLocker locker(&m_queue->mutex);
+        m_queue->cancelled = true;
+        m_queue->pending.clear();
     }
     virtual QVariant data(const QModelIndex& proxyIndex, int role = Qt::DisplayRole) const
     {
@@ -155,18 +190,18 @@ class FilterModel : public QIdentityProxyModel {
         if (role == Qt::DecorationRole) {
             QVariant result = sourceModel()->data(mapToSource(proxyIndex), QFileSystemModel::FilePathRole);
             QString filePath = result.toString();
-            QIcon temp;
             if (!watched.contains(filePath)) {
                 ((QFileSystemWatcher&)watcher).addPath(filePath);
                 ((QSet<QString>&)watched).insert(filePath);
             }
-            if (m_thumbnailCache->get(filePath, temp)) {
-                return temp;
+            if (auto icon = m_thumbnails.object(filePath)) {
+                return *icon;
             }
+            // only rows that get painted ask for their decoration, so this is what's visible right now
             if (!m_failed.contains(filePath)) {
                 ((FilterModel*)this)->thumbnailImage(filePath);
             }
-            return (m_thumbnailCache->get("placeholder"));
+            return m_placeholder;
         }
         return sourceModel()->data(mapToSource(proxyIndex), role);
     }
@@ -189,28 +224,78 @@ class FilterModel : public QIdentityProxyModel {
    private:
     void thumbnailImage(QString path)
     {
-        auto runnable = new ThumbnailRunnable(path, m_thumbnailCache);
-        connect(&(runnable->m_resultEmitter), SIGNAL(resultsReady(QString)), SLOT(thumbnailReady(QString)));
-        connect(&(runnable->m_resultEmitter), SIGNAL(resultsFailed(QString)), SLOT(thumbnailFailed(QString)));
-        ((QThreadPool&)m_thumbnailingPool).start(runnable);
+        QFileInfo info(path);
+        if (info.isDir() || info.suffix().compare("png", Qt::CaseInsensitive) != 0)
+            return;
+
+        QMutexLocker locker(&m_queue->mutex);
+        auto& pending = m_queue->pending;
+        auto queued = std::find(pending.begin(), pending.end(), path);
+        if (queued != pending.end()) {
+            // painted again, move it ahead of the rows that were scrolled past
+            pending.erase(queued);
+        } else if (m_requested.contains(path)) {
+            // a worker is already on it
+            return;
+        }
+        pending.push_front(path);
+        m_requested.insert(path);
+
+        while (pending.size() > maxPendingThumbnails) {
+            // scrolled away before a worker got to it, it gets requested again once it's painted
+            m_requested.remove(pending.back());
+            pending.pop_back();
+        }
+
+        if (m_queue->workers < maxThumbnailWorkers) {
+            m_queue->workers++;
+            // the thumbnails are for the rows on screen, so they go ahead of any background work
+            CpuExecutor::start(new ThumbnailRunnable(m_queue, m_diskCache, &m_resultEmitter), CpuExecutor::Priority::Interactive);
+        }
+    }
+    void thumbnailChanged(const QString& path)
+    {
+        auto fsModel = qobject_cast<QFileSystemModel*>(sourceModel());
+        if (!fsModel)
+            return;
+        auto index = mapFromSource(fsModel->index(path));
+        if (index.isValid())
+            emit dataChanged(index, index, { Qt::DecorationRole });
     }
    private slots:
-    void thumbnailReady(QString path) { emit layoutChanged(); }
-    void thumbnailFailed(QString path) { m_failed.insert(path); }
+    void thumbnailReady(const QString& path, const QImage& thumbnail)
+    {
+        m_requested.remove(path);
+        // pixmaps can only be made on the GUI thread, so the workers hand over plain images
+        const int cost = qMax(1, int(thumbnail.sizeInBytes() / 1024));
+        m_thumbnails.insert(path, new QIcon(QPixmap::fromImage(thumbnail)), cost);
+        thumbnailChanged(path);
+    }
+    void thumbnailFailed(const QString& path)
+    {
+        m_requested.remove(path);
+        m_failed.insert(path);
+    }
     void fileChanged(QString filepath)
     {
-        m_thumbnailCache->setStale(filepath);
+        m_thumbnails.remove(filepath);
+        m_failed.remove(filepath);
         // reinsert the path...
         watcher.removePath(filepath);
         if (QFile::exists(filepath)) {
             watcher.addPath(filepath);
-            thumbnailImage(filepath);
+            // the cached thumbnail no longer matches the file's modification time, so this makes a new one
+            thumbnailChanged(filepath);
         }
     }
 
    private:
-    SharedIconCachePtr m_thumbnailCache;
-    QThreadPool m_thumbnailingPool;
+    ThumbnailQueuePtr m_queue;
+    std::shared_ptr<ThumbnailCache> m_diskCache;
+    ThumbnailingResult m_resultEmitter;
+    mutable QCache<QString, QIcon> m_thumbnails;
+    QIcon m_placeholder;
+    QSet<QString> m_requested;
     QSet<QString> m_failed;
     QSet<QString> watched;
     QFileSystemWatcher watcher;
@@ -373,14 +458,18 @@ void ScreenshotsPage::on_actionUpload_triggered()
                   "Are you sure?")
                    .arg(baseUrl.host());
 
-    auto response = CustomMessageBox::selectable(this, "Confirm Upload", text, QMessageBox::Warning, QMessageBox::Yes | QMessageBox::No,
-                                                 QMessageBox::No)
-                        ->exec();
+    auto confirm =
+        CustomMessageBox::selectable(this, "Confirm Upload", text, QMessageBox::Warning, QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+    auto shrinkBox = new QCheckBox(tr("Scale down large screenshots before uploading them"), confirm);
+    shrinkBox->setChecked(true);
+    confirm->setCheckBox(shrinkBox);
+    auto response = confirm->exec();
+    bool shrink = shrinkBox->isChecked();
+    confirm->deleteLater();
 
     if (response != QMessageBox::Yes)
         return;
 
-    QList<ScreenShot::Ptr> uploaded;
     auto job = NetJob::Ptr(new NetJob("Screenshot Upload", APPLICATION->network()));
 
     ProgressDialog dialog(this);
@@ -390,7 +479,7 @@ void ScreenshotsPage::on_actionUpload_triggered()
         auto item = selection.at(0);
         auto info = m_model->fileInfo(item);
         auto screenshot = std::make_shared<ScreenShot>(info);
-        job->addNetAction(ImgurUpload::make(screenshot));
+        job->addNetAction(ImgurUpload::make(screenshot, shrink));
 
         connect(job.get(), &Task::failed, [this](QString reason) {
             CustomMessageBox::selectable(this, tr("Failed to upload screenshots!"), reason, QMessageBox::Critical)->show();
@@ -419,19 +508,18 @@ void ScreenshotsPage::on_actionUpload_triggered()
         return;
     }
 
+    // the album is made first, so every screenshot can go right into it when it's done instead of all of them waiting for the last
+    SequentialTask task;
+    auto albumTask = NetJob::Ptr(new NetJob("Imgur Album Creation", APPLICATION->network()));
+    auto imgurResult = std::make_shared<ImgurAlbumCreation::Result>();
+    albumTask->addNetAction(ImgurAlbumCreation::make(imgurResult));
     for (auto item : selection) {
         auto info = m_model->fileInfo(item);
         auto screenshot = std::make_shared<ScreenShot>(info);
-        uploaded.push_back(screenshot);
-        job->addNetAction(ImgurUpload::make(screenshot));
+        job->addNetAction(ImgurUpload::make(screenshot, shrink, imgurResult));
     }
-    SequentialTask task;
-    auto albumTask = NetJob::Ptr(new NetJob("Imgur Album Creation", APPLICATION->network()));
-    auto imgurResult = std::make_shared<ImgurAlbumCreation::Result>();
-    auto imgurAlbum = ImgurAlbumCreation::make(imgurResult, uploaded);
-    albumTask->addNetAction(imgurAlbum);
-    task.addTask(job);
     task.addTask(albumTask);
+    task.addTask(job);
 
     connect(&task, &Task::failed, [this](QString reason) {
         CustomMessageBox::selectable(this, tr("Failed to upload screenshots!"), reason, QMessageBox::Critical)->show();
@@ -42,6 +42,8 @@
 #include <FileSystem.h>
 #include <io/stream_reader.h>
 #include <minecraft/MinecraftInstance.h>
+#include <minecraft/ServerPingTask.h>
+#include <tasks/ConcurrentTask.h>
 #include <tag_compound.h>
 #include <tag_list.h>
 #include <tag_primitive.h>
@@ -50,9 +52,12 @@
 
 #include <QFileSystemWatcher>
 #include <QMenu>
+#include <QSet>
 #include <QTimer>
 
-static const int COLUMN_COUNT = 2;  // 3 , TBD: latency and other nice things.
+static const int COLUMN_COUNT = 3;
+// enough to fill a page of servers quickly, without looking like a flood to anyone's firewall
+static const int MAX_CONCURRENT_PINGS = 8;
 
 struct Server {
     // Types
@@ -179,6 +184,8 @@ class ServersModel : public QAbstractListModel {
 
         if (!m_loaded) {
             load();
+        } else {
+            queryStatus();
         }
 
         updateFSObserver();
@@ -330,6 +337,8 @@ class ServersModel : public QAbstractListModel {
                     }
                     case Qt::DisplayRole:
                         return m_servers[row].m_name;
+                    case Qt::ToolTipRole:
+                        return statusToolTip(m_servers[row]);
                     case ServerPtrRole:
                         return QVariant::fromValue<void*>((void*)&m_servers[row]);
                     default:
@@ -342,13 +351,21 @@ class ServersModel : public QAbstractListModel {
                     default:
                         return QVariant();
                 }
-            case 2:
+            case 2: {
+                auto& server = m_servers[row];
                 switch (role) {
                     case Qt::DisplayRole:
-                        return m_servers[row].m_ping;
+                        if (!server.m_checked)
+                            return QVariant();
+                        if (!server.m_up)
+                            return tr("Offline");
+                        return tr("%1 ms").arg(server.m_ping);
+                    case Qt::ToolTipRole:
+                        return statusToolTip(server);
                     default:
                         return QVariant();
                 }
+            }
             default:
                 return QVariant();
         }
@@ -389,8 +406,10 @@ class ServersModel : public QAbstractListModel {
             return;
         }
         server->m_address = address;
+        server->m_checked = false;
         emit dataChanged(index(row, 0), index(row, COLUMN_COUNT - 1));
         scheduleSave();
+        queryStatus();
     }
 
     void setAcceptsTextures(int row, Server::AcceptsTextures textures)
@@ -424,6 +443,46 @@ class ServersModel : public QAbstractListModel {
         m_servers.swap(servers);
         m_loaded = true;
         endResetModel();
+        queryStatus();
+    }
+
+    // fills in what's cached right away, and pings the rest of the servers in the background
+    void queryStatus()
+    {
+        auto job = makeShared<ConcurrentTask>(nullptr, tr("Ping servers"), MAX_CONCURRENT_PINGS);
+        job->setKeepSucceededTasks(false);
+        int pings = 0;
+        for (auto& server : m_servers) {
+            auto address = server.m_address.trimmed();
+            if (address.isEmpty() || m_pinging.contains(address))
+                continue;
+            if (auto cached = ServerPing::cachedStatus(address)) {
+                applyStatus(address, *cached);
+                continue;
+            }
+            auto task = makeShared<ServerPingTask>(address);
+            connect(task.get(), &Task::finished, this, [this, ping = task.get()] {
+                m_pinging.remove(ping->address());
+                if (ping->wasSuccessful())
+                    applyStatus(ping->address(), ping->status());
+            });
+            m_pinging.insert(address);
+            job->addTask(task);
+            pings++;
+        }
+        if (pings == 0)
+            return;
+
+        m_pingJobs.append(job);
+        connect(job.get(), &Task::finished, this, [this, job = job.get()] {
+            for (int i = 0; i < m_pingJobs.size(); i++) {
+                if (m_pingJobs[i].get() == job) {
+                    m_pingJobs.removeAt(i);
+                    break;
+                }
+            }
+        });
+        job->start();
     }
 
     void saveNow()
@@ -485,6 +544,39 @@ class ServersModel : public QAbstractListModel {
 
     bool saveIsScheduled() const { return m_dirty; }
 
+    void applyStatus(const QString& address, const ServerPing::Status& status)
+    {
+        bool iconChanged = false;
+        for (int row = 0; row < m_servers.size(); row++) {
+            auto& server = m_servers[row];
+            if (server.m_address.trimmed() != address)
+                continue;
+            server.m_checked = true;
+            server.m_up = status.up;
+            server.m_motd = status.up ? status.motd : status.error;
+            server.m_ping = status.ping;
+            server.m_currentPlayers = status.currentPlayers;
+            server.m_maxPlayers = status.maxPlayers;
+            // the game keeps the icons in servers.dat up to date too, so don't fight it while it's running
+            if (!m_locked && !status.icon.isEmpty() && server.m_icon != status.icon) {
+                server.m_icon = status.icon;
+                iconChanged = true;
+            }
+            emit dataChanged(index(row, 0), index(row, COLUMN_COUNT - 1));
+        }
+        if (iconChanged)
+            scheduleSave();
+    }
+
+    static QVariant statusToolTip(const Server& server)
+    {
+        if (!server.m_checked)
+            return QVariant();
+        if (!server.m_up)
+            return tr("Can't reach the server: %1").arg(server.m_motd);
+        return tr("%1\nPlayers: %2/%3").arg(server.m_motd).arg(server.m_currentPlayers).arg(server.m_maxPlayers);
+    }
+
     void updateFSObserver()
     {
         bool observingFS = m_watcher->directories().contains(m_path);
@@ -520,6 +612,9 @@ class ServersModel : public QAbstractListModel {
     QList<Server> m_servers;
     QFileSystemWatcher* m_watcher = nullptr;
     QTimer m_saveTimer;
+
+    QList<ConcurrentTask::Ptr> m_pingJobs;
+    QSet<QString> m_pinging;
 };
 
 ServersPage::ServersPage(InstancePtr inst, QWidget* parent) : QMainWindow(parent), ui(new Ui::ServersPage)
@@ -335,6 +335,7 @@ void WorldListPage::worldChanged([[maybe_unused]] const QModelIndex& current, [[
     ui->actionMCEdit->setEnabled(enable);
     ui->actionRemove->setEnabled(enable);
     ui->actionCopy->setEnabled(enable);
+    ui->actionSnapshot->setEnabled(enable);
     ui->actionRename->setEnabled(enable);
     ui->actionDatapacks->setEnabled(enable);
     bool hasIcon = !index.data(WorldList::IconFileRole).isNull();
@@ -345,15 +346,17 @@ void WorldListPage::on_actionAdd_triggered()
 {
     auto list = GuiUtil::BrowseForFiles(displayName(), tr("Select a Minecraft world zip"), tr("Minecraft World Zip File (*.zip)"),
                                         QString(), this->parentWidget());
-    if (!list.empty()) {
-        m_worlds->stopWatching();
-        for (auto filename : list) {
-            m_worlds->installWorld(QFileInfo(filename));
-        }
-        m_worlds->startWatching();
+    for (auto filename : list) {
+        if (auto task = m_worlds->installWorld(QFileInfo(filename)))
+            connect(task.get(), &Task::failed, this, [this](QString reason) { worldTaskFailed(tr("Add World"), reason); });
     }
 }
 
+void WorldListPage::worldTaskFailed(const QString& action, const QString& reason)
+{
+    CustomMessageBox::selectable(this, action, reason, QMessageBox::Warning)->show();
+}
+
 bool WorldListPage::isWorldSafe(QModelIndex)
 {
     return !m_inst->isRunning();
@@ -388,8 +391,29 @@ void WorldListPage::on_actionCopy_triggered()
         QInputDialog::getText(this, tr("World name"), tr("Enter a new name for the copy."), QLineEdit::Normal, world->name(), &ok);
 
     if (ok && name.length() > 0) {
-        world->install(m_worlds->dir().absolutePath(), name);
+        auto task = world->installTask(m_worlds->dir().absolutePath(), name);
+        connect(task.get(), &Task::failed, this, [this](QString reason) { worldTaskFailed(tr("Copy World"), reason); });
+        m_worlds->runTask(task);
+    }
+}
+
+void WorldListPage::on_actionSnapshot_triggered()
+{
+    QModelIndex index = getSelectedWorld();
+    if (!index.isValid()) {
+        return;
     }
+
+    if (!worldSafetyNagQuestion(tr("Snapshot World")))
+        return;
+
+    auto worldVariant = m_worlds->data(index, WorldList::ObjectRole);
+    auto world = (World*)worldVariant.value<void*>();
+    // where the game keeps the backups it makes, too
+    auto backups = FS::PathCombine(m_inst->gameRoot(), "backups");
+    auto task = world->snapshotTask(backups);
+    connect(task.get(), &Task::failed, this, [this](QString reason) { worldTaskFailed(tr("Snapshot World"), reason); });
+    m_worlds->runTask(task);
 }
 
 void WorldListPage::on_actionRename_triggered()
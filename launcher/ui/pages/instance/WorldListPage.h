@@ -78,6 +78,7 @@ class WorldListPage : public QMainWindow, public BasePage {
     QModelIndex getSelectedWorld();
     bool isWorldSafe(QModelIndex index);
     bool worldSafetyNagQuestion(const QString& actionType);
+    void worldTaskFailed(const QString& action, const QString& reason);
     void mceditError();
 
    private:
@@ -94,6 +95,7 @@ class WorldListPage : public QMainWindow, public BasePage {
     void on_actionRemove_triggered();
     void on_actionAdd_triggered();
     void on_actionCopy_triggered();
+    void on_actionSnapshot_triggered();
     void on_actionRename_triggered();
     void on_actionRefresh_triggered();
     void on_actionView_Folder_triggered();
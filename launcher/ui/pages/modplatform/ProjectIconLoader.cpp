@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "ProjectIconLoader.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QPixmap>
+#include <QPixmapCache>
+#include <QTimer>
+#include <QtConcurrentRun>
+
+#include "Application.h"
+
+#include "net/ApiDownload.h"
+#include "net/NetJob.h"
+
+namespace {
+// Big enough to stay sharp on high DPI screens, where the lists show logos at about 48 pixels
+constexpr int THUMBNAIL_SIZE = 96;
+// How many logos are downloaded at once
+constexpr int MAX_RUNNING_DOWNLOADS = 6;
+// Thumbnails older than this are made again from a fresh download, in case the logo changed
+constexpr qint64 THUMBNAIL_MAX_AGE_SECS = 7 * 24 * 60 * 60;
+
+QImage readThumbnail(const QString& path)
+{
+    QImageReader reader(path);
+    reader.setDecideFormatFromContent(true);
+    auto size = reader.size();
+    const QSize bounds(THUMBNAIL_SIZE, THUMBNAIL_SIZE);
+    // let the decoder scale, so the full image never has to be held in memory
+    if (size.isValid() && (size.width() > THUMBNAIL_SIZE || size.height() > THUMBNAIL_SIZE))
+        reader.setScaledSize(size.scaled(bounds, Qt::KeepAspectRatio));
+
+    auto image = reader.read();
+    if (!image.isNull() && (image.width() > THUMBNAIL_SIZE || image.height() > THUMBNAIL_SIZE))
+        image = image.scaled(bounds, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    return image;
+}
+}  // namespace
+
+ProjectIconLoader* ProjectIconLoader::instance()
+{
+    // owned by the application, so it goes away before the things it uses
+    static auto* s_instance = new ProjectIconLoader(QCoreApplication::instance());
+    return s_instance;
+}
+
+ProjectIconLoader::ProjectIconLoader(QObject* parent) : QObject(parent), m_thumbnail_dir(QDir("cache/thumbnails").absolutePath()) {}
+
+QString ProjectIconLoader::keyOf(const QString& metaEntryBase, const QString& name)
+{
+    return QString("projecticon/%1/%2").arg(metaEntryBase, name);
+}
+
+QString ProjectIconLoader::thumbnailPath(const Request& request) const
+{
+    auto hash = QCryptographicHash::hash(keyOf(request.base, request.name).toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QDir(m_thumbnail_dir).absoluteFilePath(hash + ".png");
+}
+
+std::optional<QIcon> ProjectIconLoader::find(const QString& metaEntryBase, const QString& name) const
+{
+    QPixmap pixmap;
+    if (QPixmapCache::find(keyOf(metaEntryBase, name), &pixmap))
+        return QIcon(pixmap);
+    return {};
+}
+
+void ProjectIconLoader::request(const QString& metaEntryBase, const QString& name, const QUrl& url)
+{
+    auto key = keyOf(metaEntryBase, name);
+    if (name.isEmpty() || url.isEmpty() || m_loading.contains(key) || m_failed.contains(key))
+        return;
+
+    // another list may have loaded it already; answer later, as callers are usually inside data()
+    if (auto icon = find(metaEntryBase, name)) {
+        QTimer::singleShot(0, this, [this, metaEntryBase, name, icon = *icon] { emit iconLoaded(metaEntryBase, name, icon); });
+        return;
+    }
+    m_loading.insert(key);
+
+    Request request{ metaEntryBase, name, url };
+
+    // A recent thumbnail is just as good, and much smaller than the logo
+    QFileInfo thumbnail(thumbnailPath(request));
+    if (thumbnail.exists() && thumbnail.lastModified().secsTo(QDateTime::currentDateTime()) < THUMBNAIL_MAX_AGE_SECS) {
+        decode(request, thumbnail.absoluteFilePath(), false);
+        return;
+    }
+
+    m_queue.append(request);
+    startDownloads();
+}
+
+void ProjectIconLoader::startDownloads()
+{
+    while (m_running_downloads < MAX_RUNNING_DOWNLOADS && !m_queue.isEmpty()) {
+        auto request = m_queue.takeLast();
+
+        auto entry = APPLICATION->metacache()->resolveEntry(request.base, QString("logos/%1").arg(request.name));
+        auto job = new NetJob(QString("Icon Download %1").arg(request.name), APPLICATION->network());
+        job->addNetAction(Net::ApiDownload::makeCached(request.url, entry));
+
+        auto fullPath = entry->getFullPath();
+        connect(job, &NetJob::succeeded, this, [this, request, fullPath] { decode(request, fullPath, true); });
+        connect(job, &NetJob::failed, this, [this, request] {
+            auto key = keyOf(request.base, request.name);
+            m_loading.remove(key);
+            m_failed.insert(key);
+            emit iconFailed(request.base, request.name);
+        });
+        connect(job, &NetJob::finished, this, [this, job] {
+            job->deleteLater();
+            m_running_downloads--;
+            startDownloads();
+        });
+
+        m_running_downloads++;
+        job->start();
+    }
+}
+
+void ProjectIconLoader::decode(const Request& request, const QString& source, bool saveThumbnail)
+{
+    auto thumbnail = thumbnailPath(request);
+    auto thumbnailDir = m_thumbnail_dir;
+    auto watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, request, saveThumbnail, thumbnail] {
+        watcher->deleteLater();
+        auto key = keyOf(request.base, request.name);
+
+        auto image = watcher->result();
+        if (image.isNull() && !saveThumbnail) {
+            // the thumbnail is broken, so make it again
+            QFile::remove(thumbnail);
+            m_queue.append(request);
+            startDownloads();
+            return;
+        }
+
+        m_loading.remove(key);
+        if (image.isNull()) {
+            m_failed.insert(key);
+            emit iconFailed(request.base, request.name);
+            return;
+        }
+
+        // only the conversion to a pixmap has to happen here
+        auto pixmap = QPixmap::fromImage(image);
+        QPixmapCache::insert(key, pixmap);
+        emit iconLoaded(request.base, request.name, QIcon(pixmap));
+    });
+    watcher->setFuture(QtConcurrent::run(QThreadPool::globalInstance(), [source, saveThumbnail, thumbnail, thumbnailDir] {
+        auto image = readThumbnail(source);
+        if (saveThumbnail && !image.isNull()) {
+            QDir().mkpath(thumbnailDir);
+            image.save(thumbnail, "PNG");
+        }
+        return image;
+    }));
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QIcon>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QUrl>
+
+#include <optional>
+
+/** Loads the project logos shown in the lists of every platform page.
+ *
+ *  A logo is downloaded once into the meta cache as `logos/<name>` of its base, even when several lists ask for it.
+ *  It is decoded at thumbnail size on the thread pool, and the thumbnail is kept on disk, so the next time it's shown
+ *  the full image doesn't need to be downloaded or decoded again.
+ *  Logos asked for last are loaded first, since those belong to the rows that were painted last.
+ */
+class ProjectIconLoader : public QObject {
+    Q_OBJECT
+
+   public:
+    static ProjectIconLoader* instance();
+
+    /* The thumbnail of the logo, if it's loaded already. */
+    std::optional<QIcon> find(const QString& metaEntryBase, const QString& name) const;
+
+    /* Starts loading the logo, unless it's loading already or failed before. iconLoaded or iconFailed tells how it went. */
+    void request(const QString& metaEntryBase, const QString& name, const QUrl& url);
+
+   signals:
+    void iconLoaded(const QString& metaEntryBase, const QString& name, const QIcon& icon);
+    void iconFailed(const QString& metaEntryBase, const QString& name);
+
+   private:
+    struct Request {
+        QString base;
+        QString name;
+        QUrl url;
+    };
+
+    explicit ProjectIconLoader(QObject* parent);
+
+    static QString keyOf(const QString& metaEntryBase, const QString& name);
+    QString thumbnailPath(const Request& request) const;
+
+    void startDownloads();
+    void decode(const Request& request, const QString& source, bool saveThumbnail);
+
+    QString m_thumbnail_dir;
+    // newest last, which is the one started next
+    QList<Request> m_queue;
+    QSet<QString> m_loading;
+    QSet<QString> m_failed;
+    int m_running_downloads = 0;
+};
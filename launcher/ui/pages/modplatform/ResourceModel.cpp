@@ -8,10 +8,10 @@
 #include <QIcon>
 #include <QList>
 #include <QMessageBox>
-#include <QPixmapCache>
 #include <QUrl>
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "Application.h"
 #include "BuildConfig.h"
@@ -22,6 +22,7 @@
 
 #include "modplatform/ModIndex.h"
 
+#include "ui/pages/modplatform/ProjectIconLoader.h"
 #include "ui/widgets/ProjectItem.h"
 
 namespace ResourceDownload {
@@ -31,6 +32,8 @@ QHash<ResourceModel*, bool> ResourceModel::s_running_models;
 ResourceModel::ResourceModel(ResourceAPI* api) : QAbstractListModel(), m_api(api)
 {
     s_running_models.insert(this, true);
+    connect(ProjectIconLoader::instance(), &ProjectIconLoader::iconLoaded, this,
+            [this](const QString& metaEntryBase, const QString& name) { iconLoaded(metaEntryBase, name); });
 #ifndef LAUNCHER_TEST
     m_current_info_job.setMaxConcurrent(APPLICATION->settings()->get("NumberOfConcurrentDownloads").toInt());
 #endif
@@ -135,24 +138,26 @@ void ResourceModel::search()
     if (hasActiveSearchJob())
         return;
 
+    auto generation = m_search_generation;
+
     if (m_search_term.startsWith("#")) {
         auto projectId = m_search_term.mid(1);
         if (!projectId.isEmpty()) {
             ResourceAPI::ProjectInfoCallbacks callbacks;
 
-            callbacks.on_fail = [this](QString reason) {
-                if (!s_running_models.constFind(this).value())
+            callbacks.on_fail = [this, generation](QString reason) {
+                if (!isCurrentSearch(this, generation))
                     return;
                 searchRequestFailed(reason, -1);
             };
-            callbacks.on_abort = [this] {
-                if (!s_running_models.constFind(this).value())
+            callbacks.on_abort = [this, generation] {
+                if (!isCurrentSearch(this, generation))
                     return;
                 searchRequestAborted();
             };
 
-            callbacks.on_succeed = [this](auto& doc, auto& pack) {
-                if (!s_running_models.constFind(this).value())
+            callbacks.on_succeed = [this, generation](auto& doc, auto& pack) {
+                if (!isCurrentSearch(this, generation))
                     return;
                 searchRequestForOneSucceeded(doc);
             };
@@ -161,32 +166,103 @@ void ResourceModel::search()
             return;
         }
     }
-    auto args{ createSearchArguments() };
 
+    // The page may have been requested already, while the one before it was being looked at
+    if (m_prefetch_job) {
+        m_prefetch_wanted = true;
+        if (m_prefetched_page)
+            takePrefetchedPage();
+        else
+            m_current_search_job = m_prefetch_job;
+        return;
+    }
+
+    if (auto job = m_api->searchProjects(createSearchArguments(), makeSearchCallbacks(false)); job)
+        runSearchJob(job);
+}
+
+bool ResourceModel::isCurrentSearch(ResourceModel* model, int generation)
+{
+    return s_running_models.constFind(model).value() && model->m_search_generation == generation;
+}
+
+ResourceAPI::SearchCallbacks ResourceModel::makeSearchCallbacks(bool prefetch)
+{
     auto callbacks{ createSearchCallbacks() };
 
     // Use defaults if no callbacks are set
     if (!callbacks.on_succeed)
-        callbacks.on_succeed = [this](auto& doc) {
-            if (!s_running_models.constFind(this).value())
-                return;
-            searchRequestSucceeded(doc);
-        };
+        callbacks.on_succeed = [this](auto& doc) { searchRequestSucceeded(doc); };
     if (!callbacks.on_fail)
-        callbacks.on_fail = [this](QString reason, int network_error_code) {
-            if (!s_running_models.constFind(this).value())
-                return;
-            searchRequestFailed(reason, network_error_code);
-        };
+        callbacks.on_fail = [this](QString reason, int network_error_code) { searchRequestFailed(reason, network_error_code); };
     if (!callbacks.on_abort)
-        callbacks.on_abort = [this] {
-            if (!s_running_models.constFind(this).value())
-                return;
-            searchRequestAborted();
+        callbacks.on_abort = [this] { searchRequestAborted(); };
+
+    // Answers to a search that was replaced since, or to a model that is gone already, are dropped
+    auto generation = m_search_generation;
+    ResourceAPI::SearchCallbacks wrapped;
+    wrapped.on_succeed = [this, generation, prefetch, on_succeed = callbacks.on_succeed](QJsonDocument& doc) {
+        if (!isCurrentSearch(this, generation))
+            return;
+        auto deliver = [this, on_succeed, doc]() mutable {
+            on_succeed(doc);
+            prefetchNextPage();
         };
+        if (prefetch && !m_prefetch_wanted) {
+            // kept until the page is scrolled to
+            m_prefetched_page = deliver;
+            return;
+        }
+        if (prefetch) {
+            m_prefetch_job.reset();
+            m_prefetch_wanted = false;
+        }
+        deliver();
+    };
+    wrapped.on_fail = [this, generation, prefetch, on_fail = callbacks.on_fail](QString const& reason, int network_error_code) {
+        if (!isCurrentSearch(this, generation))
+            return;
+        if (prefetch) {
+            m_prefetch_job.reset();
+            // nobody waits for it yet, so the page is just requested again when it is needed
+            if (!std::exchange(m_prefetch_wanted, false))
+                return;
+        }
+        on_fail(reason, network_error_code);
+    };
+    wrapped.on_abort = [this, generation, prefetch, on_abort = callbacks.on_abort] {
+        if (!isCurrentSearch(this, generation))
+            return;
+        if (prefetch) {
+            m_prefetch_job.reset();
+            if (!std::exchange(m_prefetch_wanted, false))
+                return;
+        }
+        on_abort();
+    };
+    return wrapped;
+}
 
-    if (auto job = m_api->searchProjects(std::move(args), std::move(callbacks)); job)
-        runSearchJob(job);
+void ResourceModel::prefetchNextPage()
+{
+    if (m_search_state != SearchState::CanFetchMore || m_prefetch_job || m_search_term.startsWith("#"))
+        return;
+
+    m_prefetch_wanted = false;
+    m_prefetched_page = nullptr;
+    if (auto job = m_api->searchProjects(createSearchArguments(), makeSearchCallbacks(true)); job) {
+        m_prefetch_job = job;
+        job->start();
+    }
+}
+
+void ResourceModel::takePrefetchedPage()
+{
+    auto deliver = std::move(m_prefetched_page);
+    m_prefetched_page = nullptr;
+    m_prefetch_job.reset();
+    m_prefetch_wanted = false;
+    deliver();
 }
 
 void ResourceModel::loadEntry(QModelIndex& entry)
@@ -249,22 +325,21 @@ void ResourceModel::loadEntry(QModelIndex& entry)
 
 void ResourceModel::refresh()
 {
-    bool reset_requested = false;
+    // Whatever is still on its way answers the previous search, so it is stopped and dropped
+    m_search_generation++;
 
-    if (hasActiveInfoJob()) {
+    if (hasActiveInfoJob())
         m_current_info_job.abort();
-        reset_requested = true;
-    }
 
-    if (hasActiveSearchJob()) {
+    if (hasActiveSearchJob())
         m_current_search_job->abort();
-        reset_requested = true;
-    }
+    m_current_search_job.reset();
 
-    if (reset_requested) {
-        m_search_state = SearchState::ResetRequested;
-        return;
-    }
+    if (m_prefetch_job && m_prefetch_job->isRunning())
+        m_prefetch_job->abort();
+    m_prefetch_job.reset();
+    m_prefetched_page = nullptr;
+    m_prefetch_wanted = false;
 
     clearData();
     m_search_state = SearchState::None;
@@ -313,44 +388,28 @@ std::optional<ResourceAPI::SortingMethod> ResourceModel::getCurrentSortingMethod
 
 std::optional<QIcon> ResourceModel::getIcon(QModelIndex& index, const QUrl& url)
 {
-    QPixmap pixmap;
-    if (QPixmapCache::find(url.toString(), &pixmap))
-        return { pixmap };
-
-    if (!m_current_icon_job)
-        m_current_icon_job.reset(new NetJob("IconJob", APPLICATION->network()));
-
-    if (m_currently_running_icon_actions.contains(url))
-        return {};
-    if (m_failed_icon_actions.contains(url))
-        return {};
-
-    auto cache_entry = APPLICATION->metacache()->resolveEntry(
-        metaEntryBase(),
-        QString("logos/%1").arg(QString(QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Algorithm::Sha1).toHex())));
-    auto icon_fetch_action = Net::ApiDownload::makeCached(url, cache_entry);
-
-    auto full_file_path = cache_entry->getFullPath();
-    connect(icon_fetch_action.get(), &Task::succeeded, this, [=] {
-        auto icon = QIcon(full_file_path);
-        QPixmapCache::insert(url.toString(), icon.pixmap(icon.actualSize({ 64, 64 })));
+    Q_UNUSED(index)
 
-        m_currently_running_icon_actions.remove(url);
+    auto name = QString(QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Algorithm::Sha1).toHex());
+    auto loader = ProjectIconLoader::instance();
+    if (auto icon = loader->find(metaEntryBase(), name); icon.has_value())
+        return icon;
 
-        emit dataChanged(index, index, { Qt::DecorationRole });
-    });
-    connect(icon_fetch_action.get(), &Task::failed, this, [=] {
-        m_currently_running_icon_actions.remove(url);
-        m_failed_icon_actions.insert(url);
-    });
-
-    m_currently_running_icon_actions.insert(url);
+    loader->request(metaEntryBase(), name, url);
+    return {};
+}
 
-    m_current_icon_job->addNetAction(icon_fetch_action);
-    if (!m_current_icon_job->isRunning())
-        QMetaObject::invokeMethod(m_current_icon_job.get(), &NetJob::start);
+void ResourceModel::iconLoaded(const QString& metaEntryBase, const QString& name)
+{
+    if (metaEntryBase != this->metaEntryBase())
+        return;
 
-    return {};
+    // the rows may have moved since the icon was asked for, so look for them again
+    for (int row = 0; row < m_packs.size(); row++) {
+        auto& url = m_packs[row]->logoUrl;
+        if (!url.isEmpty() && QCryptographicHash::hash(QUrl(url).toEncoded(), QCryptographicHash::Algorithm::Sha1).toHex() == name)
+            emit dataChanged(index(row), index(row), { Qt::DecorationRole });
+    }
 }
 
 // No 'forgor to implement' shall pass here :blobfox_knife:
@@ -459,8 +518,8 @@ void ResourceModel::searchRequestFailed([[maybe_unused]] QString reason, int net
 
 void ResourceModel::searchRequestAborted()
 {
-    if (m_search_state != SearchState::ResetRequested)
-        qCritical() << "Search task in" << debugName() << "aborted by an unknown reason!";
+    // superseded searches are dropped before getting here
+    qCritical() << "Search task in" << debugName() << "aborted by an unknown reason!";
 
     // Retry fetching
     clearData();
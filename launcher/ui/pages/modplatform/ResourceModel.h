@@ -123,7 +123,7 @@ class ResourceModel : public QAbstractListModel {
 
    protected:
     /* Basic search parameters */
-    enum class SearchState { None, CanFetchMore, ResetRequested, Finished } m_search_state = SearchState::None;
+    enum class SearchState { None, CanFetchMore, Finished } m_search_state = SearchState::None;
     int m_next_search_offset = 0;
     QString m_search_term;
     unsigned int m_current_sort_index = 0;
@@ -132,13 +132,17 @@ class ResourceModel : public QAbstractListModel {
 
     // Job for searching for new entries
     shared_qobject_ptr<Task> m_current_search_job;
+    // Bumped by every new search, so answers to the requests it replaced are dropped
+    int m_search_generation = 0;
+    // Job for the page after the last one loaded, requested before it's scrolled to
+    shared_qobject_ptr<Task> m_prefetch_job;
+    // Whether that page was asked for already, and it should be shown as soon as it arrives
+    bool m_prefetch_wanted = false;
+    // Shows the prefetched page, once it arrived but wasn't asked for yet
+    std::function<void()> m_prefetched_page;
     // Job for fetching versions and extra info on existing entries
     ConcurrentTask m_current_info_job;
 
-    shared_qobject_ptr<NetJob> m_current_icon_job;
-    QSet<QUrl> m_currently_running_icon_actions;
-    QSet<QUrl> m_failed_icon_actions;
-
     QList<ModPlatform::IndexedPack::Ptr> m_packs;
     QList<DownloadTaskPtr> m_selected;
 
@@ -147,12 +151,20 @@ class ResourceModel : public QAbstractListModel {
     static QHash<ResourceModel*, bool> s_running_models;
 
    private:
+    static bool isCurrentSearch(ResourceModel* model, int generation);
+    /** The callbacks of a search request, with the defaults filled in and answers to superseded searches dropped. */
+    ResourceAPI::SearchCallbacks makeSearchCallbacks(bool prefetch);
+    void prefetchNextPage();
+    void takePrefetchedPage();
+
     /* Default search request callbacks */
     void searchRequestSucceeded(QJsonDocument&);
     void searchRequestForOneSucceeded(QJsonDocument&);
     void searchRequestFailed(QString reason, int network_error_code);
     void searchRequestAborted();
 
+    void iconLoaded(const QString& metaEntryBase, const QString& name);
+
     void versionRequestSucceeded(QJsonDocument&, ModPlatform::IndexedPack&, const QModelIndex&);
 
     void infoRequestSucceeded(QJsonDocument&, ModPlatform::IndexedPack&, const QModelIndex&);
@@ -110,14 +110,12 @@ auto ResourcePage::eventFilter(QObject* watched, QEvent* event) -> bool
         auto* keyEvent = static_cast<QKeyEvent*>(event);
         if (watched == m_ui->searchEdit) {
             if (keyEvent->key() == Qt::Key_Return) {
+                m_search_timer.stop();
                 triggerSearch();
                 keyEvent->accept();
                 return true;
             } else {
-                if (m_search_timer.isActive())
-                    m_search_timer.stop();
-
-                m_search_timer.start(350);
+                scheduleSearch();
             }
         } else if (watched == m_ui->packView) {
             if (keyEvent->key() == Qt::Key_Return) {
@@ -136,6 +134,12 @@ auto ResourcePage::eventFilter(QObject* watched, QEvent* event) -> bool
     return QWidget::eventFilter(watched, event);
 }
 
+void ResourcePage::scheduleSearch()
+{
+    // restarting the timer pushes the search back
+    m_search_timer.start(350);
+}
+
 QString ResourcePage::getSearchTerm() const
 {
     return m_ui->searchEdit->text();
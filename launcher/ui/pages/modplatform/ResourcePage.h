@@ -85,6 +85,8 @@ class ResourcePage : public QWidget, public BasePage {
 
    protected slots:
     virtual void triggerSearch() {}
+    /** Searches once the input stopped changing for a moment, so typing or scrolling through options makes one request. */
+    void scheduleSearch();
 
     void onSelectionChanged(QModelIndex first, QModelIndex second);
     void onVersionSelectionChanged(QString data);
@@ -25,6 +25,13 @@ TexturePackResourceModel::TexturePackResourceModel(BaseInstance const& inst, Res
 
 void waitOnVersionListLoad(Meta::VersionList::Ptr version_list)
 {
+    // only the network is waited on, what's on disk already has the versions needed
+    if (version_list->isLoaded())
+        return;
+    auto task = version_list->getLoadTask();
+    if (version_list->isLoaded() || !task)
+        return;
+
     QEventLoop load_version_list_loop;
 
     QTimer time_limit_for_list_load;
@@ -33,7 +40,6 @@ void waitOnVersionListLoad(Meta::VersionList::Ptr version_list)
     time_limit_for_list_load.callOnTimeout(&load_version_list_loop, &QEventLoop::quit);
     time_limit_for_list_load.start(4000);
 
-    auto task = version_list->getLoadTask();
     QObject::connect(task.get(), &Task::finished, &load_version_list_loop, &QEventLoop::quit);
 
     load_version_list_loop.exec();
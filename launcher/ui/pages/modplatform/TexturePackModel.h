@@ -15,7 +15,11 @@ class TexturePackResourceModel : public ResourcePackResourceModel {
    public:
     TexturePackResourceModel(BaseInstance const& inst, ResourceAPI* api);
 
-    [[nodiscard]] inline ::Version maximumTexturePackVersion() const { return { "1.6" }; }
+    [[nodiscard]] inline const ::Version& maximumTexturePackVersion() const
+    {
+        static const ::Version s_maximum("1.6");
+        return s_maximum;
+    }
 
     ResourceAPI::SearchArgs createSearchArguments() override;
     ResourceAPI::VersionSearchArgs createVersionsArguments(QModelIndex&) override;
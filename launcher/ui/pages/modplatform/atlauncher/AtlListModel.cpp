@@ -21,11 +21,23 @@
 #include <Json.h>
 
 #include "net/ApiDownload.h"
+#include "ui/pages/modplatform/ProjectIconLoader.h"
 #include "ui/widgets/ProjectItem.h"
 
 namespace Atl {
 
-ListModel::ListModel(QObject* parent) : QAbstractListModel(parent) {}
+ListModel::ListModel(QObject* parent) : QAbstractListModel(parent)
+{
+    auto loader = ProjectIconLoader::instance();
+    connect(loader, &ProjectIconLoader::iconLoaded, this, [this](const QString& base, const QString& logo, const QIcon& icon) {
+        if (base == "ATLauncherPacks")
+            logoLoaded(logo, icon);
+    });
+    connect(loader, &ProjectIconLoader::iconFailed, this, [this](const QString& base, const QString& logo) {
+        if (base == "ATLauncherPacks")
+            logoFailed(logo);
+    });
+}
 
 ListModel::~ListModel() {}
 
@@ -95,13 +107,17 @@ QVariant ListModel::data(const QModelIndex& index, int role) const
 
 void ListModel::request()
 {
+    if (jobPtr)
+        jobPtr->abort();
+
     beginResetModel();
     modpacks.clear();
     endResetModel();
 
     auto netJob = makeShared<NetJob>("Atl::Request", APPLICATION->network());
     auto url = QString(BuildConfig.ATL_DOWNLOAD_SERVER_URL + "launcher/json/packsnew.json");
-    netJob->addNetAction(Net::ApiDownload::makeByteArray(QUrl(url), response));
+    // the list is big, show the packs as they come in
+    netJob->addNetAction(Net::ApiDownload::makeJsonArray(QUrl(url), [this](const QList<QJsonObject>& packs) { addPacks(packs); }));
     jobPtr = netJob;
     jobPtr->start();
 
@@ -112,29 +128,22 @@ void ListModel::request()
 void ListModel::requestFinished()
 {
     jobPtr.reset();
+}
 
-    QJsonParseError parse_error;
-    QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-    if (parse_error.error != QJsonParseError::NoError) {
-        qWarning() << "Error while parsing JSON response from ATL at " << parse_error.offset << " reason: " << parse_error.errorString();
-        qWarning() << *response;
-        return;
-    }
-
+void ListModel::addPacks(const QList<QJsonObject>& packs)
+{
     QList<ATLauncher::IndexedPack> newList;
 
-    auto packs = doc.array();
-    for (auto packRaw : packs) {
-        auto packObj = packRaw.toObject();
-
+    for (auto packObj : packs) {
         ATLauncher::IndexedPack pack;
 
         try {
             ATLauncher::loadIndexedPack(pack, packObj);
         } catch (const JSONValidationError& e) {
-            qDebug() << QString::fromUtf8(*response);
+            // the ones before it are already shown, so only leave this one out
+            qDebug() << QJsonDocument(packObj).toJson();
             qWarning() << "Error while reading pack manifest from ATLauncher: " << e.cause();
-            return;
+            continue;
         }
 
         // ignore packs without a published version
@@ -149,6 +158,8 @@ void ListModel::requestFinished()
 
         newList.append(pack);
     }
+    if (newList.isEmpty())
+        return;
 
     beginInsertRows(QModelIndex(), modpacks.size(), modpacks.size() + newList.size() - 1);
     modpacks.append(newList);
@@ -193,25 +204,7 @@ void ListModel::requestLogo(QString file, QString url)
         return;
     }
 
-    MetaEntryPtr entry = APPLICATION->metacache()->resolveEntry("ATLauncherPacks", QString("logos/%1").arg(file));
-    auto job = new NetJob(QString("ATLauncher Icon Download %1").arg(file), APPLICATION->network());
-    job->addNetAction(Net::ApiDownload::makeCached(QUrl(url), entry));
-
-    auto fullPath = entry->getFullPath();
-    QObject::connect(job, &NetJob::succeeded, this, [this, file, fullPath, job] {
-        job->deleteLater();
-        emit logoLoaded(file, QIcon(fullPath));
-        if (waitingCallbacks.contains(file)) {
-            waitingCallbacks.value(file)(fullPath);
-        }
-    });
-
-    QObject::connect(job, &NetJob::failed, this, [this, file, job] {
-        job->deleteLater();
-        emit logoFailed(file);
-    });
-
-    job->start();
+    ProjectIconLoader::instance()->request("ATLauncherPacks", file, QUrl(url));
 
     m_loadingLogos.append(file);
 }
@@ -51,6 +51,7 @@ class ListModel : public QAbstractListModel {
 
    private:
     void requestLogo(QString file, QString url);
+    void addPacks(const QList<QJsonObject>& packs);
 
    private:
     QList<ATLauncher::IndexedPack> modpacks;
@@ -58,10 +59,8 @@ class ListModel : public QAbstractListModel {
     QStringList m_failedLogos;
     QStringList m_loadingLogos;
     LogoMap m_logoMap;
-    QMap<QString, LogoCallback> waitingCallbacks;
 
     NetJob::Ptr jobPtr;
-    std::shared_ptr<QByteArray> response = std::make_shared<QByteArray>();
 };
 
 }  // namespace Atl
@@ -6,6 +6,7 @@
 #include "ui/widgets/ProjectItem.h"
 
 #include "net/ApiDownload.h"
+#include "ui/pages/modplatform/ProjectIconLoader.h"
 
 #include <Version.h>
 
@@ -13,7 +14,18 @@
 
 namespace Flame {
 
-ListModel::ListModel(QObject* parent) : QAbstractListModel(parent) {}
+ListModel::ListModel(QObject* parent) : QAbstractListModel(parent)
+{
+    auto loader = ProjectIconLoader::instance();
+    connect(loader, &ProjectIconLoader::iconLoaded, this, [this](const QString& base, const QString& logo, const QIcon& icon) {
+        if (base == "FlamePacks")
+            logoLoaded(logo, icon);
+    });
+    connect(loader, &ProjectIconLoader::iconFailed, this, [this](const QString& base, const QString& logo) {
+        if (base == "FlamePacks")
+            logoFailed(logo);
+    });
+}
 
 ListModel::~ListModel() {}
 
@@ -108,25 +120,7 @@ void ListModel::requestLogo(QString logo, QString url)
         return;
     }
 
-    MetaEntryPtr entry = APPLICATION->metacache()->resolveEntry("FlamePacks", QString("logos/%1").arg(logo));
-    auto job = new NetJob(QString("Flame Icon Download %1").arg(logo), APPLICATION->network());
-    job->addNetAction(Net::ApiDownload::makeCached(QUrl(url), entry));
-
-    auto fullPath = entry->getFullPath();
-    QObject::connect(job, &NetJob::succeeded, this, [this, logo, fullPath, job] {
-        job->deleteLater();
-        emit logoLoaded(logo, QIcon(fullPath));
-        if (waitingCallbacks.contains(logo)) {
-            waitingCallbacks.value(logo)(fullPath);
-        }
-    });
-
-    QObject::connect(job, &NetJob::failed, this, [this, logo, job] {
-        job->deleteLater();
-        emit logoFailed(logo);
-    });
-
-    job->start();
+    ProjectIconLoader::instance()->request("FlamePacks", logo, QUrl(url));
 
     m_loadingLogos.append(logo);
 }
@@ -61,7 +61,6 @@ class ListModel : public QAbstractListModel {
     QStringList m_failedLogos;
     QStringList m_loadingLogos;
     LogoMap m_logoMap;
-    QMap<QString, LogoCallback> waitingCallbacks;
 
     QString currentSearchTerm;
     int currentSort = 0;
@@ -38,6 +38,7 @@
 #include "ui_FlamePage.h"
 
 #include <QKeyEvent>
+#include <QScrollBar>
 
 #include "Application.h"
 #include "FlameModel.h"
@@ -51,6 +52,9 @@
 
 static FlameAPI api;
 
+// packs can have hundreds of files, they are asked for a few screens of the version list at a time
+static constexpr int versionsPageSize = 50;
+
 FlamePage::FlamePage(NewInstanceDialog* dialog, QWidget* parent)
     : QWidget(parent), ui(new Ui::FlamePage), dialog(dialog), m_fetch_progress(this, false)
 {
@@ -85,6 +89,8 @@ FlamePage::FlamePage(NewInstanceDialog* dialog, QWidget* parent)
     connect(ui->sortByBox, SIGNAL(currentIndexChanged(int)), this, SLOT(triggerSearch()));
     connect(ui->packView->selectionModel(), &QItemSelectionModel::currentChanged, this, &FlamePage::onSelectionChanged);
     connect(ui->versionSelectionBox, &QComboBox::currentTextChanged, this, &FlamePage::onVersionSelectionChanged);
+    connect(ui->versionSelectionBox->view()->verticalScrollBar(), &QScrollBar::valueChanged, this, &FlamePage::fetchMoreVersionsIfAtEnd);
+    ui->versionSelectionBox->view()->installEventFilter(this);
 
     ui->packView->setItemDelegate(new ProjectItemDelegate(this));
     ui->packDescription->setMetaEntry("FlamePacks");
@@ -110,6 +116,9 @@ bool FlamePage::eventFilter(QObject* watched, QEvent* event)
             m_search_timer.start(350);
         }
     }
+    if (watched == ui->versionSelectionBox->view() && event->type() == QEvent::Show) {
+        fetchMoreVersionsIfAtEnd();
+    }
     return QWidget::eventFilter(watched, event);
 }
 
@@ -147,70 +156,117 @@ void FlamePage::onSelectionChanged(QModelIndex curr, [[maybe_unused]] QModelInde
     }
 
     current = listModel->data(curr, Qt::UserRole).value<Flame::IndexedPack>();
+    m_current_index = curr;
 
     if (current.versionsLoaded == false) {
         qDebug() << "Loading flame modpack versions";
-        auto netJob = new NetJob(QString("Flame::PackVersions(%1)").arg(current.name), APPLICATION->network());
-        auto response = std::make_shared<QByteArray>();
-        int addonId = current.addonId;
-        netJob->addNetAction(
-            Net::ApiDownload::makeByteArray(QString("https://api.curseforge.com/v1/mods/%1/files").arg(addonId), response));
-
-        QObject::connect(netJob, &NetJob::succeeded, this, [this, response, addonId, curr] {
-            if (addonId != current.addonId) {
-                return;  // wrong request
-            }
-            QJsonParseError parse_error;
-            QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-            if (parse_error.error != QJsonParseError::NoError) {
-                qWarning() << "Error while parsing JSON response from CurseForge at " << parse_error.offset
-                           << " reason: " << parse_error.errorString();
-                qWarning() << *response;
-                return;
-            }
-            auto arr = Json::ensureArray(doc.object(), "data");
-            try {
-                Flame::loadIndexedPackVersions(current, arr);
-            } catch (const JSONValidationError& e) {
-                qDebug() << *response;
-                qWarning() << "Error while reading flame modpack version: " << e.cause();
-            }
+        fetchVersionsPage();
+    } else {
+        addVersionItems(0);
+        suggestCurrent();
+    }
 
-            for (auto version : current.versions) {
-                auto release_type = version.version_type.isValid() ? QString(" [%1]").arg(version.version_type.toString()) : "";
-                ui->versionSelectionBox->addItem(QString("%1%2").arg(version.version, release_type), QVariant(version.downloadUrl));
-            }
+    // TODO: Check whether it's a connection issue or the project disabled 3rd-party distribution.
+    if (current.versionsLoaded && !current.hasMoreVersions() && ui->versionSelectionBox->count() < 1) {
+        ui->versionSelectionBox->addItem(tr("No version is available!"), -1);
+    }
 
-            QVariant current_updated;
-            current_updated.setValue(current);
+    updateUi();
+}
 
-            if (!listModel->setData(curr, current_updated, Qt::UserRole))
-                qWarning() << "Failed to cache versions for the current pack!";
+void FlamePage::fetchVersionsPage()
+{
+    if (m_fetching_versions_of == current.addonId || !current.hasMoreVersions()) {
+        return;
+    }
+    m_fetching_versions_of = current.addonId;
+
+    auto netJob = new NetJob(QString("Flame::PackVersions(%1)").arg(current.name), APPLICATION->network());
+    auto response = std::make_shared<QByteArray>();
+    int addonId = current.addonId;
+    netJob->addNetAction(Net::ApiDownload::makeByteArray(QString("https://api.curseforge.com/v1/mods/%1/files?index=%2&pageSize=%3")
+                                                             .arg(addonId)
+                                                             .arg(current.versionsFetched)
+                                                             .arg(versionsPageSize),
+                                                         response));
+
+    QObject::connect(netJob, &NetJob::succeeded, this, [this, response, addonId] {
+        if (m_fetching_versions_of == addonId) {
+            m_fetching_versions_of = -1;
+        }
+        if (addonId != current.addonId) {
+            return;  // wrong request
+        }
+        QJsonParseError parse_error;
+        QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
+        if (parse_error.error != QJsonParseError::NoError) {
+            qWarning() << "Error while parsing JSON response from CurseForge at " << parse_error.offset
+                       << " reason: " << parse_error.errorString();
+            qWarning() << *response;
+            return;
+        }
+        auto arr = Json::ensureArray(doc.object(), "data");
+        int from = current.versions.size();
+        try {
+            Flame::loadIndexedPackVersionsPage(current, arr, Json::ensureObject(doc.object(), "pagination"));
+        } catch (const JSONValidationError& e) {
+            qDebug() << *response;
+            qWarning() << "Error while reading flame modpack version: " << e.cause();
+            return;
+        }
 
-            // TODO: Check whether it's a connection issue or the project disabled 3rd-party distribution.
-            if (current.versionsLoaded && ui->versionSelectionBox->count() < 1) {
-                ui->versionSelectionBox->addItem(tr("No version is available!"), -1);
-            }
+        addVersionItems(from);
+
+        QVariant current_updated;
+        current_updated.setValue(current);
+
+        if (!m_current_index.isValid() || !listModel->setData(m_current_index, current_updated, Qt::UserRole))
+            qWarning() << "Failed to cache versions for the current pack!";
+
+        if (current.versions.size() == from && current.hasMoreVersions()) {
+            // nothing on this page can be downloaded, the list would stay empty without the next one
+            fetchVersionsPage();
+            return;
+        }
+
+        // TODO: Check whether it's a connection issue or the project disabled 3rd-party distribution.
+        if (!current.hasMoreVersions() && ui->versionSelectionBox->count() < 1) {
+            ui->versionSelectionBox->addItem(tr("No version is available!"), -1);
+        }
+        if (from == 0) {
             suggestCurrent();
-        });
-        QObject::connect(netJob, &NetJob::finished, this, [response, netJob] { netJob->deleteLater(); });
-        connect(netJob, &NetJob::failed,
-                [this](QString reason) { CustomMessageBox::selectable(this, tr("Error"), reason, QMessageBox::Critical)->exec(); });
-        netJob->start();
-    } else {
-        for (auto version : current.versions) {
-            ui->versionSelectionBox->addItem(version.version, QVariant(version.downloadUrl));
         }
+        fetchMoreVersionsIfAtEnd();
+    });
+    QObject::connect(netJob, &NetJob::failed, this, [this, addonId](QString reason) {
+        if (m_fetching_versions_of == addonId) {
+            m_fetching_versions_of = -1;
+        }
+        CustomMessageBox::selectable(this, tr("Error"), reason, QMessageBox::Critical)->exec();
+    });
+    QObject::connect(netJob, &NetJob::finished, this, [response, netJob] { netJob->deleteLater(); });
+    netJob->start();
+}
 
-        suggestCurrent();
+void FlamePage::addVersionItems(int from)
+{
+    for (int i = from; i < current.versions.size(); i++) {
+        auto& version = current.versions.at(i);
+        auto release_type = version.version_type.isValid() ? QString(" [%1]").arg(version.version_type.toString()) : "";
+        ui->versionSelectionBox->addItem(QString("%1%2").arg(version.version, release_type), QVariant(version.downloadUrl));
     }
+}
 
-    // TODO: Check whether it's a connection issue or the project disabled 3rd-party distribution.
-    if (current.versionsLoaded && ui->versionSelectionBox->count() < 1) {
-        ui->versionSelectionBox->addItem(tr("No version is available!"), -1);
+void FlamePage::fetchMoreVersionsIfAtEnd()
+{
+    auto view = ui->versionSelectionBox->view();
+    if (!view->isVisible() || !current.hasMoreVersions()) {
+        return;
+    }
+    auto scrollBar = view->verticalScrollBar();
+    if (scrollBar->value() >= scrollBar->maximum() - scrollBar->pageStep() / 2) {
+        fetchVersionsPage();
     }
-
-    updateUi();
 }
 
 void FlamePage::suggestCurrent()
@@ -74,6 +74,11 @@ class FlamePage : public QWidget, public BasePage {
 
    private:
     void suggestCurrent();
+    /// asks for the next page of the current pack's files, unless it has no more or they're being asked for already
+    void fetchVersionsPage();
+    void addVersionItems(int from);
+    /// fetches more versions once the list is scrolled to its end, or opened without anything to scroll
+    void fetchMoreVersionsIfAtEnd();
 
    private slots:
     void triggerSearch();
@@ -85,6 +90,9 @@ class FlamePage : public QWidget, public BasePage {
     NewInstanceDialog* dialog = nullptr;
     Flame::ListModel* listModel = nullptr;
     Flame::IndexedPack current;
+    QPersistentModelIndex m_current_index;
+    /// the pack whose files are being asked for, -1 if none
+    int m_fetching_versions_of = -1;
 
     int m_selected_version_index = -1;
 
@@ -83,10 +83,10 @@ void FlameTexturePackModel::loadIndexedPackVersions(ModPlatform::IndexedPack& m,
 
     // FIXME: Client-side version filtering. This won't take into account any user-selected filtering.
     for (auto const& version : m.versions) {
-        auto const& mc_versions = version.mcVersion;
+        auto const& mc_versions = version.comparableMcVersions();
 
         if (std::any_of(mc_versions.constBegin(), mc_versions.constEnd(),
-                        [this](auto const& mc_version) { return Version(mc_version) <= maximumTexturePackVersion(); }))
+                        [this](auto const& mc_version) { return mc_version <= maximumTexturePackVersion(); }))
             filtered_versions.push_back(version);
     }
 
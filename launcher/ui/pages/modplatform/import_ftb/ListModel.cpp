@@ -50,6 +50,7 @@ void ListModel::update()
 {
     beginResetModel();
     modpacks.clear();
+    icons.clear();
 
     QString instancesPath = getPath();
     if (auto instancesInfo = QFileInfo(instancesPath); instancesInfo.exists() && instancesInfo.isDir()) {
@@ -81,8 +82,14 @@ QVariant ListModel::data(const QModelIndex& index, int role) const
     switch (role) {
         case Qt::ToolTipRole:
             return tr("Minecraft %1").arg(pack.mcVersion);
-        case Qt::DecorationRole:
-            return pack.icon;
+        case Qt::DecorationRole: {
+            if (pack.iconPath.isEmpty())
+                return QIcon();
+            auto icon = icons.constFind(pack.iconPath);
+            if (icon == icons.cend())
+                icon = icons.insert(pack.iconPath, QIcon(pack.iconPath));
+            return *icon;
+        }
         case Qt::UserRole: {
             QVariant v;
             v.setValue(pack);
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
 #include <QIcon>
 #include <QSortFilterProxyModel>
 #include <QVariant>
@@ -65,5 +66,7 @@ class ListModel : public QAbstractListModel {
 
    private:
     ModpackList modpacks;
+    // only the icons of the packs that were shown are loaded
+    mutable QHash<QString, QIcon> icons;
 };
 }  // namespace FTBImportAPP
\ No newline at end of file
@@ -43,12 +43,24 @@
 #include "ui/widgets/ProjectItem.h"
 
 #include "net/ApiDownload.h"
+#include "ui/pages/modplatform/ProjectIconLoader.h"
 
 #include <QMessageBox>
 
 namespace Modrinth {
 
-ModpackListModel::ModpackListModel(ModrinthPage* parent) : QAbstractListModel(parent), m_parent(parent) {}
+ModpackListModel::ModpackListModel(ModrinthPage* parent) : QAbstractListModel(parent), m_parent(parent)
+{
+    auto loader = ProjectIconLoader::instance();
+    connect(loader, &ProjectIconLoader::iconLoaded, this, [this](const QString& base, const QString& logo, const QIcon& icon) {
+        if (base == m_parent->metaEntryBase())
+            logoLoaded(logo, icon);
+    });
+    connect(loader, &ProjectIconLoader::iconFailed, this, [this](const QString& base, const QString& logo) {
+        if (base == m_parent->metaEntryBase())
+            logoFailed(logo);
+    });
+}
 
 auto ModpackListModel::debugName() const -> QString
 {
@@ -252,25 +264,7 @@ void ModpackListModel::requestLogo(QString logo, QString url)
         return;
     }
 
-    MetaEntryPtr entry = APPLICATION->metacache()->resolveEntry(m_parent->metaEntryBase(), QString("logos/%1").arg(logo));
-    auto job = new NetJob(QString("%1 Icon Download %2").arg(m_parent->debugName()).arg(logo), APPLICATION->network());
-    job->addNetAction(Net::ApiDownload::makeCached(QUrl(url), entry));
-
-    auto fullPath = entry->getFullPath();
-    QObject::connect(job, &NetJob::succeeded, this, [this, logo, fullPath, job] {
-        job->deleteLater();
-        emit logoLoaded(logo, QIcon(fullPath));
-        if (waitingCallbacks.contains(logo)) {
-            waitingCallbacks.value(logo)(fullPath);
-        }
-    });
-
-    QObject::connect(job, &NetJob::failed, this, [this, logo, job] {
-        job->deleteLater();
-        emit logoFailed(logo);
-    });
-
-    job->start();
+    ProjectIconLoader::instance()->request(m_parent->metaEntryBase(), logo, QUrl(url));
     m_loadingLogos.append(logo);
 }
 
@@ -106,7 +106,6 @@ class ModpackListModel : public QAbstractListModel {
     QList<Modrinth::Modpack> modpacks;
 
     LogoMap m_logoMap;
-    QMap<QString, LogoCallback> waitingCallbacks;
     QStringList m_failedLogos;
     QStringList m_loadingLogos;
 
@@ -39,13 +39,25 @@
 #include "Json.h"
 
 #include "net/ApiDownload.h"
+#include "ui/pages/modplatform/ProjectIconLoader.h"
 #include "ui/widgets/ProjectItem.h"
 
 #include <QFileInfo>
 #include <QIcon>
 #include <QUrl>
 
-Technic::ListModel::ListModel(QObject* parent) : QAbstractListModel(parent) {}
+Technic::ListModel::ListModel(QObject* parent) : QAbstractListModel(parent)
+{
+    auto loader = ProjectIconLoader::instance();
+    connect(loader, &ProjectIconLoader::iconLoaded, this, [this](const QString& base, const QString& logo, const QIcon& icon) {
+        if (base == "TechnicPacks")
+            logoLoaded(logo, icon);
+    });
+    connect(loader, &ProjectIconLoader::iconFailed, this, [this](const QString& base, const QString& logo) {
+        if (base == "TechnicPacks")
+            logoFailed(logo);
+    });
+}
 
 Technic::ListModel::~ListModel() {}
 
@@ -267,10 +279,10 @@ void Technic::ListModel::searchRequestFailed()
     }
 }
 
-void Technic::ListModel::logoLoaded(QString logo, QString out)
+void Technic::ListModel::logoLoaded(QString logo, QIcon out)
 {
     m_loadingLogos.removeAll(logo);
-    m_logoMap.insert(logo, QIcon(out));
+    m_logoMap.insert(logo, out);
     for (int i = 0; i < modpacks.size(); i++) {
         if (modpacks[i].logoName == logo) {
             emit dataChanged(createIndex(i, 0), createIndex(i, 0), { Qt::DecorationRole });
@@ -290,23 +302,6 @@ void Technic::ListModel::requestLogo(QString logo, QString url)
         return;
     }
 
-    MetaEntryPtr entry = APPLICATION->metacache()->resolveEntry("TechnicPacks", QString("logos/%1").arg(logo));
-    auto job = new NetJob(QString("Technic Icon Download %1").arg(logo), APPLICATION->network());
-    job->addNetAction(Net::ApiDownload::makeCached(QUrl(url), entry));
-
-    auto fullPath = entry->getFullPath();
-
-    QObject::connect(job, &NetJob::succeeded, this, [this, logo, fullPath, job] {
-        job->deleteLater();
-        logoLoaded(logo, fullPath);
-    });
-
-    QObject::connect(job, &NetJob::failed, this, [this, logo, job] {
-        job->deleteLater();
-        logoFailed(logo);
-    });
-
-    job->start();
-
+    ProjectIconLoader::instance()->request("TechnicPacks", logo, QUrl(url));
     m_loadingLogos.append(logo);
 }
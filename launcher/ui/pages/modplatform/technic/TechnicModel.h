@@ -66,7 +66,7 @@ class ListModel : public QAbstractListModel {
     void searchRequestFailed();
 
     void logoFailed(QString logo);
-    void logoLoaded(QString logo, QString out);
+    void logoLoaded(QString logo, QIcon out);
 
    private:
     void performSearch();
@@ -77,7 +77,6 @@ class ListModel : public QAbstractListModel {
     QStringList m_failedLogos;
     QStringList m_loadingLogos;
     QMap<QString, QIcon> m_logoMap;
-    QMap<QString, LogoCallback> waitingCallbacks;
 
     QString currentSearchTerm;
     enum SearchState { None, ResetRequested, Finished } searchState = None;
@@ -40,15 +40,39 @@
 #include "HintOverrideProxyStyle.h"
 #include "rainbow.h"
 
+// the Qt style that was set last, by any theme
+static QString s_qtStyle;
+
+bool ITheme::applyQtStyle(const QString& name)
+{
+    if (!s_qtStyle.isNull() && s_qtStyle.compare(name, Qt::CaseInsensitive) == 0)
+        return false;
+    s_qtStyle = name;
+    QApplication::setStyle(new HintOverrideProxyStyle(QStyleFactory::create(name)));
+    return true;
+}
+
 void ITheme::apply(bool)
 {
-    APPLICATION->setStyleSheet(QString());
-    QApplication::setStyle(new HintOverrideProxyStyle(QStyleFactory::create(qtTheme())));
-    if (hasColorScheme()) {
+    // every one of these polishes all the widgets there are again, so only what changes is set.
+    // The stylesheet can refer to theme resources, they have to be there before it's set.
+    QDir::setSearchPaths("theme", searchPaths());
+
+    bool styleChanged = s_qtStyle.isNull() || s_qtStyle.compare(qtTheme(), Qt::CaseInsensitive) != 0;
+    if (styleChanged) {
+        // the new style shouldn't be polished with the old stylesheet
+        APPLICATION->setStyleSheet(QString());
+        applyQtStyle(qtTheme());
+    }
+    bool paletteChanged = hasColorScheme() && QApplication::palette() != colorScheme();
+    if (paletteChanged) {
         QApplication::setPalette(colorScheme());
     }
-    APPLICATION->setStyleSheet(appStyleSheet());
-    QDir::setSearchPaths("theme", searchPaths());
+    // the stylesheet may use the palette, so it's set again along with it
+    auto styleSheet = appStyleSheet();
+    if (paletteChanged || APPLICATION->styleSheet() != styleSheet) {
+        APPLICATION->setStyleSheet(styleSheet);
+    }
 }
 
 QPalette ITheme::fadeInactive(QPalette in, qreal bias, QColor color)
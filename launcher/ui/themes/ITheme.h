@@ -54,4 +54,8 @@ class ITheme {
     virtual QStringList searchPaths() { return {}; }
 
     static QPalette fadeInactive(QPalette in, qreal bias, QColor color);
+
+   protected:
+    /// sets that Qt style for the application, unless it's the one in use already. Returns whether it was set.
+    static bool applyQtStyle(const QString& name);
 };
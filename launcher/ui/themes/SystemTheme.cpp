@@ -38,7 +38,6 @@
 #include <QDebug>
 #include <QStyle>
 #include <QStyleFactory>
-#include "HintOverrideProxyStyle.h"
 #include "ThemeManager.h"
 
 SystemTheme::SystemTheme()
@@ -67,7 +66,7 @@ void SystemTheme::apply(bool initial)
     // See https://github.com/MultiMC/Launcher/issues/1790
     // or https://github.com/PrismLauncher/PrismLauncher/issues/490
     if (initial) {
-        QApplication::setStyle(new HintOverrideProxyStyle(QStyleFactory::create(qtTheme())));
+        applyQtStyle(qtTheme());
         return;
     }
 
@@ -8,6 +8,11 @@ unique_qobject_ptr<ModFilterWidget> ModFilterWidget::create(Version default_vers
     auto filter_widget = new ModFilterWidget(default_version, parent);
 
     if (!filter_widget->versionList()->isLoaded()) {
+        auto task = filter_widget->versionList()->getLoadTask();
+        // what's on disk is good enough for the filter, the list is refreshed in the background
+        if (filter_widget->versionList()->isLoaded() || !task)
+            return unique_qobject_ptr<ModFilterWidget>(filter_widget);
+
         QEventLoop load_version_list_loop;
 
         QTimer time_limit_for_list_load;
@@ -16,8 +21,6 @@ unique_qobject_ptr<ModFilterWidget> ModFilterWidget::create(Version default_vers
         time_limit_for_list_load.callOnTimeout(&load_version_list_loop, &QEventLoop::quit);
         time_limit_for_list_load.start(4000);
 
-        auto task = filter_widget->versionList()->getLoadTask();
-
         connect(task.get(), &Task::failed,
                 [filter_widget] { filter_widget->disableVersionButton(VersionButtonID::Major, tr("failed to get version index")); });
         connect(task.get(), &Task::finished, &load_version_list_loop, &QEventLoop::quit);
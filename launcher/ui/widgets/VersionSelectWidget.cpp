@@ -1,6 +1,7 @@
 #include "VersionSelectWidget.h"
 
 #include <QApplication>
+#include <QDebug>
 #include <QEvent>
 #include <QHeaderView>
 #include <QKeyEvent>
@@ -54,6 +55,22 @@ VersionSelectWidget::VersionSelectWidget(QWidget* parent) : QWidget(parent)
     sneakyProgressBar->setHidden(true);
     connect(listView->selectionModel(), &QItemSelectionModel::currentRowChanged, this, &VersionSelectWidget::currentRowChanged);
 
+    // a list refreshed in the background resets the model, the selection should survive that
+    connect(m_proxyModel, &QAbstractItemModel::modelAboutToBeReset, this, [this] {
+        m_selectedBeforeReset = m_proxyModel->data(listView->selectionModel()->currentIndex(), BaseVersionList::VersionRole).toString();
+    });
+    connect(m_proxyModel, &QAbstractItemModel::modelReset, this, [this] {
+        if (m_selectedBeforeReset.isEmpty()) {
+            return;
+        }
+        auto idx = m_proxyModel->getVersion(m_selectedBeforeReset);
+        m_selectedBeforeReset.clear();
+        if (idx.isValid()) {
+            listView->selectionModel()->setCurrentIndex(idx, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+            listView->scrollTo(idx, QAbstractItemView::PositionAtCenter);
+        }
+    });
+
     QMetaObject::connectSlotsByName(this);
 }
 
@@ -113,7 +130,8 @@ void VersionSelectWidget::initialize(BaseVersionList* vlist)
     listView->header()->setSectionResizeMode(resizeOnColumn, QHeaderView::Stretch);
 
     if (!m_vlist->isLoaded()) {
-        loadList();
+        // not asked for, so a refresh failing while there's something on disk to show isn't worth a message box
+        startLoad(true);
     } else {
         if (m_proxyModel->rowCount() == 0) {
             listView->setEmptyMode(VersionListView::String);
@@ -128,12 +146,25 @@ void VersionSelectWidget::closeEvent(QCloseEvent* event)
 }
 
 void VersionSelectWidget::loadList()
+{
+    startLoad(false);
+}
+
+void VersionSelectWidget::startLoad(bool quietFailure)
 {
     auto newTask = m_vlist->getLoadTask();
+    // what's on disk is shown right away, the remote copy only replaces it in the background, if it changed
+    if (m_vlist->isLoaded()) {
+        if (m_proxyModel->rowCount() == 0) {
+            listView->setEmptyMode(VersionListView::String);
+        }
+        preselect();
+    }
     if (!newTask) {
         return;
     }
     loadTask = newTask.get();
+    m_quietLoadFailure = quietFailure && m_vlist->isLoaded() && m_proxyModel->rowCount() != 0;
     connect(loadTask, &Task::succeeded, this, &VersionSelectWidget::onTaskSucceeded);
     connect(loadTask, &Task::failed, this, &VersionSelectWidget::onTaskFailed);
     connect(loadTask, &Task::progress, this, &VersionSelectWidget::changeProgress);
@@ -155,6 +186,11 @@ void VersionSelectWidget::onTaskSucceeded()
 
 void VersionSelectWidget::onTaskFailed(const QString& reason)
 {
+    if (m_quietLoadFailure) {
+        qWarning() << "Couldn't refresh the version list, showing the local one:" << reason;
+        onTaskSucceeded();
+        return;
+    }
     CustomMessageBox::selectable(this, tr("Error"), tr("List update failed:\n%1").arg(reason), QMessageBox::Warning)->show();
     onTaskSucceeded();
 }
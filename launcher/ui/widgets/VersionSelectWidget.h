@@ -91,6 +91,7 @@ class VersionSelectWidget : public QWidget {
     void currentRowChanged(const QModelIndex& current, const QModelIndex&);
 
    private:
+    void startLoad(bool quietFailure);
     void preselect();
 
    private:
@@ -100,6 +101,9 @@ class VersionSelectWidget : public QWidget {
     int resizeOnColumn = 0;
     Task* loadTask;
     bool preselectedAlready = false;
+    // the running load only refreshes what is shown already
+    bool m_quietLoadFailure = false;
+    QString m_selectedBeforeReset;
 
     QVBoxLayout* verticalLayout = nullptr;
     VersionListView* listView = nullptr;
@@ -80,11 +80,62 @@ namespace fs = ghc::filesystem;
 #include "Json.h"
 #include "StringUtils.h"
 
+#include "net/ChecksumValidator.h"
 #include "net/Download.h"
+#include "net/NetJob.h"
 #include "net/RawHeaderProxy.h"
+#include "tasks/CpuExecutor.h"
 
 #include "MMCZip.h"
 
+// published next to a release asset, as "<asset name>.files.json", to allow updating only the files that changed
+static const QString DELTA_MANIFEST_SUFFIX = QStringLiteral(".files.json");
+
+struct DeltaFile {
+    QString path;
+    QByteArray sha256;
+    qint64 size = 0;
+    QUrl url;
+    bool executable = false;
+};
+
+/** Parses a delta update manifest, resolving the file urls against the manifest's own url.
+ *
+ *  The manifest lists every file of the release, including manifest.txt and the updater itself:
+ *  { "formatVersion": 1, "files": [ { "path": "bin/prismlauncher", "sha256": "...", "size": 123, "url": "...", "executable": true } ] }
+ */
+static QList<DeltaFile> parseDeltaManifest(const QByteArray& data, const QUrl& base_url)
+{
+    auto obj = Json::requireObject(Json::requireDocument(data, "Delta manifest"), "Delta manifest");
+    if (auto version = Json::requireInteger(obj, "formatVersion"); version != 1)
+        throw Json::JsonException(QStringLiteral("Unsupported delta manifest format version %1").arg(version));
+
+    QList<DeltaFile> files;
+    for (auto value : Json::requireArray(obj, "files")) {
+        auto file_obj = Json::requireObject(value);
+        DeltaFile file;
+        file.path = QDir::cleanPath(Json::requireString(file_obj, "path"));
+        if (file.path.isEmpty() || QDir::isAbsolutePath(file.path) || file.path.startsWith(".."))
+            throw Json::JsonException(QStringLiteral("Invalid path in delta manifest: %1").arg(file.path));
+        file.sha256 = QByteArray::fromHex(Json::requireString(file_obj, "sha256").toLatin1());
+        file.size = static_cast<qint64>(Json::requireDouble(file_obj, "size"));
+        file.url = base_url.resolved(QUrl(Json::requireString(file_obj, "url")));
+        file.executable = Json::ensureBoolean(file_obj, "executable", false);
+        files.append(file);
+    }
+    return files;
+}
+
+static QByteArray sha256OfFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(&file);
+    return hash.result();
+}
+
 /** output to the log file */
 void appDebugOutput(QtMsgType type, const QMessageLogContext& context, const QString& msg)
 {
@@ -800,6 +851,10 @@ QList<GitHubReleaseAsset> PrismUpdaterApp::validReleaseArtifacts(const GitHubRel
             qDebug() << "Rejecting" << asset.name << "because it is not an AppImage";
             continue;
         }
+        if (asset.name.toLower().endsWith(DELTA_MANIFEST_SUFFIX)) {
+            qDebug() << "Rejecting" << asset.name << "because it is a delta update manifest";
+            continue;
+        }
         auto asset_name = asset.name.toLower();
         auto [platform, platform_qt_ver] = StringUtils::splitFirst(BuildConfig.BUILD_ARTIFACT.toLower(), "-qt");
         auto system_is_arm = QSysInfo::buildCpuArchitecture().contains("arm64");
@@ -880,6 +935,14 @@ void PrismUpdaterApp::performUpdate(const GitHubRelease& release)
     }
 
     qDebug() << "will install" << selected_asset;
+    auto unpacked_install = m_isPortable || selected_asset.name.toLower().endsWith(".zip");
+    if (auto manifest_asset = deltaManifestAsset(release, selected_asset); unpacked_install && manifest_asset.isValid()) {
+        m_stagedUpdate = stageDeltaUpdate(manifest_asset);
+        if (m_stagedUpdate)
+            return performInstall({});
+        logUpdate(tr("Delta update failed, downloading the full release instead"));
+    }
+
     auto file = downloadAsset(selected_asset);
 
     if (!file.exists()) {
@@ -909,6 +972,119 @@ QFileInfo PrismUpdaterApp::downloadAsset(const GitHubReleaseAsset& asset)
     return out_file;
 }
 
+GitHubReleaseAsset PrismUpdaterApp::deltaManifestAsset(const GitHubRelease& release, const GitHubReleaseAsset& asset)
+{
+    for (auto& candidate : release.assets) {
+        if (candidate.name.compare(asset.name + DELTA_MANIFEST_SUFFIX, Qt::CaseInsensitive) == 0)
+            return candidate;
+    }
+    return {};
+}
+
+std::optional<QDir> PrismUpdaterApp::stageDeltaUpdate(const GitHubReleaseAsset& manifest_asset)
+{
+    auto manifest_url = QUrl(manifest_asset.browser_download_url);
+    logUpdate(tr("Fetching delta update manifest %1").arg(manifest_url.toString()));
+
+    auto manifest_data = std::make_shared<QByteArray>();
+    auto manifest_download = Net::Download::makeByteArray(manifest_url, manifest_data);
+    manifest_download->setNetwork(m_network);
+    ProgressDialog manifest_progress;
+    manifest_progress.adjustSize();
+    manifest_progress.execWithTask(manifest_download.get());
+    if (!manifest_download->wasSuccessful()) {
+        logUpdate(tr("Failed to download the delta update manifest: %1").arg(manifest_download->failReason()));
+        return std::nullopt;
+    }
+
+    QList<DeltaFile> files;
+    try {
+        files = parseDeltaManifest(*manifest_data, manifest_url);
+    } catch (Json::JsonException& e) {
+        logUpdate(tr("Failed to parse the delta update manifest: %1").arg(e.cause()));
+        return std::nullopt;
+    }
+
+    // same place an archive would be unpacked to, so the rest of the update goes the same way
+    auto staging_path = FS::PathCombine(m_dataPath, "prism_launcher_update_release");
+    FS::deletePath(staging_path);
+    if (!FS::ensureFolderPathExists(staging_path)) {
+        logUpdate(tr("Failed to create %1").arg(staging_path));
+        return std::nullopt;
+    }
+    auto staging_dir = QDir(staging_path);
+    auto app_dir = QDir(m_rootPath);
+
+    // hash what's installed in parallel, nothing in the install is touched until the whole release is staged
+    QList<QFuture<bool>> unchanged;
+    unchanged.reserve(files.size());
+    for (auto& file : files) {
+        unchanged.append(CpuExecutor::run(CpuExecutor::Priority::Bulk, [installed = app_dir.absoluteFilePath(file.path), file] {
+            return QFileInfo(installed).size() == file.size && sha256OfFile(installed) == file.sha256;
+        }));
+    }
+
+    QProgressDialog progress(tr("Checking installed files at %1").arg(m_rootPath), "", 0, files.length());
+    progress.setCancelButton(nullptr);
+    progress.setMinimumWidth(400);
+    progress.adjustSize();
+    progress.show();
+    QCoreApplication::processEvents();
+
+    auto job = makeShared<NetJob>(tr("Delta update"), m_network);
+    qint64 total_size = 0;
+    qint64 download_size = 0;
+    for (int i = 0; i < files.size(); i++) {
+        auto& file = files[i];
+        auto staged_path = staging_dir.absoluteFilePath(file.path);
+        FS::ensureFilePathExists(staged_path);
+        total_size += file.size;
+
+        unchanged[i].waitForFinished();
+        if (unchanged[i].result()) {
+            if (!FS::copy(app_dir.absoluteFilePath(file.path), staged_path)()) {
+                logUpdate(tr("Failed to stage %1").arg(file.path));
+                return std::nullopt;
+            }
+        } else {
+            logUpdate(tr("Changed: %1").arg(file.path));
+            auto download = Net::Download::makeFile(file.url, staged_path);
+            download->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha256, file.sha256));
+            job->addNetAction(download);
+            download_size += file.size;
+        }
+        progress.setValue(i);
+        QCoreApplication::processEvents();
+    }
+    progress.setValue(files.size());
+    QCoreApplication::processEvents();
+
+    logUpdate(tr("Delta update: downloading %1 of %2 files, %3 of %4 bytes")
+                  .arg(job->size())
+                  .arg(files.size())
+                  .arg(download_size)
+                  .arg(total_size));
+    if (job->size() > 0) {
+        ProgressDialog download_progress;
+        download_progress.adjustSize();
+        download_progress.execWithTask(job.get());
+        if (!job->wasSuccessful()) {
+            logUpdate(tr("Failed to download the changed files: %1").arg(job->failReason()));
+            return std::nullopt;
+        }
+    }
+
+    for (auto& file : files) {
+        if (!file.executable)
+            continue;
+        QFile staged(staging_dir.absoluteFilePath(file.path));
+        staged.setPermissions(staged.permissions() | QFileDevice::ExeOwner | QFileDevice::ExeGroup | QFileDevice::ExeOther);
+    }
+
+    logUpdate(tr("Staged the new release at %1").arg(staging_dir.absolutePath()));
+    return staging_dir;
+}
+
 bool PrismUpdaterApp::callAppImageUpdate()
 {
     auto appimage_path = QProcessEnvironment::systemEnvironment().value(QStringLiteral("APPIMAGE"));
@@ -1026,7 +1202,7 @@ void PrismUpdaterApp::performInstall(QFileInfo file)
     FS::write(changelog_path, m_install_release.body.toUtf8());
 
     logUpdate(tr("Updating from %1 to %2").arg(m_prismVersion).arg(m_install_release.tag_name));
-    if (m_isPortable || file.suffix().toLower() == "zip") {
+    if (m_stagedUpdate || m_isPortable || file.suffix().toLower() == "zip") {
         write_lock_file(update_lock_path, QDateTime::currentDateTime(), m_prismVersion, m_install_release.tag_name, m_rootPath, m_dataPath);
         logUpdate(tr("Updating portable install at %1").arg(m_rootPath));
         unpackAndInstall(file);
@@ -1050,7 +1226,7 @@ void PrismUpdaterApp::unpackAndInstall(QFileInfo archive)
     logUpdate(tr("Backing up install"));
     backupAppDir();
 
-    if (auto loc = unpackArchive(archive)) {
+    if (auto loc = m_stagedUpdate ? m_stagedUpdate : unpackArchive(archive)) {
         auto marker_file_path = loc.value().absoluteFilePath(".prism_launcher_updater_unpack.marker");
         FS::write(marker_file_path, m_rootPath.toUtf8());
 
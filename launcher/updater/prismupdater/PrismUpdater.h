@@ -84,6 +84,8 @@ class PrismUpdaterApp : public QApplication {
     std::optional<QDir> unpackArchive(QFileInfo file);
 
     QFileInfo downloadAsset(const GitHubReleaseAsset& asset);
+    GitHubReleaseAsset deltaManifestAsset(const GitHubRelease& release, const GitHubReleaseAsset& asset);
+    std::optional<QDir> stageDeltaUpdate(const GitHubReleaseAsset& manifest_asset);
     bool callAppImageUpdate();
 
     void moveAndFinishUpdate(QDir target);
@@ -125,6 +127,8 @@ class PrismUpdaterApp : public QApplication {
     QString m_prismGitCommit;
 
     GitHubRelease m_install_release;
+    // the new release, already assembled from a delta update, in place of an archive to unpack
+    std::optional<QDir> m_stagedUpdate;
 
     Status m_status = Status::Starting;
     shared_qobject_ptr<QNetworkAccessManager> m_network;
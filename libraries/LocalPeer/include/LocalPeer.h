@@ -44,6 +44,7 @@
 #include <memory>
 
 class QLocalServer;
+class QLocalSocket;
 class LockedFile;
 
 class ApplicationId {
@@ -82,6 +83,9 @@ class LocalPeer : public QObject {
    protected Q_SLOTS:
     void receiveConnection();
 
+   protected:
+    void readMessage(QLocalSocket* socket);
+
    protected:
     ApplicationId id;
     QString socketName;
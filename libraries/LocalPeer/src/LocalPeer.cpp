@@ -42,10 +42,12 @@
 #include <QCoreApplication>
 #include <QDataStream>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QLocalServer>
 #include <QLocalSocket>
 #include <QRegularExpression>
 #include <QTime>
+#include <QtEndian>
 #include "LockedFile.h"
 
 #if defined(Q_OS_WIN)
@@ -64,6 +66,8 @@ static PProcessIdToSessionId pProcessIdToSessionId = 0;
 #include <thread>
 
 static const char* ack = "ack";
+// way more than any command line, and small enough to not be a problem
+static const quint32 maxMessageSize = 1024 * 1024;
 
 ApplicationId ApplicationId::fromTraditionalApp()
 {
@@ -154,32 +158,34 @@ bool LocalPeer::sendMessage(const QByteArray& message, int timeout)
     if (!isClient())
         return false;
 
+    QElapsedTimer timer;
+    timer.start();
+    auto remaining = [&timer, timeout] { return static_cast<int>(qMax<qint64>(0, timeout - timer.elapsed())); };
+
     QLocalSocket socket;
-    bool connOk = false;
-    int tries = 2;
-    for (int i = 0; i < tries; i++) {
-        // Try twice, in case the other instance is just starting up
+    // the other instance holds the lock, so it's alive. If it isn't listening, it's only about to
+    while (true) {
         socket.connectToServer(socketName);
-        connOk = socket.waitForConnected(timeout / 2);
-        if (!connOk && i < (tries - 1)) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(250));
-        }
-    }
-    if (!connOk) {
-        return false;
+        if (socket.waitForConnected(remaining()))
+            break;
+        auto error = socket.error();
+        if (remaining() == 0 || (error != QLocalSocket::ServerNotFoundError && error != QLocalSocket::ConnectionRefusedError))
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
     QByteArray uMsg(message);
     QDataStream ds(&socket);
 
     ds.writeBytes(uMsg.constData(), uMsg.size());
-    if (!socket.waitForBytesWritten(timeout)) {
+    if (!socket.waitForBytesWritten(remaining())) {
         return false;
     }
 
     // wait for 'ack'
-    if (!socket.waitForReadyRead(timeout)) {
-        return false;
+    while (socket.bytesAvailable() < static_cast<qint64>(qstrlen(ack))) {
+        if (!socket.waitForReadyRead(remaining()))
+            return false;
     }
 
     // make sure we got 'ack'
@@ -191,34 +197,36 @@ bool LocalPeer::sendMessage(const QByteArray& message, int timeout)
 
 void LocalPeer::receiveConnection()
 {
-    QLocalSocket* socket = server->nextPendingConnection();
-    if (!socket) {
-        return;
+    // nothing here blocks, so a client can't hold up the running instance
+    while (QLocalSocket* socket = server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket] { readMessage(socket); });
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        readMessage(socket);
     }
+}
 
-    while (socket->bytesAvailable() < static_cast<int>(sizeof(quint32))) {
-        socket->waitForReadyRead();
-    }
-    QDataStream ds(socket);
-    QByteArray uMsg;
-    quint32 remaining;
-    ds >> remaining;
-    uMsg.resize(remaining);
-    int got = 0;
-    char* uMsgBuf = uMsg.data();
-    do {
-        got = ds.readRawData(uMsgBuf, remaining);
-        remaining -= got;
-        uMsgBuf += got;
-    } while (remaining && got >= 0 && socket->waitForReadyRead(2000));
-    if (got < 0) {
-        qWarning("QtLocalPeer: Message reception failed %s", socket->errorString().toLatin1().constData());
-        delete socket;
+void LocalPeer::readMessage(QLocalSocket* socket)
+{
+    // the message is its size, followed by as many bytes, as written by QDataStream::writeBytes
+    const qint64 header = sizeof(quint32);
+    if (socket->bytesAvailable() < header)
+        return;
+    quint32 size = qFromBigEndian<quint32>(socket->peek(header).constData());
+    if (size > maxMessageSize) {
+        qWarning("QtLocalPeer: Message of %u bytes is too big, dropping the connection", size);
+        socket->abort();
         return;
     }
+    if (socket->bytesAvailable() < header + size)
+        return;
+
+    socket->read(header);
+    QByteArray uMsg = socket->read(size);
+
+    // the client only waits for the ack, it's sent before the message is handled
+    disconnect(socket, &QLocalSocket::readyRead, this, nullptr);
     socket->write(ack, qstrlen(ack));
-    socket->waitForBytesWritten(1000);
-    socket->waitForDisconnected(1000);  // make sure client reads ack
-    delete socket;
+    socket->flush();
+    socket->disconnectFromServer();
     emit messageReceived(uMsg);  // ### (might take a long time to return)
 }
@@ -36,6 +36,8 @@
 package org.prismlauncher.utils.logging;
 
 import java.io.PrintStream;
+import java.io.PrintWriter;
+import java.io.StringWriter;
 
 /**
  * Used to print messages with different levels used to colourise the output.
@@ -46,6 +48,8 @@ public final class Log {
     // original before possibly overridden by MC
     private static final PrintStream OUT = new PrintStream(System.out), ERR = new PrintStream(System.err);
     private static final boolean DEBUG = Boolean.getBoolean("org.prismlauncher.debug");
+    // if set, messages go there instead of being printed
+    private static final LogChannel CHANNEL = LogChannel.open();
 
     public static void launcher(String message) {
         log(message, Level.LAUNCHER);
@@ -64,6 +68,8 @@ public final class Log {
     }
 
     public static void error(String message, Throwable e) {
+        if (CHANNEL != null && CHANNEL.send(message + '\n' + stackTrace(e), Level.ERROR))
+            return;
         error(message);
         e.printStackTrace(ERR);
     }
@@ -73,6 +79,8 @@ public final class Log {
     }
 
     public static void fatal(String message, Throwable e) {
+        if (CHANNEL != null && CHANNEL.send(message + '\n' + stackTrace(e), Level.FATAL))
+            return;
         fatal(message);
         e.printStackTrace(ERR);
     }
@@ -88,6 +96,9 @@ public final class Log {
         if (!DEBUG && level == Level.DEBUG)
             return;
 
+        if (CHANNEL != null && CHANNEL.send(message, level))
+            return;
+
         String prefix = "!![" + level.name + "]!";
         // prefix first line
         message = prefix + message;
@@ -99,4 +110,10 @@ public final class Log {
         else
             OUT.println(message);
     }
+
+    private static String stackTrace(Throwable e) {
+        StringWriter writer = new StringWriter();
+        e.printStackTrace(new PrintWriter(writer));
+        return writer.toString();
+    }
 }
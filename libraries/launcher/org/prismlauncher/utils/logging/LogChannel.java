@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  Linking this library statically or dynamically with other modules is
+ *  making a combined work based on this library. Thus, the terms and
+ *  conditions of the GNU General Public License cover the whole
+ *  combination.
+ *
+ *  As a special exception, the copyright holders of this library give
+ *  you permission to link this library with independent modules to
+ *  produce an executable, regardless of the license terms of these
+ *  independent modules, and to copy and distribute the resulting
+ *  executable under terms of your choice, provided that you also meet,
+ *  for each linked independent module, the terms and conditions of the
+ *  license of that module. An independent module is a module which is
+ *  not derived from or based on this library. If you modify this
+ *  library, you may extend this exception to your version of the
+ *  library, but you are not obliged to do so. If you do not wish to do
+ *  so, delete this exception statement from your version.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package org.prismlauncher.utils.logging;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.net.InetAddress;
+import java.net.Socket;
+import java.nio.charset.Charset;
+
+/**
+ * Sends log records to the launcher over a local socket, so it doesn't have to
+ * guess their level. Only used when the launcher asks for it with the
+ * <code>org.prismlauncher.log.port</code> and
+ * <code>org.prismlauncher.log.token</code> properties.
+ */
+final class LogChannel {
+    private static final Charset UTF_8 = Charset.forName("UTF-8");
+
+    private final String token;
+    private final OutputStream out;
+
+    private LogChannel(String token, OutputStream out) {
+        this.token = token;
+        this.out = out;
+    }
+
+    /**
+     * @return The channel, or <code>null</code> if the launcher didn't ask for
+     *         one or it can't be reached
+     */
+    static LogChannel open() {
+        String port = System.getProperty("org.prismlauncher.log.port");
+        String token = System.getProperty("org.prismlauncher.log.token");
+        if (port == null || token == null)
+            return null;
+
+        try {
+            Socket socket = new Socket(InetAddress.getByName("127.0.0.1"), Integer.parseInt(port));
+            socket.setTcpNoDelay(true);
+            return new LogChannel(token, socket.getOutputStream());
+        } catch (IOException | NumberFormatException e) {
+            return null;
+        }
+    }
+
+    /**
+     * Sends one record: the token, the level, the time, an empty thread and
+     * logger and the message, separated by tabs, with line breaks escaped.
+     *
+     * @return Whether the record could be sent
+     */
+    synchronized boolean send(String message, Level level) {
+        String escaped = message.replace("\r", "\\r").replace("\n", "\\n");
+        String record = token + '\t' + level.name + '\t' + System.currentTimeMillis() + "\t\t\t" + escaped + '\n';
+        try {
+            out.write(record.getBytes(UTF_8));
+            out.flush();
+            return true;
+        } catch (IOException e) {
+            return false;
+        }
+    }
+}
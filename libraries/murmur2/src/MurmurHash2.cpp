@@ -68,6 +68,39 @@ uint32_t MurmurHash2(std::ifstream&& file_stream, std::size_t buffer_size, std::
     return info.h;
 }
 
+uint32_t MurmurHash2(const char* data, std::size_t len, std::function<bool(char)> filter_out)
+{
+    uint32_t size = 0;
+    for (std::size_t i = 0; i < len; i++) {
+        if (!filter_out(data[i]))
+            size += 1;
+    }
+
+    char word[4];
+    int index = 0;
+
+    // This forces a seed of 1.
+    IncrementalHashInfo info{ (uint32_t)1 ^ size, (uint32_t)size };
+    for (std::size_t i = 0; i < len; i++) {
+        char c = data[i];
+
+        if (filter_out(c))
+            continue;
+
+        word[index] = c;
+        index = (index + 1) % 4;
+
+        // Mix 4 bytes at a time into the hash
+        if (index == 0)
+            FourBytes_MurmurHash2(reinterpret_cast<unsigned char*>(&word), info);
+    }
+
+    // Do one last bit shuffle in the hash
+    FourBytes_MurmurHash2(reinterpret_cast<unsigned char*>(&word), info);
+
+    return info.h;
+}
+
 void FourBytes_MurmurHash2(const unsigned char* data, IncrementalHashInfo& prev)
 {
     if (prev.len >= 4) {
@@ -110,3 +143,356 @@ void FourBytes_MurmurHash2(const unsigned char* data, IncrementalHashInfo& prev)
 }
 
 //-----------------------------------------------------------------------------
+// Vectorized CurseForge whitespace filtering
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MURMUR_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MURMUR_TARGET_SSE2
+#define MURMUR_TARGET_AVX2
+#else
+#define MURMUR_TARGET_SSE2 __attribute__((target("sse2")))
+#define MURMUR_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MURMUR_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+static inline bool isCurseForgeWhitespace(char c)
+{
+    return c == 9 || c == 10 || c == 13 || c == 32;
+}
+
+static std::size_t countScalar(const char* in, std::size_t len)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < len; i++)
+        kept += !isCurseForgeWhitespace(in[i]);
+    return kept;
+}
+
+static std::size_t compactScalar(const char* in, std::size_t len, char* out)
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < len; i++) {
+        char c = in[i];
+        out[n] = c;
+        n += !isCurseForgeWhitespace(c);
+    }
+    return n;
+}
+
+// Copies the bytes of in whose bit is set in keep
+static inline std::size_t compactByMask(const char* in, uint32_t keep, char* out)
+{
+    std::size_t n = 0;
+    while (keep) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long idx;
+        _BitScanForward(&idx, keep);
+#else
+        unsigned idx = __builtin_ctz(keep);
+#endif
+        out[n++] = in[idx];
+        keep &= keep - 1;
+    }
+    return n;
+}
+
+static inline unsigned popcount32(uint32_t v)
+{
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
+#if defined(MURMUR_X86)
+
+MURMUR_TARGET_SSE2 static inline uint32_t whitespaceMaskSSE2(__m128i v)
+{
+    __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(9)), _mm_cmpeq_epi8(v, _mm_set1_epi8(10))),
+                              _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(13)), _mm_cmpeq_epi8(v, _mm_set1_epi8(32))));
+    return static_cast<uint32_t>(_mm_movemask_epi8(ws));
+}
+
+MURMUR_TARGET_SSE2 static std::size_t countSSE2(const char* in, std::size_t len)
+{
+    std::size_t i = 0, removed = 0;
+    for (; i + 16 <= len; i += 16)
+        removed += popcount32(whitespaceMaskSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+    return (i - removed) + countScalar(in + i, len - i);
+}
+
+MURMUR_TARGET_SSE2 static std::size_t compactSSE2(const char* in, std::size_t len, char* out)
+{
+    std::size_t i = 0, n = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        uint32_t ws = whitespaceMaskSSE2(v);
+        if (ws == 0) {
+            // Most blocks of a compressed jar have no whitespace at all
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + n), v);
+            n += 16;
+        } else {
+            n += compactByMask(in + i, ~ws & 0xFFFF, out + n);
+        }
+    }
+    return n + compactScalar(in + i, len - i, out + n);
+}
+
+// Shuffle masks moving the kept bytes of an 8-byte group to its front, indexed by the whitespace bitmask
+static const std::array<uint64_t, 256>& compactShuffleTable()
+{
+    static const std::array<uint64_t, 256> table = [] {
+        std::array<uint64_t, 256> t{};
+        for (unsigned mask = 0; mask < 256; mask++) {
+            uint64_t entry = 0;
+            unsigned n = 0;
+            for (unsigned bit = 0; bit < 8; bit++) {
+                if (!(mask & (1u << bit)))
+                    entry |= static_cast<uint64_t>(bit) << (8 * n++);
+            }
+            // Unused lanes are zeroed out by the shuffle
+            for (; n < 8; n++)
+                entry |= static_cast<uint64_t>(0x80) << (8 * n);
+            t[mask] = entry;
+        }
+        return t;
+    }();
+    return table;
+}
+
+MURMUR_TARGET_AVX2 static inline uint32_t whitespaceMaskAVX2(__m256i v)
+{
+    __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(9)), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(10))),
+                                 _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(13)), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(32))));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(ws));
+}
+
+MURMUR_TARGET_AVX2 static std::size_t countAVX2(const char* in, std::size_t len)
+{
+    std::size_t i = 0, removed = 0;
+    for (; i + 32 <= len; i += 32)
+        removed += _mm_popcnt_u32(whitespaceMaskAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i))));
+    return (i - removed) + countScalar(in + i, len - i);
+}
+
+MURMUR_TARGET_AVX2 static std::size_t compactAVX2(const char* in, std::size_t len, char* out)
+{
+    const auto& table = compactShuffleTable();
+
+    std::size_t i = 0, n = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        uint32_t ws = whitespaceMaskAVX2(v);
+        if (ws == 0) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + n), v);
+            n += 32;
+            continue;
+        }
+
+        // Compact each 8-byte group with a table-driven shuffle. Each store writes a full 8 bytes,
+        // but the next group starts where the kept bytes end, so only the lanes we keep survive.
+        for (int group = 0; group < 4; group++) {
+            uint32_t group_ws = (ws >> (8 * group)) & 0xFF;
+            __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i + 8 * group));
+            __m128i shuffle = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&table[group_ws]));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + n), _mm_shuffle_epi8(bytes, shuffle));
+            n += 8 - _mm_popcnt_u32(group_ws);
+        }
+    }
+    return n + compactScalar(in + i, len - i, out + n);
+}
+
+static bool cpuHasAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    // OSXSAVE and AVX, plus the OS saving the YMM state
+    bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6);
+    bool popcnt = info[2] & (1 << 23);
+    __cpuidex(info, 7, 0);
+    return os_avx && popcnt && (info[1] & (1 << 5));
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#endif
+}
+
+#elif defined(MURMUR_NEON)
+
+static inline uint8x16_t whitespaceMaskNEON(uint8x16_t v)
+{
+    return vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(9)), vceqq_u8(v, vdupq_n_u8(10))),
+                    vorrq_u8(vceqq_u8(v, vdupq_n_u8(13)), vceqq_u8(v, vdupq_n_u8(32))));
+}
+
+static std::size_t countNEON(const char* in, std::size_t len)
+{
+    std::size_t i = 0, removed = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t ws = whitespaceMaskNEON(vld1q_u8(reinterpret_cast<const uint8_t*>(in + i)));
+        // Matching lanes are 0xFF, so shifting down to 1 and summing counts them
+        removed += vaddvq_u8(vshrq_n_u8(ws, 7));
+    }
+    return (i - removed) + countScalar(in + i, len - i);
+}
+
+static std::size_t compactNEON(const char* in, std::size_t len, char* out)
+{
+    // Bit weights to pack a lane mask into an integer, 8 lanes per half
+    static const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t weight = vld1q_u8(weights);
+
+    std::size_t i = 0, n = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(in + i));
+        uint8x16_t ws = whitespaceMaskNEON(v);
+        if (vmaxvq_u8(ws) == 0) {
+            vst1q_u8(reinterpret_cast<uint8_t*>(out + n), v);
+            n += 16;
+            continue;
+        }
+
+        uint8x16_t bits = vandq_u8(ws, weight);
+        uint32_t mask = vaddv_u8(vget_low_u8(bits)) | (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+        n += compactByMask(in + i, ~mask & 0xFFFF, out + n);
+    }
+    return n + compactScalar(in + i, len - i, out + n);
+}
+
+#endif
+
+struct FilterKernelImpl {
+    std::size_t (*count)(const char*, std::size_t);
+    std::size_t (*compact)(const char*, std::size_t, char*);
+};
+
+static FilterKernelImpl kernelImpl(MurmurFilterKernel kernel)
+{
+    switch (kernel) {
+#if defined(MURMUR_X86)
+        case MurmurFilterKernel::SSE2:
+            return { countSSE2, compactSSE2 };
+        case MurmurFilterKernel::AVX2:
+            return { countAVX2, compactAVX2 };
+#elif defined(MURMUR_NEON)
+        case MurmurFilterKernel::NEON:
+            return { countNEON, compactNEON };
+#endif
+        default:
+            return { countScalar, compactScalar };
+    }
+}
+
+bool MurmurFilterKernelSupported(MurmurFilterKernel kernel)
+{
+    switch (kernel) {
+        case MurmurFilterKernel::Scalar:
+            return true;
+#if defined(MURMUR_X86)
+        case MurmurFilterKernel::SSE2:
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+            return true;
+#else
+            return __builtin_cpu_supports("sse2");
+#endif
+        case MurmurFilterKernel::AVX2: {
+            static const bool has_avx2 = cpuHasAVX2();
+            return has_avx2;
+        }
+#elif defined(MURMUR_NEON)
+        case MurmurFilterKernel::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+MurmurFilterKernel MurmurBestFilterKernel()
+{
+    static const MurmurFilterKernel best = [] {
+        for (auto kernel : { MurmurFilterKernel::AVX2, MurmurFilterKernel::NEON, MurmurFilterKernel::SSE2 }) {
+            if (MurmurFilterKernelSupported(kernel))
+                return kernel;
+        }
+        return MurmurFilterKernel::Scalar;
+    }();
+    return best;
+}
+
+std::size_t MurmurFilterWhitespace(const char* in, std::size_t len, char* out)
+{
+    return MurmurFilterWhitespace(in, len, out, MurmurBestFilterKernel());
+}
+
+std::size_t MurmurFilterWhitespace(const char* in, std::size_t len, char* out, MurmurFilterKernel kernel)
+{
+    if (!MurmurFilterKernelSupported(kernel))
+        kernel = MurmurFilterKernel::Scalar;
+    return kernelImpl(kernel).compact(in, len, out);
+}
+
+uint32_t CurseForgeMurmurHash2(const char* data, std::size_t len)
+{
+    return CurseForgeMurmurHash2(data, len, MurmurBestFilterKernel());
+}
+
+uint32_t CurseForgeMurmurHash2(const char* data, std::size_t len, MurmurFilterKernel kernel)
+{
+    if (!MurmurFilterKernelSupported(kernel))
+        kernel = MurmurFilterKernel::Scalar;
+    auto impl = kernelImpl(kernel);
+
+    // Like the streamed version, we need the filtered size up front for the initial value of the hash
+    auto size = static_cast<uint32_t>(impl.count(data, len));
+
+    // This forces a seed of 1.
+    IncrementalHashInfo info{ (uint32_t)1 ^ size, (uint32_t)size };
+
+    // Compact in cache-sized chunks, carrying the bytes that don't make a full word over to the next one
+    constexpr std::size_t chunk_size = 64 * KiB;
+    std::array<unsigned char, chunk_size + 4> buffer;
+    std::size_t carry = 0;
+
+    for (std::size_t offset = 0; offset < len; offset += chunk_size) {
+        std::size_t chunk = std::min(chunk_size, len - offset);
+        std::size_t available = carry + impl.compact(data + offset, chunk, reinterpret_cast<char*>(buffer.data()) + carry);
+
+        std::size_t i = 0;
+        for (; i + 4 <= available; i += 4) {
+            uint32_t k;
+            std::memcpy(&k, buffer.data() + i, 4);
+
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+
+            info.h *= m;
+            info.h ^= k;
+        }
+        info.len -= static_cast<uint32_t>(i);
+
+        carry = available - i;
+        std::memmove(buffer.data(), buffer.data() + i, carry);
+    }
+
+    // Do one last bit shuffle in the hash
+    FourBytes_MurmurHash2(buffer.data(), info);
+
+    return info.h;
+}
+
+//-----------------------------------------------------------------------------
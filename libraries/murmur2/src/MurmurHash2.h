@@ -23,6 +23,28 @@ uint32_t MurmurHash2(
     std::size_t buffer_size = 4 * MiB,
     std::function<bool(char)> filter_out = [](char) { return false; });
 
+// Same as above, but for data that is already in memory.
+uint32_t MurmurHash2(
+    const char* data,
+    std::size_t len,
+    std::function<bool(char)> filter_out = [](char) { return false; });
+
+// CurseForge fingerprints skip the whitespace bytes 9, 10, 13 and 32.
+// These use a vectorized filter-and-compact kernel picked at runtime for the current CPU.
+enum class MurmurFilterKernel { Scalar, SSE2, AVX2, NEON };
+
+bool MurmurFilterKernelSupported(MurmurFilterKernel kernel);
+MurmurFilterKernel MurmurBestFilterKernel();
+
+// Copies the non-whitespace bytes of in to out, returning how many were written.
+// out must have room for len bytes, and may be the same as in.
+std::size_t MurmurFilterWhitespace(const char* in, std::size_t len, char* out);
+std::size_t MurmurFilterWhitespace(const char* in, std::size_t len, char* out, MurmurFilterKernel kernel);
+
+// Same result as MurmurHash2 with the CurseForge whitespace filter, but without the per-byte predicate.
+uint32_t CurseForgeMurmurHash2(const char* data, std::size_t len);
+uint32_t CurseForgeMurmurHash2(const char* data, std::size_t len, MurmurFilterKernel kernel);
+
 struct IncrementalHashInfo {
     uint32_t h;
     uint32_t len;
@@ -0,0 +1,50 @@
+#pragma once
+#include <QStringList>
+
+#include <initializer_list>
+
+namespace Sys {
+
+/* The instruction set extensions the CPU we run on has, as far as the OS lets them be used. */
+struct CpuFeatures {
+    // x86
+    bool sse42 = false;
+    bool pclmul = false;
+    bool avx2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool sha = false;
+    // ARM
+    bool neon = false;
+    bool armCrc32 = false;
+    bool armSha2 = false;
+
+    /* The names of the features that are there, for logs. */
+    QStringList names() const;
+};
+
+/* Probed the first time it's asked for, then the same for the rest of the run. */
+const CpuFeatures& getCpuFeatures();
+
+template <typename Kernel>
+struct KernelVariant {
+    bool supported;
+    Kernel kernel;
+};
+
+/* Picks the first of 'variants' the CPU supports, or 'fallback' if there's none. Meant to be called once, at startup, with
+ * the fastest variants first:
+ *
+ *     static const auto crc32 = Sys::pickKernel<Crc32Fn>({ { Sys::getCpuFeatures().sse42, crc32Sse42 } }, crc32Portable);
+ */
+template <typename Kernel>
+Kernel pickKernel(std::initializer_list<KernelVariant<Kernel>> variants, Kernel fallback)
+{
+    for (auto& variant : variants) {
+        if (variant.supported)
+            return variant.kernel;
+    }
+    return fallback;
+}
+
+}  // namespace Sys
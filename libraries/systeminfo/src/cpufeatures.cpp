@@ -0,0 +1,132 @@
+#include "cpufeatures.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SYS_CPU_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(__arm__) || defined(_M_ARM64)
+#define SYS_CPU_ARM
+#if defined(Q_OS_LINUX) || defined(__linux__)
+#include <sys/auxv.h>
+#if defined(__aarch64__)
+#include <asm/hwcap.h>
+#endif
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+#endif
+
+namespace {
+
+#if defined(SYS_CPU_X86)
+struct CpuidRegisters {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+};
+
+CpuidRegisters cpuid(unsigned int leaf, unsigned int subleaf = 0)
+{
+    CpuidRegisters out;
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    out.eax = regs[0];
+    out.ebx = regs[1];
+    out.ecx = regs[2];
+    out.edx = regs[3];
+#else
+    __cpuid_count(leaf, subleaf, out.eax, out.ebx, out.ecx, out.edx);
+#endif
+    return out;
+}
+
+// which register sets the OS saves on context switches, and so lets us use
+unsigned long long xgetbv()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+void probe(Sys::CpuFeatures& out)
+{
+    auto maxLeaf = cpuid(0).eax;
+    if (maxLeaf < 1)
+        return;
+
+    auto leaf1 = cpuid(1);
+    out.sse42 = leaf1.ecx & (1u << 20);
+    out.pclmul = leaf1.ecx & (1u << 1);
+
+    bool osxsave = leaf1.ecx & (1u << 27);
+    auto xcr0 = osxsave ? xgetbv() : 0;
+    // XMM and YMM state, and for AVX-512 the opmask and ZMM state too
+    bool osAvx = (xcr0 & 0x6) == 0x6;
+    bool osAvx512 = (xcr0 & 0xe6) == 0xe6;
+
+    if (maxLeaf < 7)
+        return;
+    auto leaf7 = cpuid(7);
+    out.avx2 = osAvx && (leaf7.ebx & (1u << 5));
+    out.avx512f = osAvx512 && (leaf7.ebx & (1u << 16));
+    out.avx512bw = out.avx512f && (leaf7.ebx & (1u << 30));
+    out.sha = leaf7.ebx & (1u << 29);
+}
+#elif defined(SYS_CPU_ARM)
+void probe(Sys::CpuFeatures& out)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+    // every 64 bit ARM CPU has Advanced SIMD
+    out.neon = true;
+#elif defined(__ARM_NEON)
+    out.neon = true;
+#endif
+
+#if defined(__APPLE__)
+    // every Apple CPU that runs macOS has these
+    out.armCrc32 = true;
+    out.armSha2 = true;
+#elif defined(__linux__) && defined(__aarch64__)
+    auto hwcap = getauxval(AT_HWCAP);
+    out.armCrc32 = hwcap & HWCAP_CRC32;
+    out.armSha2 = hwcap & HWCAP_SHA2;
+#elif defined(_WIN32)
+    out.armCrc32 = IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE);
+    out.armSha2 = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE);
+#endif
+}
+#else
+void probe(Sys::CpuFeatures&) {}
+#endif
+
+}  // namespace
+
+QStringList Sys::CpuFeatures::names() const
+{
+    QStringList out;
+    const std::initializer_list<std::pair<bool, const char*>> all = {
+        { sse42, "SSE4.2" },  { pclmul, "PCLMULQDQ" }, { avx2, "AVX2" },       { avx512f, "AVX-512F" }, { avx512bw, "AVX-512BW" },
+        { sha, "SHA" },       { neon, "NEON" },        { armCrc32, "CRC32" }, { armSha2, "SHA2" },
+    };
+    for (auto& [present, name] : all) {
+        if (present)
+            out << name;
+    }
+    return out;
+}
+
+const Sys::CpuFeatures& Sys::getCpuFeatures()
+{
+    static const CpuFeatures features = [] {
+        CpuFeatures out;
+        probe(out);
+        return out;
+    }();
+    return features;
+}
@@ -1,5 +1,6 @@
 #include <QTest>
 
+#include <cpufeatures.h>
 #include <sys.h>
 
 class SysTest : public QObject {
@@ -12,6 +13,26 @@ class SysTest : public QObject {
         QVERIFY(!kinfo.kernelName.isEmpty());
         QVERIFY(kinfo.kernelVersion != "0.0");
     }
+
+    void test_pickKernel()
+    {
+        using Kernel = int (*)();
+        Kernel fallback = [] { return 0; };
+        Kernel first = [] { return 1; };
+        Kernel second = [] { return 2; };
+        QCOMPARE(Sys::pickKernel<Kernel>({ { false, first }, { true, second } }, fallback)(), 2);
+        QCOMPARE(Sys::pickKernel<Kernel>({ { true, first }, { true, second } }, fallback)(), 1);
+        QCOMPARE(Sys::pickKernel<Kernel>({ { false, first } }, fallback)(), 0);
+    }
+
+    void test_cpuFeaturesConsistent()
+    {
+        auto& features = Sys::getCpuFeatures();
+        // AVX-512BW is only reported along with AVX-512F, and x86 and ARM features don't mix
+        QVERIFY(!features.avx512bw || features.avx512f);
+        QVERIFY(!(features.sse42 && features.neon));
+        QCOMPARE(&features, &Sys::getCpuFeatures());
+    }
     /*
         void test_systemDistroNotNull()
         {
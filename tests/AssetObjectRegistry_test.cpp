@@ -0,0 +1,63 @@
+#include <QTest>
+
+#include <minecraft/AssetObjectRegistry.h>
+
+namespace {
+AssetHash hashOf(const QString& hex)
+{
+    AssetHash hash;
+    AssetHash::fromHex(hex, hash);
+    return hash;
+}
+}  // namespace
+
+class AssetObjectRegistryTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_Hex()
+    {
+        const QString hex = "bdf48ef6b5d0d23bbb02e17d04865216179f510a";
+        AssetHash hash;
+        QVERIFY(AssetHash::fromHex(hex, hash));
+        QCOMPARE(hash.bytes[0], quint8(0xbd));
+        QCOMPARE(hash.toHex(), hex);
+        QVERIFY(AssetHash::fromHex(hex.toUpper(), hash));
+        QCOMPARE(hash.toHex(), hex);
+
+        QVERIFY(!AssetHash::fromHex("", hash));
+        QVERIFY(!AssetHash::fromHex(hex.left(39), hash));
+        QVERIFY(!AssetHash::fromHex(hex.left(39) + "g", hash));
+        QVERIFY(hash == AssetHash());
+    }
+
+    void test_Intern()
+    {
+        auto& registry = AssetObjectRegistry::instance();
+        const auto a = hashOf("00000000000000000000000000000000000000aa");
+        const auto b = hashOf("ff000000000000000000000000000000000000bb");
+        const auto c = hashOf("7700000000000000000000000000000000000000");
+
+        const auto first = registry.intern(QVector<AssetHash>{ b, a, b });
+        QCOMPARE(first.size(), 3);
+        QCOMPARE(first[0], first[2]);
+        QVERIFY(first[0] != first[1]);
+        const int size = registry.size();
+
+        // a second index with overlapping objects only adds the new ones, and known ids don't move
+        const auto second = registry.intern(QVector<AssetHash>{ c, a, b });
+        QCOMPARE(registry.size(), size + 1);
+        QCOMPARE(second[1], first[1]);
+        QCOMPARE(second[2], first[0]);
+        QCOMPARE(registry.intern(c), second[0]);
+
+        QCOMPARE(registry.hash(second[0]), c);
+        QCOMPARE(registry.hash(first[0]), b);
+        QCOMPARE(registry.hexName(first[1]), a.toHex());
+        QCOMPARE(registry.relativePath(first[0]), QString("ff/ff000000000000000000000000000000000000bb"));
+    }
+};
+
+QTEST_GUILESS_MAIN(AssetObjectRegistryTest)
+
+#include "AssetObjectRegistry_test.moc"
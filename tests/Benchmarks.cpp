@@ -0,0 +1,351 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+/* Benchmarks for the launcher's hot paths, on synthetic data.
+ *
+ * Not a part of the regular test run. Build in release mode, then run the launcher_benchmarks target directly, or
+ * `run_benchmarks` to get machine-readable results in benchmarks.xml that can be compared between commits.
+ */
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <CryptoHash.h>
+#include <FileSystem.h>
+#include <InstanceCopyPrefs.h>
+#include <InstanceCopyTask.h>
+#include <InstanceList.h>
+#include <MurmurHash2.h>
+#include <NullInstance.h>
+#include <Version.h>
+#include <launch/LogModel.h>
+#include <minecraft/WorldList.h>
+#include <minecraft/mod/Mod.h>
+#include <minecraft/mod/tasks/LocalModParseTask.h>
+#include <minecraft/mod/tasks/ModFolderLoadTask.h>
+#include <net/HttpMetaCache.h>
+#include <settings/INIFile.h>
+#include <settings/INISettingsObject.h>
+
+#include <algorithm>
+#include <random>
+
+#include "Fixtures.h"
+
+namespace {
+
+constexpr int MOD_COUNT = 500;
+constexpr int LOG_LINES = 100000;
+constexpr int METACACHE_ENTRIES = 50000;
+constexpr int COPIED_FILES = 2000;
+constexpr int INI_KEYS = 5000;
+constexpr int VERSION_COUNT = 10000;
+constexpr int BIG_JAR_ENTRIES = 5000;
+constexpr int REGION_FILES = 10000;
+constexpr int SIBLING_INSTANCES = 200;
+
+QStringList generateVersions(int count)
+{
+    std::default_random_engine eng(42);
+    std::uniform_int_distribution<int> part(0, 30);
+    static const QStringList suffixes = { "", "", "", "-pre1", "-rc2", "+build.7", "-beta.3", "a" };
+
+    QStringList versions;
+    versions.reserve(count);
+    for (int i = 0; i < count; i++) {
+        versions << QString("%1.%2.%3%4").arg(part(eng) % 3).arg(part(eng)).arg(part(eng)).arg(suffixes[part(eng) % suffixes.size()]);
+    }
+    return versions;
+}
+
+QByteArray generateIni(int keys)
+{
+    QByteArray data;
+    for (int i = 0; i < keys; i++)
+        data += QString("Setting%1=some value number %1, with a \\\"quote\\\"\n").arg(i).toUtf8();
+    return data;
+}
+
+}  // namespace
+
+class LauncherBenchmarks : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+    QString m_mods;
+    QString m_instances;
+    QString m_large_instance;
+    SettingsObjectPtr m_global_settings;
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+        m_mods = FS::PathCombine(m_dir.path(), "mods");
+        QVERIFY(Fixtures::generateModFolder(m_mods, MOD_COUNT));
+
+        m_instances = FS::PathCombine(m_dir.path(), "instances");
+        m_large_instance = FS::PathCombine(m_instances, "Large");
+        QVERIFY(Fixtures::generateInstance(m_instances, "Large", MOD_COUNT, REGION_FILES));
+        QVERIFY(Fixtures::generateInstances(m_instances, SIBLING_INSTANCES));
+        m_global_settings = Fixtures::globalSettings(FS::PathCombine(m_dir.path(), "prismlauncher.cfg"));
+    }
+
+    void bench_LocalModParseTask()
+    {
+        auto files = QDir(m_mods).entryInfoList(QDir::Files);
+        QCOMPARE(files.size(), MOD_COUNT);
+
+        QBENCHMARK {
+            for (int i = 0; i < files.size(); i++) {
+                LocalModParseTask task(i, ResourceType::ZIPFILE, files[i]);
+                task.start();
+            }
+        }
+    }
+
+    void bench_LocalModParseTask_bigJar()
+    {
+        auto folder = FS::PathCombine(m_dir.path(), "big-jar");
+        QVERIFY(Fixtures::generateModFolder(folder, 1, BIG_JAR_ENTRIES));
+        QFileInfo jar(FS::PathCombine(folder, "mod0.jar"));
+
+        QBENCHMARK {
+            LocalModParseTask task(0, ResourceType::ZIPFILE, jar);
+            task.start();
+        }
+    }
+
+    void bench_ModFolderLoadTask()
+    {
+        auto mods = FS::PathCombine(m_large_instance, "minecraft", "mods");
+
+        QBENCHMARK {
+            ModFolderLoadTask task(QDir(mods), QDir(FS::PathCombine(mods, ".index")), true);
+            task.start();
+            QCOMPARE(task.result()->mods.size(), MOD_COUNT);
+        }
+    }
+
+    void bench_processZIP_basicInfo()
+    {
+        auto files = QDir(m_mods).entryInfoList(QDir::Files);
+
+        QBENCHMARK {
+            for (auto& file : files) {
+                Mod mod(file);
+                ModUtils::processZIP(mod, ModUtils::ProcessingLevel::BasicInfoOnly);
+            }
+        }
+    }
+
+    void bench_MurmurHash2_data()
+    {
+        QTest::addColumn<int>("size");
+        QTest::newRow("64 KiB") << 64 * 1024;
+        QTest::newRow("16 MiB") << 16 * 1024 * 1024;
+    }
+
+    void bench_MurmurHash2()
+    {
+        QFETCH(int, size);
+
+        std::default_random_engine eng(42);
+        std::uniform_int_distribution<int> byte(0, 255);
+        QByteArray data(size, Qt::Uninitialized);
+        for (auto& c : data)
+            c = static_cast<char>(byte(eng));
+
+        QBENCHMARK {
+            CurseForgeMurmurHash2(data.constData(), data.size());
+        }
+    }
+
+    void bench_Sha_data()
+    {
+        QTest::addColumn<int>("algorithm");
+        QTest::addColumn<bool>("qt");
+        for (auto [name, algorithm] : { std::pair{ "sha1", QCryptographicHash::Sha1 }, std::pair{ "sha256", QCryptographicHash::Sha256 } }) {
+            QTest::addRow("%s QCryptographicHash", name) << int(algorithm) << true;
+            QTest::addRow("%s CryptoHash", name) << int(algorithm) << false;
+        }
+    }
+
+    // the same 16 MiB through both, CryptoHash only differs from Qt where it has the CPU's SHA instructions to use
+    void bench_Sha()
+    {
+        QFETCH(int, algorithm);
+        QFETCH(bool, qt);
+        auto algo = static_cast<QCryptographicHash::Algorithm>(algorithm);
+        if (!qt)
+            qDebug() << "Accelerated:" << CryptoHash::isAccelerated(algo);
+
+        std::default_random_engine eng(42);
+        std::uniform_int_distribution<int> byte(0, 255);
+        QByteArray data(16 * 1024 * 1024, Qt::Uninitialized);
+        for (auto& c : data)
+            c = static_cast<char>(byte(eng));
+
+        QBENCHMARK {
+            if (qt)
+                QCryptographicHash::hash(data, algo);
+            else
+                CryptoHash::hash(data, algo);
+        }
+    }
+
+    void bench_VersionCompare()
+    {
+        QList<Version> versions;
+        for (auto& version : generateVersions(VERSION_COUNT))
+            versions.append(Version(version));
+
+        QBENCHMARK {
+            auto sorted = versions;
+            std::sort(sorted.begin(), sorted.end());
+        }
+    }
+
+    void bench_VersionParse()
+    {
+        auto versions = generateVersions(VERSION_COUNT);
+
+        QBENCHMARK {
+            for (auto& version : versions)
+                Version parsed(version);
+        }
+    }
+
+    void bench_LogModelAppend()
+    {
+        QStringList lines;
+        lines.reserve(LOG_LINES);
+        for (int i = 0; i < LOG_LINES; i++)
+            lines << QString("[12:34:56] [Render thread/INFO]: Generated log line number %1").arg(i);
+
+        QBENCHMARK {
+            LogModel model;
+            model.setMaxLines(LOG_LINES / 2);
+            for (auto& line : lines)
+                model.append(MessageLevel::Info, line);
+            model.flush();
+        }
+    }
+
+    void bench_HttpMetaCacheSaveNow()
+    {
+        auto index = FS::PathCombine(m_dir.path(), "metacache-save");
+
+        HttpMetaCache cache(index);
+        cache.addBase("bench", FS::PathCombine(m_dir.path(), "cache"));
+        cache.Load();
+        for (int i = 0; i < METACACHE_ENTRIES; i++) {
+            auto entry = cache.resolveEntry("bench", QString("objects/%1/%2").arg(i % 256, 2, 16, QChar('0')).arg(i));
+            entry->setETag(QString("\"%1\"").arg(i));
+            entry->setMD5Sum(QString::number(i, 16).rightJustified(32, '0'));
+            entry->setStale(false);
+            cache.updateEntry(entry);
+        }
+
+        // the first save writes the whole snapshot, which is the expensive one
+        QBENCHMARK_ONCE {
+            cache.SaveNow();
+        }
+    }
+
+    void bench_HttpMetaCacheLoad()
+    {
+        auto index = FS::PathCombine(m_dir.path(), "metacache-save");
+        if (!QFileInfo::exists(index + ".bin"))
+            QSKIP("Needs the index written by bench_HttpMetaCacheSaveNow");
+
+        QBENCHMARK {
+            HttpMetaCache cache(index);
+            cache.addBase("bench", FS::PathCombine(m_dir.path(), "cache"));
+            cache.Load();
+            // bases are loaded lazily, make sure this one actually is
+            QVERIFY(cache.getEntry("bench", "objects/00/0"));
+        }
+    }
+
+    void bench_FSCopy()
+    {
+        auto source = FS::PathCombine(m_dir.path(), "copy-source");
+        for (int i = 0; i < COPIED_FILES; i++)
+            FS::write(FS::PathCombine(source, QString("dir%1/file%2.txt").arg(i % 20).arg(i)), QByteArray("copy me ").repeated(64));
+
+        int run = 0;
+        QBENCHMARK {
+            FS::copy copy(source, FS::PathCombine(m_dir.path(), QString("copy-target-%1").arg(run++)));
+            QVERIFY(copy());
+        }
+    }
+
+    void bench_InstanceListLoad()
+    {
+        QBENCHMARK {
+            InstanceList list(m_global_settings, m_instances);
+            list.loadList();
+            QCOMPARE(list.count(), SIBLING_INSTANCES + 1);
+        }
+    }
+
+    void bench_WorldListUpdate()
+    {
+        auto saves = FS::PathCombine(m_large_instance, "minecraft", "saves");
+
+        QBENCHMARK {
+            // a new list every time, so nothing is cached
+            WorldList list(saves, nullptr);
+            QSignalSpy reset(&list, &WorldList::modelReset);
+            QVERIFY(list.update());
+            QVERIFY(reset.wait(60000));
+            QCOMPARE(list.size(), size_t(1));
+            // sizes come in afterwards, walking all the region files
+            QVERIFY(QTest::qWaitFor([&list] { return list[0].bytes() >= 0; }, 60000));
+        }
+    }
+
+    void bench_InstanceCopyTask()
+    {
+        auto settings = std::make_shared<INISettingsObject>(FS::PathCombine(m_large_instance, "instance.cfg"));
+        InstancePtr instance(new NullInstance(m_global_settings, settings, m_large_instance));
+
+        int run = 0;
+        QBENCHMARK {
+            InstanceCopyTask task(instance, InstanceCopyPrefs());
+            task.setParentSettings(m_global_settings);
+            task.setStagingPath(FS::PathCombine(m_dir.path(), QString("copied-%1").arg(run++)));
+            QSignalSpy succeeded(&task, &Task::succeeded);
+            task.start();
+            QVERIFY(succeeded.wait(60000));
+        }
+    }
+
+    void bench_INIFileLoad()
+    {
+        auto data = generateIni(INI_KEYS);
+
+        QBENCHMARK {
+            INIFile ini;
+            ini.loadFile(data);
+        }
+    }
+
+    void bench_INIFileSave()
+    {
+        INIFile ini;
+        ini.loadFile(generateIni(INI_KEYS));
+        auto path = FS::PathCombine(m_dir.path(), "settings.cfg");
+
+        QBENCHMARK {
+            QVERIFY(ini.saveFile(path));
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(LauncherBenchmarks)
+
+#include "Benchmarks.moc"
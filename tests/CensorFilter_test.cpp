@@ -0,0 +1,55 @@
+#include <QTest>
+
+#include <launch/CensorFilter.h>
+
+class CensorFilterTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_apply_data()
+    {
+        QTest::addColumn<QString>("line");
+        QTest::addColumn<QString>("expected");
+
+        QTest::newRow("nothing") << "Setting user: Player" << "Setting user: Player";
+        QTest::newRow("token") << "--accessToken eyJhbGciOi --version 1.20.1" << "--accessToken <ACCESS TOKEN> --version 1.20.1";
+        QTest::newRow("several") << "uuid 0123abcd token eyJhbGciOi uuid 0123abcd" << "uuid <PROFILE ID> token <ACCESS TOKEN> uuid <PROFILE ID>";
+        QTest::newRow("whole line") << "eyJhbGciOi" << "<ACCESS TOKEN>";
+        QTest::newRow("longest first") << "session 0123abcd-ef" << "session <SESSION ID>";
+        QTest::newRow("partial") << "0123abc eyJhbGci" << "0123abc eyJhbGci";
+    }
+
+    void test_apply()
+    {
+        QFETCH(QString, line);
+        QFETCH(QString, expected);
+
+        CensorFilter filter({ { "eyJhbGciOi", "<ACCESS TOKEN>" },
+                              { "0123abcd", "<PROFILE ID>" },
+                              { "0123abcd-ef", "<SESSION ID>" } });
+        QCOMPARE(filter.apply(line), expected);
+    }
+
+    void test_overlapping()
+    {
+        CensorFilter filter({ { "abc", "<1>" }, { "bcd", "<2>" }, { "c", "<3>" } });
+        // the match starting first wins, and what it leaves behind can still match
+        QCOMPARE(filter.apply("abcd"), QString("<1>d"));
+        QCOMPARE(filter.apply("xbcdc"), QString("x<2><3>"));
+    }
+
+    void test_empty()
+    {
+        CensorFilter filter;
+        QVERIFY(filter.isEmpty());
+        QCOMPARE(filter.apply("some line"), QString("some line"));
+
+        CensorFilter emptyKey({ { "", "<NOTHING>" } });
+        QVERIFY(emptyKey.isEmpty());
+        QCOMPARE(emptyKey.apply("some line"), QString("some line"));
+    }
+};
+
+QTEST_GUILESS_MAIN(CensorFilterTest)
+
+#include "CensorFilter_test.moc"
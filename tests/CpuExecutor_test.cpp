@@ -0,0 +1,87 @@
+#include <QSemaphore>
+#include <QTest>
+
+#include <atomic>
+
+#include <tasks/CpuExecutor.h>
+
+class CpuExecutorTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_Run()
+    {
+        auto future = CpuExecutor::run(CpuExecutor::Priority::Background, [] { return 6 * 7; });
+        future.waitForFinished();
+        QCOMPARE(future.result(), 42);
+    }
+
+    void test_InteractiveIsNotStarved()
+    {
+        // keep every worker that bulk work may use busy
+        QSemaphore release;
+        std::atomic<int> bulk_started = 0;
+        const int bulk_workers = CpuExecutor::maxThreadCount() - 1;
+        for (int i = 0; i < bulk_workers + 4; i++) {
+            CpuExecutor::post(CpuExecutor::Priority::Bulk, [&] {
+                bulk_started++;
+                release.acquire();
+            });
+        }
+        QVERIFY(QTest::qWaitFor([&] { return bulk_started == bulk_workers; }, 1000));
+
+        auto interactive = CpuExecutor::run(CpuExecutor::Priority::Interactive, [] { return true; });
+        QVERIFY2(QTest::qWaitFor([&] { return interactive.isFinished(); }, 1000), "Interactive work waited for bulk work.");
+
+        // no more bulk work got to start meanwhile
+        QCOMPARE(bulk_started.load(), bulk_workers);
+
+        release.release(bulk_workers + 4);
+        QVERIFY(QTest::qWaitFor([&] { return bulk_started == bulk_workers + 4; }, 1000));
+    }
+
+    void test_GameRunning()
+    {
+        CpuExecutor::setGameRunning(true);
+        QVERIFY(CpuExecutor::gameRunning());
+
+        // only one worker is left for background work
+        QSemaphore release;
+        std::atomic<int> started = 0;
+        for (int i = 0; i < 3; i++) {
+            CpuExecutor::post(CpuExecutor::Priority::Background, [&] {
+                started++;
+                release.acquire();
+            });
+        }
+        QVERIFY(QTest::qWaitFor([&] { return started == 1; }, 1000));
+        QTest::qWait(50);
+        QCOMPARE(started.load(), 1);
+
+        // and the others take it again once the game is closed
+        CpuExecutor::setGameRunning(false);
+        QVERIFY(!CpuExecutor::gameRunning());
+        QVERIFY(QTest::qWaitFor([&] { return started == qMin(3, CpuExecutor::maxThreadCount() - 1); }, 1000));
+
+        release.release(3);
+        QVERIFY(QTest::qWaitFor([&] { return started == 3; }, 1000));
+    }
+
+    void test_CpuTask()
+    {
+        CpuTask succeeding([] { return QString(); });
+        succeeding.start();
+        QVERIFY(QTest::qWaitFor([&] { return succeeding.isFinished(); }, 1000));
+        QVERIFY(succeeding.wasSuccessful());
+
+        CpuTask failing([] { return QString("broken"); }, CpuExecutor::Priority::Bulk);
+        failing.start();
+        QVERIFY(QTest::qWaitFor([&] { return failing.isFinished(); }, 1000));
+        QVERIFY(!failing.wasSuccessful());
+        QCOMPARE(failing.failReason(), QString("broken"));
+    }
+};
+
+QTEST_GUILESS_MAIN(CpuExecutorTest)
+
+#include "CpuExecutor_test.moc"
@@ -0,0 +1,71 @@
+#include <QBuffer>
+#include <QTest>
+
+#include <CryptoHash.h>
+
+#include <random>
+
+class CryptoHashTest : public QObject {
+    Q_OBJECT
+
+    static QByteArray randomData(int size)
+    {
+        std::default_random_engine eng(size);
+        std::uniform_int_distribution<int> byte(0, 255);
+        QByteArray data(size, Qt::Uninitialized);
+        for (auto& c : data)
+            c = static_cast<char>(byte(eng));
+        return data;
+    }
+
+   private slots:
+    void test_matchesQt_data()
+    {
+        QTest::addColumn<int>("algorithmId");
+        QTest::addColumn<int>("size");
+        // around the block size and where the padding needs a second block
+        for (auto size : { 0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 1000, 1024 * 1024 + 3 }) {
+            QTest::addRow("sha1 %d", size) << int(QCryptographicHash::Sha1) << size;
+            QTest::addRow("sha256 %d", size) << int(QCryptographicHash::Sha256) << size;
+            QTest::addRow("md5 %d", size) << int(QCryptographicHash::Md5) << size;
+        }
+    }
+
+    void test_matchesQt()
+    {
+        QFETCH(int, algorithmId);
+        QFETCH(int, size);
+        auto algorithm = static_cast<QCryptographicHash::Algorithm>(algorithmId);
+
+        auto data = randomData(size);
+        auto expected = QCryptographicHash::hash(data, algorithm);
+        QCOMPARE(CryptoHash::hash(data, algorithm), expected);
+
+        // the same, in uneven pieces
+        CryptoHash hash(algorithm);
+        for (int offset = 0, piece = 1; offset < size; offset += piece, piece = piece * 3 % 97 + 1)
+            hash.addData(data.constData() + offset, qMin(piece, size - offset));
+        QCOMPARE(hash.result(), expected);
+        QCOMPARE(hash.result(), expected);
+
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        hash.reset();
+        QVERIFY(hash.addData(&buffer));
+        QCOMPARE(hash.result(), expected);
+    }
+
+    void test_moreDataAfterResult()
+    {
+        auto data = randomData(300);
+        CryptoHash hash(QCryptographicHash::Sha1);
+        hash.addData(data.left(100));
+        QCOMPARE(hash.result(), QCryptographicHash::hash(data.left(100), QCryptographicHash::Sha1));
+        hash.addData(data.mid(100));
+        QCOMPARE(hash.result(), QCryptographicHash::hash(data, QCryptographicHash::Sha1));
+    }
+};
+
+QTEST_GUILESS_MAIN(CryptoHashTest)
+
+#include "CryptoHash_test.moc"
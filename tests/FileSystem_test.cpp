@@ -353,6 +353,95 @@ class FileSystemTest : public QObject {
         }
     }
 
+    void test_copy_many_files()
+    {
+        QTemporaryDir source;
+        QTemporaryDir target;
+        const int count = 200;
+        for (int i = 0; i < count; i++) {
+            auto path = FS::PathCombine(source.path(), QString("folder%1").arg(i % 7), QString("file%1.txt").arg(i));
+            QVERIFY(FS::ensureFilePathExists(path));
+            FS::write(path, QByteArray::number(i));
+        }
+
+        FS::copy c(source.path(), target.path());
+        QVERIFY(c(true));
+        QCOMPARE(c.totalCopied(), qsizetype(count));
+
+        qsizetype lastDone = 0;
+        connect(&c, &FS::copy::copyProgress, [&lastDone, count](qsizetype done, qsizetype total, const QString&) {
+            QCOMPARE(total, qsizetype(count));
+            QVERIFY(done > lastDone);
+            lastDone = done;
+        });
+        QVERIFY(c());
+        QCOMPARE(c.totalCopied(), qsizetype(count));
+        QCOMPARE(lastDone, qsizetype(count));
+        QVERIFY(c.failed().isEmpty());
+
+        for (int i = 0; i < count; i++) {
+            auto path = FS::PathCombine(target.path(), QString("folder%1").arg(i % 7), QString("file%1.txt").arg(i));
+            QCOMPARE(FS::read(path), QByteArray::number(i));
+        }
+    }
+
+    void test_copy_clone_when_possible()
+    {
+        QTemporaryDir source;
+        QTemporaryDir target;
+        FS::write(FS::PathCombine(source.path(), "a.txt"), "hello");
+        FS::write(FS::PathCombine(source.path(), "folder", "b.txt"), "clone me");
+
+        // results depend on the filesystem the tests run on, but every byte is either cloned or copied
+        FS::copy c(source.path(), target.path());
+        c.cloneWhenPossible(true);
+        QVERIFY(c());
+        QCOMPARE(c.totalCopied(), qsizetype(2));
+        QCOMPARE(c.bytesCloned() + c.bytesCopied(), qint64(13));
+        QCOMPARE(FS::read(FS::PathCombine(target.path(), "a.txt")), QByteArray("hello"));
+        QCOMPARE(FS::read(FS::PathCombine(target.path(), "folder", "b.txt")), QByteArray("clone me"));
+    }
+
+    void test_copy_move_when_possible()
+    {
+        QTemporaryDir source;
+        QTemporaryDir target;
+        FS::write(FS::PathCombine(source.path(), "a.txt"), "hello");
+        FS::write(FS::PathCombine(source.path(), "folder", "b.txt"), "move me");
+
+        qint64 lastSize = 0;
+        FS::copy c(source.path(), target.path());
+        c.moveWhenPossible(true);
+        connect(&c, &FS::copy::sizeProgress, [&lastSize](qint64 done, qint64 total) {
+            QCOMPARE(total, qint64(12));
+            lastSize = done;
+        });
+        QVERIFY(c());
+        QCOMPARE(lastSize, qint64(12));
+        QCOMPARE(c.bytesLinked() + c.bytesCopied(), qint64(12));
+        QCOMPARE(FS::read(FS::PathCombine(target.path(), "a.txt")), QByteArray("hello"));
+        QCOMPARE(FS::read(FS::PathCombine(target.path(), "folder", "b.txt")), QByteArray("move me"));
+        // both temporary folders are usually on the same filesystem, a move doesn't leave the file behind
+        if (c.bytesLinked() == 12)
+            QVERIFY(!QFileInfo::exists(FS::PathCombine(source.path(), "a.txt")));
+    }
+
+    void test_copy_link_when_possible()
+    {
+        QTemporaryDir source;
+        QTemporaryDir target;
+        FS::write(FS::PathCombine(source.path(), "a.txt"), "hello");
+
+        FS::copy c(source.path(), target.path());
+        c.linkWhenPossible(true);
+        QVERIFY(c());
+        QCOMPARE(c.bytesLinked() + c.bytesCopied(), qint64(5));
+        QCOMPARE(FS::read(FS::PathCombine(target.path(), "a.txt")), QByteArray("hello"));
+        QVERIFY(QFileInfo::exists(FS::PathCombine(source.path(), "a.txt")));
+        if (c.bytesLinked() == 5)
+            QCOMPARE(FS::hardLinkCount(FS::PathCombine(target.path(), "a.txt")), uintmax_t(2));
+    }
+
     void test_getDesktop() { QCOMPARE(FS::getDesktopDir(), QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)); }
 
     void test_link()
@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#include "Fixtures.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+
+#include <cmath>
+
+#include "FileSystem.h"
+#include "GZip.h"
+#include "settings/INISettingsObject.h"
+
+namespace Fixtures {
+
+namespace {
+
+// the NBT tags a level.dat summary needs
+enum TagType : quint8 { End = 0, Int = 3, Long = 4, String = 8, Compound = 10 };
+
+void writeNbtString(QDataStream& out, const QByteArray& value)
+{
+    out << quint16(value.size());
+    out.writeRawData(value.constData(), value.size());
+}
+
+void writeNbtTag(QDataStream& out, TagType type, const QByteArray& name)
+{
+    out << quint8(type);
+    writeNbtString(out, name);
+}
+
+QByteArray makeLevelDat(const QString& name)
+{
+    QByteArray nbt;
+    QDataStream out(&nbt, QIODevice::WriteOnly);
+    writeNbtTag(out, Compound, "");
+    writeNbtTag(out, Compound, "Data");
+    writeNbtTag(out, String, "LevelName");
+    writeNbtString(out, name.toUtf8());
+    writeNbtTag(out, Int, "GameType");
+    out << qint32(0);
+    writeNbtTag(out, Long, "LastPlayed");
+    out << qint64(1700000000000);
+    writeNbtTag(out, Long, "RandomSeed");
+    out << qint64(42);
+    out << quint8(End);
+    out << quint8(End);
+
+    QByteArray gzipped;
+    GZip::zip(nbt, gzipped);
+    return gzipped;
+}
+
+bool writeFile(const QString& path, const QByteArray& data)
+{
+    try {
+        FS::write(path, data);
+        return true;
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Couldn't write fixture:" << e.cause();
+        return false;
+    }
+}
+
+}  // namespace
+
+bool writeZip(const QString& path, const QHash<QString, QByteArray>& files)
+{
+    QuaZip zip(path);
+    if (!zip.open(QuaZip::mdCreate))
+        return false;
+
+    for (auto it = files.cbegin(); it != files.cend(); ++it) {
+        QuaZipFile file(&zip);
+        if (!file.open(QIODevice::WriteOnly, QuaZipNewInfo(it.key())))
+            return false;
+        file.write(it.value());
+        file.close();
+    }
+
+    zip.close();
+    return zip.getZipError() == 0;
+}
+
+bool generateModFolder(const QString& folder, int count, int classes)
+{
+    if (!FS::ensureFolderPathExists(folder))
+        return false;
+
+    const QByteArray padding = QByteArray("\xCA\xFE\xBA\xBE", 4).repeated(2048);
+    for (int i = 0; i < count; i++) {
+        auto id = QString("mod%1").arg(i);
+        auto descriptor = QString(R"({
+            "schemaVersion": 1,
+            "id": "%1",
+            "version": "1.%2.0",
+            "name": "Generated Mod %2",
+            "description": "A generated mod, to be parsed over and over again.",
+            "authors": [ "Some Person" ],
+            "contact": { "homepage": "https://example.com/%1" },
+            "license": "MIT",
+            "icon": "assets/%1/icon.png",
+            "depends": { "fabricloader": ">=0.14.0", "minecraft": "1.20.x" }
+        })")
+                              .arg(id)
+                              .arg(i);
+
+        QHash<QString, QByteArray> files;
+        files["fabric.mod.json"] = descriptor.toUtf8();
+        files[QString("assets/%1/icon.png").arg(id)] = QByteArray("\x89PNG\r\n\x1a\n", 8);
+        for (int c = 0; c < classes; c++)
+            files[QString("com/example/%1/Class%2.class").arg(id).arg(c)] = padding;
+
+        if (!writeZip(FS::PathCombine(folder, id + ".jar"), files))
+            return false;
+    }
+    return true;
+}
+
+bool generatePackwizIndex(const QString& mods_folder, const QString& index_folder)
+{
+    if (!FS::ensureFolderPathExists(index_folder))
+        return false;
+
+    for (auto& jar : QDir(mods_folder).entryInfoList({ "*.jar" }, QDir::Files, QDir::Name)) {
+        auto slug = jar.completeBaseName();
+        auto toml = QString(R"(name = "Generated Mod %1"
+filename = "%2"
+side = "both"
+
+[download]
+url = "https://cdn.modrinth.com/data/%1/versions/1.0.0/%2"
+hash-format = "sha512"
+hash = "%3"
+
+[update]
+[update.modrinth]
+mod-id = "%1"
+version = "%1-1.0.0"
+)")
+                        .arg(slug, jar.fileName(), QString(128, 'a'));
+        if (!writeFile(FS::PathCombine(index_folder, slug + ".pw.toml"), toml.toUtf8()))
+            return false;
+    }
+    return true;
+}
+
+bool generateWorld(const QString& saves_folder, const QString& name, int region_files)
+{
+    auto world = FS::PathCombine(saves_folder, name);
+    if (!writeFile(FS::PathCombine(world, "level.dat"), makeLevelDat(name)))
+        return false;
+
+    // real region files are much bigger, but what matters here is how many of them there are
+    const QByteArray sector(1024, '\0');
+    const int side = qMax(1, static_cast<int>(std::ceil(std::sqrt(region_files))));
+    for (int i = 0; i < region_files; i++) {
+        auto region = QString("r.%1.%2.mca").arg(i % side - side / 2).arg(i / side - side / 2);
+        if (!writeFile(FS::PathCombine(world, "region", region), sector))
+            return false;
+    }
+    return true;
+}
+
+bool generateInstance(const QString& instances_folder, const QString& id, int mods, int region_files)
+{
+    auto root = FS::PathCombine(instances_folder, id);
+    auto config = QString("InstanceType=OneSix\nname=%1\niconKey=default\n").arg(id);
+    if (!writeFile(FS::PathCombine(root, "instance.cfg"), config.toUtf8()))
+        return false;
+
+    auto pack = R"({ "formatVersion": 1, "components": [ { "uid": "net.minecraft", "version": "1.20.1", "important": true } ] })";
+    if (!writeFile(FS::PathCombine(root, "mmc-pack.json"), pack))
+        return false;
+
+    auto game_root = FS::PathCombine(root, "minecraft");
+    if (!writeFile(FS::PathCombine(game_root, "options.txt"), "fov:0.0\nrenderDistance:12\n"))
+        return false;
+
+    if (mods > 0) {
+        auto mods_folder = FS::PathCombine(game_root, "mods");
+        if (!generateModFolder(mods_folder, mods) || !generatePackwizIndex(mods_folder, FS::PathCombine(mods_folder, ".index")))
+            return false;
+    }
+    if (region_files > 0 && !generateWorld(FS::PathCombine(game_root, "saves"), "Generated World", region_files))
+        return false;
+
+    return true;
+}
+
+bool generateInstances(const QString& instances_folder, int count)
+{
+    for (int i = 0; i < count; i++) {
+        if (!generateInstance(instances_folder, QString("Sibling %1").arg(i), 0, 0))
+            return false;
+    }
+    return true;
+}
+
+SettingsObjectPtr globalSettings(const QString& path)
+{
+    auto settings = std::make_shared<INISettingsObject>(path);
+    settings->registerSetting("ShowGameTime", true);
+    settings->registerSetting("RecordGameTime", true);
+    settings->registerSetting("PreLaunchCommand", "");
+    settings->registerSetting("WrapperCommand", "");
+    settings->registerSetting("PostExitCommand", "");
+    settings->registerSetting("ShowConsole", false);
+    settings->registerSetting("AutoCloseConsole", false);
+    settings->registerSetting("ShowConsoleOnError", true);
+    settings->registerSetting("LogPrePostOutput", true);
+    settings->registerSetting("ConsoleMaxLines", 100000);
+    settings->registerSetting("ConsoleOverflowStop", true);
+    return settings;
+}
+
+}  // namespace Fixtures
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+#include "settings/SettingsObject.h"
+
+/** Generators for large synthetic instances, to see how the launcher behaves at scale.
+ *
+ *  Everything is deterministic, so the same layout comes out every time. The generators return false if something
+ *  couldn't be written.
+ */
+namespace Fixtures {
+
+/** Writes a zip with the given files in it, by path inside the zip. */
+bool writeZip(const QString& path, const QHash<QString, QByteArray>& files);
+
+/** Fills the folder with fabric mod jars, each with a descriptor, an icon and `classes` padding class files. */
+bool generateModFolder(const QString& folder, int count, int classes = 8);
+
+/** Writes a packwiz .pw.toml metadata file into the index folder for every jar in the mods folder. */
+bool generatePackwizIndex(const QString& mods_folder, const QString& index_folder);
+
+/** Creates a world in the saves folder, with a level.dat and that many (small) region files. */
+bool generateWorld(const QString& saves_folder, const QString& name, int region_files);
+
+/** Creates a OneSix instance folder containing `mods` indexed mods and a world with `region_files` region files. */
+bool generateInstance(const QString& instances_folder, const QString& id, int mods, int region_files);
+
+/** Creates `count` small sibling instances, without mods or worlds. */
+bool generateInstances(const QString& instances_folder, int count);
+
+/** A settings object with what instances take from the global settings, stored at the given path. */
+SettingsObjectPtr globalSettings(const QString& path);
+
+}  // namespace Fixtures
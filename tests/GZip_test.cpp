@@ -1,3 +1,4 @@
+#include <QBuffer>
 #include <QTest>
 
 #include <GZip.h>
@@ -45,6 +46,42 @@ class GZipTest : public QObject {
             fib(prev, cur);
         } while (cur < size);
     }
+
+    void test_ThroughDevice()
+    {
+        QByteArray data;
+        for (int i = 0; i < 100000; i++) {
+            data += QByteArray::number(i) + '\n';
+        }
+
+        QBuffer compressedBuffer;
+        QVERIFY(compressedBuffer.open(QIODevice::WriteOnly));
+        QVERIFY(GZip::zip(data, compressedBuffer));
+        compressedBuffer.close();
+
+        QByteArray compressed;
+        QVERIFY(GZip::zip(data, compressed));
+        QCOMPARE(compressedBuffer.data(), compressed);
+
+        QVERIFY(compressedBuffer.open(QIODevice::ReadOnly));
+        QByteArray decompressed;
+        QVERIFY(GZip::unzip(compressedBuffer, decompressed));
+        QCOMPARE(decompressed, data);
+    }
+
+    void test_Truncated()
+    {
+        QByteArray compressed;
+        QVERIFY(GZip::zip(QByteArray(100000, 'x'), compressed));
+        compressed.chop(20);
+
+        QByteArray decompressed;
+        QVERIFY(!GZip::unzip(compressed, decompressed));
+
+        QBuffer buffer(&compressed);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QVERIFY(!GZip::unzip(buffer, decompressed));
+    }
 };
 
 QTEST_GUILESS_MAIN(GZipTest)
@@ -0,0 +1,75 @@
+#include <QTcpSocket>
+#include <QTest>
+
+#include <minecraft/launch/GameLogChannel.h>
+
+class GameLogChannelTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_parseLog4j()
+    {
+        GameLogChannel::Record record;
+        QVERIFY(GameLogChannel::parseRecord("abc\tWARN\t1700000000000\tRender thread\tnet.minecraft.Foo\tsome\ttabbed\\nmessage", "abc",
+                                            record));
+        QCOMPARE(record.level, MessageLevel::Warning);
+        QCOMPARE(record.time.toMSecsSinceEpoch(), 1700000000000);
+        QCOMPARE(record.thread, QString("Render thread"));
+        QCOMPARE(record.logger, QString("net.minecraft.Foo"));
+        QCOMPARE(record.message, QString("some\ttabbed\nmessage"));
+
+        auto lines = GameLogChannel::format(record);
+        QCOMPARE(lines.size(), 2);
+        QVERIFY(lines[0].endsWith(" [Render thread/WARN]: some\ttabbed"));
+        QCOMPARE(lines[1], QString("message"));
+    }
+
+    void test_parseNewLaunch()
+    {
+        GameLogChannel::Record record;
+        QVERIFY(GameLogChannel::parseRecord("abc\tLauncher\t1700000000000\t\t\tUsing onesix launcher.\\r\\n", "abc", record));
+        QCOMPARE(record.level, MessageLevel::Launcher);
+        QCOMPARE(GameLogChannel::format(record), QStringList{ "Using onesix launcher." });
+    }
+
+    void test_rejectsOthers()
+    {
+        GameLogChannel::Record record;
+        QVERIFY(!GameLogChannel::parseRecord("xyz\tINFO\t0\tmain\tlogger\tmessage", "abc", record));
+        QVERIFY(!GameLogChannel::parseRecord("abc\tINFO\t0", "abc", record));
+        QVERIFY(!GameLogChannel::parseRecord("GET / HTTP/1.1", "abc", record));
+    }
+
+    void test_receive()
+    {
+        GameLogChannel channel;
+        QVERIFY(channel.listen());
+
+        auto args = channel.javaArguments();
+        QCOMPARE(args.size(), 2);
+        auto port = args[0].section('=', 1).toUShort();
+        auto token = args[1].section('=', 1).toUtf8();
+
+        QList<QPair<QStringList, MessageLevel::Enum>> received;
+        connect(&channel, &GameLogChannel::log, this,
+                [&received](QStringList lines, MessageLevel::Enum level) { received.append({ lines, level }); });
+        QTcpSocket socket;
+        socket.connectToHost(QHostAddress::LocalHost, port);
+        QVERIFY(socket.waitForConnected());
+        // split in the middle of a record, it has to be put back together
+        socket.write(token + "\tERROR\t0\tmain\tlogger\tfirst\n" + token + "\tINFO\t0\tmain\tlog");
+        socket.flush();
+        QTest::qWait(50);
+        socket.write("ger\tsecond\n");
+        socket.flush();
+
+        QTRY_COMPARE(received.size(), 2);
+        QCOMPARE(received[0].second, MessageLevel::Error);
+        QCOMPARE(received[1].second, MessageLevel::Message);
+        QVERIFY(received[1].first.first().endsWith("second"));
+    }
+};
+
+QTEST_GUILESS_MAIN(GameLogChannelTest)
+
+#include "GameLogChannel_test.moc"
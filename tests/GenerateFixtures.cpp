@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2024 Prism Launcher Contributors
+//
+// SPDX-License-Identifier: GPL-3.0-only
+
+/* Writes the large-instance fixtures the benchmarks use into a folder, to try the launcher against by hand:
+ * an instances folder with one large instance (indexed mods and a world with many region files) and many small
+ * siblings, and a folder of jars with thousands of entries each.
+ */
+
+#include <QCoreApplication>
+#include <QTextStream>
+
+#include <functional>
+
+#include "FileSystem.h"
+#include "Fixtures.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream err(stderr);
+
+    auto args = app.arguments();
+    if (args.size() != 2) {
+        err << "Usage: " << args.first() << " <output folder>\n";
+        return 1;
+    }
+    auto output = args.at(1);
+    auto instances = FS::PathCombine(output, "instances");
+
+    struct Step {
+        const char* what;
+        std::function<bool()> generate;
+    };
+    const QList<Step> steps = {
+        { "large instance", [&] { return Fixtures::generateInstance(instances, "Large", 500, 10000); } },
+        { "sibling instances", [&] { return Fixtures::generateInstances(instances, 200); } },
+        { "big jars", [&] { return Fixtures::generateModFolder(FS::PathCombine(output, "big-jars"), 10, 5000); } },
+    };
+    for (auto& step : steps) {
+        err << "Generating " << step.what << "...\n";
+        err.flush();
+        if (!step.generate()) {
+            err << "Failed to generate " << step.what << " in " << output << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
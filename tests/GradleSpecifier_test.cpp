@@ -64,6 +64,22 @@ class GradleSpecifierTest : public QObject {
         QCOMPARE(spec.serialize(), input);
         QCOMPARE(spec.toPath(), QString());
     }
+
+    void test_MatchName()
+    {
+        GradleSpecifier lwjgl("org.lwjgl:lwjgl:3.3.1");
+        GradleSpecifier newer("org.lwjgl:lwjgl:3.3.3@jar");
+        GradleSpecifier natives("org.lwjgl:lwjgl:3.3.1:natives-linux");
+        QVERIFY(lwjgl.matchName(newer));
+        QCOMPARE(lwjgl.nameId(), newer.nameId());
+        QVERIFY(!(lwjgl == newer));
+        QVERIFY(!lwjgl.matchName(natives));
+        QVERIFY(!lwjgl.matchName(GradleSpecifier("org.lwjgl:lwjgl-glfw:3.3.1")));
+
+        natives.setClassifier(QString());
+        QVERIFY(lwjgl.matchName(natives));
+        QVERIFY(lwjgl == natives);
+    }
 };
 
 QTEST_GUILESS_MAIN(GradleSpecifierTest)
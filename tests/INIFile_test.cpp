@@ -2,6 +2,7 @@
 
 #include <settings/INIFile.h>
 #include <QList>
+#include <QRect>
 #include <QSettings>
 #include <QTemporaryFile>
 #include <QVariant>
@@ -46,6 +47,44 @@ class IniFileTest : public QObject {
         QCOMPARE(f2.get("b", "NOT SET").toString(), b);
     }
 
+    void test_SaveSkipsUnchanged()
+    {
+        QString filename = "test_SaveSkipsUnchanged.ini";
+
+        INIFile f;
+        f.set("a", "1");
+        QVERIFY(f.saveFile(filename));
+
+        // an unchanged save leaves the file alone
+        {
+            QFile file(filename);
+            QVERIFY(file.open(QFile::WriteOnly | QFile::Append));
+            file.write("# marker\n");
+        }
+        QVERIFY(f.saveFile(filename));
+        {
+            QFile file(filename);
+            QVERIFY(file.open(QFile::ReadOnly));
+            QVERIFY(file.readAll().contains("# marker"));
+        }
+
+        // but a missing file and changed values are written
+        QVERIFY(QFile::remove(filename));
+        QVERIFY(f.saveFile(filename));
+        QVERIFY(QFile::exists(filename));
+
+        f.set("a", "2");
+        QVERIFY(f.saveFile(filename));
+        INIFile f2;
+        f2.loadFile(filename);
+        QCOMPARE(f2.get("a", "NOT SET").toString(), QString("2"));
+
+        // a freshly loaded file matches what's on disk
+        f2.set("a", "2");
+        QVERIFY(f2.saveFile(filename));
+        QFile::remove(filename);
+    }
+
     void test_SaveLoadLists()
     {
         QString slist_strings = "(\"a\",\"b\",\"c\")";
@@ -75,6 +114,86 @@ class IniFileTest : public QObject {
         QCOMPARE(out_list_numbers, list_numbers);
     }
 
+    void test_ParityWithQSettings_data()
+    {
+        QTest::addColumn<QByteArray>("contents");
+
+        QTest::newRow("plain") << QByteArray("[General]\nConfigVersion=1.2\nname=Minecraft   \nOverrideCommands=true\nempty=\n");
+        QTest::newRow("quotes and specials") << QByteArray(
+            "[General]\nConfigVersion=1.2\nPreLaunchCommand=\"\\\"$INST_JAVA\\\" -jar link =\"\nenv=\"env mesa=true\"\n"
+            "spaced=\"  kept  \"   \ncomment=value ; trailing comment\n; a comment line\n");
+        QTest::newRow("escapes") << QByteArray(
+            "[General]\nConfigVersion=1.2\nescapes=a\\nb\\tc\\\\d\\x42\\101\\q\\x\nunicode=\\x44f\\x5f30x\nbroken=abc  \\\n"
+            "continued=first\\\nsecond\n");
+        QTest::newRow("lists") << QByteArray("[General]\nConfigVersion=1.2\nlist=a, b ,\"c, d\"\nnumbers=1,2,3,10\nescaped=@@a,b\n");
+        QTest::newRow("variants") << QByteArray(
+            "[General]\nConfigVersion=1.2\nbytes=@ByteArray(abc)\nrect=@Rect(1 2 3 4)\nsize=@Size(5 6)\npoint=@Point(7 8)\n"
+            "invalid=@Invalid()\nat=@@value\nmixed=@Size(1 2),text\n");
+        QTest::newRow("sections") << QByteArray(
+            "ConfigVersion=1.2\n[%General]\nkey=1\n[Group]\nkey=2\nnested\\child=3\n[general]\nback=4\n[%55ni]\nkey=5\n");
+        QTest::newRow("keys") << QByteArray("[General]\nConfigVersion=1.2\n  spaced key  =1\nper%20cent%U00e9=2\nbad%zz=3\n");
+        QTest::newRow("line endings") << QByteArray("\xef\xbb\xbf[General]\r\nConfigVersion=1.2\r\nmultiline=\"one\r\ntwo\"\r\nlast=x");
+        QTest::newRow("malformed") << QByteArray("[General]\nConfigVersion=1.2\nno equals sign\n");
+    }
+
+    void test_ParityWithQSettings()
+    {
+        QFETCH(QByteArray, contents);
+
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        file.write(contents);
+        file.close();
+
+        QSettings settings{ file.fileName(), QSettings::Format::IniFormat };
+        settings.setFallbacksEnabled(false);
+        QVariantMap expected;
+        for (auto&& key : settings.allKeys())
+            expected.insert(key, settings.value(key));
+
+        INIFile f;
+        QCOMPARE(f.loadFile(file.fileName()), settings.status() == QSettings::Status::NoError);
+        if (settings.status() != QSettings::Status::NoError)
+            return;
+        QCOMPARE(f.keys(), expected.keys());
+        for (auto&& key : expected.keys())
+            QCOMPARE(f.value(key), expected.value(key));
+    }
+
+    void test_ParityWithQSettingsWriter()
+    {
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        file.close();
+
+        {
+            QSettings settings{ file.fileName(), QSettings::Format::IniFormat };
+            settings.setValue("ConfigVersion", "1.2");
+            settings.setValue("string", "  leading, and trailing; \"quoted\" = \\ \t\n ");
+            settings.setValue("unicode", QString::fromUtf8("h\xc3\xa9llo \xe2\x9c\x93"));
+            settings.setValue("at", "@notAVariant");
+            settings.setValue("int", 42);
+            settings.setValue("double", 0.25);
+            settings.setValue("bool", true);
+            settings.setValue("bytes", QByteArray("\x01\x02\xff", 3));
+            settings.setValue("rect", QRect(1, 2, 3, 4));
+            settings.setValue("strings", QStringList{ "a", "b,c", "@d", "" });
+            settings.setValue("variants", QVariantList{ 1, "two", QSize(3, 4) });
+            settings.setValue("group/key with spaces", "x");
+            settings.setValue("J\xc3\xa4ger", "y");
+            settings.sync();
+        }
+
+        QSettings settings{ file.fileName(), QSettings::Format::IniFormat };
+        INIFile f;
+        QVERIFY(f.loadFile(file.fileName()));
+        auto keys = settings.allKeys();
+        keys.sort();
+        QCOMPARE(f.keys(), keys);
+        for (auto&& key : keys)
+            QCOMPARE(f.value(key), settings.value(key));
+    }
+
     void test_SaveAlreadyExistingFile()
     {
         QString fileContent = R"(InstanceType=OneSix
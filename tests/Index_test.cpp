@@ -1,5 +1,8 @@
 #include <QTest>
 
+#include <QJsonDocument>
+
+#include <meta/BinaryFormat.h>
 #include <meta/Index.h>
 #include <meta/VersionList.h>
 
@@ -33,6 +36,74 @@ class IndexTest : public QObject {
         windex.merge(std::shared_ptr<Meta::Index>(new Meta::Index({ std::make_shared<Meta::VersionList>("list6") })));
         QCOMPARE(windex.lists().size(), 6);
     }
+
+    void test_indexSnapshot()
+    {
+        Meta::Index windex({ std::make_shared<Meta::VersionList>("list1"), std::make_shared<Meta::VersionList>("list2") });
+        windex.get("list2")->setName("List Two");
+
+        QByteArray data;
+        {
+            QDataStream out(&data, QIODevice::WriteOnly);
+            Meta::writeIndex(out, &windex);
+        }
+        Meta::Index read;
+        QDataStream in(data);
+        QVERIFY(Meta::readIndex(in, &read));
+        QCOMPARE(read.lists().size(), 2);
+        QVERIFY(read.hasUid("list1"));
+        QCOMPARE(read.get("list2")->name(), QString("List Two"));
+
+        // a truncated snapshot must not touch the index
+        Meta::Index truncated;
+        QDataStream short_in(data.left(data.size() - 2));
+        QVERIFY(!Meta::readIndex(short_in, &truncated));
+        QCOMPARE(truncated.lists().size(), 0);
+    }
+
+    void test_versionListSnapshot()
+    {
+        auto json = QJsonDocument::fromJson(R"({
+            "formatVersion": 1, "uid": "net.example", "name": "Example",
+            "versions": [
+                { "version": "1.1", "releaseTime": "2020-02-01T00:00:00+00:00", "type": "release", "recommended": true,
+                  "sha256": "0123abcd", "requires": [ { "uid": "net.minecraft", "equals": "1.20" } ] },
+                { "version": "1.0", "releaseTime": "2020-01-01T00:00:00+00:00", "type": "snapshot", "volatile": true,
+                  "conflicts": [ { "uid": "net.other" } ] }
+            ]
+        })");
+        Meta::VersionList parsed("net.example");
+        parsed.parse(json.object());
+
+        QByteArray data;
+        {
+            QDataStream out(&data, QIODevice::WriteOnly);
+            Meta::writeVersionList(out, &parsed);
+        }
+        Meta::VersionList read("net.example");
+        QDataStream in(data);
+        QVERIFY(Meta::readVersionList(in, &read));
+
+        QCOMPARE(read.name(), QString("Example"));
+        QCOMPARE(read.count(), 2);
+        for (auto& version : parsed.versions()) {
+            auto other = read.getVersion(version->version());
+            QCOMPARE(other->type(), version->type());
+            QCOMPARE(other->rawTime(), version->rawTime());
+            QCOMPARE(other->isRecommended(), version->isRecommended());
+            QCOMPARE(other->isVolatile(), version->isVolatile());
+            QCOMPARE(other->sha256(), version->sha256());
+            QCOMPARE(other->requiredSet().size(), version->requiredSet().size());
+            QCOMPARE(other->conflictSet().size(), version->conflictSet().size());
+        }
+        QCOMPARE(read.getVersion("1.1")->requiredSet().begin()->equalsVersion, QString("1.20"));
+        QCOMPARE(read.getVersion("1.1")->sha256(), QString("0123abcd"));
+
+        // snapshots of another uid are rejected
+        Meta::VersionList wrong("net.wrong");
+        QDataStream wrong_in(data);
+        QVERIFY(!Meta::readVersionList(wrong_in, &wrong));
+    }
 };
 
 QTEST_GUILESS_MAIN(IndexTest)
@@ -0,0 +1,84 @@
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <InstanceList.h>
+
+class InstanceDiscoveryTest : public QObject {
+    Q_OBJECT
+
+    static void makeInstance(const QString& instDir, const QString& id)
+    {
+        QDir(instDir).mkpath(id);
+        QFile cfg(FS::PathCombine(instDir, id, "instance.cfg"));
+        QVERIFY(cfg.open(QFile::WriteOnly));
+        cfg.write("InstanceType=OneSix\n");
+    }
+
+   private slots:
+    void test_discover()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto instDir = tempDir.path();
+
+        makeInstance(instDir, "first");
+        makeInstance(instDir, ".hidden");
+        // not an instance, there's no instance.cfg in it
+        QDir(instDir).mkpath("_LAUNCHER_TEMP");
+        QFile(FS::PathCombine(instDir, "instgroups.json")).open(QFile::WriteOnly);
+
+        int stats = 0;
+        auto ids = InstanceList::discoverInstanceIds(instDir, &stats);
+        std::sort(ids.begin(), ids.end());
+        QCOMPARE(ids, QList<InstanceId>({ ".hidden", "first" }));
+        // one stat for each folder in there, nothing else
+        QCOMPARE(stats, 3);
+    }
+
+#if defined(Q_OS_UNIX)
+    void test_symlinks()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto instDir = FS::PathCombine(tempDir.path(), "instances");
+        auto otherDir = FS::PathCombine(tempDir.path(), "elsewhere");
+
+        makeInstance(instDir, "first");
+        makeInstance(otherDir, "linked");
+        QVERIFY(QFile::link(FS::PathCombine(otherDir, "linked"), FS::PathCombine(instDir, "linked")));
+        // leads back into the instances folder, so it would be there twice
+        QVERIFY(QFile::link(FS::PathCombine(instDir, "first"), FS::PathCombine(instDir, "loop")));
+
+        auto ids = InstanceList::discoverInstanceIds(instDir);
+        std::sort(ids.begin(), ids.end());
+        QCOMPARE(ids, QList<InstanceId>({ "first", "linked" }));
+    }
+#endif
+
+    void test_discover_benchmark()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto instDir = tempDir.path();
+
+        const int count = 200;
+        for (int i = 0; i < count; i++) {
+            makeInstance(instDir, QString("instance %1").arg(i));
+        }
+
+        int stats = 0;
+        QBENCHMARK
+        {
+            QCOMPARE(InstanceList::discoverInstanceIds(instDir, &stats).size(), count);
+        }
+        qDebug() << "Discovering" << count << "instances took" << stats << "stats";
+        QCOMPARE(stats, count);
+    }
+};
+
+QTEST_GUILESS_MAIN(InstanceDiscoveryTest)
+
+#include "InstanceDiscovery_test.moc"
@@ -0,0 +1,85 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <InstanceOverlay.h>
+
+class InstanceOverlayTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+
+    QString base(const QString& path = {}) const { return FS::PathCombine(m_dir.path(), "base", path); }
+    QString overlay(const QString& path = {}) const { return FS::PathCombine(m_dir.path(), "overlay", path); }
+    QString manifest() const { return FS::PathCombine(m_dir.path(), ".prism-overlay"); }
+
+    bool materialize()
+    {
+        InstanceOverlay overlayFolder(base(), overlay(), manifest());
+        return overlayFolder.materialize();
+    }
+
+   private slots:
+    void init()
+    {
+        QVERIFY(m_dir.isValid());
+        FS::deletePath(base());
+        FS::deletePath(overlay());
+        FS::deletePath(manifest());
+        FS::write(base("mods/a.jar"), "mod a");
+        FS::write(base("mods/b.jar"), "mod b");
+        FS::write(base("config/a.toml"), "setting=1");
+        FS::write(base("options.txt"), "fov:70");
+    }
+
+    void test_PlacesAndCopies()
+    {
+        QVERIFY(materialize());
+        QCOMPARE(FS::read(overlay("mods/a.jar")), QByteArray("mod a"));
+        QCOMPARE(FS::read(overlay("mods/b.jar")), QByteArray("mod b"));
+        QCOMPARE(FS::read(overlay("config/a.toml")), QByteArray("setting=1"));
+        QCOMPARE(FS::read(overlay("options.txt")), QByteArray("fov:70"));
+
+        // private paths are copies, so the base doesn't see what the game writes
+        FS::write(overlay("options.txt"), "fov:90");
+        QCOMPARE(FS::read(base("options.txt")), QByteArray("fov:70"));
+    }
+
+    void test_FollowsTheBase()
+    {
+        QVERIFY(materialize());
+
+        FS::write(base("mods/c.jar"), "mod c");
+        FS::deletePath(base("mods/b.jar"));
+        QVERIFY(materialize());
+        QCOMPARE(FS::read(overlay("mods/c.jar")), QByteArray("mod c"));
+        QVERIFY(!QFileInfo::exists(overlay("mods/b.jar")));
+    }
+
+    void test_KeepsTheDelta()
+    {
+        QVERIFY(materialize());
+
+        // deleted and replaced files are the overlay's own from then on
+        FS::deletePath(overlay("mods/a.jar"));
+        QFile::remove(overlay("mods/b.jar"));
+        FS::write(overlay("mods/b.jar"), "my own mod b");
+        FS::write(overlay("mods/mine.jar"), "my mod");
+        QVERIFY(materialize());
+
+        QVERIFY(!QFileInfo::exists(overlay("mods/a.jar")));
+        QCOMPARE(FS::read(overlay("mods/b.jar")), QByteArray("my own mod b"));
+        QCOMPARE(FS::read(overlay("mods/mine.jar")), QByteArray("my mod"));
+        QCOMPARE(FS::read(base("mods/b.jar")), QByteArray("mod b"));
+    }
+
+    void test_MissingBase()
+    {
+        FS::deletePath(base());
+        QVERIFY(!materialize());
+    }
+};
+
+QTEST_GUILESS_MAIN(InstanceOverlayTest)
+
+#include "InstanceOverlay_test.moc"
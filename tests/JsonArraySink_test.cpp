@@ -0,0 +1,42 @@
+#include <QTest>
+
+#include <net/JsonArraySink.h>
+
+class JsonArraySinkTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_feedInPieces()
+    {
+        Net::JsonArraySink sink({});
+        QByteArray json = R"( [ {"name": "a]}\"", "nested": {"list": [1, 2]}}, {"name": "b"} ] )";
+
+        // one byte at a time, so every object is cut at every possible place
+        QList<QJsonObject> elements;
+        for (int i = 0; i < json.size(); i++) {
+            QVERIFY(sink.feed(json.mid(i, 1), elements));
+            if (i < json.indexOf("}, {"))
+                QCOMPARE(elements.size(), 0);
+        }
+        QVERIFY(sink.isComplete());
+        QCOMPARE(elements.size(), 2);
+        QCOMPARE(elements[0]["name"].toString(), QString("a]}\""));
+        QCOMPARE(elements[1]["name"].toString(), QString("b"));
+    }
+
+    void test_notAnArray()
+    {
+        QList<QJsonObject> elements;
+        QVERIFY(!Net::JsonArraySink({}).feed(R"({"name": "a"})", elements));
+        QVERIFY(!Net::JsonArraySink({}).feed("[1, 2]", elements));
+        QVERIFY(!Net::JsonArraySink({}).feed("[{\"a\": 1}] []", elements));
+
+        Net::JsonArraySink unfinished({});
+        QVERIFY(unfinished.feed("[{\"a\": 1}", elements));
+        QVERIFY(!unfinished.isComplete());
+    }
+};
+
+QTEST_GUILESS_MAIN(JsonArraySinkTest)
+
+#include "JsonArraySink_test.moc"
@@ -0,0 +1,189 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryFile>
+#include <QTest>
+
+#include <JsonOnDemand.h>
+#include <minecraft/AssetsUtils.h>
+
+#include <algorithm>
+
+namespace {
+
+// shaped like a modern Mojang asset index, which has a few thousand objects
+QByteArray makeAssetsIndex(int amount)
+{
+    QByteArray out = "{\n  \"objects\": {\n";
+    for (int i = 0; i < amount; i++) {
+        if (i > 0)
+            out += ",\n";
+        out += "    \"minecraft/sounds/mob/some_mob/sound" + QByteArray::number(i) + ".ogg\": {\"hash\": \"" +
+               QByteArray::number(i * 2654435761u, 16).rightJustified(40, '0') + "\", \"size\": " + QByteArray::number(i * 37) + "}";
+    }
+    out += "\n  },\n  \"virtual\": true\n}\n";
+    return out;
+}
+
+// what loadAssetsIndexJson did before it used the on-demand reader
+void loadAssetsIndexWithDom(const QString& path, AssetsIndex& index)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    auto root = QJsonDocument::fromJson(file.readAll()).object();
+    index.isVirtual = root.value("virtual").toBool(false);
+    index.mapToResources = root.value("map_to_resources").toBool(false);
+    QVariantMap map = root.value("objects").toVariant().toMap();
+    for (auto iter = map.begin(); iter != map.end(); ++iter) {
+        auto nested = iter.value().toMap();
+        AssetObject object;
+        AssetHash hash;
+        AssetHash::fromHex(nested.value("hash").toString(), hash);
+        object.hashId = AssetObjectRegistry::instance().intern(hash);
+        object.size = nested.value("size").toDouble();
+        index.objects.append({ iter.key(), object });
+    }
+}
+
+}  // namespace
+
+class JsonOnDemandTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_MatchesQtDom_data()
+    {
+        QTest::addColumn<QByteArray>("json");
+
+        QTest::newRow("scalars") << QByteArray(R"([true, false, null, 0, -1, 1.5, -2.5e3, 1E-2, 123456789012345678, ""])");
+        QTest::newRow("strings") << QByteArray(R"(["plain", "esc\"apes\\\/\b\f\n\r\t", "é✓😀", "h\u00e9llo \ud83d\ude00"])");
+        QTest::newRow("nested") << QByteArray(R"({"a": {"b": [1, [2, {"c": []}], {}]}, "d": "e"})");
+        QTest::newRow("whitespace") << QByteArray(" \r\n\t{ \"a\" :\n1 , \"b\"\t: [ ] }\n ");
+        QTest::newRow("escaped keys") << QByteArray(R"({"key": 1, "k\"ey": 2})");
+    }
+
+    void test_MatchesQtDom()
+    {
+        QFETCH(QByteArray, json);
+
+        auto doc = Json::OnDemand::Document::parse(json);
+        QVERIFY2(!doc.isNull(), qPrintable(doc.errorString()));
+        QJsonParseError error;
+        auto expected = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+
+        if (expected.isArray())
+            QCOMPARE(doc.root().toJsonValue(), QJsonValue(expected.array()));
+        else
+            QCOMPARE(doc.root().toJsonValue(), QJsonValue(expected.object()));
+    }
+
+    void test_Lookup()
+    {
+        auto doc = Json::OnDemand::Document::parse(R"({"name": "x", "n": 42, "big": 1e3, "key": true, "list": [1, 2, 3]})");
+        auto root = doc.object();
+        QCOMPARE(root.size(), 5);
+        QCOMPARE(root.value(QLatin1String("name")).toString(), QString("x"));
+        QCOMPARE(root.value(QLatin1String("n")).toInteger(), qint64(42));
+        QCOMPARE(root.value(QLatin1String("big")).toInteger(), qint64(1000));
+        QCOMPARE(root.value(QLatin1String("key")).toBool(), true);
+        QCOMPARE(root.value(QLatin1String("list")).toArray().size(), 3);
+        QVERIFY(root.value(QLatin1String("missing")).isUndefined());
+        QCOMPARE(root.value(QLatin1String("missing")).toString("default"), QString("default"));
+        QCOMPARE(root.value(QLatin1String("name")).toInteger(7), qint64(7));
+        QVERIFY(root.value(QLatin1String("n")).toObject().isEmpty());
+
+        // like QJsonObject, the last of several equal keys wins
+        auto duplicates = Json::OnDemand::Document::parse(R"({"a": 1, "b": 2, "a": 3})").object();
+        QCOMPARE(duplicates.value(QLatin1String("a")).toInteger(), qint64(3));
+    }
+
+    void test_Invalid_data()
+    {
+        QTest::addColumn<QByteArray>("json");
+
+        QTest::newRow("empty") << QByteArray("");
+        QTest::newRow("unterminated object") << QByteArray(R"({"a": 1)");
+        QTest::newRow("unterminated string") << QByteArray(R"(["abc)");
+        QTest::newRow("trailing comma") << QByteArray(R"([1, 2,])");
+        QTest::newRow("missing colon") << QByteArray(R"({"a" 1})");
+        QTest::newRow("bare key") << QByteArray(R"({a: 1})");
+        QTest::newRow("bad escape") << QByteArray(R"(["\q"])");
+        QTest::newRow("bad unicode escape") << QByteArray(R"(["\u12g4"])");
+        QTest::newRow("control character") << QByteArray("[\"a\nb\"]");
+        QTest::newRow("leading zero") << QByteArray("[01]");
+        QTest::newRow("bad number") << QByteArray("[1.]");
+        QTest::newRow("bad literal") << QByteArray("[nul]");
+        QTest::newRow("garbage") << QByteArray("{} x");
+        QTest::newRow("too deep") << QByteArray(2000, '[') + QByteArray(2000, ']');
+    }
+
+    void test_Invalid()
+    {
+        QFETCH(QByteArray, json);
+
+        auto doc = Json::OnDemand::Document::parse(json);
+        QVERIFY(doc.isNull());
+        QVERIFY(!doc.errorString().isEmpty());
+        QVERIFY(doc.errorOffset() >= 0);
+        QVERIFY_EXCEPTION_THROWN(Json::OnDemand::requireDocument(json), Json::JsonException);
+    }
+
+    void test_AssetsIndex()
+    {
+        const auto data = makeAssetsIndex(100);
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        file.write(data);
+        file.close();
+
+        AssetsIndex index;
+        QVERIFY(AssetsUtils::loadAssetsIndexJson("test", file.fileName(), index));
+        AssetsIndex expected;
+        loadAssetsIndexWithDom(file.fileName(), expected);
+
+        QCOMPARE(index.id, QString("test"));
+        QCOMPARE(index.isVirtual, true);
+        QCOMPARE(index.mapToResources, false);
+        // the DOM version went through a map, so it sorted the objects by name
+        auto loaded = index.objects;
+        std::sort(loaded.begin(), loaded.end(), [](auto& a, auto& b) { return a.first < b.first; });
+        QCOMPARE(loaded.size(), expected.objects.size());
+        for (int i = 0; i < loaded.size(); i++) {
+            QCOMPARE(loaded[i].first, expected.objects[i].first);
+            QCOMPARE(loaded[i].second.hashId, expected.objects[i].second.hashId);
+            QCOMPARE(loaded[i].second.size, expected.objects[i].second.size);
+        }
+    }
+
+    void benchmark_AssetsIndexQtDom()
+    {
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        file.write(makeAssetsIndex(4000));
+        file.close();
+        QBENCHMARK
+        {
+            AssetsIndex index;
+            loadAssetsIndexWithDom(file.fileName(), index);
+        }
+    }
+
+    void benchmark_AssetsIndexOnDemand()
+    {
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        file.write(makeAssetsIndex(4000));
+        file.close();
+        QBENCHMARK
+        {
+            AssetsIndex index;
+            AssetsUtils::loadAssetsIndexJson("test", file.fileName(), index);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(JsonOnDemandTest)
+
+#include "JsonOnDemand_test.moc"
@@ -0,0 +1,77 @@
+#include <QTest>
+
+#include <Json.h>
+
+class JsonTest : public QObject {
+    Q_OBJECT
+
+    QJsonObject sample()
+    {
+        return QJsonObject{ { "name", "value" }, { "count", 3 }, { "list", QJsonArray{ "a", "b" } }, { "nothing", QJsonValue() } };
+    }
+
+   private slots:
+    void test_KeyKinds()
+    {
+        const auto obj = sample();
+        QCOMPARE(Json::requireString(obj, "name"), QString("value"));
+        QCOMPARE(Json::requireString(obj, QLatin1String("name")), QString("value"));
+        QCOMPARE(Json::requireString(obj, QString("name")), QString("value"));
+        QCOMPARE(Json::ensureInteger(obj, "count", 0), 3);
+        QCOMPARE(Json::ensureInteger(obj, "missing", 7), 7);
+        QCOMPARE(Json::ensureInteger(obj, "name", 7), 7);
+        QCOMPARE(Json::ensureString(obj, "nothing", "default"), QString("default"));
+        QCOMPARE(Json::requireIsArrayOf<QString>(obj, "list"), QVector<QString>({ "a", "b" }));
+        QCOMPARE(Json::ensureIsArrayOf<QString>(obj, "missing"), QVector<QString>());
+    }
+
+    void test_ErrorMessages()
+    {
+        const auto obj = sample();
+        try {
+            Json::requireString(obj, "missing");
+            QFAIL("no exception");
+        } catch (const Json::JsonException& e) {
+            QCOMPARE(e.cause(), QString("'missing's parent does not contain 'missing'"));
+        }
+        try {
+            Json::requireString(obj, "count");
+            QFAIL("no exception");
+        } catch (const Json::JsonException& e) {
+            QCOMPARE(e.cause(), QString("'count' is not a string"));
+        }
+        try {
+            Json::requireString(obj, "count", "pack name");
+            QFAIL("no exception");
+        } catch (const Json::JsonException& e) {
+            QCOMPARE(e.cause(), QString("pack name is not a string"));
+        }
+        QVERIFY_EXCEPTION_THROWN(Json::requireIsArrayOf<int>(obj, "list"), Json::JsonException);
+    }
+
+    void benchmark_LiteralKeys()
+    {
+        const auto obj = sample();
+        QBENCHMARK
+        {
+            Json::requireString(obj, "name");
+            Json::ensureInteger(obj, "count", 0);
+            Json::ensureString(obj, "missing", QString());
+        }
+    }
+
+    void benchmark_QStringKeys()
+    {
+        const auto obj = sample();
+        QBENCHMARK
+        {
+            Json::requireString(obj, QString("name"));
+            Json::ensureInteger(obj, QString("count"), 0);
+            Json::ensureString(obj, QString("missing"), QString());
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(JsonTest)
+
+#include "Json_test.moc"
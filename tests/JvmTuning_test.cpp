@@ -0,0 +1,84 @@
+#include <QTest>
+
+#include <java/JvmTuning.h>
+
+class JvmTuningTest : public QObject {
+    Q_OBJECT
+
+    static JvmTuning::Machine machine(uint64_t memoryMiB, int cpus = 8)
+    {
+        JvmTuning::Machine machine;
+        machine.memoryMiB = memoryMiB;
+        machine.cpus = cpus;
+        return machine;
+    }
+
+    static JvmTuning::Game game(const QString& java, int mods)
+    {
+        JvmTuning::Game game;
+        game.javaVersion = JavaVersion(java);
+        game.mods = mods;
+        return game;
+    }
+
+   private slots:
+    void test_heapGrowsWithMods()
+    {
+        auto vanilla = JvmTuning::choose(machine(16384), game("17.0.8", 0));
+        auto modded = JvmTuning::choose(machine(16384), game("17.0.8", 300));
+        QCOMPARE(vanilla.maxHeapMiB, 2048);
+        QCOMPARE(modded.maxHeapMiB, 7168);
+        QVERIFY(modded.minHeapMiB < modded.maxHeapMiB);
+    }
+
+    void test_heapFitsTheMachine()
+    {
+        QCOMPARE(JvmTuning::choose(machine(4096), game("17.0.8", 300)).maxHeapMiB, 2048);
+        QCOMPARE(JvmTuning::choose(machine(2048), game("17.0.8", 0)).maxHeapMiB, 1024);
+        QCOMPARE(JvmTuning::choose(machine(131072), game("21.0.1", 2000)).maxHeapMiB, 16384);
+
+        auto game32 = game("1.8.0_51", 100);
+        game32.is64bit = false;
+        QCOMPARE(JvmTuning::choose(machine(16384), game32).maxHeapMiB, 1024);
+    }
+
+    void test_collector()
+    {
+        auto g1 = JvmTuning::choose(machine(16384), game("17.0.8", 100));
+        QVERIFY(g1.flags.contains("-XX:+UseG1GC"));
+        QVERIFY(g1.flags.contains("-XX:G1HeapRegionSize=8M"));
+
+        auto zgc = JvmTuning::choose(machine(32768), game("21.0.1", 500));
+        QVERIFY(zgc.flags.contains("-XX:+UseZGC"));
+        QVERIFY(zgc.flags.contains("-XX:+ZGenerational"));
+        QVERIFY(!JvmTuning::choose(machine(32768), game("23.0.1", 500)).flags.contains("-XX:+ZGenerational"));
+
+        // too few cores for a concurrent collector to keep up
+        QVERIFY(JvmTuning::choose(machine(32768, 2), game("21.0.1", 500)).flags.contains("-XX:+UseG1GC"));
+    }
+
+    void test_leavesOthersAlone()
+    {
+        auto chosen = game("17.0.8", 100);
+        chosen.userArguments = QStringList{ "-XX:+UseShenandoahGC" };
+        QVERIFY(JvmTuning::choose(machine(16384), chosen).flags.isEmpty());
+
+        auto openj9 = game("17.0.8", 100);
+        openj9.javaVendor = "Eclipse OpenJ9";
+        QVERIFY(JvmTuning::choose(machine(16384), openj9).flags.isEmpty());
+
+        QVERIFY(JvmTuning::choose(machine(16384), game("1.7.0_80", 10)).flags.isEmpty());
+    }
+
+    void test_hugePages()
+    {
+        auto withThp = machine(16384);
+        withThp.transparentHugePages = true;
+        QVERIFY(JvmTuning::choose(withThp, game("17.0.8", 0)).flags.contains("-XX:+UseTransparentHugePages"));
+        QVERIFY(!JvmTuning::choose(machine(16384), game("17.0.8", 0)).flags.contains("-XX:+UseTransparentHugePages"));
+    }
+};
+
+QTEST_GUILESS_MAIN(JvmTuningTest)
+
+#include "JvmTuning_test.moc"
@@ -0,0 +1,215 @@
+#include <QBuffer>
+#include <QDataStream>
+#include <QTest>
+
+#include <GZip.h>
+#include <io/stream_reader.h>
+#include <minecraft/LevelDat.h>
+
+#include <sstream>
+
+namespace {
+
+enum TagType : quint8 { End = 0, Byte = 1, Int = 3, Long = 4, String = 8, List = 9, Compound = 10, IntArray = 11 };
+
+void writeString(QDataStream& out, const QByteArray& value)
+{
+    out << quint16(value.size());
+    out.writeRawData(value.constData(), value.size());
+}
+
+void writeTag(QDataStream& out, TagType type, const QByteArray& name)
+{
+    out << quint8(type);
+    writeString(out, name);
+}
+
+// the kind of data that makes up most of a modded level.dat, none of which the launcher wants
+void writeFiller(QDataStream& out, int amount)
+{
+    writeTag(out, Compound, "Player");
+    writeTag(out, List, "Inventory");
+    out << quint8(Compound) << qint32(amount);
+    for (int i = 0; i < amount; i++) {
+        writeTag(out, String, "id");
+        writeString(out, "somemod:some_pretty_long_item_name_" + QByteArray::number(i));
+        writeTag(out, Byte, "Count");
+        out << qint8(64);
+        writeTag(out, Compound, "tag");
+        writeTag(out, Int, "Damage");
+        out << qint32(i);
+        out << quint8(End);
+        out << quint8(End);
+    }
+    out << quint8(End);
+
+    writeTag(out, Compound, "DataPacks");
+    writeTag(out, List, "Enabled");
+    out << quint8(String) << qint32(amount / 10);
+    for (int i = 0; i < amount / 10; i++) {
+        writeString(out, "file/datapack_" + QByteArray::number(i) + ".zip");
+    }
+    out << quint8(End);
+
+    writeTag(out, Compound, "fml");
+    writeTag(out, IntArray, "Registries");
+    out << qint32(amount * 4);
+    for (int i = 0; i < amount * 4; i++) {
+        out << qint32(i);
+    }
+    out << quint8(End);
+}
+
+QByteArray makeLevelDat(bool modern, int filler)
+{
+    QByteArray nbt;
+    QDataStream out(&nbt, QIODevice::WriteOnly);
+    writeTag(out, Compound, "");
+    writeTag(out, Compound, "Data");
+    if (filler)
+        writeFiller(out, filler);
+    writeTag(out, String, "LevelName");
+    writeString(out, "Test World");
+    writeTag(out, Int, "GameType");
+    out << qint32(1);
+    if (modern) {
+        writeTag(out, Long, "LastPlayed");
+        out << qint64(1700000000000);
+        writeTag(out, Compound, "WorldGenSettings");
+        writeTag(out, Compound, "dimensions");
+        if (filler)
+            writeFiller(out, filler / 10);
+        out << quint8(End);
+        writeTag(out, Long, "seed");
+        out << qint64(-1234567890123);
+        out << quint8(End);
+    } else {
+        writeTag(out, Long, "RandomSeed");
+        out << qint64(42);
+    }
+    out << quint8(End);
+    out << quint8(End);
+
+    QByteArray gzipped;
+    GZip::zip(nbt, gzipped);
+    return gzipped;
+}
+
+}  // namespace
+
+class LevelDatTest : public QObject {
+    Q_OBJECT
+
+    void addInputs()
+    {
+        QTest::addColumn<QByteArray>("levelDat");
+        QTest::newRow("vanilla") << makeLevelDat(true, 0);
+        QTest::newRow("legacy") << makeLevelDat(false, 50);
+        QTest::newRow("modded") << makeLevelDat(true, 20000);
+    }
+
+   private slots:
+    void test_modern()
+    {
+        auto summary = LevelDat::readSummary(makeLevelDat(true, 1000));
+        QVERIFY(summary);
+        QCOMPARE(*summary->levelName, QString("Test World"));
+        QCOMPARE(*summary->lastPlayed, int64_t(1700000000000));
+        QCOMPARE(*summary->gameType, 1);
+        QCOMPARE(*summary->seed, int64_t(-1234567890123));
+        QVERIFY(!summary->randomSeed);
+    }
+
+    void test_legacy()
+    {
+        auto summary = LevelDat::readSummary(makeLevelDat(false, 1000));
+        QVERIFY(summary);
+        QCOMPARE(*summary->levelName, QString("Test World"));
+        QVERIFY(!summary->lastPlayed);
+        QVERIFY(!summary->seed);
+        QCOMPARE(*summary->randomSeed, int64_t(42));
+    }
+
+    void test_wrongTypes()
+    {
+        QByteArray nbt;
+        QDataStream out(&nbt, QIODevice::WriteOnly);
+        writeTag(out, Compound, "");
+        writeTag(out, Compound, "Data");
+        writeTag(out, Int, "LevelName");
+        out << qint32(5);
+        writeTag(out, String, "GameType");
+        writeString(out, "creative");
+        out << quint8(End) << quint8(End);
+        QByteArray gzipped;
+        QVERIFY(GZip::zip(nbt, gzipped));
+
+        auto summary = LevelDat::readSummary(gzipped);
+        QVERIFY(summary);
+        QVERIFY(!summary->levelName);
+        QVERIFY(!summary->gameType);
+    }
+
+    void test_stopsEarly()
+    {
+        // everything is found before the garbage at the end, which never gets read
+        auto levelDat = makeLevelDat(true, 0);
+        QByteArray nbt;
+        QVERIFY(GZip::unzip(levelDat, nbt));
+        nbt.chop(2);
+        nbt.append(QByteArray(64, char(0xff)));
+        QByteArray gzipped;
+        QVERIFY(GZip::zip(nbt, gzipped));
+        QVERIFY(LevelDat::readSummary(gzipped));
+    }
+
+    void test_invalid()
+    {
+        QVERIFY(!LevelDat::readSummary(QByteArray()));
+        QVERIFY(!LevelDat::readSummary(QByteArray("not gzipped at all")));
+
+        // truncated
+        auto levelDat = makeLevelDat(false, 100);
+        QByteArray nbt;
+        QVERIFY(GZip::unzip(levelDat, nbt));
+        QByteArray gzipped;
+        QVERIFY(GZip::zip(nbt.left(nbt.size() / 2), gzipped));
+        QVERIFY(!LevelDat::readSummary(gzipped));
+
+        // no Data in the root
+        QByteArray empty;
+        QDataStream out(&empty, QIODevice::WriteOnly);
+        writeTag(out, Compound, "");
+        out << quint8(End);
+        QVERIFY(GZip::zip(empty, gzipped));
+        QVERIFY(!LevelDat::readSummary(gzipped));
+    }
+
+    void benchmark_readSummary_data() { addInputs(); }
+    void benchmark_readSummary()
+    {
+        QFETCH(QByteArray, levelDat);
+        QBENCHMARK
+        {
+            LevelDat::readSummary(levelDat);
+        }
+    }
+
+    // what World used to do: inflate everything, then build the whole tree
+    void benchmark_readFullTree_data() { addInputs(); }
+    void benchmark_readFullTree()
+    {
+        QFETCH(QByteArray, levelDat);
+        QBENCHMARK
+        {
+            QByteArray output;
+            GZip::unzip(levelDat, output);
+            std::istringstream stream(std::string(output.constData(), output.size()));
+            nbt::io::read_compound(stream);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(LevelDatTest)
+
+#include "LevelDat_test.moc"
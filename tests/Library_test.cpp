@@ -37,6 +37,7 @@
 
 #include <FileSystem.h>
 #include <RuntimeContext.h>
+#include <minecraft/LaunchProfile.h>
 #include <minecraft/Library.h>
 #include <minecraft/MojangVersionFormat.h>
 #include <minecraft/OneSixVersionFormat.h>
@@ -322,6 +323,47 @@ class LibraryTest : public QObject {
         QCOMPARE(dls[1]->url(),
                  QUrl("https://libraries.minecraft.net/tv/twitch/twitch-platform/5.16/twitch-platform-5.16-natives-windows-64.jar"));
     }
+    void test_profile_library_files()
+    {
+        RuntimeContext r32 = dummyContext("windows", "32");
+        RuntimeContext r64 = dummyContext("windows", "64");
+        LaunchProfile profile;
+        profile.applyLibrary(std::make_shared<Library>("test.package:testname:testversion"), r64);
+        profile.applyLibrary(readMojangJson(QFINDTESTDATA("testdata/Library/lib-native-arch.json")), r64);
+
+        QStringList jars, nativeJars;
+        profile.getLibraryFiles(r64, jars, nativeJars, QString(), QString());
+        QCOMPARE(jars, getStorage("test/package/testname/testversion/testname-testversion.jar"));
+        QCOMPARE(nativeJars, getStorage("tv/twitch/twitch-platform/5.16/twitch-platform-5.16-natives-windows-64.jar"));
+
+        // asking again gives the same, and another context gets its own files
+        QStringList againJars, againNativeJars;
+        profile.getLibraryFiles(r64, againJars, againNativeJars, QString(), QString());
+        QCOMPARE(againJars, jars);
+        QCOMPARE(againNativeJars, nativeJars);
+        profile.getLibraryFiles(r32, jars, nativeJars, QString(), QString());
+        QCOMPARE(nativeJars, getStorage("tv/twitch/twitch-platform/5.16/twitch-platform-5.16-natives-windows-32.jar"));
+    }
+
+    void test_profile_copy()
+    {
+        RuntimeContext r64 = dummyContext("windows", "64");
+        LaunchProfile profile;
+        profile.applyLibrary(std::make_shared<Library>("test.package:testname:1.0"), r64);
+
+        // building on a copy leaves the original as it was
+        LaunchProfile copy(profile);
+        copy.applyLibrary(std::make_shared<Library>("test.package:testname:2.0"), r64);
+        copy.applyLibrary(std::make_shared<Library>("test.package:other:1.0"), r64);
+        QCOMPARE(profile.getLibraries().size(), 1);
+        QCOMPARE(profile.getLibraries().first()->version(), QString("1.0"));
+        QCOMPARE(copy.getLibraries().size(), 2);
+        QCOMPARE(copy.getLibraries().first()->version(), QString("2.0"));
+
+        QStringList jars, nativeJars;
+        profile.getLibraryFiles(r64, jars, nativeJars, QString(), QString());
+        QCOMPARE(jars, getStorage("test/package/testname/1.0/testname-1.0.jar"));
+    }
 
    private:
     std::unique_ptr<HttpMetaCache> cache;
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QTest>
+
+#include <FileSystem.h>
+
+#include <minecraft/mod/tasks/LocalModParseTask.h>
+
+class LocalModParseTest : public QObject {
+    Q_OBJECT
+
+    QByteArray readDescriptor(const QString& name)
+    {
+        QString source = QFINDTESTDATA("testdata/LocalModParse");
+        return FS::read(FS::PathCombine(source, name));
+    }
+
+   private slots:
+    void test_parseMCModTOML()
+    {
+        auto details = ModUtils::ReadMCModTOML(readDescriptor("mods.toml"));
+
+        QCOMPARE(details.mod_id, QString("supercoolmod"));
+        QCOMPARE(details.version, QString("1.2.3"));
+        QCOMPARE(details.name, QString("Super Cool Mod"));
+        QCOMPARE(details.authors, QStringList({ "Some Person" }));
+        QCOMPARE(details.homeurl, QString("http://example.com/supercoolmod"));
+        QCOMPARE(details.issue_tracker, QString("https://example.com/supercoolmod/issues"));
+        QCOMPARE(details.icon_file, QString("logo.png"));
+    }
+
+    void test_parseFabricModInfo()
+    {
+        auto details = ModUtils::ReadFabricModInfo(readDescriptor("fabric.mod.json"));
+
+        QCOMPARE(details.mod_id, QString("supercoolmod"));
+        QCOMPARE(details.version, QString("1.2.3"));
+        QCOMPARE(details.name, QString("Super Cool Mod"));
+        QCOMPARE(details.description, QString("A super cool mod, with \"quotes\" and {braces} in it."));
+        QCOMPARE(details.authors, QStringList({ "Some Person", "Another Person" }));
+        QCOMPARE(details.homeurl, QString("https://example.com/supercoolmod"));
+        QCOMPARE(details.issue_tracker, QString("https://example.com/supercoolmod/issues"));
+        QCOMPARE(details.licenses.size(), 1);
+        QCOMPARE(details.icon_file, QString("assets/supercoolmod/icon128.png"));
+    }
+
+    void test_parseQuiltModInfo()
+    {
+        auto details = ModUtils::ReadQuiltModInfo(readDescriptor("quilt.mod.json"));
+
+        QCOMPARE(details.mod_id, QString("supercoolmod"));
+        QCOMPARE(details.version, QString("1.2.3"));
+        QCOMPARE(details.name, QString("Super Cool Mod"));
+        QCOMPARE(details.authors, QStringList({ "Another Person", "Some Person" }));
+        QCOMPARE(details.homeurl, QString("https://example.com/supercoolmod"));
+        QCOMPARE(details.licenses.size(), 1);
+        QCOMPARE(details.licenses.first().id, QString("MIT"));
+        QCOMPARE(details.icon_file, QString("assets/supercoolmod/icon.png"));
+    }
+
+    void test_parseMalformedJson()
+    {
+        // Falls back to the regular parser, which gives back an empty document
+        auto details = ModUtils::ReadFabricModInfo("{ \"schemaVersion\": 1, \"id\": ");
+        QVERIFY(details.mod_id.isEmpty());
+    }
+
+    void benchmark_parseMCModTOML()
+    {
+        auto contents = readDescriptor("mods.toml");
+        QBENCHMARK
+        {
+            ModUtils::ReadMCModTOML(contents);
+        }
+    }
+
+    void benchmark_parseFabricModInfo()
+    {
+        auto contents = readDescriptor("fabric.mod.json");
+        QBENCHMARK
+        {
+            ModUtils::ReadFabricModInfo(contents);
+        }
+    }
+
+    void benchmark_parseQuiltModInfo()
+    {
+        auto contents = readDescriptor("quilt.mod.json");
+        QBENCHMARK
+        {
+            ModUtils::ReadQuiltModInfo(contents);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(LocalModParseTest)
+
+#include "LocalModParse_test.moc"
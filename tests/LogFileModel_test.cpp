@@ -0,0 +1,96 @@
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <GZip.h>
+#include <LogFileModel.h>
+
+class LogFileModelTest : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+
+    QString write(const QString& name, const QByteArray& content)
+    {
+        QFile file(m_dir.filePath(name));
+        if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size())
+            return {};
+        return file.fileName();
+    }
+
+    static bool load(LogFileModel& model, const QString& path)
+    {
+        QSignalSpy spy(&model, &LogFileModel::loaded);
+        return model.load(path) && (spy.count() || spy.wait());
+    }
+
+    static QString line(const LogFileModel& model, int row) { return model.data(model.index(row)).toString(); }
+
+   private slots:
+    void test_lines()
+    {
+        LogFileModel model;
+        QVERIFY(load(model, write("plain.log", "first\r\n\nthird ünïcödé\nno newline")));
+
+        QCOMPARE(model.rowCount(), 4);
+        QCOMPARE(line(model, 0), QString("first"));
+        QCOMPARE(line(model, 1), QString());
+        QCOMPARE(line(model, 2), QString("third ünïcödé"));
+        QCOMPARE(line(model, 3), QString("no newline"));
+        QCOMPARE(model.text(), QString("first\r\n\nthird ünïcödé\nno newline"));
+    }
+
+    void test_empty()
+    {
+        LogFileModel model;
+        QVERIFY(load(model, write("empty.log", "")));
+        QCOMPARE(model.rowCount(), 0);
+        QCOMPARE(model.find("a", 0, false), -1);
+    }
+
+    void test_gzip()
+    {
+        QByteArray content;
+        for (int i = 0; i < 100000; i++)
+            content += QString("line %1\n").arg(i).toUtf8();
+        QByteArray compressed;
+        QVERIFY(GZip::zip(content, compressed));
+
+        LogFileModel model;
+        QVERIFY(load(model, write("latest.log.gz", compressed)));
+        QCOMPARE(model.rowCount(), 100000);
+        QCOMPARE(line(model, 54321), QString("line 54321"));
+        QCOMPARE(model.indexedSize(), content.size());
+    }
+
+    void test_brokenGzip()
+    {
+        LogFileModel model;
+        QSignalSpy spy(&model, &LogFileModel::loadFailed);
+        QVERIFY(model.load(write("broken.log.gz", "not gzip at all")));
+        QVERIFY(spy.wait());
+        QCOMPARE(model.rowCount(), 1);
+    }
+
+    void test_find()
+    {
+        LogFileModel model;
+        QVERIFY(load(model, write("find.log", "[INFO] one\n[WARN] Two\n[info] three\n")));
+
+        auto first = model.find("info", 0, false);
+        QCOMPARE(first, 1);
+        QCOMPARE(model.rowAt(first), 0);
+        auto second = model.find("info", first + 1, false);
+        QCOMPARE(model.rowAt(second), 2);
+        QCOMPARE(model.find("info", second + 1, false), -1);
+
+        QCOMPARE(model.find("INFO", second, true), first);
+        QCOMPARE(model.find("two", model.indexedSize(), true), model.rowStart(1) + 7);
+        QCOMPARE(model.rowStart(2), qint64(22));
+        QCOMPARE(model.rowAt(model.rowStart(2) - 1), 1);
+    }
+};
+
+QTEST_GUILESS_MAIN(LogFileModelTest)
+
+#include "LogFileModel_test.moc"
@@ -0,0 +1,98 @@
+#include <QTest>
+
+#include <launch/LogStore.h>
+
+class LogStoreTest : public QObject {
+    Q_OBJECT
+
+    // small blocks, so that a few lines are enough to spill most of them to disk
+    static void fill(LogStore& store, int count)
+    {
+        for (int i = 0; i < count; i++) {
+            store.append(i % 2 ? MessageLevel::Warning : MessageLevel::Message, QString("line %1 ünïcödé").arg(i));
+        }
+    }
+
+   private slots:
+    void test_appendAndRead()
+    {
+        LogStore store(64, 2);
+        fill(store, 1000);
+
+        QCOMPARE(store.size(), 1000);
+        QCOMPARE(store.line(0), QString("line 0 ünïcödé"));
+        QCOMPARE(store.line(537), QString("line 537 ünïcödé"));
+        QCOMPARE(store.line(999), QString("line 999 ünïcödé"));
+        QCOMPARE(store.level(0), MessageLevel::Message);
+        QCOMPARE(store.level(537), MessageLevel::Warning);
+        QCOMPARE(store.line(1000), QString());
+    }
+
+    void test_emptyLines()
+    {
+        LogStore store(64, 2);
+        store.append(MessageLevel::Message, "first");
+        store.append(MessageLevel::Message, "");
+        store.append(MessageLevel::Message, "third");
+
+        QCOMPARE(store.line(1), QString());
+        QCOMPARE(store.line(2), QString("third"));
+        QCOMPARE(store.find("third", 0), 2);
+    }
+
+    void test_removeFirst()
+    {
+        LogStore store(64, 2);
+        fill(store, 10000);
+        store.removeFirst(9000);
+
+        QCOMPARE(store.size(), 1000);
+        QCOMPARE(store.line(0), QString("line 9000 ünïcödé"));
+        QCOMPARE(store.line(999), QString("line 9999 ünïcödé"));
+
+        fill(store, 10);
+        QCOMPARE(store.size(), 1010);
+        QCOMPARE(store.line(1000), QString("line 0 ünïcödé"));
+
+        store.removeFirst(5000);
+        QCOMPARE(store.size(), 0);
+    }
+
+    void test_find()
+    {
+        LogStore store(64, 2);
+        fill(store, 1000);
+
+        QCOMPARE(store.find("line 537 ", 0), 537);
+        QCOMPARE(store.find("line 537 ", 538), -1);
+        QCOMPARE(store.find("line 537 ", 999, true), 537);
+        QCOMPARE(store.find("line 537 ", 536, true), -1);
+        QCOMPARE(store.find("LINE 42 ", 0, false, Qt::CaseInsensitive), 42);
+        QCOMPARE(store.find("LINE 42 ", 0), -1);
+        // matches can't go across lines
+        QCOMPARE(store.find("ünïcödéline", 0), -1);
+        QCOMPARE(store.find("cödé", 999, true), 999);
+
+        store.removeFirst(600);
+        QCOMPARE(store.find("line 537 ", 0), -1);
+        QCOMPARE(store.find("line 637 ", 0), 37);
+        QCOMPARE(store.find("line 637 ", 399, true), 37);
+    }
+
+    void test_clear()
+    {
+        LogStore store(64, 2);
+        fill(store, 100);
+        store.clear();
+
+        QCOMPARE(store.size(), 0);
+        QCOMPARE(store.find("line", 0), -1);
+
+        fill(store, 3);
+        QCOMPARE(store.line(2), QString("line 2 ünïcödé"));
+    }
+};
+
+QTEST_GUILESS_MAIN(LogStoreTest)
+
+#include "LogStore_test.moc"
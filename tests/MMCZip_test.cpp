@@ -0,0 +1,229 @@
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <MMCZip.h>
+#include <quazip/quazipfile.h>
+
+#include <zlib.h>
+
+class MMCZipTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_ExportToZip()
+    {
+        QTemporaryDir source;
+        QTemporaryDir target;
+        QVERIFY(source.isValid() && target.isValid());
+
+        QHash<QString, QByteArray> contents;
+        contents.insert("empty.txt", {});
+        contents.insert("config/options.txt", QByteArray("fov:70\n").repeated(1000));
+        contents.insert("mods/mod.jar", QByteArray("PK not really a jar"));
+        contents.insert("screenshot.png", QByteArray("\x89PNG", 4).repeated(300));
+        for (int i = 0; i < 50; i++)
+            contents.insert(QString("many/%1.json").arg(i), QByteArray::number(i).repeated(i * 10));
+        contents.insert("excluded.txt", "never exported");
+
+        QFileInfoList files;
+        for (auto it = contents.cbegin(); it != contents.cend(); ++it) {
+            auto path = FS::PathCombine(source.path(), it.key());
+            FS::write(path, it.value());
+            files.append(QFileInfo(path));
+        }
+
+        auto zipPath = FS::PathCombine(target.path(), "export.zip");
+        ExportToZipTask task(zipPath, source.path(), files, "prefix/");
+        task.setExcludeFiles({ "excluded.txt" });
+        task.addExtraFile("extra.json", "{}");
+        QSignalSpy finished(&task, &Task::finished);
+        task.start();
+        QVERIFY(finished.wait(10000));
+        QVERIFY2(task.wasSuccessful(), qPrintable(task.failReason()));
+
+        auto extracted = FS::PathCombine(target.path(), "extracted");
+        QVERIFY(MMCZip::extractDir(zipPath, extracted).has_value());
+        QCOMPARE(FS::read(FS::PathCombine(extracted, "extra.json")), QByteArray("{}"));
+        QVERIFY(!QFileInfo::exists(FS::PathCombine(extracted, "prefix/excluded.txt")));
+        contents.remove("excluded.txt");
+        for (auto it = contents.cbegin(); it != contents.cend(); ++it)
+            QCOMPARE(FS::read(FS::PathCombine(extracted, "prefix", it.key())), it.value());
+    }
+
+    void test_ExportReusesPreviousArchive()
+    {
+        QTemporaryDir source;
+        QVERIFY(source.isValid());
+
+        QHash<QString, QByteArray> contents;
+        contents.insert("kept.txt", QByteArray("unchanged ").repeated(500));
+        contents.insert("same-size.txt", QByteArray("aaaa").repeated(100));
+        contents.insert("grown.txt", "short");
+
+        QFileInfoList files;
+        for (auto it = contents.cbegin(); it != contents.cend(); ++it) {
+            auto path = FS::PathCombine(source.path(), it.key());
+            FS::write(path, it.value());
+            files.append(QFileInfo(path));
+        }
+
+        auto zipPath = FS::PathCombine(source.path(), "export.zip");
+        auto exportOnce = [&] {
+            ExportToZipTask task(zipPath, source.path(), files, "overrides/");
+            task.setPreviousArchive(zipPath);
+            QSignalSpy finished(&task, &Task::finished);
+            task.start();
+            return finished.wait(10000) && task.wasSuccessful();
+        };
+        QVERIFY(exportOnce());
+
+        contents["same-size.txt"] = QByteArray("bbbb").repeated(100);
+        contents["grown.txt"] = "a lot longer than before";
+        FS::write(FS::PathCombine(source.path(), "same-size.txt"), contents["same-size.txt"]);
+        FS::write(FS::PathCombine(source.path(), "grown.txt"), contents["grown.txt"]);
+        QVERIFY(exportOnce());
+        QVERIFY(!QFileInfo::exists(zipPath + ".previous"));
+
+        auto extracted = FS::PathCombine(source.path(), "extracted");
+        QVERIFY(MMCZip::extractDir(zipPath, extracted).has_value());
+        for (auto it = contents.cbegin(); it != contents.cend(); ++it)
+            QCOMPARE(FS::read(FS::PathCombine(extracted, "overrides", it.key())), it.value());
+    }
+
+    void test_MergeKeepsEntries()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto folder = FS::PathCombine(dir.path(), "folder");
+        FS::write(FS::PathCombine(folder, "text.txt"), QByteArray("deflate me ").repeated(100));
+        FS::write(FS::PathCombine(folder, "image.png"), QByteArray("\x89PNG", 4).repeated(100));
+        FS::write(FS::PathCombine(folder, "skipped/file.txt"), "filtered out");
+
+        QFileInfoList files;
+        QVERIFY(MMCZip::collectFileListRecursively(folder, nullptr, &files, nullptr));
+        auto source = FS::PathCombine(dir.path(), "source.zip");
+        QVERIFY(MMCZip::compressDirFiles(source, folder, files));
+
+        auto merged = FS::PathCombine(dir.path(), "merged.zip");
+        {
+            QuaZip into(merged);
+            QVERIFY(into.open(QuaZip::mdCreate));
+            QSet<QString> contained;
+            QVERIFY(MMCZip::mergeZipFiles(&into, QFileInfo(source), contained,
+                                          [](const QString& name) { return !name.startsWith("skipped/"); }));
+            into.close();
+            QCOMPARE(into.getZipError(), 0);
+        }
+
+        QuaZip zip(merged);
+        QVERIFY(zip.open(QuaZip::mdUnzip));
+        QHash<QString, int> methods;
+        for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile()) {
+            QuaZipFileInfo64 info;
+            QVERIFY(zip.getCurrentFileInfo(&info));
+            methods.insert(info.name, info.method);
+        }
+        QCOMPARE(methods.keys().size(), 2);
+        QCOMPARE(methods.value("image.png"), 0);
+        QCOMPARE(methods.value("text.txt"), int(Z_DEFLATED));
+        zip.close();
+
+        auto extracted = FS::PathCombine(dir.path(), "extracted");
+        QVERIFY(MMCZip::extractDir(merged, extracted).has_value());
+        QCOMPARE(FS::read(FS::PathCombine(extracted, "text.txt")), QByteArray("deflate me ").repeated(100));
+        QCOMPARE(FS::read(FS::PathCombine(extracted, "image.png")), QByteArray("\x89PNG", 4).repeated(100));
+    }
+
+    void test_ExtractManyEntries()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto folder = FS::PathCombine(dir.path(), "folder");
+        for (int i = 0; i < 300; i++)
+            FS::write(FS::PathCombine(folder, QString("sub%1/file%2.txt").arg(i % 13).arg(i)), QByteArray::number(i).repeated(i));
+
+        QFileInfoList files;
+        QVERIFY(MMCZip::collectFileListRecursively(folder, nullptr, &files, nullptr));
+        auto zipPath = FS::PathCombine(dir.path(), "many.zip");
+        QVERIFY(MMCZip::compressDirFiles(zipPath, folder, files));
+
+        auto extracted = FS::PathCombine(dir.path(), "extracted");
+        auto result = MMCZip::extractDir(zipPath, "sub1/", extracted);
+        QVERIFY(result.has_value());
+        QCOMPARE(result->size(), 23);
+
+        result = MMCZip::extractDir(zipPath, FS::PathCombine(dir.path(), "all"));
+        QVERIFY(result.has_value());
+        QCOMPARE(result->size(), 300);
+        for (int i = 0; i < 300; i++) {
+            auto path = FS::PathCombine(dir.path(), "all", QString("sub%1/file%2.txt").arg(i % 13).arg(i));
+            QCOMPARE(FS::read(path), QByteArray::number(i).repeated(i));
+        }
+    }
+
+    void test_ReadEntrySpans()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto folder = FS::PathCombine(dir.path(), "folder");
+        for (int i = 0; i < 40; i++)
+            FS::write(FS::PathCombine(folder, QString("sub%1/file%2.txt").arg(i % 3).arg(i)), QByteArray::number(i).repeated(i));
+
+        QFileInfoList files;
+        QVERIFY(MMCZip::collectFileListRecursively(folder, nullptr, &files, nullptr));
+        auto zipPath = FS::PathCombine(dir.path(), "spans.zip");
+        QVERIFY(MMCZip::compressDirFiles(zipPath, folder, files));
+        auto archive = FS::read(zipPath);
+
+        // only the end of the archive is needed to find the directory
+        auto tail = archive.right(int(std::min<qint64>(archive.size(), MMCZip::END_OF_DIRECTORY_SEARCH)));
+        qint64 offset = 0;
+        qint64 size = 0;
+        QVERIFY(MMCZip::findCentralDirectory(tail, archive.size(), offset, size));
+        QVERIFY(!MMCZip::findCentralDirectory(tail.left(tail.size() - 1), archive.size() - 1, offset, size));
+        QVERIFY(MMCZip::findCentralDirectory(tail, archive.size(), offset, size));
+
+        auto spans = MMCZip::readEntrySpans(archive.mid(int(offset), int(size)), offset);
+        QVERIFY(spans.has_value());
+        QCOMPARE(spans->size(), 40);
+
+        // every span starts at a local header, and together they cover everything before the directory
+        qint64 covered = 0;
+        for (auto& span : *spans) {
+            QCOMPARE(archive.mid(int(span.begin), 4), QByteArray("PK\x03\x04"));
+            QVERIFY(span.end > span.begin);
+            covered += span.end - span.begin;
+        }
+        QCOMPARE(covered, offset);
+    }
+
+    void test_FindFolderOf()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto folder = FS::PathCombine(dir.path(), "folder");
+        FS::write(FS::PathCombine(folder, "pack/overrides/config/manifest.json"), "{}");
+        FS::write(FS::PathCombine(folder, "pack/deeper/manifest.json"), "{}");
+        FS::write(FS::PathCombine(folder, "pack/manifest.json"), "{}");
+        FS::write(FS::PathCombine(folder, "other/overrides/instance.cfg"), "");
+
+        QFileInfoList files;
+        QVERIFY(MMCZip::collectFileListRecursively(folder, nullptr, &files, nullptr));
+        auto zipPath = FS::PathCombine(dir.path(), "pack.zip");
+        QVERIFY(MMCZip::compressDirFiles(zipPath, folder, files));
+
+        QuaZip zip(zipPath);
+        QVERIFY(zip.open(QuaZip::mdUnzip));
+        MMCZip::EntryIndex index(&zip);
+        QCOMPARE(index.findFolderOf("manifest.json", { "overrides/" }).value_or("none"), QString("pack/"));
+        QVERIFY(!index.findFolderOf("instance.cfg", { "overrides/" }));
+        QCOMPARE(index.findFolderOf("instance.cfg").value_or("none"), QString("other/overrides/"));
+        QCOMPARE(index.findFolderOf("config/manifest.json").value_or("none"), QString("pack/overrides/"));
+    }
+};
+
+QTEST_GUILESS_MAIN(MMCZipTest)
+
+#include "MMCZip_test.moc"
@@ -0,0 +1,49 @@
+#include <QTest>
+
+#include <Metrics.h>
+
+class MetricsTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void init() { Metrics::reset(); }
+
+    void test_Counters()
+    {
+        Metrics::count("downloads");
+        Metrics::count("downloads", 2);
+        Metrics::count("bytes", 1024);
+
+        auto snapshot = Metrics::snapshot();
+        QCOMPARE(snapshot["downloads"].toDouble(), 3.);
+        QCOMPARE(snapshot["bytes"].toDouble(), 1024.);
+    }
+
+    void test_Histograms()
+    {
+        for (double value : { 0.5, 3., 3., 100. })
+            Metrics::observe("duration_ms", value);
+
+        auto histogram = Metrics::snapshot()["duration_ms"].toObject();
+        QCOMPARE(histogram["count"].toDouble(), 4.);
+        QCOMPARE(histogram["sum"].toDouble(), 106.5);
+        QCOMPARE(histogram["min"].toDouble(), 0.5);
+        QCOMPARE(histogram["max"].toDouble(), 100.);
+
+        auto buckets = histogram["buckets"].toObject();
+        QCOMPARE(buckets["1"].toDouble(), 1.);
+        QCOMPARE(buckets["4"].toDouble(), 2.);
+        QCOMPARE(buckets["128"].toDouble(), 1.);
+    }
+
+    void test_Reset()
+    {
+        Metrics::count("downloads");
+        Metrics::reset();
+        QVERIFY(Metrics::snapshot().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(MetricsTest)
+
+#include "Metrics_test.moc"
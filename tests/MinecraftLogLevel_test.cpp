@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QRegularExpression>
+#include <QTest>
+
+#include <FileSystem.h>
+
+#include <minecraft/MinecraftLogLevelClassifier.h>
+
+// the regular expression based implementation the classifier replaced, to check that they agree
+static MessageLevel::Enum referenceLevel(const QString& line, MessageLevel::Enum level)
+{
+    QRegularExpression re("\\[(?<timestamp>[0-9:]+)\\] \\[[^/]+/(?<level>[^\\]]+)\\]");
+    auto match = re.match(line);
+    if (match.hasMatch()) {
+        QString levelStr = match.captured("level");
+        if (levelStr == "INFO")
+            level = MessageLevel::Message;
+        if (levelStr == "WARN")
+            level = MessageLevel::Warning;
+        if (levelStr == "ERROR")
+            level = MessageLevel::Error;
+        if (levelStr == "FATAL")
+            level = MessageLevel::Fatal;
+        if (levelStr == "TRACE" || levelStr == "DEBUG")
+            level = MessageLevel::Debug;
+    } else {
+        if (line.contains("[INFO]") || line.contains("[CONFIG]") || line.contains("[FINE]") || line.contains("[FINER]") ||
+            line.contains("[FINEST]"))
+            level = MessageLevel::Message;
+        if (line.contains("[SEVERE]") || line.contains("[STDERR]"))
+            level = MessageLevel::Error;
+        if (line.contains("[WARNING]"))
+            level = MessageLevel::Warning;
+        if (line.contains("[DEBUG]"))
+            level = MessageLevel::Debug;
+    }
+    if (line.contains("overwriting existing"))
+        return MessageLevel::Fatal;
+    static const QString javaSymbol = "([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$][a-zA-Z\\d_$]*";
+    if (line.contains("Exception in thread") || line.contains(QRegularExpression("\\s+at " + javaSymbol)) ||
+        line.contains(QRegularExpression("Caused by: " + javaSymbol)) ||
+        line.contains(QRegularExpression("([a-zA-Z_$][a-zA-Z\\d_$]*\\.)+[a-zA-Z_$]?[a-zA-Z\\d_$]*(Exception|Error|Throwable)")) ||
+        line.contains(QRegularExpression("... \\d+ more$")))
+        return MessageLevel::Error;
+    return level;
+}
+
+class MinecraftLogLevelTest : public QObject {
+    Q_OBJECT
+
+    QStringList readLog()
+    {
+        QString source = QFINDTESTDATA("testdata/MinecraftLogLevel");
+        return QString::fromUtf8(FS::read(FS::PathCombine(source, "latest.log"))).split('\n');
+    }
+
+   private slots:
+    void test_classify_data()
+    {
+        QTest::addColumn<QString>("line");
+        QTest::addColumn<int>("expected");
+
+        QTest::newRow("log4j info") << "[09:41:02] [main/INFO]: Loading 87 mods:" << int(MessageLevel::Message);
+        QTest::newRow("log4j warn") << "[09:41:03] [Render thread/WARN]: Missing sound" << int(MessageLevel::Warning);
+        QTest::newRow("log4j error") << "[09:41:07] [Render thread/ERROR]: Failed" << int(MessageLevel::Error);
+        QTest::newRow("log4j fatal") << "[09:41:08] [Render thread/FATAL]: Unreported" << int(MessageLevel::Fatal);
+        QTest::newRow("log4j trace") << "[09:41:03] [main/TRACE]: Mixin applied" << int(MessageLevel::Debug);
+        QTest::newRow("log4j unknown level") << "[09:41:03] [main/CUSTOM]: Something" << int(MessageLevel::StdOut);
+        QTest::newRow("forge info") << "2013-07-08 20:11:22 [INFO] [ForgeModLoader] loading" << int(MessageLevel::Message);
+        QTest::newRow("forge warning") << "2013-07-08 20:11:24 [WARNING] [FML] no annotation" << int(MessageLevel::Warning);
+        QTest::newRow("forge severe") << "2013-07-08 20:11:25 [SEVERE] [FML] Fatal errors" << int(MessageLevel::Error);
+        QTest::newRow("forge debug wins") << "[INFO] [WARNING] [DEBUG] all of them" << int(MessageLevel::Debug);
+        QTest::newRow("overwriting") << "[DEBUG] [FML] overwriting existing item" << int(MessageLevel::Fatal);
+        QTest::newRow("stack frame") << "\tat net.minecraft.client.Main.main(Main.java:1)" << int(MessageLevel::Error);
+        QTest::newRow("caused by") << "Caused by: java.lang.IllegalStateException" << int(MessageLevel::Error);
+        QTest::newRow("throwable") << "java.io.FileNotFoundException: oak_log.json" << int(MessageLevel::Error);
+        QTest::newRow("more frames") << "\t... 12 more" << int(MessageLevel::Error);
+        QTest::newRow("plain") << "LWJGL Version: 2.9.0" << int(MessageLevel::StdOut);
+        QTest::newRow("not a frame") << "Look at them" << int(MessageLevel::StdOut);
+    }
+
+    void test_classify()
+    {
+        QFETCH(QString, line);
+        QFETCH(int, expected);
+
+        MinecraftLogLevelClassifier classifier;
+        QCOMPARE(int(classifier.classify(line, MessageLevel::StdOut)), expected);
+    }
+
+    void test_matchesReference()
+    {
+        MinecraftLogLevelClassifier classifier;
+        for (auto& line : readLog()) {
+            for (auto level : { MessageLevel::StdOut, MessageLevel::StdErr }) {
+                QCOMPARE(int(classifier.classify(line, level)), int(referenceLevel(line, level)));
+            }
+        }
+    }
+
+    void test_benchmarkClassifier()
+    {
+        auto lines = readLog();
+        MinecraftLogLevelClassifier classifier;
+        QBENCHMARK
+        {
+            for (auto& line : lines)
+                classifier.classify(line, MessageLevel::StdOut);
+        }
+    }
+
+    void test_benchmarkReference()
+    {
+        auto lines = readLog();
+        QBENCHMARK
+        {
+            for (auto& line : lines)
+                referenceLevel(line, MessageLevel::StdOut);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(MinecraftLogLevelTest)
+
+#include "MinecraftLogLevel_test.moc"
@@ -0,0 +1,104 @@
+#include <QTemporaryFile>
+#include <QTest>
+
+#include <MurmurHash2.h>
+#include <random>
+
+static const QList<MurmurFilterKernel> s_kernels = { MurmurFilterKernel::Scalar, MurmurFilterKernel::SSE2, MurmurFilterKernel::AVX2,
+                                                     MurmurFilterKernel::NEON };
+
+static bool isCurseForgeWhitespace(char c)
+{
+    return c == 9 || c == 10 || c == 13 || c == 32;
+}
+
+class MurmurHash2Test : public QObject {
+    Q_OBJECT
+
+    // Random bytes, with roughly one in `whitespace_ratio` replaced by CurseForge whitespace
+    QByteArray makeData(int size, int whitespace_ratio, std::default_random_engine& eng)
+    {
+        static const char whitespace[] = { 9, 10, 13, 32 };
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::uniform_int_distribution<int> pick(0, 3);
+
+        QByteArray data(size, Qt::Uninitialized);
+        for (auto& c : data) {
+            c = static_cast<char>(byte(eng));
+            if (whitespace_ratio > 0 && byte(eng) % whitespace_ratio == 0)
+                c = whitespace[pick(eng)];
+        }
+        return data;
+    }
+
+   private slots:
+    void test_KnownValue()
+    {
+        // Whitespace doesn't count towards the fingerprint
+        QByteArray data("Hello, \tWorld!\r\n");
+        QByteArray stripped("Hello,World!");
+
+        QCOMPARE(CurseForgeMurmurHash2(data.constData(), data.size()),
+                 MurmurHash2(stripped.constData(), stripped.size()));
+        QCOMPARE(CurseForgeMurmurHash2(data.constData(), data.size()),
+                 MurmurHash2(data.constData(), data.size(), isCurseForgeWhitespace));
+    }
+
+    void test_KernelsMatchScalar_data()
+    {
+        QTest::addColumn<int>("whitespace_ratio");
+
+        QTest::newRow("binary") << 0;
+        QTest::newRow("sparse whitespace") << 64;
+        QTest::newRow("dense whitespace") << 2;
+    }
+
+    void test_KernelsMatchScalar()
+    {
+        QFETCH(int, whitespace_ratio);
+
+        std::default_random_engine eng(1234);
+
+        // Cover the vector tails, unaligned starts, and the chunk boundaries of the hashing loop
+        for (int size : { 0, 1, 3, 4, 15, 16, 17, 31, 32, 33, 100, 4096, 65535, 65536, 65537, 300001 }) {
+            auto buffer = makeData(size + 3, whitespace_ratio, eng);
+            for (int offset = 0; offset < 3; offset++) {
+                const char* data = buffer.constData() + offset;
+                auto expected = MurmurHash2(data, size, isCurseForgeWhitespace);
+
+                QByteArray scalar_filtered(size, Qt::Uninitialized);
+                auto scalar_size = MurmurFilterWhitespace(data, size, scalar_filtered.data(), MurmurFilterKernel::Scalar);
+                scalar_filtered.resize(static_cast<int>(scalar_size));
+
+                for (auto kernel : s_kernels) {
+                    if (!MurmurFilterKernelSupported(kernel))
+                        continue;
+
+                    QCOMPARE(CurseForgeMurmurHash2(data, size, kernel), expected);
+
+                    QByteArray filtered(size, Qt::Uninitialized);
+                    filtered.resize(static_cast<int>(MurmurFilterWhitespace(data, size, filtered.data(), kernel)));
+                    QCOMPARE(filtered, scalar_filtered);
+                }
+            }
+        }
+    }
+
+    void test_MatchesStreamed()
+    {
+        std::default_random_engine eng(5678);
+        auto data = makeData(5 * 1024 * 1024 + 7, 16, eng);
+
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        QCOMPARE(file.write(data), data.size());
+        file.close();
+
+        auto streamed = MurmurHash2(std::ifstream(file.fileName().toStdString(), std::ifstream::binary), 4 * MiB, isCurseForgeWhitespace);
+        QCOMPARE(CurseForgeMurmurHash2(data.constData(), data.size()), streamed);
+    }
+};
+
+QTEST_GUILESS_MAIN(MurmurHash2Test)
+
+#include "MurmurHash2_test.moc"
@@ -0,0 +1,73 @@
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/mod/PackDetailsCache.h>
+#include <minecraft/mod/tasks/LocalResourcePackParseTask.h>
+
+class PackDetailsCacheTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_persisted()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto path = FS::PathCombine(dir.path(), "packs.cache");
+        auto pack = FS::PathCombine(dir.path(), "pack.zip");
+        FS::write(pack, "not really a zip");
+        auto identity = Hashing::FileIdentity::of(pack);
+
+        {
+            PackDetailsCache cache(path);
+            cache.insert("pack.zip", identity, { 15, "A pack", true });
+            cache.insert("gone.zip", identity, { 1, "Deleted", false });
+            cache.retain({ "pack.zip" });
+            cache.save();
+        }
+
+        PackDetailsCache cache(path);
+        auto details = cache.lookup("pack.zip", identity);
+        QVERIFY(details);
+        QCOMPARE(details->pack_format, 15);
+        QCOMPARE(details->description, QString("A pack"));
+        QVERIFY(details->has_image);
+        QVERIFY(!cache.lookup("gone.zip", identity));
+
+        // the entry is only good for the file it was made from
+        auto changed = identity;
+        changed.size++;
+        QVERIFY(!cache.lookup("pack.zip", changed));
+    }
+
+    void test_parseTaskUsesCache()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto zip = FS::PathCombine(dir.path(), "pack.zip");
+        QVERIFY(QFile::copy(QFINDTESTDATA("testdata/ResourcePackParse/test_resource_pack_idk.zip"), zip));
+        auto cache = std::make_shared<PackDetailsCache>(FS::PathCombine(dir.path(), "packs.cache"));
+
+        ResourcePack parsed{ QFileInfo(zip) };
+        LocalResourcePackParseTask parse(0, parsed, cache);
+        QSignalSpy parsed_spy(&parse, &Task::succeeded);
+        parse.start();
+        QCOMPARE(parsed_spy.count(), 1);
+        QCOMPARE(parsed.packFormat(), 3);
+
+        // a cached entry is used as is, without opening the archive again
+        cache->insert("pack.zip", Hashing::FileIdentity::of(zip), { 7, "From the cache", false });
+        ResourcePack cached{ QFileInfo(zip) };
+        LocalResourcePackParseTask again(1, cached, cache);
+        QSignalSpy cached_spy(&again, &Task::succeeded);
+        again.start();
+        QCOMPARE(cached_spy.count(), 1);
+        QCOMPARE(cached.packFormat(), 7);
+        QCOMPARE(cached.description(), QString("From the cache"));
+    }
+};
+
+QTEST_GUILESS_MAIN(PackDetailsCacheTest)
+
+#include "PackDetailsCache_test.moc"
@@ -17,6 +17,7 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <QFile>
 #include <QTemporaryDir>
 #include <QTest>
 
@@ -82,6 +83,68 @@ class PackwizTest : public QObject {
         QCOMPARE(metadata.file_id, 3509043);
         QCOMPARE(metadata.project_id, 327154);
     }
+
+    void realIndexName()
+    {
+        QTemporaryDir tmp;
+        QVERIFY(tmp.isValid());
+        QDir index_dir(tmp.path());
+        QFile file(index_dir.absoluteFilePath("Some-Mod.pw.toml"));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.close();
+        if (QFile::exists(index_dir.absoluteFilePath("some-mod.pw.toml")))
+            QSKIP("The file system ignores case");
+
+        QCOMPARE(Packwiz::getRealIndexName(index_dir, "some-mod.pw.toml", true), QString("Some-Mod.pw.toml"));
+        QCOMPARE(Packwiz::getRealIndexName(index_dir, "SOME-MOD.pw.toml", true), QString("Some-Mod.pw.toml"));
+        QCOMPARE(Packwiz::getRealIndexName(index_dir, "other-mod.pw.toml", true), QString());
+
+        QString slug("some-mod");
+        Packwiz::V1::deleteModIndex(index_dir, slug);
+        QVERIFY(!file.exists());
+        QCOMPARE(Packwiz::getRealIndexName(index_dir, "some-mod.pw.toml", true), QString());
+    }
+
+    void batchedWrites()
+    {
+        QTemporaryDir tmp;
+        QVERIFY(tmp.isValid());
+        QDir index_dir(tmp.path());
+
+        Packwiz::V1::Mod mod;
+        mod.slug = "batched-mod";
+        mod.name = "Batched Mod";
+        mod.filename = "batched-mod-1.0.jar";
+        mod.provider = ModPlatform::ResourceProvider::MODRINTH;
+        mod.mod_id() = "AABBCCDD";
+        mod.version() = "v1";
+
+        {
+            Packwiz::IndexBatch batch(index_dir);
+            Packwiz::V1::updateModIndex(index_dir, mod);
+            // nothing's on disk yet, but the index already has it
+            QVERIFY(!QFile::exists(index_dir.absoluteFilePath("batched-mod.pw.toml")));
+            auto pending = Packwiz::V1::getIndexForMod(index_dir, "batched-mod");
+            QCOMPARE(pending.name, QString("Batched Mod"));
+            QVariant id("AABBCCDD");
+            QCOMPARE(Packwiz::V1::getIndexForMod(index_dir, id).filename, QString("batched-mod-1.0.jar"));
+
+            QVERIFY(batch.commit());
+        }
+        QVERIFY(QFile::exists(index_dir.absoluteFilePath("batched-mod.pw.toml")));
+        QCOMPARE(index_dir.entryList(QDir::Files), QStringList{ "batched-mod.pw.toml" });
+        QCOMPARE(Packwiz::V1::getIndexForMod(index_dir, "batched-mod").version(), QVariant("v1"));
+
+        // removals wait for the batch too
+        {
+            Packwiz::IndexBatch batch(index_dir);
+            QString slug("batched-mod");
+            Packwiz::V1::deleteModIndex(index_dir, slug);
+            QVERIFY(QFile::exists(index_dir.absoluteFilePath("batched-mod.pw.toml")));
+            QVERIFY(!Packwiz::V1::getIndexForMod(index_dir, "batched-mod").isValid());
+        }
+        QVERIFY(!QFile::exists(index_dir.absoluteFilePath("batched-mod.pw.toml")));
+    }
 };
 
 QTEST_GUILESS_MAIN(PackwizTest)
@@ -0,0 +1,37 @@
+#include <QTest>
+
+#include <net/PasteUpload.h>
+
+class PasteUploadTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_collapseRepeats()
+    {
+        QByteArray log = "start\nspam\nspam\nspam\nend\nend";
+        QCOMPARE(PasteUpload::prepareLog(log, 0), QByteArray("start\nspam\n[repeated 2 more times]\nend\nend"));
+        QCOMPARE(PasteUpload::prepareLog("a\nb\n", 0), QByteArray("a\nb\n"));
+        QCOMPARE(PasteUpload::prepareLog({}, 0), QByteArray());
+    }
+
+    void test_cutToSize()
+    {
+        QByteArray log;
+        for (int i = 0; i < 1000; i++) {
+            log += QString("line %1\n").arg(i).toUtf8();
+        }
+        const qint64 maxSize = 2000;
+        auto prepared = PasteUpload::prepareLog(log, maxSize);
+        QVERIFY(prepared.size() <= maxSize);
+        QVERIFY(prepared.startsWith("line 0\n"));
+        QVERIFY(prepared.endsWith("line 999\n"));
+        QVERIFY(prepared.contains("bytes were cut out"));
+
+        // small enough already
+        QCOMPARE(PasteUpload::prepareLog(log, log.size()), log);
+    }
+};
+
+QTEST_GUILESS_MAIN(PasteUploadTest)
+
+#include "PasteUpload_test.moc"
@@ -0,0 +1,53 @@
+#include <QTest>
+
+#include <pathmatcher/MultiMatcher.h>
+#include <pathmatcher/RegexpMatcher.h>
+#include <pathmatcher/SimplePrefixMatcher.h>
+
+class PathMatcherTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_regexpFileName()
+    {
+        RegexpMatcher matcher("^crash-.*\\.txt$");
+        QVERIFY(matcher.matches("crash-1.txt"));
+        QVERIFY(matcher.matches("crash-reports/crash-1.txt"));
+        QVERIFY(!matcher.matches("crash-reports/old-crash-1.txt"));
+    }
+
+    void test_multi_data()
+    {
+        QTest::addColumn<QString>("path");
+        QTest::addColumn<bool>("matches");
+        QTest::newRow("log") << "logs/latest.log" << true;
+        QTest::newRow("rotated log") << "logs/debug.log.2.gz" << true;
+        QTest::newRow("crash") << "crash-reports/crash-2024.txt" << true;
+        QTest::newRow("whole path") << "config/secret/keys.json" << true;
+        QTest::newRow("back reference") << "aa.dump" << true;
+        QTest::newRow("back reference mismatch") << "ab.dump" << false;
+        QTest::newRow("exact") << "options.txt" << true;
+        QTest::newRow("exact, not a prefix") << "options.txt.bak" << false;
+        QTest::newRow("prefix") << "screenshots/2024.png" << true;
+        QTest::newRow("nothing") << "mods/mod.jar" << false;
+    }
+
+    void test_multi()
+    {
+        QFETCH(QString, path);
+        QFETCH(bool, matches);
+
+        MultiMatcher matcher;
+        matcher.add(std::make_shared<RegexpMatcher>(".*\\.log(\\.[0-9]*)?(\\.gz)?$"))
+            .add(std::make_shared<RegexpMatcher>("^crash-.*\\.txt$"))
+            .add(std::make_shared<RegexpMatcher>("^config/secret/"))
+            .add(std::make_shared<RegexpMatcher>("^(.)\\1\\.dump$"))
+            .add(std::make_shared<SimplePrefixMatcher>("options.txt"))
+            .add(std::make_shared<SimplePrefixMatcher>("screenshots/"));
+        QCOMPARE(matcher.matches(path), matches);
+    }
+};
+
+QTEST_GUILESS_MAIN(PathMatcherTest)
+
+#include "PathMatcher_test.moc"
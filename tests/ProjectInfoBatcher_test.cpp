@@ -0,0 +1,104 @@
+#include <QSignalSpy>
+#include <QTest>
+
+#include <modplatform/helpers/ProjectInfoBatcher.h>
+
+/* Answers a bulk request with one line per project it was asked for. Only used for testing. */
+class FakeBulkTask : public Task {
+    Q_OBJECT
+
+   public:
+    FakeBulkTask(QStringList ids, std::shared_ptr<QByteArray> response) : m_ids(std::move(ids)), m_response(std::move(response)) {}
+
+   private:
+    void executeTask() override
+    {
+        for (auto& id : m_ids)
+            if (id != "missing")
+                m_response->append((id + "\n").toUtf8());
+        emitSucceeded();
+    }
+
+    QStringList m_ids;
+    std::shared_ptr<QByteArray> m_response;
+};
+
+class ProjectInfoBatcherTest : public QObject {
+    Q_OBJECT
+
+    QList<QStringList> m_fetches;
+
+    ProjectInfoBatcher* makeBatcher(int max_batch_size)
+    {
+        m_fetches.clear();
+        return new ProjectInfoBatcher(
+            [this](QStringList ids, std::shared_ptr<QByteArray> response) {
+                m_fetches.append(ids);
+                return makeShared<FakeBulkTask>(ids, response);
+            },
+            [](const QByteArray& response) {
+                QHash<QString, QByteArray> projects;
+                for (auto& line : response.split('\n'))
+                    if (!line.isEmpty())
+                        projects.insert(QString::fromUtf8(line), "project " + line);
+                return projects;
+            },
+            max_batch_size, this);
+    }
+
+   private slots:
+    void test_RequestsShareOneFetch()
+    {
+        auto batcher = makeBatcher(100);
+
+        auto a = std::make_shared<QByteArray>();
+        auto b = std::make_shared<QByteArray>();
+        auto again = std::make_shared<QByteArray>();
+        auto tasks = QList<Task::Ptr>{ batcher->getProject("a", a), batcher->getProject("b", b), batcher->getProject("a", again) };
+        QList<QSharedPointer<QSignalSpy>> spies;
+        for (auto& task : tasks) {
+            spies.append(QSharedPointer<QSignalSpy>::create(task.get(), &Task::succeeded));
+            task->start();
+        }
+
+        QTRY_VERIFY(spies[0]->count() == 1 && spies[1]->count() == 1 && spies[2]->count() == 1);
+        QCOMPARE(m_fetches.size(), 1);
+        QCOMPARE(m_fetches.first(), QStringList({ "a", "b" }));
+        QCOMPARE(*a, QByteArray("project a"));
+        QCOMPARE(*b, QByteArray("project b"));
+        QCOMPARE(*again, QByteArray("project a"));
+    }
+
+    void test_MissingProjectFails()
+    {
+        auto batcher = makeBatcher(100);
+
+        auto response = std::make_shared<QByteArray>();
+        auto task = batcher->getProject("missing", response);
+        QSignalSpy failed(task.get(), &Task::failed);
+        task->start();
+
+        QTRY_COMPARE(failed.count(), 1);
+        QVERIFY(response->isEmpty());
+    }
+
+    void test_BigSelectionsAreSplit()
+    {
+        auto batcher = makeBatcher(2);
+
+        QList<Task::Ptr> tasks;
+        for (auto id : { "a", "b", "c" }) {
+            tasks.append(batcher->getProject(id, std::make_shared<QByteArray>()));
+            tasks.last()->start();
+        }
+
+        QTRY_VERIFY(tasks[0]->wasSuccessful() && tasks[1]->wasSuccessful() && tasks[2]->wasSuccessful());
+        QCOMPARE(m_fetches.size(), 2);
+        QCOMPARE(m_fetches[0], QStringList({ "a", "b" }));
+        QCOMPARE(m_fetches[1], QStringList({ "c" }));
+    }
+};
+
+QTEST_GUILESS_MAIN(ProjectInfoBatcherTest)
+
+#include "ProjectInfoBatcher_test.moc"
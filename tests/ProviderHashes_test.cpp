@@ -0,0 +1,57 @@
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QTest>
+
+#include <MurmurHash2.h>
+#include <modplatform/ModIndex.h>
+
+class ProviderHashesTest : public QObject {
+    Q_OBJECT
+
+    // more than one read block, with some CurseForge whitespace in it
+    QByteArray makeData()
+    {
+        QByteArray data;
+        for (int i = 0; data.size() < 3 * 1024 * 1024 + 17; i++)
+            data.append(QByteArray::number(i * 7919)).append(i % 5 ? ' ' : '\n');
+        return data;
+    }
+
+   private slots:
+    void test_hashAll()
+    {
+        ModPlatform::ProviderCapabilities caps;
+        auto data = makeData();
+        QStringList types = { "sha512", "sha1", "md5", "murmur2", "sha256", "unknown" };
+
+        QHash<QString, QString> expected{
+            { "sha512", QCryptographicHash::hash(data, QCryptographicHash::Sha512).toHex() },
+            { "sha1", QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex() },
+            { "md5", QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex() },
+            { "sha256", QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex() },
+            { "murmur2", QString::number(CurseForgeMurmurHash2(data.constData(), data.size())) },
+        };
+
+        QCOMPARE(caps.hashAll(data, types), expected);
+
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QCOMPARE(caps.hashAll(&buffer, types), expected);
+    }
+
+    void test_hashAllEmpty()
+    {
+        ModPlatform::ProviderCapabilities caps;
+        QByteArray data;
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+        auto hashes = caps.hashAll(&buffer, { "sha1", "murmur2" });
+        QCOMPARE(hashes.value("sha1"), QString(QCryptographicHash::hash({}, QCryptographicHash::Sha1).toHex()));
+        QCOMPARE(hashes.value("murmur2"), QString::number(MurmurHash2(nullptr, 0)));
+    }
+};
+
+QTEST_GUILESS_MAIN(ProviderHashesTest)
+
+#include "ProviderHashes_test.moc"
@@ -193,6 +193,30 @@ class ResourceFolderModelTest : public QObject {
         model.stopWatching();
     }
 
+    void test_incrementalUpdate()
+    {
+        QString folder_resource = QFINDTESTDATA("testdata/ResourceFolderModel/test_folder");
+        QString file_mod = QFINDTESTDATA("testdata/ResourceFolderModel/supercoolmod.jar");
+
+        QTemporaryDir tmp;
+        ModFolderModel model(tmp.path(), nullptr);
+
+        { EXEC_UPDATE_TASK(model.installResource(file_mod), QVERIFY) }
+
+        QCOMPARE(model.size(), 1);
+        auto const* first_mod = model.all().at(0).get();
+
+        { EXEC_UPDATE_TASK(model.installResource(folder_resource), QVERIFY) }
+
+        QCOMPARE(model.size(), 2);
+        QVERIFY2(model.find("supercoolmod.jar") == first_mod, "Untouched mod got replaced by an incremental update.");
+
+        { EXEC_UPDATE_TASK(model.uninstallResource("test_folder"), QVERIFY) }
+
+        QCOMPARE(model.size(), 1);
+        QVERIFY2(model.find("supercoolmod.jar") == first_mod, "Untouched mod got replaced by an incremental update.");
+    }
+
     void test_enable_disable()
     {
         QString folder_resource = QFINDTESTDATA("testdata/ResourceFolderModel/test_folder");
@@ -240,6 +264,31 @@ class ResourceFolderModelTest : public QObject {
         QVERIFY(res_2.enabled() == initial_enabled_res_2);
         QVERIFY(res_2.internal_id() == id_2);
     }
+
+    void test_sortKeysFollowDetails()
+    {
+        Mod first;
+        Mod second;
+
+        ModDetails details;
+        details.name = "The Zebra Mod";
+        details.version = "1.10";
+        first.setDetails(details);
+        details.name = "apple mod";
+        details.version = "1.9";
+        second.setDetails(details);
+
+        QVERIFY(first.compare(second, SortType::NAME).first > 0);
+        QVERIFY(first.compare(second, SortType::VERSION).first > 0);
+
+        // what was worked out for the first sort must not stick around once the details change
+        details.name = "Aardvark Mod";
+        details.version = "1.2";
+        first.setDetails(details);
+
+        QVERIFY(first.compare(second, SortType::NAME).first < 0);
+        QVERIFY(first.compare(second, SortType::VERSION).first < 0);
+    }
 };
 
 QTEST_GUILESS_MAIN(ResourceFolderModelTest)
@@ -0,0 +1,55 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <modplatform/helpers/SearchResponseCache.h>
+
+class SearchResponseCacheTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_LookupAfterInsert()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        SearchResponseCache cache(dir.path());
+        QVERIFY(!cache.lookup("https://api.example/search?query=a").has_value());
+
+        cache.insert("https://api.example/search?query=a", "{\"hits\":[]}");
+        auto cached = cache.lookup("https://api.example/search?query=a");
+        QVERIFY(cached.has_value());
+        QCOMPARE(cached->data, QByteArray("{\"hits\":[]}"));
+        QVERIFY(!cached->stale);
+        QVERIFY(!cache.lookup("https://api.example/search?query=b").has_value());
+    }
+
+    void test_LookupFromDisk()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        SearchResponseCache(dir.path()).insert("https://api.example/search?query=a", "{}");
+
+        SearchResponseCache cache(dir.path());
+        auto cached = cache.lookup("https://api.example/search?query=a");
+        QVERIFY(cached.has_value());
+        QCOMPARE(cached->data, QByteArray("{}"));
+    }
+
+    void test_OneRefreshAtATime()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        SearchResponseCache cache(dir.path());
+        QVERIFY(cache.beginRefresh("https://api.example/search?query=a"));
+        QVERIFY(!cache.beginRefresh("https://api.example/search?query=a"));
+        QVERIFY(cache.beginRefresh("https://api.example/search?query=b"));
+        cache.endRefresh("https://api.example/search?query=a");
+        QVERIFY(cache.beginRefresh("https://api.example/search?query=a"));
+    }
+};
+
+QTEST_GUILESS_MAIN(SearchResponseCacheTest)
+
+#include "SearchResponseCache_test.moc"
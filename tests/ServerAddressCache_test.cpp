@@ -0,0 +1,57 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/ServerAddressCache.h>
+
+class ServerAddressCacheTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void cleanup() { ServerAddressCache::clear(); }
+
+    void test_storeAndLookup()
+    {
+        QVERIFY(!ServerAddressCache::lookup("play.example.com"));
+
+        ServerAddressCache::store("Play.Example.com", { "mc.example.net", 25570 }, 300);
+        auto target = ServerAddressCache::lookup("play.example.com");
+        QVERIFY(target);
+        QCOMPARE(target->host, QString("mc.example.net"));
+        QCOMPARE(target->port, quint16(25570));
+
+        ServerAddressCache::clear();
+        QVERIFY(!ServerAddressCache::lookup("play.example.com"));
+    }
+
+    void test_persisted()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto path = FS::PathCombine(dir.path(), "server_addresses.json");
+        auto saved = FS::PathCombine(dir.path(), "saved.json");
+
+        ServerAddressCache::setPersistPath(path);
+        ServerAddressCache::store("play.example.com", { "mc.example.net", 25570 }, 300);
+        ServerAddressCache::store("plain.example.com", { "plain.example.com", 25565 }, ServerAddressCache::NO_RECORD_TTL_SECONDS);
+        QVERIFY(QFile::copy(path, saved));
+
+        // as if the launcher was started again
+        ServerAddressCache::clear();
+        QVERIFY(!QFileInfo::exists(path));
+        QVERIFY(QFile::copy(saved, path));
+        ServerAddressCache::setPersistPath(path);
+
+        auto target = ServerAddressCache::lookup("play.example.com");
+        QVERIFY(target);
+        QCOMPARE(target->host, QString("mc.example.net"));
+        QCOMPARE(target->port, quint16(25570));
+        QVERIFY(ServerAddressCache::lookup("plain.example.com"));
+
+        ServerAddressCache::setPersistPath({});
+    }
+};
+
+QTEST_GUILESS_MAIN(ServerAddressCacheTest)
+
+#include "ServerAddressCache_test.moc"
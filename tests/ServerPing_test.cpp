@@ -0,0 +1,142 @@
+#include <QDataStream>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+
+#include <Json.h>
+#include <minecraft/ServerPingTask.h>
+
+class ServerPingTest : public QObject {
+    Q_OBJECT
+
+    // answers one status request and one ping, the way a vanilla server does
+    static void serveStatus(QTcpSocket* socket, const QByteArray& json)
+    {
+        auto buffer = std::make_shared<QByteArray>();
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [socket, buffer, json] {
+            *buffer += socket->readAll();
+            while (true) {
+                int offset = 0;
+                qint32 length;
+                if (!ServerPing::decodeVarInt(*buffer, offset, length) || buffer->size() < offset + length)
+                    return;
+                auto packet = buffer->mid(offset, length);
+                buffer->remove(0, offset + length);
+
+                int position = 0;
+                qint32 id;
+                ServerPing::decodeVarInt(packet, position, id);
+                if (id == 0x00 && position == packet.size()) {
+                    auto response = ServerPing::encodeVarInt(0x00) + ServerPing::encodeVarInt(json.size()) + json;
+                    socket->write(ServerPing::encodeVarInt(response.size()) + response);
+                } else if (id == 0x01) {
+                    // the pong is the ping, sent back
+                    socket->write(ServerPing::encodeVarInt(packet.size()) + packet);
+                }
+            }
+        });
+    }
+
+   private slots:
+    void test_varInt_data()
+    {
+        QTest::addColumn<qint32>("value");
+        QTest::addColumn<QByteArray>("encoded");
+        QTest::newRow("zero") << 0 << QByteArray::fromHex("00");
+        QTest::newRow("one byte") << 127 << QByteArray::fromHex("7f");
+        QTest::newRow("two bytes") << 25565 << QByteArray::fromHex("ddc701");
+        QTest::newRow("negative") << -1 << QByteArray::fromHex("ffffffff0f");
+    }
+
+    void test_varInt()
+    {
+        QFETCH(qint32, value);
+        QFETCH(QByteArray, encoded);
+
+        QCOMPARE(ServerPing::encodeVarInt(value), encoded);
+
+        int offset = 0;
+        qint32 decoded;
+        QVERIFY(ServerPing::decodeVarInt(encoded, offset, decoded));
+        QCOMPARE(decoded, value);
+        QCOMPARE(offset, encoded.size());
+
+        // cut short, there's nothing to read yet
+        offset = 0;
+        QVERIFY(!ServerPing::decodeVarInt(encoded.left(encoded.size() - 1), offset, decoded));
+        QCOMPARE(offset, 0);
+    }
+
+    void test_statusRequest()
+    {
+        // length, handshake id, protocol -1, "mc.local", port 25565, next state status, then the empty status request
+        QCOMPARE(ServerPing::statusRequest("mc.local", 25565), QByteArray::fromHex("12" "00" "ffffffff0f" "086d632e6c6f63616c" "63dd" "01"
+                                                                                   "01" "00"));
+    }
+
+    void test_parseStatus()
+    {
+        auto status = ServerPing::parseStatus(R"({
+            "version": { "name": "1.20.4", "protocol": 765 },
+            "players": { "max": 100, "online": 5 },
+            "description": { "text": "§aA ", "extra": [ { "text": "Minecraft" }, " Server" ] },
+            "favicon": "data:image/png;base64,iVBORw0KGgo="
+        })");
+        QVERIFY(status.up);
+        QCOMPARE(status.motd, QString("A Minecraft Server"));
+        QCOMPARE(status.version, QString("1.20.4"));
+        QCOMPARE(status.currentPlayers, 5);
+        QCOMPARE(status.maxPlayers, 100);
+        QCOMPARE(status.icon, QByteArray("\x89PNG\r\n\x1a\n", 8));
+
+        QCOMPARE(ServerPing::parseStatus(R"({ "description": "Plain" })").motd, QString("Plain"));
+        QVERIFY_EXCEPTION_THROWN(ServerPing::parseStatus("not json"), Json::JsonException);
+    }
+
+    void test_ping()
+    {
+        QTcpServer server;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+        connect(&server, &QTcpServer::newConnection, this, [&server] {
+            serveStatus(server.nextPendingConnection(), R"({ "players": { "max": 20, "online": 1 }, "description": "Hello" })");
+        });
+
+        auto address = QString("127.0.0.1:%1").arg(server.serverPort());
+        ServerPingTask task(address);
+        QSignalSpy succeeded(&task, &Task::succeeded);
+        task.start();
+        QVERIFY(succeeded.wait());
+        QVERIFY(task.status().up);
+        QCOMPARE(task.status().motd, QString("Hello"));
+        QCOMPARE(task.status().maxPlayers, 20);
+
+        // asking again right away is answered from the cache
+        server.close();
+        ServerPingTask again(address);
+        QSignalSpy succeededAgain(&again, &Task::succeeded);
+        again.start();
+        QCOMPARE(succeededAgain.count(), 1);
+        QCOMPARE(again.status().motd, QString("Hello"));
+    }
+
+    void test_pingUnreachable()
+    {
+        // find a port nothing is listening on
+        QTcpServer server;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+        auto address = QString("127.0.0.1:%1").arg(server.serverPort());
+        server.close();
+
+        ServerPingTask task(address);
+        QSignalSpy succeeded(&task, &Task::succeeded);
+        task.start();
+        QVERIFY(succeeded.wait());
+        QVERIFY(!task.status().up);
+        QVERIFY(!task.status().error.isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(ServerPingTest)
+
+#include "ServerPing_test.moc"
@@ -0,0 +1,46 @@
+#include <QTest>
+
+#include <tasks/SharedWork.h>
+#include <tasks/Task.h>
+
+/* Runs until it's told how to finish. Only used for testing. */
+class ManualTask : public Task {
+    Q_OBJECT
+
+   public:
+    using Task::emitFailed;
+    using Task::emitSucceeded;
+
+   private:
+    void executeTask() override {}
+};
+
+class SharedWorkTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_claim()
+    {
+        ManualTask first, second;
+        first.start();
+        second.start();
+
+        QVERIFY(!SharedWork::claim("libraries/a", &first));
+        QCOMPARE(SharedWork::claim("libraries/a", &second), static_cast<Task*>(&first));
+        QVERIFY(!SharedWork::claim("libraries/b", &second));
+
+        // the key is free again by the time a follower hears the owner is done
+        Task* claimedAfter = &first;
+        connect(&first, &Task::failed, this, [&] { claimedAfter = SharedWork::claim("libraries/a", &second); });
+        first.emitFailed("broken");
+        QVERIFY(!claimedAfter);
+        QCOMPARE(SharedWork::claim("libraries/a", &first), static_cast<Task*>(&second));
+
+        second.emitSucceeded();
+        QVERIFY(!SharedWork::claim("libraries/b", &first));
+    }
+};
+
+QTEST_GUILESS_MAIN(SharedWorkTest)
+
+#include "SharedWork_test.moc"
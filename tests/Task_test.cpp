@@ -1,12 +1,15 @@
+#include <QPointer>
 #include <QTest>
 #include <QThread>
 #include <QTimer>
 
 #include <tasks/ConcurrentTask.h>
+#include <tasks/DependencyTask.h>
 #include <tasks/MultipleOptionsTask.h>
 #include <tasks/SequentialTask.h>
 #include <tasks/Task.h>
 
+#include <algorithm>
 #include <array>
 
 /* Does nothing. Only used for testing. */
@@ -22,6 +25,19 @@ class BasicTask : public Task {
     void executeTask() override { emitSucceeded(); }
 };
 
+/* Reports a lot of progress at once, then succeeds a bit later. Only used for testing. */
+class ChattyTask : public Task {
+    Q_OBJECT
+
+   private:
+    void executeTask() override
+    {
+        for (int i = 1; i <= 1000; i++)
+            setProgress(i, 1000);
+        QTimer::singleShot(100, this, [this] { emitSucceeded(); });
+    }
+};
+
 /* Does nothing. Only used for testing. */
 class BasicTask_MultiStep : public Task {
     Q_OBJECT
@@ -245,6 +261,95 @@ class TaskTest : public QObject {
         QVERIFY2(QTest::qWaitFor([&]() { return t.isFinished(); }, 1000), "Task didn't finish as it should.");
     }
 
+    void test_concurrentProgressIsThrottled()
+    {
+        ConcurrentTask t;
+
+        t.addTask(makeShared<ChattyTask>());
+        t.addTask(makeShared<ChattyTask>());
+
+        int reports = 0;
+        qint64 last_current = 0;
+        QObject::connect(&t, &Task::stepProgress, [&reports, &last_current](TaskStepProgress const& tp) {
+            reports++;
+            if (!tp.isDone())
+                last_current = tp.current;
+        });
+
+        t.start();
+        QVERIFY2(QTest::qWaitFor([&]() { return t.isFinished(); }, 1000), "Task didn't finish as it should.");
+        QVERIFY(t.wasSuccessful());
+
+        QVERIFY2(reports < 100, "Every single progress update was passed on.");
+        QCOMPARE(last_current, 1000);
+    }
+
+    void test_concurrentReleasesSucceededTasks()
+    {
+        ConcurrentTask t;
+        t.setKeepSucceededTasks(false);
+
+        QList<QPointer<Task>> subtasks;
+        for (int i = 0; i < 10; i++) {
+            auto subtask = makeShared<BasicTask>();
+            subtasks.append(subtask.get());
+            t.addTask(subtask);
+        }
+
+        t.start();
+        QVERIFY2(QTest::qWaitFor([&]() { return t.isFinished(); }, 1000), "Task didn't finish as it should.");
+        QVERIFY(t.wasSuccessful());
+        QCOMPARE(t.getStepProgress().size(), 0);
+
+        auto all_released = [&subtasks] { return std::all_of(subtasks.begin(), subtasks.end(), [](auto& p) { return p.isNull(); }); };
+        QVERIFY2(QTest::qWaitFor(all_released, 1000), "Succeeded subtasks were kept alive.");
+    }
+
+    void test_dependencyRun()
+    {
+        auto first = makeShared<BasicTask>();
+        auto second = makeShared<BasicTask>();
+        auto third = makeShared<BasicTask>();
+        auto last = makeShared<BasicTask>();
+
+        DependencyTask t;
+
+        // added out of order on purpose, the dependencies decide when they run
+        t.addTask(last, { second, third });
+        t.addTask(second, { first });
+        t.addTask(third, { first });
+        t.addTask(first);
+
+        QList<Task*> order;
+        for (auto task : { first, second, third, last })
+            QObject::connect(task.get(), &Task::succeeded, [&order, task] { order.append(task.get()); });
+
+        t.start();
+        QVERIFY2(QTest::qWaitFor([&]() { return t.isFinished(); }, 1000), "Task didn't finish as it should.");
+        QVERIFY(t.wasSuccessful());
+
+        QCOMPARE(order.size(), 4);
+        QCOMPARE(order.first(), first.get());
+        QCOMPARE(order.last(), last.get());
+    }
+
+    void test_dependencyFailure()
+    {
+        auto failing = makeShared<BasicTask_MultiStep>();
+        auto dependent = makeShared<BasicTask>();
+
+        DependencyTask t;
+        t.addTask(dependent, { failing });
+        t.addTask(failing);
+
+        t.start();
+        QVERIFY(QTest::qWaitFor([&]() { return failing->isRunning(); }, 1000));
+        failing->emitFailed("broken");
+        QVERIFY2(QTest::qWaitFor([&]() { return t.isFinished(); }, 1000), "Task didn't finish as it should.");
+        QVERIFY(!t.wasSuccessful());
+        QVERIFY(!dependent->isFinished());
+    }
+
     void test_stackOverflowInConcurrentTask()
     {
         QEventLoop loop;
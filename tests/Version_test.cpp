@@ -178,6 +178,20 @@ class VersionTest : public QObject {
         QCOMPARE(v1 > v2, !lessThan && !equal);
         QCOMPARE(v1 == v2, equal);
     }
+
+    void benchmark_sort()
+    {
+        QVector<Version> versions;
+        for (int major = 0; major < 20; major++)
+            for (int minor = 0; minor < 20; minor++)
+                versions.append(Version(QString("1.%1.%2-pre%3+build.%4").arg(major).arg(minor).arg(minor % 3).arg(major * minor)));
+
+        QBENCHMARK
+        {
+            auto sorted = versions;
+            std::sort(sorted.begin(), sorted.end());
+        }
+    }
 };
 
 QTEST_GUILESS_MAIN(VersionTest)